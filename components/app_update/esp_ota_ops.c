@@ -48,6 +48,7 @@ typedef struct ota_ops_entry_ {
     uint32_t wrote_size;
     uint8_t partial_bytes;
     bool ota_resumption;
+    esp_image_stream_handle_t stream;        /*!< Verification of the image data written so far, NULL if the image is verified from flash in esp_ota_end */
     WORD_ALIGNED_ATTR uint8_t partial_data[16];
     LIST_ENTRY(ota_ops_entry_) entries;
 } ota_ops_entry_t;
@@ -292,9 +293,37 @@ esp_err_t esp_ota_set_final_partition(esp_ota_handle_t handle, const esp_partiti
     return ESP_OK;
 }
 
+static void ota_stream_drop(ota_ops_entry_t *it)
+{
+    esp_image_verify_stream_abort(it->stream);
+    it->stream = NULL;
+}
+
+/* Verify an app or bootloader image while it is written, esp_ota_end() then only completes the verification */
+static void ota_stream_start(ota_ops_entry_t *it)
+{
+    const esp_partition_pos_t part_pos = {
+        .offset = it->partition.staging->address,
+        .size = it->partition.staging->size,
+    };
+    ota_stream_drop(it);
+    if (esp_image_verify_stream_start(ESP_IMAGE_VERIFY, &part_pos, &it->stream) != ESP_OK) {
+        ESP_LOGD(TAG, "image will be verified from flash");
+    }
+}
+
+static void ota_stream_data(ota_ops_entry_t *it, const void *data, size_t size)
+{
+    // Errors are reported by esp_ota_end(), once the image is complete
+    if (it->stream != NULL && esp_image_verify_stream_data(it->stream, data, size) != ESP_OK) {
+        ESP_LOGD(TAG, "image data is invalid");
+    }
+}
+
 esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
 {
     const uint8_t *data_bytes = (const uint8_t *)data;
+    const size_t write_size = size;
     esp_err_t ret;
     ota_ops_entry_t *it;
 
@@ -333,7 +362,7 @@ esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
                         ESP_LOGE(TAG, "OTA image has invalid magic byte (expected 0xE9, saw 0x%02x)", data_bytes[0]);
                         return ESP_ERR_OTA_VALIDATE_FAILED;
                     }
-
+                    ota_stream_start(it);
                 } else if (it->partition.final->type == ESP_PARTITION_TYPE_PARTITION_TABLE) {
                     if (*(uint16_t*)data_bytes != (uint16_t)ESP_PARTITION_MAGIC) {
                         ESP_LOGE(TAG, "Partition table image has invalid magic word (expected 0x50AA, saw 0x%04x)", *(uint16_t*)data_bytes);
@@ -352,11 +381,13 @@ esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
                     memcpy(it->partial_data + it->partial_bytes, data_bytes, copy_len);
                     it->partial_bytes += copy_len;
                     if (it->partial_bytes != 16) {
+                        ota_stream_data(it, data, write_size);
                         return ESP_OK; /* nothing to write yet, just filling buffer */
                     }
                     /* write 16 byte to partition */
                     ret = esp_partition_write(it->partition.staging, it->wrote_size, it->partial_data, 16);
                     if (ret != ESP_OK) {
+                        ota_stream_drop(it);
                         return ret;
                     }
                     it->partial_bytes = 0;
@@ -377,6 +408,9 @@ esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
             ret = esp_partition_write(it->partition.staging, it->wrote_size, data_bytes, size);
             if(ret == ESP_OK){
                 it->wrote_size += size;
+                ota_stream_data(it, data, write_size);
+            } else {
+                ota_stream_drop(it);
             }
             return ret;
         }
@@ -411,6 +445,8 @@ esp_err_t esp_ota_write_with_offset(esp_ota_handle_t handle, const void *data, s
                 ESP_LOGE(TAG, "Size should be 16byte aligned for flash encryption case");
                 return ESP_ERR_INVALID_ARG;
             }
+            // Data is not written in order, the image is verified from flash in esp_ota_end()
+            ota_stream_drop(it);
             ret = esp_partition_write(it->partition.staging, offset, data_bytes, size);
             if (ret == ESP_OK) {
                 it->wrote_size += size;
@@ -442,6 +478,7 @@ esp_err_t esp_ota_abort(esp_ota_handle_t handle)
     if (it == NULL) {
         return ESP_ERR_NOT_FOUND;
     }
+    ota_stream_drop(it);
     LIST_REMOVE(it, entries);
     free(it);
     return ESP_OK;
@@ -456,7 +493,14 @@ static esp_err_t ota_verify_partition(ota_ops_entry_t *ota_ops)
             .offset = ota_ops->partition.staging->address,
             .size = ota_ops->partition.staging->size,
         };
-        if (esp_image_verify(ESP_IMAGE_VERIFY, &part_pos, &data) != ESP_OK) {
+        esp_err_t err;
+        if (ota_ops->stream != NULL) {
+            err = esp_image_verify_stream_finish(ota_ops->stream, &data);
+            ota_ops->stream = NULL;
+        } else {
+            err = esp_image_verify(ESP_IMAGE_VERIFY, &part_pos, &data);
+        }
+        if (err != ESP_OK) {
             return ESP_ERR_OTA_VALIDATE_FAILED;
         }
     } else if (ota_ops->partition.final->type == ESP_PARTITION_TYPE_PARTITION_TABLE) {
@@ -518,6 +562,7 @@ esp_err_t esp_ota_end(esp_ota_handle_t handle)
         // In esp_ota_begin, bootloader offset was updated, here we return it to default.
         esp_image_bootloader_offset_set(ESP_PRIMARY_BOOTLOADER_OFFSET);
     }
+    ota_stream_drop(it);
     LIST_REMOVE(it, entries);
     free(it);
     return ret;
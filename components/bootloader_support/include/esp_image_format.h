@@ -127,6 +127,67 @@ esp_err_t esp_image_verify(esp_image_load_mode_t mode, const esp_partition_pos_t
  */
 esp_err_t esp_image_get_metadata(const esp_partition_pos_t *part, esp_image_metadata_t *metadata);
 
+/**
+ * @brief Handle of an image verification fed with the image data, see esp_image_verify_stream_start()
+ */
+typedef struct esp_image_stream *esp_image_stream_handle_t;
+
+/**
+ * @brief Start verifying an app/bootloader image while it is being written to a partition (not available in bootloader).
+ *
+ * The image data is passed to esp_image_verify_stream_data() in order, as it is written to the partition.
+ * Headers and segments are checked and the checksum and SHA-256 are calculated on the fly, so that
+ * esp_image_verify_stream_finish() only reads the checksum, appended hash and signature from flash.
+ * The result is the same as esp_image_verify() on the partition, provided that the data passed is the data written.
+ *
+ * @param mode Mode of operation, ESP_IMAGE_VERIFY or ESP_IMAGE_VERIFY_SILENT.
+ * @param part Partition the image is written to.
+ * @param[out] out_handle Handle to pass to the other esp_image_verify_stream_* functions.
+ *
+ * @return
+ * - ESP_OK if the verification was started
+ * - ESP_ERR_NO_MEM if the handle can't be allocated
+ * - ESP_ERR_INVALID_ARG if the mode, partition or handle pointer are invalid.
+ * - ESP_ERR_NOT_SUPPORTED in bootloader.
+ */
+esp_err_t esp_image_verify_stream_start(esp_image_load_mode_t mode, const esp_partition_pos_t *part, esp_image_stream_handle_t *out_handle);
+
+/**
+ * @brief Pass the next chunk of image data to a verification started by esp_image_verify_stream_start().
+ *
+ * Chunks can have any length. Data following the last segment is ignored.
+ *
+ * @param handle Verification handle.
+ * @param data Image data.
+ * @param len Length of data.
+ *
+ * @return
+ * - ESP_OK if no error has been found so far, the final result is given by esp_image_verify_stream_finish()
+ * - ESP_ERR_IMAGE_INVALID or another error if the image data passed so far is invalid.
+ * - ESP_ERR_INVALID_ARG if the handle or data pointers are invalid.
+ */
+esp_err_t esp_image_verify_stream_data(esp_image_stream_handle_t handle, const void *data, size_t len);
+
+/**
+ * @brief Complete the verification once the whole image has been written, and free the handle.
+ *
+ * If the data passed does not cover all the segments of the image, the whole partition is verified
+ * with esp_image_verify() instead.
+ *
+ * @param handle Verification handle.
+ * @param[out] data Pointer to the image metadata structure, filled in as by esp_image_verify().
+ *
+ * @return As per esp_image_verify().
+ */
+esp_err_t esp_image_verify_stream_finish(esp_image_stream_handle_t handle, esp_image_metadata_t *data);
+
+/**
+ * @brief Abandon a verification and free the handle.
+ *
+ * @param handle Verification handle, can be NULL.
+ */
+void esp_image_verify_stream_abort(esp_image_stream_handle_t handle);
+
 /**
  * @brief Verify and load an app image (available only in space of bootloader).
  *
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <stdlib.h>
 #include <string.h>
 #include <sys/param.h>
 #include <esp_cpu.h>
@@ -83,8 +84,8 @@ static esp_err_t process_segment_data(int segment, intptr_t load_addr, uint32_t
 /* Verify the main image header */
 static esp_err_t verify_image_header(uint32_t src_addr, const esp_image_header_t *image, bool silent);
 
-/* Verify a segment header */
-static esp_err_t verify_segment_header(int index, const esp_image_segment_header_t *segment, uint32_t segment_data_offs, esp_image_metadata_t *metadata, bool silent);
+/* Verify a segment header, app_desc is the start of segment #0 of an app if already at hand (otherwise read from flash) */
+static esp_err_t verify_segment_header(int index, const esp_image_segment_header_t *segment, uint32_t segment_data_offs, const esp_app_desc_t *app_desc, esp_image_metadata_t *metadata, bool silent);
 
 /* Log-and-fail macro for use in esp_image_load */
 #define FAIL_LOAD(...) do {                         \
@@ -103,10 +104,16 @@ static esp_err_t verify_segment_header(int index, const esp_image_segment_header
     while(0)
 
 static esp_err_t process_image_header(esp_image_metadata_t *data, uint32_t part_offset, bootloader_sha256_handle_t *sha_handle, bool do_verify, bool silent);
+/* Start the SHA-256 of the image and verify the image header already read into data->image */
+static esp_err_t check_image_header(esp_image_metadata_t *data, bootloader_sha256_handle_t *sha_handle, bool do_verify, bool silent);
 static esp_err_t process_appended_hash_and_sig(esp_image_metadata_t *data, uint32_t part_offset, uint32_t part_len, bool do_verify, bool silent);
 static esp_err_t process_checksum(bootloader_sha256_handle_t sha_handle, uint32_t checksum_word, esp_image_metadata_t *data, bool silent, bool skip_check_checksum);
 static esp_err_t __attribute__((unused)) verify_secure_boot_signature(bootloader_sha256_handle_t sha_handle, esp_image_metadata_t *data, uint8_t *image_digest, uint8_t *verified_digest);
 static esp_err_t __attribute__((unused)) verify_simple_hash(bootloader_sha256_handle_t sha_handle, esp_image_metadata_t *data);
+/* Return true if the SHA-256 of the image is calculated and checked against its appended digest or signature */
+static bool should_verify_sha(uint32_t part_offset, bool do_verify);
+/* Check the SHA-256 of the image if verify_sha is set, always finishes sha_handle */
+static esp_err_t verify_image_digest(bool verify_sha, bootloader_sha256_handle_t sha_handle, esp_image_metadata_t *data, uint8_t *image_digest, uint8_t *verified_digest);
 
 static uint32_t s_bootloader_partition_offset = ESP_PRIMARY_BOOTLOADER_OFFSET;
 
@@ -167,15 +174,7 @@ static esp_err_t image_load(esp_image_load_mode_t mode, const esp_partition_pos_
         return ESP_ERR_INVALID_ARG;
     }
 
-#if CONFIG_SECURE_BOOT_V2_ENABLED
-    // For Secure Boot V2, we do verify signature on bootloader which includes the SHA calculation.
-    verify_sha = do_verify;
-#else // Secure boot not enabled
-    // For secure boot V1 on ESP32, we don't calculate SHA or verify signature on bootloaders.
-    // (For non-secure boot, we don't verify any SHA-256 hash appended to the bootloader because
-    // esptool.py may have rewritten the header - rely on esptool.py having verified the bootloader at flashing time, instead.)
-    verify_sha = !is_bootloader(part->offset) && do_verify;
-#endif
+    verify_sha = should_verify_sha(part->offset, do_verify);
 
     if (part->size > ESP_IMAGE_MAX_FLASH_ADDR_SIZE) {
         err = ESP_ERR_INVALID_ARG;
@@ -188,35 +187,12 @@ static esp_err_t image_load(esp_image_load_mode_t mode, const esp_partition_pos_
     bool skip_check_checksum = !do_verify || esp_cpu_dbgr_is_attached();
     CHECK_ERR(process_checksum(sha_handle, checksum_word, data, silent, skip_check_checksum));
     CHECK_ERR(process_appended_hash_and_sig(data, part->offset, part->size, do_verify, silent));
-    if (verify_sha) {
 #if (SECURE_BOOT_CHECK_SIGNATURE == 1)
-        // secure boot images have a signature appended
-#if defined(BOOTLOADER_BUILD) && !defined(CONFIG_SECURE_BOOT)
-        // If secure boot is not enabled in hardware, then
-        // skip the signature check in bootloader when the debugger is attached.
-        // This is done to allow for breakpoints in Flash.
-        bool do_verify_sig = !esp_cpu_dbgr_is_attached();
-#else // CONFIG_SECURE_BOOT
-        bool do_verify_sig = true;
-#endif // end checking for JTAG
-        if (do_verify_sig) {
-            err = verify_secure_boot_signature(sha_handle, data, image_digest, verified_digest);
-            sha_handle = NULL; // verify_secure_boot_signature finishes sha_handle
-        }
-#else // SECURE_BOOT_CHECK_SIGNATURE
-        // No secure boot, but SHA-256 can be appended for basic corruption detection
-        if (sha_handle != NULL && !esp_cpu_dbgr_is_attached()) {
-            err = verify_simple_hash(sha_handle, data);
-            sha_handle = NULL; // calling verify_simple_hash finishes sha_handle
-        }
-#endif // SECURE_BOOT_CHECK_SIGNATURE
-    } // verify_sha
-
-    // bootloader may still have a sha256 digest handle open
-    if (sha_handle != NULL) {
-        bootloader_sha256_finish(sha_handle, NULL);
-        sha_handle = NULL;
-    }
+    err = verify_image_digest(verify_sha, sha_handle, data, image_digest, verified_digest);
+#else
+    err = verify_image_digest(verify_sha, sha_handle, data, NULL, NULL);
+#endif
+    sha_handle = NULL; // verify_image_digest finishes sha_handle
 
     if (err != ESP_OK) {
         goto err;
@@ -293,6 +269,53 @@ err:
     return err;
 }
 
+static bool should_verify_sha(uint32_t part_offset, bool do_verify)
+{
+#if CONFIG_SECURE_BOOT_V2_ENABLED
+    // For Secure Boot V2, we do verify signature on bootloader which includes the SHA calculation.
+    return do_verify;
+#else // Secure boot not enabled
+    // For secure boot V1 on ESP32, we don't calculate SHA or verify signature on bootloaders.
+    // (For non-secure boot, we don't verify any SHA-256 hash appended to the bootloader because
+    // esptool.py may have rewritten the header - rely on esptool.py having verified the bootloader at flashing time, instead.)
+    return !is_bootloader(part_offset) && do_verify;
+#endif
+}
+
+static esp_err_t verify_image_digest(bool verify_sha, bootloader_sha256_handle_t sha_handle, esp_image_metadata_t *data, uint8_t *image_digest, uint8_t *verified_digest)
+{
+    esp_err_t err = ESP_OK;
+    if (verify_sha) {
+#if (SECURE_BOOT_CHECK_SIGNATURE == 1)
+        // secure boot images have a signature appended
+#if defined(BOOTLOADER_BUILD) && !defined(CONFIG_SECURE_BOOT)
+        // If secure boot is not enabled in hardware, then
+        // skip the signature check in bootloader when the debugger is attached.
+        // This is done to allow for breakpoints in Flash.
+        bool do_verify_sig = !esp_cpu_dbgr_is_attached();
+#else // CONFIG_SECURE_BOOT
+        bool do_verify_sig = true;
+#endif // end checking for JTAG
+        if (do_verify_sig) {
+            err = verify_secure_boot_signature(sha_handle, data, image_digest, verified_digest);
+            sha_handle = NULL; // verify_secure_boot_signature finishes sha_handle
+        }
+#else // SECURE_BOOT_CHECK_SIGNATURE
+        // No secure boot, but SHA-256 can be appended for basic corruption detection
+        if (sha_handle != NULL && !esp_cpu_dbgr_is_attached()) {
+            err = verify_simple_hash(sha_handle, data);
+            sha_handle = NULL; // calling verify_simple_hash finishes sha_handle
+        }
+#endif // SECURE_BOOT_CHECK_SIGNATURE
+    } // verify_sha
+
+    // bootloader may still have a sha256 digest handle open
+    if (sha_handle != NULL) {
+        bootloader_sha256_finish(sha_handle, NULL);
+    }
+    return err;
+}
+
 esp_err_t bootloader_load_image(const esp_partition_pos_t *part, esp_image_metadata_t *data)
 {
 #if !defined(BOOTLOADER_BUILD)
@@ -535,7 +558,14 @@ static esp_err_t process_image_header(esp_image_metadata_t *data, uint32_t part_
 
     ESP_LOGD(TAG, "reading image header @ 0x%"PRIx32, data->start_addr);
     CHECK_ERR(bootloader_flash_read(data->start_addr, &data->image, sizeof(esp_image_header_t), true));
+    return check_image_header(data, sha_handle, do_verify, silent);
+err:
+    return err;
+}
 
+static esp_err_t check_image_header(esp_image_metadata_t *data, bootloader_sha256_handle_t *sha_handle, bool do_verify, bool silent)
+{
+    esp_err_t err;
     if (do_verify) {
         // Calculate SHA-256 of image if secure boot is on, or if image has a hash appended
         if (SECURE_BOOT_CHECK_SIGNATURE || data->image.hash_appended) {
@@ -604,7 +634,7 @@ static esp_err_t process_segment(int index, uint32_t flash_addr, esp_image_segme
 
     ESP_LOGV(TAG, "segment data length 0x%"PRIx32" data starts 0x%"PRIx32, data_len, data_addr);
 
-    CHECK_ERR(verify_segment_header(index, header, data_addr, metadata, silent));
+    CHECK_ERR(verify_segment_header(index, header, data_addr, NULL, metadata, silent));
 
     if (data_len % 4 != 0) {
         FAIL_LOAD("unaligned segment length 0x%"PRIx32, data_len);
@@ -701,6 +731,27 @@ static size_t process_esp_app_desc_data(const uint32_t *src, bootloader_sha256_h
 }
 #endif // CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
 
+/* Checks on the esp_app_desc_t at the start of segment #0 of an app.
+   Sets processed_len to the number of bytes already added to the checksum and SHA-256 (secure_version check).
+*/
+static esp_err_t process_app_desc(const uint32_t *src, uint32_t data_addr, bootloader_sha256_handle_t sha_handle, uint32_t *checksum, esp_image_metadata_t *metadata, size_t *processed_len)
+{
+    *processed_len = 0;
+/* ESP32 doesn't have more memory and more efuse bits for block major version. */
+#if !CONFIG_IDF_TARGET_ESP32
+    const esp_app_desc_t *app_desc = (const esp_app_desc_t *)src;
+    esp_err_t ret = bootloader_common_check_efuse_blk_validity(app_desc->min_efuse_blk_rev_full, app_desc->max_efuse_blk_rev_full);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+#endif  // !CONFIG_IDF_TARGET_ESP32
+#if CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
+    ESP_LOGD(TAG, "additional anti-rollback check 0x%"PRIx32, data_addr);
+    *processed_len = process_esp_app_desc_data(src, sha_handle, checksum, metadata);
+#endif // CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
+    return ESP_OK;
+}
+
 static esp_err_t process_segment_data(int segment, intptr_t load_addr, uint32_t data_addr, uint32_t data_len, bool do_load, bootloader_sha256_handle_t sha_handle, uint32_t *checksum, esp_image_metadata_t *metadata)
 {
     // If we are not loading, and the checksum is empty, skip processing this
@@ -750,22 +801,15 @@ static esp_err_t process_segment_data(int segment, intptr_t load_addr, uint32_t
     // The esp_app_desc_t structure is located in DROM and is always in segment #0.
     // Anti-rollback check and efuse block version check should handle only Case I from above.
     if (segment == 0 && !is_bootloader(metadata->start_addr)) {
-/* ESP32 doesn't have more memory and more efuse bits for block major version. */
-#if !CONFIG_IDF_TARGET_ESP32
-        const esp_app_desc_t *app_desc = (const esp_app_desc_t *)src;
-        esp_err_t ret = bootloader_common_check_efuse_blk_validity(app_desc->min_efuse_blk_rev_full, app_desc->max_efuse_blk_rev_full);
+        size_t len;
+        esp_err_t ret = process_app_desc(src, data_addr, sha_handle, checksum, metadata, &len);
         if (ret != ESP_OK) {
             bootloader_munmap(data);
             return ret;
         }
-#endif  // !CONFIG_IDF_TARGET_ESP32
-#if CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
-        ESP_LOGD(TAG, "additional anti-rollback check 0x%"PRIx32, data_addr);
-        size_t len = process_esp_app_desc_data(src, sha_handle, checksum, metadata);
         data_len -= len;
         src += len / 4;
         // In BOOTLOADER_BUILD, for DROM (segment #0) we do not load it into dest (only map it), do_load = false.
-#endif // CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
     }
 
     for (size_t i = 0; i < data_len; i += 4) {
@@ -802,7 +846,7 @@ static esp_err_t process_segment_data(int segment, intptr_t load_addr, uint32_t
     return ESP_OK;
 }
 
-static esp_err_t verify_segment_header(int index, const esp_image_segment_header_t *segment, uint32_t segment_data_offs, esp_image_metadata_t *metadata, bool silent)
+static esp_err_t verify_segment_header(int index, const esp_image_segment_header_t *segment, uint32_t segment_data_offs, const esp_app_desc_t *app_desc, esp_image_metadata_t *metadata, bool silent)
 {
     if ((segment->data_len & 3) != 0
             || segment->data_len >= ESP_IMAGE_MAX_FLASH_ADDR_SIZE) {
@@ -821,9 +865,14 @@ static esp_err_t verify_segment_header(int index, const esp_image_segment_header
     /* ESP APP descriptor is present in the DROM segment #0 */
     if (index == 0 && !is_bootloader(metadata->start_addr)) {
         uint32_t mmu_page_size = 0, magic_word = 0;
-        const uint32_t mmu_page_size_offset = segment_data_offs + offsetof(esp_app_desc_t, mmu_page_size);
-        CHECK_ERR(bootloader_flash_read(segment_data_offs, &magic_word, sizeof(uint32_t), true));
-        CHECK_ERR(bootloader_flash_read(mmu_page_size_offset, &mmu_page_size, sizeof(uint32_t), true));
+        if (app_desc != NULL) {
+            magic_word = app_desc->magic_word;
+            mmu_page_size = app_desc->mmu_page_size;
+        } else {
+            const uint32_t mmu_page_size_offset = segment_data_offs + offsetof(esp_app_desc_t, mmu_page_size);
+            CHECK_ERR(bootloader_flash_read(segment_data_offs, &magic_word, sizeof(uint32_t), true));
+            CHECK_ERR(bootloader_flash_read(mmu_page_size_offset, &mmu_page_size, sizeof(uint32_t), true));
+        }
         // Extract only the lowest byte from mmu_page_size (as per image format)
         mmu_page_size &= 0xFF;
 
@@ -1156,6 +1205,304 @@ static esp_err_t verify_simple_hash(bootloader_sha256_handle_t sha_handle, esp_i
     return ESP_OK;
 }
 
+#if !NON_OS_BUILD
+typedef enum {
+    STREAM_IMAGE_HEADER,    /* collecting the image header */
+    STREAM_SEGMENT_HEADER,  /* collecting a segment header */
+    STREAM_APP_DESC,        /* collecting the esp_app_desc_t at the start of segment #0 of an app */
+    STREAM_SEGMENT_DATA,    /* passing segment data to the checksum and SHA-256 */
+    STREAM_DONE,            /* all segments processed, data following them is checked from flash */
+    STREAM_FROM_FLASH,      /* the data can't be checked on the fly, the partition is verified from flash */
+} stream_state_t;
+
+struct esp_image_stream {
+    esp_image_load_mode_t mode;
+    esp_partition_pos_t part;
+    esp_image_metadata_t data;
+    stream_state_t state;
+    esp_err_t err;                          /* first error found, reported by esp_image_verify_stream_finish() */
+    bool verify_sha;
+    bootloader_sha256_handle_t sha_handle;
+    uint32_t checksum_word;
+    uint32_t offset;                        /* offset in the image of the next byte passed */
+    int segment;                            /* index of the current segment */
+    uint32_t data_remain;                   /* bytes of the current segment data still to come */
+    uint8_t word[4];                        /* bytes of a checksum word split between two chunks */
+    size_t word_len;
+    size_t buf_len;                         /* bytes collected in buf */
+    size_t buf_need;                        /* bytes to collect in buf before processing them */
+    WORD_ALIGNED_ATTR uint8_t buf[sizeof(esp_app_desc_t)];
+};
+
+static void stream_collect(struct esp_image_stream *s, stream_state_t state, size_t len)
+{
+    s->state = state;
+    s->buf_len = 0;
+    s->buf_need = len;
+}
+
+static void stream_segment_data(struct esp_image_stream *s, const uint8_t *src, size_t len)
+{
+    if (s->sha_handle != NULL) {
+        bootloader_sha256_data(s->sha_handle, src, len);
+    }
+    // checksum words may be split between chunks
+    if (s->word_len > 0) {
+        size_t n = MIN(len, sizeof(s->word) - s->word_len);
+        memcpy(s->word + s->word_len, src, n);
+        s->word_len += n;
+        src += n;
+        len -= n;
+        if (s->word_len < sizeof(s->word)) {
+            return;
+        }
+        uint32_t w;
+        memcpy(&w, s->word, sizeof(w));
+        s->checksum_word ^= w;
+    }
+    for (; len >= sizeof(uint32_t); src += sizeof(uint32_t), len -= sizeof(uint32_t)) {
+        uint32_t w;
+        memcpy(&w, src, sizeof(w));
+        s->checksum_word ^= w;
+    }
+    memcpy(s->word, src, len);
+    s->word_len = len;
+}
+
+static esp_err_t stream_next_segment(struct esp_image_stream *s)
+{
+    bool silent = (s->mode == ESP_IMAGE_VERIFY_SILENT);
+    if (s->segment < s->data.image.segment_count) {
+        stream_collect(s, STREAM_SEGMENT_HEADER, sizeof(esp_image_segment_header_t));
+        return ESP_OK;
+    }
+    // Segments all processed, verify length
+    uint32_t end_addr = s->data.start_addr + s->offset;
+    if (end_addr < s->data.start_addr) {
+        FAIL_LOAD("image offset has wrapped");
+    }
+    s->data.image_len = s->offset;
+    s->state = STREAM_DONE;
+    return ESP_OK;
+err:
+    return ESP_ERR_IMAGE_INVALID;
+}
+
+static esp_err_t stream_segment_header(struct esp_image_stream *s, const esp_app_desc_t *app_desc)
+{
+    esp_err_t err;
+    bool silent = (s->mode == ESP_IMAGE_VERIFY_SILENT);
+    int index = s->segment;
+    const esp_image_segment_header_t *header = &s->data.segments[index];
+    uint32_t data_addr = s->data.segment_data[index];
+
+    CHECK_ERR(verify_segment_header(index, header, data_addr, app_desc, &s->data, silent));
+    if (header->data_len % 4 != 0) {
+        err = ESP_ERR_IMAGE_INVALID;
+        FAIL_LOAD("unaligned segment length 0x%"PRIx32, header->data_len);
+    }
+    if (!silent) {
+        ESP_LOGI(TAG, "segment %d: paddr=%08"PRIx32" vaddr=%08"PRIx32" size=%05"PRIx32"h (%6"PRIu32") %s",
+                 index, data_addr, header->load_addr,
+                 header->data_len, header->data_len,
+                 should_map(header->load_addr) ? "map" : "");
+    }
+    s->data_remain = header->data_len;
+    s->state = STREAM_SEGMENT_DATA;
+    if (app_desc != NULL) {
+        size_t len;
+        CHECK_ERR(process_app_desc((const uint32_t *)app_desc, data_addr, s->sha_handle, &s->checksum_word, &s->data, &len));
+        stream_segment_data(s, (const uint8_t *)app_desc + len, sizeof(esp_app_desc_t) - len);
+        s->data_remain -= sizeof(esp_app_desc_t);
+    }
+    if (s->data_remain == 0) {
+        s->segment++;
+        return stream_next_segment(s);
+    }
+    return ESP_OK;
+err:
+    return err;
+}
+
+/* Process the data collected for the current state */
+static esp_err_t stream_process(struct esp_image_stream *s)
+{
+    esp_err_t err;
+    bool silent = (s->mode == ESP_IMAGE_VERIFY_SILENT);
+    switch (s->state) {
+    case STREAM_IMAGE_HEADER:
+        memcpy(&s->data.image, s->buf, sizeof(esp_image_header_t));
+        CHECK_ERR(check_image_header(&s->data, s->verify_sha ? &s->sha_handle : NULL, true, silent));
+        s->segment = 0;
+        return stream_next_segment(s);
+    case STREAM_SEGMENT_HEADER: {
+        esp_image_segment_header_t *header = &s->data.segments[s->segment];
+        memcpy(header, s->buf, sizeof(esp_image_segment_header_t));
+        if (s->sha_handle != NULL) {
+            bootloader_sha256_data(s->sha_handle, header, sizeof(esp_image_segment_header_t));
+        }
+        s->data.segment_data[s->segment] = s->data.start_addr + s->offset;
+        if (s->segment == 0 && !is_bootloader(s->data.start_addr)) {
+            if (header->data_len < sizeof(esp_app_desc_t)) {
+                // not a valid app, leave the details to esp_image_verify()
+                s->state = STREAM_FROM_FLASH;
+                return ESP_OK;
+            }
+            stream_collect(s, STREAM_APP_DESC, sizeof(esp_app_desc_t));
+            return ESP_OK;
+        }
+        return stream_segment_header(s, NULL);
+    }
+    case STREAM_APP_DESC:
+        return stream_segment_header(s, (const esp_app_desc_t *)s->buf);
+    case STREAM_SEGMENT_DATA:
+        s->segment++;
+        return stream_next_segment(s);
+    default:
+        return ESP_OK;
+    }
+err:
+    return err;
+}
+
+esp_err_t esp_image_verify_stream_start(esp_image_load_mode_t mode, const esp_partition_pos_t *part, esp_image_stream_handle_t *out_handle)
+{
+    if (part == NULL || out_handle == NULL || (mode != ESP_IMAGE_VERIFY && mode != ESP_IMAGE_VERIFY_SILENT)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (part->size > ESP_IMAGE_MAX_FLASH_ADDR_SIZE) {
+        if (mode != ESP_IMAGE_VERIFY_SILENT) {
+            ESP_LOGE(TAG, "partition size 0x%"PRIx32" invalid, larger than 16MB", part->size);
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct esp_image_stream *s = calloc(1, sizeof(struct esp_image_stream));
+    if (s == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    s->mode = mode;
+    s->part = *part;
+    s->data.start_addr = part->offset;
+    s->verify_sha = should_verify_sha(part->offset, true);
+    s->checksum_word = ESP_ROM_CHECKSUM_INITIAL;
+    stream_collect(s, STREAM_IMAGE_HEADER, sizeof(esp_image_header_t));
+    *out_handle = s;
+    return ESP_OK;
+}
+
+esp_err_t esp_image_verify_stream_data(esp_image_stream_handle_t s, const void *data, size_t len)
+{
+    if (s == NULL || (data == NULL && len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint8_t *src = data;
+    while (len > 0 && s->err == ESP_OK && s->state < STREAM_DONE) {
+        size_t n;
+        bool complete;
+        if (s->state == STREAM_SEGMENT_DATA) {
+            n = MIN(len, s->data_remain);
+            stream_segment_data(s, src, n);
+            s->data_remain -= n;
+            complete = (s->data_remain == 0);
+        } else {
+            n = MIN(len, s->buf_need - s->buf_len);
+            memcpy(s->buf + s->buf_len, src, n);
+            s->buf_len += n;
+            complete = (s->buf_len == s->buf_need);
+        }
+        src += n;
+        len -= n;
+        s->offset += n;
+        if (complete) {
+            s->err = stream_process(s);
+        }
+    }
+    return s->err;
+}
+
+esp_err_t esp_image_verify_stream_finish(esp_image_stream_handle_t s, esp_image_metadata_t *data)
+{
+    if (s == NULL || data == NULL) {
+        esp_image_verify_stream_abort(s);
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = s->err;
+    bool silent = (s->mode == ESP_IMAGE_VERIFY_SILENT);
+#if (SECURE_BOOT_CHECK_SIGNATURE == 1)
+    uint8_t image_digest[ESP_SECURE_BOOT_DIGEST_LEN] = { [ 0 ... ESP_SECURE_BOOT_DIGEST_LEN - 1 ] = 0xEE };
+    uint8_t verified_digest[ESP_SECURE_BOOT_DIGEST_LEN] = { [ 0 ... ESP_SECURE_BOOT_DIGEST_LEN - 1 ] = 0x01 };
+#endif
+
+    if (err == ESP_OK && s->state != STREAM_DONE) {
+        // The data passed doesn't cover all the segments, verify what is in flash instead
+        ESP_LOGD(TAG, "verifying image @ 0x%"PRIx32" from flash", s->part.offset);
+        esp_image_load_mode_t mode = s->mode;
+        esp_partition_pos_t part = s->part;
+        esp_image_verify_stream_abort(s);
+        return esp_image_verify(mode, &part, data);
+    }
+    CHECK_ERR(err);
+
+    memcpy(data, &s->data, sizeof(esp_image_metadata_t));
+    bool skip_check_checksum = esp_cpu_dbgr_is_attached();
+    CHECK_ERR(process_checksum(s->sha_handle, s->checksum_word, data, silent, skip_check_checksum));
+    CHECK_ERR(process_appended_hash_and_sig(data, s->part.offset, s->part.size, true, silent));
+#if (SECURE_BOOT_CHECK_SIGNATURE == 1)
+    err = verify_image_digest(s->verify_sha, s->sha_handle, data, image_digest, verified_digest);
+#else
+    err = verify_image_digest(s->verify_sha, s->sha_handle, data, NULL, NULL);
+#endif
+    s->sha_handle = NULL; // verify_image_digest finishes sha_handle
+    if (err != ESP_OK) {
+        goto err;
+    }
+    esp_image_verify_stream_abort(s);
+    return ESP_OK;
+
+err:
+    if (err == ESP_OK) {
+        err = ESP_ERR_IMAGE_INVALID;
+    }
+    esp_image_verify_stream_abort(s);
+    // Prevent invalid/incomplete data leaking out
+    bzero(data, sizeof(esp_image_metadata_t));
+    return err;
+}
+
+void esp_image_verify_stream_abort(esp_image_stream_handle_t s)
+{
+    if (s == NULL) {
+        return;
+    }
+    if (s->sha_handle != NULL) {
+        // Need to finish the hash process to free the handle
+        bootloader_sha256_finish(s->sha_handle, NULL);
+    }
+    free(s);
+}
+
+#else // NON_OS_BUILD
+
+esp_err_t esp_image_verify_stream_start(esp_image_load_mode_t mode, const esp_partition_pos_t *part, esp_image_stream_handle_t *out_handle)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_image_verify_stream_data(esp_image_stream_handle_t handle, const void *data, size_t len)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_image_verify_stream_finish(esp_image_stream_handle_t handle, esp_image_metadata_t *data)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void esp_image_verify_stream_abort(esp_image_stream_handle_t handle)
+{
+}
+#endif // NON_OS_BUILD
+
 int esp_image_get_flash_size(esp_image_flash_size_t app_flash_size)
 {
     switch (app_flash_size) {
@@ -9,6 +9,9 @@
 
 #include <esp_types.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <sys/param.h>
 #include "string.h"
 
 #include "freertos/FreeRTOS.h"
@@ -54,6 +57,72 @@ TEST_CASE("Verify unit test app image", "[bootloader_support]")
     TEST_ASSERT_TRUE(data.image_len <= running->size);
 }
 
+static esp_err_t verify_stream_from_flash(const esp_partition_t *partition, const esp_partition_pos_t *pos, size_t chunk_len, uint32_t corrupt_offset, esp_image_metadata_t *data)
+{
+    uint8_t *buf = malloc(chunk_len);
+    TEST_ASSERT_NOT_NULL(buf);
+    esp_image_stream_handle_t stream;
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_image_verify_stream_start(ESP_IMAGE_VERIFY, pos, &stream));
+    // Pass the whole partition, data following the image is ignored
+    for (uint32_t offset = 0; offset < pos->size; offset += chunk_len) {
+        size_t len = MIN(chunk_len, pos->size - offset);
+        TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_partition_read(partition, offset, buf, len));
+        if (corrupt_offset >= offset && corrupt_offset < offset + len) {
+            buf[corrupt_offset - offset] ^= 0x01;
+        }
+        esp_image_verify_stream_data(stream, buf, len);
+    }
+    free(buf);
+    return esp_image_verify_stream_finish(stream, data);
+}
+
+TEST_CASE("Verify unit test app image on the fly", "[bootloader_support]")
+{
+    esp_image_metadata_t expected = { 0 };
+    esp_image_metadata_t data = { 0 };
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    TEST_ASSERT_NOT_EQUAL(NULL, running);
+    const esp_partition_pos_t running_pos  = {
+        .offset = running->address,
+        .size = running->size,
+    };
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_image_verify(ESP_IMAGE_VERIFY, &running_pos, &expected));
+
+    const size_t chunk_lens[] = { 4096, 1000, 13 };
+    for (size_t i = 0; i < sizeof(chunk_lens) / sizeof(chunk_lens[0]); i++) {
+        TEST_ASSERT_EQUAL_HEX(ESP_OK, verify_stream_from_flash(running, &running_pos, chunk_lens[i], UINT32_MAX, &data));
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &data, sizeof(esp_image_metadata_t));
+    }
+
+    // Data passed differs from the data in flash, in the last segment
+    uint32_t last = expected.image.segment_count - 1;
+    uint32_t corrupt_offset = expected.segment_data[last] - expected.start_addr + expected.segments[last].data_len / 2;
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, verify_stream_from_flash(running, &running_pos, 1000, corrupt_offset, &data));
+
+    // An unaligned segment length is rejected as soon as its header is passed, as esp_image_verify() does
+    uint32_t header_offset = expected.segment_data[last] - expected.start_addr - sizeof(esp_image_segment_header_t);
+    uint32_t stream_len = header_offset + sizeof(esp_image_segment_header_t);
+    uint8_t *image = malloc(stream_len);
+    TEST_ASSERT_NOT_NULL(image);
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_partition_read(running, 0, image, stream_len));
+    image[header_offset + offsetof(esp_image_segment_header_t, data_len)] ^= 0x01;
+    esp_image_stream_handle_t unaligned;
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_image_verify_stream_start(ESP_IMAGE_VERIFY, &running_pos, &unaligned));
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_image_verify_stream_data(unaligned, image, header_offset));
+    TEST_ASSERT_EQUAL_HEX(ESP_ERR_IMAGE_INVALID, esp_image_verify_stream_data(unaligned, image + header_offset, sizeof(esp_image_segment_header_t)));
+    TEST_ASSERT_EQUAL_HEX(ESP_ERR_IMAGE_INVALID, esp_image_verify_stream_finish(unaligned, &data));
+    free(image);
+
+    // A stream ending before the last segment falls back to verifying the partition in flash
+    esp_image_stream_handle_t stream;
+    uint8_t header[sizeof(esp_image_header_t)];
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_partition_read(running, 0, header, sizeof(header)));
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_image_verify_stream_start(ESP_IMAGE_VERIFY, &running_pos, &stream));
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_image_verify_stream_data(stream, header, sizeof(header)));
+    TEST_ASSERT_EQUAL_HEX(ESP_OK, esp_image_verify_stream_finish(stream, &data));
+    TEST_ASSERT_EQUAL_MEMORY(&expected, &data, sizeof(esp_image_metadata_t));
+}
+
 void check_label_search (int num_test, const char *list, const char *t_label, bool result)
 {
     // gen_esp32part.py trims up to 16 characters
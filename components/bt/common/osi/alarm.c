@@ -19,6 +19,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include "osi/alarm.h"
+#include "osi/alarm_wheel.h"
 #include "osi/allocator.h"
 #include "osi/list.h"
 #include "esp_timer.h"
@@ -27,12 +28,18 @@
 #include "osi/mutex.h"
 #include "bt_common.h"
 
+// All the alarms are kept in a hashed timing wheel (alarm_wheel.c) driven by a
+// single esp_timer, which is armed for the earliest deadline. Unused alarms are
+// kept in a free list.
+// Number of expired alarms dispatched per lock of the alarm mutex
+#define ALARM_WHEEL_BATCH           8
+
 typedef struct alarm_t {
-    /* timer id point to here */
-    esp_timer_handle_t alarm_hdl;
+    alarm_wheel_node_t node;    // must be first, expired nodes are cast back to alarms
+    struct alarm_t *free_next;
     osi_alarm_callback_t cb;
     void *cb_data;
-    int64_t deadline_us;
+    bool in_use;
 } osi_alarm_t;
 
 enum {
@@ -49,8 +56,40 @@ static struct alarm_t alarm_cbs[ALARM_CBS_NUM];
 static struct alarm_t *alarm_cbs;
 #endif
 
+static struct alarm_t *alarm_free_list;
+static alarm_wheel_t alarm_wheel;
+// Deadline the wheel timer is armed for, INT64_MAX when stopped
+static int64_t alarm_wheel_next_us;
+static esp_timer_handle_t alarm_wheel_timer;
+
 static osi_alarm_err_t alarm_free(osi_alarm_t *alarm);
 static osi_alarm_err_t alarm_set(osi_alarm_t *alarm, period_ms_t timeout, bool is_periodic);
+static void alarm_wheel_handler(void *arg);
+
+static void alarm_wheel_arm(int64_t deadline_us, int64_t now_us)
+{
+    esp_timer_stop(alarm_wheel_timer);
+    esp_err_t stat = esp_timer_start_once(alarm_wheel_timer, (deadline_us > now_us) ? (uint64_t)(deadline_us - now_us) : 0);
+    if (stat != ESP_OK) {
+        OSI_TRACE_ERROR("%s failed to start timer, err 0x%x\n", __func__, stat);
+        alarm_wheel_next_us = INT64_MAX;
+        return;
+    }
+    alarm_wheel_next_us = deadline_us;
+}
+
+// Arms the wheel timer for the earliest deadline, stops it if the wheel is empty
+static void alarm_wheel_schedule(int64_t now_us)
+{
+    int64_t next_us = alarm_wheel_next_deadline(&alarm_wheel);
+
+    if (next_us == INT64_MAX) {
+        esp_timer_stop(alarm_wheel_timer);
+        alarm_wheel_next_us = INT64_MAX;
+        return;
+    }
+    alarm_wheel_arm(next_us, now_us);
+}
 
 int osi_alarm_create_mux(void)
 {
@@ -88,7 +127,29 @@ void osi_alarm_init(void)
     }
 #endif
 
+    esp_timer_create_args_t tca = {0};
+    tca.callback = alarm_wheel_handler;
+    tca.dispatch_method = ESP_TIMER_TASK;
+    tca.name = "osi_alarm";
+
+    esp_err_t stat = esp_timer_create(&tca, &alarm_wheel_timer);
+    if (stat != ESP_OK) {
+        OSI_TRACE_ERROR("%s failed to create timer, err 0x%x\n", __func__, stat);
+#if (BT_BLE_DYNAMIC_ENV_MEMORY == TRUE)
+        osi_free(alarm_cbs);
+        alarm_cbs = NULL;
+#endif
+        goto end;
+    }
+
     memset(alarm_cbs, 0x00, sizeof(osi_alarm_t) * ALARM_CBS_NUM);
+    alarm_free_list = NULL;
+    for (int i = ALARM_CBS_NUM - 1; i >= 0; i--) {
+        alarm_cbs[i].free_next = alarm_free_list;
+        alarm_free_list = &alarm_cbs[i];
+    }
+    alarm_wheel_init(&alarm_wheel, esp_timer_get_time());
+    alarm_wheel_next_us = INT64_MAX;
     alarm_state = ALARM_STATE_OPEN;
 
 end:
@@ -106,11 +167,16 @@ void osi_alarm_deinit(void)
     }
 
     for (int i = 0; i < ALARM_CBS_NUM; i++) {
-        if (alarm_cbs[i].alarm_hdl != NULL) {
+        if (alarm_cbs[i].in_use) {
             alarm_free(&alarm_cbs[i]);
         }
     }
 
+    esp_timer_stop(alarm_wheel_timer);
+    esp_timer_delete(alarm_wheel_timer);
+    alarm_wheel_timer = NULL;
+    alarm_free_list = NULL;
+
 #if (BT_BLE_DYNAMIC_ENV_MEMORY == TRUE)
     osi_free(alarm_cbs);
     alarm_cbs = NULL;
@@ -122,34 +188,40 @@ end:
     osi_mutex_unlock(&alarm_mutex);
 }
 
-static struct alarm_t *alarm_cbs_lookfor_available(void)
+static void alarm_wheel_handler(void *arg)
 {
-    int i;
-
-    for (i = 0; i < ALARM_CBS_NUM; i++) {
-        if (alarm_cbs[i].alarm_hdl == NULL) { //available
-            OSI_TRACE_DEBUG("%s %d %p\n", __func__, i, &alarm_cbs[i]);
-            return &alarm_cbs[i];
+    alarm_wheel_node_t *expired[ALARM_WHEEL_BATCH];
+    btc_alarm_args_t fired[ALARM_WHEEL_BATCH];
+    size_t num;
+
+    // The callbacks are dispatched without the mutex, so that a full BTC queue
+    // cannot block the tasks arming alarms.
+    do {
+        osi_mutex_lock(&alarm_mutex, OSI_MUTEX_MAX_TIMEOUT);
+        if (alarm_state != ALARM_STATE_OPEN) {
+            OSI_TRACE_WARNING("%s, invalid state %d\n", __func__, alarm_state);
+            osi_mutex_unlock(&alarm_mutex);
+            return;
         }
-    }
-
-    return NULL;
-}
-
-static void alarm_cb_handler(struct alarm_t *alarm)
-{
-    OSI_TRACE_DEBUG("TimerID %p\n", alarm);
-    if (alarm_state != ALARM_STATE_OPEN) {
-        OSI_TRACE_WARNING("%s, invalid state %d\n", __func__, alarm_state);
-        return;
-    }
-    btc_msg_t msg = {0};
-    btc_alarm_args_t arg;
-    msg.sig = BTC_SIG_API_CALL;
-    msg.pid = BTC_PID_ALARM;
-    arg.cb = alarm->cb;
-    arg.cb_data = alarm->cb_data;
-    btc_transfer_context(&msg, &arg, sizeof(btc_alarm_args_t), NULL, NULL);
+        int64_t now_us = esp_timer_get_time();
+        num = alarm_wheel_expire(&alarm_wheel, now_us, expired, ALARM_WHEEL_BATCH);
+        for (size_t i = 0; i < num; i++) {
+            fired[i].cb = ((struct alarm_t *)expired[i])->cb;
+            fired[i].cb_data = ((struct alarm_t *)expired[i])->cb_data;
+        }
+        if (num < ALARM_WHEEL_BATCH) {
+            alarm_wheel_schedule(now_us);
+        }
+        osi_mutex_unlock(&alarm_mutex);
+
+        for (size_t i = 0; i < num; i++) {
+            OSI_TRACE_DEBUG("%s cb %p\n", __func__, fired[i].cb);
+            btc_msg_t msg = {0};
+            msg.sig = BTC_SIG_API_CALL;
+            msg.pid = BTC_PID_ALARM;
+            btc_transfer_context(&msg, &fired[i], sizeof(btc_alarm_args_t), NULL, NULL);
+        }
+    } while (num == ALARM_WHEEL_BATCH);
 }
 
 osi_alarm_t *osi_alarm_new(const char *alarm_name, osi_alarm_callback_t callback, void *data, period_ms_t timer_expire)
@@ -165,30 +237,20 @@ osi_alarm_t *osi_alarm_new(const char *alarm_name, osi_alarm_callback_t callback
         goto end;
     }
 
-    timer_id = alarm_cbs_lookfor_available();
+    timer_id = alarm_free_list;
 
     if (!timer_id) {
         OSI_TRACE_ERROR("%s alarm_cbs exhausted\n", __func__);
         timer_id = NULL;
         goto end;
     }
+    alarm_free_list = timer_id->free_next;
+    OSI_TRACE_DEBUG("%s %s %p\n", __func__, alarm_name ? alarm_name : "", timer_id);
 
-    esp_timer_create_args_t tca = {0};
-    tca.callback = (esp_timer_cb_t)alarm_cb_handler;
-    tca.arg = timer_id;
-    tca.dispatch_method = ESP_TIMER_TASK;
-    tca.name = alarm_name;
-
+    memset(timer_id, 0, sizeof(osi_alarm_t));
     timer_id->cb = callback;
     timer_id->cb_data = data;
-    timer_id->deadline_us = 0;
-
-    esp_err_t stat = esp_timer_create(&tca, &timer_id->alarm_hdl);
-    if (stat != ESP_OK) {
-        OSI_TRACE_ERROR("%s failed to create timer, err 0x%x\n", __func__, stat);
-        timer_id = NULL;
-        goto end;
-    }
+    timer_id->in_use = true;
 
 end:
     osi_mutex_unlock(&alarm_mutex);
@@ -197,18 +259,17 @@ end:
 
 static osi_alarm_err_t alarm_free(osi_alarm_t *alarm)
 {
-    if (!alarm || alarm->alarm_hdl == NULL) {
+    if (!alarm || !alarm->in_use) {
         OSI_TRACE_ERROR("%s null\n", __func__);
         return OSI_ALARM_ERR_INVALID_ARG;
     }
-    esp_timer_stop(alarm->alarm_hdl);
-    esp_err_t stat = esp_timer_delete(alarm->alarm_hdl);
-    if (stat != ESP_OK) {
-        OSI_TRACE_ERROR("%s failed to delete timer, err 0x%x\n", __func__, stat);
-        return OSI_ALARM_ERR_FAIL;
+    if (alarm->node.armed) {
+        alarm_wheel_remove(&alarm_wheel, &alarm->node);
     }
 
     memset(alarm, 0, sizeof(osi_alarm_t));
+    alarm->free_next = alarm_free_list;
+    alarm_free_list = alarm;
     return OSI_ALARM_ERR_PASS;
 }
 
@@ -240,25 +301,32 @@ static osi_alarm_err_t alarm_set(osi_alarm_t *alarm, period_ms_t timeout, bool i
         goto end;
     }
 
-    if (!alarm || alarm->alarm_hdl == NULL) {
+    if (!alarm || !alarm->in_use) {
         OSI_TRACE_ERROR("%s null\n", __func__);
         ret = OSI_ALARM_ERR_INVALID_ARG;
         goto end;
     }
 
-    int64_t timeout_us = 1000 * (int64_t)timeout;
-    esp_err_t stat;
-    if (is_periodic) {
-        stat = esp_timer_start_periodic(alarm->alarm_hdl, (uint64_t)timeout_us);
-    } else {
-        stat = esp_timer_start_once(alarm->alarm_hdl, (uint64_t)timeout_us);
-    }
-    if (stat != ESP_OK) {
-        OSI_TRACE_ERROR("%s failed to start timer, err 0x%x\n", __func__, stat);
+    if (is_periodic && timeout == 0) {
+        OSI_TRACE_ERROR("%s zero period\n", __func__);
         ret = OSI_ALARM_ERR_FAIL;
         goto end;
     }
-    alarm->deadline_us = is_periodic ? 0 : (timeout_us + esp_timer_get_time());
+
+    if (alarm->node.armed) {
+        alarm_wheel_remove(&alarm_wheel, &alarm->node);
+    }
+
+    int64_t timeout_us = 1000 * (int64_t)timeout;
+    int64_t now_us = esp_timer_get_time();
+    alarm->node.deadline_us = now_us + timeout_us;
+    alarm->node.period_us = is_periodic ? (uint64_t)timeout_us : 0;
+    alarm_wheel_add(&alarm_wheel, &alarm->node, now_us);
+
+    // The wheel timer only needs to be re-armed for a new earliest deadline
+    if (alarm->node.deadline_us < alarm_wheel_next_us) {
+        alarm_wheel_arm(alarm->node.deadline_us, now_us);
+    }
 
 end:
     osi_mutex_unlock(&alarm_mutex);
@@ -285,18 +353,24 @@ osi_alarm_err_t osi_alarm_cancel(osi_alarm_t *alarm)
         goto end;
     }
 
-    if (!alarm || alarm->alarm_hdl == NULL) {
+    if (!alarm || !alarm->in_use) {
         OSI_TRACE_ERROR("%s null\n", __func__);
         ret = OSI_ALARM_ERR_INVALID_ARG;
         goto end;
     }
 
-    esp_err_t stat = esp_timer_stop(alarm->alarm_hdl);
-    if (stat != ESP_OK) {
-        OSI_TRACE_DEBUG("%s failed to stop timer, err 0x%x\n", __func__, stat);
+    if (!alarm->node.armed) {
+        OSI_TRACE_DEBUG("%s alarm not armed\n", __func__);
         ret = OSI_ALARM_ERR_FAIL;
         goto end;
     }
+    alarm_wheel_remove(&alarm_wheel, &alarm->node);
+
+    // An earlier wheel timer expiry is harmless, it is only stopped once the wheel is empty
+    if (alarm_wheel.num == 0) {
+        esp_timer_stop(alarm_wheel_timer);
+        alarm_wheel_next_us = INT64_MAX;
+    }
 end:
     osi_mutex_unlock(&alarm_mutex);
     return ret;
@@ -308,7 +382,9 @@ period_ms_t osi_alarm_get_remaining_ms(const osi_alarm_t *alarm)
     int64_t dt_us = 0;
 
     osi_mutex_lock(&alarm_mutex, OSI_MUTEX_MAX_TIMEOUT);
-    dt_us = alarm->deadline_us - esp_timer_get_time();
+    if (alarm->node.armed && alarm->node.period_us == 0) {
+        dt_us = alarm->node.deadline_us - esp_timer_get_time();
+    }
     osi_mutex_unlock(&alarm_mutex);
 
     return (dt_us > 0) ? (period_ms_t)(dt_us / 1000) : 0;
@@ -323,9 +399,5 @@ bool osi_alarm_is_active(osi_alarm_t *alarm)
 {
     assert(alarm != NULL);
 
-    if (alarm->alarm_hdl != NULL) {
-        return esp_timer_is_active(alarm->alarm_hdl);
-    }
-
-    return false;
+    return alarm->in_use && alarm->node.armed;
 }
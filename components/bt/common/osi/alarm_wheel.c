@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "osi/alarm_wheel.h"
+
+static inline uint64_t alarm_wheel_tick_of(int64_t time_us)
+{
+    return (uint64_t)time_us >> ALARM_WHEEL_TICK_SHIFT;
+}
+
+static void alarm_wheel_link(alarm_wheel_t *wheel, alarm_wheel_node_t *node)
+{
+    size_t slot = alarm_wheel_tick_of(node->deadline_us) & (ALARM_WHEEL_SLOTS - 1);
+
+    node->next = wheel->slots[slot];
+    if (node->next) {
+        node->next->pprev = &node->next;
+    }
+    node->pprev = &wheel->slots[slot];
+    wheel->slots[slot] = node;
+    wheel->map[slot / 32] |= 1U << (slot % 32);
+    node->armed = true;
+    wheel->num++;
+}
+
+static void alarm_wheel_unlink(alarm_wheel_t *wheel, alarm_wheel_node_t *node)
+{
+    size_t slot = alarm_wheel_tick_of(node->deadline_us) & (ALARM_WHEEL_SLOTS - 1);
+
+    *node->pprev = node->next;
+    if (node->next) {
+        node->next->pprev = node->pprev;
+    }
+    if (wheel->slots[slot] == NULL) {
+        wheel->map[slot / 32] &= ~(1U << (slot % 32));
+    }
+    node->next = NULL;
+    node->pprev = NULL;
+    node->armed = false;
+    wheel->num--;
+}
+
+void alarm_wheel_init(alarm_wheel_t *wheel, int64_t now_us)
+{
+    memset(wheel, 0x00, sizeof(alarm_wheel_t));
+    wheel->tick = alarm_wheel_tick_of(now_us);
+}
+
+void alarm_wheel_add(alarm_wheel_t *wheel, alarm_wheel_node_t *node, int64_t now_us)
+{
+    if (wheel->num == 0) {
+        wheel->tick = alarm_wheel_tick_of(now_us);
+    }
+    alarm_wheel_link(wheel, node);
+}
+
+void alarm_wheel_remove(alarm_wheel_t *wheel, alarm_wheel_node_t *node)
+{
+    alarm_wheel_unlink(wheel, node);
+}
+
+size_t alarm_wheel_expire(alarm_wheel_t *wheel, int64_t now_us, alarm_wheel_node_t **fired, size_t max_num)
+{
+    uint64_t now_tick = alarm_wheel_tick_of(now_us);
+    size_t num = 0;
+
+    for (size_t i = 0; wheel->tick + i <= now_tick && i < ALARM_WHEEL_SLOTS; i++) {
+        size_t slot = (wheel->tick + i) & (ALARM_WHEEL_SLOTS - 1);
+        alarm_wheel_node_t *next;
+
+        for (alarm_wheel_node_t *node = wheel->slots[slot]; node != NULL; node = next) {
+            next = node->next;
+            if (node->deadline_us > now_us) {
+                continue;
+            }
+            if (num == max_num) {
+                wheel->tick += i;
+                return num;
+            }
+            fired[num++] = node;
+            alarm_wheel_unlink(wheel, node);
+            if (node->period_us) {
+                node->deadline_us += node->period_us;
+                if (node->deadline_us <= now_us) {
+                    node->deadline_us = now_us + node->period_us;
+                }
+                alarm_wheel_link(wheel, node);
+            }
+        }
+    }
+    wheel->tick = now_tick;
+
+    return num;
+}
+
+// Slots are visited in tick order for one rotation, the first node due in the rotation
+// it is visited in is the earliest one. Otherwise all the nodes have been visited and
+// the minimum is used.
+int64_t alarm_wheel_next_deadline(const alarm_wheel_t *wheel)
+{
+    int64_t next_us = INT64_MAX;
+
+    for (size_t i = 0; i < ALARM_WHEEL_SLOTS && wheel->num > 0; i++) {
+        uint64_t tick = wheel->tick + i;
+        size_t slot = tick & (ALARM_WHEEL_SLOTS - 1);
+        int64_t round_us = INT64_MAX;
+
+        if ((wheel->map[slot / 32] & (1U << (slot % 32))) == 0) {
+            continue;
+        }
+        for (const alarm_wheel_node_t *node = wheel->slots[slot]; node != NULL; node = node->next) {
+            if (node->deadline_us < next_us) {
+                next_us = node->deadline_us;
+            }
+            if (alarm_wheel_tick_of(node->deadline_us) <= tick && node->deadline_us < round_us) {
+                round_us = node->deadline_us;
+            }
+        }
+        if (round_us != INT64_MAX) {
+            return round_us;
+        }
+    }
+
+    return next_us;
+}
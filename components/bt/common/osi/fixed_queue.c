@@ -23,9 +23,16 @@
 #include "osi/mutex.h"
 #include "osi/semaphore.h"
 
+// Initial number of slots of the ring array, it is doubled when full up to the
+// capacity of the queue, so that idle queues do not hold |capacity| slots.
+#define FIXED_QUEUE_INITIAL_SIZE    8
+
 typedef struct fixed_queue_t {
 
-    list_t *list;
+    void **items;       // ring array of |size| slots
+    size_t size;
+    size_t head;        // slot of the first element
+    size_t length;
     osi_sem_t enqueue_sem;
     osi_sem_t dequeue_sem;
     osi_mutex_t lock;
@@ -34,6 +41,49 @@ typedef struct fixed_queue_t {
     fixed_queue_cb dequeue_ready;
 } fixed_queue_t;
 
+static inline size_t fixed_queue_slot(const fixed_queue_t *queue, size_t index)
+{
+    index += queue->head;
+    return index < queue->size ? index : index - queue->size;
+}
+
+// Grows the ring array of a full |queue|. Must be called with the lock held.
+static bool fixed_queue_grow(fixed_queue_t *queue)
+{
+    size_t size = queue->size ? queue->size * 2 : FIXED_QUEUE_INITIAL_SIZE;
+    void **items;
+
+    if (size > queue->capacity) {
+        size = queue->capacity;
+    }
+    if (size <= queue->size) {
+        return false;
+    }
+
+    items = osi_malloc(size * sizeof(void *));
+    if (!items) {
+        return false;
+    }
+    for (size_t i = 0; i < queue->length; i++) {
+        items[i] = queue->items[fixed_queue_slot(queue, i)];
+    }
+    osi_free(queue->items);
+    queue->items = items;
+    queue->size = size;
+    queue->head = 0;
+
+    return true;
+}
+
+// Removes the element at |index| from |queue|, shifting the following ones.
+// Must be called with the lock held.
+static void fixed_queue_remove_at(fixed_queue_t *queue, size_t index)
+{
+    for (size_t i = index; i + 1 < queue->length; i++) {
+        queue->items[fixed_queue_slot(queue, i)] = queue->items[fixed_queue_slot(queue, i + 1)];
+    }
+    queue->length--;
+}
 
 fixed_queue_t *fixed_queue_new(size_t capacity)
 {
@@ -45,12 +95,10 @@ fixed_queue_t *fixed_queue_new(size_t capacity)
     osi_mutex_new(&ret->lock);
     ret->capacity = capacity;
 
-    ret->list = list_new(NULL);
-    if (!ret->list) {
+    if (capacity > 0 && !fixed_queue_grow(ret)) {
         goto error;
     }
 
-
     osi_sem_new(&ret->enqueue_sem, capacity, capacity);
     if (!ret->enqueue_sem) {
         goto error;
@@ -70,8 +118,6 @@ error:;
 
 void fixed_queue_free(fixed_queue_t *queue, fixed_queue_free_cb free_cb)
 {
-    const list_node_t *node;
-
     if (queue == NULL) {
 	    return;
 	}
@@ -79,12 +125,12 @@ void fixed_queue_free(fixed_queue_t *queue, fixed_queue_free_cb free_cb)
     fixed_queue_unregister_dequeue(queue);
 
     if (free_cb) {
-        for (node = list_begin(queue->list); node != list_end(queue->list); node = list_next(node)) {
-            free_cb(list_node(node));
+        for (size_t i = 0; i < queue->length; i++) {
+            free_cb(queue->items[fixed_queue_slot(queue, i)]);
         }
     }
 
-    list_free(queue->list);
+    osi_free(queue->items);
     osi_sem_free(&queue->enqueue_sem);
     osi_sem_free(&queue->dequeue_sem);
     osi_mutex_free(&queue->lock);
@@ -100,7 +146,7 @@ bool fixed_queue_is_empty(fixed_queue_t *queue)
     }
 
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    is_empty = list_is_empty(queue->list);
+    is_empty = queue->length == 0;
     osi_mutex_unlock(&queue->lock);
 
     return is_empty;
@@ -115,7 +161,7 @@ size_t fixed_queue_length(fixed_queue_t *queue)
     }
 
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    length = list_length(queue->list);
+    length = queue->length;
     osi_mutex_unlock(&queue->lock);
 
     return length;
@@ -139,11 +185,20 @@ bool fixed_queue_enqueue(fixed_queue_t *queue, void *data, uint32_t timeout)
     }
 
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    status = list_append(queue->list, data); //Check whether enqueued success
+    // The enqueue semaphore guarantees length < capacity, the array only
+    // needs to grow while it is smaller than the capacity
+    if (queue->length < queue->size || fixed_queue_grow(queue)) {
+        queue->items[fixed_queue_slot(queue, queue->length)] = data;
+        queue->length++;
+        status = true;
+    }
     osi_mutex_unlock(&queue->lock);
 
-    if(status == true )
+    if (status == true) {
         osi_sem_give(&queue->dequeue_sem);
+    } else {
+        osi_sem_give(&queue->enqueue_sem);
+    }
 
     return status;
 }
@@ -159,8 +214,9 @@ void *fixed_queue_dequeue(fixed_queue_t *queue, uint32_t timeout)
     }
 
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    ret = list_front(queue->list);
-    list_remove(queue->list, ret);
+    ret = queue->items[queue->head];
+    queue->head = fixed_queue_slot(queue, 1);
+    queue->length--;
     osi_mutex_unlock(&queue->lock);
 
     osi_sem_give(&queue->enqueue_sem);
@@ -169,6 +225,11 @@ void *fixed_queue_dequeue(fixed_queue_t *queue, uint32_t timeout)
 }
 
 void *fixed_queue_try_peek_first(fixed_queue_t *queue)
+{
+    return fixed_queue_try_peek_at(queue, 0);
+}
+
+void *fixed_queue_try_peek_last(fixed_queue_t *queue)
 {
     void *ret = NULL;
 
@@ -177,13 +238,13 @@ void *fixed_queue_try_peek_first(fixed_queue_t *queue)
     }
 
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    ret = list_is_empty(queue->list) ? NULL : list_front(queue->list);
+    ret = queue->length == 0 ? NULL : queue->items[fixed_queue_slot(queue, queue->length - 1)];
     osi_mutex_unlock(&queue->lock);
 
     return ret;
 }
 
-void *fixed_queue_try_peek_last(fixed_queue_t *queue)
+void *fixed_queue_try_peek_at(fixed_queue_t *queue, size_t index)
 {
     void *ret = NULL;
 
@@ -192,7 +253,7 @@ void *fixed_queue_try_peek_last(fixed_queue_t *queue)
     }
 
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    ret = list_is_empty(queue->list) ? NULL : list_back(queue->list);
+    ret = index < queue->length ? queue->items[fixed_queue_slot(queue, index)] : NULL;
     osi_mutex_unlock(&queue->lock);
 
     return ret;
@@ -207,10 +268,14 @@ void *fixed_queue_try_remove_from_queue(fixed_queue_t *queue, void *data)
     }
 
     osi_mutex_lock(&queue->lock, OSI_MUTEX_MAX_TIMEOUT);
-    if (list_contains(queue->list, data) &&
-            osi_sem_take(&queue->dequeue_sem, 0) == 0) {
-        removed = list_remove(queue->list, data);
-        assert(removed);
+    for (size_t i = 0; i < queue->length; i++) {
+        if (queue->items[fixed_queue_slot(queue, i)] == data) {
+            if (osi_sem_take(&queue->dequeue_sem, 0) == 0) {
+                fixed_queue_remove_at(queue, i);
+                removed = true;
+            }
+            break;
+        }
     }
     osi_mutex_unlock(&queue->lock);
 
@@ -222,15 +287,6 @@ void *fixed_queue_try_remove_from_queue(fixed_queue_t *queue, void *data)
     return NULL;
 }
 
-list_t *fixed_queue_get_list(fixed_queue_t *queue)
-{
-    assert(queue != NULL);
-
-    // NOTE: This function is not thread safe, and there is no point for
-    // calling osi_mutex_lock() / osi_mutex_unlock()
-    return queue->list;
-}
-
 void fixed_queue_register_dequeue(fixed_queue_t *queue, fixed_queue_cb ready_cb)
 {
     assert(queue != NULL);
@@ -17,19 +17,25 @@
  ******************************************************************************/
 
 #include "bt_common.h"
-#include "osi/list.h"
 #include "osi/hash_map.h"
 #include "osi/allocator.h"
 
-struct hash_map_t;
+// Entries are stored in place in an open addressing table with linear probing.
+// A slot is free when its data is NULL, hash_map_set() does not accept NULL data.
+// Erased entries are filled by shifting the following entries of their probe
+// sequence back, so that lookups never need tombstones.
+
+// Minimum table size, in log2 of the number of slots
+#define HASH_MAP_MIN_SLOT_BITS      2
+// Maximum load factor, in 1/4
+#define HASH_MAP_MAX_LOAD_QUARTERS  3
 
-typedef struct hash_map_bucket_t {
-    list_t *list;
-} hash_map_bucket_t;
+struct hash_map_t;
 
 typedef struct hash_map_t {
-    hash_map_bucket_t *bucket;
-    size_t num_bucket;
+    hash_map_entry_t *slot;
+    size_t num_slot;            // power of two
+    uint8_t slot_bits;          // log2(num_slot)
     size_t hash_size;
     hash_index_fn hash_fn;
     key_free_fn key_fn;
@@ -37,13 +43,68 @@ typedef struct hash_map_t {
     key_equality_fn keys_are_equal;
 } hash_map_t;
 
-// Hidden constructor for list, only to be used by us.
-list_t *list_new_internal(list_free_cb callback);
-
-static void bucket_free_(void *data);
 static bool default_key_equality(const void *x, const void *y);
-static hash_map_entry_t *find_bucket_entry_(list_t *hash_bucket_list,
-        const void *key);
+
+// Fibonacci hashing of the user hash, the table size being a power of two
+// would otherwise only use its low bits.
+static inline size_t hash_slot_(const hash_map_t *hash_map, const void *key)
+{
+    uint64_t hash = hash_map->hash_fn(key);
+    uint32_t folded = (uint32_t)(hash ^ (hash >> 32));
+
+    return (folded * 2654435769U) >> (32 - hash_map->slot_bits);
+}
+
+static inline size_t next_slot_(const hash_map_t *hash_map, size_t index)
+{
+    return (index + 1) & (hash_map->num_slot - 1);
+}
+
+static hash_map_entry_t *find_entry_(const hash_map_t *hash_map, const void *key)
+{
+    for (size_t i = hash_slot_(hash_map, key); hash_map->slot[i].data != NULL; i = next_slot_(hash_map, i)) {
+        if (hash_map->keys_are_equal(hash_map->slot[i].key, key)) {
+            return &hash_map->slot[i];
+        }
+    }
+    return NULL;
+}
+
+static void insert_entry_(hash_map_t *hash_map, const void *key, void *data)
+{
+    size_t i = hash_slot_(hash_map, key);
+
+    while (hash_map->slot[i].data != NULL) {
+        i = next_slot_(hash_map, i);
+    }
+    hash_map->slot[i].key = key;
+    hash_map->slot[i].data = data;
+    hash_map->slot[i].hash_map = hash_map;
+}
+
+static bool alloc_slots_(hash_map_t *hash_map, uint8_t slot_bits)
+{
+    hash_map_entry_t *old_slot = hash_map->slot;
+    size_t old_num_slot = hash_map->num_slot;
+    hash_map_entry_t *slot = osi_calloc(sizeof(hash_map_entry_t) << slot_bits);
+
+    if (slot == NULL) {
+        return false;
+    }
+
+    hash_map->slot = slot;
+    hash_map->slot_bits = slot_bits;
+    hash_map->num_slot = (size_t)1 << slot_bits;
+
+    for (size_t i = 0; i < old_num_slot; i++) {
+        if (old_slot[i].data != NULL) {
+            insert_entry_(hash_map, old_slot[i].key, old_slot[i].data);
+        }
+    }
+    osi_free(old_slot);
+
+    return true;
+}
 
 // Hidden constructor, only to be used by the allocation tracker. Behaves the same as
 // |hash_map_new|, except you get to specify the allocator.
@@ -66,9 +127,12 @@ hash_map_t *hash_map_new_internal(
     hash_map->data_fn = data_fn;
     hash_map->keys_are_equal = equality_fn ? equality_fn : default_key_equality;
 
-    hash_map->num_bucket = num_bucket;
-    hash_map->bucket = osi_calloc(sizeof(hash_map_bucket_t) * num_bucket);
-    if (hash_map->bucket == NULL) {
+    // Size the table so that |num_bucket| elements fit below the maximum load factor
+    uint8_t slot_bits = HASH_MAP_MIN_SLOT_BITS;
+    while (((size_t)HASH_MAP_MAX_LOAD_QUARTERS << slot_bits) / 4 < num_bucket) {
+        slot_bits++;
+    }
+    if (!alloc_slots_(hash_map, slot_bits)) {
         osi_free(hash_map);
         return NULL;
     }
@@ -91,7 +155,7 @@ void hash_map_free(hash_map_t *hash_map)
         return;
     }
     hash_map_clear(hash_map);
-    osi_free(hash_map->bucket);
+    osi_free(hash_map->slot);
     osi_free(hash_map);
 }
 
@@ -108,7 +172,7 @@ size_t hash_map_size(const hash_map_t *hash_map) {
 
 size_t hash_map_num_buckets(const hash_map_t *hash_map) {
   assert(hash_map != NULL);
-  return hash_map->num_bucket;
+  return hash_map->num_slot;
 }
 */
 
@@ -116,11 +180,7 @@ bool hash_map_has_key(const hash_map_t *hash_map, const void *key)
 {
     assert(hash_map != NULL);
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
-
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
-    return (hash_map_entry != NULL);
+    return (find_entry_(hash_map, key) != NULL);
 }
 
 bool hash_map_set(hash_map_t *hash_map, const void *key, void *data)
@@ -128,68 +188,74 @@ bool hash_map_set(hash_map_t *hash_map, const void *key, void *data)
     assert(hash_map != NULL);
     assert(data != NULL);
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
+    hash_map_entry_t *hash_map_entry = find_entry_(hash_map, key);
+
+    if (hash_map_entry) {
+        hash_map_entry_t old = *hash_map_entry;
 
-    if (hash_map->bucket[hash_key].list == NULL) {
-        hash_map->bucket[hash_key].list = list_new_internal(bucket_free_);
-        if (hash_map->bucket[hash_key].list == NULL) {
-            return false;
+        hash_map_entry->key = key;
+        hash_map_entry->data = data;
+        if (hash_map->key_fn) {
+            hash_map->key_fn((void *)old.key);
         }
+        if (hash_map->data_fn) {
+            hash_map->data_fn(old.data);
+        }
+        return true;
     }
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
-
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
 
-    if (hash_map_entry) {
-        // Calls hash_map callback to delete the hash_map_entry.
-        bool rc = list_remove(hash_bucket_list, hash_map_entry);
-        assert(rc == true);
-        (void)rc;
-    } else {
-        hash_map->hash_size++;
-    }
-    hash_map_entry = osi_calloc(sizeof(hash_map_entry_t));
-    if (hash_map_entry == NULL) {
+    if ((hash_map->hash_size + 1) * 4 > hash_map->num_slot * HASH_MAP_MAX_LOAD_QUARTERS &&
+            !alloc_slots_(hash_map, hash_map->slot_bits + 1)) {
         return false;
     }
 
-    hash_map_entry->key = key;
-    hash_map_entry->data = data;
-    hash_map_entry->hash_map = hash_map;
+    insert_entry_(hash_map, key, data);
+    hash_map->hash_size++;
 
-    return list_append(hash_bucket_list, hash_map_entry);
+    return true;
 }
 
 bool hash_map_erase(hash_map_t *hash_map, const void *key)
 {
     assert(hash_map != NULL);
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
-
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
+    hash_map_entry_t *hash_map_entry = find_entry_(hash_map, key);
     if (hash_map_entry == NULL) {
         return false;
     }
 
+    hash_map_entry_t old = *hash_map_entry;
+    size_t hole = hash_map_entry - hash_map->slot;
+
+    // Shift back the entries which would not be reachable through the hole anymore
+    for (size_t i = next_slot_(hash_map, hole); hash_map->slot[i].data != NULL; i = next_slot_(hash_map, i)) {
+        size_t home = hash_slot_(hash_map, hash_map->slot[i].key);
+        // Move the entry if its home slot is not in the cyclic range (hole, i]
+        if (((i - home) & (hash_map->num_slot - 1)) >= ((i - hole) & (hash_map->num_slot - 1))) {
+            hash_map->slot[hole] = hash_map->slot[i];
+            hole = i;
+        }
+    }
+    hash_map->slot[hole].key = NULL;
+    hash_map->slot[hole].data = NULL;
+    hash_map->slot[hole].hash_map = NULL;
     hash_map->hash_size--;
-    bool remove = list_remove(hash_bucket_list, hash_map_entry);
-    if(list_is_empty(hash_map->bucket[hash_key].list)) {
-        list_free(hash_map->bucket[hash_key].list);
-        hash_map->bucket[hash_key].list = NULL;
+
+    if (hash_map->key_fn) {
+        hash_map->key_fn((void *)old.key);
+    }
+    if (hash_map->data_fn) {
+        hash_map->data_fn(old.data);
     }
 
-    return remove;
+    return true;
 }
 
 void *hash_map_get(const hash_map_t *hash_map, const void *key)
 {
     assert(hash_map != NULL);
 
-    hash_index_t hash_key = hash_map->hash_fn(key) % hash_map->num_bucket;
-    list_t *hash_bucket_list = hash_map->bucket[hash_key].list;
-
-    hash_map_entry_t *hash_map_entry = find_bucket_entry_(hash_bucket_list, key);
+    hash_map_entry_t *hash_map_entry = find_entry_(hash_map, key);
     if (hash_map_entry != NULL) {
         return hash_map_entry->data;
     }
@@ -201,13 +267,23 @@ void hash_map_clear(hash_map_t *hash_map)
 {
     assert(hash_map != NULL);
 
-    for (hash_index_t i = 0; i < hash_map->num_bucket; i++) {
-        if (hash_map->bucket[i].list == NULL) {
+    for (hash_index_t i = 0; i < hash_map->num_slot; i++) {
+        hash_map_entry_t old = hash_map->slot[i];
+
+        if (old.data == NULL) {
             continue;
         }
-        list_free(hash_map->bucket[i].list);
-        hash_map->bucket[i].list = NULL;
+        hash_map->slot[i].key = NULL;
+        hash_map->slot[i].data = NULL;
+        hash_map->slot[i].hash_map = NULL;
+        if (hash_map->key_fn) {
+            hash_map->key_fn((void *)old.key);
+        }
+        if (hash_map->data_fn) {
+            hash_map->data_fn(old.data);
+        }
     }
+    hash_map->hash_size = 0;
 }
 
 void hash_map_foreach(hash_map_t *hash_map, hash_map_iter_cb callback, void *context)
@@ -215,53 +291,14 @@ void hash_map_foreach(hash_map_t *hash_map, hash_map_iter_cb callback, void *con
     assert(hash_map != NULL);
     assert(callback != NULL);
 
-    for (hash_index_t i = 0; i < hash_map->num_bucket; ++i) {
-        if (hash_map->bucket[i].list == NULL) {
+    for (hash_index_t i = 0; i < hash_map->num_slot; ++i) {
+        if (hash_map->slot[i].data == NULL) {
             continue;
         }
-        for (const list_node_t *iter = list_begin(hash_map->bucket[i].list);
-                iter != list_end(hash_map->bucket[i].list);
-                iter = list_next(iter)) {
-            hash_map_entry_t *hash_map_entry = (hash_map_entry_t *)list_node(iter);
-            if (!callback(hash_map_entry, context)) {
-                return;
-            }
-        }
-    }
-}
-
-static void bucket_free_(void *data)
-{
-    assert(data != NULL);
-    hash_map_entry_t *hash_map_entry = (hash_map_entry_t *)data;
-    const hash_map_t *hash_map = hash_map_entry->hash_map;
-
-    if (hash_map->key_fn) {
-        hash_map->key_fn((void *)hash_map_entry->key);
-    }
-    if (hash_map->data_fn) {
-        hash_map->data_fn(hash_map_entry->data);
-    }
-    osi_free(hash_map_entry);
-}
-
-static hash_map_entry_t *find_bucket_entry_(list_t *hash_bucket_list,
-        const void *key)
-{
-
-    if (hash_bucket_list == NULL) {
-        return NULL;
-    }
-
-    for (const list_node_t *iter = list_begin(hash_bucket_list);
-            iter != list_end(hash_bucket_list);
-            iter = list_next(iter)) {
-        hash_map_entry_t *hash_map_entry = (hash_map_entry_t *)list_node(iter);
-        if (hash_map_entry->hash_map->keys_are_equal(hash_map_entry->key, key)) {
-            return hash_map_entry;
+        if (!callback(&hash_map->slot[i], context)) {
+            return;
         }
     }
-    return NULL;
 }
 
 static bool default_key_equality(const void *x, const void *y)
@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _ALARM_WHEEL_H_
+#define _ALARM_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Hashed timing wheel of the OSI alarms. Slots hash the deadline with a granularity
+ * of ALARM_WHEEL_TICK_SHIFT, the alarms still expire at their exact deadline.
+ * The wheel does no locking and keeps no clock, the caller passes the current time.
+ */
+#define ALARM_WHEEL_SLOTS           64
+#define ALARM_WHEEL_TICK_SHIFT      13      // 8.192 ms per slot
+#define ALARM_WHEEL_MAP_WORDS       (ALARM_WHEEL_SLOTS / 32)
+
+typedef struct alarm_wheel_node {
+    struct alarm_wheel_node *next;      // slot list
+    struct alarm_wheel_node **pprev;    // slot list, for O(1) removal
+    int64_t deadline_us;
+    uint64_t period_us;                 // 0 for a one shot alarm
+    bool armed;
+} alarm_wheel_node_t;
+
+typedef struct {
+    alarm_wheel_node_t *slots[ALARM_WHEEL_SLOTS];
+    uint32_t map[ALARM_WHEEL_MAP_WORDS];    // non-empty slots
+    size_t num;
+    uint64_t tick;                          // last processed tick, no node has an earlier deadline
+} alarm_wheel_t;
+
+/*
+ * brief: initialize an empty wheel
+ * param now_us: current time
+ */
+void alarm_wheel_init(alarm_wheel_t *wheel, int64_t now_us);
+
+/*
+ * brief: arm a node, its deadline_us and period_us must be set
+ * param now_us: current time, the node must not expire before it
+ */
+void alarm_wheel_add(alarm_wheel_t *wheel, alarm_wheel_node_t *node, int64_t now_us);
+
+/*
+ * brief: disarm a node
+ */
+void alarm_wheel_remove(alarm_wheel_t *wheel, alarm_wheel_node_t *node);
+
+/*
+ * brief: remove the nodes whose deadline has passed, periodic nodes are re-armed for their next period
+ * param now_us: current time
+ * param fired: filled with the expired nodes
+ * param max_num: size of |fired|, the remaining expired nodes are left for the next call
+ * return: number of nodes copied to |fired|
+ */
+size_t alarm_wheel_expire(alarm_wheel_t *wheel, int64_t now_us, alarm_wheel_node_t **fired, size_t max_num);
+
+/*
+ * brief: get the earliest deadline of the armed nodes
+ * return: INT64_MAX if the wheel is empty
+ */
+int64_t alarm_wheel_next_deadline(const alarm_wheel_t *wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ALARM_WHEEL_H_ */
@@ -78,6 +78,13 @@ void *fixed_queue_try_peek_first(fixed_queue_t *queue);
 // elements in the queue or |queue| is NULL.
 void *fixed_queue_try_peek_last(fixed_queue_t *queue);
 
+// Returns the element at position |index| from the front of |queue|, if
+// present, without dequeuing it. This function will never block the caller.
+// Returns NULL if |index| is out of range or |queue| is NULL. The elements
+// of a queue can be iterated by increasing |index| until NULL is returned,
+// the result is unpredictable if the queue is modified by another thread.
+void *fixed_queue_try_peek_at(fixed_queue_t *queue, size_t index);
+
 // Tries to remove a |data| element from the middle of the |queue|. This
 // function will never block the caller. If the queue is empty or NULL, this
 // function returns NULL immediately. |data| may not be NULL. If the |data|
@@ -85,15 +92,6 @@ void *fixed_queue_try_peek_last(fixed_queue_t *queue);
 // otherwise NULL.
 void *fixed_queue_try_remove_from_queue(fixed_queue_t *queue, void *data);
 
-// Returns the iterateable list with all entries in the |queue|. This function
-// will never block the caller. |queue| may not be NULL.
-//
-// NOTE: The return result of this function is not thread safe: the list could
-// be modified by another thread, and the result would be unpredictable.
-// TODO: The usage of this function should be refactored, and the function
-// itself should be removed.
-list_t *fixed_queue_get_list(fixed_queue_t *queue);
-
 // This function returns a valid file descriptor. Callers may perform one
 // operation on the fd: select(2). If |select| indicates that the file
 // descriptor is readable, the caller may call |fixed_queue_enqueue| without
@@ -120,6 +118,4 @@ void fixed_queue_unregister_dequeue(fixed_queue_t *queue);
 
 void fixed_queue_process(fixed_queue_t *queue);
 
-list_t *fixed_queue_get_list(fixed_queue_t *queue);
-
 #endif
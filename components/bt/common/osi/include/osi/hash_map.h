@@ -45,8 +45,9 @@ typedef void (*data_free_fn)(void *data);
 
 // Returns a new, empty hash_map. Returns NULL if not enough memory could be allocated
 // for the hash_map structure. The returned hash_map must be freed with |hash_map_free|.
-// The |num_bucket| specifies the number of hashable buckets for the map and must not
-// be zero.  The |hash_fn| specifies a hash function to be used and must not be NULL.
+// The |num_bucket| specifies the number of elements the map is sized for and must not
+// be zero, the map grows beyond it as needed. The |hash_fn| specifies a hash function
+// to be used and must not be NULL.
 // The |key_fn| and |data_fn| are called whenever a hash_map element is removed from
 // the hash_map. They can be used to release resources held by the hash_map element,
 // e.g.  memory or file descriptor.  |key_fn| and |data_fn| may be NULL if no cleanup
@@ -72,7 +73,7 @@ void hash_map_free(hash_map_t *hash_map);
 // NULL |hash_map|.
 //size_t hash_map_size(const hash_map_t *hash_map);
 
-// Returns the number of buckets in the hash map.  This function does not accept a
+// Returns the number of slots in the hash map.  This function does not accept a
 // NULL |hash_map|.
 //size_t hash_map_num_buckets(const hash_map_t *hash_map);
 
@@ -98,7 +99,8 @@ bool hash_map_set(hash_map_t *hash_map, const void *key, void *data);
 bool hash_map_erase(hash_map_t *hash_map, const void *key);
 
 // Removes all elements in the hash_map. Calling this function will return the hash_map
-// to the same state it was in after |hash_map_new|. |hash_map| may not be NULL.
+// to the same state it was in after |hash_map_new|, except that the memory of a grown
+// map is kept. |hash_map| may not be NULL.
 void hash_map_clear(hash_map_t *hash_map);
 
 // Iterates through the entire |hash_map| and calls |callback| for each data
@@ -22,6 +22,10 @@
 #include "mesh/common.h"
 #include "mesh/adapter.h"
 
+#if CONFIG_MBEDTLS_HARDWARE_AES
+#include "mbedtls/aes.h"
+#endif
+
 #if CONFIG_BLE_MESH_V11_SUPPORT
 #include "mesh_v1.1/utils.h"
 #endif
@@ -29,6 +33,61 @@
 #define NET_MIC_LEN(pdu) (((pdu)[1] & 0x80) ? 8 : 4)
 #define APP_MIC_LEN(aszmic) ((aszmic) ? 8 : 4)
 
+/* AES-128 block encryption with the key set up once for a whole CCM
+ * computation, instead of once per block.
+ */
+struct aes_ctx {
+#if CONFIG_MBEDTLS_HARDWARE_AES
+    mbedtls_aes_context mbedtls;
+#else
+    struct tc_aes_key_sched_struct sched;
+#endif
+};
+
+static int aes_ctx_init(struct aes_ctx *ctx, const uint8_t key[16])
+{
+#if CONFIG_MBEDTLS_HARDWARE_AES
+    mbedtls_aes_init(&ctx->mbedtls);
+
+    if (mbedtls_aes_setkey_enc(&ctx->mbedtls, key, 128) != 0) {
+        mbedtls_aes_free(&ctx->mbedtls);
+        return -EINVAL;
+    }
+#else /* CONFIG_MBEDTLS_HARDWARE_AES */
+    if (tc_aes128_set_encrypt_key(&ctx->sched, key) == TC_CRYPTO_FAIL) {
+        return -EINVAL;
+    }
+#endif /* CONFIG_MBEDTLS_HARDWARE_AES */
+
+    return 0;
+}
+
+static int aes_ctx_encrypt(struct aes_ctx *ctx, const uint8_t plaintext[16],
+                           uint8_t enc_data[16])
+{
+#if CONFIG_MBEDTLS_HARDWARE_AES
+    if (mbedtls_aes_crypt_ecb(&ctx->mbedtls, MBEDTLS_AES_ENCRYPT,
+                              plaintext, enc_data) != 0) {
+        return -EINVAL;
+    }
+#else /* CONFIG_MBEDTLS_HARDWARE_AES */
+    if (tc_aes_encrypt(enc_data, plaintext, &ctx->sched) == TC_CRYPTO_FAIL) {
+        return -EINVAL;
+    }
+#endif /* CONFIG_MBEDTLS_HARDWARE_AES */
+
+    return 0;
+}
+
+static void aes_ctx_free(struct aes_ctx *ctx)
+{
+#if CONFIG_MBEDTLS_HARDWARE_AES
+    mbedtls_aes_free(&ctx->mbedtls);
+#else
+    memset(&ctx->sched, 0, sizeof(ctx->sched));
+#endif
+}
+
 int bt_mesh_aes_cmac(const uint8_t key[16], struct bt_mesh_sg *sg,
                      size_t sg_len, uint8_t mac[16])
 {
@@ -199,10 +258,10 @@ int bt_mesh_id128(const uint8_t n[16], const char *s, uint8_t out[16])
     return bt_mesh_k1(n, 16, salt, id128, out);
 }
 
-static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
-                               const uint8_t *enc_msg, size_t msg_len,
-                               const uint8_t *aad, size_t aad_len,
-                               uint8_t *out_msg, size_t mic_size)
+static int ccm_decrypt(struct aes_ctx *ctx, uint8_t nonce[13],
+                       const uint8_t *enc_msg, size_t msg_len,
+                       const uint8_t *aad, size_t aad_len,
+                       uint8_t *out_msg, size_t mic_size)
 {
     uint8_t msg[16] = {0}, pmsg[16] = {0}, cmic[16] = {0},
             cmsg[16] = {0}, Xn[16] = {0}, mic[16] = {0};
@@ -219,7 +278,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
     memcpy(pmsg + 1, nonce, 13);
     sys_put_be16(0x0000, pmsg + 14);
 
-    err = bt_mesh_encrypt_be(key, pmsg, cmic);
+    err = aes_ctx_encrypt(ctx, pmsg, cmic);
     if (err) {
         return err;
     }
@@ -234,7 +293,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
     memcpy(pmsg + 1, nonce, 13);
     sys_put_be16(msg_len, pmsg + 14);
 
-    err = bt_mesh_encrypt_be(key, pmsg, Xn);
+    err = aes_ctx_encrypt(ctx, pmsg, Xn);
     if (err) {
         return err;
     }
@@ -258,7 +317,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
             aad_len -= 16;
             i = 0;
 
-            err = bt_mesh_encrypt_be(key, pmsg, Xn);
+            err = aes_ctx_encrypt(ctx, pmsg, Xn);
             if (err) {
                 return err;
             }
@@ -272,7 +331,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
             pmsg[i] = Xn[i];
         }
 
-        err = bt_mesh_encrypt_be(key, pmsg, Xn);
+        err = aes_ctx_encrypt(ctx, pmsg, Xn);
         if (err) {
             return err;
         }
@@ -291,7 +350,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
             memcpy(pmsg + 1, nonce, 13);
             sys_put_be16(j + 1, pmsg + 14);
 
-            err = bt_mesh_encrypt_be(key, pmsg, cmsg);
+            err = aes_ctx_encrypt(ctx, pmsg, cmsg);
             if (err) {
                 return err;
             }
@@ -312,7 +371,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
                 pmsg[i] = Xn[i] ^ 0x00;
             }
 
-            err = bt_mesh_encrypt_be(key, pmsg, Xn);
+            err = aes_ctx_encrypt(ctx, pmsg, Xn);
             if (err) {
                 return err;
             }
@@ -327,7 +386,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
             memcpy(pmsg + 1, nonce, 13);
             sys_put_be16(j + 1, pmsg + 14);
 
-            err = bt_mesh_encrypt_be(key, pmsg, cmsg);
+            err = aes_ctx_encrypt(ctx, pmsg, cmsg);
             if (err) {
                 return err;
             }
@@ -344,7 +403,7 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
                 pmsg[i] = Xn[i] ^ msg[i];
             }
 
-            err = bt_mesh_encrypt_be(key, pmsg, Xn);
+            err = aes_ctx_encrypt(ctx, pmsg, Xn);
             if (err) {
                 return err;
             }
@@ -358,10 +417,10 @@ static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
     return 0;
 }
 
-static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
-                               const uint8_t *msg, size_t msg_len,
-                               const uint8_t *aad, size_t aad_len,
-                               uint8_t *out_msg, size_t mic_size)
+static int ccm_encrypt(struct aes_ctx *ctx, uint8_t nonce[13],
+                       const uint8_t *msg, size_t msg_len,
+                       const uint8_t *aad, size_t aad_len,
+                       uint8_t *out_msg, size_t mic_size)
 {
     uint8_t pmsg[16] = {0}, cmic[16] = {0}, cmsg[16] = {0},
             mic[16] = {0}, Xn[16] = {0};
@@ -369,11 +428,6 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
     size_t i = 0U, j = 0U;
     int err = 0;
 
-    BT_DBG("key %s", bt_hex(key, 16));
-    BT_DBG("nonce %s", bt_hex(nonce, 13));
-    BT_DBG("msg (len %u) %s", msg_len, bt_hex(msg, msg_len));
-    BT_DBG("aad_len %u mic_size %u", aad_len, mic_size);
-
     /* Unsupported AAD size */
     if (aad_len >= 0xff00) {
         return -EINVAL;
@@ -384,7 +438,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
     memcpy(pmsg + 1, nonce, 13);
     sys_put_be16(0x0000, pmsg + 14);
 
-    err = bt_mesh_encrypt_be(key, pmsg, cmic);
+    err = aes_ctx_encrypt(ctx, pmsg, cmic);
     if (err) {
         return err;
     }
@@ -399,7 +453,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
     memcpy(pmsg + 1, nonce, 13);
     sys_put_be16(msg_len, pmsg + 14);
 
-    err = bt_mesh_encrypt_be(key, pmsg, Xn);
+    err = aes_ctx_encrypt(ctx, pmsg, Xn);
     if (err) {
         return err;
     }
@@ -423,7 +477,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
             aad_len -= 16;
             i = 0;
 
-            err = bt_mesh_encrypt_be(key, pmsg, Xn);
+            err = aes_ctx_encrypt(ctx, pmsg, Xn);
             if (err) {
                 return err;
             }
@@ -437,7 +491,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
             pmsg[i] = Xn[i];
         }
 
-        err = bt_mesh_encrypt_be(key, pmsg, Xn);
+        err = aes_ctx_encrypt(ctx, pmsg, Xn);
         if (err) {
             return err;
         }
@@ -459,7 +513,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
                 pmsg[i] = Xn[i] ^ 0x00;
             }
 
-            err = bt_mesh_encrypt_be(key, pmsg, Xn);
+            err = aes_ctx_encrypt(ctx, pmsg, Xn);
             if (err) {
                 return err;
             }
@@ -474,7 +528,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
             memcpy(pmsg + 1, nonce, 13);
             sys_put_be16(j + 1, pmsg + 14);
 
-            err = bt_mesh_encrypt_be(key, pmsg, cmsg);
+            err = aes_ctx_encrypt(ctx, pmsg, cmsg);
             if (err) {
                 return err;
             }
@@ -490,7 +544,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
                 pmsg[i] = Xn[i] ^ msg[(j * 16) + i];
             }
 
-            err = bt_mesh_encrypt_be(key, pmsg, Xn);
+            err = aes_ctx_encrypt(ctx, pmsg, Xn);
             if (err) {
                 return err;
             }
@@ -500,7 +554,7 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
             memcpy(pmsg + 1, nonce, 13);
             sys_put_be16(j + 1, pmsg + 14);
 
-            err = bt_mesh_encrypt_be(key, pmsg, cmsg);
+            err = aes_ctx_encrypt(ctx, pmsg, cmsg);
             if (err) {
                 return err;
             }
@@ -519,6 +573,51 @@ static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
     return 0;
 }
 
+static int bt_mesh_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
+                               const uint8_t *enc_msg, size_t msg_len,
+                               const uint8_t *aad, size_t aad_len,
+                               uint8_t *out_msg, size_t mic_size)
+{
+    struct aes_ctx ctx = {0};
+    int err = 0;
+
+    err = aes_ctx_init(&ctx, key);
+    if (err) {
+        return err;
+    }
+
+    err = ccm_decrypt(&ctx, nonce, enc_msg, msg_len, aad, aad_len,
+                      out_msg, mic_size);
+
+    aes_ctx_free(&ctx);
+    return err;
+}
+
+static int bt_mesh_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
+                               const uint8_t *msg, size_t msg_len,
+                               const uint8_t *aad, size_t aad_len,
+                               uint8_t *out_msg, size_t mic_size)
+{
+    struct aes_ctx ctx = {0};
+    int err = 0;
+
+    BT_DBG("key %s", bt_hex(key, 16));
+    BT_DBG("nonce %s", bt_hex(nonce, 13));
+    BT_DBG("msg (len %u) %s", msg_len, bt_hex(msg, msg_len));
+    BT_DBG("aad_len %u mic_size %u", aad_len, mic_size);
+
+    err = aes_ctx_init(&ctx, key);
+    if (err) {
+        return err;
+    }
+
+    err = ccm_encrypt(&ctx, nonce, msg, msg_len, aad, aad_len,
+                      out_msg, mic_size);
+
+    aes_ctx_free(&ctx);
+    return err;
+}
+
 #if CONFIG_BLE_MESH_PROXY
 static void create_proxy_nonce(uint8_t nonce[13], const uint8_t *pdu,
                                uint32_t iv_index)
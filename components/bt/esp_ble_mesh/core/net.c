@@ -66,6 +66,47 @@ static struct {
 } msg_cache[CONFIG_BLE_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
 
+/* Hash chains over the message cache entries, keyed by SRC and SEQ.
+ * Entries are 1-based indexes into msg_cache (0 terminates a chain),
+ * and only the entries with an assigned source address are linked.
+ */
+static struct {
+    uint16_t head[CONFIG_BLE_MESH_MSG_CACHE_SIZE];
+    uint16_t next[CONFIG_BLE_MESH_MSG_CACHE_SIZE];
+} msg_cache_index;
+
+/* Index of the RX subnet keys by NID, so that a received Network PDU is
+ * only tried with the subnets having a key with its NID. Entry
+ * (i * NET_NID_KEYS + k) stands for key k of the i-th RX subnet, see
+ * net_nid_key_get(). The entries are not checked against the current keys
+ * when the index is built, the decryption does it, so the index only has
+ * to be rebuilt when keys are created or the number of RX subnets changes.
+ */
+#if CONFIG_BLE_MESH_DF_SRV
+#define NET_NID_KEYS    4   /* Flooding and directed, old and new key */
+#else
+#define NET_NID_KEYS    2   /* Flooding, old and new key */
+#endif
+#define NET_NID_NONE    0xFFFF
+
+static struct {
+    uint32_t gen;               /* Incremented when the keys change */
+    uint32_t built_gen;         /* Value of gen when the index was built */
+    size_t   count;             /* Number of RX subnets indexed */
+    uint16_t head[128];         /* First entry for each NID */
+    uint16_t *next;             /* Next entry with the same NID */
+} net_nid;
+
+static inline uint8_t net_nid_key_get(struct bt_mesh_subnet *sub, int k)
+{
+#if CONFIG_BLE_MESH_DF_SRV
+    if (k >= 2) {
+        return sub->keys[k - 2].direct_nid;
+    }
+#endif
+    return sub->keys[k].nid;
+}
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
     .local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -108,16 +149,51 @@ static bool check_dup(struct net_buf_simple *data)
     return false;
 }
 
+static inline uint16_t msg_cache_hash(uint16_t src, uint32_t seq)
+{
+    return (((uint32_t)src << 17 | seq) * 2654435761U >> 16) % ARRAY_SIZE(msg_cache_index.head);
+}
+
+static void msg_cache_unlink(uint16_t idx)
+{
+    uint16_t *link = NULL;
+
+    if (msg_cache[idx].src == BLE_MESH_ADDR_UNASSIGNED) {
+        return;
+    }
+
+    link = &msg_cache_index.head[msg_cache_hash(msg_cache[idx].src, msg_cache[idx].seq)];
+
+    while (*link) {
+        if (*link == idx + 1) {
+            *link = msg_cache_index.next[idx];
+            return;
+        }
+
+        link = &msg_cache_index.next[*link - 1];
+    }
+}
+
+static void msg_cache_reset(void)
+{
+    (void)memset(msg_cache, 0, sizeof(msg_cache));
+    (void)memset(&msg_cache_index, 0, sizeof(msg_cache_index));
+    msg_cache_next = 0U;
+}
+
 static bool msg_cache_match(struct bt_mesh_net_rx *rx,
                             struct net_buf_simple *pdu)
 {
-    int i;
+    uint16_t src = BLE_MESH_NET_HDR_SRC(pdu->data);
+    uint32_t seq = BLE_MESH_NET_HDR_SEQ(pdu->data) & BIT_MASK(17);
+    uint16_t idx = msg_cache_index.head[msg_cache_hash(src, seq)];
 
-    for (i = 0; i < ARRAY_SIZE(msg_cache); i++) {
-        if (msg_cache[i].src == BLE_MESH_NET_HDR_SRC(pdu->data) &&
-            msg_cache[i].seq == (BLE_MESH_NET_HDR_SEQ(pdu->data) & BIT_MASK(17))) {
+    while (idx) {
+        if (msg_cache[idx - 1].src == src && msg_cache[idx - 1].seq == seq) {
             return true;
         }
+
+        idx = msg_cache_index.next[idx - 1];
     }
 
     return false;
@@ -125,12 +201,76 @@ static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
+    uint16_t hash = 0U;
+
     rx->msg_cache_idx = msg_cache_next++;
+    msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+    /* The oldest entry is overwritten */
+    msg_cache_unlink(rx->msg_cache_idx);
+
     msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
     msg_cache[rx->msg_cache_idx].seq = rx->seq;
-    msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+    if (rx->ctx.addr != BLE_MESH_ADDR_UNASSIGNED) {
+        hash = msg_cache_hash(msg_cache[rx->msg_cache_idx].src, msg_cache[rx->msg_cache_idx].seq);
+        msg_cache_index.next[rx->msg_cache_idx] = msg_cache_index.head[hash];
+        msg_cache_index.head[hash] = rx->msg_cache_idx + 1;
+    }
+}
+
+#if CONFIG_BLE_MESH_SELF_TEST
+void bt_mesh_test_msg_cache_add(uint16_t src, uint32_t seq)
+{
+    struct bt_mesh_net_rx rx = {
+        .ctx.addr = src,
+        .seq = seq,
+    };
+
+    msg_cache_add(&rx);
 }
 
+bool bt_mesh_test_msg_cache_match(uint16_t src, uint32_t seq)
+{
+    NET_BUF_SIMPLE_DEFINE(buf, BLE_MESH_NET_HDR_LEN);
+    struct bt_mesh_net_rx rx = {0};
+
+    /* Only the SEQ and SRC fields of the header are used */
+    net_buf_simple_add_be16(&buf, 0x0000);
+    net_buf_simple_add_be24(&buf, seq);
+    net_buf_simple_add_be16(&buf, src);
+
+    return msg_cache_match(&rx, &buf);
+}
+
+int bt_mesh_test_msg_cache_index_check(void)
+{
+    bool linked[CONFIG_BLE_MESH_MSG_CACHE_SIZE] = {0};
+    int count = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(msg_cache_index.head); i++) {
+        for (uint16_t idx = msg_cache_index.head[i]; idx; idx = msg_cache_index.next[idx - 1]) {
+            if (idx > ARRAY_SIZE(msg_cache) || linked[idx - 1] ||
+                msg_cache[idx - 1].src == BLE_MESH_ADDR_UNASSIGNED ||
+                msg_cache_hash(msg_cache[idx - 1].src, msg_cache[idx - 1].seq) != i) {
+                return -EINVAL;
+            }
+
+            linked[idx - 1] = true;
+            count++;
+        }
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(msg_cache); i++) {
+        if (!linked[i] && msg_cache[i].src != BLE_MESH_ADDR_UNASSIGNED) {
+            return -EINVAL;
+        }
+    }
+
+    return count;
+}
+#endif /* CONFIG_BLE_MESH_SELF_TEST */
+
 #if CONFIG_BLE_MESH_PROVISIONER
 void bt_mesh_msg_cache_clear(uint16_t unicast_addr, uint8_t elem_num)
 {
@@ -139,6 +279,7 @@ void bt_mesh_msg_cache_clear(uint16_t unicast_addr, uint8_t elem_num)
     for (i = 0; i < ARRAY_SIZE(msg_cache); i++) {
         if (msg_cache[i].src >= unicast_addr &&
             msg_cache[i].src < unicast_addr + elem_num) {
+            msg_cache_unlink(i);
             memset(&msg_cache[i], 0, sizeof(msg_cache[i]));
         }
     }
@@ -249,6 +390,9 @@ int bt_mesh_net_keys_create(struct bt_mesh_subnet_keys *keys,
     keys->direct_nid = nid;
 #endif /* CONFIG_BLE_MESH_DF_SRV */
 
+    /* All the NIDs are derived, the index can pick them up */
+    bt_mesh_net_nid_index_invalidate();
+
     return 0;
 }
 
@@ -490,8 +634,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 
     BT_DBG("NetKey %s", bt_hex(key, 16));
 
-    (void)memset(msg_cache, 0, sizeof(msg_cache));
-    msg_cache_next = 0U;
+    msg_cache_reset();
 
     sub = &bt_mesh.sub[0];
 
@@ -548,6 +691,7 @@ void bt_mesh_net_revoke_keys(struct bt_mesh_subnet *sub)
     BT_DBG("idx 0x%04x", sub->net_idx);
 
     memcpy(&sub->keys[0], &sub->keys[1], sizeof(sub->keys[0]));
+    bt_mesh_net_nid_index_invalidate();
 
     if (IS_ENABLED(CONFIG_BLE_MESH_SETTINGS)) {
         BT_DBG("Store updated NetKey persistently");
@@ -1308,6 +1452,10 @@ int net_decrypt(struct bt_mesh_subnet *sub, const uint8_t *enc,
     BT_DBG("NID 0x%02x net_idx 0x%04x", BLE_MESH_NET_HDR_NID(data), sub->net_idx);
     BT_DBG("IVI %u net->iv_index 0x%08x", BLE_MESH_NET_HDR_IVI(data), bt_mesh.iv_index);
 
+#if CONFIG_BLE_MESH_SELF_TEST
+    net_decrypt_test_count++;
+#endif /* CONFIG_BLE_MESH_SELF_TEST */
+
     rx->old_iv = (BLE_MESH_NET_HDR_IVI(data) != (bt_mesh.iv_index & 0x01));
 
     net_buf_simple_reset(buf);
@@ -1339,43 +1487,33 @@ int net_decrypt(struct bt_mesh_subnet *sub, const uint8_t *enc,
     return bt_mesh_net_decrypt(enc, buf, BLE_MESH_NET_IVI_RX(rx), false, false);
 }
 
-#if (CONFIG_BLE_MESH_LOW_POWER || CONFIG_BLE_MESH_FRIEND)
-static int friend_decrypt(struct bt_mesh_subnet *sub, const uint8_t *data,
-                          size_t data_len, struct bt_mesh_net_rx *rx,
-                          struct net_buf_simple *buf)
+#if FRIEND_CRED_COUNT > 0
+static int friend_cred_decrypt(struct friend_cred *cred, struct bt_mesh_subnet *sub,
+                               const uint8_t *data, size_t data_len,
+                               struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 {
-    int i;
-
     BT_DBG("NID 0x%02x net_idx 0x%04x", BLE_MESH_NET_HDR_NID(data), sub->net_idx);
 
-    for (i = 0; i < ARRAY_SIZE(friend_cred); i++) {
-        struct friend_cred *cred = &friend_cred[i];
-
-        if (cred->net_idx != sub->net_idx) {
-            continue;
-        }
-
-        if (BLE_MESH_NET_HDR_NID(data) == cred->cred[0].nid &&
-            !net_decrypt(sub, cred->cred[0].enc, cred->cred[0].privacy,
-                         data, data_len, rx, buf)) {
-            return 0;
-        }
+    if (BLE_MESH_NET_HDR_NID(data) == cred->cred[0].nid &&
+        !net_decrypt(sub, cred->cred[0].enc, cred->cred[0].privacy,
+                     data, data_len, rx, buf)) {
+        return 0;
+    }
 
-        if (sub->kr_phase == BLE_MESH_KR_NORMAL) {
-            continue;
-        }
+    if (sub->kr_phase == BLE_MESH_KR_NORMAL) {
+        return -ENOENT;
+    }
 
-        if (BLE_MESH_NET_HDR_NID(data) == cred->cred[1].nid &&
-            !net_decrypt(sub, cred->cred[1].enc, cred->cred[1].privacy,
-                         data, data_len, rx, buf)) {
-            rx->new_key = 1U;
-            return 0;
-        }
+    if (BLE_MESH_NET_HDR_NID(data) == cred->cred[1].nid &&
+        !net_decrypt(sub, cred->cred[1].enc, cred->cred[1].privacy,
+                     data, data_len, rx, buf)) {
+        rx->new_key = 1U;
+        return 0;
     }
 
     return -ENOENT;
 }
-#endif /* (CONFIG_BLE_MESH_LOW_POWER || CONFIG_BLE_MESH_FRIEND) */
+#endif /* FRIEND_CRED_COUNT > 0 */
 
 static int flooding_decrypt(struct bt_mesh_subnet *sub, const uint8_t *data,
                             size_t data_len, struct bt_mesh_net_rx *rx,
@@ -1403,6 +1541,96 @@ static int flooding_decrypt(struct bt_mesh_subnet *sub, const uint8_t *data,
     return -ENOENT;
 }
 
+static bool subnet_decrypt(struct bt_mesh_subnet *sub, const uint8_t *data,
+                           size_t data_len, struct bt_mesh_net_rx *rx,
+                           struct net_buf_simple *buf)
+{
+#if CONFIG_BLE_MESH_SELF_TEST
+    net_subnet_test_count++;
+#endif /* CONFIG_BLE_MESH_SELF_TEST */
+
+#if CONFIG_BLE_MESH_BRC_SRV
+    sub->sbr_net_idx = BLE_MESH_KEY_UNUSED;
+#endif
+
+    /* Friendship credentials are tried beforehand, see net_find_and_decrypt() */
+
+#if CONFIG_BLE_MESH_DF_SRV
+    if (!bt_mesh_directed_decrypt(sub, data, data_len, rx, buf)) {
+        rx->ctx.recv_cred = BLE_MESH_DIRECTED_CRED;
+        rx->ctx.net_idx = sub->net_idx;
+        rx->sub = sub;
+        return true;
+    }
+#endif /* CONFIG_BLE_MESH_DF_SRV */
+
+    if (!flooding_decrypt(sub, data, data_len, rx, buf)) {
+        rx->ctx.recv_cred = BLE_MESH_FLOODING_CRED;
+        rx->ctx.net_idx = sub->net_idx;
+        rx->sub = sub;
+        return true;
+    }
+
+    return false;
+}
+
+static bool net_nid_index_update(void)
+{
+    size_t count = bt_mesh_rx_netkey_size();
+    uint32_t gen = net_nid.gen;
+    int i, k;
+
+    if (net_nid.next && net_nid.built_gen == gen && net_nid.count == count) {
+        return true;
+    }
+
+    if (net_nid.count != count || net_nid.next == NULL) {
+        bt_mesh_free(net_nid.next);
+        net_nid.next = NULL;
+        net_nid.count = 0U;
+
+        if (count == 0U) {
+            return false;
+        }
+
+        net_nid.next = bt_mesh_calloc(count * NET_NID_KEYS * sizeof(net_nid.next[0]));
+        if (net_nid.next == NULL) {
+            BT_DBG("No memory for NID index");
+            return false;
+        }
+        net_nid.count = count;
+    }
+
+    memset(net_nid.head, 0xFF, sizeof(net_nid.head));
+
+    /* Entries of a subnet are inserted in a row, so they are adjacent
+     * in the list of a NID.
+     */
+    for (i = (int)count - 1; i >= 0; i--) {
+        struct bt_mesh_subnet *sub = bt_mesh_rx_netkey_get(i);
+
+        if (sub == NULL) {
+            continue;
+        }
+
+        for (k = 0; k < NET_NID_KEYS; k++) {
+            uint16_t entry = i * NET_NID_KEYS + k;
+            uint8_t nid = net_nid_key_get(sub, k);
+
+            net_nid.next[entry] = net_nid.head[nid];
+            net_nid.head[nid] = entry;
+        }
+    }
+
+    net_nid.built_gen = gen;
+    return true;
+}
+
+void bt_mesh_net_nid_index_invalidate(void)
+{
+    net_nid.gen++;
+}
+
 static bool net_find_and_decrypt(const uint8_t *data, size_t data_len,
                                  struct bt_mesh_net_rx *rx,
                                  struct net_buf_simple *buf)
@@ -1411,16 +1639,21 @@ static bool net_find_and_decrypt(const uint8_t *data, size_t data_len,
     size_t array_size = 0U;
     int i;
 
-    array_size = bt_mesh_rx_netkey_size();
+#if FRIEND_CRED_COUNT > 0
+    /* Friendship credentials are few and not part of the NID index, they
+     * are tried once here, the subnet keys are tried below.
+     */
+    for (i = 0; i < ARRAY_SIZE(friend_cred); i++) {
+        struct friend_cred *cred = &friend_cred[i];
 
-    for (i = 0; i < array_size; i++) {
-        sub = bt_mesh_rx_netkey_get(i);
-        if (!sub) {
-            BT_DBG("Subnet not found");
+        if (cred->addr == BLE_MESH_ADDR_UNASSIGNED ||
+            (BLE_MESH_NET_HDR_NID(data) != cred->cred[0].nid &&
+             BLE_MESH_NET_HDR_NID(data) != cred->cred[1].nid)) {
             continue;
         }
 
-        if (sub->net_idx == BLE_MESH_KEY_UNUSED) {
+        sub = bt_mesh_subnet_get(cred->net_idx);
+        if (!sub) {
             continue;
         }
 
@@ -1428,28 +1661,56 @@ static bool net_find_and_decrypt(const uint8_t *data, size_t data_len,
         sub->sbr_net_idx = BLE_MESH_KEY_UNUSED;
 #endif
 
-#if (CONFIG_BLE_MESH_LOW_POWER || CONFIG_BLE_MESH_FRIEND)
-        if (!friend_decrypt(sub, data, data_len, rx, buf)) {
+        if (!friend_cred_decrypt(cred, sub, data, data_len, rx, buf)) {
             rx->ctx.recv_cred = BLE_MESH_FRIENDSHIP_CRED;
             rx->ctx.net_idx = sub->net_idx;
             rx->sub = sub;
             return true;
         }
-#endif
+    }
+#endif /* FRIEND_CRED_COUNT > 0 */
 
-#if CONFIG_BLE_MESH_DF_SRV
-        if (!bt_mesh_directed_decrypt(sub, data, data_len, rx, buf)) {
-            rx->ctx.recv_cred = BLE_MESH_DIRECTED_CRED;
-            rx->ctx.net_idx = sub->net_idx;
-            rx->sub = sub;
-            return true;
+    if (net_nid_index_update()) {
+        uint16_t last = NET_NID_NONE;
+        uint16_t entry;
+
+        for (entry = net_nid.head[BLE_MESH_NET_HDR_NID(data)];
+             entry != NET_NID_NONE; entry = net_nid.next[entry]) {
+            uint16_t index = entry / NET_NID_KEYS;
+
+            /* The subnet may be listed once per key with this NID */
+            if (index == last) {
+                continue;
+            }
+            last = index;
+
+            sub = bt_mesh_rx_netkey_get(index);
+            if (!sub || sub->net_idx == BLE_MESH_KEY_UNUSED) {
+                continue;
+            }
+
+            if (subnet_decrypt(sub, data, data_len, rx, buf)) {
+                return true;
+            }
         }
-#endif /* CONFIG_BLE_MESH_DF_SRV */
 
-        if (!flooding_decrypt(sub, data, data_len, rx, buf)) {
-            rx->ctx.recv_cred = BLE_MESH_FLOODING_CRED;
-            rx->ctx.net_idx = sub->net_idx;
-            rx->sub = sub;
+        return false;
+    }
+
+    array_size = bt_mesh_rx_netkey_size();
+
+    for (i = 0; i < array_size; i++) {
+        sub = bt_mesh_rx_netkey_get(i);
+        if (!sub) {
+            BT_DBG("Subnet not found");
+            continue;
+        }
+
+        if (sub->net_idx == BLE_MESH_KEY_UNUSED) {
+            continue;
+        }
+
+        if (subnet_decrypt(sub, data, data_len, rx, buf)) {
             return true;
         }
     }
@@ -1997,6 +2258,7 @@ void bt_mesh_generic_net_recv(struct net_buf_simple *data,
     */
     if (bt_mesh_trans_recv(&buf, rx) == -EAGAIN) {
         BT_WARN("Removing rejected message from Network Message Cache");
+        msg_cache_unlink(rx->msg_cache_idx);
         msg_cache[rx->msg_cache_idx].src = BLE_MESH_ADDR_UNASSIGNED;
         /* Rewind the next index now that we're not using this entry */
         msg_cache_next = rx->msg_cache_idx;
@@ -2109,12 +2371,16 @@ void bt_mesh_net_reset(void)
     memset(friend_cred, 0, sizeof(friend_cred));
 #endif
 
-    memset(msg_cache, 0, sizeof(msg_cache));
-    msg_cache_next = 0U;
+    msg_cache_reset();
 
     memset(dup_cache, 0, sizeof(dup_cache));
     dup_cache_next = 0U;
 
+    bt_mesh_free(net_nid.next);
+    net_nid.next = NULL;
+    net_nid.count = 0U;
+    bt_mesh_net_nid_index_invalidate();
+
     bt_mesh.iv_index = 0U;
     bt_mesh.seq = 0U;
 }
@@ -482,6 +482,8 @@ uint32_t bt_mesh_next_seq(void);
 
 void bt_mesh_net_start(void);
 
+void bt_mesh_net_nid_index_invalidate(void);
+
 void bt_mesh_net_init(void);
 void bt_mesh_net_reset(void);
 void bt_mesh_net_deinit(void);
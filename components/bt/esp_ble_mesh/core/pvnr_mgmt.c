@@ -1252,6 +1252,7 @@ int bt_mesh_provisioner_local_net_key_add(const uint8_t net_key[16], uint16_t *n
 #endif
 
     bt_mesh.p_sub[add] = sub;
+    bt_mesh_net_nid_index_invalidate();
 
     if (IS_ENABLED(CONFIG_BLE_MESH_SETTINGS)) {
         bt_mesh_store_p_net_idx();
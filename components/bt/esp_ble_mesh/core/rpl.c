@@ -14,6 +14,121 @@
 #include "mesh/trace.h"
 #include "mesh.h"
 #include "settings.h"
+#include "test.h"
+
+/* Index of the RPL slots by source address, so that the per-packet check
+ * does not scan the whole list. Entries are 1-based slot numbers chained
+ * through "next" (0 terminates a chain), and "src" records the address a
+ * slot has been linked with.
+ *
+ * The list itself may still be written without going through this file
+ * (e.g. IV Index recovery or restoring from flash), so an entry whose slot
+ * no longer holds the address it was linked with is dropped when it is met,
+ * and a miss in the index falls back to scanning the list.
+ */
+static struct {
+    uint16_t head[CONFIG_BLE_MESH_CRPL];
+    uint16_t next[CONFIG_BLE_MESH_CRPL];
+    uint16_t src[CONFIG_BLE_MESH_CRPL];
+} rpl_index;
+
+static inline uint16_t rpl_hash(uint16_t src)
+{
+    return ((uint32_t)src * 2654435761U >> 16) % ARRAY_SIZE(rpl_index.head);
+}
+
+static void rpl_index_unlink(size_t slot)
+{
+    uint16_t *link = &rpl_index.head[rpl_hash(rpl_index.src[slot])];
+
+    while (*link) {
+        if (*link == slot + 1) {
+            *link = rpl_index.next[slot];
+            break;
+        }
+
+        link = &rpl_index.next[*link - 1];
+    }
+
+    rpl_index.src[slot] = BLE_MESH_ADDR_UNASSIGNED;
+}
+
+static void rpl_index_link(size_t slot)
+{
+    uint16_t src = bt_mesh.rpl[slot].src;
+    uint16_t hash = 0U;
+
+    if (rpl_index.src[slot] == src) {
+        return;
+    }
+
+    if (rpl_index.src[slot] != BLE_MESH_ADDR_UNASSIGNED) {
+        rpl_index_unlink(slot);
+    }
+
+    if (src == BLE_MESH_ADDR_UNASSIGNED) {
+        return;
+    }
+
+    hash = rpl_hash(src);
+
+    rpl_index.src[slot] = src;
+    rpl_index.next[slot] = rpl_index.head[hash];
+    rpl_index.head[hash] = slot + 1;
+}
+
+static struct bt_mesh_rpl *rpl_index_find(uint16_t src)
+{
+    uint16_t *link = &rpl_index.head[rpl_hash(src)];
+
+    while (*link) {
+        size_t slot = *link - 1;
+
+        if (rpl_index.src[slot] != bt_mesh.rpl[slot].src) {
+            /* The slot has been changed behind the index */
+            *link = rpl_index.next[slot];
+            rpl_index.src[slot] = BLE_MESH_ADDR_UNASSIGNED;
+            continue;
+        }
+
+        if (rpl_index.src[slot] == src) {
+            return &bt_mesh.rpl[slot];
+        }
+
+        link = &rpl_index.next[slot];
+    }
+
+    return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_find(uint16_t src)
+{
+    struct bt_mesh_rpl *empty = NULL;
+    struct bt_mesh_rpl *rpl = NULL;
+
+    rpl = rpl_index_find(src);
+    if (rpl) {
+        return rpl;
+    }
+
+    /* Not indexed yet, look for the existing slot for the given
+     * address and otherwise use the first empty one.
+     */
+    for (size_t i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+        rpl = &bt_mesh.rpl[i];
+
+        if (rpl->src == src) {
+            rpl_index_link(i);
+            return rpl;
+        }
+
+        if (rpl->src == BLE_MESH_ADDR_UNASSIGNED && empty == NULL) {
+            empty = rpl;
+        }
+    }
+
+    return empty;
+}
 
 void bt_mesh_update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
 {
@@ -21,6 +136,11 @@ void bt_mesh_update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
     rpl->seq = rx->seq;
     rpl->old_iv = rx->old_iv;
 
+    /* The slot may also belong to a list kept outside of bt_mesh.rpl */
+    if (rpl >= bt_mesh.rpl && rpl < bt_mesh.rpl + ARRAY_SIZE(bt_mesh.rpl)) {
+        rpl_index_link(rpl - bt_mesh.rpl);
+    }
+
     if (IS_ENABLED(CONFIG_BLE_MESH_SETTINGS)) {
         bt_mesh_store_rpl(rpl);
     }
@@ -33,46 +153,44 @@ void bt_mesh_update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
  */
 static bool rpl_check_and_store(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 {
-    for (size_t i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-        struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
+    struct bt_mesh_rpl *rpl = rpl_find(rx->ctx.addr);
 
-        /* Empty slot */
-        if (rpl->src == BLE_MESH_ADDR_UNASSIGNED) {
-            if (match) {
-                *match = rpl;
-            } else {
-                bt_mesh_update_rpl(rpl, rx);
-            }
+    if (rpl == NULL) {
+        BT_ERR("RPL is full!");
+        return true;
+    }
 
-            return false;
+    /* Empty slot */
+    if (rpl->src == BLE_MESH_ADDR_UNASSIGNED) {
+        if (match) {
+            *match = rpl;
+        } else {
+            bt_mesh_update_rpl(rpl, rx);
         }
 
-        /* Existing slot for given address */
-        if (rpl->src == rx->ctx.addr) {
-            if (rx->old_iv && !rpl->old_iv) {
-                return true;
-            }
+        return false;
+    }
 
-            if ((!rx->old_iv && rpl->old_iv) ||
-                rpl->seq < rx->seq) {
-                if (match) {
-                    *match = rpl;
-                } else {
-                    bt_mesh_update_rpl(rpl, rx);
-                }
+    /* Existing slot for given address */
+    if (rx->old_iv && !rpl->old_iv) {
+        return true;
+    }
 
-                return false;
-            }
+    if ((!rx->old_iv && rpl->old_iv) ||
+        rpl->seq < rx->seq) {
+        if (match) {
+            *match = rpl;
+        } else {
+            bt_mesh_update_rpl(rpl, rx);
+        }
+
+        return false;
+    }
 
 #if CONFIG_BLE_MESH_NOT_RELAY_REPLAY_MSG
-            rx->replay_msg = 1;
+    rx->replay_msg = 1;
 #endif
 
-            return true;
-        }
-    }
-
-    BT_ERR("RPL is full!");
     return true;
 }
 
@@ -101,6 +219,7 @@ void bt_mesh_rpl_update(void)
 
         if (rpl->src) {
             if (rpl->old_iv) {
+                rpl_index_unlink(i);
                 (void)memset(rpl, 0, sizeof(*rpl));
             } else {
                 rpl->old_iv = true;
@@ -121,6 +240,7 @@ void bt_mesh_rpl_reset_single(uint16_t src, bool erase)
 
     for (size_t i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
         if (src == bt_mesh.rpl[i].src) {
+            rpl_index_unlink(i);
             memset(&bt_mesh.rpl[i], 0, sizeof(struct bt_mesh_rpl));
 
             if (IS_ENABLED(CONFIG_BLE_MESH_SETTINGS) && erase) {
@@ -133,8 +253,40 @@ void bt_mesh_rpl_reset_single(uint16_t src, bool erase)
 void bt_mesh_rpl_reset(bool erase)
 {
     (void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+    (void)memset(&rpl_index, 0, sizeof(rpl_index));
 
     if (IS_ENABLED(CONFIG_BLE_MESH_SETTINGS) && erase) {
         bt_mesh_clear_rpl();
     }
 }
+
+#if CONFIG_BLE_MESH_SELF_TEST
+int bt_mesh_test_rpl_index_check(void)
+{
+    bool linked[CONFIG_BLE_MESH_CRPL] = {0};
+    int count = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(rpl_index.head); i++) {
+        for (uint16_t idx = rpl_index.head[i]; idx; idx = rpl_index.next[idx - 1]) {
+            size_t slot = idx - 1;
+
+            if (idx > ARRAY_SIZE(bt_mesh.rpl) || linked[slot] ||
+                rpl_index.src[slot] != bt_mesh.rpl[slot].src ||
+                rpl_hash(rpl_index.src[slot]) != i) {
+                return -EINVAL;
+            }
+
+            linked[slot] = true;
+            count++;
+        }
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+        if (!linked[i] && rpl_index.src[i] != BLE_MESH_ADDR_UNASSIGNED) {
+            return -EINVAL;
+        }
+    }
+
+    return count;
+}
+#endif /* CONFIG_BLE_MESH_SELF_TEST */
@@ -189,4 +189,39 @@ void bt_mesh_test_set_seq(uint32_t seq)
     bt_mesh.seq = seq;
 }
 
+uint32_t net_subnet_test_count;
+uint32_t net_decrypt_test_count;
+
+int bt_mesh_test_net_decode(const uint8_t *data, uint16_t length, uint16_t *net_idx,
+                            uint32_t *subnets, uint32_t *attempts)
+{
+    /* Same size as in bt_mesh_generic_net_recv() */
+    NET_BUF_SIMPLE_DEFINE(in, 29);
+    NET_BUF_SIMPLE_DEFINE(out, 29);
+    struct bt_mesh_net_rx rx = {0};
+    int err = 0;
+
+    if (data == NULL || length > in.size) {
+        return -EINVAL;
+    }
+
+    net_buf_simple_add_mem(&in, data, length);
+
+    net_subnet_test_count = 0U;
+    net_decrypt_test_count = 0U;
+    err = bt_mesh_net_decode(&in, BLE_MESH_NET_IF_LOCAL, &rx, &out);
+
+    if (subnets) {
+        *subnets = net_subnet_test_count;
+    }
+    if (attempts) {
+        *attempts = net_decrypt_test_count;
+    }
+    if (net_idx && !err) {
+        *net_idx = rx.ctx.net_idx;
+    }
+
+    return err;
+}
+
 #endif /* CONFIG_BLE_MESH_SELF_TEST */
@@ -53,6 +53,37 @@ void bt_mesh_test_register_net_pdu_cb(bt_mesh_test_net_pdu_cb_t cb);
 
 void bt_mesh_test_set_seq(uint32_t seq);
 
+/* Number of subnets tried for a Network PDU */
+extern uint32_t net_subnet_test_count;
+
+/* Number of Network PDU decryption attempts (deobfuscation + AES-CCM) */
+extern uint32_t net_decrypt_test_count;
+
+/* Decode a Network PDU, e.g. one captured with the net_pdu_test_cb, as if
+ * it was received locally, and report the subnets and decryption attempts
+ * it took.
+ */
+int bt_mesh_test_net_decode(const uint8_t *data, uint16_t length, uint16_t *net_idx,
+                            uint32_t *subnets, uint32_t *attempts);
+
+/* Add an entry to the Network Message Cache, as for a received Network PDU */
+void bt_mesh_test_msg_cache_add(uint16_t src, uint32_t seq);
+
+/* Check if a Network PDU with the given SRC and SEQ is in the message cache */
+bool bt_mesh_test_msg_cache_match(uint16_t src, uint32_t seq);
+
+/* Check the hash index of the message cache against the cache entries.
+ * Returns the number of indexed entries, or -EINVAL if an entry is linked
+ * in the wrong chain or twice, or an assigned entry is not linked at all.
+ */
+int bt_mesh_test_msg_cache_index_check(void);
+
+/* Check the index of the RPL slots against bt_mesh.rpl. Returns the number
+ * of indexed slots, or -EINVAL if a slot is linked in the wrong chain or
+ * twice, or is linked with an address it no longer holds.
+ */
+int bt_mesh_test_rpl_index_check(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,9 @@
 extern "C" {
 #endif
 
+/// Maximum number of notifications in one `esp_ble_gatts_send_notify_batch` call
+#define ESP_GATTS_NOTIFY_BATCH_MAX      32
+
 /// GATT Server callback function events
 typedef enum {
     ESP_GATTS_REG_EVT                 = 0,       /*!< This event is triggered when a GATT Server application is registered using `esp_ble_gatts_app_register`. */
@@ -43,6 +46,7 @@ typedef enum {
     ESP_GATTS_CREAT_ATTR_TAB_EVT      = 22,      /*!< This event is triggered when a service attribute table is created using `esp_ble_gatts_create_attr_tab`. */
     ESP_GATTS_SET_ATTR_VAL_EVT        = 23,      /*!< This event is triggered when an attribute value is set using `esp_ble_gatts_set_attr_value`. */
     ESP_GATTS_SEND_SERVICE_CHANGE_EVT = 24,      /*!< This event is triggered when a service change indication is sent using `esp_ble_gatts_send_service_change_indication`. */
+    ESP_GATTS_SEND_NOTIFY_BATCH_EVT   = 25,      /*!< This event is triggered when a batch of notifications is sent using `esp_ble_gatts_send_notify_batch`. */
 } esp_gatts_cb_event_t;
 
 /**
@@ -267,8 +271,26 @@ typedef union {
         esp_gatt_status_t status;        /*!< Operation status */
     } service_change;                    /*!< Callback parameter for the event `ESP_GATTS_SEND_SERVICE_CHANGE_EVT` */
 
+    /**
+    * @brief Callback parameter for the event `ESP_GATTS_SEND_NOTIFY_BATCH_EVT`
+    */
+    struct gatts_send_notify_batch_evt_param{
+        esp_gatt_status_t status;        /*!< Operation status, see `esp_ble_gatts_send_notify_batch` */
+        uint16_t conn_id;                /*!< Connection ID */
+        uint16_t num_sent;               /*!< Number of notifications sent, counted from the start of the batch */
+    } notify_batch;                      /*!< Callback parameter for the event `ESP_GATTS_SEND_NOTIFY_BATCH_EVT` */
+
 } esp_ble_gatts_cb_param_t;
 
+/**
+ * @brief One notification of a batch, see `esp_ble_gatts_send_notify_batch`
+ */
+typedef struct {
+    uint16_t attr_handle;               /*!< Attribute handle to notify */
+    uint16_t value_len;                 /*!< Notification value length in bytes */
+    uint8_t *value;                     /*!< Notification value */
+} esp_gatts_notify_value_t;
+
 /**
  * @brief GATT Server callback function type
  *
@@ -496,6 +518,40 @@ esp_err_t esp_ble_gatts_stop_service(uint16_t service_handle);
 esp_err_t esp_ble_gatts_send_indicate(esp_gatt_if_t gatts_if, uint16_t conn_id, uint16_t attr_handle,
                                       uint16_t value_len, uint8_t *value, bool need_confirm);
 
+/**
+ * @brief  Send several notifications to a GATT Client at once
+ *
+ * The whole batch travels to the Bluetooth task as a single message. If the Client has enabled
+ * Multiple Handle Value Notifications in its Client Supported Features, consecutive values are packed
+ * into as few ATT PDUs as the MTU allows; otherwise each value is sent as a regular notification,
+ * back to back, so that they can share the same connection event.
+ *
+ * @param[in]       gatts_if    GATT Server access interface
+ * @param[in]       conn_id     Connection ID
+ * @param[in]       num_values  Number of notifications, up to `ESP_GATTS_NOTIFY_BATCH_MAX`
+ * @param[in]       values      Handle and value of each notification
+ *
+ * @note
+ *       1. This function triggers a single `ESP_GATTS_SEND_NOTIFY_BATCH_EVT` for the whole batch, not `ESP_GATTS_CONF_EVT`.
+ *       2. Values longer than MTU - 3 bytes are truncated, as with `esp_ble_gatts_send_indicate`.
+ *       3. If the channel becomes congested, the remaining notifications are not sent, see `num_sent` of the event.
+ *       4. This function should be called only after the connection has been established.
+ *       5. The arguments are checked before anything is sent, an error return means that no notification was sent.
+ *       6. The status of `ESP_GATTS_SEND_NOTIFY_BATCH_EVT` is `ESP_GATT_OK` if all the notifications were sent,
+ *          `ESP_GATT_CONGESTED` if the batch was cut short by congestion, `ESP_GATT_WRONG_STATE` if the connection
+ *          was closed in the meantime, or another error if a PDU could not be built or sent.
+ *
+ * @return
+ *       - ESP_OK: Success, the batch was handed to the Bluetooth task
+ *       - ESP_ERR_INVALID_ARG: `values` is NULL, `num_values` is 0 or more than `ESP_GATTS_NOTIFY_BATCH_MAX`,
+ *                              or a notification has `attr_handle` 0 or a NULL `value` with a non-zero `value_len`
+ *       - ESP_ERR_INVALID_SIZE: A value is longer than `ESP_GATT_MAX_ATTR_LEN`
+ *       - ESP_ERR_INVALID_STATE: Bluedroid is not enabled, or the connection has not been established
+ *       - ESP_FAIL: The channel is congested, or the batch could not be passed to the Bluetooth task
+ */
+esp_err_t esp_ble_gatts_send_notify_batch(esp_gatt_if_t gatts_if, uint16_t conn_id, uint16_t num_values,
+                                          const esp_gatts_notify_value_t *values);
+
 /**
  * @brief  Send a response to a request
  *
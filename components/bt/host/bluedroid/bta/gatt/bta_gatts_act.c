@@ -736,6 +736,53 @@ void bta_gatts_indicate_handle (tBTA_GATTS_CB *p_cb, tBTA_GATTS_DATA *p_msg)
     }
 }
 
+/*******************************************************************************
+**
+** Function         bta_gatts_notify_batch
+**
+** Description      GATTS send a batch of handle value notifications.
+**
+** Returns          none.
+**
+*******************************************************************************/
+void bta_gatts_notify_batch (tBTA_GATTS_CB *p_cb, tBTA_GATTS_DATA *p_msg)
+{
+    tBTA_GATTS_RCB      *p_rcb = NULL;
+    tBTA_GATT_STATUS    status = BTA_GATT_ILLEGAL_PARAMETER;
+    tGATT_IF            gatt_if;
+    BD_ADDR             remote_bda;
+    tBTA_TRANSPORT      transport;
+    tBTA_GATTS          cb_data;
+    UINT16              num_sent = 0;
+    UINT16              conn_id = p_msg->api_notify_batch.hdr.layer_specific;
+    UNUSED(p_cb);
+
+    for (UINT16 i = 0; i < p_msg->api_notify_batch.num_values; i++) {
+        l2ble_update_att_acl_pkt_num(L2CA_DECREASE_BTU_NUM, NULL);
+    }
+
+    if (GATT_GetConnectionInfor(conn_id, &gatt_if, remote_bda, &transport)) {
+        p_rcb = bta_gatts_find_app_rcb_by_app_if(gatt_if);
+
+        status = GATTS_HandleValueNotificationBatch(conn_id, p_msg->api_notify_batch.p_values,
+                                                    p_msg->api_notify_batch.num_values, &num_sent);
+
+        /* if over BR_EDR, inform PM for mode change */
+        if (transport == BTA_TRANSPORT_BR_EDR) {
+            bta_sys_busy(BTA_ID_GATTS, BTA_ALL_APP_ID, remote_bda);
+            bta_sys_idle(BTA_ID_GATTS, BTA_ALL_APP_ID, remote_bda);
+        }
+    } else {
+        APPL_TRACE_ERROR("Unknown connection ID: %d fail sending notification", conn_id);
+    }
+
+    if (p_rcb && p_rcb->p_cback) {
+        cb_data.notify_batch.status = status;
+        cb_data.notify_batch.conn_id = conn_id;
+        cb_data.notify_batch.num_sent = num_sent;
+        (*p_rcb->p_cback)(BTA_GATTS_NOTIFY_BATCH_EVT, &cb_data);
+    }
+}
 
 /*******************************************************************************
 **
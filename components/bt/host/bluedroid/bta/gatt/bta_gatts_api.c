@@ -436,6 +436,56 @@ void BTA_GATTS_HandleValueIndication (UINT16 conn_id, UINT16 attr_id, UINT16 dat
     return;
 
 }
+/*******************************************************************************
+**
+** Function         BTA_GATTS_HandleValueNotificationBatch
+**
+** Description      This function is called to send several notifications to
+**                  a client with a single message to BTA.
+**
+** Parameters       conn_id - connection identifier.
+**                  num_values - number of notifications.
+**                  p_values - handle, length and value of each notification.
+**
+** Returns          None
+**
+*******************************************************************************/
+void BTA_GATTS_HandleValueNotificationBatch (UINT16 conn_id, UINT16 num_values,
+                                             tGATT_HLV *p_values)
+{
+    tBTA_GATTS_API_NOTIFY_BATCH  *p_buf;
+    UINT16  len = sizeof(tBTA_GATTS_API_NOTIFY_BATCH) + num_values * sizeof(tGATT_HLV);
+    UINT8   *p;
+
+    for (UINT16 i = 0; i < num_values; i++) {
+        len += p_values[i].length;
+    }
+
+    if ((p_buf = (tBTA_GATTS_API_NOTIFY_BATCH *) osi_malloc(len)) != NULL) {
+        p_buf->hdr.event = BTA_GATTS_API_NOTIFY_BATCH_EVT;
+        p_buf->hdr.layer_specific = conn_id;
+        p_buf->num_values = num_values;
+        p_buf->p_values = (tGATT_HLV *)(p_buf + 1);
+
+        p = (UINT8 *)(p_buf->p_values + num_values);
+        for (UINT16 i = 0; i < num_values; i++) {
+            p_buf->p_values[i].handle = p_values[i].handle;
+            p_buf->p_values[i].length = p_values[i].length;
+            p_buf->p_values[i].value = p;
+            if (p_values[i].length > 0) {
+                memcpy(p, p_values[i].value, p_values[i].length);
+                p += p_values[i].length;
+            }
+        }
+
+        for (UINT16 i = 0; i < num_values; i++) {
+            l2ble_update_att_acl_pkt_num(L2CA_DECREASE_BTC_NUM, NULL);
+            l2ble_update_att_acl_pkt_num(L2CA_ADD_BTU_NUM, NULL);
+        }
+        bta_sys_sendmsg(p_buf);
+    }
+}
+
 /*******************************************************************************
 **
 ** Function         BTA_GATTS_SendRsp
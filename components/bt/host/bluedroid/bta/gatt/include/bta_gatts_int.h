@@ -53,7 +53,8 @@ enum {
     BTA_GATTS_API_CLOSE_EVT,
     BTA_GATTS_API_DISABLE_EVT,
     BTA_GATTS_API_SEND_SERVICE_CHANGE_EVT,
-    BTA_GATTS_API_SHOW_LOCAL_DATABASE_EVT
+    BTA_GATTS_API_SHOW_LOCAL_DATABASE_EVT,
+    BTA_GATTS_API_NOTIFY_BATCH_EVT
 };
 typedef UINT16 tBTA_GATTS_INT_EVT;
 
@@ -117,6 +118,12 @@ typedef struct {
     UINT8   value[BTA_GATT_MAX_ATTR_LEN];
 } tBTA_GATTS_API_INDICATION;
 
+typedef struct {
+    BT_HDR      hdr;
+    UINT16      num_values;
+    tGATT_HLV   *p_values;  /* tuples and their values follow this structure */
+} tBTA_GATTS_API_NOTIFY_BATCH;
+
 typedef struct {
     BT_HDR              hdr;
     UINT32              trans_id;
@@ -163,6 +170,7 @@ typedef union {
     tBTA_GATTS_API_ADD_DESCR        api_add_char_descr;
     tBTA_GATTS_API_START            api_start;
     tBTA_GATTS_API_INDICATION       api_indicate;
+    tBTA_GATTS_API_NOTIFY_BATCH     api_notify_batch;
     tBTA_GATTS_API_RSP              api_rsp;
     tBTA_GATTS_API_SET_ATTR_VAL     api_set_val;
     tBTA_GATTS_API_OPEN             api_open;
@@ -235,6 +243,7 @@ extern void bta_gatts_stop_service(tBTA_GATTS_SRVC_CB *p_srvc_cb, tBTA_GATTS_DAT
 
 extern void bta_gatts_send_rsp(tBTA_GATTS_CB *p_cb, tBTA_GATTS_DATA *p_msg);
 extern void bta_gatts_indicate_handle (tBTA_GATTS_CB *p_cb, tBTA_GATTS_DATA *p_msg);
+extern void bta_gatts_notify_batch (tBTA_GATTS_CB *p_cb, tBTA_GATTS_DATA *p_msg);
 
 
 extern void bta_gatts_open (tBTA_GATTS_CB *p_cb, tBTA_GATTS_DATA *p_msg);
@@ -481,6 +481,7 @@ typedef void (tBTA_GATTC_CBACK)(tBTA_GATTC_EVT event, tBTA_GATTC *p_data);
 #define BTA_GATTS_CONGEST_EVT                           20
 #define BTA_GATTS_SET_ATTR_VAL_EVT                      23
 #define BTA_GATTS_SEND_SERVICE_CHANGE_EVT               24
+#define BTA_GATTS_NOTIFY_BATCH_EVT                      25
 
 typedef UINT8  tBTA_GATTS_EVT;
 typedef tGATT_IF tBTA_GATTS_IF;
@@ -643,6 +644,12 @@ typedef struct {
     UINT16              conn_id;    /* connection ID */
 } tBTA_GATTS_CLOSE;
 
+typedef struct {
+    tBTA_GATT_STATUS    status;
+    UINT16              conn_id;    /* connection ID */
+    UINT16              num_sent;   /* number of notifications handed to L2CAP */
+} tBTA_GATTS_NOTIFY_BATCH;
+
 typedef struct {
     tBTA_GATT_STATUS    status;
     tBTA_GATTS_IF       server_if;
@@ -675,6 +682,7 @@ typedef union {
     tBTA_GATTS_OPEN             open;           /* BTA_GATTS_OPEN_EVT callback data */
     tBTA_GATTS_CANCEL_OPEN      cancel_open;    /* tBTA_GATTS_CANCEL_OPEN callback data */
     tBTA_GATTS_SERVICE_CHANGE   service_change;
+    tBTA_GATTS_NOTIFY_BATCH     notify_batch;   /* BTA_GATTS_NOTIFY_BATCH_EVT callback data */
 
 } tBTA_GATTS;
 
@@ -1418,6 +1426,23 @@ extern void BTA_GATTS_HandleValueIndication (UINT16 conn_id, UINT16 attr_id,
                                              UINT8 *p_data,
                                              BOOLEAN need_confirm);
 
+/*******************************************************************************
+**
+** Function         BTA_GATTS_HandleValueNotificationBatch
+**
+** Description      This function is called to send several notifications to
+**                  a client with a single message to BTA.
+**
+** Parameters       conn_id - connection identifier.
+**                  num_values - number of notifications.
+**                  p_values - handle, length and value of each notification.
+**
+** Returns          None
+**
+*******************************************************************************/
+extern void BTA_GATTS_HandleValueNotificationBatch (UINT16 conn_id, UINT16 num_values,
+                                                    tGATT_HLV *p_values);
+
 /*******************************************************************************
 **
 ** Function         BTA_GATTS_SendRsp
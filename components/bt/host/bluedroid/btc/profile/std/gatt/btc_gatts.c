@@ -18,6 +18,7 @@
 #include "esp_gatts_api.h"
 #include "btc/btc_storage.h"
 #include "common/bt_defs.h"
+#include "stack/l2c_api.h"
 
 #if (GATTS_INCLUDED == TRUE)
 
@@ -82,6 +83,29 @@ void btc_gatts_arg_deep_copy(btc_msg_t *msg, void *p_dest, void *p_src)
         }
         break;
     }
+    case BTC_GATTS_ACT_SEND_NOTIFY_BATCH: {
+        // Values are copied behind the array so that one allocation holds the whole batch
+        uint16_t num_values = src->send_notify_batch.num_values;
+        size_t len = sizeof(esp_gatts_notify_value_t) * num_values;
+        for (uint16_t i = 0; i < num_values; i++) {
+            len += src->send_notify_batch.values[i].value_len;
+        }
+        dst->send_notify_batch.values = (esp_gatts_notify_value_t *) osi_malloc(len);
+        if (dst->send_notify_batch.values) {
+            uint8_t *p = (uint8_t *)(dst->send_notify_batch.values + num_values);
+            for (uint16_t i = 0; i < num_values; i++) {
+                dst->send_notify_batch.values[i] = src->send_notify_batch.values[i];
+                dst->send_notify_batch.values[i].value = p;
+                if (src->send_notify_batch.values[i].value_len > 0) {
+                    memcpy(p, src->send_notify_batch.values[i].value, src->send_notify_batch.values[i].value_len);
+                    p += src->send_notify_batch.values[i].value_len;
+                }
+            }
+        } else {
+            BTC_TRACE_ERROR("%s %d no mem\n", __func__, msg->act);
+        }
+        break;
+    }
     case BTC_GATTS_ACT_SEND_RESPONSE: {
         if (src->send_rsp.rsp) {
             dst->send_rsp.rsp = (esp_gatt_rsp_t *) osi_malloc(sizeof(esp_gatt_rsp_t));
@@ -179,6 +203,12 @@ void btc_gatts_arg_deep_free(btc_msg_t *msg)
         }
         break;
     }
+    case BTC_GATTS_ACT_SEND_NOTIFY_BATCH: {
+        if (arg->send_notify_batch.values) {
+            osi_free(arg->send_notify_batch.values);
+        }
+        break;
+    }
     case BTC_GATTS_ACT_SEND_RESPONSE: {
         if (arg->send_rsp.rsp) {
             osi_free(arg->send_rsp.rsp);
@@ -752,6 +782,24 @@ void btc_gatts_call_handler(btc_msg_t *msg)
     case BTC_GATTS_ACT_SHOW_LOCAL_DATABASE:
         BTA_GATTS_ShowLocalDatabase();
         break;
+    case BTC_GATTS_ACT_SEND_NOTIFY_BATCH: {
+        tGATT_HLV tuples[ESP_GATTS_NOTIFY_BATCH_MAX];
+        uint16_t num_values = arg->send_notify_batch.num_values;
+        if (arg->send_notify_batch.values == NULL) {
+            // Release the buffers reserved by esp_ble_gatts_send_notify_batch
+            for (uint16_t i = 0; i < num_values; i++) {
+                l2ble_update_att_acl_pkt_num(L2CA_DECREASE_BTC_NUM, NULL);
+            }
+            break;
+        }
+        for (uint16_t i = 0; i < num_values; i++) {
+            tuples[i].handle = arg->send_notify_batch.values[i].attr_handle;
+            tuples[i].length = arg->send_notify_batch.values[i].value_len;
+            tuples[i].value = arg->send_notify_batch.values[i].value;
+        }
+        BTA_GATTS_HandleValueNotificationBatch(arg->send_notify_batch.conn_id, num_values, tuples);
+        break;
+    }
     default:
         break;
     }
@@ -957,6 +1005,13 @@ void btc_gatts_cb_handler(btc_msg_t *msg)
         param.service_change.status = p_data->service_change.status;
         btc_gatts_cb_to_app(ESP_GATTS_SEND_SERVICE_CHANGE_EVT, gatts_if, &param);
         break;
+    case BTA_GATTS_NOTIFY_BATCH_EVT:
+        gatts_if = BTC_GATT_GET_GATT_IF(p_data->notify_batch.conn_id);
+        param.notify_batch.status = p_data->notify_batch.status;
+        param.notify_batch.conn_id = BTC_GATT_GET_CONN_ID(p_data->notify_batch.conn_id);
+        param.notify_batch.num_sent = p_data->notify_batch.num_sent;
+        btc_gatts_cb_to_app(ESP_GATTS_SEND_NOTIFY_BATCH_EVT, gatts_if, &param);
+        break;
     case BTA_GATTS_LISTEN_EVT:
         // do nothing
         break;
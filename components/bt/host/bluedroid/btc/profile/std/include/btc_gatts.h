@@ -31,6 +31,7 @@ typedef enum {
     BTC_GATTS_ACT_CLOSE,
     BTC_GATTS_ACT_SEND_SERVICE_CHANGE,
     BTC_GATTS_ACT_SHOW_LOCAL_DATABASE,
+    BTC_GATTS_ACT_SEND_NOTIFY_BATCH,
 } btc_gatts_act_t;
 
 /* btc_ble_gatts_args_t */
@@ -142,6 +143,13 @@ typedef union {
         esp_bd_addr_t remote_bda;
     } send_service_change;
 
+    //BTC_GATTS_ACT_SEND_NOTIFY_BATCH,
+    struct send_notify_batch_args {
+        uint16_t conn_id;
+        uint16_t num_values;
+        esp_gatts_notify_value_t *values;
+    } send_notify_batch;
+
 } btc_ble_gatts_args_t;
 
 typedef struct {
@@ -6090,11 +6090,8 @@ static void btm_sec_check_pending_enc_req (tBTM_SEC_DEV_REC  *p_dev_rec, tBT_TRA
     }
 
     UINT8 res = encr_enable ? BTM_SUCCESS : BTM_ERR_PROCESSING;
-    list_t *list = fixed_queue_get_list(btm_cb.sec_pending_q);
-    for (const list_node_t *node = list_begin(list); node != list_end(list); ) {
-        tBTM_SEC_QUEUE_ENTRY *p_e = (tBTM_SEC_QUEUE_ENTRY *)list_node(node);
-        node = list_next(node);
-
+    tBTM_SEC_QUEUE_ENTRY *p_e;
+    for (size_t i = 0; (p_e = fixed_queue_try_peek_at(btm_cb.sec_pending_q, i)) != NULL; i++) {
         if (memcmp(p_e->bd_addr, p_dev_rec->bd_addr, BD_ADDR_LEN) == 0 && p_e->psm == 0
 #if BLE_INCLUDED == TRUE
             && p_e->transport == transport
@@ -6115,7 +6112,10 @@ static void btm_sec_check_pending_enc_req (tBTM_SEC_DEV_REC  *p_dev_rec, tBT_TRA
                     (*p_e->p_callback) (p_dev_rec->bd_addr, transport, p_e->p_ref_data, res);
                 }
 
-				fixed_queue_try_remove_from_queue(btm_cb.sec_pending_q, (void *)p_e);
+				if (fixed_queue_try_remove_from_queue(btm_cb.sec_pending_q, (void *)p_e)) {
+                    /* The next entry moved to the same position */
+                    i--;
+                }
             }
         }
     }
@@ -1782,6 +1782,11 @@ tGATT_STATUS GATTS_HandleMultiValueNotification (UINT16 conn_id, tGATT_HLV *tupl
             return GATT_ILLEGAL_PARAMETER;
         }
 
+        if (notif.len + 4 + p_hlv->length > GATT_MAX_ATTR_LEN) {
+            GATT_TRACE_ERROR("%s tuples too long", __func__);
+            return GATT_ILLEGAL_PARAMETER;
+        }
+
         UINT16_TO_STREAM(p, p_hlv->handle);   //handle
         UINT16_TO_STREAM(p, p_hlv->length);   //length
         memcpy (p, p_hlv->value, p_hlv->length); //value
@@ -1804,6 +1809,176 @@ tGATT_STATUS GATTS_HandleMultiValueNotification (UINT16 conn_id, tGATT_HLV *tupl
     return cmd_sent;
 }
 
+/*******************************************************************************
+**
+** Function         gatts_send_notif_pdu
+**
+** Description      Build and send one notification PDU. A single tuple goes
+**                  out as a Handle Value Notification, several tuples as a
+**                  Multiple Handle Value Notification.
+**
+** Returns          GATT_SUCCESS or GATT_CONGESTED if L2CAP took the PDU,
+**                  otherwise error code.
+**
+*******************************************************************************/
+static tGATT_STATUS gatts_send_notif_pdu (tGATT_TCB *p_tcb, tGATT_HLV *tuples, UINT16 num_tuples)
+{
+    BT_HDR          *p_buf;
+    tGATT_VALUE     notif;
+    UINT8           *p = notif.value;
+    UINT8           op_code;
+
+    notif.auth_req = GATT_AUTH_REQ_NONE;
+
+    if (num_tuples == 1) {
+        op_code = GATT_HANDLE_VALUE_NOTIF;
+        notif.handle = tuples->handle;
+        notif.len = tuples->length;
+        memcpy(notif.value, tuples->value, tuples->length);
+    } else {
+        op_code = GATT_HANDLE_MULTI_VALUE_NOTIF;
+        notif.len = 0;
+        for (UINT16 i = 0; i < num_tuples; i++) {
+            UINT16_TO_STREAM(p, tuples[i].handle);
+            UINT16_TO_STREAM(p, tuples[i].length);
+            memcpy(p, tuples[i].value, tuples[i].length);
+            p += tuples[i].length;
+            notif.len += 4 + tuples[i].length;
+        }
+    }
+
+    if ((p_buf = attp_build_sr_msg (p_tcb, op_code, (tGATT_SR_MSG *)&notif)) == NULL) {
+        return GATT_NO_RESOURCES;
+    }
+
+    return attp_send_sr_msg (p_tcb, p_buf);
+}
+
+/*******************************************************************************
+**
+** Function         gatts_multi_notif_batch_len
+**
+** Description      Count how many of the given tuples, from the first one,
+**                  fit in one Multiple Handle Value Notification of max_len
+**                  bytes without the opcode. The first tuple is always taken:
+**                  a value too long for a multi PDU goes out on its own, as a
+**                  regular notification truncated to the MTU.
+**
+** Parameter        tuples: Pointer to handle-length-value tuple list.
+**                  num_tuples: Number of tuples, at least 1.
+**                  max_len: PDU length available after the opcode.
+**
+** Returns          Number of tuples for the next PDU, at least 1.
+**
+*******************************************************************************/
+UINT16 gatts_multi_notif_batch_len(const tGATT_HLV *tuples, UINT16 num_tuples, UINT16 max_len)
+{
+    UINT16 len = 4 + tuples[0].length;
+    UINT16 num = 1;
+
+    while (num < num_tuples && len + 4 + tuples[num].length <= max_len) {
+        len += 4 + tuples[num].length;
+        num++;
+    }
+
+    return num;
+}
+
+/*******************************************************************************
+**
+** Function         GATTS_HandleValueNotificationBatch
+**
+** Description      This function sends a batch of handle value notifications
+**                  to a client in one go. If the client supports Multiple
+**                  Handle Value Notifications, consecutive tuples are packed
+**                  into as few PDUs as the MTU allows, otherwise every tuple
+**                  is sent as a separate notification. Sending stops when the
+**                  channel becomes congested.
+**
+** Parameter        conn_id: connection identifier.
+**                  tuples: Pointer to handle-length-value tuple list.
+**                  num_tuples: Number of tuples.
+**                  p_num_sent: Number of tuples handed to L2CAP.
+**
+** Returns          GATT_SUCCESS if all tuples were sent;
+**                  GATT_CONGESTED if the channel is congested, the tuples from
+**                  *p_num_sent on were not sent;
+**                  GATT_INVALID_CONN_ID if conn_id is unknown;
+**                  GATT_WRONG_STATE if the connection is not open;
+**                  GATT_ILLEGAL_PARAMETER if the tuple list is empty, or has
+**                  an invalid handle or a value longer than GATT_MAX_ATTR_LEN;
+**                  GATT_NO_RESOURCES or the L2CAP error if a PDU could not be
+**                  built or sent, the tuples from *p_num_sent on were not sent.
+**
+*******************************************************************************/
+tGATT_STATUS GATTS_HandleValueNotificationBatch (UINT16 conn_id, tGATT_HLV *tuples, UINT16 num_tuples,
+                                                 UINT16 *p_num_sent)
+{
+    tGATT_STATUS    status = GATT_SUCCESS;
+    tGATT_IF        gatt_if = GATT_GET_GATT_IF(conn_id);
+    UINT8           tcb_idx = GATT_GET_TCB_IDX(conn_id);
+    tGATT_REG       *p_reg = gatt_get_regcb(gatt_if);
+    tGATT_TCB       *p_tcb = gatt_get_tcb_by_idx(tcb_idx);
+    BOOLEAN         multi;
+    UINT16          max_len;
+    UINT16          sent = 0;
+    UINT16          num;
+
+    GATT_TRACE_API ("GATTS_HandleValueNotificationBatch");
+
+    if (p_num_sent) {
+        *p_num_sent = 0;
+    }
+
+    if ( (p_reg == NULL) || (p_tcb == NULL)) {
+        GATT_TRACE_ERROR ("GATTS_HandleValueNotificationBatch Unknown conn_id: %u \n", conn_id);
+        return (tGATT_STATUS) GATT_INVALID_CONN_ID;
+    }
+
+    if (!gatt_check_connection_state_by_tcb(p_tcb)) {
+        GATT_TRACE_ERROR("connection not established\n");
+        return GATT_WRONG_STATE;
+    }
+
+    if (tuples == NULL || num_tuples == 0) {
+        return GATT_ILLEGAL_PARAMETER;
+    }
+
+    for (UINT16 i = 0; i < num_tuples; i++) {
+        if (!GATT_HANDLE_IS_VALID (tuples[i].handle) || tuples[i].length > GATT_MAX_ATTR_LEN) {
+            return GATT_ILLEGAL_PARAMETER;
+        }
+    }
+
+    multi = gatt_sr_is_cl_multi_notif_supported(p_tcb);
+    /* opcode takes one byte of the PDU */
+    max_len = p_tcb->payload_size - 1;
+
+    while (sent < num_tuples) {
+        /* L2CAP drops PDUs once congested, do not lose the rest of the batch silently */
+        if (p_tcb->att_lcid == L2CAP_ATT_CID && L2CA_CheckIsCongest(L2CAP_ATT_CID, p_tcb->peer_bda)) {
+            status = GATT_CONGESTED;
+            break;
+        }
+
+        num = multi ? gatts_multi_notif_batch_len(&tuples[sent], num_tuples - sent, max_len) : 1;
+
+        status = gatts_send_notif_pdu(p_tcb, &tuples[sent], num);
+        if (status != GATT_SUCCESS && status != GATT_CONGESTED) {
+            break;
+        }
+        sent += num;
+    }
+
+    GATT_TRACE_DEBUG("%s sent %u/%u multi %d status %x", __func__, sent, num_tuples, multi, status);
+
+    if (p_num_sent) {
+        *p_num_sent = sent;
+    }
+
+    return status;
+}
+
 tGATT_STATUS GATTS_ShowLocalDatabase(void)
 {
     gatts_show_local_database();
@@ -696,6 +696,21 @@ void GATT_ConfigServiceChangeCCC (BD_ADDR remote_bda, BOOLEAN enable, tBT_TRANSP
     gatt_cl_start_config_ccc(p_clcb);
 }
 
+/*******************************************************************************
+**
+** Function         gatt_sr_is_cl_multi_notif_supported
+**
+** Description      Check if the client supports Multiple Handle Value
+**                  Notifications
+**
+** Returns          true if enabled by client side, otherwise false
+**
+*******************************************************************************/
+BOOLEAN gatt_sr_is_cl_multi_notif_supported(tGATT_TCB *p_tcb)
+{
+    return ((p_tcb->cl_supp_feat & BLE_GATT_CL_SUPP_FEAT_MULTI_NOTIF_BITMASK) != 0);
+}
+
 #if GATTS_ROBUST_CACHING_ENABLED
 /*******************************************************************************
 **
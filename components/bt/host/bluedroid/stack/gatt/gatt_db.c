@@ -75,10 +75,19 @@ BOOLEAN gatts_init_service_db (tGATT_SVC_DB *p_db, tBT_UUID *p_service,  BOOLEAN
         return FALSE;
     }
 
+    /* the handle index is kept in the service buffer queue, so that it is
+       freed together with the rest of the database */
+    if ((p_db->p_attr_index = (void **)osi_calloc(num_handle * sizeof(void *))) == NULL) {
+        GATT_TRACE_ERROR("gatts_init_service_db failed, no resources for the handle index\n");
+        return FALSE;
+    }
+    fixed_queue_enqueue(p_db->svc_buffer, p_db->p_attr_index, FIXED_QUEUE_MAX_TIMEOUT);
+
     GATT_TRACE_DEBUG("gatts_init_service_db\n");
     GATT_TRACE_DEBUG("s_hdl = %d num_handle = %d\n", s_hdl, num_handle );
 
     /* update service database information */
+    p_db->start_handle  = s_hdl;
     p_db->next_handle   = s_hdl;
     p_db->end_handle    = s_hdl + num_handle;
 
@@ -108,6 +117,62 @@ tBT_UUID *gatts_get_service_uuid (tGATT_SVC_DB *p_db)
     }
 }
 
+/*******************************************************************************
+**
+** Function         gatts_find_attr_by_handle
+**
+** Description      Find an attribute of the service database by its handle.
+**
+** Parameter        p_db: database pointer.
+**                  handle: attribute handle.
+**
+** Returns          Pointer to the attribute, either tGATT_ATTR16, tGATT_ATTR32
+**                  or tGATT_ATTR128, NULL if not found.
+**
+*******************************************************************************/
+void *gatts_find_attr_by_handle(tGATT_SVC_DB *p_db, UINT16 handle)
+{
+    if (!p_db || !p_db->p_attr_index ||
+            handle < p_db->start_handle || handle >= p_db->next_handle) {
+        return NULL;
+    }
+
+    return p_db->p_attr_index[handle - p_db->start_handle];
+}
+
+/*******************************************************************************
+**
+** Function         gatts_find_first_attr_from_handle
+**
+** Description      Find the first attribute of the service database whose
+**                  handle is not lower than the given handle. The following
+**                  attributes are reached through p_next in handle order.
+**
+** Parameter        p_db: database pointer.
+**                  handle: starting handle.
+**
+** Returns          Pointer to the attribute, NULL if not found.
+**
+*******************************************************************************/
+void *gatts_find_first_attr_from_handle(tGATT_SVC_DB *p_db, UINT16 handle)
+{
+    void *p_attr = NULL;
+
+    if (!p_db || !p_db->p_attr_index) {
+        return NULL;
+    }
+
+    if (handle < p_db->start_handle) {
+        handle = p_db->start_handle;
+    }
+
+    for (; handle < p_db->next_handle && p_attr == NULL; handle++) {
+        p_attr = p_db->p_attr_index[handle - p_db->start_handle];
+    }
+
+    return p_attr;
+}
+
 /*******************************************************************************
 **
 ** Function         gatts_check_attr_readability
@@ -347,9 +412,16 @@ tGATT_STATUS gatts_db_read_attr_value_by_type (tGATT_TCB   *p_tcb,
     BOOLEAN have_send_request = false;
 
     if (p_db && p_db->p_attr_list) {
-        p_attr = (tGATT_ATTR16 *)p_db->p_attr_list;
+        p_attr = (tGATT_ATTR16 *)gatts_find_first_attr_from_handle(p_db, s_handle);
 
         while (p_attr && p_attr->handle <= e_handle) {
+            /* most requests are for a 16 bits UUID, compare it directly */
+            if (type.len == LEN_UUID_16 && p_attr->uuid_type == GATT_ATTR_UUID_TYPE_16 &&
+                    type.uu.uuid16 != p_attr->uuid) {
+                p_attr = (tGATT_ATTR16 *)p_attr->p_next;
+                continue;
+            }
+
             if (p_attr->uuid_type == GATT_ATTR_UUID_TYPE_16) {
                 attr_uuid.len = LEN_UUID_16;
                 attr_uuid.uu.uuid16 = p_attr->uuid;
@@ -732,36 +804,32 @@ tGATT_STATUS gatts_set_attribute_value(tGATT_SVC_DB *p_db, UINT16 attr_handle,
         return GATT_INVALID_PDU;
     }
 
-    p_cur    =  (tGATT_ATTR16 *) p_db->p_attr_list;
+    p_cur = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, attr_handle);
 
-    while (p_cur != NULL) {
-        if (p_cur->handle == attr_handle) {
-            /* for characteristic should not be set, return GATT_NOT_FOUND */
-            if (p_cur->uuid_type == GATT_ATTR_UUID_TYPE_16) {
-                switch (p_cur->uuid) {
-                    case GATT_UUID_PRI_SERVICE:
-                    case GATT_UUID_SEC_SERVICE:
-                    case GATT_UUID_CHAR_DECLARE:
-                        return GATT_NOT_FOUND;
-                        break;
-                }
+    if (p_cur != NULL) {
+        /* for characteristic should not be set, return GATT_NOT_FOUND */
+        if (p_cur->uuid_type == GATT_ATTR_UUID_TYPE_16) {
+            switch (p_cur->uuid) {
+                case GATT_UUID_PRI_SERVICE:
+                case GATT_UUID_SEC_SERVICE:
+                case GATT_UUID_CHAR_DECLARE:
+                    return GATT_NOT_FOUND;
+                    break;
             }
+        }
 
-            /* in other cases, value can be set*/
-            if ((p_cur->p_value == NULL) || (p_cur->p_value->attr_val.attr_val == NULL) \
-                    || (p_cur->p_value->attr_val.attr_max_len == 0)){
-                GATT_TRACE_ERROR("Error in %s, line=%d, attribute value should not be NULL here\n", __func__, __LINE__);
-                return GATT_NOT_FOUND;
-            } else if (p_cur->p_value->attr_val.attr_max_len < length) {
-                GATT_TRACE_ERROR("gatts_set_attribute_value failed:Invalid value length");
-                return GATT_INVALID_ATTR_LEN;
-            } else{
-                memcpy(p_cur->p_value->attr_val.attr_val, value, length);
-                p_cur->p_value->attr_val.attr_len = length;
-            }
-            break;
+        /* in other cases, value can be set*/
+        if ((p_cur->p_value == NULL) || (p_cur->p_value->attr_val.attr_val == NULL) \
+                || (p_cur->p_value->attr_val.attr_max_len == 0)){
+            GATT_TRACE_ERROR("Error in %s, line=%d, attribute value should not be NULL here\n", __func__, __LINE__);
+            return GATT_NOT_FOUND;
+        } else if (p_cur->p_value->attr_val.attr_max_len < length) {
+            GATT_TRACE_ERROR("gatts_set_attribute_value failed:Invalid value length");
+            return GATT_INVALID_ATTR_LEN;
+        } else{
+            memcpy(p_cur->p_value->attr_val.attr_val, value, length);
+            p_cur->p_value->attr_val.attr_len = length;
         }
-        p_cur = p_cur->p_next;
     }
 
     return GATT_SUCCESS;
@@ -879,29 +947,16 @@ tGATT_STATUS gatts_get_attribute_value(tGATT_SVC_DB *p_db, UINT16 attr_handle,
         return GATT_INVALID_PDU;
     }
 
-    p_cur = (tGATT_ATTR16 *) p_db->p_attr_list;
-
-    while (p_cur != NULL) {
-        if (p_cur->handle == attr_handle) {
+    p_cur = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, attr_handle);
 
-            if (p_cur->uuid_type == GATT_ATTR_UUID_TYPE_16) {
-                switch (p_cur->uuid) {
-                case GATT_UUID_CHAR_DECLARE:
-                case GATT_UUID_INCLUDE_SERVICE:
-                    break;
-                default:
-                    if (p_cur->p_value &&  p_cur->p_value->attr_val.attr_len != 0) {
-                        *length = p_cur->p_value->attr_val.attr_len;
-                        *value = p_cur->p_value->attr_val.attr_val;
-                        return GATT_SUCCESS;
-                    } else {
-                        *length = 0;
-                        return GATT_SUCCESS;
-                    }
-                    break;
-                }
-            } else {
-                if (p_cur->p_value && p_cur->p_value->attr_val.attr_len != 0) {
+    if (p_cur != NULL) {
+        if (p_cur->uuid_type == GATT_ATTR_UUID_TYPE_16) {
+            switch (p_cur->uuid) {
+            case GATT_UUID_CHAR_DECLARE:
+            case GATT_UUID_INCLUDE_SERVICE:
+                break;
+            default:
+                if (p_cur->p_value &&  p_cur->p_value->attr_val.attr_len != 0) {
                     *length = p_cur->p_value->attr_val.attr_len;
                     *value = p_cur->p_value->attr_val.attr_val;
                     return GATT_SUCCESS;
@@ -909,14 +964,18 @@ tGATT_STATUS gatts_get_attribute_value(tGATT_SVC_DB *p_db, UINT16 attr_handle,
                     *length = 0;
                     return GATT_SUCCESS;
                 }
-
+                break;
+            }
+        } else {
+            if (p_cur->p_value && p_cur->p_value->attr_val.attr_len != 0) {
+                *length = p_cur->p_value->attr_val.attr_len;
+                *value = p_cur->p_value->attr_val.attr_val;
+                return GATT_SUCCESS;
+            } else {
+                *length = 0;
+                return GATT_SUCCESS;
             }
-
-            break;
-
         }
-
-        p_cur = p_cur->p_next;
     }
 
     return GATT_NOT_FOUND;
@@ -934,7 +993,7 @@ BOOLEAN gatts_is_auto_response(UINT16 attr_handle)
 
     p_db = &p_decl->svc_db;
 
-    tGATT_ATTR16  *p_cur, *p_next;
+    tGATT_ATTR16  *p_cur;
 
     if (p_db == NULL) {
         GATT_TRACE_DEBUG("gatts_get_attribute_value Fail:p_db is NULL.\n");
@@ -945,19 +1004,10 @@ BOOLEAN gatts_is_auto_response(UINT16 attr_handle)
         return rsp;
     }
 
-    p_cur    =  (tGATT_ATTR16 *) p_db->p_attr_list;
-    p_next  = (tGATT_ATTR16 *) p_cur->p_next;
-
-    for (; p_cur != NULL && p_next != NULL;
-            p_cur = p_next, p_next = (tGATT_ATTR16 *)p_next->p_next) {
-        if (p_cur->handle == attr_handle) {
-            if (p_cur->p_value != NULL && p_cur->control.auto_rsp == GATT_RSP_BY_STACK) {
-                rsp = true;
-                return rsp;
-            }
-
-        }
+    p_cur = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, attr_handle);
 
+    if (p_cur != NULL && p_cur->p_value != NULL && p_cur->control.auto_rsp == GATT_RSP_BY_STACK) {
+        rsp = true;
     }
 
     return rsp;
@@ -1000,22 +1050,14 @@ tGATT_STATUS gatts_read_attr_value_by_handle(tGATT_TCB *p_tcb,
     tGATT_ATTR16  *p_attr;
     UINT8       *pp = p_value;
 
-    if (p_db && p_db->p_attr_list) {
-        p_attr = (tGATT_ATTR16 *)p_db->p_attr_list;
-
-        while (p_attr && handle >= p_attr->handle) {
-            if (p_attr->handle == handle) {
-                status = read_attr_value (p_attr, offset, &pp,
-                                          (BOOLEAN)(op_code == GATT_REQ_READ_BLOB),
-                                          mtu, p_len, sec_flag, key_size);
+    if ((p_attr = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, handle)) != NULL) {
+        status = read_attr_value (p_attr, offset, &pp,
+                                  (BOOLEAN)(op_code == GATT_REQ_READ_BLOB),
+                                  mtu, p_len, sec_flag, key_size);
 
-                if ((status == GATT_PENDING) || (status == GATT_STACK_RSP)) {
-                    BOOLEAN need_rsp = (status != GATT_STACK_RSP);
-                    status = gatts_send_app_read_request(p_tcb, op_code, p_attr->handle, offset, trans_id, need_rsp);
-                }
-                break;
-            }
-            p_attr = (tGATT_ATTR16 *)p_attr->p_next;
+        if ((status == GATT_PENDING) || (status == GATT_STACK_RSP)) {
+            BOOLEAN need_rsp = (status != GATT_STACK_RSP);
+            status = gatts_send_app_read_request(p_tcb, op_code, p_attr->handle, offset, trans_id, need_rsp);
         }
     }
 
@@ -1030,33 +1072,24 @@ tGATT_STATUS gatts_write_attr_value_by_handle(tGATT_SVC_DB *p_db,
     tGATT_STATUS status = GATT_NOT_FOUND;
     tGATT_ATTR16  *p_attr;
 
-    if (p_db && p_db->p_attr_list) {
-        p_attr = (tGATT_ATTR16 *)p_db->p_attr_list;
-
-        while (p_attr && handle >= p_attr->handle) {
-            if (p_attr->handle == handle ) {
-                if (p_attr->control.auto_rsp == GATT_RSP_BY_APP) {
-                    return GATT_APP_RSP;
-                }
-
-                if ((p_attr->p_value != NULL) &&
-                    (p_attr->p_value->attr_val.attr_max_len >= offset + len) &&
-                    p_attr->p_value->attr_val.attr_val != NULL) {
-                    memcpy(p_attr->p_value->attr_val.attr_val + offset, p_value, len);
-                    p_attr->p_value->attr_val.attr_len = len + offset;
-                    return GATT_SUCCESS;
-                } else if (p_attr->p_value && p_attr->p_value->attr_val.attr_max_len < offset + len){
-                    GATT_TRACE_DEBUG("Remote device try to write with a length larger then attribute's max length\n");
-                    return GATT_INVALID_ATTR_LEN;
-                } else if ((p_attr->p_value == NULL) || (p_attr->p_value->attr_val.attr_val == NULL)){
-                    GATT_TRACE_ERROR("Error in %s, line=%d, %s should not be NULL here\n", __func__, __LINE__, \
-                                    (p_attr->p_value == NULL) ? "p_value" : "attr_val.attr_val");
-                    return GATT_UNKNOWN_ERROR;
-                }
-            }
-
-            p_attr = (tGATT_ATTR16 *)p_attr->p_next;
+    if ((p_attr = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, handle)) != NULL) {
+        if (p_attr->control.auto_rsp == GATT_RSP_BY_APP) {
+            return GATT_APP_RSP;
+        }
 
+        if ((p_attr->p_value != NULL) &&
+            (p_attr->p_value->attr_val.attr_max_len >= offset + len) &&
+            p_attr->p_value->attr_val.attr_val != NULL) {
+            memcpy(p_attr->p_value->attr_val.attr_val + offset, p_value, len);
+            p_attr->p_value->attr_val.attr_len = len + offset;
+            return GATT_SUCCESS;
+        } else if (p_attr->p_value && p_attr->p_value->attr_val.attr_max_len < offset + len){
+            GATT_TRACE_DEBUG("Remote device try to write with a length larger then attribute's max length\n");
+            return GATT_INVALID_ATTR_LEN;
+        } else if ((p_attr->p_value == NULL) || (p_attr->p_value->attr_val.attr_val == NULL)){
+            GATT_TRACE_ERROR("Error in %s, line=%d, %s should not be NULL here\n", __func__, __LINE__, \
+                            (p_attr->p_value == NULL) ? "p_value" : "attr_val.attr_val");
+            return GATT_UNKNOWN_ERROR;
         }
     }
 
@@ -1091,18 +1124,10 @@ tGATT_STATUS gatts_read_attr_perm_check(tGATT_SVC_DB *p_db,
     tGATT_STATUS status = GATT_NOT_FOUND;
     tGATT_ATTR16  *p_attr;
 
-    if (p_db && p_db->p_attr_list) {
-        p_attr = (tGATT_ATTR16 *)p_db->p_attr_list;
-
-        while (p_attr && handle >= p_attr->handle) {
-            if (p_attr->handle == handle) {
-                status = gatts_check_attr_readability (p_attr, 0,
-                                                       is_long,
-                                                       sec_flag, key_size);
-                break;
-            }
-            p_attr = (tGATT_ATTR16 *) p_attr->p_next;
-        }
+    if ((p_attr = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, handle)) != NULL) {
+        status = gatts_check_attr_readability (p_attr, 0,
+                                               is_long,
+                                               sec_flag, key_size);
     }
 
     return status;
@@ -1140,133 +1165,124 @@ tGATT_STATUS gatts_write_attr_perm_check (tGATT_SVC_DB *p_db, UINT8 op_code,
     GATT_TRACE_DEBUG( "gatts_write_attr_perm_check op_code=0x%0x handle=0x%04x offset=%d len=%d sec_flag=0x%0x key_size=%d",
                       op_code, handle, offset, len, sec_flag, key_size);
 
-    if (p_db != NULL) {
-        p_attr = (tGATT_ATTR16 *) p_db->p_attr_list;
-
-        while (p_attr != NULL) {
-            if (p_attr->handle == handle) {
-                perm = p_attr->permission;
-                min_key_size = (((perm & GATT_ENCRYPT_KEY_SIZE_MASK) >> 12));
-                if (min_key_size != 0 ) {
-                    min_key_size += 6;
-                }
-                GATT_TRACE_DEBUG( "gatts_write_attr_perm_check p_attr->permission =0x%04x min_key_size==0x%04x",
-                                  p_attr->permission,
-                                  min_key_size);
-
-                if ((op_code == GATT_CMD_WRITE || op_code == GATT_REQ_WRITE)
-                        && (perm & GATT_WRITE_SIGNED_PERM)) {
-                    /* use the rules for the mixed security see section 10.2.3*/
-                    /* use security mode 1 level 2 when the following condition follows */
-                    /* LE security mode 2 level 1 and LE security mode 1 level 2 */
-                    if ((perm & GATT_PERM_WRITE_SIGNED) && (perm & GATT_PERM_WRITE_ENCRYPTED)) {
-                        perm = GATT_PERM_WRITE_ENCRYPTED;
-                    }
-                    /* use security mode 1 level 3 when the following condition follows */
-                    /* LE security mode 2 level 2 and security mode 1 and LE */
-                    else if (((perm & GATT_PERM_WRITE_SIGNED_MITM) && (perm & GATT_PERM_WRITE_ENCRYPTED)) ||
-                             /* LE security mode 2 and security mode 1 level 3 */
-                             ((perm & GATT_WRITE_SIGNED_PERM) && (perm & GATT_PERM_WRITE_ENC_MITM))) {
-                        perm = GATT_PERM_WRITE_ENC_MITM;
-                    }
-                }
+    if ((p_attr = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, handle)) != NULL) {
+        perm = p_attr->permission;
+        min_key_size = (((perm & GATT_ENCRYPT_KEY_SIZE_MASK) >> 12));
+        if (min_key_size != 0 ) {
+            min_key_size += 6;
+        }
+        GATT_TRACE_DEBUG( "gatts_write_attr_perm_check p_attr->permission =0x%04x min_key_size==0x%04x",
+                          p_attr->permission,
+                          min_key_size);
+
+        if ((op_code == GATT_CMD_WRITE || op_code == GATT_REQ_WRITE)
+                && (perm & GATT_WRITE_SIGNED_PERM)) {
+            /* use the rules for the mixed security see section 10.2.3*/
+            /* use security mode 1 level 2 when the following condition follows */
+            /* LE security mode 2 level 1 and LE security mode 1 level 2 */
+            if ((perm & GATT_PERM_WRITE_SIGNED) && (perm & GATT_PERM_WRITE_ENCRYPTED)) {
+                perm = GATT_PERM_WRITE_ENCRYPTED;
+            }
+            /* use security mode 1 level 3 when the following condition follows */
+            /* LE security mode 2 level 2 and security mode 1 and LE */
+            else if (((perm & GATT_PERM_WRITE_SIGNED_MITM) && (perm & GATT_PERM_WRITE_ENCRYPTED)) ||
+                     /* LE security mode 2 and security mode 1 level 3 */
+                     ((perm & GATT_WRITE_SIGNED_PERM) && (perm & GATT_PERM_WRITE_ENC_MITM))) {
+                perm = GATT_PERM_WRITE_ENC_MITM;
+            }
+        }
 
-                if ((op_code == GATT_SIGN_CMD_WRITE) && !(perm & GATT_WRITE_SIGNED_PERM)) {
-                    status = GATT_WRITE_NOT_PERMIT;
-                    GATT_TRACE_DEBUG( "gatts_write_attr_perm_check - sign cmd write not allowed,handle %04x,perm %04x", handle, perm);
-                }
-                if ((op_code == GATT_SIGN_CMD_WRITE) && (sec_flag & GATT_SEC_FLAG_ENCRYPTED)) {
-                    status = GATT_INVALID_PDU;
-                    GATT_TRACE_ERROR( "gatts_write_attr_perm_check - Error!! sign cmd write sent on a encrypted link,handle %04x,perm %04x", handle, perm);
-                } else if (!(perm & GATT_WRITE_ALLOWED)) {
+        if ((op_code == GATT_SIGN_CMD_WRITE) && !(perm & GATT_WRITE_SIGNED_PERM)) {
+            status = GATT_WRITE_NOT_PERMIT;
+            GATT_TRACE_DEBUG( "gatts_write_attr_perm_check - sign cmd write not allowed,handle %04x,perm %04x", handle, perm);
+        }
+        if ((op_code == GATT_SIGN_CMD_WRITE) && (sec_flag & GATT_SEC_FLAG_ENCRYPTED)) {
+            status = GATT_INVALID_PDU;
+            GATT_TRACE_ERROR( "gatts_write_attr_perm_check - Error!! sign cmd write sent on a encrypted link,handle %04x,perm %04x", handle, perm);
+        } else if (!(perm & GATT_WRITE_ALLOWED)) {
+            status = GATT_WRITE_NOT_PERMIT;
+            GATT_TRACE_ERROR("gatts_write_attr_perm_check - GATT_WRITE_NOT_PERMIT,handle %04x, perm %04x", handle, perm);
+        }
+        /* require authentication, but not been authenticated */
+        else if ((perm & GATT_WRITE_AUTH_REQUIRED ) && !(sec_flag & GATT_SEC_FLAG_LKEY_UNAUTHED)) {
+            status = GATT_INSUF_AUTHENTICATION;
+            GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHENTICATION,handle %04x, perm %04x", handle, perm);
+        } else if ((perm & GATT_WRITE_MITM_REQUIRED ) && !(sec_flag & GATT_SEC_FLAG_LKEY_AUTHED)) {
+            status = GATT_INSUF_AUTHENTICATION;
+            GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHENTICATION: MITM required,handle %04x,perm %04x", handle, perm);
+        } else if ((perm & GATT_WRITE_ENCRYPTED_PERM ) && !(sec_flag & GATT_SEC_FLAG_ENCRYPTED)) {
+            status = GATT_INSUF_ENCRYPTION;
+            GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_ENCRYPTION,handle:0x%04x, perm:0x%04x", handle, perm);
+        } else if ((perm & GATT_WRITE_ENCRYPTED_PERM ) && (sec_flag & GATT_SEC_FLAG_ENCRYPTED) && (key_size < min_key_size)) {
+            status = GATT_INSUF_KEY_SIZE;
+            GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_KEY_SIZE,handle %04x,perm %04x", handle, perm);
+        }
+        /* LE Authorization check*/
+        else if ((perm & GATT_WRITE_AUTHORIZATION) && (!(sec_flag & GATT_SEC_FLAG_LKEY_AUTHED) || !(sec_flag & GATT_SEC_FLAG_AUTHORIZATION))){
+            status = GATT_INSUF_AUTHORIZATION;
+            GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHORIZATION,handle %04x,perm %04x", handle, perm);
+        }
+        /* LE security mode 2 attribute  */
+        else if (perm & GATT_WRITE_SIGNED_PERM && op_code != GATT_SIGN_CMD_WRITE && !(sec_flag & GATT_SEC_FLAG_ENCRYPTED)
+                 &&  (perm & GATT_WRITE_ALLOWED) == 0) {
+            status = GATT_INSUF_AUTHENTICATION;
+            GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHENTICATION: LE security mode 2 required,handle %04x,perm %04x", handle, perm);
+        } else { /* writable: must be char value declaration or char descriptors */
+            if (p_attr->uuid_type == GATT_ATTR_UUID_TYPE_16) {
+                switch (p_attr->uuid) {
+                case GATT_UUID_CHAR_PRESENT_FORMAT:/* should be readable only */
+                case GATT_UUID_CHAR_EXT_PROP:/* should be readable only */
+                case GATT_UUID_CHAR_AGG_FORMAT: /* should be readable only */
+                case GATT_UUID_CHAR_VALID_RANGE:
                     status = GATT_WRITE_NOT_PERMIT;
-                    GATT_TRACE_ERROR("gatts_write_attr_perm_check - GATT_WRITE_NOT_PERMIT,handle %04x, perm %04x", handle, perm);
-                }
-                /* require authentication, but not been authenticated */
-                else if ((perm & GATT_WRITE_AUTH_REQUIRED ) && !(sec_flag & GATT_SEC_FLAG_LKEY_UNAUTHED)) {
-                    status = GATT_INSUF_AUTHENTICATION;
-                    GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHENTICATION,handle %04x, perm %04x", handle, perm);
-                } else if ((perm & GATT_WRITE_MITM_REQUIRED ) && !(sec_flag & GATT_SEC_FLAG_LKEY_AUTHED)) {
-                    status = GATT_INSUF_AUTHENTICATION;
-                    GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHENTICATION: MITM required,handle %04x,perm %04x", handle, perm);
-                } else if ((perm & GATT_WRITE_ENCRYPTED_PERM ) && !(sec_flag & GATT_SEC_FLAG_ENCRYPTED)) {
-                    status = GATT_INSUF_ENCRYPTION;
-                    GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_ENCRYPTION,handle:0x%04x, perm:0x%04x", handle, perm);
-                } else if ((perm & GATT_WRITE_ENCRYPTED_PERM ) && (sec_flag & GATT_SEC_FLAG_ENCRYPTED) && (key_size < min_key_size)) {
-                    status = GATT_INSUF_KEY_SIZE;
-                    GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_KEY_SIZE,handle %04x,perm %04x", handle, perm);
-                }
-                /* LE Authorization check*/
-                else if ((perm & GATT_WRITE_AUTHORIZATION) && (!(sec_flag & GATT_SEC_FLAG_LKEY_AUTHED) || !(sec_flag & GATT_SEC_FLAG_AUTHORIZATION))){
-                    status = GATT_INSUF_AUTHORIZATION;
-                    GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHORIZATION,handle %04x,perm %04x", handle, perm);
+                    break;
+                case GATT_UUID_GAP_ICON:/* The Appearance characteristic value shall be 2 octets in length */
+                case GATT_UUID_CHAR_CLIENT_CONFIG:
+                /* coverity[MISSING_BREAK] */
+                /* intnended fall through, ignored */
+                /* fall through */
+                case GATT_UUID_CHAR_SRVR_CONFIG:
+                    max_size = 2;
+                    status = GATT_SUCCESS;
+                    break;
+                case GATT_UUID_CLIENT_SUP_FEAT:
+                    max_size = 1;
+                    status = GATT_SUCCESS;
+                    break;
+                case GATT_UUID_CHAR_DESCRIPTION:
+                default: /* any other must be character value declaration */
+                    status = GATT_SUCCESS;
+                    break;
                 }
-                /* LE security mode 2 attribute  */
-                else if (perm & GATT_WRITE_SIGNED_PERM && op_code != GATT_SIGN_CMD_WRITE && !(sec_flag & GATT_SEC_FLAG_ENCRYPTED)
-                         &&  (perm & GATT_WRITE_ALLOWED) == 0) {
-                    status = GATT_INSUF_AUTHENTICATION;
-                    GATT_TRACE_ERROR( "gatts_write_attr_perm_check - GATT_INSUF_AUTHENTICATION: LE security mode 2 required,handle %04x,perm %04x", handle, perm);
-                } else { /* writable: must be char value declaration or char descriptors */
-                    if (p_attr->uuid_type == GATT_ATTR_UUID_TYPE_16) {
-                        switch (p_attr->uuid) {
-                        case GATT_UUID_CHAR_PRESENT_FORMAT:/* should be readable only */
-                        case GATT_UUID_CHAR_EXT_PROP:/* should be readable only */
-                        case GATT_UUID_CHAR_AGG_FORMAT: /* should be readable only */
-                        case GATT_UUID_CHAR_VALID_RANGE:
-                            status = GATT_WRITE_NOT_PERMIT;
-                            break;
-                        case GATT_UUID_GAP_ICON:/* The Appearance characteristic value shall be 2 octets in length */
-                        case GATT_UUID_CHAR_CLIENT_CONFIG:
-                        /* coverity[MISSING_BREAK] */
-                        /* intnended fall through, ignored */
-                        /* fall through */
-                        case GATT_UUID_CHAR_SRVR_CONFIG:
-                            max_size = 2;
-                            status = GATT_SUCCESS;
-                            break;
-                        case GATT_UUID_CLIENT_SUP_FEAT:
-                            max_size = 1;
-                            status = GATT_SUCCESS;
-                            break;
-                        case GATT_UUID_CHAR_DESCRIPTION:
-                        default: /* any other must be character value declaration */
-                            status = GATT_SUCCESS;
-                            break;
-                        }
-                    } else if (p_attr->uuid_type == GATT_ATTR_UUID_TYPE_128 ||
-                               p_attr->uuid_type == GATT_ATTR_UUID_TYPE_32) {
-                        status = GATT_SUCCESS;
-                    } else {
-                        status = GATT_INVALID_PDU;
-                    }
+            } else if (p_attr->uuid_type == GATT_ATTR_UUID_TYPE_128 ||
+                       p_attr->uuid_type == GATT_ATTR_UUID_TYPE_32) {
+                status = GATT_SUCCESS;
+            } else {
+                status = GATT_INVALID_PDU;
+            }
 
-                    if (p_data == NULL && len  > 0) {
-                        status = GATT_INVALID_PDU;
-                    }
-                    /* these attribute does not allow write blob */
+            if (p_data == NULL && len  > 0) {
+                status = GATT_INVALID_PDU;
+            }
+            /* these attribute does not allow write blob */
 // btla-specific ++
-                    else if ( (p_attr->uuid_type == GATT_ATTR_UUID_TYPE_16) &&
-                              (p_attr->uuid == GATT_UUID_CHAR_CLIENT_CONFIG ||
-                               p_attr->uuid == GATT_UUID_CHAR_SRVR_CONFIG   ||
-                               p_attr->uuid == GATT_UUID_CLIENT_SUP_FEAT    ||
-                               p_attr->uuid == GATT_UUID_GAP_ICON
-                               ) )
+            else if ( (p_attr->uuid_type == GATT_ATTR_UUID_TYPE_16) &&
+                      (p_attr->uuid == GATT_UUID_CHAR_CLIENT_CONFIG ||
+                       p_attr->uuid == GATT_UUID_CHAR_SRVR_CONFIG   ||
+                       p_attr->uuid == GATT_UUID_CLIENT_SUP_FEAT    ||
+                       p_attr->uuid == GATT_UUID_GAP_ICON
+                       ) )
 // btla-specific --
-                    {
-                        if (op_code == GATT_REQ_PREPARE_WRITE) { /* does not allow write blob */
-                            status = GATT_REQ_NOT_SUPPORTED;
-                            GATT_TRACE_ERROR("gatts_write_attr_perm_check - GATT_REQ_NOT_SUPPORTED,handle %04x,opcode %4x", handle, op_code);
-                        } else if (len != max_size) { /* data does not match the required format */
-                            status = GATT_INVALID_ATTR_LEN;
-                            GATT_TRACE_ERROR("gatts_write_attr_perm_check - GATT_INVALID_ATTR_LEN,handle %04x,op_code %04x,len %d,max_size %d", handle, op_code, len, max_size);
-                        } else {
-                            status = GATT_SUCCESS;
-                        }
-                    }
+            {
+                if (op_code == GATT_REQ_PREPARE_WRITE) { /* does not allow write blob */
+                    status = GATT_REQ_NOT_SUPPORTED;
+                    GATT_TRACE_ERROR("gatts_write_attr_perm_check - GATT_REQ_NOT_SUPPORTED,handle %04x,opcode %4x", handle, op_code);
+                } else if (len != max_size) { /* data does not match the required format */
+                    status = GATT_INVALID_ATTR_LEN;
+                    GATT_TRACE_ERROR("gatts_write_attr_perm_check - GATT_INVALID_ATTR_LEN,handle %04x,op_code %04x,len %d,max_size %d", handle, op_code, len, max_size);
+                } else {
+                    status = GATT_SUCCESS;
                 }
-                break;
-            } else {
-                p_attr = (tGATT_ATTR16 *)p_attr->p_next;
             }
         }
     }
@@ -1344,19 +1360,26 @@ static void *allocate_attr_in_db(tGATT_SVC_DB *p_db, tBT_UUID *p_uuid, tGATT_PER
     p_attr16->permission = perm;
     p_attr16->p_next = NULL;
 
-    /* link the attribute record into the end of DB */
+    /* link the attribute record into the end of DB, handles are allocated in
+       increasing order so the last attribute is the one of the previous handle */
     if (p_db->p_attr_list == NULL) {
         p_db->p_attr_list = p_attr16;
     } else {
-        p_last = (tGATT_ATTR16 *)p_db->p_attr_list;
+        p_last = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, p_attr16->handle - 1);
+
+        if (p_last == NULL) {
+            p_last = (tGATT_ATTR16 *)p_db->p_attr_list;
 
-        while (p_last != NULL && p_last->p_next != NULL) {
-            p_last = (tGATT_ATTR16 *)p_last->p_next;
+            while (p_last != NULL && p_last->p_next != NULL) {
+                p_last = (tGATT_ATTR16 *)p_last->p_next;
+            }
         }
 
         p_last->p_next = p_attr16;
     }
 
+    p_db->p_attr_index[p_attr16->handle - p_db->start_handle] = p_attr16;
+
     if (p_attr16->uuid_type == GATT_ATTR_UUID_TYPE_16) {
         GATT_TRACE_DEBUG("=====> handle = [0x%04x] uuid16 = [0x%04x] perm=0x%02x\n",
                          p_attr16->handle, p_attr16->uuid, p_attr16->permission);
@@ -1411,6 +1434,7 @@ static BOOLEAN deallocate_attr_in_db(tGATT_SVC_DB *p_db, void *p_attr)
     /* else attr not found */
     if ( found) {
         p_db->next_handle --;
+        p_db->p_attr_index[((tGATT_ATTR16 *)p_attr)->handle - p_db->start_handle] = NULL;
     }
 
     return found;
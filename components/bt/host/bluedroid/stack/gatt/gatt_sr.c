@@ -201,23 +201,8 @@ static BOOLEAN process_read_multi_rsp (tGATT_SR_CMD *p_cmd, tGATT_STATUS status,
             p_buf->len = 1;
 
             /* Now walk through the buffers putting the data into the response in order */
-            list_t *list = NULL;
-            const list_node_t *node = NULL;
-            if (! fixed_queue_is_empty(p_cmd->multi_rsp_q)) {
-                list = fixed_queue_get_list(p_cmd->multi_rsp_q);
-			}
             for (ii = 0; ii < p_cmd->multi_req.num_handles; ii++) {
-                tGATTS_RSP *p_rsp = NULL;
-                if (list != NULL) {
-                    if (ii == 0) {
-                        node = list_begin(list);
-                    } else {
-                        node = list_next(node);
-					}
-                    if (node != list_end(list)) {
-                        p_rsp = (tGATTS_RSP *)list_node(node);
-					}
-                }
+                tGATTS_RSP *p_rsp = (tGATTS_RSP *)fixed_queue_try_peek_at(p_cmd->multi_rsp_q, ii);
 
                 if (p_rsp != NULL) {
 
@@ -322,23 +307,8 @@ static BOOLEAN process_read_multi_var_rsp (tGATT_SR_CMD *p_cmd, tGATT_STATUS sta
             p_buf->len = 1;
 
             /* Now walk through the buffers putting the data into the response in order */
-            list_t *list = NULL;
-            const list_node_t *node = NULL;
-            if (! fixed_queue_is_empty(p_cmd->multi_rsp_q)) {
-                list = fixed_queue_get_list(p_cmd->multi_rsp_q);
-			}
             for (ii = 0; ii < p_cmd->multi_req.num_handles; ii++) {
-                tGATTS_RSP *p_rsp = NULL;
-                if (list != NULL) {
-                    if (ii == 0) {
-                        node = list_begin(list);
-                    } else {
-                        node = list_next(node);
-					}
-                    if (node != list_end(list)) {
-                        p_rsp = (tGATTS_RSP *)list_node(node);
-					}
-                }
+                tGATTS_RSP *p_rsp = (tGATTS_RSP *)fixed_queue_try_peek_at(p_cmd->multi_rsp_q, ii);
 
                 if (p_rsp != NULL) {
 
@@ -805,7 +775,7 @@ static tGATT_STATUS gatt_build_find_info_rsp(tGATT_SR_REG *p_rcb, BT_HDR *p_msg,
     }
 
     /* check the attribute database */
-    p_attr = (tGATT_ATTR16 *) p_rcb->p_db->p_attr_list;
+    p_attr = (tGATT_ATTR16 *)gatts_find_first_attr_from_handle(p_rcb->p_db, s_hdl);
 
     p = (UINT8 *)(p_msg + 1) + L2CAP_MIN_OFFSET + p_msg->len;
 
@@ -1359,36 +1329,30 @@ void gatt_attr_process_prepare_write (tGATT_TCB *p_tcb, UINT8 i_rcb, UINT16 hand
     if (status == GATT_SUCCESS){
         if ((trans_id = gatt_sr_enqueue_cmd(p_tcb, op_code, handle)) != 0) {
             p_db = gatt_cb.sr_reg[i_rcb].p_db;
-            if (p_db && p_db->p_attr_list) {
-                p_attr = (tGATT_ATTR16 *)p_db->p_attr_list;
-                while (p_attr && handle >= p_attr->handle) {
-                    if (p_attr->handle == handle ) {
-                        p_attr_temp = p_attr;
-                        if (p_attr->control.auto_rsp == GATT_RSP_BY_APP) {
-                            status = GATT_APP_RSP;
-                        } else if (p_attr->p_value != NULL &&
-                            offset > p_attr->p_value->attr_val.attr_max_len) {
-                            status = GATT_INVALID_OFFSET;
-                             is_need_prepare_write_rsp = TRUE;
-                             is_need_queue_data = TRUE;
-                        } else if (p_attr->p_value != NULL &&
-                            ((offset + len) > p_attr->p_value->attr_val.attr_max_len)){
-                            status = GATT_INVALID_ATTR_LEN;
-                            is_need_prepare_write_rsp = TRUE;
-                            is_need_queue_data = TRUE;
-                        } else if (p_attr->p_value == NULL) {
-                            GATT_TRACE_ERROR("Error in %s, attribute of handle 0x%x not allocate value buffer\n",
-                                        __func__, handle);
-                            status = GATT_UNKNOWN_ERROR;
-                        } else {
-                             //valid prepare write request, need to send response and queue the data
-                             //status: GATT_SUCCESS
-                             is_need_prepare_write_rsp = TRUE;
-                             is_need_queue_data = TRUE;
-                         }
-                    }
-                    p_attr = (tGATT_ATTR16 *)p_attr->p_next;
-                }
+            if ((p_attr = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_db, handle)) != NULL) {
+                p_attr_temp = p_attr;
+                if (p_attr->control.auto_rsp == GATT_RSP_BY_APP) {
+                    status = GATT_APP_RSP;
+                } else if (p_attr->p_value != NULL &&
+                    offset > p_attr->p_value->attr_val.attr_max_len) {
+                    status = GATT_INVALID_OFFSET;
+                     is_need_prepare_write_rsp = TRUE;
+                     is_need_queue_data = TRUE;
+                } else if (p_attr->p_value != NULL &&
+                    ((offset + len) > p_attr->p_value->attr_val.attr_max_len)){
+                    status = GATT_INVALID_ATTR_LEN;
+                    is_need_prepare_write_rsp = TRUE;
+                    is_need_queue_data = TRUE;
+                } else if (p_attr->p_value == NULL) {
+                    GATT_TRACE_ERROR("Error in %s, attribute of handle 0x%x not allocate value buffer\n",
+                                __func__, handle);
+                    status = GATT_UNKNOWN_ERROR;
+                } else {
+                     //valid prepare write request, need to send response and queue the data
+                     //status: GATT_SUCCESS
+                     is_need_prepare_write_rsp = TRUE;
+                     is_need_queue_data = TRUE;
+                 }
             }
         } else{
             status = GATT_UNKNOWN_ERROR;
@@ -1571,31 +1535,27 @@ void gatts_process_attribute_req (tGATT_TCB *p_tcb, UINT8 op_code,
     if (GATT_HANDLE_IS_VALID(handle)) {
         for (i = 0; i < GATT_MAX_SR_PROFILES; i ++, p_rcb ++) {
             if (p_rcb->in_use && p_rcb->s_hdl <= handle && p_rcb->e_hdl >= handle) {
-                p_attr = (tGATT_ATTR16 *)p_rcb->p_db->p_attr_list;
-
-                while (p_attr) {
-                    if (p_attr->handle == handle) {
-                        switch (op_code) {
-                        case GATT_REQ_READ: /* read char/char descriptor value */
-                        case GATT_REQ_READ_BLOB:
-                            gatts_process_read_req(p_tcb, p_rcb, op_code, handle, len, p);
-                            break;
-
-                        case GATT_REQ_WRITE: /* write char/char descriptor value */
-                        case GATT_CMD_WRITE:
-                        case GATT_SIGN_CMD_WRITE:
-                            gatts_process_write_req(p_tcb, i, handle, op_code, len, p);
-                            break;
-
-                        case GATT_REQ_PREPARE_WRITE:
-                            gatt_attr_process_prepare_write (p_tcb, i, handle, op_code, len, p);
-                        default:
-                            break;
-                        }
-                        status = GATT_SUCCESS;
+                p_attr = (tGATT_ATTR16 *)gatts_find_attr_by_handle(p_rcb->p_db, handle);
+
+                if (p_attr) {
+                    switch (op_code) {
+                    case GATT_REQ_READ: /* read char/char descriptor value */
+                    case GATT_REQ_READ_BLOB:
+                        gatts_process_read_req(p_tcb, p_rcb, op_code, handle, len, p);
+                        break;
+
+                    case GATT_REQ_WRITE: /* write char/char descriptor value */
+                    case GATT_CMD_WRITE:
+                    case GATT_SIGN_CMD_WRITE:
+                        gatts_process_write_req(p_tcb, i, handle, op_code, len, p);
+                        break;
+
+                    case GATT_REQ_PREPARE_WRITE:
+                        gatt_attr_process_prepare_write (p_tcb, i, handle, op_code, len, p);
+                    default:
                         break;
                     }
-                    p_attr = (tGATT_ATTR16 *)p_attr->p_next;
+                    status = GATT_SUCCESS;
                 }
                 break;
             }
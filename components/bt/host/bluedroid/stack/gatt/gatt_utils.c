@@ -198,12 +198,10 @@ void gatt_set_srv_chg(void)
         return;
 	}
 
-    list_t *list = fixed_queue_get_list(gatt_cb.srv_chg_clt_q);
-    for (const list_node_t *node = list_begin(list); node != list_end(list);
-         node = list_next(node)) {
+    tGATTS_SRV_CHG *p_buf;
+    for (size_t i = 0; (p_buf = fixed_queue_try_peek_at(gatt_cb.srv_chg_clt_q, i)) != NULL; i++) {
         GATT_TRACE_DEBUG ("found a srv_chg clt");
 
-        tGATTS_SRV_CHG *p_buf = (tGATTS_SRV_CHG *)list_node(node);
         if (!p_buf->srv_changed) {
             GATT_TRACE_DEBUG("set srv_changed to TRUE");
             p_buf->srv_changed = TRUE;
@@ -233,10 +231,7 @@ tGATTS_PENDING_NEW_SRV_START *gatt_sr_is_new_srv_chg(tBT_UUID *p_app_uuid128, tB
         return NULL;
 	}
 
-    list_t *list = fixed_queue_get_list(gatt_cb.pending_new_srv_start_q);
-    for (const list_node_t *node = list_begin(list); node != list_end(list);
-         node = list_next(node)) {
-        p_buf = (tGATTS_PENDING_NEW_SRV_START *)list_node(node);
+    for (size_t i = 0; (p_buf = fixed_queue_try_peek_at(gatt_cb.pending_new_srv_start_q, i)) != NULL; i++) {
         tGATTS_HNDL_RANGE *p = p_buf->p_new_srv_start;
         if (gatt_uuid_compare(*p_app_uuid128, p->app_uuid128)
             && gatt_uuid_compare (*p_svc_uuid, p->svc_uuid)
@@ -503,6 +498,7 @@ void gatt_free_srvc_db_buffer_app_id(tBT_UUID *p_app_id)
 
             p_elem->svc_db.mem_free = 0;
             p_elem->svc_db.p_attr_list = p_elem->svc_db.p_free_mem = NULL;
+            p_elem->svc_db.p_attr_index = NULL;
         }
     }
 }
@@ -824,11 +820,8 @@ BOOLEAN gatt_is_srv_chg_ind_pending (tGATT_TCB *p_tcb)
     if (p_tcb->indicate_handle == gatt_cb.handle_of_h_r) {
         srv_chg_ind_pending = TRUE;
     } else if (! fixed_queue_is_empty(p_tcb->pending_ind_q)) {
-        list_t *list = fixed_queue_get_list(p_tcb->pending_ind_q);
-        for (const list_node_t *node = list_begin(list);
-             node != list_end(list);
-             node = list_next(node)) {
-            tGATT_VALUE *p_buf = (tGATT_VALUE *)list_node(node);
+        tGATT_VALUE *p_buf;
+        for (size_t i = 0; (p_buf = fixed_queue_try_peek_at(p_tcb->pending_ind_q, i)) != NULL; i++) {
             if (p_buf->handle == gatt_cb.handle_of_h_r)
             {
                 srv_chg_ind_pending = TRUE;
@@ -862,10 +855,7 @@ tGATTS_SRV_CHG *gatt_is_bda_in_the_srv_chg_clt_list (BD_ADDR bda)
         return NULL;
 	}
 
-    list_t *list = fixed_queue_get_list(gatt_cb.srv_chg_clt_q);
-    for (const list_node_t *node = list_begin(list); node != list_end(list);
-         node = list_next(node)) {
-        p_buf = (tGATTS_SRV_CHG *)list_node(node);
+    for (size_t i = 0; (p_buf = fixed_queue_try_peek_at(gatt_cb.srv_chg_clt_q, i)) != NULL; i++) {
         if (!memcmp( bda, p_buf->bda, BD_ADDR_LEN)) {
             GATT_TRACE_DEBUG("bda is in the srv chg clt list");
             break;
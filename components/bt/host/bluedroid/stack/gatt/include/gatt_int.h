@@ -225,9 +225,11 @@ typedef struct {
 */
 typedef struct {
     void            *p_attr_list;       /* pointer to the first attribute, either tGATT_ATTR16 or tGATT_ATTR128 */
+    void            **p_attr_index;     /* attributes indexed by (handle - start_handle) */
     UINT8           *p_free_mem;        /* Pointer to free memory       */
     fixed_queue_t   *svc_buffer;         /* buffer queue used for service database */
     UINT32          mem_free;           /* Memory still available       */
+    UINT16          start_handle;       /* First handle number          */
     UINT16          end_handle;         /* Last handle number           */
     UINT16          next_handle;        /* Next usable handle value     */
 } tGATT_SVC_DB;
@@ -777,6 +779,8 @@ extern tGATT_STATUS gatts_write_attr_perm_check (tGATT_SVC_DB *p_db, UINT8 op_co
 extern tGATT_STATUS gatts_read_attr_perm_check(tGATT_SVC_DB *p_db, BOOLEAN is_long, UINT16 handle, tGATT_SEC_FLAG sec_flag, UINT8 key_size);
 extern void gatts_update_srv_list_elem(UINT8 i_sreg, UINT16 handle, BOOLEAN is_primary);
 extern tBT_UUID *gatts_get_service_uuid (tGATT_SVC_DB *p_db);
+extern void *gatts_find_attr_by_handle(tGATT_SVC_DB *p_db, UINT16 handle);
+extern void *gatts_find_first_attr_from_handle(tGATT_SVC_DB *p_db, UINT16 handle);
 
 extern BOOLEAN gatt_check_connection_state_by_tcb(tGATT_TCB *p_tcb);
 
@@ -787,6 +791,8 @@ extern void gatt_set_local_mtu(uint16_t mtu);
 extern tGATT_STATUS gatts_calculate_datebase_hash(BT_OCTET16 hash);
 extern void gatts_show_local_database(void);
 
+extern BOOLEAN gatt_sr_is_cl_multi_notif_supported(tGATT_TCB *p_tcb);
+extern UINT16 gatts_multi_notif_batch_len(const tGATT_HLV *tuples, UINT16 num_tuples, UINT16 max_len);
 extern BOOLEAN gatt_sr_is_cl_change_aware(tGATT_TCB *p_tcb);
 extern void gatt_sr_init_cl_status(tGATT_TCB *p_tcb);
 extern void gatt_sr_update_cl_status(tGATT_TCB *tcb, BOOLEAN chg_aware);
@@ -1283,6 +1283,33 @@ extern tGATT_STATUS GATTS_SetServiceChangeMode(UINT8 mode);
 *******************************************************************************/
 extern tGATT_STATUS GATTS_HandleMultiValueNotification (UINT16 conn_id, tGATT_HLV *tuples, UINT16 num_tuples);
 
+/*******************************************************************************
+**
+** Function         GATTS_HandleValueNotificationBatch
+**
+** Description      This function sends a batch of handle value notifications
+**                  to a client, using Multiple Handle Value Notifications if
+**                  the client supports them.
+**
+** Parameter        conn_id: connection identifier.
+**                  tuples: Pointer to handle-length-value tuple list.
+**                  num_tuples: Number of tuples.
+**                  p_num_sent: Number of tuples handed to L2CAP.
+**
+** Returns          GATT_SUCCESS if all tuples were sent;
+**                  GATT_CONGESTED if the channel is congested, the tuples from
+**                  *p_num_sent on were not sent;
+**                  GATT_INVALID_CONN_ID if conn_id is unknown;
+**                  GATT_WRONG_STATE if the connection is not open;
+**                  GATT_ILLEGAL_PARAMETER if the tuple list is empty, or has
+**                  an invalid handle or a value longer than GATT_MAX_ATTR_LEN;
+**                  GATT_NO_RESOURCES or the L2CAP error if a PDU could not be
+**                  built or sent, the tuples from *p_num_sent on were not sent.
+**
+*******************************************************************************/
+extern tGATT_STATUS GATTS_HandleValueNotificationBatch (UINT16 conn_id, tGATT_HLV *tuples, UINT16 num_tuples,
+                                                        UINT16 *p_num_sent);
+
 /*******************************************************************************
 **
 ** Function         GATTS_ShowLocalDatabase
@@ -0,0 +1,328 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+/*
+ * Tests for the BLE Mesh network layer, run on the data structures only,
+ * without starting the mesh stack.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_BLE_MESH && CONFIG_BLE_MESH_SELF_TEST
+
+#include "mesh/buf.h"
+#include "net.h"
+#include "rpl.h"
+#include "test.h"
+
+/* Directed Forwarding is left out, its keys would be tried too when their NID matches */
+#if CONFIG_BLE_MESH_NODE && !CONFIG_BLE_MESH_PROVISIONER && !CONFIG_BLE_MESH_DF_SRV
+
+#define TEST_MESH_SUBNETS   3
+#define TEST_MESH_SRC       0x0001
+#define TEST_MESH_DST       0x0002
+
+_Static_assert(CONFIG_BLE_MESH_SUBNET_COUNT >= TEST_MESH_SUBNETS, "Not enough subnets for the test");
+
+struct test_mesh_pdu {
+    uint8_t data[29];
+    uint16_t len;
+};
+
+static void test_mesh_key(uint8_t key[16], uint8_t seed, uint16_t n)
+{
+    memset(key, seed, 16);
+    key[14] = n >> 8;
+    key[15] = n & 0xff;
+}
+
+/*
+ * Derive the keys of a NetKey with the NID nid0 if 'same' is true, else with a NID other
+ * than nid0 and nid1. NID 0 is avoided, it is the one of the unused new keys.
+ */
+static void test_mesh_keys_find(struct bt_mesh_subnet_keys *keys, uint8_t seed,
+                                bool same, uint8_t nid0, uint8_t nid1)
+{
+    uint8_t key[16];
+
+    for (uint16_t n = 0; n < 4096; n++) {
+        test_mesh_key(key, seed, n);
+        TEST_ASSERT_EQUAL(0, bt_mesh_net_keys_create(keys, key));
+        if (same ? keys->nid == nid0 : (keys->nid != 0 && keys->nid != nid0 && keys->nid != nid1)) {
+            return;
+        }
+    }
+    TEST_FAIL_MESSAGE("No NetKey found with the requested NID");
+}
+
+static void test_mesh_subnet_add(int i, uint16_t net_idx)
+{
+    struct bt_mesh_subnet *sub = &bt_mesh.sub[i];
+
+    sub->net_idx = net_idx;
+    sub->kr_phase = BLE_MESH_KR_NORMAL;
+    sub->kr_flag = false;
+}
+
+static void test_mesh_encode(struct bt_mesh_subnet *sub, struct test_mesh_pdu *pdu)
+{
+    NET_BUF_SIMPLE_DEFINE(buf, sizeof(pdu->data));
+    struct bt_mesh_msg_ctx ctx = {
+        .net_idx = sub->net_idx,
+        .app_idx = BLE_MESH_KEY_DEV,
+        .addr = TEST_MESH_DST,
+        .send_ttl = 5,
+        .send_cred = BLE_MESH_FLOODING_CRED,
+    };
+    struct bt_mesh_net_tx tx = {
+        .sub = sub,
+        .ctx = &ctx,
+        .src = TEST_MESH_SRC,
+    };
+
+    net_buf_simple_reserve(&buf, BLE_MESH_NET_HDR_LEN);
+    memset(net_buf_simple_add(&buf, 8), 0x5a, 8);
+    TEST_ASSERT_EQUAL(0, bt_mesh_net_encode(&tx, &buf, false));
+
+    memcpy(pdu->data, buf.data, buf.len);
+    pdu->len = buf.len;
+}
+
+/* Decode a PDU, check the subnet it was decrypted with and the subnets and attempts it took */
+static void test_mesh_decode(const struct test_mesh_pdu *pdu, int net_idx,
+                             uint32_t subnets, uint32_t attempts)
+{
+    uint16_t rx_net_idx = BLE_MESH_KEY_UNUSED;
+    uint32_t rx_subnets = UINT32_MAX;
+    uint32_t rx_attempts = UINT32_MAX;
+    int err = bt_mesh_test_net_decode(pdu->data, pdu->len, &rx_net_idx, &rx_subnets, &rx_attempts);
+
+    if (net_idx < 0) {
+        TEST_ASSERT_EQUAL(-ENOENT, err);
+    } else {
+        TEST_ASSERT_EQUAL(0, err);
+        TEST_ASSERT_EQUAL_HEX16(net_idx, rx_net_idx);
+    }
+    TEST_ASSERT_EQUAL(subnets, rx_subnets);
+    TEST_ASSERT_EQUAL(attempts, rx_attempts);
+}
+
+TEST_CASE("ble_mesh network PDUs are only decrypted with the subnets of their NID", "[ble_mesh]")
+{
+    struct test_mesh_pdu pdu[TEST_MESH_SUBNETS], old_key_pdu, new_key_pdu, other_pdu;
+    struct bt_mesh_subnet *sub = bt_mesh.sub;
+    uint8_t other_nid;
+
+    bt_mesh_atomic_set_bit(bt_mesh.flags, BLE_MESH_NODE);
+    bt_mesh_atomic_set_bit(bt_mesh.flags, BLE_MESH_VALID);
+
+    /* Subnets 0 and 2 share a NID, subnet 1 has another one */
+    for (int i = 0; i < TEST_MESH_SUBNETS; i++) {
+        test_mesh_subnet_add(i, 0x100 + i);
+    }
+    test_mesh_keys_find(&sub[0].keys[0], 0x10, false, 0, 0);
+    test_mesh_keys_find(&sub[1].keys[0], 0x11, false, sub[0].keys[0].nid, 0);
+    test_mesh_keys_find(&sub[2].keys[0], 0x12, true, sub[0].keys[0].nid, 0);
+
+    for (int i = 0; i < TEST_MESH_SUBNETS; i++) {
+        test_mesh_encode(&sub[i], &pdu[i]);
+    }
+
+    /* The subnets of a NID are tried in order, the other ones not at all */
+    test_mesh_decode(&pdu[0], 0x100, 1, 1);
+    test_mesh_decode(&pdu[1], 0x101, 1, 1);
+    test_mesh_decode(&pdu[2], 0x102, 2, 2);
+
+    /* A PDU with an unknown NID isn't tried with any subnet */
+    other_pdu = pdu[1];
+    for (other_nid = 1; other_nid == sub[0].keys[0].nid || other_nid == sub[1].keys[0].nid; other_nid++) {
+    }
+    other_pdu.data[0] = (other_pdu.data[0] & 0x80) | other_nid;
+    test_mesh_decode(&other_pdu, -1, 0, 0);
+
+    /* Key Refresh of subnet 1: creating the new key updates the index */
+    old_key_pdu = pdu[1];
+    test_mesh_keys_find(&sub[1].keys[1], 0x21, false, sub[0].keys[0].nid, sub[1].keys[0].nid);
+    sub[1].kr_phase = BLE_MESH_KR_PHASE_2;
+    sub[1].kr_flag = true;
+    test_mesh_encode(&sub[1], &new_key_pdu);
+    test_mesh_decode(&old_key_pdu, 0x101, 1, 1);
+    test_mesh_decode(&new_key_pdu, 0x101, 1, 1);
+    test_mesh_decode(&pdu[2], 0x102, 2, 2);
+
+    /* Revoking the old key updates it too */
+    bt_mesh_net_revoke_keys(&sub[1]);
+    sub[1].kr_phase = BLE_MESH_KR_NORMAL;
+    sub[1].kr_flag = false;
+    test_mesh_decode(&old_key_pdu, -1, 0, 0);
+    test_mesh_decode(&new_key_pdu, 0x101, 1, 1);
+
+    /* Both keys of subnet 1 have the same NID now, the subnet is tried once */
+    other_pdu = new_key_pdu;
+    other_pdu.data[other_pdu.len - 1] ^= 0x01;
+    test_mesh_decode(&other_pdu, -1, 1, 1);
+
+    /* A deleted subnet isn't tried anymore, even before the index is rebuilt */
+    memset(&sub[0], 0, sizeof(sub[0]));
+    sub[0].net_idx = BLE_MESH_KEY_UNUSED;
+    test_mesh_decode(&pdu[0], -1, 1, 1);
+    test_mesh_decode(&pdu[2], 0x102, 1, 1);
+
+    for (int i = 0; i < TEST_MESH_SUBNETS; i++) {
+        memset(&sub[i], 0, sizeof(sub[i]));
+        sub[i].net_idx = BLE_MESH_KEY_UNUSED;
+    }
+    bt_mesh_atomic_clear_bit(bt_mesh.flags, BLE_MESH_VALID);
+    bt_mesh_atomic_clear_bit(bt_mesh.flags, BLE_MESH_NODE);
+    bt_mesh.seq = 0U;
+
+    /* With no RX subnets left, the NID index is freed by the next decode */
+    test_mesh_decode(&pdu[0], -1, 0, 0);
+}
+
+#endif /* CONFIG_BLE_MESH_NODE && !CONFIG_BLE_MESH_PROVISIONER && !CONFIG_BLE_MESH_DF_SRV */
+
+#define TEST_MESH_CACHE_SIZE    CONFIG_BLE_MESH_MSG_CACHE_SIZE
+
+static void test_mesh_cache_fill(uint16_t src, uint32_t seq)
+{
+    for (int i = 0; i < TEST_MESH_CACHE_SIZE; i++) {
+        bt_mesh_test_msg_cache_add(src + i, seq + i);
+    }
+}
+
+static void test_mesh_cache_expect(uint16_t src, uint32_t seq, int first, int count, bool match)
+{
+    for (int i = first; i < first + count; i++) {
+        TEST_ASSERT_EQUAL(match, bt_mesh_test_msg_cache_match(src + i, seq + i));
+    }
+}
+
+TEST_CASE("ble_mesh message cache index follows overwrites and clears", "[ble_mesh]")
+{
+    /* Whatever the cache held is overwritten by a full round of entries */
+    test_mesh_cache_fill(0x0100, 0x100);
+    TEST_ASSERT_EQUAL(TEST_MESH_CACHE_SIZE, bt_mesh_test_msg_cache_index_check());
+    test_mesh_cache_expect(0x0100, 0x100, 0, TEST_MESH_CACHE_SIZE, true);
+    TEST_ASSERT_FALSE(bt_mesh_test_msg_cache_match(0x0100, 0x101));
+    TEST_ASSERT_FALSE(bt_mesh_test_msg_cache_match(0x0200, 0x100));
+
+    /* The next entry replaces the oldest one only */
+    bt_mesh_test_msg_cache_add(0x0200, 0x200);
+    TEST_ASSERT_EQUAL(TEST_MESH_CACHE_SIZE, bt_mesh_test_msg_cache_index_check());
+    TEST_ASSERT_TRUE(bt_mesh_test_msg_cache_match(0x0200, 0x200));
+    test_mesh_cache_expect(0x0100, 0x100, 0, 1, false);
+    test_mesh_cache_expect(0x0100, 0x100, 1, TEST_MESH_CACHE_SIZE - 1, true);
+
+    /* Overwriting an entry with the same SRC and SEQ keeps it once */
+    bt_mesh_test_msg_cache_add(0x0101, 0x101);
+    TEST_ASSERT_EQUAL(TEST_MESH_CACHE_SIZE, bt_mesh_test_msg_cache_index_check());
+    TEST_ASSERT_TRUE(bt_mesh_test_msg_cache_match(0x0101, 0x101));
+
+    /* A second full round leaves none of the first one */
+    test_mesh_cache_fill(0x0300, 0x300);
+    TEST_ASSERT_EQUAL(TEST_MESH_CACHE_SIZE, bt_mesh_test_msg_cache_index_check());
+    test_mesh_cache_expect(0x0100, 0x100, 0, TEST_MESH_CACHE_SIZE, false);
+    TEST_ASSERT_FALSE(bt_mesh_test_msg_cache_match(0x0200, 0x200));
+    test_mesh_cache_expect(0x0300, 0x300, 0, TEST_MESH_CACHE_SIZE, true);
+
+#if CONFIG_BLE_MESH_PROVISIONER
+    /* Clearing the messages of a removed node unlinks them */
+    bt_mesh_msg_cache_clear(0x0301, 2);
+    TEST_ASSERT_EQUAL(TEST_MESH_CACHE_SIZE - 2, bt_mesh_test_msg_cache_index_check());
+    test_mesh_cache_expect(0x0300, 0x300, 0, 1, true);
+    test_mesh_cache_expect(0x0300, 0x300, 1, 2, false);
+    test_mesh_cache_expect(0x0300, 0x300, 3, TEST_MESH_CACHE_SIZE - 3, true);
+
+    /* The cleared entries are reused in turn */
+    test_mesh_cache_fill(0x0400, 0x400);
+    TEST_ASSERT_EQUAL(TEST_MESH_CACHE_SIZE, bt_mesh_test_msg_cache_index_check());
+    test_mesh_cache_expect(0x0300, 0x300, 0, TEST_MESH_CACHE_SIZE, false);
+    test_mesh_cache_expect(0x0400, 0x400, 0, TEST_MESH_CACHE_SIZE, true);
+#endif /* CONFIG_BLE_MESH_PROVISIONER */
+
+    /* Entries without a source address are not indexed */
+    for (int i = 0; i < TEST_MESH_CACHE_SIZE; i++) {
+        bt_mesh_test_msg_cache_add(BLE_MESH_ADDR_UNASSIGNED, i);
+    }
+    TEST_ASSERT_EQUAL(0, bt_mesh_test_msg_cache_index_check());
+    test_mesh_cache_expect(0x0400, 0x400, 0, TEST_MESH_CACHE_SIZE, false);
+}
+
+#define TEST_MESH_RPL_SIZE      CONFIG_BLE_MESH_CRPL
+
+/* Run the RPL check of a message received for the local node, true if it is a replay */
+static bool test_mesh_rpl_check(uint16_t src, uint32_t seq)
+{
+    struct bt_mesh_net_rx rx = {
+        .ctx.addr = src,
+        .seq = seq,
+        .net_if = BLE_MESH_NET_IF_ADV,
+        .local_match = 1U,
+    };
+
+    return bt_mesh_rpl_check(&rx, NULL);
+}
+
+TEST_CASE("ble_mesh RPL index follows resets and updates", "[ble_mesh]")
+{
+    bt_mesh_rpl_reset(false);
+    TEST_ASSERT_EQUAL(0, bt_mesh_test_rpl_index_check());
+
+    for (int i = 0; i < TEST_MESH_RPL_SIZE; i++) {
+        TEST_ASSERT_FALSE(test_mesh_rpl_check(0x0100 + i, 1));
+    }
+    TEST_ASSERT_EQUAL(TEST_MESH_RPL_SIZE, bt_mesh_test_rpl_index_check());
+
+    for (int i = 0; i < TEST_MESH_RPL_SIZE; i++) {
+        TEST_ASSERT_TRUE(test_mesh_rpl_check(0x0100 + i, 1));
+        TEST_ASSERT_FALSE(test_mesh_rpl_check(0x0100 + i, 2));
+    }
+    TEST_ASSERT_EQUAL(TEST_MESH_RPL_SIZE, bt_mesh_test_rpl_index_check());
+
+    /* A new source is rejected while the list is full */
+    TEST_ASSERT_TRUE(test_mesh_rpl_check(0x0200, 1));
+    TEST_ASSERT_EQUAL(TEST_MESH_RPL_SIZE, bt_mesh_test_rpl_index_check());
+
+    /* Resetting a source unlinks its slot, which the next new source takes */
+    bt_mesh_rpl_reset_single(0x0101, false);
+    TEST_ASSERT_EQUAL(TEST_MESH_RPL_SIZE - 1, bt_mesh_test_rpl_index_check());
+    TEST_ASSERT_FALSE(test_mesh_rpl_check(0x0200, 1));
+    TEST_ASSERT_EQUAL_HEX16(0x0200, bt_mesh.rpl[1].src);
+    TEST_ASSERT_EQUAL(TEST_MESH_RPL_SIZE, bt_mesh_test_rpl_index_check());
+    TEST_ASSERT_TRUE(test_mesh_rpl_check(0x0101, 3));
+    TEST_ASSERT_TRUE(test_mesh_rpl_check(0x0200, 1));
+
+    /* A slot cleared behind the index is dropped from it when its source is met */
+    memset(&bt_mesh.rpl[0], 0, sizeof(bt_mesh.rpl[0]));
+    TEST_ASSERT_EQUAL(-EINVAL, bt_mesh_test_rpl_index_check());
+    TEST_ASSERT_FALSE(test_mesh_rpl_check(0x0100, 1));
+    TEST_ASSERT_EQUAL_HEX16(0x0100, bt_mesh.rpl[0].src);
+    TEST_ASSERT_EQUAL(TEST_MESH_RPL_SIZE, bt_mesh_test_rpl_index_check());
+
+    /* After an IV Index update the entries are kept, after a second one they are discarded */
+    bt_mesh_rpl_update();
+    TEST_ASSERT_EQUAL(TEST_MESH_RPL_SIZE, bt_mesh_test_rpl_index_check());
+    bt_mesh_rpl_update();
+    TEST_ASSERT_EQUAL(0, bt_mesh_test_rpl_index_check());
+    TEST_ASSERT_FALSE(test_mesh_rpl_check(0x0100, 1));
+    TEST_ASSERT_EQUAL(1, bt_mesh_test_rpl_index_check());
+
+    bt_mesh_rpl_reset(false);
+    TEST_ASSERT_EQUAL(0, bt_mesh_test_rpl_index_check());
+    TEST_ASSERT_FALSE(test_mesh_rpl_check(0x0100, 1));
+    TEST_ASSERT_FALSE(test_mesh_rpl_check(0x0101, 1));
+    TEST_ASSERT_EQUAL(2, bt_mesh_test_rpl_index_check());
+
+    bt_mesh_rpl_reset(false);
+}
+
+#endif /* CONFIG_BLE_MESH && CONFIG_BLE_MESH_SELF_TEST */
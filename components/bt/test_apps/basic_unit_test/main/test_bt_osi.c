@@ -0,0 +1,366 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+/*
+ * Tests and benchmarks for the BT OSI library
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "osi/alarm_wheel.h"
+#include "osi/fixed_queue.h"
+#include "osi/hash_map.h"
+#include "osi/hash_functions.h"
+
+#define OSI_BENCH_ITERATIONS    10000
+
+static int s_freed;
+
+static void count_free_cb(void *data)
+{
+    s_freed++;
+}
+
+TEST_CASE("fixed_queue keeps FIFO order and bounds", "[bt_osi]")
+{
+    int items[8];
+    fixed_queue_t *queue = fixed_queue_new(5);
+    TEST_ASSERT_NOT_NULL(queue);
+    TEST_ASSERT_TRUE(fixed_queue_is_empty(queue));
+    TEST_ASSERT_EQUAL(5, fixed_queue_capacity(queue));
+
+    // Run a few rounds so that the ring array wraps around
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 5; i++) {
+            TEST_ASSERT_TRUE(fixed_queue_enqueue(queue, &items[i], 0));
+        }
+        TEST_ASSERT_FALSE(fixed_queue_enqueue(queue, &items[5], 0));
+        TEST_ASSERT_EQUAL(5, fixed_queue_length(queue));
+        TEST_ASSERT_EQUAL_PTR(&items[0], fixed_queue_try_peek_first(queue));
+        TEST_ASSERT_EQUAL_PTR(&items[4], fixed_queue_try_peek_last(queue));
+
+        TEST_ASSERT_EQUAL_PTR(&items[2], fixed_queue_try_remove_from_queue(queue, &items[2]));
+        TEST_ASSERT_NULL(fixed_queue_try_remove_from_queue(queue, &items[2]));
+        TEST_ASSERT_EQUAL_PTR(&items[3], fixed_queue_try_peek_at(queue, 2));
+        TEST_ASSERT_NULL(fixed_queue_try_peek_at(queue, 4));
+
+        TEST_ASSERT_EQUAL_PTR(&items[0], fixed_queue_dequeue(queue, 0));
+        TEST_ASSERT_TRUE(fixed_queue_enqueue(queue, &items[6], 0));
+        TEST_ASSERT_TRUE(fixed_queue_enqueue(queue, &items[7], 0));
+        TEST_ASSERT_FALSE(fixed_queue_enqueue(queue, &items[5], 0));
+
+        void *expected[] = { &items[1], &items[3], &items[4], &items[6], &items[7] };
+        for (int i = 0; i < 5; i++) {
+            TEST_ASSERT_EQUAL_PTR(expected[i], fixed_queue_dequeue(queue, 0));
+        }
+        TEST_ASSERT_NULL(fixed_queue_dequeue(queue, 0));
+    }
+
+    s_freed = 0;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(fixed_queue_enqueue(queue, &items[i], 0));
+    }
+    fixed_queue_free(queue, count_free_cb);
+    TEST_ASSERT_EQUAL(3, s_freed);
+}
+
+TEST_CASE("fixed_queue does not allocate per message", "[bt_osi]")
+{
+    int item;
+    fixed_queue_t *queue = fixed_queue_new(QUEUE_SIZE_MAX);
+    TEST_ASSERT_NOT_NULL(queue);
+
+    // Grow the queue to its steady state size first
+    for (int i = 0; i < 16; i++) {
+        TEST_ASSERT_TRUE(fixed_queue_enqueue(queue, &item, 0));
+    }
+    while (fixed_queue_dequeue(queue, 0)) {
+    }
+
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    TEST_ASSERT_TRUE(fixed_queue_enqueue(queue, &item, 0));
+    TEST_ASSERT_TRUE(fixed_queue_enqueue(queue, &item, 0));
+    TEST_ASSERT_EQUAL(free_before, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+    fixed_queue_dequeue(queue, 0);
+    fixed_queue_dequeue(queue, 0);
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < OSI_BENCH_ITERATIONS; i++) {
+        fixed_queue_enqueue(queue, &item, 0);
+        fixed_queue_dequeue(queue, 0);
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    printf("fixed_queue: %lld ns per enqueue/dequeue pair\n", elapsed * 1000 / OSI_BENCH_ITERATIONS);
+
+    fixed_queue_free(queue, NULL);
+}
+
+static bool count_entry_cb(hash_map_entry_t *hash_entry, void *context)
+{
+    (*(int *)context)++;
+    return true;
+}
+
+TEST_CASE("hash_map set, get and erase", "[bt_osi]")
+{
+    static int keys[64];
+    hash_map_t *map = hash_map_new(4, hash_function_pointer, NULL, count_free_cb, NULL);
+    TEST_ASSERT_NOT_NULL(map);
+
+    // Insert beyond the size hint so that the map grows
+    for (int i = 0; i < 64; i++) {
+        TEST_ASSERT_TRUE(hash_map_set(map, &keys[i], &keys[i]));
+    }
+    for (int i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_PTR(&keys[i], hash_map_get(map, &keys[i]));
+    }
+
+    s_freed = 0;
+    TEST_ASSERT_TRUE(hash_map_set(map, &keys[0], &keys[1]));
+    TEST_ASSERT_EQUAL(1, s_freed);
+    TEST_ASSERT_EQUAL_PTR(&keys[1], hash_map_get(map, &keys[0]));
+
+    // Erase every other key, the remaining ones must stay reachable
+    for (int i = 0; i < 64; i += 2) {
+        TEST_ASSERT_TRUE(hash_map_erase(map, &keys[i]));
+        TEST_ASSERT_FALSE(hash_map_erase(map, &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(33, s_freed);
+    for (int i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL(i % 2, hash_map_has_key(map, &keys[i]));
+    }
+
+    int count = 0;
+    hash_map_foreach(map, count_entry_cb, &count);
+    TEST_ASSERT_EQUAL(32, count);
+
+    hash_map_clear(map);
+    TEST_ASSERT_EQUAL(65, s_freed);
+    count = 0;
+    hash_map_foreach(map, count_entry_cb, &count);
+    TEST_ASSERT_EQUAL(0, count);
+    TEST_ASSERT_NULL(hash_map_get(map, &keys[1]));
+
+    hash_map_free(map);
+}
+
+TEST_CASE("hash_map does not allocate per element", "[bt_osi]")
+{
+    static int keys[34];
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    hash_map_t *map = hash_map_new(34, hash_function_pointer, NULL, NULL, NULL);
+    TEST_ASSERT_NOT_NULL(map);
+    size_t free_empty = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    for (int i = 0; i < 34; i++) {
+        TEST_ASSERT_TRUE(hash_map_set(map, &keys[i], &keys[i]));
+    }
+    TEST_ASSERT_EQUAL(free_empty, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+    printf("hash_map: %u bytes for 34 elements\n", (unsigned)(free_before - free_empty));
+
+    volatile void *data;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < OSI_BENCH_ITERATIONS; i++) {
+        data = hash_map_get(map, &keys[i % 34]);
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    (void)data;
+    printf("hash_map: %lld ns per lookup\n", elapsed * 1000 / OSI_BENCH_ITERATIONS);
+
+    hash_map_free(map);
+}
+
+#define ALARM_TEST_MS(ms)       ((int64_t)(ms) * 1000)
+// One rotation of the wheel
+#define ALARM_TEST_ROTATION_US  ((int64_t)ALARM_WHEEL_SLOTS << ALARM_WHEEL_TICK_SHIFT)
+
+static void alarm_test_add(alarm_wheel_t *wheel, alarm_wheel_node_t *node, int64_t now_us,
+                           int64_t deadline_us, uint64_t period_us)
+{
+    node->deadline_us = deadline_us;
+    node->period_us = period_us;
+    alarm_wheel_add(wheel, node, now_us);
+    TEST_ASSERT_TRUE(node->armed);
+}
+
+TEST_CASE("alarm wheel expires alarms at their deadline", "[bt_osi]")
+{
+    alarm_wheel_t wheel;
+    alarm_wheel_node_t nodes[4] = {0};
+    alarm_wheel_node_t *fired[4];
+    int64_t now = esp_timer_get_time();
+
+    alarm_wheel_init(&wheel, now);
+    TEST_ASSERT_EQUAL_INT64(INT64_MAX, alarm_wheel_next_deadline(&wheel));
+
+    // The last alarm is two rotations away, in the slot of the first one to expire
+    alarm_test_add(&wheel, &nodes[0], now, now + ALARM_TEST_MS(20), 0);
+    alarm_test_add(&wheel, &nodes[1], now, now + ALARM_TEST_MS(1), 0);
+    alarm_test_add(&wheel, &nodes[2], now, now + ALARM_TEST_MS(5), 0);
+    alarm_test_add(&wheel, &nodes[3], now, now + ALARM_TEST_MS(1) + 2 * ALARM_TEST_ROTATION_US, 0);
+    TEST_ASSERT_EQUAL(4, wheel.num);
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(1), alarm_wheel_next_deadline(&wheel));
+
+    TEST_ASSERT_EQUAL(0, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(1) - 1, fired, 4));
+    TEST_ASSERT_EQUAL(1, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(1), fired, 4));
+    TEST_ASSERT_EQUAL_PTR(&nodes[1], fired[0]);
+    TEST_ASSERT_FALSE(nodes[1].armed);
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(5), alarm_wheel_next_deadline(&wheel));
+
+    // Expired alarms come out in deadline order when they are in different slots
+    TEST_ASSERT_EQUAL(2, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(25), fired, 4));
+    TEST_ASSERT_EQUAL_PTR(&nodes[2], fired[0]);
+    TEST_ASSERT_EQUAL_PTR(&nodes[0], fired[1]);
+
+    // Only found by the full rotation scan
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(1) + 2 * ALARM_TEST_ROTATION_US, alarm_wheel_next_deadline(&wheel));
+    TEST_ASSERT_EQUAL(0, alarm_wheel_expire(&wheel, now + ALARM_TEST_ROTATION_US, fired, 4));
+    TEST_ASSERT_EQUAL(0, alarm_wheel_expire(&wheel, now + 2 * ALARM_TEST_ROTATION_US, fired, 4));
+    TEST_ASSERT_EQUAL(1, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(1) + 2 * ALARM_TEST_ROTATION_US, fired, 4));
+    TEST_ASSERT_EQUAL_PTR(&nodes[3], fired[0]);
+    TEST_ASSERT_EQUAL(0, wheel.num);
+    TEST_ASSERT_EQUAL_INT64(INT64_MAX, alarm_wheel_next_deadline(&wheel));
+}
+
+TEST_CASE("alarm wheel re-arms periodic alarms and cancels the earliest one", "[bt_osi]")
+{
+    alarm_wheel_t wheel;
+    alarm_wheel_node_t periodic = {0}, first = {0}, second = {0};
+    alarm_wheel_node_t *fired[2];
+    int64_t now = esp_timer_get_time();
+
+    alarm_wheel_init(&wheel, now);
+    alarm_test_add(&wheel, &periodic, now, now + ALARM_TEST_MS(10), ALARM_TEST_MS(10));
+    TEST_ASSERT_EQUAL(1, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(10), fired, 2));
+    TEST_ASSERT_EQUAL_PTR(&periodic, fired[0]);
+    TEST_ASSERT_TRUE(periodic.armed);
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(20), periodic.deadline_us);
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(20), alarm_wheel_next_deadline(&wheel));
+
+    // Missed periods are skipped, the alarm fires once and is re-armed from now
+    TEST_ASSERT_EQUAL(1, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(55), fired, 2));
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(65), periodic.deadline_us);
+    alarm_wheel_remove(&wheel, &periodic);
+    TEST_ASSERT_FALSE(periodic.armed);
+
+    // Cancelling the earliest alarm moves the next deadline to the following one
+    now += ALARM_TEST_MS(55);
+    alarm_test_add(&wheel, &first, now, now + ALARM_TEST_MS(5), 0);
+    alarm_test_add(&wheel, &second, now, now + ALARM_TEST_MS(15), 0);
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(5), alarm_wheel_next_deadline(&wheel));
+    alarm_wheel_remove(&wheel, &first);
+    TEST_ASSERT_EQUAL_INT64(now + ALARM_TEST_MS(15), alarm_wheel_next_deadline(&wheel));
+    TEST_ASSERT_EQUAL(0, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(10), fired, 2));
+    alarm_wheel_remove(&wheel, &second);
+    TEST_ASSERT_EQUAL(0, wheel.num);
+    TEST_ASSERT_EQUAL_INT64(INT64_MAX, alarm_wheel_next_deadline(&wheel));
+
+    // Expired alarms beyond the batch size are left for the next call
+    alarm_wheel_node_t batch[5] = {0};
+    for (int i = 0; i < 5; i++) {
+        alarm_test_add(&wheel, &batch[i], now, now + ALARM_TEST_MS(1), 0);
+    }
+    TEST_ASSERT_EQUAL(2, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(2), fired, 2));
+    TEST_ASSERT_EQUAL(2, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(2), fired, 2));
+    TEST_ASSERT_EQUAL(1, alarm_wheel_expire(&wheel, now + ALARM_TEST_MS(2), fired, 2));
+    TEST_ASSERT_EQUAL(0, wheel.num);
+}
+
+#define ALARM_TEST_ONESHOTS     16
+#define ALARM_TEST_PERIOD_MS    7
+#define ALARM_TEST_RUN_MS       300
+
+typedef struct {
+    alarm_wheel_t wheel;
+    alarm_wheel_node_t oneshots[ALARM_TEST_ONESHOTS];
+    alarm_wheel_node_t periodic;
+    esp_timer_handle_t timer;
+    volatile bool stop;
+    int fired[ALARM_TEST_ONESHOTS];
+    int periodic_fired;
+    int early;
+    int64_t max_late_us;
+} alarm_test_ctx_t;
+
+// Same role as the osi_alarm handler: expire, then re-arm for the earliest deadline
+static void alarm_test_timer_cb(void *arg)
+{
+    alarm_test_ctx_t *ctx = (alarm_test_ctx_t *)arg;
+    alarm_wheel_node_t *fired[4];
+    int64_t now = esp_timer_get_time();
+    size_t num;
+
+    do {
+        int64_t deadlines[4];
+        num = alarm_wheel_expire(&ctx->wheel, now, fired, 4);
+        for (size_t i = 0; i < num; i++) {
+            // a periodic alarm is already re-armed, its expired deadline is one period back
+            deadlines[i] = fired[i]->deadline_us - (int64_t)fired[i]->period_us;
+            if (fired[i] == &ctx->periodic) {
+                ctx->periodic_fired++;
+            } else {
+                ctx->fired[fired[i] - ctx->oneshots]++;
+            }
+            if (deadlines[i] > now) {
+                ctx->early++;
+            } else if (now - deadlines[i] > ctx->max_late_us) {
+                ctx->max_late_us = now - deadlines[i];
+            }
+        }
+    } while (num == 4);
+
+    int64_t next = alarm_wheel_next_deadline(&ctx->wheel);
+    if (next != INT64_MAX && !ctx->stop) {
+        esp_timer_start_once(ctx->timer, next > now ? next - now : 0);
+    }
+}
+
+TEST_CASE("alarm wheel driven by esp_timer fires every alarm once", "[bt_osi]")
+{
+    static alarm_test_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    esp_timer_create_args_t args = {
+        .callback = alarm_test_timer_cb,
+        .arg = &ctx,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "alarm_test",
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_timer_create(&args, &ctx.timer));
+
+    int64_t now = esp_timer_get_time();
+    alarm_wheel_init(&ctx.wheel, now);
+    // Some of them share a slot
+    for (int i = 0; i < ALARM_TEST_ONESHOTS; i++) {
+        alarm_test_add(&ctx.wheel, &ctx.oneshots[i], now, now + ALARM_TEST_MS(3 + (i * 37) % (ALARM_TEST_RUN_MS - 50)), 0);
+    }
+    alarm_test_add(&ctx.wheel, &ctx.periodic, now, now + ALARM_TEST_MS(ALARM_TEST_PERIOD_MS), ALARM_TEST_MS(ALARM_TEST_PERIOD_MS));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_timer_start_once(ctx.timer, alarm_wheel_next_deadline(&ctx.wheel) - now));
+
+    vTaskDelay(pdMS_TO_TICKS(ALARM_TEST_RUN_MS));
+    ctx.stop = true;
+    esp_timer_stop(ctx.timer);
+    // Let a callback in progress complete
+    vTaskDelay(pdMS_TO_TICKS(20));
+    esp_timer_stop(ctx.timer);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_timer_delete(ctx.timer));
+
+    for (int i = 0; i < ALARM_TEST_ONESHOTS; i++) {
+        TEST_ASSERT_EQUAL(1, ctx.fired[i]);
+        TEST_ASSERT_FALSE(ctx.oneshots[i].armed);
+    }
+    TEST_ASSERT_EQUAL(0, ctx.early);
+    TEST_ASSERT_TRUE(ctx.periodic.armed);
+    TEST_ASSERT_INT_WITHIN(5, ALARM_TEST_RUN_MS / ALARM_TEST_PERIOD_MS, ctx.periodic_fired);
+    printf("alarm wheel: %d periodic expiries, max lateness %lld us\n", ctx.periodic_fired, ctx.max_late_us);
+    TEST_ASSERT_EQUAL(1, ctx.wheel.num);
+}
@@ -0,0 +1,253 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+/*
+ * Tests for the Bluedroid GATT server attribute database, run on the
+ * database only, without starting the stack. The handle lookups are
+ * checked against walks of the attribute list, as they were done before
+ * the handle index.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_BT_BLUEDROID_ENABLED && CONFIG_BT_BLE_ENABLED && CONFIG_BT_GATTS_ENABLE
+
+#include "common/bt_target.h"
+#include "gatt_int.h"
+
+#define TEST_GATT_DB_START_HANDLE   40
+#define TEST_GATT_DB_SERVICES       5
+#define TEST_GATT_DB_VALUE_LEN      8
+
+struct test_gatt_db_svc {
+    UINT16 num_handle;      /* handles reserved for the service */
+    UINT16 svc_uuid;
+    BOOLEAN is_pri;
+    UINT8 char_uuid_len;
+    UINT8 num_char;
+    BOOLEAN cccd;           /* add a CCCD to each characteristic */
+    int include;            /* index of the included service, -1 if none */
+};
+
+/* Adjacent services with all UUID sizes, unused handles at the end of a range
+ * and a characteristic/CCCD list spread over several database buffers. The
+ * last service has room for one handle only after its declaration.
+ */
+static const struct test_gatt_db_svc test_gatt_db_svcs[TEST_GATT_DB_SERVICES] = {
+    { 16, 0x1800, TRUE,  LEN_UUID_16,  5,  TRUE,  -1 },
+    { 40, 0x18ff, TRUE,  LEN_UUID_128, 12, TRUE,  -1 },
+    { 10, 0x180a, FALSE, LEN_UUID_32,  4,  FALSE, -1 },
+    { 6,  0x180f, TRUE,  LEN_UUID_16,  2,  FALSE, 2 },
+    { 2,  0x1801, TRUE,  LEN_UUID_16,  0,  FALSE, -1 },
+};
+
+static tGATT_HDL_LIST_ELEM test_gatt_db_elem[TEST_GATT_DB_SERVICES];
+
+static UINT16 test_gatt_db_max_handle(void)
+{
+    UINT16 handle = TEST_GATT_DB_START_HANDLE;
+
+    for (int i = 0; i < TEST_GATT_DB_SERVICES; i++) {
+        handle += test_gatt_db_svcs[i].num_handle;
+    }
+    return handle;
+}
+
+static tBT_UUID test_gatt_db_char_uuid(UINT8 len, int svc, int chr)
+{
+    tBT_UUID uuid = { .len = len };
+
+    if (len == LEN_UUID_16) {
+        uuid.uu.uuid16 = 0x2a00 + svc * 0x10 + chr;
+    } else if (len == LEN_UUID_32) {
+        uuid.uu.uuid32 = 0x12340000 + svc * 0x10 + chr;
+    } else {
+        memset(uuid.uu.uuid128, 0x5a, LEN_UUID_128);
+        uuid.uu.uuid128[0] = svc;
+        uuid.uu.uuid128[1] = chr;
+    }
+    return uuid;
+}
+
+static void test_gatt_db_add_service(int svc, UINT16 s_hdl)
+{
+    const struct test_gatt_db_svc *p_svc = &test_gatt_db_svcs[svc];
+    tGATT_SVC_DB *p_db = &test_gatt_db_elem[svc].svc_db;
+    tBT_UUID svc_uuid = { .len = LEN_UUID_16, .uu.uuid16 = p_svc->svc_uuid };
+    tBT_UUID cccd_uuid = { .len = LEN_UUID_16, .uu.uuid16 = GATT_UUID_CHAR_CLIENT_CONFIG };
+    tGATTS_ATTR_CONTROL control = { .auto_rsp = GATT_RSP_BY_STACK };
+    UINT8 value[TEST_GATT_DB_VALUE_LEN];
+    UINT8 cccd[2] = {0};
+    UINT16 handle = s_hdl;
+
+    test_gatt_db_elem[svc].asgn_range.s_handle = s_hdl;
+    test_gatt_db_elem[svc].asgn_range.e_handle = s_hdl + p_svc->num_handle - 1;
+    TEST_ASSERT_TRUE(gatts_init_service_db(p_db, &svc_uuid, p_svc->is_pri, s_hdl, p_svc->num_handle));
+
+    if (p_svc->include >= 0) {
+        const struct test_gatt_db_svc *p_inc = &test_gatt_db_svcs[p_svc->include];
+        tBT_UUID inc_uuid = { .len = LEN_UUID_16, .uu.uuid16 = p_inc->svc_uuid };
+
+        TEST_ASSERT_EQUAL(++handle, gatts_add_included_service(p_db,
+                          test_gatt_db_elem[p_svc->include].asgn_range.s_handle,
+                          test_gatt_db_elem[p_svc->include].asgn_range.e_handle, inc_uuid));
+    }
+
+    for (int i = 0; i < p_svc->num_char; i++) {
+        tBT_UUID char_uuid = test_gatt_db_char_uuid(p_svc->char_uuid_len, svc, i);
+        tGATT_ATTR_VAL char_val = { TEST_GATT_DB_VALUE_LEN, TEST_GATT_DB_VALUE_LEN, value };
+        tGATT_ATTR_VAL cccd_val = { sizeof(cccd), sizeof(cccd), cccd };
+
+        memset(value, svc << 4 | i, sizeof(value));
+        handle += 2;
+        TEST_ASSERT_EQUAL(handle, gatts_add_characteristic(p_db, GATT_PERM_READ | GATT_PERM_WRITE,
+                          GATT_CHAR_PROP_BIT_READ | GATT_CHAR_PROP_BIT_WRITE | GATT_CHAR_PROP_BIT_NOTIFY,
+                          &char_uuid, &char_val, &control));
+        if (p_svc->cccd) {
+            TEST_ASSERT_EQUAL(++handle, gatts_add_char_descr(p_db, GATT_PERM_READ | GATT_PERM_WRITE,
+                              &cccd_uuid, &cccd_val, &control));
+        }
+    }
+
+    test_gatt_db_elem[svc].in_use = TRUE;
+}
+
+static void test_gatt_db_delete_service(int svc)
+{
+    gatt_free_attr_value_buffer(&test_gatt_db_elem[svc]);
+    gatt_free_hdl_buffer(&test_gatt_db_elem[svc]);
+}
+
+/* Find an attribute by walking the list, as the handle lookups used to */
+static tGATT_ATTR16 *test_gatt_db_find_linear(tGATT_SVC_DB *p_db, UINT16 handle)
+{
+    tGATT_ATTR16 *p_attr = (tGATT_ATTR16 *)p_db->p_attr_list;
+
+    while (p_attr && p_attr->handle != handle) {
+        p_attr = (tGATT_ATTR16 *)p_attr->p_next;
+    }
+    return p_attr;
+}
+
+/* Find the first attribute at or after a handle, as Read By Type and Find Information used to */
+static tGATT_ATTR16 *test_gatt_db_first_linear(tGATT_SVC_DB *p_db, UINT16 handle)
+{
+    tGATT_ATTR16 *p_attr = (tGATT_ATTR16 *)p_db->p_attr_list;
+
+    while (p_attr && p_attr->handle < handle) {
+        p_attr = (tGATT_ATTR16 *)p_attr->p_next;
+    }
+    return p_attr;
+}
+
+/* Check the lookups of a service database for every handle of all the services and around them */
+static void test_gatt_db_check(tGATT_SVC_DB *p_db)
+{
+    tGATT_ATTR16 *p_attr = NULL;
+    UINT16 count = 0, handle = 0;
+    UINT16 len = 0;
+    UINT8 *p_value = NULL;
+
+    for (p_attr = (tGATT_ATTR16 *)p_db->p_attr_list; p_attr; p_attr = (tGATT_ATTR16 *)p_attr->p_next) {
+        TEST_ASSERT_GREATER_THAN(handle, p_attr->handle);
+        handle = p_attr->handle;
+        count++;
+    }
+    if (p_db->p_attr_list) {
+        TEST_ASSERT_EQUAL(p_db->next_handle - p_db->start_handle, count);
+    }
+
+    for (UINT32 h = 0; h <= test_gatt_db_max_handle() + 1; h++) {
+        p_attr = test_gatt_db_find_linear(p_db, h);
+        TEST_ASSERT_EQUAL_PTR(p_attr, gatts_find_attr_by_handle(p_db, h));
+        TEST_ASSERT_EQUAL_PTR(test_gatt_db_first_linear(p_db, h), gatts_find_first_attr_from_handle(p_db, h));
+
+        if (p_db->p_attr_list == NULL) {
+            continue;
+        }
+        if (p_attr == NULL) {
+            TEST_ASSERT_EQUAL(GATT_NOT_FOUND, gatts_get_attribute_value(p_db, h, &len, &p_value));
+        } else if (p_attr->mask & GATT_ATTR_VALUE_ALLOCATED) {
+            TEST_ASSERT_EQUAL(GATT_SUCCESS, gatts_get_attribute_value(p_db, h, &len, &p_value));
+            TEST_ASSERT_EQUAL(p_attr->p_value->attr_val.attr_len, len);
+            TEST_ASSERT_EQUAL_PTR(p_attr->p_value->attr_val.attr_val, p_value);
+        }
+    }
+}
+
+static void test_gatt_db_check_all(void)
+{
+    for (int i = 0; i < TEST_GATT_DB_SERVICES; i++) {
+        test_gatt_db_check(&test_gatt_db_elem[i].svc_db);
+    }
+}
+
+TEST_CASE("bluedroid gatt_db handle lookups match the attribute list", "[bt_gatt]")
+{
+    tBT_UUID char_uuid = test_gatt_db_char_uuid(LEN_UUID_16, 0, 0);
+    tBT_UUID cccd_uuid = { .len = LEN_UUID_16, .uu.uuid16 = GATT_UUID_CHAR_CLIENT_CONFIG };
+    tGATT_SVC_DB *p_db = NULL;
+    UINT16 s_hdl = TEST_GATT_DB_START_HANDLE;
+    int found = 0, expected = 0;
+
+    memset(test_gatt_db_elem, 0, sizeof(test_gatt_db_elem));
+
+    for (int i = 0; i < TEST_GATT_DB_SERVICES; i++) {
+        test_gatt_db_add_service(i, s_hdl);
+        s_hdl += test_gatt_db_svcs[i].num_handle;
+    }
+    test_gatt_db_check_all();
+
+    /* Each used handle is found in the service owning it only */
+    for (UINT32 h = 0; h <= test_gatt_db_max_handle(); h++) {
+        found = 0;
+        expected = 0;
+        for (int i = 0; i < TEST_GATT_DB_SERVICES; i++) {
+            p_db = &test_gatt_db_elem[i].svc_db;
+            if (gatts_find_attr_by_handle(p_db, h)) {
+                TEST_ASSERT_TRUE(h >= test_gatt_db_elem[i].asgn_range.s_handle &&
+                                 h <= test_gatt_db_elem[i].asgn_range.e_handle);
+                found++;
+            }
+            if (test_gatt_db_find_linear(p_db, h)) {
+                expected++;
+            }
+        }
+        TEST_ASSERT_EQUAL(expected, found);
+        TEST_ASSERT_TRUE(found <= 1);
+    }
+
+    /* A characteristic which does not fit is rolled back, its declaration is removed */
+    p_db = &test_gatt_db_elem[TEST_GATT_DB_SERVICES - 1].svc_db;
+    TEST_ASSERT_EQUAL(0, gatts_add_characteristic(p_db, GATT_PERM_READ, GATT_CHAR_PROP_BIT_READ,
+                      &char_uuid, NULL, NULL));
+    TEST_ASSERT_EQUAL(p_db->start_handle + 1, p_db->next_handle);
+    TEST_ASSERT_NULL(gatts_find_attr_by_handle(p_db, p_db->start_handle + 1));
+    test_gatt_db_check(p_db);
+
+    /* The released handle is reused */
+    TEST_ASSERT_EQUAL(p_db->start_handle + 1, gatts_add_char_descr(p_db, GATT_PERM_READ, &cccd_uuid, NULL, NULL));
+    TEST_ASSERT_NOT_NULL(gatts_find_attr_by_handle(p_db, p_db->start_handle + 1));
+    test_gatt_db_check(p_db);
+
+    /* Deleting a service leaves the other ones unchanged */
+    test_gatt_db_delete_service(1);
+    TEST_ASSERT_NULL(gatts_find_first_attr_from_handle(&test_gatt_db_elem[1].svc_db, 0));
+    test_gatt_db_check_all();
+
+    for (int i = 0; i < TEST_GATT_DB_SERVICES; i++) {
+        if (i != 1) {
+            test_gatt_db_delete_service(i);
+        }
+    }
+    test_gatt_db_check_all();
+}
+
+#endif /* CONFIG_BT_BLUEDROID_ENABLED && CONFIG_BT_BLE_ENABLED && CONFIG_BT_GATTS_ENABLE */
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+/*
+ * Tests for batched GATT server notifications, run without starting the
+ * stack: the argument checks of esp_ble_gatts_send_notify_batch, which are
+ * done before the Bluedroid state is checked, and the split of a batch into
+ * Multiple Handle Value Notification PDUs.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_BT_BLUEDROID_ENABLED && CONFIG_BT_BLE_ENABLED && CONFIG_BT_GATTS_ENABLE
+
+#include "esp_bt_main.h"
+#include "esp_gatts_api.h"
+#include "common/bt_target.h"
+#include "gatt_int.h"
+
+#define TEST_GATTS_IF           3
+#define TEST_GATTS_CONN_ID      0
+#define TEST_GATTS_HANDLE       42
+
+static uint8_t test_gatts_value[ESP_GATT_MAX_ATTR_LEN + 1];
+
+static void test_gatts_fill_values(esp_gatts_notify_value_t *values, uint16_t num, uint16_t len)
+{
+    for (uint16_t i = 0; i < num; i++) {
+        values[i].attr_handle = TEST_GATTS_HANDLE + 2 * i;
+        values[i].value_len = len;
+        values[i].value = test_gatts_value;
+    }
+}
+
+static esp_err_t test_gatts_send(uint16_t num, const esp_gatts_notify_value_t *values)
+{
+    return esp_ble_gatts_send_notify_batch(TEST_GATTS_IF, TEST_GATTS_CONN_ID, num, values);
+}
+
+TEST_CASE("bluedroid gatts notify batch rejects invalid arguments", "[bt_gatt]")
+{
+    esp_gatts_notify_value_t values[ESP_GATTS_NOTIFY_BATCH_MAX + 1];
+
+    TEST_ASSERT_EQUAL(ESP_BLUEDROID_STATUS_UNINITIALIZED, esp_bluedroid_get_status());
+
+    test_gatts_fill_values(values, ESP_GATTS_NOTIFY_BATCH_MAX + 1, 8);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, test_gatts_send(1, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, test_gatts_send(0, values));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, test_gatts_send(ESP_GATTS_NOTIFY_BATCH_MAX + 1, values));
+
+    /* a bad entry anywhere in the batch fails the whole call */
+    values[ESP_GATTS_NOTIFY_BATCH_MAX - 1].value_len = ESP_GATT_MAX_ATTR_LEN + 1;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, test_gatts_send(ESP_GATTS_NOTIFY_BATCH_MAX, values));
+    values[ESP_GATTS_NOTIFY_BATCH_MAX - 1].value_len = ESP_GATT_MAX_ATTR_LEN;
+
+    values[1].attr_handle = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, test_gatts_send(ESP_GATTS_NOTIFY_BATCH_MAX, values));
+    values[1].attr_handle = TEST_GATTS_HANDLE;
+
+    values[2].value = NULL;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, test_gatts_send(ESP_GATTS_NOTIFY_BATCH_MAX, values));
+
+    /* an empty value needs no buffer, the call then only fails on the stack state */
+    values[2].value_len = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, test_gatts_send(ESP_GATTS_NOTIFY_BATCH_MAX, values));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, test_gatts_send(1, values));
+}
+
+/* Number of PDUs gatts_multi_notif_batch_len splits the tuples into. Each PDU
+ * must take at least one tuple, and more than one only if they fit in max_len.
+ */
+static int test_gatts_count_pdus(const tGATT_HLV *tuples, UINT16 num_tuples, UINT16 max_len)
+{
+    UINT16 sent = 0;
+    int pdus = 0;
+
+    while (sent < num_tuples) {
+        UINT16 num = gatts_multi_notif_batch_len(&tuples[sent], num_tuples - sent, max_len);
+        UINT16 len = 0;
+
+        TEST_ASSERT_GREATER_OR_EQUAL(1, num);
+        TEST_ASSERT_LESS_OR_EQUAL(num_tuples - sent, num);
+        for (UINT16 i = 0; i < num; i++) {
+            len += 4 + tuples[sent + i].length;
+        }
+        if (num > 1) {
+            TEST_ASSERT_LESS_OR_EQUAL(max_len, len);
+        }
+        /* the next tuple would not have fit */
+        if (sent + num < num_tuples) {
+            TEST_ASSERT_GREATER_THAN(max_len, len + 4 + tuples[sent + num].length);
+        }
+
+        sent += num;
+        pdus++;
+    }
+
+    return pdus;
+}
+
+static void test_gatts_fill_tuples(tGATT_HLV *tuples, UINT16 num, UINT16 len)
+{
+    for (UINT16 i = 0; i < num; i++) {
+        tuples[i].handle = TEST_GATTS_HANDLE + 2 * i;
+        tuples[i].length = len;
+        tuples[i].value = test_gatts_value;
+    }
+}
+
+TEST_CASE("bluedroid gatts notify batch packs values into the MTU", "[bt_gatt]")
+{
+    tGATT_HLV tuples[ESP_GATTS_NOTIFY_BATCH_MAX];
+
+    /* default MTU: two 8 byte values need 24 bytes, one PDU each */
+    test_gatts_fill_tuples(tuples, 4, 8);
+    TEST_ASSERT_EQUAL(4, test_gatts_count_pdus(tuples, 4, GATT_DEF_BLE_MTU_SIZE - 1));
+
+    /* MTU 247: 12 values of 8 bytes take 144 bytes */
+    test_gatts_fill_tuples(tuples, 12, 8);
+    TEST_ASSERT_EQUAL(1, test_gatts_count_pdus(tuples, 12, 246));
+
+    /* MTU 247: 4 values of 60 bytes take 256 bytes, 3 per PDU */
+    test_gatts_fill_tuples(tuples, ESP_GATTS_NOTIFY_BATCH_MAX, 60);
+    TEST_ASSERT_EQUAL(11, test_gatts_count_pdus(tuples, ESP_GATTS_NOTIFY_BATCH_MAX, 246));
+
+    /* exact fit: 3 values of 78 bytes take 246 bytes */
+    test_gatts_fill_tuples(tuples, 6, 78);
+    TEST_ASSERT_EQUAL(3, gatts_multi_notif_batch_len(tuples, 6, 246));
+    TEST_ASSERT_EQUAL(2, test_gatts_count_pdus(tuples, 6, 246));
+
+    /* a value longer than the MTU goes out on its own, the rest are packed */
+    test_gatts_fill_tuples(tuples, 5, 8);
+    tuples[0].length = ESP_GATT_MAX_ATTR_LEN;
+    TEST_ASSERT_EQUAL(1, gatts_multi_notif_batch_len(tuples, 5, 246));
+    TEST_ASSERT_EQUAL(2, test_gatts_count_pdus(tuples, 5, 246));
+    tuples[0].length = 0;
+    tuples[4].length = ESP_GATT_MAX_ATTR_LEN;
+    TEST_ASSERT_EQUAL(4, gatts_multi_notif_batch_len(tuples, 5, 246));
+    TEST_ASSERT_EQUAL(2, test_gatts_count_pdus(tuples, 5, 246));
+
+    /* a single tuple is never split */
+    TEST_ASSERT_EQUAL(1, gatts_multi_notif_batch_len(&tuples[4], 1, GATT_DEF_BLE_MTU_SIZE - 1));
+}
+
+#endif /* CONFIG_BT_BLUEDROID_ENABLED && CONFIG_BT_BLE_ENABLED && CONFIG_BT_GATTS_ENABLE */
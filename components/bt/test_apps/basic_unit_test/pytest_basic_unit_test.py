@@ -6,6 +6,7 @@ from pytest_embedded_idf.utils import idf_parametrize
 
 
 @pytest.mark.generic
+@idf_parametrize('config', ['default', 'ble_mesh', 'ble_mesh_df_lpn', 'ble_mesh_provisioner'], indirect=['config'])
 @idf_parametrize('target', ['esp32', 'esp32c3'], indirect=['target'])
 def test_bt(dut: Dut) -> None:
     dut.run_all_single_board_cases()
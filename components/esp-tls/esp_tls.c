@@ -132,11 +132,38 @@ static ssize_t tcp_write(esp_tls_t *tls, const char *data, size_t datalen)
     return send(tls->sockfd, data, datalen, 0);
 }
 
+ssize_t esp_tls_conn_flush(esp_tls_t *tls)
+{
+    if (!tls) {
+        return -1;
+    }
+    while (tls->tx_buf_sent < tls->tx_buf_len) {
+        ssize_t ret = tls->write(tls, tls->tx_buf + tls->tx_buf_sent, tls->tx_buf_len - tls->tx_buf_sent);
+        if (ret < 0) {
+            /* keep the pending data, the flush can be retried */
+            tls->tx_flush_pending = true;
+            return ret;
+        }
+        tls->tx_buf_sent += ret;
+    }
+    tls->tx_buf_len = 0;
+    tls->tx_buf_sent = 0;
+    tls->tx_flush_pending = false;
+    return 0;
+}
+
 ssize_t esp_tls_conn_read(esp_tls_t *tls, void  *data, size_t datalen)
 {
     if (!tls) {
         return -1;
     }
+    if (tls->tx_buf_len) {
+        /* the peer may be waiting for the coalesced data before it replies */
+        ssize_t ret = esp_tls_conn_flush(tls);
+        if (ret < 0) {
+            return ret;
+        }
+    }
     return tls->read(tls, (char *)data, datalen);
 }
 
@@ -145,7 +172,50 @@ ssize_t esp_tls_conn_write(esp_tls_t *tls, const void  *data, size_t datalen)
     if (!tls || !data) {
         return -1;
     }
-    return tls->write(tls, (char *)data, datalen);
+    if (tls->tx_buf == NULL) {
+        return tls->write(tls, (char *)data, datalen);
+    }
+    if (tls->tx_flush_pending || tls->tx_buf_len + datalen > tls->tx_buf_size) {
+        /*
+         * A blocked TLS write must be retried with the same data, so a pending
+         * flush is finished before anything else is collected
+         */
+        ssize_t ret = esp_tls_conn_flush(tls);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+    if (datalen >= tls->tx_buf_size) {
+        /* nothing to gain from copying, the write makes full records on its own */
+        return tls->write(tls, (char *)data, datalen);
+    }
+    memcpy(tls->tx_buf + tls->tx_buf_len, data, datalen);
+    tls->tx_buf_len += datalen;
+    if (tls->tx_buf_len == tls->tx_buf_size) {
+        ssize_t ret = esp_tls_conn_flush(tls);
+        /* the data is taken either way, a blocked flush is retried by the next call */
+        if (ret < 0 && ret != ESP_TLS_ERR_SSL_WANT_WRITE && ret != ESP_TLS_ERR_SSL_WANT_READ) {
+            return ret;
+        }
+    }
+    return datalen;
+}
+
+static esp_err_t esp_tls_tx_buf_init(esp_tls_t *tls, const esp_tls_cfg_t *cfg)
+{
+    if (cfg == NULL || cfg->tx_coalesce_size == 0 || tls->tx_buf != NULL) {
+        return ESP_OK;
+    }
+    tls->tx_buf = malloc(cfg->tx_coalesce_size);
+    if (tls->tx_buf == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate TX coalescing buffer");
+        return ESP_ERR_NO_MEM;
+    }
+    tls->tx_buf_size = cfg->tx_coalesce_size;
+    tls->tx_buf_len = 0;
+    tls->tx_buf_sent = 0;
+    tls->tx_flush_pending = false;
+    return ESP_OK;
 }
 
 /**
@@ -155,11 +225,18 @@ int esp_tls_conn_destroy(esp_tls_t *tls)
 {
     if (tls != NULL) {
         int ret = 0;
+        if (tls->tx_buf_len && tls->conn_state == ESP_TLS_DONE) {
+            /* best effort: don't silently drop data the caller considers written */
+            if (esp_tls_conn_flush(tls) < 0) {
+                ESP_LOGW(TAG, "Failed to flush %d coalesced bytes on close", (int)(tls->tx_buf_len - tls->tx_buf_sent));
+            }
+        }
         _esp_tls_conn_delete(tls);
         if (tls->sockfd >= 0) {
             ret = close(tls->sockfd);
         }
         esp_tls_internal_event_tracker_destroy(tls->error_handle);
+        free(tls->tx_buf);
 #if CONFIG_MBEDTLS_SSL_PROTO_TLS1_3 && CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
         if (tls->client_session) {
             free(tls->client_session);
@@ -476,6 +553,10 @@ static int esp_tls_low_level_conn(const char *hostname, int hostlen, int port, c
             ESP_INT_EVENT_TRACKER_CAPTURE(tls->error_handle, ESP_TLS_ERR_TYPE_ESP, esp_ret);
             return -1;
         }
+        if ((esp_ret = esp_tls_tx_buf_init(tls, cfg)) != ESP_OK) {
+            ESP_INT_EVENT_TRACKER_CAPTURE(tls->error_handle, ESP_TLS_ERR_TYPE_ESP, esp_ret);
+            return -1;
+        }
         if (tls->is_tls == false) {
             tls->read = tcp_read;
             tls->write = tcp_write;
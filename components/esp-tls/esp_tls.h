@@ -238,6 +238,12 @@ typedef struct esp_tls_cfg {
     esp_tls_dyn_buf_strategy_t esp_tls_dyn_buf_strategy; /*!< ESP-TLS dynamic buffer strategy */
 #endif
 
+    size_t tx_coalesce_size;                /*!< Size of the TX coalescing buffer (0 - disabled, default).
+                                                 When set, small writes are collected and sent as a single TLS record
+                                                 once the buffer is full, on esp_tls_conn_flush(), before a read or (best effort)
+                                                 in esp_tls_conn_destroy().
+                                                 Writes larger than the buffer bypass it. */
+
 } esp_tls_cfg_t;
 
 #if defined(CONFIG_ESP_TLS_SERVER_SESSION_TICKETS)
@@ -495,9 +501,27 @@ int esp_tls_conn_http_new_async(const char *url, const esp_tls_cfg_t *cfg, esp_t
  *               ESP_TLS_ERR_SSL_WANT_WRITE.
  *                  if the handshake is incomplete and waiting for data to be available for reading.
  *                  In this case this functions needs to be called again when the underlying transport is ready for operation.
+ *                  With esp_tls_cfg_t::tx_coalesce_size set, also returned if the coalesced data couldn't be flushed yet,
+ *                  in which case none of 'data' has been written.
  */
 ssize_t esp_tls_conn_write(esp_tls_t *tls, const void *data, size_t datalen);
 
+/**
+ * @brief      Send the data collected in the TX coalescing buffer.
+ *
+ * Only has an effect if the connection was created with esp_tls_cfg_t::tx_coalesce_size set.
+ * esp_tls_conn_read() flushes the buffer automatically before reading.
+ *
+ * @param[in]  tls      pointer to esp-tls as esp-tls handle.
+ *
+ * @return
+ *             - 0  if all pending data has been written (or nothing was pending).
+ *             - <0 if the write failed, the return value is the same as for esp_tls_conn_write().
+ *                  In case of ESP_TLS_ERR_SSL_WANT_WRITE, call this function again when the
+ *                  underlying transport is writable.
+ */
+ssize_t esp_tls_conn_flush(esp_tls_t *tls);
+
 /**
  * @brief      Read from specified tls connection into the buffer 'data'.
  *
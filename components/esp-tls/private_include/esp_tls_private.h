@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -103,6 +103,16 @@ struct esp_tls {
     esp_tls_dyn_buf_strategy_t esp_tls_dyn_buf_strategy;                        /*!< ESP-TLS dynamic buffer strategy */
 #endif
 
+    char *tx_buf;                                                               /*!< TX coalescing buffer, NULL if disabled */
+
+    size_t tx_buf_size;                                                         /*!< Capacity of the TX coalescing buffer */
+
+    size_t tx_buf_len;                                                          /*!< Number of bytes collected in the TX coalescing buffer */
+
+    size_t tx_buf_sent;                                                         /*!< Number of collected bytes already written by a partial flush */
+
+    bool tx_flush_pending;                                                      /*!< A flush failed, it must be retried with the same data before more is collected */
+
 };
 
 // Function pointer for the server configuration API
@@ -1,16 +1,24 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <sys/param.h>
 #include "memory_checks.h"
 #include "esp_tls.h"
+#include "esp_tls_private.h"
 #include "unity.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_mac.h"
 #include "sys/socket.h"
+#include "netinet/in.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "test_utils.h"
 
 const char *test_cert_pem =   "-----BEGIN CERTIFICATE-----\n"\
                               "MIICrDCCAZQCCQD88gCs5AFs/jANBgkqhkiG9w0BAQsFADAYMRYwFAYDVQQDDA1F\n"\
@@ -94,3 +102,210 @@ TEST_CASE("esp_tls_server session create delete", "[esp-tls]")
     esp_tls_server_session_delete(tls);
 
 }
+
+#define TEST_COALESCE_PORT      8443
+#define TEST_COALESCE_MSG_PARTS 3
+
+typedef struct {
+    int listen_fd;
+    SemaphoreHandle_t done;
+    int app_records;
+    int wire_bytes;
+} test_tls_record_counter_t;
+
+/* Accepts one TLS connection, then reads the raw socket and counts application data records */
+static void test_tls_record_counter_task(void *arg)
+{
+    test_tls_record_counter_t *srv = (test_tls_record_counter_t *)arg;
+    esp_tls_cfg_server_t cfg = {
+        .servercert_buf = (const unsigned char *)test_cert_pem,
+        .servercert_bytes = strlen(test_cert_pem) + 1,
+        .serverkey_buf = (const unsigned char *)test_key_pem,
+        .serverkey_bytes = strlen(test_key_pem) + 1,
+    };
+    srv->app_records = 0;
+    srv->wire_bytes = 0;
+    int fd = accept(srv->listen_fd, NULL, NULL);
+    esp_tls_t *tls = esp_tls_init();
+    if (fd >= 0 && tls && esp_tls_server_session_create(&cfg, fd, tls) == 0) {
+        static uint8_t wire[2048];
+        int len = 0;
+        int ret;
+        while (len < sizeof(wire) && (ret = recv(fd, wire + len, sizeof(wire) - len, 0)) > 0) {
+            len += ret;
+        }
+        // TLS record header: content type (1), version (2), length (2)
+        for (int off = 0; off + 5 <= len; off += 5 + ((wire[off + 3] << 8) | wire[off + 4])) {
+            if (wire[off] == 0x17) {
+                srv->app_records++;
+            }
+        }
+        srv->wire_bytes = len;
+    }
+    esp_tls_server_session_delete(tls);
+    if (fd >= 0) {
+        close(fd);
+    }
+    xSemaphoreGive(srv->done);
+    vTaskDelete(NULL);
+}
+
+static void test_tls_send_message(size_t tx_coalesce_size, bool flush, test_tls_record_counter_t *srv)
+{
+    const char *parts[TEST_COALESCE_MSG_PARTS] = { "header:", "topic/sensor:", "{\"value\":42}" };
+    esp_tls_cfg_t cfg = {
+        .cacert_buf = (const unsigned char *)test_cert_pem,
+        .cacert_bytes = strlen(test_cert_pem) + 1,
+        .skip_common_name = true,
+        .timeout_ms = 10000,
+        .tls_version = ESP_TLS_VER_TLS_1_2,     // TLS 1.3 would hide the close_notify alert in an application data record
+        .tx_coalesce_size = tx_coalesce_size,
+    };
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(test_tls_record_counter_task, "tls_server", 8192, srv, 5, NULL));
+    esp_tls_t *tls = esp_tls_init();
+    TEST_ASSERT_NOT_NULL(tls);
+    TEST_ASSERT_EQUAL(1, esp_tls_conn_new_sync("127.0.0.1", strlen("127.0.0.1"), TEST_COALESCE_PORT, &cfg, tls));
+    for (int i = 0; i < TEST_COALESCE_MSG_PARTS; i++) {
+        TEST_ASSERT_EQUAL(strlen(parts[i]), esp_tls_conn_write(tls, parts[i], strlen(parts[i])));
+    }
+    if (flush) {
+        TEST_ASSERT_EQUAL(0, esp_tls_conn_flush(tls));
+    }
+    // without an explicit flush, destroying the connection sends the coalesced data
+    esp_tls_conn_destroy(tls);
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(srv->done, pdMS_TO_TICKS(20000)));
+    printf("tx_coalesce_size=%d: %d records, %d bytes on the wire per message\n",
+           (int)tx_coalesce_size, srv->app_records, srv->wire_bytes);
+}
+
+TEST_CASE("esp-tls write coalescing reduces records per message", "[esp-tls][timeout=60]")
+{
+    test_case_uses_tcpip();
+    test_tls_record_counter_t srv = { .done = xSemaphoreCreateBinary() };
+    TEST_ASSERT_NOT_NULL(srv.done);
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(TEST_COALESCE_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    srv.listen_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, srv.listen_fd);
+    TEST_ASSERT_EQUAL(0, bind(srv.listen_fd, (struct sockaddr *)&addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL(0, listen(srv.listen_fd, 1));
+
+    test_tls_send_message(0, true, &srv);
+    TEST_ASSERT_EQUAL(TEST_COALESCE_MSG_PARTS, srv.app_records);
+    int uncoalesced_bytes = srv.wire_bytes;
+
+    test_tls_send_message(512, true, &srv);
+    TEST_ASSERT_EQUAL(1, srv.app_records);
+    TEST_ASSERT_LESS_THAN(uncoalesced_bytes, srv.wire_bytes);
+    int coalesced_bytes = srv.wire_bytes;
+
+    test_tls_send_message(512, false, &srv);
+    TEST_ASSERT_EQUAL(1, srv.app_records);
+    TEST_ASSERT_EQUAL(coalesced_bytes, srv.wire_bytes);
+
+    close(srv.listen_fd);
+    vSemaphoreDelete(srv.done);
+}
+
+#define TEST_FAKE_WIRE_LEN  64
+
+/*
+ * Fake TLS write, following the script of return values: a positive value accepts up to that
+ * many bytes, ESP_TLS_ERR_SSL_WANT_WRITE blocks. Once the script is over, everything is accepted.
+ */
+static struct {
+    const int *script;
+    size_t script_len;
+    size_t calls;
+    const char *blocked_data;
+    size_t blocked_len;
+    char wire[TEST_FAKE_WIRE_LEN];
+    size_t wire_len;
+} s_fake_write;
+
+static ssize_t test_fake_tls_write(esp_tls_t *tls, const char *data, size_t datalen)
+{
+    if (s_fake_write.blocked_data) {
+        // like mbedtls_ssl_write(), a blocked write must be retried with the same arguments
+        TEST_ASSERT_EQUAL_PTR(s_fake_write.blocked_data, data);
+        TEST_ASSERT_EQUAL(s_fake_write.blocked_len, datalen);
+        s_fake_write.blocked_data = NULL;
+    }
+    size_t len = datalen;
+    if (s_fake_write.calls < s_fake_write.script_len) {
+        int action = s_fake_write.script[s_fake_write.calls++];
+        if (action == ESP_TLS_ERR_SSL_WANT_WRITE) {
+            s_fake_write.blocked_data = data;
+            s_fake_write.blocked_len = datalen;
+            return ESP_TLS_ERR_SSL_WANT_WRITE;
+        }
+        len = MIN(len, (size_t)action);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_FAKE_WIRE_LEN, s_fake_write.wire_len + len);
+    memcpy(s_fake_write.wire + s_fake_write.wire_len, data, len);
+    s_fake_write.wire_len += len;
+    return len;
+}
+
+static ssize_t test_fake_tls_read(esp_tls_t *tls, char *data, size_t datalen)
+{
+    TEST_FAIL_MESSAGE("read with a pending flush");
+    return -1;
+}
+
+static esp_tls_t *test_fake_tls_new(size_t tx_coalesce_size, const int *script, size_t script_len)
+{
+    memset(&s_fake_write, 0, sizeof(s_fake_write));
+    s_fake_write.script = script;
+    s_fake_write.script_len = script_len;
+    esp_tls_t *tls = esp_tls_init();
+    TEST_ASSERT_NOT_NULL(tls);
+    tls->write = test_fake_tls_write;
+    tls->read = test_fake_tls_read;
+    tls->tx_buf = malloc(tx_coalesce_size);
+    TEST_ASSERT_NOT_NULL(tls->tx_buf);
+    tls->tx_buf_size = tx_coalesce_size;
+    return tls;
+}
+
+static void test_fake_tls_check_wire(const char *expected)
+{
+    TEST_ASSERT_EQUAL(strlen(expected), s_fake_write.wire_len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, s_fake_write.wire, s_fake_write.wire_len);
+}
+
+TEST_CASE("esp-tls write coalescing retries a blocked flush with the same data", "[esp-tls]")
+{
+    char buf[4];
+
+    // Flush blocked at the start: writes and reads retry it before doing anything else
+    const int blocked_twice[] = { ESP_TLS_ERR_SSL_WANT_WRITE, ESP_TLS_ERR_SSL_WANT_WRITE, ESP_TLS_ERR_SSL_WANT_WRITE };
+    esp_tls_t *tls = test_fake_tls_new(16, blocked_twice, 3);
+    TEST_ASSERT_EQUAL(8, esp_tls_conn_write(tls, "abcdefgh", 8));
+    TEST_ASSERT_EQUAL(0, s_fake_write.wire_len);
+    TEST_ASSERT_EQUAL(ESP_TLS_ERR_SSL_WANT_WRITE, esp_tls_conn_flush(tls));
+    TEST_ASSERT_EQUAL(ESP_TLS_ERR_SSL_WANT_WRITE, esp_tls_conn_write(tls, "ijkl", 4));
+    TEST_ASSERT_EQUAL(ESP_TLS_ERR_SSL_WANT_WRITE, esp_tls_conn_read(tls, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(8, tls->tx_buf_len);
+    TEST_ASSERT_EQUAL(4, esp_tls_conn_write(tls, "ijkl", 4));
+    test_fake_tls_check_wire("abcdefgh");
+    TEST_ASSERT_EQUAL(0, esp_tls_conn_flush(tls));
+    test_fake_tls_check_wire("abcdefghijkl");
+    esp_tls_conn_destroy(tls);
+
+    // Flush blocked after a partial write, when the buffer gets full: the data is taken,
+    // the next write resumes the flush from where it stopped
+    const int partial_then_blocked[] = { 5, ESP_TLS_ERR_SSL_WANT_WRITE };
+    tls = test_fake_tls_new(16, partial_then_blocked, 2);
+    TEST_ASSERT_EQUAL(10, esp_tls_conn_write(tls, "0123456789", 10));
+    TEST_ASSERT_EQUAL(6, esp_tls_conn_write(tls, "abcdef", 6));
+    test_fake_tls_check_wire("01234");
+    TEST_ASSERT_EQUAL(2, esp_tls_conn_write(tls, "XY", 2));
+    test_fake_tls_check_wire("0123456789abcdef");
+    TEST_ASSERT_EQUAL(0, esp_tls_conn_flush(tls));
+    test_fake_tls_check_wire("0123456789abcdefXY");
+    esp_tls_conn_destroy(tls);
+}
@@ -466,6 +466,21 @@ typedef struct httpd_uri {
      */
     esp_err_t (*ws_pre_handshake_cb)(httpd_req_t *req);
 #endif
+
+#if CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE || __DOXYGEN__
+    /**
+     * Accept the permessage-deflate extension (RFC 7692) if the client offers it.
+     * Frames are then transparently inflated by httpd_ws_recv_frame() and
+     * compressed by httpd_ws_send_frame().
+     */
+    bool ws_permessage_deflate;
+
+    /**
+     * Reset the compression context after every message in both directions.
+     * Lowers the compression ratio but frees the deflate state between messages.
+     */
+    bool ws_deflate_no_context_takeover;
+#endif
 #endif
 } httpd_uri_t;
 
@@ -75,6 +75,9 @@ struct sock_db {
     esp_err_t (*ws_handler)(httpd_req_t *r);   /*!< WebSocket handler, leave to null if it's not WebSocket */
     bool ws_control_frames;                         /*!< WebSocket flag indicating that control frames should be passed to user handlers */
     void *ws_user_ctx;                         /*!< Pointer to user context data which will be available to handler for websocket*/
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    struct httpd_ws_deflate *ws_deflate;    /*!< permessage-deflate state, NULL if the extension was not negotiated */
+#endif
 #endif
 };
 
@@ -105,6 +108,9 @@ struct httpd_req_aux {
     httpd_ws_type_t ws_type;                        /*!< WebSocket frame type */
     bool ws_final;                                  /*!< WebSocket FIN bit (final frame or not) */
     uint8_t mask_key[4];                            /*!< WebSocket mask key for this payload */
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    bool ws_compressed;                             /*!< WebSocket payload is permessage-deflate compressed */
+#endif
 #endif
 };
 
@@ -523,7 +529,7 @@ int httpd_default_recv(httpd_handle_t hd, int sockfd, char *buf, size_t buf_len,
  * @brief   This function is for responding a WebSocket handshake
  *
  * @param[in] req                       Pointer to handshake request that will be handled
- * @param[in] supported_subprotocol     Pointer to the subprotocol supported by this URI
+ * @param[in] uri                       URI handler of the WebSocket endpoint
  * @return
  *  - ESP_OK                        : When handshake is successful
  *  - ESP_ERR_NOT_FOUND             : When some headers (Sec-WebSocket-*) are not found
@@ -532,7 +538,7 @@ int httpd_default_recv(httpd_handle_t hd, int sockfd, char *buf, size_t buf_len,
  *  - ESP_ERR_INVALID_ARG           : Argument is invalid (null or non-WebSocket)
  *  - ESP_FAIL                      : Socket failures
  */
-esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req, const char *supported_subprotocol);
+esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req, const httpd_uri_t *uri);
 
 /**
  * @brief   This function is for getting a frame type
@@ -547,6 +553,15 @@ esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req, const char *suppor
  */
 esp_err_t httpd_ws_get_frame_type(httpd_req_t *req);
 
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+/**
+ * @brief   Release the permessage-deflate state of a session
+ *
+ * @param[in] sd    Session of a WebSocket client
+ */
+void httpd_ws_deflate_free(struct sock_db *sd);
+#endif
+
 /**
  * @brief   Trigger an httpd session close externally
  *
@@ -380,6 +380,9 @@ void httpd_sess_delete(struct httpd_data *hd, struct sock_db *session)
 
     // clear all contexts
     httpd_sess_clear_ctx(session);
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    httpd_ws_deflate_free(session);
+#endif
 
     // mark session slot as available
     session->fd = -1;
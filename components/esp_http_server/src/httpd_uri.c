@@ -172,6 +172,10 @@ esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
 #ifdef CONFIG_HTTPD_WS_SUPPORT
             hd->hd_calls[i]->is_websocket = uri_handler->is_websocket;
             hd->hd_calls[i]->handle_ws_control_frames = uri_handler->handle_ws_control_frames;
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+            hd->hd_calls[i]->ws_permessage_deflate = uri_handler->ws_permessage_deflate;
+            hd->hd_calls[i]->ws_deflate_no_context_takeover = uri_handler->ws_deflate_no_context_takeover;
+#endif
             if (uri_handler->supported_subprotocol) {
                 hd->hd_calls[i]->supported_subprotocol = strdup(uri_handler->supported_subprotocol);
                 if (hd->hd_calls[i]->supported_subprotocol == NULL) {
@@ -331,7 +335,7 @@ esp_err_t httpd_uri(struct httpd_data *hd)
 #endif
 
         ESP_LOGD(TAG, LOG_FMT("Responding WS handshake to sock %d"), aux->sd->fd);
-        esp_err_t ret = httpd_ws_respond_server_handshake(&hd->hd_req, uri->supported_subprotocol);
+        esp_err_t ret = httpd_ws_respond_server_handshake(&hd->hd_req, uri);
         if (ret != ESP_OK) {
             return ret;
         }
@@ -19,6 +19,11 @@
 #include "esp_httpd_priv.h"
 #include "freertos/event_groups.h"
 #include "sdkconfig.h"
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+#include <sys/param.h>
+#include "freertos/semphr.h"
+#include "esp_ws_deflate.h"
+#endif
 
 #ifdef CONFIG_HTTPD_WS_SUPPORT
 
@@ -46,6 +51,7 @@ static const char *TAG="httpd_ws";
 #define HTTPD_WS_OPCODE_BITS    0x0fU
 #define HTTPD_WS_MASK_BIT       0x80U
 #define HTTPD_WS_LENGTH_BITS    0x7fU
+#define HTTPD_WS_RSV1_BIT       0x40U
 
 /*
  * The magic GUID string used for handshake
@@ -53,6 +59,72 @@ static const char *TAG="httpd_ws";
  */
 static const char ws_magic_uuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+/*
+ * permessage-deflate, please refer to RFC7692 for more details.
+ */
+#define HTTPD_WS_DEFLATE_MAX_PAYLOAD    CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE_MAX_PAYLOAD
+#define HTTPD_WS_DEFLATE_MIN_LEN        CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE_MIN_LEN
+#define HTTPD_WS_DEFLATE_WINDOW_BITS    CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE_WINDOW_BITS
+
+struct httpd_ws_deflate {
+    esp_ws_deflate_t codec;
+    SemaphoreHandle_t tx_lock;      /*!< Keeps the compressed frames in the order of the compressor state */
+};
+
+void httpd_ws_deflate_free(struct sock_db *sd)
+{
+    struct httpd_ws_deflate *d = sd->ws_deflate;
+    if (d == NULL) {
+        return;
+    }
+    esp_ws_deflate_free(&d->codec);
+    vSemaphoreDelete(d->tx_lock);
+    free(d);
+    sd->ws_deflate = NULL;
+}
+
+/**
+ * @brief Picks the first acceptable permessage-deflate offer
+ *
+ * @param offers[in]                Value of the Sec-WebSocket-Extensions request header, modified in place
+ * @param no_context_takeover[in]   Ask for no context takeover in both directions
+ * @param response[out]             Parameters of the accepted offer, to be sent back
+ * @return true: an offer was accepted
+ * @return false
+ */
+static bool httpd_ws_deflate_negotiate(char *offers, bool no_context_takeover, esp_ws_deflate_params_t *response)
+{
+    char *rest_offer = NULL;
+    for (char *offer = strtok_r(offers, ",", &rest_offer); offer; offer = strtok_r(NULL, ",", &rest_offer)) {
+        esp_ws_deflate_params_t params;
+        esp_err_t ret = esp_ws_deflate_parse_params(offer, &params);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            continue;
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGD(TAG, LOG_FMT("Declined permessage-deflate offer"));
+            continue;
+        }
+
+        *response = params;
+        /* Any window up to the requested one can be used, please refer to RFC7692 Section 7.1.2.1 */
+        if (params.server_max_window_bits) {
+            response->server_max_window_bits = MIN(params.server_max_window_bits, HTTPD_WS_DEFLATE_WINDOW_BITS);
+        }
+        /* Clients which can limit their window are asked to, the others may use 32 KB */
+        uint8_t client_bits = MIN(params.client_max_window_bits, HTTPD_WS_DEFLATE_WINDOW_BITS);
+        response->client_max_window_bits = client_bits < ESP_WS_DEFLATE_MAX_WINDOW_BITS ? client_bits : 0;
+        if (no_context_takeover) {
+            response->server_no_context_takeover = true;
+            response->client_no_context_takeover = true;
+        }
+        return true;
+    }
+    return false;
+}
+#endif /* CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE */
+
 /* Checks if any subprotocols from the comma separated list matches the supported one
  *
  * Returns true if the response should contain a protocol field
@@ -96,8 +168,10 @@ static bool httpd_ws_get_response_subprotocol(const char *supported_subprotocol,
 
 }
 
-esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req, const char *supported_subprotocol)
+esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req, const httpd_uri_t *uri)
 {
+    const char *supported_subprotocol = uri->supported_subprotocol;
+
     /* Probe if input parameters are valid or not */
     if (!req || !req->aux) {
         ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
@@ -186,8 +260,23 @@ sha_end:
     }
 
 
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    esp_ws_deflate_params_t deflate = { 0 };
+    bool deflate_accepted = false;
+    if (uri->ws_permessage_deflate) {
+        char extensions[128] = { '\0' };
+        if (httpd_req_get_hdr_value_str(req, "Sec-WebSocket-Extensions", extensions, sizeof(extensions)) == ESP_OK) {
+            deflate_accepted = httpd_ws_deflate_negotiate(extensions, uri->ws_deflate_no_context_takeover, &deflate);
+        }
+    }
+#endif
+
     /* Prepare the Switching Protocol response */
-    char tx_buf[192] = { '\0' };
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    char tx_buf[384] = { '\0' };
+#else
+    char tx_buf[256] = { '\0' };
+#endif
     int fmt_len = snprintf(tx_buf, sizeof(tx_buf),
                            "HTTP/1.1 101 Switching Protocols\r\n"
                            "Upgrade: websocket\r\n"
@@ -217,6 +306,27 @@ sha_end:
         }
     }
 
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    if (deflate_accepted) {
+        char extensions[128];
+        esp_ws_deflate_format_params(&deflate, extensions, sizeof(extensions));
+        int r = snprintf(tx_buf + fmt_len, sizeof(tx_buf) - fmt_len, "Sec-WebSocket-Extensions: %s\r\n", extensions);
+        if (r <= 0) {
+            ESP_LOGE(TAG, "Error in response generation"
+                          "(snprintf of extensions returned %d, buffer size: %"NEWLIB_NANO_COMPAT_FORMAT, r, NEWLIB_NANO_COMPAT_CAST(sizeof(tx_buf)));
+            return ESP_FAIL;
+        }
+
+        fmt_len += r;
+
+        if (fmt_len >= sizeof(tx_buf)) {
+            ESP_LOGE(TAG, "Error in response generation"
+                          "(snprintf of extensions returned %d, desired response len: %d, buffer size: %"NEWLIB_NANO_COMPAT_FORMAT, r, fmt_len, NEWLIB_NANO_COMPAT_CAST(sizeof(tx_buf)));
+            return ESP_FAIL;
+        }
+    }
+#endif
+
     int r = snprintf(tx_buf + fmt_len, sizeof(tx_buf) - fmt_len, "\r\n");
     if (r <= 0) {
         ESP_LOGE(TAG, "Error in response generation"
@@ -230,6 +340,26 @@ sha_end:
         return ESP_FAIL;
     }
 
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    if (deflate_accepted) {
+        /* Compression state is only allocated once the first message needs it */
+        struct httpd_ws_deflate *d = calloc(1, sizeof(struct httpd_ws_deflate));
+        if (d == NULL || (d->tx_lock = xSemaphoreCreateMutex()) == NULL) {
+            ESP_LOGW(TAG, LOG_FMT("No memory for permessage-deflate state"));
+            free(d);
+            return ESP_ERR_NO_MEM;
+        }
+        d->codec.tx_window_bits = deflate.server_max_window_bits ? deflate.server_max_window_bits : HTTPD_WS_DEFLATE_WINDOW_BITS;
+        d->codec.rx_window_bits = deflate.client_max_window_bits ? deflate.client_max_window_bits : ESP_WS_DEFLATE_MAX_WINDOW_BITS;
+        d->codec.tx_no_context_takeover = deflate.server_no_context_takeover;
+        d->codec.rx_no_context_takeover = deflate.client_no_context_takeover;
+        d->codec.max_payload = HTTPD_WS_DEFLATE_MAX_PAYLOAD;
+        req_aux->sd->ws_deflate = d;
+        ESP_LOGD(TAG, LOG_FMT("permessage-deflate accepted (server window %d bits, client window %d bits)"),
+                 d->codec.tx_window_bits, d->codec.rx_window_bits);
+    }
+#endif
+
     /* Send off the response */
     if (httpd_send(req, tx_buf, fmt_len) < 0) {
         ESP_LOGW(TAG, LOG_FMT("Failed to send the response"));
@@ -271,6 +401,42 @@ static esp_err_t httpd_ws_unmask_payload(uint8_t *payload, size_t len, const uin
     return ESP_OK;
 }
 
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+/* Receives a whole compressed frame and inflates it into the session buffer */
+static esp_err_t httpd_ws_deflate_recv(httpd_req_t *req, struct httpd_ws_deflate *d, size_t len, bool fin)
+{
+    struct httpd_req_aux *aux = req->aux;
+
+    if (len > HTTPD_WS_DEFLATE_MAX_PAYLOAD) {
+        ESP_LOGW(TAG, LOG_FMT("Compressed WS frame too long"));
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t *compressed = malloc(len ? len : 1);
+    if (compressed == NULL) {
+        ESP_LOGW(TAG, LOG_FMT("No memory for compressed payload"));
+        return ESP_ERR_NO_MEM;
+    }
+    size_t offset = 0;
+    while (offset < len) {
+        int read_len = httpd_recv_with_opt(req, (char *)compressed + offset, len - offset, HTTPD_RECV_OPT_NONE);
+        if (read_len <= 0) {
+            ESP_LOGW(TAG, LOG_FMT("Failed to receive payload"));
+            free(compressed);
+            return ESP_FAIL;
+        }
+        offset += read_len;
+    }
+    if (len > 0) {
+        httpd_ws_unmask_payload(compressed, len, aux->mask_key);
+    }
+
+    esp_err_t ret = esp_ws_deflate_inflate(&d->codec, compressed, len, fin);
+    free(compressed);
+    return ret;
+}
+#endif /* CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE */
+
 esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *frame, size_t max_len)
 {
     esp_err_t ret = httpd_ws_check_req(req);
@@ -348,6 +514,16 @@ esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *frame, size_t
             ESP_LOGW(TAG, LOG_FMT("WS frame is not properly masked."));
             return ESP_ERR_INVALID_STATE;
         }
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+        /* The whole frame is inflated now, the caller only sees the decompressed length */
+        if (aux->ws_compressed) {
+            ret = httpd_ws_deflate_recv(req, aux->sd->ws_deflate, frame->len, aux->ws_final);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            frame->len = aux->sd->ws_deflate->codec.rx_len;
+        }
+#endif
     }
     /* We only accept the incoming packet length that is smaller than the max_len (or it will overflow the buffer!) */
     /* If max_len is 0, regard it OK for userspace to get frame len */
@@ -371,6 +547,19 @@ esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *frame, size_t
         return ESP_FAIL;
     }
 
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    if (aux->ws_compressed) {
+        esp_ws_deflate_t *d = &aux->sd->ws_deflate->codec;
+        if (d->rx_buf == NULL || frame->len != d->rx_len) {
+            ESP_LOGW(TAG, LOG_FMT("Inflated payload is not available"));
+            return ESP_ERR_INVALID_STATE;
+        }
+        memcpy(frame->payload, d->rx_buf, frame->len);
+        esp_ws_deflate_drop_rx_buf(d);
+        return ESP_OK;
+    }
+#endif
+
     size_t left_len = frame->len;
     size_t offset = 0;
 
@@ -408,6 +597,14 @@ esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t
         return ESP_ERR_INVALID_ARG;
     }
 
+    struct sock_db *sess = httpd_sess_get(hd, fd);
+    if (!sess) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const uint8_t *payload = frame->payload;
+    size_t payload_len = frame->len;
+
     /* Prepare Tx buffer - maximum length is 14, which includes 2 bytes header, 8 bytes length, 4 bytes mask key */
     uint8_t tx_len = 0;
     uint8_t header_buf[10] = {0 };
@@ -415,19 +612,43 @@ esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t
     header_buf[0] |= (!frame->fragmented) ? HTTPD_WS_FIN_BIT : (frame->final? HTTPD_WS_FIN_BIT: HTTPD_WS_CONTINUE);
     header_buf[0] |= frame->type; /* Type (opcode): 4 bits */
 
-    if (frame->len <= 125) {
-        header_buf[1] = frame->len & 0x7fU; /* Length for 7 bits */
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    uint8_t *compressed = NULL;
+    struct httpd_ws_deflate *d = sess->ws_deflate;
+    if (d) {
+        /* Frames may be sent from several tasks, the compressor state has to follow the order on the wire */
+        xSemaphoreTake(d->tx_lock, portMAX_DELAY);
+    }
+    if (d && ((frame->type == HTTPD_WS_TYPE_CONTINUE && d->codec.tx_in_msg) ||
+              ((frame->type == HTTPD_WS_TYPE_TEXT || frame->type == HTTPD_WS_TYPE_BINARY) &&
+               frame->len >= HTTPD_WS_DEFLATE_MIN_LEN))) {
+        esp_err_t ret = esp_ws_deflate_compress(&d->codec, frame->payload, frame->len,
+                                                (header_buf[0] & HTTPD_WS_FIN_BIT) != 0, &compressed, &payload_len);
+        if (ret != ESP_OK) {
+            xSemaphoreGive(d->tx_lock);
+            return ret;
+        }
+        payload = compressed;
+        /* RSV1 is only set on the first frame of a message, please refer to RFC7692 Section 6.1 */
+        if (frame->type != HTTPD_WS_TYPE_CONTINUE) {
+            header_buf[0] |= HTTPD_WS_RSV1_BIT;
+        }
+    }
+#endif
+
+    if (payload_len <= 125) {
+        header_buf[1] = payload_len & 0x7fU; /* Length for 7 bits */
         tx_len = 2;
-    } else if (frame->len > 125 && frame->len < UINT16_MAX) {
+    } else if (payload_len > 125 && payload_len < UINT16_MAX) {
         header_buf[1] = 126;                /* Length for 16 bits */
-        header_buf[2] = (frame->len >> 8U) & 0xffU;
-        header_buf[3] = frame->len & 0xffU;
+        header_buf[2] = (payload_len >> 8U) & 0xffU;
+        header_buf[3] = payload_len & 0xffU;
         tx_len = 4;
     } else {
         header_buf[1] = 127;                /* Length for 64 bits */
         uint8_t shift_idx = sizeof(uint64_t) - 1; /* Shift index starts at 7 */
-        uint64_t len64 = frame->len; /* Raise variable size to make sure we won't shift by more bits
-                                      * than the length has (to avoid undefined behaviour) */
+        uint64_t len64 = payload_len; /* Raise variable size to make sure we won't shift by more bits
+                                       * than the length has (to avoid undefined behaviour) */
         for (int8_t idx = 2; idx <= 9; idx++) {
             /* Now do shifting (be careful of endianness, i.e. when buffer index is 2, frame length shift index is 7) */
             header_buf[idx] = (len64 >> (shift_idx * 8)) & 0xffU;
@@ -439,26 +660,27 @@ esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t
     /* WebSocket server does not required to mask response payload, so leave the MASK bit as 0. */
     header_buf[1] &= (~HTTPD_WS_MASK_BIT);
 
-    struct sock_db *sess = httpd_sess_get(hd, fd);
-    if (!sess) {
-        return ESP_ERR_INVALID_ARG;
-    }
+    esp_err_t ret = ESP_OK;
 
     /* Send off header */
     if (sess->send_fn(hd, fd, (const char *)header_buf, tx_len, 0) < 0) {
         ESP_LOGW(TAG, LOG_FMT("Failed to send WS header"));
-        return ESP_FAIL;
-    }
-
-    /* Send off payload */
-    if(frame->len > 0 && frame->payload != NULL) {
-        if (sess->send_fn(hd, fd, (const char *)frame->payload, frame->len, 0) < 0) {
+        ret = ESP_FAIL;
+    } else if (payload_len > 0 && payload != NULL) {
+        /* Send off payload */
+        if (sess->send_fn(hd, fd, (const char *)payload, payload_len, 0) < 0) {
             ESP_LOGW(TAG, LOG_FMT("Failed to send WS payload"));
-            return ESP_FAIL;
+            ret = ESP_FAIL;
         }
     }
 
-    return ESP_OK;
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    free(compressed);
+    if (d) {
+        xSemaphoreGive(d->tx_lock);
+    }
+#endif
+    return ret;
 }
 
 esp_err_t httpd_ws_get_frame_type(httpd_req_t *req)
@@ -497,6 +719,17 @@ esp_err_t httpd_ws_get_frame_type(httpd_req_t *req)
     /* Decode the FIN flag and Opcode from the byte */
     aux->ws_final = (first_byte & HTTPD_WS_FIN_BIT) != 0;
     aux->ws_type = (first_byte & HTTPD_WS_OPCODE_BITS);
+#ifdef CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    /* Only the first frame of a compressed message carries RSV1, please refer to RFC7692 Section 6.1 */
+    aux->ws_compressed = false;
+    if (sd->ws_deflate) {
+        if (aux->ws_type == HTTPD_WS_TYPE_CONTINUE) {
+            aux->ws_compressed = sd->ws_deflate->codec.rx_in_msg;
+        } else if (aux->ws_type == HTTPD_WS_TYPE_TEXT || aux->ws_type == HTTPD_WS_TYPE_BINARY) {
+            aux->ws_compressed = (first_byte & HTTPD_WS_RSV1_BIT) != 0;
+        }
+    }
+#endif
 
     /* If userspace requests control frames, do not deal with the control frames */
     if (!sd->ws_control_frames) {
@@ -1,74 +1,175 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "esp_netif.h"
-#include "sys/queue.h"
 #include "esp_log.h"
 #include "esp_netif_private.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <assert.h>
+#include <stdatomic.h>
 #include <string.h>
 
 //
 // Purpose of this module is to provide list of esp-netif structures
 //  - this module has no dependency on a specific network stack (lwip)
 //
+// The list is published as an immutable array of handles which is replaced on every
+// add/remove, so that the lookups don't need any lock (read-copy-update):
+//  - readers announce themselves in the counter of the current epoch while they access the array
+//  - writers (serialized by the callers, typically in TCPIP context) publish the new array,
+//    then flip the epoch twice and block until the readers of the previous epoch leave
+//    (the last one to leave wakes the writer up)
+//  - the retired array is kept as a spare for the next removal, so that removing a netif
+//    never allocates and cannot fail
+//
 
 static const char *TAG = "esp_netif_objects";
 
-typedef struct slist_netifs_s slist_netifs_t;
-struct slist_netifs_s {
-    esp_netif_t *netif;
-    SLIST_ENTRY(slist_netifs_s) next;
-};
-
-SLIST_HEAD(slisthead, slist_netifs_s) s_head = { .slh_first = NULL, };
+typedef struct netif_list_s {
+    size_t capacity;
+    size_t count;
+    esp_netif_t *netifs[];
+} netif_list_t;
 
-static size_t s_esp_netif_counter = 0;
+static _Atomic(netif_list_t *) s_netif_list = NULL;
+static netif_list_t *s_spare_list = NULL;
+static atomic_uint s_epoch = 0;
+static atomic_uint s_readers[2] = { 0, 0 };
+static atomic_bool s_writer_waiting = false;
+static SemaphoreHandle_t s_grace_sem = NULL;
+static StaticSemaphore_t s_grace_sem_buffer;
 
 ESP_EVENT_DEFINE_BASE(IP_EVENT);
 
+//
+// Lock-free read side
+//
+static inline netif_list_t *netif_list_read_begin(unsigned *epoch)
+{
+    *epoch = atomic_load(&s_epoch) & 1;
+    atomic_fetch_add(&s_readers[*epoch], 1);
+    return atomic_load(&s_netif_list);
+}
+
+static inline void netif_list_read_end(unsigned epoch)
+{
+    if (atomic_fetch_sub(&s_readers[epoch], 1) == 1 && atomic_load(&s_writer_waiting)) {
+        xSemaphoreGive(s_grace_sem);
+    }
+}
+
+static void netif_list_wait_for_readers(unsigned epoch)
+{
+    // announce the writer before checking the readers, so that the last reader
+    // either sees the flag or is already accounted for
+    atomic_store(&s_writer_waiting, true);
+    while (atomic_load(&s_readers[epoch]) != 0) {
+        xSemaphoreTake(s_grace_sem, portMAX_DELAY);
+    }
+    atomic_store(&s_writer_waiting, false);
+    // drop a wake-up that raced with the check above
+    xSemaphoreTake(s_grace_sem, 0);
+}
+
+static void netif_list_publish(netif_list_t *list)
+{
+    netif_list_t *old = atomic_exchange(&s_netif_list, list);
+    // two epoch flips, as a reader could have sampled the epoch just before the first flip
+    for (int i = 0; i < 2; ++i) {
+        unsigned prev = atomic_fetch_add(&s_epoch, 1) & 1;
+        netif_list_wait_for_readers(prev);
+    }
+    // no reader can see the retired array anymore, keep the larger one as the spare
+    if (old != NULL && (s_spare_list == NULL || old->capacity > s_spare_list->capacity)) {
+        free(s_spare_list);
+        s_spare_list = old;
+    } else {
+        free(old);
+    }
+}
+
 //
 // List manipulation functions
 //
 esp_err_t esp_netif_add_to_list_unsafe(esp_netif_t *netif)
 {
-    struct slist_netifs_s *item = calloc(1, sizeof(struct slist_netifs_s));
+    netif_list_t *old = atomic_load(&s_netif_list);
+    size_t count = old ? old->count : 0;
     ESP_LOGV(TAG, "%s %p", __func__, netif);
-    if (item == NULL) {
-        return ESP_ERR_NO_MEM;
+    if (s_grace_sem == NULL) {
+        s_grace_sem = xSemaphoreCreateBinaryStatic(&s_grace_sem_buffer);
     }
-    item->netif = netif;
-
-    SLIST_INSERT_HEAD(&s_head, item, next);
-    ++s_esp_netif_counter;
-    ESP_LOGD(TAG, "%s netif added successfully (total netifs: %" PRIu32 ")", __func__, (uint32_t)s_esp_netif_counter);
+    netif_list_t *list = NULL;
+    if (s_spare_list != NULL && s_spare_list->capacity >= count + 1) {
+        list = s_spare_list;
+        s_spare_list = NULL;
+    } else {
+        list = malloc(sizeof(netif_list_t) + (count + 1) * sizeof(esp_netif_t *));
+        if (list == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        list->capacity = count + 1;
+    }
+    // the most recently added netif comes first
+    list->netifs[0] = netif;
+    if (count > 0) {
+        memcpy(&list->netifs[1], old->netifs, count * sizeof(esp_netif_t *));
+    }
+    list->count = count + 1;
+    // the retired array (capacity >= count) becomes the spare, which is all a removal needs
+    netif_list_publish(list);
+    ESP_LOGD(TAG, "%s netif added successfully (total netifs: %" PRIu32 ")", __func__, (uint32_t)list->count);
     return ESP_OK;
 }
 
 
 esp_err_t esp_netif_remove_from_list_unsafe(esp_netif_t *netif)
 {
-    struct slist_netifs_s *item;
+    netif_list_t *old = atomic_load(&s_netif_list);
+    netif_list_t *list = NULL;
+    size_t count = old ? old->count : 0;
+    size_t i;
     ESP_LOGV(TAG, "%s %p", __func__, netif);
 
-    SLIST_FOREACH(item, &s_head, next) {
-        if (item->netif == netif) {
-            SLIST_REMOVE(&s_head, item, slist_netifs_s, next);
-            assert(s_esp_netif_counter > 0);
-            --s_esp_netif_counter;
-            ESP_LOGD(TAG, "%s netif successfully removed (total netifs: %" PRIu32 ")", __func__, (uint32_t)s_esp_netif_counter);
-            free(item);
-            return ESP_OK;
+    for (i = 0; i < count; ++i) {
+        if (old->netifs[i] == netif) {
+            break;
         }
     }
-    return ESP_ERR_NOT_FOUND;
+    if (i == count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (count > 1) {
+        // every publish leaves a spare of at least the retired count, i.e. >= count - 1 here
+        assert(s_spare_list != NULL && s_spare_list->capacity >= count - 1);
+        list = s_spare_list;
+        s_spare_list = NULL;
+        memcpy(list->netifs, old->netifs, i * sizeof(esp_netif_t *));
+        memcpy(&list->netifs[i], &old->netifs[i + 1], (count - i - 1) * sizeof(esp_netif_t *));
+        list->count = count - 1;
+    }
+    netif_list_publish(list);
+    if (count == 1) {
+        // the last netif is gone, don't keep the spare around
+        free(s_spare_list);
+        s_spare_list = NULL;
+    }
+    ESP_LOGD(TAG, "%s netif successfully removed (total netifs: %" PRIu32 ")", __func__, (uint32_t)(count - 1));
+    return ESP_OK;
 }
 
 size_t esp_netif_get_nr_of_ifs(void)
 {
-    return s_esp_netif_counter;
+    unsigned epoch;
+    netif_list_t *list = netif_list_read_begin(&epoch);
+    size_t count = list ? list->count : 0;
+    netif_list_read_end(epoch);
+    return count;
 }
 
 // This API is inherently unsafe
@@ -81,42 +182,56 @@ esp_netif_t* esp_netif_next(esp_netif_t* netif)
 esp_netif_t* esp_netif_next_unsafe(esp_netif_t* netif)
 {
     ESP_LOGV(TAG, "%s %p", __func__, netif);
-    struct slist_netifs_s *item;
-    // Getting the first netif if argument is NULL
-    if (netif == NULL) {
-        item = SLIST_FIRST(&s_head);
-        return (item == NULL) ? NULL : item->netif;
-    }
-    // otherwise the next one (after the supplied netif)
-    SLIST_FOREACH(item, &s_head, next) {
-        if (item->netif == netif) {
-            item = SLIST_NEXT(item, next);
-            return (item == NULL) ? NULL : item->netif;
+    esp_netif_t *next = NULL;
+    unsigned epoch;
+    netif_list_t *list = netif_list_read_begin(&epoch);
+    if (list != NULL) {
+        // Getting the first netif if argument is NULL
+        if (netif == NULL) {
+            next = list->netifs[0];
+        } else {
+            // otherwise the next one (after the supplied netif)
+            for (size_t i = 0; i + 1 < list->count; ++i) {
+                if (list->netifs[i] == netif) {
+                    next = list->netifs[i + 1];
+                    break;
+                }
+            }
         }
     }
-    return NULL;
+    netif_list_read_end(epoch);
+    return next;
 }
 
 bool esp_netif_is_netif_listed(esp_netif_t *esp_netif)
 {
-    struct slist_netifs_s *item;
-    SLIST_FOREACH(item, &s_head, next) {
-        if (item->netif == esp_netif) {
-            return true;
+    bool listed = false;
+    unsigned epoch;
+    netif_list_t *list = netif_list_read_begin(&epoch);
+    for (size_t i = 0; list != NULL && i < list->count; ++i) {
+        if (list->netifs[i] == esp_netif) {
+            listed = true;
+            break;
         }
     }
-    return false;
+    netif_list_read_end(epoch);
+    return listed;
 }
 
 esp_netif_t *esp_netif_get_handle_from_ifkey_unsafe(const char *if_key)
 {
-    struct slist_netifs_s *item;
-
-    SLIST_FOREACH(item, &s_head, next) {
-        esp_netif_t *esp_netif = item->netif;
-        if (strcmp(if_key, esp_netif_get_ifkey(esp_netif)) == 0) {
-            return esp_netif;
+    esp_netif_t *found = NULL;
+    unsigned epoch;
+    netif_list_t *list = netif_list_read_begin(&epoch);
+    // listed netifs are not destroyed until the readers leave, so their keys are safe to access,
+    // but a netif could be listed before its key is configured
+    for (size_t i = 0; list != NULL && i < list->count; ++i) {
+        const char *key = esp_netif_get_ifkey(list->netifs[i]);
+        if (key != NULL && strcmp(if_key, key) == 0) {
+            found = list->netifs[i];
+            break;
         }
     }
-    return NULL;
+    netif_list_read_end(epoch);
+    return found;
 }
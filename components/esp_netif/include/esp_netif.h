@@ -165,6 +165,38 @@ esp_err_t esp_netif_tx_rx_event_enable(esp_netif_t *esp_netif);
  */
 esp_err_t esp_netif_tx_rx_event_disable(esp_netif_t *esp_netif);
 
+/**
+ * @brief Gets the traffic statistics of a network interface
+ *
+ * The counters are updated in esp_netif_receive() and esp_netif_transmit() without locking,
+ * and read here without locking either, so this function can be called from any task,
+ * e.g. periodically to compute the throughput of the interface.
+ *
+ * @param[in]  esp_netif Handle to esp-netif instance
+ * @param[out] stats Traffic statistics
+ *
+ * @return
+ *         - ESP_OK: Success
+ *         - ESP_ERR_ESP_NETIF_INVALID_PARAMS: Invalid parameters
+ *         - ESP_ERR_NOT_SUPPORTED: Statistics not configured (CONFIG_ESP_NETIF_TRAFFIC_STATS)
+ */
+esp_err_t esp_netif_get_stats(esp_netif_t *esp_netif, esp_netif_stats_t *stats);
+
+/**
+ * @brief Clears the traffic statistics of a network interface
+ *
+ * @note Updates from a concurrent esp_netif_receive() or esp_netif_transmit() may be counted
+ * before or after clearing
+ *
+ * @param[in]  esp_netif Handle to esp-netif instance
+ *
+ * @return
+ *         - ESP_OK: Success
+ *         - ESP_ERR_ESP_NETIF_INVALID_PARAMS: Invalid parameters
+ *         - ESP_ERR_NOT_SUPPORTED: Statistics not configured (CONFIG_ESP_NETIF_TRAFFIC_STATS)
+ */
+esp_err_t esp_netif_reset_stats(esp_netif_t *esp_netif);
+
 /**
  * @}
  */
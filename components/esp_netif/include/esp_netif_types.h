@@ -178,6 +178,20 @@ typedef struct {
 } ip_event_tx_rx_t;
 #endif
 
+/**
+ * @brief Traffic statistics of a network interface, see esp_netif_get_stats()
+ *
+ * @note The counters are 32-bit and wrap around, compute the differences of two readings with unsigned arithmetic
+ */
+typedef struct {
+    uint32_t rx_packets;    /*!< Number of packets passed to the TCP/IP stack by esp_netif_receive() */
+    uint32_t rx_bytes;      /*!< Number of bytes passed to the TCP/IP stack by esp_netif_receive() */
+    uint32_t rx_dropped;    /*!< Number of received packets rejected by the TCP/IP stack (requires CONFIG_ESP_NETIF_RECEIVE_REPORT_ERRORS) */
+    uint32_t tx_packets;    /*!< Number of packets accepted by the IO driver in esp_netif_transmit() */
+    uint32_t tx_bytes;      /*!< Number of bytes accepted by the IO driver in esp_netif_transmit() */
+    uint32_t tx_dropped;    /*!< Number of packets the IO driver failed to transmit */
+} esp_netif_stats_t;
+
 typedef enum esp_netif_flags {
     ESP_NETIF_DHCP_CLIENT = 1 << 0,
     ESP_NETIF_DHCP_SERVER = 1 << 1,
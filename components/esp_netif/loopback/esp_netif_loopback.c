@@ -187,8 +187,6 @@ esp_netif_t *esp_netif_new(const esp_netif_config_t *esp_netif_config)
     }
     esp_netif->ip_info_old = ip_info;
 
-    esp_netif_add_to_list_unsafe(esp_netif);
-
     // Configure the created object with provided configuration
     esp_err_t ret =  esp_netif_init_configuration(esp_netif, esp_netif_config);
     if (ret != ESP_OK) {
@@ -197,6 +195,9 @@ esp_netif_t *esp_netif_new(const esp_netif_config_t *esp_netif_config)
         return NULL;
     }
 
+    // list the netif once configured, as the lookups may access it right away
+    esp_netif_add_to_list_unsafe(esp_netif);
+
     return esp_netif;
 }
 
@@ -284,6 +285,16 @@ esp_err_t esp_netif_receive(esp_netif_t *esp_netif, void *buffer, size_t len, vo
     return ESP_OK;
 }
 
+esp_err_t esp_netif_get_stats(esp_netif_t *esp_netif, esp_netif_stats_t *stats)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_netif_reset_stats(esp_netif_t *esp_netif)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 esp_err_t esp_netif_dhcpc_stop(esp_netif_t *esp_netif)
 {
     return ESP_ERR_NOT_SUPPORTED;
@@ -1355,6 +1355,54 @@ esp_err_t esp_netif_tx_rx_event_disable(esp_netif_t *esp_netif)
 #endif
 }
 
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+static inline void esp_netif_count_tx(esp_netif_t *esp_netif, size_t len, esp_err_t ret)
+{
+    if (likely(ret == ESP_OK)) {
+        atomic_fetch_add_explicit(&esp_netif->stats.tx_packets, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&esp_netif->stats.tx_bytes, len, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&esp_netif->stats.tx_dropped, 1, memory_order_relaxed);
+    }
+}
+#endif
+
+esp_err_t esp_netif_get_stats(esp_netif_t *esp_netif, esp_netif_stats_t *stats)
+{
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    if (esp_netif == NULL || stats == NULL) {
+        return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    }
+    stats->rx_packets = atomic_load_explicit(&esp_netif->stats.rx_packets, memory_order_relaxed);
+    stats->rx_bytes = atomic_load_explicit(&esp_netif->stats.rx_bytes, memory_order_relaxed);
+    stats->rx_dropped = atomic_load_explicit(&esp_netif->stats.rx_dropped, memory_order_relaxed);
+    stats->tx_packets = atomic_load_explicit(&esp_netif->stats.tx_packets, memory_order_relaxed);
+    stats->tx_bytes = atomic_load_explicit(&esp_netif->stats.tx_bytes, memory_order_relaxed);
+    stats->tx_dropped = atomic_load_explicit(&esp_netif->stats.tx_dropped, memory_order_relaxed);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_netif_reset_stats(esp_netif_t *esp_netif)
+{
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    if (esp_netif == NULL) {
+        return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    }
+    atomic_store_explicit(&esp_netif->stats.rx_packets, 0, memory_order_relaxed);
+    atomic_store_explicit(&esp_netif->stats.rx_bytes, 0, memory_order_relaxed);
+    atomic_store_explicit(&esp_netif->stats.rx_dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&esp_netif->stats.tx_packets, 0, memory_order_relaxed);
+    atomic_store_explicit(&esp_netif->stats.tx_bytes, 0, memory_order_relaxed);
+    atomic_store_explicit(&esp_netif->stats.tx_dropped, 0, memory_order_relaxed);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 esp_err_t esp_netif_transmit(esp_netif_t *esp_netif, void* data, size_t len)
 {
 #ifdef CONFIG_ESP_NETIF_REPORT_DATA_TRAFFIC
@@ -1367,7 +1415,13 @@ esp_err_t esp_netif_transmit(esp_netif_t *esp_netif, void* data, size_t len)
         esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
     }
 #endif
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    esp_err_t ret = (esp_netif->driver_transmit)(esp_netif->driver_handle, data, len);
+    esp_netif_count_tx(esp_netif, len, ret);
+    return ret;
+#else
     return (esp_netif->driver_transmit)(esp_netif->driver_handle, data, len);
+#endif
 }
 
 esp_err_t esp_netif_transmit_wrap(esp_netif_t *esp_netif, void *data, size_t len, void *pbuf)
@@ -1382,7 +1436,13 @@ esp_err_t esp_netif_transmit_wrap(esp_netif_t *esp_netif, void *data, size_t len
         esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
     }
 #endif
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    esp_err_t ret = (esp_netif->driver_transmit_wrap)(esp_netif->driver_handle, data, len, pbuf);
+    esp_netif_count_tx(esp_netif, len, ret);
+    return ret;
+#else
     return (esp_netif->driver_transmit_wrap)(esp_netif->driver_handle, data, len, pbuf);
+#endif
 }
 
 esp_err_t esp_netif_receive(esp_netif_t *esp_netif, void *buffer, size_t len, void *eb)
@@ -1397,8 +1457,20 @@ esp_err_t esp_netif_receive(esp_netif_t *esp_netif, void *buffer, size_t len, vo
         esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
     }
 #endif
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    atomic_fetch_add_explicit(&esp_netif->stats.rx_packets, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&esp_netif->stats.rx_bytes, len, memory_order_relaxed);
+#endif
 #ifdef CONFIG_ESP_NETIF_RECEIVE_REPORT_ERRORS
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    esp_err_t ret = esp_netif->lwip_input_fn(esp_netif->netif_handle, buffer, len, eb);
+    if (unlikely(ret != ESP_OK)) {
+        atomic_fetch_add_explicit(&esp_netif->stats.rx_dropped, 1, memory_order_relaxed);
+    }
+    return ret;
+#else
     return esp_netif->lwip_input_fn(esp_netif->netif_handle, buffer, len, eb);
+#endif
 #else
     esp_netif->lwip_input_fn(esp_netif->netif_handle, buffer, len, eb);
     return ESP_OK;
@@ -13,6 +13,9 @@
 #ifdef CONFIG_LWIP_DHCPS
 #include "dhcpserver/dhcpserver.h"
 #endif
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+#include <stdatomic.h>
+#endif
 
 struct esp_netif_api_msg_s;
 
@@ -66,6 +69,20 @@ typedef struct netif_related_data {
     enum netif_types netif_type;
 } netif_related_data_t;
 
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+/**
+ * @brief Traffic counters, each updated by a single atomic add on the data path
+ */
+typedef struct esp_netif_stats_counters {
+    atomic_uint_least32_t rx_packets;
+    atomic_uint_least32_t rx_bytes;
+    atomic_uint_least32_t rx_dropped;
+    atomic_uint_least32_t tx_packets;
+    atomic_uint_least32_t tx_bytes;
+    atomic_uint_least32_t tx_dropped;
+} esp_netif_stats_counters_t;
+#endif
+
 /**
  * @brief Main esp-netif container with interface related information
  */
@@ -102,6 +119,9 @@ struct esp_netif_obj {
 #ifdef CONFIG_ESP_NETIF_REPORT_DATA_TRAFFIC
     bool tx_rx_events_enabled;
 #endif
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    esp_netif_stats_counters_t stats;
+#endif
 
     // misc flags, types, keys, priority
     esp_netif_flags_t flags;
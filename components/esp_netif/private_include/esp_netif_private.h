@@ -83,8 +83,9 @@ bool esp_netif_is_valid_static_ip(esp_netif_ip_info_t *ip_info);
 
 /**
  * @brief Adds created interface to the list of netifs.
- * This function doesn't lock the list, so you need to call esp_netif_list_lock/unlock
- * manually before and after the call.
+ * This function doesn't lock the list, so the calls modifying the list have to be serialized
+ * (e.g. executed in TCPIP context). Lookups may run concurrently, the function waits
+ * until no lookup uses the previous version of the list.
  *
  * @param[in]  esp_netif Handle to esp-netif instance
  *
@@ -96,8 +97,9 @@ esp_err_t esp_netif_add_to_list_unsafe(esp_netif_t* netif);
 
 /**
  * @brief Removes interface to be destroyed from the list of netifs
- * This function doesn't lock the list, so you need to call esp_netif_list_lock/unlock
- * manually before and after the call.
+ * This function doesn't lock the list, so the calls modifying the list have to be serialized
+ * (e.g. executed in TCPIP context). Lookups may run concurrently, the function returns
+ * once no lookup can access the removed interface, so it's safe to be freed.
  *
  * @param[in]  esp_netif Handle to esp-netif instance
  *
@@ -109,6 +111,7 @@ esp_err_t esp_netif_remove_from_list_unsafe(esp_netif_t* netif);
 
 /**
  * @brief Iterates over list of registered interfaces to check if supplied netif is listed
+ * This doesn't lock the list, it's safe to call concurrently with adding or removing interfaces
  *
  * @param esp_netif network interface to check
  *
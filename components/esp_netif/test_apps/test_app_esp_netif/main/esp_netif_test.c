@@ -17,9 +17,13 @@
 #include "test_utils.h"
 #include "memory_checks.h"
 #include "lwip/netif.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 
 //// This is a private esp-netif API, but include here to test it
 bool esp_netif_is_netif_listed(esp_netif_t *esp_netif);
+esp_netif_t *esp_netif_get_handle_from_ifkey_unsafe(const char *if_key);
 
 void create_delete_multiple_netifs(void)
 {
@@ -70,3 +74,71 @@ void get_from_if_key(void)
     TEST_ASSERT_EQUAL(NULL, esp_netif_get_handle_from_ifkey("WIFI_STA_DEF"));
 
 }
+
+typedef struct {
+    esp_netif_t *permanent;
+    volatile bool stop;
+    int lookups;
+    int failures;
+    SemaphoreHandle_t done;
+} list_reader_ctx_t;
+
+static void list_reader_task(void *arg)
+{
+    list_reader_ctx_t *ctx = arg;
+    while (!ctx->stop) {
+        // the permanent netif has to be visible whatever happens to the others
+        if (!esp_netif_is_netif_listed(ctx->permanent) ||
+                esp_netif_get_handle_from_ifkey_unsafe("perm") != ctx->permanent) {
+            ctx->failures++;
+        }
+        int listed = 0;
+        for (esp_netif_t *netif = esp_netif_next_unsafe(NULL); netif != NULL && listed <= 16; netif = esp_netif_next_unsafe(netif)) {
+            listed++;
+        }
+        if (listed > 16 || esp_netif_get_nr_of_ifs() == 0) {
+            ctx->failures++;
+        }
+        ctx->lookups++;
+        taskYIELD();
+    }
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+void lookup_netifs_while_modified(void)
+{
+    const char* if_keys[] = { "if1", "if2", "if3", "if4", "if5", "if6", "if7", "if8" };
+    const int nr_of_netifs = sizeof(if_keys)/sizeof(char*);
+    esp_netif_t *netifs[nr_of_netifs];
+    esp_netif_inherent_config_t perm_config = { .if_key = "perm"};
+    esp_netif_config_t perm_cfg = { .base = &perm_config, .stack = ESP_NETIF_NETSTACK_DEFAULT_WIFI_STA };
+    list_reader_ctx_t ctx = { .done = xSemaphoreCreateBinary() };
+    TEST_ASSERT_NOT_NULL(ctx.done);
+    ctx.permanent = esp_netif_new(&perm_cfg);
+    TEST_ASSERT_NOT_NULL(ctx.permanent);
+
+    // lookups run without any lock in another task, while the list is being modified
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(list_reader_task, "list_reader", 4096, &ctx, 5, NULL));
+    for (int round = 0; round < 10; ++round) {
+        for (int i=0; i<nr_of_netifs; ++i) {
+            esp_netif_inherent_config_t base_netif_config = { .if_key = if_keys[i]};
+            esp_netif_config_t cfg = { .base = &base_netif_config, .stack = ESP_NETIF_NETSTACK_DEFAULT_WIFI_STA };
+            netifs[i] = esp_netif_new(&cfg);
+            TEST_ASSERT_NOT_NULL(netifs[i]);
+        }
+        for (int i=0; i<nr_of_netifs; ++i) {
+            esp_netif_destroy(netifs[i]);
+            TEST_ASSERT_FALSE(esp_netif_is_netif_listed(netifs[i]));
+        }
+    }
+    ctx.stop = true;
+    TEST_ASSERT_TRUE(xSemaphoreTake(ctx.done, pdMS_TO_TICKS(1000)));
+    vSemaphoreDelete(ctx.done);
+    esp_netif_destroy(ctx.permanent);
+    TEST_ASSERT_GREATER_THAN(0, ctx.lookups);
+    TEST_ASSERT_EQUAL(0, ctx.failures);
+    TEST_ASSERT_EQUAL(0, esp_netif_get_nr_of_ifs());
+    // let the idle task free the reader task
+    vTaskDelay(pdMS_TO_TICKS(10));
+}
@@ -12,3 +12,4 @@
 // List of tests that are common for both configurations
 void create_delete_multiple_netifs(void);
 void get_from_if_key(void);
+void lookup_netifs_while_modified(void);
@@ -35,10 +35,16 @@ TEST(esp_netif, get_from_if_key)
     get_from_if_key();
 }
 
+TEST(esp_netif, lookup_netifs_while_modified)
+{
+    lookup_netifs_while_modified();
+}
+
 TEST_GROUP_RUNNER(esp_netif)
 {
     RUN_TEST_CASE(esp_netif, create_delete_multiple_netifs)
     RUN_TEST_CASE(esp_netif, get_from_if_key)
+    RUN_TEST_CASE(esp_netif, lookup_netifs_while_modified)
 }
 
 void app_main(void)
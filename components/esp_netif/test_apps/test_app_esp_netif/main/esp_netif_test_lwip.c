@@ -103,6 +103,11 @@ TEST(esp_netif, create_delete_multiple_netifs)
     create_delete_multiple_netifs();
 }
 
+TEST(esp_netif, lookup_netifs_while_modified)
+{
+    lookup_netifs_while_modified();
+}
+
 static bool desc_matches_with(esp_netif_t *netif, void *ctx)
 {
     return strcmp(ctx, esp_netif_get_desc(netif)) == 0;
@@ -504,6 +509,45 @@ TEST(esp_netif, route_priority)
     }
 }
 
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+static esp_err_t failing_transmit(void* hd, void *buf, size_t length)
+{
+    // fails the packets of odd length
+    return (length & 1) ? ESP_FAIL : ESP_OK;
+}
+
+TEST(esp_netif, traffic_stats)
+{
+    uint8_t data[64] = { 0 };
+    esp_netif_stats_t stats;
+    esp_netif_driver_ifconfig_t driver_config = { .handle =  (void*)1, .transmit = failing_transmit };
+    esp_netif_inherent_config_t base_netif_config = { .if_key = "stats" };
+    esp_netif_config_t cfg = {  .base = &base_netif_config,
+                                .stack = ESP_NETIF_NETSTACK_DEFAULT_WIFI_STA,
+                                .driver = &driver_config };
+    esp_netif_t *esp_netif = esp_netif_new(&cfg);
+    TEST_ASSERT_NOT_NULL(esp_netif);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_ESP_NETIF_INVALID_PARAMS, esp_netif_get_stats(NULL, &stats));
+    TEST_ESP_OK(esp_netif_get_stats(esp_netif, &stats));
+    TEST_ASSERT_EQUAL(0, stats.tx_packets + stats.tx_bytes + stats.tx_dropped);
+
+    TEST_ESP_OK(esp_netif_transmit(esp_netif, data, 64));
+    TEST_ESP_OK(esp_netif_transmit(esp_netif, data, 32));
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, esp_netif_transmit(esp_netif, data, 33));
+    TEST_ESP_OK(esp_netif_get_stats(esp_netif, &stats));
+    TEST_ASSERT_EQUAL(2, stats.tx_packets);
+    TEST_ASSERT_EQUAL(96, stats.tx_bytes);
+    TEST_ASSERT_EQUAL(1, stats.tx_dropped);
+    TEST_ASSERT_EQUAL(0, stats.rx_packets);
+
+    TEST_ESP_OK(esp_netif_reset_stats(esp_netif));
+    TEST_ESP_OK(esp_netif_get_stats(esp_netif, &stats));
+    TEST_ASSERT_EQUAL(0, stats.tx_packets + stats.tx_bytes + stats.tx_dropped);
+    esp_netif_destroy(esp_netif);
+}
+#endif // CONFIG_ESP_NETIF_TRAFFIC_STATS
+
 // to probe DNS server info directly in LWIP
 const ip_addr_t * dns_getserver(u8_t numdns);
 
@@ -592,6 +636,10 @@ TEST_GROUP_RUNNER(esp_netif)
     RUN_TEST_CASE(esp_netif, get_from_if_key)
     RUN_TEST_CASE(esp_netif, create_delete_multiple_netifs)
     RUN_TEST_CASE(esp_netif, find_netifs)
+    RUN_TEST_CASE(esp_netif, lookup_netifs_while_modified)
+#ifdef CONFIG_ESP_NETIF_TRAFFIC_STATS
+    RUN_TEST_CASE(esp_netif, traffic_stats)
+#endif
 #ifdef CONFIG_ESP_WIFI_ENABLED
     RUN_TEST_CASE(esp_netif, wifi_netif_api_null_deref)
     RUN_TEST_CASE(esp_netif, create_custom_wifi_interfaces)
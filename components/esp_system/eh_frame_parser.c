@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -138,8 +138,32 @@ typedef struct {
     uint32_t location;
     /* Index of the registers offset to use (1 for saved offset, 0 else). */
     uint8_t offset_idx;
+    /* Unsupported opcode met while executing the instructions, DW_CFA_NOP if none. */
+    uint8_t unsupported_opcode;
 } dwarf_regs;
 
+/**
+ * @brief Decoded .eh_frame_hdr section, i.e. the table used to find the FDE of a given PC.
+ */
+typedef struct {
+    const table_entry* sorted_table; /*!< Sorted array of table_entry. */
+    uint32_t fde_count;              /*!< Number of entries in the sorted table. */
+    uint32_t table_enc;              /*!< Encoding of the sorted table entries. */
+} eh_frame_table;
+
+/**
+ * @brief Context shared by all the steps of a backtrace.
+ * Consecutive frames are very often described by the same CIE, thus the DWARF
+ * registers it defines are kept here to not decode and execute it again at each step.
+ */
+typedef struct {
+    uint32_t stack_low;     /*!< Lowest address registers can be restored from. */
+    uint32_t stack_high;    /*!< Address following the highest address registers can be restored from. */
+    const uint8_t* cie;     /*!< CIE the fields below were computed from, NULL if none. */
+    uint32_t cie_ra_reg;    /*!< Index of the DWARF register containing the return address. */
+    uint32_t cie_regs_offset[EXECUTION_FRAME_MAX_REGS]; /*!< DWARF registers after executing the CIE instructions. */
+} dwarf_unwind_ctx;
+
 /**
  * @brief DWARF's register state.
  * When a DWARF register is set to ESP_EH_FRAME_REG_SAME, the CPU register corresponding to this
@@ -569,9 +593,8 @@ static inline uint32_t esp_eh_frame_execute_opcode_0(const uint32_t opcode, cons
         ESP_EH_FRAME_CFA(state) = ESP_EH_FRAME_SET_CFA_OFF(ESP_EH_FRAME_CFA(state), operand1);
         break;
     default:
-        panic_print_str("\r\nUnsupported DWARF opcode 0: 0x");
-        panic_print_hex(opcode);
-        panic_print_str("\r\n");
+        /* Let the caller report it, unwinding may happen where nothing can be printed. */
+        state->unsupported_opcode = opcode;
         used_operands = ESP_EH_FRAME_UNSUPPORTED_OPCODE;
         break;
     }
@@ -724,14 +747,16 @@ static uint32_t esp_eh_frame_initialize_state(const uint8_t* cie, ExecutionFrame
  *
  * @param fde Pointer to the Frame Description Entry for the current program counter (defined by frame's MEPC register)
  * @param frame Snapshot of the CPU registers when the CPU stopped its normal execution.
- * @param state DWARF VM registers.
+ * @param state DWARF VM registers. They don't need to be initialized.
+ * @param ctx Context of the backtrace, shared by all the steps.
  *
  * @return Return Address of the current context. Frame has been restored to the previous context
  * (before calling the function program counter is currently going throught).
  */
 static uint32_t esp_eh_frame_restore_caller_state(const uint32_t* fde,
                                                   ExecutionFrame* frame,
-                                                  dwarf_regs* state)
+                                                  dwarf_regs* state,
+                                                  dwarf_unwind_ctx* ctx)
 {
     /* Length of the whole Frame Description Entry (FDE), excluding this field. */
     const uint32_t length = fde[ESP_FDE_LENGTH_IDX];
@@ -758,8 +783,25 @@ static uint32_t esp_eh_frame_restore_caller_state(const uint32_t* fde,
     /* Augmentation not supported. */
     assert(augmentation == 0);
 
-    /* Initialize the DWARF state by executing the CIE's instructions. */
-    const uint32_t ra_reg = esp_eh_frame_initialize_state(cie, frame, state);
+    /* Initialize the DWARF state by executing the CIE's instructions, unless the
+     * previous step already did it for the same CIE. */
+    uint32_t ra_reg = 0;
+    if (cie == ctx->cie) {
+        ra_reg = ctx->cie_ra_reg;
+        memcpy(state->regs_offset[0], ctx->cie_regs_offset, sizeof(ctx->cie_regs_offset));
+        state->offset_idx = 0;
+        state->unsupported_opcode = DW_CFA_NOP;
+    } else {
+        memset(state, 0, sizeof(dwarf_regs));
+        ra_reg = esp_eh_frame_initialize_state(cie, frame, state);
+        /* The resulting registers don't depend on the frame as long as the CIE doesn't
+         * advance the location, which is always the case in practice. */
+        if (state->location == 0 && state->offset_idx == 0 && state->unsupported_opcode == DW_CFA_NOP) {
+            ctx->cie = cie;
+            ctx->cie_ra_reg = ra_reg;
+            memcpy(ctx->cie_regs_offset, state->regs_offset[0], sizeof(ctx->cie_regs_offset));
+        }
+    }
     state->location = initial_location;
 
     /**
@@ -779,6 +821,19 @@ static uint32_t esp_eh_frame_restore_caller_state(const uint32_t* fde,
     const uint32_t cfa_off = ESP_EH_FRAME_GET_CFA_OFF(cfa_val);
     const uint32_t cfa_addr = EXECUTION_FRAME_REG(frame, cfa_reg) + cfa_off;
 
+    /* Make sure all the registers to restore are on the stack before modifying the frame.
+     * If one is not, the frame is corrupted or was interrupted before saving it entirely. */
+    for (uint32_t i = 0; i < DIM(state->regs_offset[0]); i++) {
+        uint32_t value_addr = state->regs_offset[state->offset_idx][i];
+        if (i != ESP_ESH_FRAME_CFA_IDX && value_addr != ESP_EH_FRAME_REG_SAME) {
+            value_addr = cfa_addr - ESP_EH_FRAME_GET_REG_OFFSET(value_addr) * sizeof(uint32_t);
+            if (value_addr < ctx->stack_low || value_addr > ctx->stack_high - sizeof(uint32_t) ||
+                (value_addr % sizeof(uint32_t)) != 0) {
+                return EXECUTION_FRAME_PC(*frame);
+            }
+        }
+    }
+
     /* Restore the registers that need to be restored. */
     for (uint32_t i = 0; i < DIM(state->regs_offset[0]); i++) {
         uint32_t value_addr = state->regs_offset[state->offset_idx][i];
@@ -838,6 +893,71 @@ static bool esp_eh_frame_missing_info(const uint32_t* fde, uint32_t pc)
     return (initial_location + range_length) <= pc;
 }
 
+/**
+ * @brief Decode the .eh_frame_hdr section header.
+ *
+ * @param table Structure filled with the sorted table information.
+ *
+ * @return true if the header is supported, false else.
+ */
+static bool esp_eh_frame_get_table(eh_frame_table* table)
+{
+    uint32_t size = 0;
+    uint8_t* enc_values = NULL;
+
+    /* Start parsing the .eh_frame_hdr section. */
+    fde_header* header = (fde_header*) EH_FRAME_HDR_ADDR;
+    if (header->version != 1) {
+        return false;
+    }
+
+    /* Make enc_values point to the end of the structure, where the encoded
+     * values start. */
+    enc_values = (uint8_t*)(header + 1);
+
+    /* Retrieve the encoded value eh_frame_ptr. Get the size of the data also. */
+    const uint32_t eh_frame_ptr = esp_eh_frame_get_encoded(enc_values, header->eh_frame_ptr_enc, &size);
+    assert(eh_frame_ptr == (uint32_t) EH_FRAME_ADDR);
+    (void) eh_frame_ptr;
+    enc_values += size;
+
+    /* Same for the number of entries in the sorted table. */
+    table->fde_count = esp_eh_frame_get_encoded(enc_values, header->fde_count_enc, &size);
+    enc_values += size;
+
+    /* enc_values points now at the beginning of the sorted table. */
+    /* Only support 4-byte entries. */
+    table->table_enc = header->table_enc;
+    if (((table->table_enc >> 4) != 0x3) && ((table->table_enc >> 4) != 0xB)) {
+        return false;
+    }
+
+    table->sorted_table = (const table_entry*) enc_values;
+    return true;
+}
+
+/**
+ * @brief Get the FDE describing the function the given PC is part of.
+ *
+ * @param table Decoded .eh_frame_hdr section.
+ * @param pc Program counter to look for.
+ *
+ * @return Absolute address of the FDE, NULL if the DWARF information are missing for this PC.
+ */
+static const uint32_t* esp_eh_frame_find_fde(const eh_frame_table* table, uint32_t pc)
+{
+    const table_entry* from_fun = esp_eh_frame_find_entry(table->sorted_table, table->fde_count,
+                                                          table->table_enc, pc);
+
+    /* Get absolute address of FDE entry describing the function where PC left of. */
+    uint32_t* fde = NULL;
+    if (from_fun != NULL) {
+        fde = esp_eh_frame_decode_address(&from_fun->fde_addr, table->table_enc);
+    }
+
+    return esp_eh_frame_missing_info(fde, pc) ? NULL : fde;
+}
+
 /**
  * @brief When one step of the backtrace is generated, output it to the serial.
  * This function can be overriden as it is defined as weak.
@@ -863,34 +983,19 @@ void esp_eh_frame_print_backtrace(const void *frame_or)
     assert(frame_or != NULL);
 
     static dwarf_regs state = { 0 };
+    static dwarf_unwind_ctx ctx = { 0 };
     ExecutionFrame frame = *((ExecutionFrame*) frame_or);
-    uint32_t size = 0;
-    uint8_t* enc_values = NULL;
+    eh_frame_table table = { 0 };
     bool end_of_backtrace = false;
 
-    /* Start parsing the .eh_frame_hdr section. */
-    fde_header* header = (fde_header*) EH_FRAME_HDR_ADDR;
-    assert(header->version == 1);
-
-    /* Make enc_values point to the end of the structure, where the encoded
-     * values start. */
-    enc_values = (uint8_t*)(header + 1);
-
-    /* Retrieve the encoded value eh_frame_ptr. Get the size of the data also. */
-    const uint32_t eh_frame_ptr = esp_eh_frame_get_encoded(enc_values, header->eh_frame_ptr_enc, &size);
-    assert(eh_frame_ptr == (uint32_t) EH_FRAME_ADDR);
-    enc_values += size;
-
-    /* Same for the number of entries in the sorted table. */
-    const uint32_t fde_count = esp_eh_frame_get_encoded(enc_values, header->fde_count_enc, &size);
-    enc_values += size;
-
-    /* enc_values points now at the beginning of the sorted table. */
-    /* Only support 4-byte entries. */
-    const uint32_t table_enc = header->table_enc;
-    assert(((table_enc >> 4) == 0x3) || ((table_enc >> 4) == 0xB));
+    const bool table_valid = esp_eh_frame_get_table(&table);
+    assert(table_valid);
+    (void) table_valid;
 
-    const table_entry* sorted_table = (const table_entry*) enc_values;
+    /* The stack boundaries are unknown here, the frame is trusted. */
+    ctx.stack_low = 0;
+    ctx.stack_high = UINT32_MAX;
+    ctx.cie = NULL;
 
     panic_print_str("Backtrace:");
     while (!end_of_backtrace) {
@@ -898,17 +1003,9 @@ void esp_eh_frame_print_backtrace(const void *frame_or)
         /* Output one step of the backtrace. */
         esp_eh_frame_generated_step(EXECUTION_FRAME_PC(frame), EXECUTION_FRAME_SP(frame));
 
-        const table_entry* from_fun = esp_eh_frame_find_entry(sorted_table, fde_count,
-                                                              table_enc, EXECUTION_FRAME_PC(frame));
+        const uint32_t* fde = esp_eh_frame_find_fde(&table, EXECUTION_FRAME_PC(frame));
 
-        /* Get absolute address of FDE entry describing the function where PC left of. */
-        uint32_t* fde = NULL;
-
-        if (from_fun != NULL) {
-            fde = esp_eh_frame_decode_address(&from_fun->fde_addr, table_enc);
-        }
-
-        if (esp_eh_frame_missing_info(fde, EXECUTION_FRAME_PC(frame))) {
+        if (fde == NULL) {
             /* Address was not found in the list. */
             panic_print_str("\r\nBacktrace ended abruptly: cannot find DWARF information for"
                             " instruction at address 0x");
@@ -917,14 +1014,17 @@ void esp_eh_frame_print_backtrace(const void *frame_or)
             break;
         }
 
-        /* Clean and set the DWARF register structure. */
-        memset(&state, 0, sizeof(dwarf_regs));
-
         const uint32_t prev_sp = EXECUTION_FRAME_SP(frame);
 
         /* Retrieve the return address of the frame. The frame's registers will be modified.
          * The frame we get then is the caller's one. */
-        uint32_t ra = esp_eh_frame_restore_caller_state(fde, &frame, &state);
+        uint32_t ra = esp_eh_frame_restore_caller_state(fde, &frame, &state, &ctx);
+
+        if (state.unsupported_opcode != DW_CFA_NOP) {
+            panic_print_str("\r\nUnsupported DWARF opcode 0: 0x");
+            panic_print_hex(state.unsupported_opcode);
+            panic_print_str("\r\n");
+        }
 
         /* End of backtrace is reached if the stack and the PC don't change anymore. */
         end_of_backtrace = (EXECUTION_FRAME_SP(frame) == prev_sp) && (EXECUTION_FRAME_PC(frame) == ra);
@@ -936,6 +1036,44 @@ void esp_eh_frame_print_backtrace(const void *frame_or)
     panic_print_str("\r\n");
 }
 
+uint32_t esp_eh_frame_unwind(const void *frame_or, uint32_t stack_low, uint32_t stack_high,
+                             uint32_t *pcs, uint32_t depth)
+{
+    dwarf_regs state;
+    dwarf_unwind_ctx ctx = {
+        .stack_low = stack_low,
+        .stack_high = stack_high,
+        .cie = NULL,
+    };
+    ExecutionFrame frame = *((const ExecutionFrame*) frame_or);
+    eh_frame_table table = { 0 };
+    uint32_t count = 0;
+
+    if (!esp_eh_frame_get_table(&table)) {
+        return 0;
+    }
+
+    while (count < depth) {
+        pcs[count++] = EXECUTION_FRAME_PC(frame);
+
+        const uint32_t* fde = esp_eh_frame_find_fde(&table, EXECUTION_FRAME_PC(frame));
+        if (fde == NULL) {
+            break;
+        }
+
+        const uint32_t prev_sp = EXECUTION_FRAME_SP(frame);
+        const uint32_t ra = esp_eh_frame_restore_caller_state(fde, &frame, &state, &ctx);
+
+        /* End of backtrace is reached if the stack and the PC don't change anymore. */
+        if ((EXECUTION_FRAME_SP(frame) == prev_sp) && (EXECUTION_FRAME_PC(frame) == ra)) {
+            break;
+        }
+        EXECUTION_FRAME_PC(frame) = ra;
+    }
+
+    return count;
+}
+
 /**
  * The following functions are the implementation of libunwind API
  * Check the header libunwind.h for more information
@@ -956,49 +1094,22 @@ int unw_init_local(unw_cursor_t* c, unw_context_t* ctxt)
 
 int unw_step(unw_cursor_t* cp)
 {
-    static dwarf_regs state = { 0 };
+    dwarf_regs state;
+    /* A cursor doesn't have room for the CIE cache, each step starts from scratch. */
+    dwarf_unwind_ctx ctx = {
+        .stack_low = 0,
+        .stack_high = UINT32_MAX,
+        .cie = NULL,
+    };
     ExecutionFrame* frame = (ExecutionFrame*) cp;
-    uint32_t size = 0;
-    uint8_t* enc_values = NULL;
-
-    /* Start parsing the .eh_frame_hdr section. */
-    fde_header* header = (fde_header*) EH_FRAME_HDR_ADDR;
-    if (header->version != 1) {
-        goto badversion;
-    }
-
-    /* Make enc_values point to the end of the structure, where the encoded
-     * values start. */
-    enc_values = (uint8_t*)(header + 1);
-
-    /* Retrieve the encoded value eh_frame_ptr. Get the size of the data also. */
-    const uint32_t eh_frame_ptr = esp_eh_frame_get_encoded(enc_values, header->eh_frame_ptr_enc, &size);
-    assert(eh_frame_ptr == (uint32_t) EH_FRAME_ADDR);
-    enc_values += size;
+    eh_frame_table table = { 0 };
 
-    /* Same for the number of entries in the sorted table. */
-    const uint32_t fde_count = esp_eh_frame_get_encoded(enc_values, header->fde_count_enc, &size);
-    enc_values += size;
-
-    /* enc_values points now at the beginning of the sorted table. */
-    /* Only support 4-byte entries. */
-    const uint32_t table_enc = header->table_enc;
-    if (((table_enc >> 4) != 0x3) && ((table_enc >> 4) != 0xB)) {
+    if (!esp_eh_frame_get_table(&table)) {
         goto badversion;
     }
 
-    const table_entry* sorted_table = (const table_entry*) enc_values;
-
-    const table_entry* from_fun = esp_eh_frame_find_entry(sorted_table, fde_count,
-                                                          table_enc, EXECUTION_FRAME_PC(*frame));
-
-    /* Get absolute address of FDE entry describing the function where PC left of. */
-    uint32_t* fde = NULL;
-    if (from_fun != NULL) {
-        fde = esp_eh_frame_decode_address(&from_fun->fde_addr, table_enc);
-    }
-
-    if (esp_eh_frame_missing_info(fde, EXECUTION_FRAME_PC(*frame))) {
+    const uint32_t* fde = esp_eh_frame_find_fde(&table, EXECUTION_FRAME_PC(*frame));
+    if (fde == NULL) {
         goto missinginfo;
     }
 
@@ -1006,7 +1117,7 @@ int unw_step(unw_cursor_t* cp)
 
     /* Retrieve the return address of the frame. The frame's registers will be modified.
      * The frame we get then is the caller's one. */
-    uint32_t ra = esp_eh_frame_restore_caller_state(fde, frame, &state);
+    uint32_t ra = esp_eh_frame_restore_caller_state(fde, frame, &state, &ctx);
 
     /* End of backtrace is reached if the stack and the PC don't change anymore. */
     if ((EXECUTION_FRAME_SP(*frame) == prev_sp) && (EXECUTION_FRAME_PC(*frame) == ra)) {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,6 +7,8 @@
 #ifndef EH_FRAME_PARSER_H
 #define EH_FRAME_PARSER_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,6 +22,24 @@ extern "C" {
  */
 void esp_eh_frame_print_backtrace(const void *frame_or);
 
+/**
+ * @brief Get the program counters of the call stack for the given execution frame.
+ *
+ * Unlike esp_eh_frame_print_backtrace(), this function doesn't print anything, doesn't
+ * allocate memory and only restores registers from memory within the given stack
+ * boundaries, so that it can be called from an interrupt handler on a live task stack.
+ *
+ * @param frame_or Snapshot of the CPU registers, as for esp_eh_frame_print_backtrace().
+ * @param stack_low Lowest address of the stack the frame belongs to.
+ * @param stack_high Address following the highest address of the stack the frame belongs to.
+ * @param pcs Array filled with the program counter of each frame, innermost first.
+ * @param depth Maximum number of frames to unwind, size of pcs.
+ *
+ * @return Number of program counters written in pcs.
+ */
+uint32_t esp_eh_frame_unwind(const void *frame_or, uint32_t stack_low, uint32_t stack_high,
+                             uint32_t *pcs, uint32_t depth);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,6 @@
 
 /*
- * SPDX-FileCopyrightText: 2020-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -114,8 +114,8 @@ typedef enum {
                          "mov DWORD PTR [%0 + %c8], edi\n\t" \
                          "mov DWORD PTR [%0 + %c11], 0\n\t"  \
                          /* Special part for retrieving PC */ \
-                         "call __get_pc\n" \
-                         "__get_pc: pop ebx\n\t" \
+                         "call 1f\n" \
+                         "1: pop ebx\n\t" \
                          "mov DWORD PTR [%0 + %c9], ebx\n\t" \
                          /* Same for the flags */ \
                          "pushfd\n\t" \
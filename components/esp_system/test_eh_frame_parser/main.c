@@ -1,6 +1,6 @@
 
 /*
- * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -15,6 +15,8 @@
 #include <stdbool.h>
 #include <assert.h>
 #include <ucontext.h>
+#include <time.h>
+#include <inttypes.h>
 #include "esp_private/eh_frame_parser.h"
 #include "libunwind.h"
 
@@ -47,6 +49,16 @@
  */
 #define NUMBER_OF_ITERATION     (2 * NUMBER_TO_TEST + 2 + 1)
 
+/**
+ * @brief Maximum number of frames retrieved with `esp_eh_frame_unwind`.
+ */
+#define UNWIND_MAX_DEPTH        (16)
+
+/**
+ * @brief Number of call stacks unwound when measuring the unwinding duration.
+ */
+#define UNWIND_ITERATIONS       (100000)
+
 /**
  * @brief Macro for testing calls to libunwind when UNW_ESUCCESS must be returned.
  */
@@ -97,6 +109,10 @@ int analyse_callstack();
 int inner_function1(void);
 int inner_function2(void);
 void test1(void);
+int unwind_callstack(void);
+int unwind_function1(void);
+int unwind_function2(void);
+void test3(void);
 
 /**
  * @brief Structure defining a function of our program.
@@ -148,6 +164,26 @@ struct functions_info funs[] = {
         .start = (uintptr_t) &test1,
         .end = 0
     },
+    {
+        .name = "unwind_callstack",
+        .start = (uintptr_t) &unwind_callstack,
+        .end = 0
+    },
+    {
+        .name = "unwind_function1",
+        .start = (uintptr_t) &unwind_function1,
+        .end = 0
+    },
+    {
+        .name = "unwind_function2",
+        .start = (uintptr_t) &unwind_function2,
+        .end = 0
+    },
+    {
+        .name = "test3",
+        .start = (uintptr_t) &test3,
+        .end = 0
+    },
 };
 
 /**
@@ -417,6 +453,90 @@ void __attribute__((noinline)) test1()
     (void) inner_function1();
 }
 
+/**
+ * @brief Get the number of nanoseconds elapsed since the given time.
+ */
+static uint64_t elapsed_ns(const struct timespec* start)
+{
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    /* time_t and long are 32-bit with -m32 */
+    return (uint64_t) (now.tv_sec - start->tv_sec) * 1000000000ULL + (uint64_t) (now.tv_nsec - start->tv_nsec);
+}
+
+/**
+ * Test the allocation-free unwinder used for sampling call stacks, and measure
+ * how long it takes compared to unwinding the same call stack with libunwind.
+ */
+int unwind_callstack(void)
+{
+    unw_context_t ucp = { 0 };
+    unw_cursor_t cur = { 0 };
+    unw_word_t pc = 0;
+    uint32_t pcs[UNWIND_MAX_DEPTH] = { 0 };
+    uint32_t depth = 0;
+    struct timespec start = { 0 };
+    int err = UNW_ESUCCESS;
+
+    UNW_CHECK(unw_getcontext(&ucp));
+
+    depth = esp_eh_frame_unwind(&ucp, 0, UINT32_MAX, pcs, UNWIND_MAX_DEPTH);
+    UNW_CHECK_TRUE(depth >= 4);
+    UNW_CHECK_PC((unw_word_t) pcs[0], "unwind_callstack");
+    UNW_CHECK_PC((unw_word_t) pcs[1], "unwind_function2");
+    UNW_CHECK_PC((unw_word_t) pcs[2], "unwind_function1");
+    UNW_CHECK_PC((unw_word_t) pcs[3], "test3");
+
+    /* The call stack must be the same as the one given by libunwind, step by step */
+    UNW_CHECK(unw_init_local(&cur, &ucp));
+    for (uint32_t i = 0; i < depth; i++) {
+        UNW_CHECK(unw_get_reg(&cur, UNW_X86_EIP, &pc));
+        UNW_CHECK_TRUE(pc == pcs[i]);
+        UNW_CHECK_TRUE(i == depth - 1 || unw_step(&cur) > 0);
+    }
+    if (depth < UNWIND_MAX_DEPTH) {
+        UNW_CHECK_TRUE(unw_step(&cur) <= 0);
+    }
+
+    /* Registers saved outside of the stack boundaries must not be read: with an empty
+     * stack, the unwinding stops right after the first frame. */
+    UNW_CHECK_TRUE(esp_eh_frame_unwind(&ucp, ucp.esp, ucp.esp, pcs, UNWIND_MAX_DEPTH) == 1);
+    UNW_CHECK_PC((unw_word_t) pcs[0], "unwind_callstack");
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < UNWIND_ITERATIONS; i++) {
+        esp_eh_frame_unwind(&ucp, 0, UINT32_MAX, pcs, UNWIND_MAX_DEPTH);
+    }
+    printf("esp_eh_frame_unwind: %" PRIu64 " ns per call stack of %" PRIu32 " frames\r\n",
+           elapsed_ns(&start) / UNWIND_ITERATIONS, depth);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < UNWIND_ITERATIONS; i++) {
+        UNW_CHECK(unw_init_local(&cur, &ucp));
+        for (uint32_t j = 1; j < depth && unw_step(&cur) > 0; j++) {
+        }
+    }
+    printf("unw_step: %" PRIu64 " ns per call stack of %" PRIu32 " frames\r\n",
+           elapsed_ns(&start) / UNWIND_ITERATIONS, depth);
+
+    return UNW_ESUCCESS;
+}
+
+int __attribute__((noinline)) unwind_function2(void)
+{
+    return unwind_callstack();
+}
+
+int __attribute__((noinline)) unwind_function1(void)
+{
+    return unwind_function2();
+}
+
+void __attribute__((noinline)) test3(void)
+{
+    (void) unwind_function1();
+}
+
 /**
  * Call the previous tests within the main. If the first test fails, it will exit by itself.
  */
@@ -424,6 +544,7 @@ int main(int argc, char** argv)
 {
     initialize_functions_info();
     test1();
+    test3();
     test2();
     return 0;
 }
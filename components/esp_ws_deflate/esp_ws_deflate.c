@@ -0,0 +1,494 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "miniz.h"
+#include "esp_ws_deflate.h"
+
+static const char *TAG = "ws_deflate";
+
+/*
+ * The ROM deflate implementation always uses a 32 KB window and needs about 160 KB of state,
+ * so messages are compressed by the LZ77 encoder below, which sizes its state by the negotiated
+ * window and emits fixed Huffman blocks. Messages are inflated by the ROM implementation into a
+ * dictionary of the negotiated window size.
+ */
+#define WS_DEFLATE_HASH_BITS    10
+#define WS_DEFLATE_HASH_SIZE    (1 << WS_DEFLATE_HASH_BITS)
+#define WS_DEFLATE_MIN_MATCH    3
+#define WS_DEFLATE_MAX_MATCH    258
+#define WS_DEFLATE_TOO_FAR      4096    /*!< Further 3 byte matches would cost more than literals */
+#define WS_DEFLATE_PROBES       32      /*!< Match finder probes, higher values trade CPU for ratio */
+#define WS_DEFLATE_MIN_WSIZE    512     /*!< Keeps a whole match of lookahead beyond the window */
+#define WS_DEFLATE_TRAILER_LEN  4
+
+static const uint8_t ws_deflate_trailer[WS_DEFLATE_TRAILER_LEN] = { 0x00, 0x00, 0xff, 0xff };
+
+/* Please refer to RFC1951 Section 3.2.5 */
+static const uint16_t ws_deflate_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t ws_deflate_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t ws_deflate_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t ws_deflate_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* The window buffer holds up to wsize bytes of history followed by the data being compressed */
+struct esp_ws_deflate_tx {
+    size_t wsize;                           /*!< Half of the window buffer */
+    size_t max_dist;                        /*!< Negotiated window */
+    size_t fill;                            /*!< Bytes in the window buffer */
+    uint16_t head[WS_DEFLATE_HASH_SIZE];    /*!< Latest position of every hash */
+    uint16_t *prev;                         /*!< Previous position with the same hash, indexed modulo wsize */
+    uint8_t *window;                        /*!< 2 * wsize bytes */
+};
+
+struct esp_ws_deflate_rx {
+    tinfl_decompressor inflator;
+    size_t dict_size;
+    size_t dict_ofs;
+    uint8_t dict[];                         /*!< Inflate window of the negotiated size */
+};
+
+typedef struct {
+    uint8_t *buf;
+    size_t len;
+    size_t cap;
+    uint32_t bits;
+    int nbits;
+} ws_deflate_bitbuf_t;
+
+static void ws_deflate_put_bits(ws_deflate_bitbuf_t *bb, uint32_t value, int nbits)
+{
+    bb->bits |= value << bb->nbits;
+    bb->nbits += nbits;
+    while (bb->nbits >= 8) {
+        assert(bb->len < bb->cap);
+        bb->buf[bb->len++] = bb->bits & 0xff;
+        bb->bits >>= 8;
+        bb->nbits -= 8;
+    }
+}
+
+/* Huffman codes are packed starting with the most significant bit */
+static void ws_deflate_put_code(ws_deflate_bitbuf_t *bb, uint32_t code, int nbits)
+{
+    uint32_t reversed = 0;
+    for (int i = 0; i < nbits; i++) {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    ws_deflate_put_bits(bb, reversed, nbits);
+}
+
+/* Fixed literal/length codes, please refer to RFC1951 Section 3.2.6 */
+static void ws_deflate_put_symbol(ws_deflate_bitbuf_t *bb, int sym)
+{
+    if (sym < 144) {
+        ws_deflate_put_code(bb, 0x30 + sym, 8);
+    } else if (sym < 256) {
+        ws_deflate_put_code(bb, 0x190 + sym - 144, 9);
+    } else if (sym < 280) {
+        ws_deflate_put_code(bb, sym - 256, 7);
+    } else {
+        ws_deflate_put_code(bb, 0xc0 + sym - 280, 8);
+    }
+}
+
+static void ws_deflate_put_match(ws_deflate_bitbuf_t *bb, size_t len, size_t dist)
+{
+    int i = 28;
+    while (ws_deflate_len_base[i] > len) {
+        i--;
+    }
+    ws_deflate_put_symbol(bb, 257 + i);
+    ws_deflate_put_bits(bb, len - ws_deflate_len_base[i], ws_deflate_len_extra[i]);
+
+    i = 29;
+    while (ws_deflate_dist_base[i] > dist) {
+        i--;
+    }
+    ws_deflate_put_code(bb, i, 5);
+    ws_deflate_put_bits(bb, dist - ws_deflate_dist_base[i], ws_deflate_dist_extra[i]);
+}
+
+static inline uint32_t ws_deflate_hash(const uint8_t *p)
+{
+    return ((p[0] | p[1] << 8 | p[2] << 16) * 2654435761u) >> (32 - WS_DEFLATE_HASH_BITS);
+}
+
+static void ws_deflate_insert(struct esp_ws_deflate_tx *tx, size_t pos)
+{
+    uint32_t h = ws_deflate_hash(tx->window + pos);
+    tx->prev[pos & (tx->wsize - 1)] = tx->head[h];
+    tx->head[h] = pos;
+}
+
+/* Chains are only hints, every candidate is compared and has to be within the window */
+static size_t ws_deflate_longest_match(struct esp_ws_deflate_tx *tx, size_t pos, size_t max_len, size_t *dist)
+{
+    const uint8_t *win = tx->window;
+    size_t cand = tx->head[ws_deflate_hash(win + pos)];
+    size_t best = 0;
+
+    for (int probes = WS_DEFLATE_PROBES; probes > 0 && cand < pos && pos - cand <= tx->max_dist; probes--) {
+        if (win[cand + best] == win[pos + best]) {
+            size_t len = 0;
+            while (len < max_len && win[cand + len] == win[pos + len]) {
+                len++;
+            }
+            if (len > best) {
+                best = len;
+                *dist = pos - cand;
+                if (len == max_len) {
+                    break;
+                }
+            }
+        }
+        size_t next = tx->prev[cand & (tx->wsize - 1)];
+        if (next >= cand) {
+            break;
+        }
+        cand = next;
+    }
+    return best;
+}
+
+/* Drops the older half of the window buffer */
+static void ws_deflate_slide(struct esp_ws_deflate_tx *tx)
+{
+    memcpy(tx->window, tx->window + tx->wsize, tx->wsize);
+    tx->fill -= tx->wsize;
+    for (size_t i = 0; i < WS_DEFLATE_HASH_SIZE; i++) {
+        tx->head[i] = tx->head[i] >= tx->wsize ? tx->head[i] - tx->wsize : 0;
+    }
+    for (size_t i = 0; i < tx->wsize; i++) {
+        tx->prev[i] = tx->prev[i] >= tx->wsize ? tx->prev[i] - tx->wsize : 0;
+    }
+}
+
+static void ws_deflate_encode(struct esp_ws_deflate_tx *tx, const uint8_t *in, size_t len, ws_deflate_bitbuf_t *bb)
+{
+    size_t pos = tx->fill;
+    size_t in_ofs = 0;
+
+    while (1) {
+        if (tx->fill == 2 * tx->wsize) {
+            ws_deflate_slide(tx);
+            pos -= tx->wsize;
+        }
+        size_t n = MIN(len - in_ofs, 2 * tx->wsize - tx->fill);
+        memcpy(tx->window + tx->fill, in + in_ofs, n);
+        tx->fill += n;
+        in_ofs += n;
+
+        /* Keep a whole match of lookahead while more input is to come */
+        size_t end = in_ofs < len ? tx->fill - WS_DEFLATE_MAX_MATCH : tx->fill;
+        while (pos < end) {
+            size_t avail = tx->fill - pos;
+            size_t match = 0, dist = 0;
+            if (avail >= WS_DEFLATE_MIN_MATCH) {
+                match = ws_deflate_longest_match(tx, pos, MIN(avail, WS_DEFLATE_MAX_MATCH), &dist);
+            }
+            if (match >= WS_DEFLATE_MIN_MATCH && (match > WS_DEFLATE_MIN_MATCH || dist <= WS_DEFLATE_TOO_FAR)) {
+                ws_deflate_put_match(bb, match, dist);
+                for (size_t i = 0; i < match && pos + i + WS_DEFLATE_MIN_MATCH <= tx->fill; i++) {
+                    ws_deflate_insert(tx, pos + i);
+                }
+                pos += match;
+            } else {
+                ws_deflate_put_symbol(bb, tx->window[pos]);
+                if (avail >= WS_DEFLATE_MIN_MATCH) {
+                    ws_deflate_insert(tx, pos);
+                }
+                pos++;
+            }
+        }
+        if (in_ofs == len) {
+            return;
+        }
+    }
+}
+
+static void ws_deflate_free_tx(esp_ws_deflate_t *d)
+{
+    free(d->tx);
+    d->tx = NULL;
+}
+
+static void ws_deflate_free_rx(esp_ws_deflate_t *d)
+{
+    free(d->rx);
+    d->rx = NULL;
+}
+
+static esp_err_t ws_deflate_alloc_tx(esp_ws_deflate_t *d)
+{
+    size_t max_dist = 1 << d->tx_window_bits;
+    size_t wsize = MAX(max_dist, WS_DEFLATE_MIN_WSIZE);
+    size_t size = sizeof(struct esp_ws_deflate_tx) + wsize * sizeof(uint16_t) + 2 * wsize;
+
+    struct esp_ws_deflate_tx *tx = calloc(1, size);
+    if (tx == NULL) {
+        ESP_LOGE(TAG, "Cannot allocate deflate state, need-%d", (int)size);
+        return ESP_ERR_NO_MEM;
+    }
+    tx->wsize = wsize;
+    tx->max_dist = max_dist;
+    tx->prev = (uint16_t *)(tx + 1);
+    tx->window = (uint8_t *)(tx->prev + wsize);
+    d->tx = tx;
+    return ESP_OK;
+}
+
+static esp_err_t ws_deflate_alloc_rx(esp_ws_deflate_t *d)
+{
+    size_t dict_size = 1 << d->rx_window_bits;
+    struct esp_ws_deflate_rx *rx = malloc(sizeof(struct esp_ws_deflate_rx) + dict_size);
+    if (rx == NULL) {
+        ESP_LOGE(TAG, "Cannot allocate inflate state, need-%d", (int)(sizeof(struct esp_ws_deflate_rx) + dict_size));
+        return ESP_ERR_NO_MEM;
+    }
+    tinfl_init(&rx->inflator);
+    rx->dict_size = dict_size;
+    rx->dict_ofs = 0;
+    d->rx = rx;
+    return ESP_OK;
+}
+
+esp_err_t esp_ws_deflate_compress(esp_ws_deflate_t *d, const uint8_t *in, size_t len, bool fin,
+                                  uint8_t **out, size_t *out_len)
+{
+    if (d->tx == NULL && ws_deflate_alloc_tx(d) != ESP_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* No symbol takes more than 9 bits per byte, plus the block header and the flush */
+    ws_deflate_bitbuf_t bb = { .cap = len + len / 8 + 16 };
+    bb.buf = malloc(bb.cap);
+    if (bb.buf == NULL) {
+        ESP_LOGE(TAG, "Cannot allocate deflate buffer, need-%d", (int)bb.cap);
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (len > 0) {
+        /* BFINAL=0, BTYPE=01: a block with the fixed Huffman codes */
+        ws_deflate_put_bits(&bb, 2, 3);
+        ws_deflate_encode(d->tx, in, len, &bb);
+        ws_deflate_put_symbol(&bb, 256);
+    }
+    /* Sync flush makes every frame end on a byte boundary with an empty stored block (00 00 ff ff) */
+    ws_deflate_put_bits(&bb, 0, 3);
+    if (bb.nbits > 0) {
+        ws_deflate_put_bits(&bb, 0, 8 - bb.nbits);
+    }
+    if (!fin) {
+        memcpy(bb.buf + bb.len, ws_deflate_trailer, WS_DEFLATE_TRAILER_LEN);
+        bb.len += WS_DEFLATE_TRAILER_LEN;
+    } else if (d->tx_no_context_takeover) {
+        ws_deflate_free_tx(d);
+    }
+    d->tx_in_msg = !fin;
+
+    *out = bb.buf;
+    *out_len = bb.len;
+    return ESP_OK;
+}
+
+static esp_err_t ws_deflate_inflate_feed(esp_ws_deflate_t *d, const uint8_t *in, size_t in_len)
+{
+    struct esp_ws_deflate_rx *rx = d->rx;
+
+    while (1) {
+        size_t in_size = in_len;
+        size_t out_size = rx->dict_size - rx->dict_ofs;
+        tinfl_status status = tinfl_decompress(&rx->inflator, in, &in_size, rx->dict, rx->dict + rx->dict_ofs,
+                                               &out_size, TINFL_FLAG_HAS_MORE_INPUT);
+        in += in_size;
+        in_len -= in_size;
+
+        if (out_size > 0) {
+            if (d->rx_len + out_size > d->max_payload) {
+                ESP_LOGE(TAG, "Inflated payload exceeds %d bytes", (int)d->max_payload);
+                return ESP_ERR_INVALID_SIZE;
+            }
+            uint8_t *grown = realloc(d->rx_buf, d->rx_len + out_size);
+            if (grown == NULL) {
+                ESP_LOGE(TAG, "Cannot allocate inflate buffer, need-%d", (int)(d->rx_len + out_size));
+                return ESP_ERR_NO_MEM;
+            }
+            d->rx_buf = grown;
+            memcpy(d->rx_buf + d->rx_len, rx->dict + rx->dict_ofs, out_size);
+            d->rx_len += out_size;
+            rx->dict_ofs = (rx->dict_ofs + out_size) & (rx->dict_size - 1);
+        }
+
+        if (status < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "tinfl_decompress failed (%d)", status);
+            return ESP_FAIL;
+        }
+        if (status == TINFL_STATUS_DONE) {
+            /* The peer closed the deflate stream with a final block, anything after it is the trailer */
+            tinfl_init(&rx->inflator);
+            return ESP_OK;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT) {
+            return ESP_OK;
+        }
+    }
+}
+
+esp_err_t esp_ws_deflate_inflate(esp_ws_deflate_t *d, const uint8_t *in, size_t len, bool fin)
+{
+    if (d->rx == NULL && ws_deflate_alloc_rx(d) != ESP_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_ws_deflate_drop_rx_buf(d);
+
+    esp_err_t ret = ws_deflate_inflate_feed(d, in, len);
+    if (ret == ESP_OK && fin) {
+        /* Please refer to RFC7692 Section 7.2.2 */
+        ret = ws_deflate_inflate_feed(d, ws_deflate_trailer, WS_DEFLATE_TRAILER_LEN);
+    }
+    if (ret != ESP_OK) {
+        ws_deflate_free_rx(d);
+        esp_ws_deflate_drop_rx_buf(d);
+        return ret;
+    }
+    if (fin && d->rx_no_context_takeover) {
+        ws_deflate_free_rx(d);
+    }
+    d->rx_in_msg = !fin;
+    return ESP_OK;
+}
+
+void esp_ws_deflate_drop_rx_buf(esp_ws_deflate_t *d)
+{
+    free(d->rx_buf);
+    d->rx_buf = NULL;
+    d->rx_len = 0;
+}
+
+void esp_ws_deflate_free(esp_ws_deflate_t *d)
+{
+    ws_deflate_free_tx(d);
+    ws_deflate_free_rx(d);
+    esp_ws_deflate_drop_rx_buf(d);
+    d->tx_in_msg = d->rx_in_msg = false;
+}
+
+static char *ws_deflate_trim(char *str)
+{
+    while (*str == ' ' || *str == '\t') {
+        str++;
+    }
+    char *end = str + strlen(str);
+    while (end > str && (end[-1] == ' ' || end[-1] == '\t')) {
+        *--end = '\0';
+    }
+    return str;
+}
+
+/* Returns 0 for a missing or invalid value, which may be a quoted string */
+static uint8_t ws_deflate_parse_window_bits(char *value)
+{
+    if (value == NULL) {
+        return 0;
+    }
+    size_t len = strlen(value);
+    if (len >= 2 && value[0] == '"' && value[len - 1] == '"') {
+        value[len - 1] = '\0';
+        value++;
+    }
+    if (!isdigit((unsigned char)value[0])) {
+        return 0;
+    }
+    char *end = NULL;
+    long bits = strtol(value, &end, 10);
+    if (*end != '\0' || bits < ESP_WS_DEFLATE_MIN_WINDOW_BITS || bits > ESP_WS_DEFLATE_MAX_WINDOW_BITS) {
+        return 0;
+    }
+    return bits;
+}
+
+esp_err_t esp_ws_deflate_parse_params(char *ext, esp_ws_deflate_params_t *params)
+{
+    memset(params, 0, sizeof(*params));
+
+    char *rest = NULL;
+    char *param = strtok_r(ext, ";", &rest);
+    if (param == NULL || strcmp(ws_deflate_trim(param), "permessage-deflate") != 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    /* Unknown or repeated parameters make the element invalid, please refer to RFC7692 Section 7 */
+    while ((param = strtok_r(NULL, ";", &rest)) != NULL) {
+        char *value = strchr(param, '=');
+        if (value != NULL) {
+            *value++ = '\0';
+            value = ws_deflate_trim(value);
+        }
+        param = ws_deflate_trim(param);
+
+        if (strcmp(param, "server_no_context_takeover") == 0 && value == NULL &&
+                !params->server_no_context_takeover) {
+            params->server_no_context_takeover = true;
+        } else if (strcmp(param, "client_no_context_takeover") == 0 && value == NULL &&
+                   !params->client_no_context_takeover) {
+            params->client_no_context_takeover = true;
+        } else if (strcmp(param, "server_max_window_bits") == 0 && params->server_max_window_bits == 0) {
+            params->server_max_window_bits = ws_deflate_parse_window_bits(value);
+            if (params->server_max_window_bits == 0) {
+                ESP_LOGD(TAG, "Invalid server_max_window_bits");
+                return ESP_ERR_NOT_SUPPORTED;
+            }
+        } else if (strcmp(param, "client_max_window_bits") == 0 && params->client_max_window_bits == 0) {
+            params->client_max_window_bits = value ? ws_deflate_parse_window_bits(value) : ESP_WS_DEFLATE_MAX_WINDOW_BITS;
+            if (params->client_max_window_bits == 0) {
+                ESP_LOGD(TAG, "Invalid client_max_window_bits");
+                return ESP_ERR_NOT_SUPPORTED;
+            }
+        } else {
+            ESP_LOGD(TAG, "Unsupported permessage-deflate parameter: %s", param);
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+    }
+    return ESP_OK;
+}
+
+int esp_ws_deflate_format_params(const esp_ws_deflate_params_t *params, char *buf, size_t len)
+{
+    int total = snprintf(buf, len, "permessage-deflate%s%s",
+                         params->server_no_context_takeover ? "; server_no_context_takeover" : "",
+                         params->client_no_context_takeover ? "; client_no_context_takeover" : "");
+    if (total >= 0 && params->server_max_window_bits) {
+        size_t ofs = MIN((size_t)total, len);
+        total += snprintf(buf + ofs, len - ofs, "; server_max_window_bits=%d", params->server_max_window_bits);
+    }
+    if (total >= 0 && params->client_max_window_bits) {
+        size_t ofs = MIN((size_t)total, len);
+        if (params->client_max_window_bits == ESP_WS_DEFLATE_MAX_WINDOW_BITS) {
+            total += snprintf(buf + ofs, len - ofs, "; client_max_window_bits");
+        } else {
+            total += snprintf(buf + ofs, len - ofs, "; client_max_window_bits=%d", params->client_max_window_bits);
+        }
+    }
+    return total;
+}
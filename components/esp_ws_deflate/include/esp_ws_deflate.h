@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * WebSocket permessage-deflate codec shared by the WebSocket server and client,
+ * please refer to RFC7692 for more details.
+ */
+
+#define ESP_WS_DEFLATE_MIN_WINDOW_BITS  8
+#define ESP_WS_DEFLATE_MAX_WINDOW_BITS  15
+
+/**
+ * @brief Parameters of a permessage-deflate offer or response
+ */
+typedef struct {
+    bool server_no_context_takeover;
+    bool client_no_context_takeover;
+    uint8_t server_max_window_bits;     /*!< 0 if the parameter is absent */
+    uint8_t client_max_window_bits;     /*!< 0 if the parameter is absent, 15 if it has no value */
+} esp_ws_deflate_params_t;
+
+/**
+ * @brief Compression state of a WebSocket connection
+ *
+ * The window sizes and context takeover flags are set by the caller once the
+ * extension is negotiated. The compressor and inflate states are allocated on
+ * first use and sized by the window bits.
+ */
+typedef struct {
+    uint8_t tx_window_bits;         /*!< Largest window of the messages we compress */
+    uint8_t rx_window_bits;         /*!< Largest window of the messages the peer compresses */
+    bool tx_no_context_takeover;    /*!< Reset the compressor after every message */
+    bool rx_no_context_takeover;    /*!< The peer resets its compressor after every message */
+    bool tx_in_msg;                 /*!< A compressed message is being sent in fragments */
+    bool rx_in_msg;                 /*!< A compressed message is being received in fragments */
+    size_t max_payload;             /*!< Largest inflated payload of a frame */
+    struct esp_ws_deflate_tx *tx;
+    struct esp_ws_deflate_rx *rx;
+    uint8_t *rx_buf;                /*!< Inflated payload of the last frame */
+    size_t rx_len;
+} esp_ws_deflate_t;
+
+/**
+ * @brief Parses one permessage-deflate extension element
+ *
+ * @param[in]  ext      Extension element, e.g. "permessage-deflate; client_max_window_bits", modified in place
+ * @param[out] params   Parameters of the element
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if the element is not permessage-deflate
+ *      - ESP_ERR_NOT_SUPPORTED if a parameter is unknown or out of range
+ */
+esp_err_t esp_ws_deflate_parse_params(char *ext, esp_ws_deflate_params_t *params);
+
+/**
+ * @brief Formats a permessage-deflate extension element
+ *
+ * A client_max_window_bits of 15 is written without a value, which lets the server pick one.
+ *
+ * @param[in]  params   Parameters of the element
+ * @param[out] buf      Output buffer
+ * @param[in]  len      Size of the output buffer
+ *
+ * @return Length of the element, as snprintf()
+ */
+int esp_ws_deflate_format_params(const esp_ws_deflate_params_t *params, char *buf, size_t len);
+
+/**
+ * @brief Compresses one frame of a message
+ *
+ * The output of the last frame of a message has the trailing empty block removed,
+ * please refer to RFC7692 Section 7.2.1.
+ *
+ * @param[in]  d        Compression state
+ * @param[in]  in       Payload of the frame
+ * @param[in]  len      Length of the payload
+ * @param[in]  fin      The frame is the last one of the message
+ * @param[out] out      Compressed payload, to be freed by the caller
+ * @param[out] out_len  Length of the compressed payload
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if the compressor or the output can't be allocated
+ */
+esp_err_t esp_ws_deflate_compress(esp_ws_deflate_t *d, const uint8_t *in, size_t len, bool fin,
+                                  uint8_t **out, size_t *out_len);
+
+/**
+ * @brief Inflates one frame of a message into d->rx_buf
+ *
+ * @param[in] d         Compression state
+ * @param[in] in        Unmasked payload of the frame
+ * @param[in] len       Length of the payload
+ * @param[in] fin       The frame is the last one of the message
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if the inflate state or the output can't be allocated
+ *      - ESP_ERR_INVALID_SIZE if the inflated payload exceeds d->max_payload
+ *      - ESP_FAIL if the payload is not a valid deflate stream
+ */
+esp_err_t esp_ws_deflate_inflate(esp_ws_deflate_t *d, const uint8_t *in, size_t len, bool fin);
+
+/**
+ * @brief Releases the inflated payload of the last frame
+ *
+ * @param[in] d     Compression state
+ */
+void esp_ws_deflate_drop_rx_buf(esp_ws_deflate_t *d);
+
+/**
+ * @brief Releases the compressor, the inflate state and the inflated payload
+ *
+ * The negotiated parameters are kept.
+ *
+ * @param[in] d     Compression state
+ */
+void esp_ws_deflate_free(esp_ws_deflate_t *d);
+
+#ifdef __cplusplus
+}
+#endif
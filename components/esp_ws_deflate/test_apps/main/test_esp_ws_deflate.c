@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_ws_deflate.h"
+
+/*
+ * The test data is generated from a seed so that pytest_esp_ws_deflate.py can
+ * regenerate it and check the streams printed by the last test with zlib.
+ */
+#define TEST_DATA_RANDOM    0   /*!< Incompressible */
+#define TEST_DATA_TEXT      1   /*!< JSON-like telemetry */
+#define TEST_DATA_RUNS      2   /*!< Runs of repeated bytes */
+#define TEST_DATA_KINDS     3
+
+#define TEST_MSG_LEN        1024
+#define TEST_MSGS           2
+#define TEST_FRAMES         3
+
+static const char *test_words[] = {
+    "{\"id\":", "\"temperature\":", "\"humidity\":", "\"pressure\":", "21.5", "1013", ", ", "}\n",
+};
+
+static uint32_t test_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void test_fill(uint8_t *buf, size_t len, int kind, uint32_t seed)
+{
+    uint32_t state = seed;
+    uint8_t run = 0;
+    size_t i = 0;
+
+    while (i < len) {
+        uint32_t r = test_rand(&state);
+        if (kind == TEST_DATA_RANDOM) {
+            buf[i++] = r & 0xff;
+        } else if (kind == TEST_DATA_TEXT) {
+            const char *word = test_words[r % (sizeof(test_words) / sizeof(test_words[0]))];
+            while (*word != '\0' && i < len) {
+                buf[i++] = *word++;
+            }
+        } else {
+            if (r % 16 == 0) {
+                run = (r >> 8) & 0xff;
+            }
+            buf[i++] = run;
+        }
+    }
+}
+
+/* Length of a frame, the message is split into a quarter, a half and the rest */
+static size_t test_frame_len(size_t len, int frame)
+{
+    return frame == 0 ? len / 4 : frame == 1 ? len / 2 : len - len / 4 - len / 2;
+}
+
+/*
+ * Compresses TEST_MSGS messages in TEST_FRAMES frames each, inflates every frame
+ * with a window of the same size and checks the result. Returns the compressed size.
+ */
+static size_t test_round_trip(uint8_t bits, int kind, bool no_context_takeover, bool dump)
+{
+    esp_ws_deflate_t tx = {
+        .tx_window_bits = bits,
+        .tx_no_context_takeover = no_context_takeover,
+    };
+    esp_ws_deflate_t rx = {
+        .rx_window_bits = bits,
+        .rx_no_context_takeover = no_context_takeover,
+        .max_payload = TEST_MSG_LEN,
+    };
+    uint8_t *msg = malloc(TEST_MSG_LEN);
+    TEST_ASSERT_NOT_NULL(msg);
+    size_t total = 0;
+
+    if (dump) {
+        printf("ws_deflate stream %d %d %d\n", bits, kind, no_context_takeover);
+    }
+    for (int m = 0; m < TEST_MSGS; m++) {
+        test_fill(msg, TEST_MSG_LEN, kind, 1 + m);
+        size_t ofs = 0;
+        for (int f = 0; f < TEST_FRAMES; f++) {
+            size_t len = test_frame_len(TEST_MSG_LEN, f);
+            bool fin = f == TEST_FRAMES - 1;
+            uint8_t *out;
+            size_t out_len;
+            TEST_ESP_OK(esp_ws_deflate_compress(&tx, msg + ofs, len, fin, &out, &out_len));
+            // fixed Huffman codes take at most 9 bits per byte
+            TEST_ASSERT_LESS_OR_EQUAL(len + len / 8 + 16, out_len);
+            if (dump) {
+                for (size_t i = 0; i < out_len; i += 32) {
+                    printf("ws_deflate data ");
+                    for (size_t j = i; j < out_len && j < i + 32; j++) {
+                        printf("%02x", out[j]);
+                    }
+                    printf("\n");
+                }
+                printf("ws_deflate frame %d\n", fin);
+            }
+            TEST_ESP_OK(esp_ws_deflate_inflate(&rx, out, out_len, fin));
+            TEST_ASSERT_EQUAL(len, rx.rx_len);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(msg + ofs, rx.rx_buf, len);
+            free(out);
+            total += out_len;
+            ofs += len;
+        }
+        TEST_ASSERT_EQUAL(no_context_takeover, tx.tx == NULL);
+        TEST_ASSERT_EQUAL(no_context_takeover, rx.rx == NULL);
+    }
+    if (dump) {
+        printf("ws_deflate end\n");
+    }
+    esp_ws_deflate_free(&tx);
+    esp_ws_deflate_free(&rx);
+    free(msg);
+    return total;
+}
+
+TEST_CASE("esp_ws_deflate round trip for every window size", "[esp_ws_deflate]")
+{
+    for (uint8_t bits = ESP_WS_DEFLATE_MIN_WINDOW_BITS; bits <= ESP_WS_DEFLATE_MAX_WINDOW_BITS; bits++) {
+        for (int kind = 0; kind < TEST_DATA_KINDS; kind++) {
+            test_round_trip(bits, kind, false, false);
+            test_round_trip(bits, kind, true, false);
+        }
+    }
+}
+
+TEST_CASE("esp_ws_deflate compression ratio", "[esp_ws_deflate]")
+{
+    // incompressible data grows by at most an eighth, text shrinks by more than half
+    size_t random_len = test_round_trip(11, TEST_DATA_RANDOM, false, false);
+    size_t text_len = test_round_trip(11, TEST_DATA_TEXT, false, false);
+    size_t runs_len = test_round_trip(11, TEST_DATA_RUNS, false, false);
+    printf("%d bytes compressed to: random %d, text %d, runs %d\n",
+           TEST_MSGS * TEST_MSG_LEN, (int)random_len, (int)text_len, (int)runs_len);
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_MSGS * (TEST_MSG_LEN + TEST_MSG_LEN / 8 + 16), random_len);
+    TEST_ASSERT_LESS_THAN(TEST_MSGS * TEST_MSG_LEN / 2, text_len);
+    TEST_ASSERT_LESS_THAN(TEST_MSGS * TEST_MSG_LEN / 2, runs_len);
+}
+
+TEST_CASE("esp_ws_deflate rejects an invalid stream", "[esp_ws_deflate]")
+{
+    esp_ws_deflate_t rx = {
+        .rx_window_bits = 15,
+        .max_payload = TEST_MSG_LEN,
+    };
+    // BTYPE=11 is reserved
+    const uint8_t invalid[] = { 0x07, 0x00 };
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_ws_deflate_inflate(&rx, invalid, sizeof(invalid), true));
+    TEST_ASSERT_NULL(rx.rx);
+    TEST_ASSERT_NULL(rx.rx_buf);
+
+    // the inflated payload is capped by max_payload
+    esp_ws_deflate_t tx = { .tx_window_bits = 15 };
+    uint8_t *msg = calloc(1, TEST_MSG_LEN + 1);
+    TEST_ASSERT_NOT_NULL(msg);
+    uint8_t *out;
+    size_t out_len;
+    TEST_ESP_OK(esp_ws_deflate_compress(&tx, msg, TEST_MSG_LEN + 1, true, &out, &out_len));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_ws_deflate_inflate(&rx, out, out_len, true));
+    TEST_ASSERT_NULL(rx.rx_buf);
+    free(out);
+    free(msg);
+    esp_ws_deflate_free(&tx);
+    esp_ws_deflate_free(&rx);
+}
+
+TEST_CASE("esp_ws_deflate streams for the zlib reference check", "[esp_ws_deflate]")
+{
+    const uint8_t bits[] = { ESP_WS_DEFLATE_MIN_WINDOW_BITS, 11, ESP_WS_DEFLATE_MAX_WINDOW_BITS };
+    for (int b = 0; b < sizeof(bits); b++) {
+        for (int kind = 0; kind < TEST_DATA_KINDS; kind++) {
+            test_round_trip(bits[b], kind, false, true);
+            test_round_trip(bits[b], kind, true, true);
+        }
+    }
+    printf("ws_deflate done\n");
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
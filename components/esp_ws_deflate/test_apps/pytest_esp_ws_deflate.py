@@ -0,0 +1,87 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+import zlib
+
+import pytest
+from pytest_embedded import Dut
+from pytest_embedded_idf.utils import idf_parametrize
+
+# Must match test_words, test_rand() and test_fill() of main/test_esp_ws_deflate.c
+TEST_WORDS = [b'{"id":', b'"temperature":', b'"humidity":', b'"pressure":', b'21.5', b'1013', b', ', b'}\n']
+TEST_MSG_LEN = 1024
+TEST_MSGS = 2
+TRAILER = b'\x00\x00\xff\xff'
+
+
+def gen_rand(state: int) -> int:
+    state ^= (state << 13) & 0xFFFFFFFF
+    state ^= state >> 17
+    state ^= (state << 5) & 0xFFFFFFFF
+    return state
+
+
+def gen_fill(length: int, kind: int, seed: int) -> bytes:
+    state = seed
+    run = 0
+    buf = bytearray()
+    while len(buf) < length:
+        state = gen_rand(state)
+        if kind == 0:
+            buf.append(state & 0xFF)
+        elif kind == 1:
+            buf += TEST_WORDS[state % len(TEST_WORDS)]
+        else:
+            if state % 16 == 0:
+                run = (state >> 8) & 0xFF
+            buf.append(run)
+    return bytes(buf[:length])
+
+
+def check_stream(bits: int, kind: int, no_context_takeover: bool, frames: list) -> None:
+    inflater = zlib.decompressobj(wbits=-bits)
+    msg = 0
+    inflated = b''
+    for data, fin in frames:
+        if fin:
+            data += TRAILER
+        inflated += inflater.decompress(data)
+        if fin:
+            assert inflated == gen_fill(TEST_MSG_LEN, kind, 1 + msg), f'stream {bits} {kind} {no_context_takeover}'
+            inflated = b''
+            msg += 1
+            if no_context_takeover:
+                inflater = zlib.decompressobj(wbits=-bits)
+    assert msg == TEST_MSGS
+
+
+@pytest.mark.generic
+@idf_parametrize('target', ['esp32', 'esp32c3'], indirect=['target'])
+def test_esp_ws_deflate(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
+
+
+@pytest.mark.generic
+@idf_parametrize('target', ['esp32', 'esp32c3'], indirect=['target'])
+def test_esp_ws_deflate_zlib_reference(dut: Dut) -> None:
+    dut.expect_exact('Press ENTER to see the list of tests')
+    dut.write('"esp_ws_deflate streams for the zlib reference check"')
+    streams = 0
+    while True:
+        match = dut.expect(r'ws_deflate (stream \d+ \d+ \d+|data [0-9a-f]+|frame \d|end|done)\r?\n', timeout=60)
+        words = match.group(1).decode().split()
+        if words[0] == 'stream':
+            bits, kind, no_context_takeover = (int(w) for w in words[1:])
+            frames = []
+            data = b''
+        elif words[0] == 'data':
+            data += bytes.fromhex(words[1])
+        elif words[0] == 'frame':
+            frames.append((data, words[1] == '1'))
+            data = b''
+        elif words[0] == 'end':
+            check_stream(bits, kind, bool(no_context_takeover), frames)
+            streams += 1
+        else:
+            break
+    assert streams == 18
+    dut.expect_exact('0 Failures')
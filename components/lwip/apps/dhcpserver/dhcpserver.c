@@ -18,6 +18,9 @@
 
 #include "dhcpserver/dhcpserver.h"
 #include "dhcpserver/dhcpserver_options.h"
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+#include "netif/dhcps_state.h"
+#endif
 
 #if ESP_DHCPS
 
@@ -94,6 +97,11 @@
 
 #define MAX_STATION_NUM CONFIG_LWIP_DHCPS_MAX_STATION_NUM
 
+#define DHCPS_LEASE_NONE 0xFFFF
+#define DHCPS_LEASE_STORE_DELAY_SECS 10
+/* wrap-around safe comparison of lease expiry times, in coarse timer ticks */
+#define DHCPS_TIME_AFTER(a, b) ((s32_t)((a) - (b)) > 0)
+
 #define DHCPS_STATE_OFFER 1
 #define DHCPS_STATE_DECLINE 2
 #define DHCPS_STATE_ACK 3
@@ -108,10 +116,32 @@ typedef enum {
     DHCPS_HANDLE_DELETE_PENDING,
 } dhcps_handle_state;
 
-typedef struct list_node {
-	void *pnode;
-	struct list_node *pnext;
-} list_node;
+/* Lease of one address of the pool, the lease_timer of the pool holds the expiry time */
+struct dhcps_lease {
+    struct dhcps_pool pool;
+    u16_t mac_next;     /* next lease in the same MAC hash bucket */
+    u16_t exp_prev;     /* previous lease in the expiry list */
+    u16_t exp_next;     /* next lease in the expiry list */
+    bool bound;         /* acknowledged to the client */
+};
+
+/*
+ * Leases are indexed by the offset of their address in the pool, the used addresses
+ * are kept in a bitmap, the leases are chained in MAC hash buckets and in a list
+ * sorted by expiry time, the oldest first.
+ */
+struct dhcps_lease_table {
+    ip4_addr_t start_ip;
+    u16_t size;
+    u16_t count;
+    u16_t hash_mask;
+    u16_t exp_head;
+    u16_t exp_tail;
+    u32_t now;
+    u32_t *used;
+    u16_t *mac_hash;
+    struct dhcps_lease *leases;
+};
 
 typedef struct {
     ip4_addr_t ip;
@@ -130,7 +160,7 @@ struct dhcps_t {
     ip4_addr_t client_address;
     ip4_addr_t client_address_plus;
     ip4_addr_t dhcps_mask;
-    list_node *plist;
+    struct dhcps_lease_table *lease_table;
     bool renew;
     dhcps_lease_t dhcps_poll;
     dhcps_time_t dhcps_lease_time;
@@ -142,6 +172,10 @@ struct dhcps_t {
     struct udp_pcb *dhcps_pcb;
     dhcps_handle_state state;
     bool has_declined_ip;
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+    bool leases_dirty;
+    u32_t leases_stored;
+#endif
 };
 
 
@@ -165,7 +199,7 @@ dhcps_t *dhcps_new(void)
 #else
     dhcps->dhcps_mask.addr = PP_HTONL(LWIP_MAKEU32(255, 255, 255, 0));
 #endif
-    dhcps->plist = NULL;
+    dhcps->lease_table = NULL;
     dhcps->renew = false;
     dhcps->dhcps_lease_time = DHCPS_LEASE_TIME_DEF;
     dhcps->dhcps_offer = 0xFF;
@@ -329,83 +363,254 @@ err_t dhcps_set_option_info(dhcps_t *dhcps, u8_t op_id, void *opt_info, u32_t op
 }
 
 /******************************************************************************
- * FunctionName : node_insert_to_list
- * Description  : insert the node to the list
- * Parameters   : phead -- the head node of the list
- *                pinsert -- the insert node of the list
+ * FunctionName : lease_table_new
+ * Description  : allocate the lease table of the address pool
+ * Parameters   : start_ip -- the first address of the pool
+ *                end_ip -- the last address of the pool
+ * Returns      : the lease table, NULL if out of memory
+*******************************************************************************/
+static struct dhcps_lease_table *lease_table_new(ip4_addr_t start_ip, ip4_addr_t end_ip)
+{
+    u16_t size = htonl(end_ip.addr) - htonl(start_ip.addr) + 1;
+    u16_t buckets = 8;
+    u16_t words = (size + 31) / 32;
+    struct dhcps_lease_table *table;
+
+    while (buckets < size) {
+        buckets <<= 1;
+    }
+    table = mem_calloc(1, sizeof(struct dhcps_lease_table) + size * sizeof(struct dhcps_lease)
+                       + words * sizeof(u32_t) + buckets * sizeof(u16_t));
+    if (table == NULL) {
+        return NULL;
+    }
+    table->leases = (struct dhcps_lease *)(table + 1);
+    table->used = (u32_t *)(table->leases + size);
+    table->mac_hash = (u16_t *)(table->used + words);
+    table->start_ip.addr = start_ip.addr;
+    table->size = size;
+    table->hash_mask = buckets - 1;
+    table->exp_head = DHCPS_LEASE_NONE;
+    table->exp_tail = DHCPS_LEASE_NONE;
+    memset(table->mac_hash, 0xFF, buckets * sizeof(u16_t));
+    return table;
+}
+
+static inline u16_t lease_mac_hash(const struct dhcps_lease_table *table, const u8_t *mac)
+{
+    u32_t hash = 2166136261U;
+
+    for (int i = 0; i < 6; i++) {
+        hash = (hash ^ mac[i]) * 16777619U;
+    }
+    return (hash ^ (hash >> 16)) & table->hash_mask;
+}
+
+/******************************************************************************
+ * FunctionName : lease_find_mac
+ * Description  : find the lease of a client
+ * Parameters   : mac -- the MAC address of the client
+ * Returns      : the lease index, DHCPS_LEASE_NONE if not found
+*******************************************************************************/
+static u16_t lease_find_mac(const struct dhcps_lease_table *table, const u8_t *mac)
+{
+    u16_t idx = table->mac_hash[lease_mac_hash(table, mac)];
+
+    while (idx != DHCPS_LEASE_NONE && memcmp(table->leases[idx].pool.mac, mac, 6) != 0) {
+        idx = table->leases[idx].mac_next;
+    }
+    return idx;
+}
+
+/******************************************************************************
+ * FunctionName : lease_find_free
+ * Description  : find the first free address of the pool
+ * Parameters   : from -- offset in the pool to start from
+ * Returns      : the lease index, DHCPS_LEASE_NONE if none is free
+*******************************************************************************/
+static u16_t lease_find_free(const struct dhcps_lease_table *table, u32_t from)
+{
+    u32_t i = from;
+
+    while (i < table->size) {
+        u32_t free_bits = ~table->used[i / 32] & (0xFFFFFFFFU << (i % 32));
+
+        if (free_bits != 0) {
+            i = (i & ~31U) + __builtin_ctz(free_bits);
+            return i < table->size ? i : DHCPS_LEASE_NONE;
+        }
+        i = (i & ~31U) + 32;
+    }
+    return DHCPS_LEASE_NONE;
+}
+
+/******************************************************************************
+ * FunctionName : lease_expiry_link
+ * Description  : insert the lease in the expiry list
+ * Parameters   : idx -- the lease index
  * Returns      : none
 *******************************************************************************/
-static void node_insert_to_list(list_node **phead, list_node *pinsert)
+static void lease_expiry_link(struct dhcps_lease_table *table, u16_t idx)
 {
-    list_node *plist = NULL;
-    struct dhcps_pool *pdhcps_pool = NULL;
-    struct dhcps_pool *pdhcps_node = NULL;
+    struct dhcps_lease *lease = &table->leases[idx];
+    u16_t prev = table->exp_tail;
 
-    if (*phead == NULL) {
-        *phead = pinsert;
+    // leases mostly share the same lease time, so this stops at the tail unless the lease time was changed
+    while (prev != DHCPS_LEASE_NONE && DHCPS_TIME_AFTER(table->leases[prev].pool.lease_timer, lease->pool.lease_timer)) {
+        prev = table->leases[prev].exp_prev;
+    }
+    lease->exp_prev = prev;
+    lease->exp_next = (prev == DHCPS_LEASE_NONE) ? table->exp_head : table->leases[prev].exp_next;
+    if (lease->exp_next == DHCPS_LEASE_NONE) {
+        table->exp_tail = idx;
+    } else {
+        table->leases[lease->exp_next].exp_prev = idx;
+    }
+    if (prev == DHCPS_LEASE_NONE) {
+        table->exp_head = idx;
     } else {
-        plist = *phead;
-        pdhcps_node = pinsert->pnode;
-        pdhcps_pool = plist->pnode;
+        table->leases[prev].exp_next = idx;
+    }
+}
 
-        if (pdhcps_node->ip.addr < pdhcps_pool->ip.addr) {
-            pinsert->pnext = plist;
-            *phead = pinsert;
-        } else {
-            while (plist->pnext != NULL) {
-                pdhcps_pool = plist->pnext->pnode;
+static void lease_expiry_unlink(struct dhcps_lease_table *table, u16_t idx)
+{
+    struct dhcps_lease *lease = &table->leases[idx];
 
-                if (pdhcps_node->ip.addr < pdhcps_pool->ip.addr) {
-                    pinsert->pnext = plist->pnext;
-                    plist->pnext = pinsert;
-                    break;
-                }
+    if (lease->exp_prev == DHCPS_LEASE_NONE) {
+        table->exp_head = lease->exp_next;
+    } else {
+        table->leases[lease->exp_prev].exp_next = lease->exp_next;
+    }
+    if (lease->exp_next == DHCPS_LEASE_NONE) {
+        table->exp_tail = lease->exp_prev;
+    } else {
+        table->leases[lease->exp_next].exp_prev = lease->exp_prev;
+    }
+}
 
-                plist = plist->pnext;
-            }
+/******************************************************************************
+ * FunctionName : lease_insert
+ * Description  : lease a free address of the pool to a client
+ * Parameters   : idx -- the lease index
+ *                mac -- the MAC address of the client
+ *                lease_timer -- the lease time, in coarse timer ticks
+ * Returns      : none
+*******************************************************************************/
+static void lease_insert(struct dhcps_lease_table *table, u16_t idx, const u8_t *mac, u32_t lease_timer)
+{
+    struct dhcps_lease *lease = &table->leases[idx];
+    u16_t bucket = lease_mac_hash(table, mac);
+
+    lease->pool.ip.addr = htonl(htonl(table->start_ip.addr) + idx);
+    memcpy(lease->pool.mac, mac, sizeof(lease->pool.mac));
+    lease->pool.lease_timer = table->now + lease_timer;
+    lease->bound = false;
+    lease->mac_next = table->mac_hash[bucket];
+    table->mac_hash[bucket] = idx;
+    table->used[idx / 32] |= 1U << (idx % 32);
+    table->count++;
+    lease_expiry_link(table, idx);
+}
 
-            if (plist->pnext == NULL) {
-                plist->pnext = pinsert;
-            }
-        }
+/******************************************************************************
+ * FunctionName : lease_remove
+ * Description  : release the address of a lease
+ * Parameters   : idx -- the lease index
+ * Returns      : none
+*******************************************************************************/
+static void lease_remove(struct dhcps_lease_table *table, u16_t idx)
+{
+    struct dhcps_lease *lease = &table->leases[idx];
+    u16_t *pnext = &table->mac_hash[lease_mac_hash(table, lease->pool.mac)];
+
+    while (*pnext != idx) {
+        pnext = &table->leases[*pnext].mac_next;
     }
+    *pnext = lease->mac_next;
+    lease_expiry_unlink(table, idx);
+    table->used[idx / 32] &= ~(1U << (idx % 32));
+    table->count--;
+}
 
-//	pinsert->pnext = NULL;
+/******************************************************************************
+ * FunctionName : lease_refresh
+ * Description  : restart the lease time of a lease
+ * Parameters   : idx -- the lease index
+ *                lease_timer -- the lease time, in coarse timer ticks
+ * Returns      : none
+*******************************************************************************/
+static void lease_refresh(struct dhcps_lease_table *table, u16_t idx, u32_t lease_timer)
+{
+    lease_expiry_unlink(table, idx);
+    table->leases[idx].pool.lease_timer = table->now + lease_timer;
+    lease_expiry_link(table, idx);
 }
 
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
 /******************************************************************************
- * FunctionName : node_delete_from_list
- * Description  : remove the node from list
- * Parameters   : phead -- the head node of the list
- *                pdelete -- the remove node of the list
+ * FunctionName : dhcps_leases_save
+ * Description  : store the bound leases in NVS
+ * Parameters   : none
  * Returns      : none
 *******************************************************************************/
-void node_remove_from_list(list_node **phead, list_node *pdelete)
+static void dhcps_leases_save(dhcps_t *dhcps)
 {
-    list_node *plist = NULL;
+    struct dhcps_lease_table *table = dhcps->lease_table;
+    struct dhcps_pool *pools;
+    size_t num_pools = 0;
 
-    plist = *phead;
+    pools = mem_calloc(table->count + 1, sizeof(struct dhcps_pool));
+    if (pools == NULL) {
+        return;     // still dirty, retried on the next timer tick
+    }
+    for (u16_t idx = table->exp_head; idx != DHCPS_LEASE_NONE; idx = table->leases[idx].exp_next) {
+        if (table->leases[idx].bound) {
+            pools[num_pools] = table->leases[idx].pool;
+            pools[num_pools].lease_timer = 0;
+            num_pools++;
+        }
+    }
+    dhcps_leases_store(dhcps->dhcps_netif, pools, num_pools);
+    free(pools);
+    dhcps->leases_dirty = false;
+    dhcps->leases_stored = table->now;
+}
 
-    if (plist == NULL) {
-        *phead = NULL;
-    } else {
-        if (plist == pdelete) {
-            // Note: Ignoring the "use after free" warnings, as it could only happen
-            // if the linked list contains loops
-            *phead = plist->pnext; // NOLINT(clang-analyzer-unix.Malloc)
-            pdelete->pnext = NULL;
-        } else {
-            while (plist != NULL) {
-                if (plist->pnext == pdelete) { // NOLINT(clang-analyzer-unix.Malloc)
-                    plist->pnext = pdelete->pnext;
-                    pdelete->pnext = NULL;
-                }
+/******************************************************************************
+ * FunctionName : dhcps_leases_load
+ * Description  : restore the leases stored in NVS, for a full lease time
+ * Parameters   : none
+ * Returns      : none
+*******************************************************************************/
+static void dhcps_leases_load(dhcps_t *dhcps)
+{
+    struct dhcps_lease_table *table = dhcps->lease_table;
+    u32_t lease_timer = (dhcps->dhcps_lease_time * DHCPS_LEASE_UNIT)/DHCPS_COARSE_TIMER_SECS;
+    struct dhcps_pool *pools;
+    size_t num_pools;
 
-                plist = plist->pnext;
-            }
+    pools = mem_calloc(table->size, sizeof(struct dhcps_pool));
+    if (pools == NULL) {
+        return;
+    }
+    num_pools = dhcps_leases_restore(dhcps->dhcps_netif, pools, table->size);
+    for (size_t i = 0; i < num_pools; i++) {
+        u32_t idx = htonl(pools[i].ip.addr) - htonl(table->start_ip.addr);
+
+        // skip the leases out of the current pool, or of a client already restored
+        if (idx >= table->size || (table->used[idx / 32] & (1U << (idx % 32)))
+                || lease_find_mac(table, pools[i].mac) != DHCPS_LEASE_NONE) {
+            continue;
         }
+        lease_insert(table, idx, pools[i].mac, lease_timer);
+        table->leases[idx].bound = true;
     }
+    free(pools);
+    dhcps->leases_dirty = false;
+    dhcps->leases_stored = table->now;
 }
+#endif /* CONFIG_LWIP_DHCPS_LEASE_PERSIST */
 
 /******************************************************************************
  * FunctionName : add_msg_type
@@ -1011,124 +1216,73 @@ static s16_t parse_msg(dhcps_t *dhcps, struct dhcps_msg *m, u16_t len)
 #if DHCPS_DEBUG
         DHCPS_LOG("dhcps: len = %d\n", len);
 #endif
-        ip4_addr_t addr_tmp;
+        struct dhcps_lease_table *table = dhcps->lease_table;
+        u16_t idx;
 
-        struct dhcps_pool *pdhcps_pool = NULL;
-        list_node *pnode = NULL;
-        list_node *pback_node = NULL;
-        ip4_addr_t first_address;
-        bool flag = false;
+        if (table == NULL) {
+            return 0;
+        }
 
-        first_address.addr = dhcps->dhcps_poll.start_ip.addr;
-        dhcps->client_address.addr = dhcps->client_address_plus.addr;
         dhcps->renew = false;
+        idx = lease_find_mac(table, m->chaddr);
 
-        if (dhcps->plist != NULL) {
-            if (dhcps->has_declined_ip) {
-                dhcps->has_declined_ip = false;
+        if (idx != DHCPS_LEASE_NONE) {
+            if (memcmp(&table->leases[idx].pool.ip.addr, m->ciaddr, sizeof(table->leases[idx].pool.ip.addr)) == 0) {
+                dhcps->renew = true;
             }
 
-            for (pback_node = dhcps->plist; pback_node != NULL; pback_node = pback_node->pnext) {
-                pdhcps_pool = pback_node->pnode;
-
-                if (memcmp(pdhcps_pool->mac, m->chaddr, sizeof(pdhcps_pool->mac)) == 0) {
-                    if (memcmp(&pdhcps_pool->ip.addr, m->ciaddr, sizeof(pdhcps_pool->ip.addr)) == 0) {
-                        dhcps->renew = true;
-                    }
-
-                    dhcps->client_address.addr = pdhcps_pool->ip.addr;
-                    pdhcps_pool->lease_timer = lease_timer;
-                    pnode = pback_node;
-                    goto POOL_CHECK;
-                } else if (pdhcps_pool->ip.addr == dhcps->client_address_plus.addr) {
-                    addr_tmp.addr = htonl(dhcps->client_address_plus.addr);
-                    addr_tmp.addr++;
-                    dhcps->client_address_plus.addr = htonl(addr_tmp.addr);
-                    dhcps->client_address.addr = dhcps->client_address_plus.addr;
-                }
+            dhcps->client_address.addr = table->leases[idx].pool.ip.addr;
+            lease_refresh(table, idx, lease_timer);
+        } else {
+            // the next free address after the last leased one, then the first free address of the pool;
+            // the server goes back to the start of an empty pool, unless the last address was declined
+            u32_t from = htonl(dhcps->client_address_plus.addr) - htonl(table->start_ip.addr);
 
-                if (flag == false) { // search the first unused ip
-                    if (first_address.addr < pdhcps_pool->ip.addr) {
-                        flag = true;
-                    } else {
-                        addr_tmp.addr = htonl(first_address.addr);
-                        addr_tmp.addr++;
-                        first_address.addr = htonl(addr_tmp.addr);
-                    }
-                }
+            if (table->count == 0 && !dhcps->has_declined_ip) {
+                from = 0;
             }
-        } else {
-            if (dhcps->has_declined_ip) {
-                dhcps->has_declined_ip = false;
-            } else {
-                dhcps->client_address.addr = dhcps->dhcps_poll.start_ip.addr;
+            idx = lease_find_free(table, from);
+            if (idx == DHCPS_LEASE_NONE && from != 0) {
+                idx = lease_find_free(table, 0);
             }
-        }
-
-        if (dhcps->client_address_plus.addr > dhcps->dhcps_poll.end_ip.addr) {
-            dhcps->client_address.addr = first_address.addr;
-        }
-
-        if (dhcps->client_address.addr > dhcps->dhcps_poll.end_ip.addr) {
-            dhcps->client_address_plus.addr = dhcps->dhcps_poll.start_ip.addr;
-            pdhcps_pool = NULL;
-            pnode = NULL;
-        } else {
-            pdhcps_pool = (struct dhcps_pool *)mem_calloc(1, sizeof(struct dhcps_pool));
-
-            pdhcps_pool->ip.addr = dhcps->client_address.addr;
-            memcpy(pdhcps_pool->mac, m->chaddr, sizeof(pdhcps_pool->mac));
-            pdhcps_pool->lease_timer = lease_timer;
-            pnode = (list_node *)mem_calloc(1, sizeof(list_node));
 
-            pnode->pnode = pdhcps_pool;
-            pnode->pnext = NULL;
-            node_insert_to_list(&dhcps->plist, pnode);
-
-            if (dhcps->client_address.addr == dhcps->dhcps_poll.end_ip.addr) {
-                dhcps->client_address_plus.addr = dhcps->dhcps_poll.start_ip.addr;
+            if (idx == DHCPS_LEASE_NONE) {
+                dhcps->client_address_plus.addr = table->start_ip.addr;
+                ip4_addr_set_zero(&dhcps->client_address);
             } else {
-                addr_tmp.addr = htonl(dhcps->client_address.addr);
-                addr_tmp.addr++;
-                dhcps->client_address_plus.addr = htonl(addr_tmp.addr);
-            }
-        }
-
-POOL_CHECK:
+                lease_insert(table, idx, m->chaddr, lease_timer);
+                dhcps->client_address.addr = table->leases[idx].pool.ip.addr;
 
-        if ((dhcps->client_address.addr > dhcps->dhcps_poll.end_ip.addr) || (ip4_addr_isany(&dhcps->client_address))) {
-            if (pnode != NULL) {
-                node_remove_from_list(&dhcps->plist, pnode);
-                free(pnode);
-                pnode = NULL;
-            }
-
-            if (pdhcps_pool != NULL) {
-                free(pdhcps_pool);
-                pdhcps_pool = NULL;
+                if (idx + 1 == table->size) {
+                    dhcps->client_address_plus.addr = table->start_ip.addr;
+                } else {
+                    dhcps->client_address_plus.addr = htonl(htonl(dhcps->client_address.addr) + 1);
+                }
             }
+        }
+        dhcps->has_declined_ip = false;
 
+        if (ip4_addr_isany(&dhcps->client_address)) {
             return 4;
         }
 
-        s16_t ret = parse_options(dhcps, &m->options[4], len);;
+        s16_t ret = parse_options(dhcps, &m->options[4], len);
 
         if (ret == DHCPS_STATE_RELEASE || ret == DHCPS_STATE_NAK || ret ==  DHCPS_STATE_DECLINE) {
-            if (pnode != NULL) {
-                node_remove_from_list(&dhcps->plist, pnode);
-                free(pnode);
-                pnode = NULL;
-            }
-
-            if (pdhcps_pool != NULL) {
-                free(pdhcps_pool);
-                pdhcps_pool = NULL;
-            }
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+            dhcps->leases_dirty |= table->leases[idx].bound;
+#endif
+            lease_remove(table, idx);
 
             if (ret ==  DHCPS_STATE_DECLINE) {
                 dhcps->has_declined_ip = true;
             }
             memset(&dhcps->client_address, 0x0, sizeof(dhcps->client_address));
+        } else if (ret == DHCPS_STATE_ACK && !table->leases[idx].bound) {
+            table->leases[idx].bound = true;
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+            dhcps->leases_dirty = true;
+#endif
         }
 
 #if DHCPS_DEBUG
@@ -1383,6 +1537,20 @@ err_t dhcps_start(dhcps_t *dhcps, struct netif *netif, ip4_addr_t ip)
 
     dhcps->client_address_plus.addr = dhcps->dhcps_poll.start_ip.addr;
 
+    if (dhcps->lease_table != NULL) {
+        free(dhcps->lease_table);
+    }
+    dhcps->lease_table = lease_table_new(dhcps->dhcps_poll.start_ip, dhcps->dhcps_poll.end_ip);
+    if (dhcps->lease_table == NULL) {
+        DHCPS_LOG("dhcps_start(): could not allocate the lease table\n");
+        udp_remove(dhcps->dhcps_pcb);
+        dhcps->dhcps_pcb = NULL;
+        return ERR_MEM;
+    }
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+    dhcps_leases_load(dhcps);
+#endif
+
     udp_bind_netif(dhcps->dhcps_pcb, dhcps->dhcps_netif);
     udp_bind(dhcps->dhcps_pcb, &netif->ip_addr, DHCPS_SERVER_PORT);
     udp_recv(dhcps->dhcps_pcb, handle_dhcp, dhcps);
@@ -1415,18 +1583,14 @@ err_t dhcps_stop(dhcps_t *dhcps, struct netif *netif)
         dhcps->dhcps_pcb = NULL;
     }
 
-    list_node *pnode = NULL;
-    list_node *pback_node = NULL;
-    pnode = dhcps->plist;
-
-    while (pnode != NULL) {
-        pback_node = pnode;
-        pnode = pback_node->pnext;
-        node_remove_from_list(&dhcps->plist, pback_node);
-        free(pback_node->pnode);
-        pback_node->pnode = NULL;
-        free(pback_node);
-        pback_node = NULL;
+    if (dhcps->lease_table != NULL) {
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+        if (dhcps->leases_dirty) {
+            dhcps_leases_save(dhcps);
+        }
+#endif
+        free(dhcps->lease_table);
+        dhcps->lease_table = NULL;
     }
     sys_untimeout(dhcps_tmr, dhcps);
     dhcps->state = DHCPS_HANDLE_STOPPED;
@@ -1435,42 +1599,18 @@ err_t dhcps_stop(dhcps_t *dhcps, struct netif *netif)
 
 /******************************************************************************
  * FunctionName : kill_oldest_dhcps_pool
- * Description  : remove the oldest node from list
+ * Description  : remove the lease which expires first
  * Parameters   : none
  * Returns      : none
 *******************************************************************************/
 static void kill_oldest_dhcps_pool(dhcps_t *dhcps)
 {
-    list_node *pre = NULL, *p = NULL;
-    list_node *minpre = NULL, *minp = NULL;
-    struct dhcps_pool *pdhcps_pool = NULL, *pmin_pool = NULL;
-    pre = dhcps->plist;
-    assert(pre != NULL && pre->pnext != NULL); // Expect the list to have at least 2 nodes
-    p = pre->pnext;
-    minpre = pre;
-    minp = pre;
-
-    while (p != NULL) {
-        pdhcps_pool = p->pnode;
-        pmin_pool = minp->pnode;
-
-        if (pdhcps_pool->lease_timer < pmin_pool->lease_timer) {
-            minp = p;
-            minpre = pre;
-        }
-
-        pre = p;
-        p = p->pnext;
-    }
-    if (minp == dhcps->plist) {
-        dhcps->plist = minp->pnext;
-    } else {
-        minpre->pnext = minp->pnext;
-    }
-    free(minp->pnode);
-    minp->pnode = NULL;
-    free(minp);
-    minp = NULL;
+    struct dhcps_lease_table *table = dhcps->lease_table;
+    assert(table->exp_head != DHCPS_LEASE_NONE);
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+    dhcps->leases_dirty |= table->leases[table->exp_head].bound;
+#endif
+    lease_remove(table, table->exp_head);
 }
 
 /******************************************************************************
@@ -1484,6 +1624,7 @@ static void dhcps_tmr(void *arg)
     dhcps_t *dhcps = arg;
     dhcps_handle_state state = dhcps->state;
     if (state == DHCPS_HANDLE_DELETE_PENDING) {
+        free(dhcps->lease_table);
         free(dhcps);
         return;
     }
@@ -1492,33 +1633,29 @@ static void dhcps_tmr(void *arg)
         return;
     }
     sys_timeout(DHCP_COARSE_TIMER_MSECS, dhcps_tmr, dhcps);
-    u8_t num_dhcps_pool = 0;
-    list_node *pback_node = NULL;
-    list_node *pnode = NULL;
-    struct dhcps_pool *pdhcps_pool = NULL;
-    pnode = dhcps->plist;
-
-    while (pnode != NULL) {
-        pdhcps_pool = pnode->pnode;
-        pdhcps_pool->lease_timer --;
-
-        if (pdhcps_pool->lease_timer == 0) {
-            pback_node = pnode;
-            pnode = pback_node->pnext;
-            node_remove_from_list(&dhcps->plist, pback_node);
-            free(pback_node->pnode);
-            pback_node->pnode = NULL;
-            free(pback_node);
-            pback_node = NULL;
-        } else {
-            pnode = pnode ->pnext;
-            num_dhcps_pool ++;
-        }
+    struct dhcps_lease_table *table = dhcps->lease_table;
+    if (table == NULL) {
+        return;
+    }
+    table->now++;
+
+    // the expiry list is sorted, only the expired leases are visited
+    while (table->exp_head != DHCPS_LEASE_NONE
+            && !DHCPS_TIME_AFTER(table->leases[table->exp_head].pool.lease_timer, table->now)) {
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+        dhcps->leases_dirty |= table->leases[table->exp_head].bound;
+#endif
+        lease_remove(table, table->exp_head);
     }
 
-    if (num_dhcps_pool > MAX_STATION_NUM) {
+    if (table->count > MAX_STATION_NUM) {
         kill_oldest_dhcps_pool(dhcps);
     }
+#if CONFIG_LWIP_DHCPS_LEASE_PERSIST
+    if (dhcps->leases_dirty && table->now - dhcps->leases_stored >= DHCPS_LEASE_STORE_DELAY_SECS / DHCPS_COARSE_TIMER_SECS) {
+        dhcps_leases_save(dhcps);
+    }
+#endif
 }
 
 /******************************************************************************
@@ -1530,25 +1667,18 @@ static void dhcps_tmr(void *arg)
 *******************************************************************************/
 bool dhcp_search_ip_on_mac(dhcps_t *dhcps, u8_t *mac, ip4_addr_t *ip)
 {
-    struct dhcps_pool *pdhcps_pool = NULL;
-    list_node *pback_node = NULL;
-    bool ret = false;
+    u16_t idx;
 
-    if (dhcps == NULL) {
+    if (dhcps == NULL || dhcps->lease_table == NULL) {
         return false;
     }
 
-    for (pback_node = dhcps->plist; pback_node != NULL; pback_node = pback_node->pnext) {
-        pdhcps_pool = pback_node->pnode;
-
-        if (memcmp(pdhcps_pool->mac, mac, sizeof(pdhcps_pool->mac)) == 0) {
-            memcpy(&ip->addr, &pdhcps_pool->ip.addr, sizeof(pdhcps_pool->ip.addr));
-            ret = true;
-            break;
-        }
+    idx = lease_find_mac(dhcps->lease_table, mac);
+    if (idx == DHCPS_LEASE_NONE) {
+        return false;
     }
-
-    return ret;
+    memcpy(&ip->addr, &dhcps->lease_table->leases[idx].pool.ip.addr, sizeof(ip->addr));
+    return true;
 }
 
 /******************************************************************************
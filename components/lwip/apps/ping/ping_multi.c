@@ -0,0 +1,731 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <sys/time.h>
+#include <net/if.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "lwip/opt.h"
+#include "lwip/mem.h"
+#include "lwip/icmp.h"
+#include "lwip/sys.h"
+#include "lwip/inet.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/ip.h"
+#include "lwip/sockets.h"
+#include "esp_log.h"
+#include "ping/ping_multi.h"
+#include "esp_check.h"
+
+const static char *TAG = "ping_multi";
+
+#define PING_CHECK_START_TIMEOUT_MS (1000)
+
+#define PING_FLAGS_INIT (1 << 0)
+#define PING_FLAGS_START (1 << 1)
+
+#define IP_ICMP_HDR_SIZE (64)   // 64 bytes are enough to cover IP header and ICMP header
+
+/*
+ * Timeouts and intervals of all targets are kept in a hashed timer wheel of
+ * 8 ms ticks. Deadlines beyond one revolution stay in their slot until they
+ * are reached. Both sizes are powers of two so that the slot of a deadline
+ * doesn't change when sys_now() wraps.
+ */
+#define PING_WHEEL_TICK_SHIFT (3)
+#define PING_WHEEL_TICK_MS (1 << PING_WHEEL_TICK_SHIFT)
+#define PING_WHEEL_SLOTS (64)
+#define PING_WHEEL_SLOT(ms) (((ms) >> PING_WHEEL_TICK_SHIFT) & (PING_WHEEL_SLOTS - 1))
+
+/* Longest sleep of the ping task, so that new targets and stop/delete requests are noticed */
+#define PING_MAX_WAIT_MS (100)
+
+/* The ICMP sequence number carries the target index in its high byte and the target's own sequence number in the low byte */
+#define PING_SEQNO(index, seq) ((uint16_t)(((index) << 8) | ((seq) & 0xFF)))
+#define PING_SEQNO_TARGET(seqno) ((seqno) >> 8)
+
+#define PING_TIME_REACHED(now, t) ((int32_t)((now) - (t)) >= 0)
+
+typedef enum {
+    PING_FAMILY_V4,
+    PING_FAMILY_V6,
+    PING_FAMILY_MAX,
+} ping_family_t;
+
+typedef struct ping_target {
+    struct ping_target *wheel_next;
+    struct ping_target **wheel_pprev;   // NULL when the target is not in the wheel
+    uint32_t expiry_ms;
+    ip_addr_t addr;
+    struct sockaddr_storage sockaddr;
+    ping_family_t family;
+    bool in_use;
+    bool waiting;                       // an echo request is waiting for its reply
+    bool finished;
+    uint32_t count;
+    uint16_t seqno;
+    uint16_t wire_seqno;                // ICMP sequence number of the request, network order
+    uint32_t sent_ms;
+    esp_ping_multi_stats_t stats;
+} ping_target_t;
+
+typedef struct {
+    int sock[PING_FAMILY_MAX];
+    TaskHandle_t ping_task_hdl;
+    SemaphoreHandle_t lock;
+    struct icmp_echo_hdr *packet_hdr;
+    uint32_t icmp_pkt_size;
+    uint16_t id;
+    uint32_t interval_ms;
+    uint32_t timeout_ms;
+    int tos;
+    int ttl;
+    uint32_t interface;
+    uint32_t max_targets;
+    ping_target_t *targets;
+    ping_target_t *wheel[PING_WHEEL_SLOTS];
+    uint32_t wheel_ms;                  // start of the first tick not processed yet
+    bool running;
+    volatile uint32_t flags;
+    void (*on_ping_success)(esp_ping_multi_handle_t hdl, const esp_ping_multi_result_t *result, void *args);
+    void (*on_ping_timeout)(esp_ping_multi_handle_t hdl, const esp_ping_multi_result_t *result, void *args);
+    void (*on_ping_end)(esp_ping_multi_handle_t hdl, int target, void *args);
+    void *cb_args;
+} esp_ping_multi_t;
+
+static inline void ping_lock(esp_ping_multi_t *ep)
+{
+    xSemaphoreTakeRecursive(ep->lock, portMAX_DELAY);
+}
+
+static inline void ping_unlock(esp_ping_multi_t *ep)
+{
+    xSemaphoreGiveRecursive(ep->lock);
+}
+
+static inline int ping_target_index(esp_ping_multi_t *ep, ping_target_t *t)
+{
+    return t - ep->targets;
+}
+
+static void ping_wheel_remove(ping_target_t *t)
+{
+    if (t->wheel_pprev) {
+        *t->wheel_pprev = t->wheel_next;
+        if (t->wheel_next) {
+            t->wheel_next->wheel_pprev = t->wheel_pprev;
+        }
+        t->wheel_next = NULL;
+        t->wheel_pprev = NULL;
+    }
+}
+
+static void ping_wheel_insert(esp_ping_multi_t *ep, ping_target_t *t, uint32_t expiry_ms)
+{
+    /* deadlines in ticks already processed go to the next tick to process */
+    ping_target_t **head = &ep->wheel[PING_WHEEL_SLOT(PING_TIME_REACHED(expiry_ms, ep->wheel_ms) ? expiry_ms : ep->wheel_ms)];
+    t->expiry_ms = expiry_ms;
+    t->wheel_next = *head;
+    if (*head) {
+        (*head)->wheel_pprev = &t->wheel_next;
+    }
+    *head = t;
+    t->wheel_pprev = head;
+}
+
+static void ping_fill_result(esp_ping_multi_t *ep, ping_target_t *t, esp_ping_multi_result_t *result)
+{
+    memset(result, 0, sizeof(*result));
+    result->target = ping_target_index(ep, t);
+    ip_addr_copy(result->target_addr, t->addr);
+    result->seqno = t->seqno;
+}
+
+static void ping_target_schedule_next(esp_ping_multi_t *ep, ping_target_t *t, uint32_t now)
+{
+    /* the target may have been removed from a callback */
+    if (!t->in_use || !ep->running) {
+        return;
+    }
+    if (t->count && t->seqno >= t->count) {
+        t->finished = true;
+        if (ep->on_ping_end) {
+            ep->on_ping_end((esp_ping_multi_handle_t)ep, ping_target_index(ep, t), ep->cb_args);
+        }
+        return;
+    }
+    uint32_t next_ms = t->sent_ms + ep->interval_ms;
+    ping_wheel_insert(ep, t, PING_TIME_REACHED(now, next_ms) ? now : next_ms);
+}
+
+static void ping_target_send(esp_ping_multi_t *ep, ping_target_t *t, uint32_t now)
+{
+    struct icmp_echo_hdr *hdr = ep->packet_hdr;
+
+    t->seqno++;
+    t->wire_seqno = lwip_htons(PING_SEQNO(ping_target_index(ep, t), t->seqno));
+    hdr->id = ep->id;
+    hdr->seqno = t->wire_seqno;
+    hdr->chksum = 0;
+#if CONFIG_LWIP_IPV4
+    if (t->family == PING_FAMILY_V4) {
+        hdr->type = ICMP_ECHO;
+        hdr->chksum = inet_chksum(hdr, ep->icmp_pkt_size);
+    }
+#endif
+#if CONFIG_LWIP_IPV6
+    if (t->family == PING_FAMILY_V6) {
+        /* ICMPv6 checksum is computed by the stack */
+        hdr->type = ICMP6_TYPE_EREQ;
+    }
+#endif
+
+    ssize_t sent = sendto(ep->sock[t->family], hdr, ep->icmp_pkt_size, 0,
+                          (struct sockaddr *)&t->sockaddr, sizeof(t->sockaddr));
+    if (sent == (ssize_t)ep->icmp_pkt_size) {
+        t->stats.transmitted++;
+    } else {
+        ESP_LOGD(TAG, "target %d send error=%d", ping_target_index(ep, t), errno);
+    }
+    /* a failed request just times out, like a lost one */
+    t->sent_ms = now;
+    t->waiting = true;
+    ping_wheel_insert(ep, t, now + ep->timeout_ms);
+}
+
+static void ping_target_expired(esp_ping_multi_t *ep, ping_target_t *t, uint32_t now)
+{
+    if (!t->waiting) {
+        ping_target_send(ep, t, now);
+        return;
+    }
+    t->waiting = false;
+    t->stats.timeouts++;
+    if (ep->on_ping_timeout) {
+        esp_ping_multi_result_t result;
+        ping_fill_result(ep, t, &result);
+        result.elapsed_time_ms = ep->timeout_ms;
+        ep->on_ping_timeout((esp_ping_multi_handle_t)ep, &result, ep->cb_args);
+    }
+    ping_target_schedule_next(ep, t, now);
+}
+
+/* Fires the expired targets of the wheel, returns how long the task may sleep */
+static uint32_t ping_multi_run_timers(esp_ping_multi_t *ep)
+{
+    uint32_t now = sys_now();
+
+    /* a tick is processed once it is over, so all its deadlines are reached */
+    for (int i = 0; i < PING_WHEEL_SLOTS && PING_TIME_REACHED(now, ep->wheel_ms + PING_WHEEL_TICK_MS - 1); i++) {
+        ping_target_t **head = &ep->wheel[PING_WHEEL_SLOT(ep->wheel_ms)];
+        ping_target_t *t = *head;
+        while (t) {
+            if (PING_TIME_REACHED(now, t->expiry_ms)) {
+                ping_wheel_remove(t);
+                ping_target_expired(ep, t, now);
+                /* callbacks may have changed the slot, start over */
+                t = *head;
+            } else {
+                t = t->wheel_next;
+            }
+        }
+        ep->wheel_ms += PING_WHEEL_TICK_MS;
+    }
+    if (PING_TIME_REACHED(now, ep->wheel_ms + PING_WHEEL_TICK_MS - 1)) {
+        /* late by more than a revolution, every slot has been run once */
+        ep->wheel_ms = now & ~(PING_WHEEL_TICK_MS - 1);
+        return 0;
+    }
+
+    for (uint32_t ms = ep->wheel_ms; (int32_t)(ms - now) < PING_MAX_WAIT_MS; ms += PING_WHEEL_TICK_MS) {
+        if (ep->wheel[PING_WHEEL_SLOT(ms)]) {
+            return ms + PING_WHEEL_TICK_MS - 1 - now;
+        }
+    }
+    return PING_MAX_WAIT_MS;
+}
+
+static bool ping_addr_match(const ip_addr_t *target, const ip_addr_t *from)
+{
+#if CONFIG_LWIP_IPV4
+    if (IP_IS_V4(target) && IP_IS_V4(from)) {
+        return ip4_addr_eq(ip_2_ip4(target), ip_2_ip4(from));
+    }
+#endif
+#if CONFIG_LWIP_IPV6
+    if (IP_IS_V6(target) && IP_IS_V6(from)) {
+        return ip6_addr_zoneless_eq(ip_2_ip6(target), ip_2_ip6(from));
+    }
+#endif
+    return false;
+}
+
+static void ping_multi_handle_reply(esp_ping_multi_t *ep, char *buf, int len, struct sockaddr_storage *from)
+{
+    uint32_t now = sys_now();
+    esp_ping_multi_result_t result;
+    ip_addr_t recv_addr;
+    uint16_t id, seqno;
+    uint8_t ttl = 0, tos = 0;
+    uint32_t recv_len;
+
+#if CONFIG_LWIP_IPV4
+    if (from->ss_family == AF_INET) {
+        struct sockaddr_in *from4 = (struct sockaddr_in *)from;
+        struct ip_hdr *iphdr = (struct ip_hdr *)buf;
+        if (len < (int)sizeof(struct ip_hdr) || len < IPH_HL_BYTES(iphdr) + (int)sizeof(struct icmp_echo_hdr)) {
+            return;
+        }
+        struct icmp_echo_hdr *iecho = (struct icmp_echo_hdr *)(buf + IPH_HL_BYTES(iphdr));
+        if (ICMPH_TYPE(iecho) != ICMP_ER) {
+            return;
+        }
+        inet_addr_to_ip4addr(ip_2_ip4(&recv_addr), &from4->sin_addr);
+        IP_SET_TYPE_VAL(recv_addr, IPADDR_TYPE_V4);
+        id = iecho->id;
+        seqno = iecho->seqno;
+        ttl = IPH_TTL(iphdr);
+        tos = IPH_TOS(iphdr);
+        recv_len = lwip_ntohs(IPH_LEN(iphdr)) - IPH_HL_BYTES(iphdr) - sizeof(struct icmp_echo_hdr);   // The data portion of ICMP
+    } else
+#endif
+#if CONFIG_LWIP_IPV6
+    if (from->ss_family == AF_INET6) {
+        struct sockaddr_in6 *from6 = (struct sockaddr_in6 *)from;
+        struct ip6_hdr *iphdr = (struct ip6_hdr *)buf;
+        if (len < (int)(sizeof(struct ip6_hdr) + sizeof(struct icmp6_echo_hdr))) {
+            return;
+        }
+        struct icmp6_echo_hdr *iecho6 = (struct icmp6_echo_hdr *)(buf + sizeof(struct ip6_hdr)); // IPv6 head length is 40
+        if (iecho6->type != ICMP6_TYPE_EREP) {
+            return;
+        }
+        inet6_addr_to_ip6addr(ip_2_ip6(&recv_addr), &from6->sin6_addr);
+        IP_SET_TYPE_VAL(recv_addr, IPADDR_TYPE_V6);
+        id = iecho6->id;
+        seqno = iecho6->seqno;
+        recv_len = IP6H_PLEN(iphdr) - sizeof(struct icmp6_echo_hdr); //The data portion of ICMPv6
+    } else
+#endif
+    {
+        return;
+    }
+
+    /* match the reply to its target by id and sequence number, the address must match as well */
+    uint32_t index = PING_SEQNO_TARGET(lwip_ntohs(seqno));
+    if (id != ep->id || index >= ep->max_targets) {
+        return;
+    }
+    ping_target_t *t = &ep->targets[index];
+    if (!t->in_use || !t->waiting || t->wire_seqno != seqno || !ping_addr_match(&t->addr, &recv_addr)) {
+        return;
+    }
+
+    ping_wheel_remove(t);
+    t->waiting = false;
+
+    uint32_t rtt = now - t->sent_ms;
+    esp_ping_multi_stats_t *stats = &t->stats;
+    stats->received++;
+    if (stats->received == 1 || rtt < stats->rtt_min_ms) {
+        stats->rtt_min_ms = rtt;
+    }
+    if (rtt > stats->rtt_max_ms) {
+        stats->rtt_max_ms = rtt;
+    }
+    stats->rtt_total_ms += rtt;
+    int bucket = 0;
+    while (bucket < ESP_PING_MULTI_RTT_BUCKETS - 1 && (rtt >> bucket)) {
+        bucket++;
+    }
+    stats->rtt_hist[bucket]++;
+
+    if (ep->on_ping_success) {
+        ping_fill_result(ep, t, &result);
+        result.ttl = ttl;
+        result.tos = tos;
+        result.recv_len = recv_len;
+        result.elapsed_time_ms = rtt;
+        ep->on_ping_success((esp_ping_multi_handle_t)ep, &result, ep->cb_args);
+    }
+    ping_target_schedule_next(ep, t, now);
+}
+
+static void ping_multi_receive(esp_ping_multi_t *ep, int sock)
+{
+    char buf[IP_ICMP_HDR_SIZE];
+    struct sockaddr_storage from;
+    socklen_t fromlen = sizeof(from);
+    int len;
+
+    while ((len = recvfrom(sock, buf, sizeof(buf), MSG_DONTWAIT, (struct sockaddr *)&from, &fromlen)) > 0) {
+        ping_multi_handle_reply(ep, buf, len, &from);
+        fromlen = sizeof(from);
+    }
+}
+
+static void ping_multi_poll(esp_ping_multi_t *ep, uint32_t wait_ms)
+{
+    fd_set readset;
+    int maxfd = -1;
+
+    FD_ZERO(&readset);
+    for (int i = 0; i < PING_FAMILY_MAX; i++) {
+        if (ep->sock[i] >= 0) {
+            FD_SET(ep->sock[i], &readset);
+            maxfd = LWIP_MAX(maxfd, ep->sock[i]);
+        }
+    }
+    if (maxfd < 0) {
+        vTaskDelay(pdMS_TO_TICKS(wait_ms) + 1);
+        return;
+    }
+
+    struct timeval timeout = {
+        .tv_sec = wait_ms / 1000,
+        .tv_usec = (wait_ms % 1000) * 1000,
+    };
+    if (select(maxfd + 1, &readset, NULL, NULL, &timeout) <= 0) {
+        return;
+    }
+    ping_lock(ep);
+    for (int i = 0; i < PING_FAMILY_MAX; i++) {
+        if (ep->sock[i] >= 0 && FD_ISSET(ep->sock[i], &readset)) {
+            ping_multi_receive(ep, ep->sock[i]);
+        }
+    }
+    ping_unlock(ep);
+}
+
+static void ping_multi_begin(esp_ping_multi_t *ep)
+{
+    uint32_t now = sys_now();
+    uint32_t active = 0, n = 0;
+
+    ep->wheel_ms = now & ~(PING_WHEEL_TICK_MS - 1);
+    ep->running = true;
+    for (uint32_t i = 0; i < ep->max_targets; i++) {
+        active += ep->targets[i].in_use;
+    }
+    /* spread the first requests over one interval rather than sending them in a burst */
+    for (uint32_t i = 0; i < ep->max_targets; i++) {
+        ping_target_t *t = &ep->targets[i];
+        if (t->in_use) {
+            memset(&t->stats, 0, sizeof(t->stats));
+            t->seqno = 0;
+            t->waiting = false;
+            t->finished = false;
+            ping_wheel_insert(ep, t, now + (uint32_t)((uint64_t)n++ * ep->interval_ms / active));
+        }
+    }
+}
+
+static void ping_multi_end(esp_ping_multi_t *ep)
+{
+    ep->running = false;
+    for (uint32_t i = 0; i < ep->max_targets; i++) {
+        ping_target_t *t = &ep->targets[i];
+        ping_wheel_remove(t);
+        t->waiting = false;
+        if (t->in_use && !t->finished) {
+            t->finished = true;
+            if (ep->on_ping_end) {
+                ep->on_ping_end((esp_ping_multi_handle_t)ep, i, ep->cb_args);
+            }
+        }
+    }
+}
+
+static void esp_ping_multi_thread(void *args)
+{
+    esp_ping_multi_t *ep = (esp_ping_multi_t *)(args);
+
+    while (ep->flags & PING_FLAGS_INIT) {
+        if (!ep->running) {
+            /* wait for ping start signal */
+            if (!(ep->flags & PING_FLAGS_START)) {
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PING_CHECK_START_TIMEOUT_MS));
+                continue;
+            }
+            ping_lock(ep);
+            ping_multi_begin(ep);
+            ping_unlock(ep);
+        }
+        if (!(ep->flags & PING_FLAGS_START)) {
+            ping_lock(ep);
+            ping_multi_end(ep);
+            ping_unlock(ep);
+            continue;
+        }
+        ping_lock(ep);
+        uint32_t wait_ms = ping_multi_run_timers(ep);
+        ping_unlock(ep);
+        ping_multi_poll(ep, wait_ms);
+    }
+
+    /* before exit task, free all resources */
+    for (int i = 0; i < PING_FAMILY_MAX; i++) {
+        if (ep->sock[i] >= 0) {
+            close(ep->sock[i]);
+        }
+    }
+    vSemaphoreDelete(ep->lock);
+    free(ep->targets);
+    free(ep->packet_hdr);
+    free(ep);
+    vTaskDelete(NULL);
+}
+
+static int ping_multi_open_socket(esp_ping_multi_t *ep, ping_family_t family)
+{
+    int sock = -1;
+#if CONFIG_LWIP_IPV4
+    if (family == PING_FAMILY_V4) {
+        sock = socket(AF_INET, SOCK_RAW, IP_PROTO_ICMP);
+    }
+#endif
+#if CONFIG_LWIP_IPV6
+    if (family == PING_FAMILY_V6) {
+        sock = socket(AF_INET6, SOCK_RAW, IP6_NEXTH_ICMP6);
+    }
+#endif
+    if (sock < 0) {
+        ESP_LOGE(TAG, "create socket failed: %d", sock);
+        return -1;
+    }
+    /* set if index */
+    if (ep->interface) {
+        struct ifreq iface;
+        if (if_indextoname(ep->interface, iface.ifr_name) == NULL) {
+            ESP_LOGE(TAG, "fail to find interface name with netif index %" PRIu32, ep->interface);
+            goto err;
+        }
+        if (setsockopt(sock, SOL_SOCKET, SO_BINDTODEVICE, &iface, sizeof(iface)) != 0) {
+            ESP_LOGE(TAG, "fail to setsockopt SO_BINDTODEVICE");
+            goto err;
+        }
+    }
+    if (family == PING_FAMILY_V4) {
+        /* set tos */
+        setsockopt(sock, IPPROTO_IP, IP_TOS, &ep->tos, sizeof(ep->tos));
+        /* set ttl */
+        setsockopt(sock, IPPROTO_IP, IP_TTL, &ep->ttl, sizeof(ep->ttl));
+    }
+    return sock;
+err:
+    close(sock);
+    return -1;
+}
+
+esp_err_t esp_ping_multi_new_session(const esp_ping_multi_config_t *config, const esp_ping_multi_callbacks_t *cbs,
+                                     esp_ping_multi_handle_t *hdl_out)
+{
+    esp_err_t ret = ESP_FAIL;
+    esp_ping_multi_t *ep = NULL;
+    ESP_GOTO_ON_FALSE(config, ESP_ERR_INVALID_ARG, err, TAG, "ping config can't be null");
+    ESP_GOTO_ON_FALSE(hdl_out, ESP_ERR_INVALID_ARG, err, TAG, "ping handle can't be null");
+    ESP_GOTO_ON_FALSE(config->max_targets && config->max_targets <= ESP_PING_MULTI_MAX_TARGETS, ESP_ERR_INVALID_ARG,
+                      err, TAG, "invalid number of targets: %" PRIu32, config->max_targets);
+    ESP_GOTO_ON_FALSE(config->timeout_ms, ESP_ERR_INVALID_ARG, err, TAG, "ping timeout can't be zero");
+
+    ep = mem_calloc(1, sizeof(esp_ping_multi_t));
+    ESP_GOTO_ON_FALSE(ep, ESP_ERR_NO_MEM, err, TAG, "no memory for esp_ping_multi object");
+    for (int i = 0; i < PING_FAMILY_MAX; i++) {
+        ep->sock[i] = -1;
+    }
+
+    ep->targets = mem_calloc(config->max_targets, sizeof(ping_target_t));
+    ESP_GOTO_ON_FALSE(ep->targets, ESP_ERR_NO_MEM, err, TAG, "no memory for ping targets");
+    ep->lock = xSemaphoreCreateRecursiveMutex();
+    ESP_GOTO_ON_FALSE(ep->lock, ESP_ERR_NO_MEM, err, TAG, "no memory for ping lock");
+
+    /* callback functions */
+    if (cbs) {
+        ep->cb_args = cbs->cb_args;
+        ep->on_ping_end = cbs->on_ping_end;
+        ep->on_ping_timeout = cbs->on_ping_timeout;
+        ep->on_ping_success = cbs->on_ping_success;
+    }
+    /* set parameters for ping */
+    ep->max_targets = config->max_targets;
+    ep->interval_ms = config->interval_ms;
+    ep->timeout_ms = config->timeout_ms;
+    ep->tos = config->tos;
+    ep->ttl = config->ttl;
+    ep->interface = config->interface;
+    ep->icmp_pkt_size = sizeof(struct icmp_echo_hdr) + config->data_size;
+    ep->packet_hdr = mem_calloc(1, ep->icmp_pkt_size);
+    ESP_GOTO_ON_FALSE(ep->packet_hdr, ESP_ERR_NO_MEM, err, TAG, "no memory for echo packet");
+    /* fill the additional data buffer with some data */
+    char *d = (char *)(ep->packet_hdr) + sizeof(struct icmp_echo_hdr);
+    for (uint32_t i = 0; i < config->data_size; i++) {
+        d[i] = 'A' + i;
+    }
+
+    /* set INIT flag, so that ping task won't exit (must set before create ping task) */
+    ep->flags |= PING_FLAGS_INIT;
+
+    /* create ping thread */
+    BaseType_t xReturned = xTaskCreate(esp_ping_multi_thread, "ping_multi", config->task_stack_size, ep,
+                                       config->task_prio, &ep->ping_task_hdl);
+    ESP_GOTO_ON_FALSE(xReturned == pdTRUE, ESP_ERR_NO_MEM, err, TAG, "create ping task failed");
+    /* ping id should be unique, treat task handle as ping ID */
+    ep->id = ((intptr_t)ep->ping_task_hdl) & 0xFFFF;
+
+    /* return ping handle to user */
+    *hdl_out = (esp_ping_multi_handle_t)ep;
+    return ESP_OK;
+err:
+    if (ep) {
+        if (ep->lock) {
+            vSemaphoreDelete(ep->lock);
+        }
+        free(ep->packet_hdr);
+        free(ep->targets);
+        free(ep);
+    }
+    return ret;
+}
+
+esp_err_t esp_ping_multi_delete_session(esp_ping_multi_handle_t hdl)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ping_multi_t *ep = (esp_ping_multi_t *)hdl;
+    ESP_GOTO_ON_FALSE(ep, ESP_ERR_INVALID_ARG, err, TAG, "ping handle can't be null");
+    /* reset init flags, then ping task will exit */
+    ep->flags &= ~PING_FLAGS_INIT;
+    xTaskNotifyGive(ep->ping_task_hdl);
+    return ESP_OK;
+err:
+    return ret;
+}
+
+esp_err_t esp_ping_multi_add_target(esp_ping_multi_handle_t hdl, const ip_addr_t *target_addr, uint32_t count,
+                                    int *target_out)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ping_multi_t *ep = (esp_ping_multi_t *)hdl;
+    ping_target_t *t = NULL;
+    ip_addr_t addr;
+    ESP_GOTO_ON_FALSE(ep && target_addr && target_out, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+
+    ip_addr_copy(addr, *target_addr);
+#if CONFIG_LWIP_IPV4 && CONFIG_LWIP_IPV6
+    if (IP_IS_V6(&addr) && ip6_addr_isipv4mappedipv6(ip_2_ip6(&addr))) {
+        unmap_ipv4_mapped_ipv6(ip_2_ip4(&addr), ip_2_ip6(&addr));
+        IP_SET_TYPE_VAL(addr, IPADDR_TYPE_V4);
+    }
+#endif
+
+    ping_lock(ep);
+    for (uint32_t i = 0; i < ep->max_targets; i++) {
+        if (!ep->targets[i].in_use) {
+            t = &ep->targets[i];
+            break;
+        }
+    }
+    ESP_GOTO_ON_FALSE(t, ESP_ERR_NO_MEM, err_unlock, TAG, "no free target slot");
+    memset(t, 0, sizeof(*t));
+
+    /* set socket address */
+#if CONFIG_LWIP_IPV4
+    if (IP_IS_V4(&addr)) {
+        struct sockaddr_in *to4 = (struct sockaddr_in *)&t->sockaddr;
+        to4->sin_family = AF_INET;
+        inet_addr_from_ip4addr(&to4->sin_addr, ip_2_ip4(&addr));
+        t->family = PING_FAMILY_V4;
+    }
+#endif
+#if CONFIG_LWIP_IPV6
+    if (IP_IS_V6(&addr)) {
+        struct sockaddr_in6 *to6 = (struct sockaddr_in6 *)&t->sockaddr;
+        to6->sin6_family = AF_INET6;
+        inet6_addr_from_ip6addr(&to6->sin6_addr, ip_2_ip6(&addr));
+        t->family = PING_FAMILY_V6;
+    }
+#endif
+    ESP_GOTO_ON_FALSE(t->sockaddr.ss_family != 0, ESP_ERR_INVALID_ARG, err_unlock, TAG, "unsupported address type");
+    /* one raw socket per address family serves all the targets */
+    if (ep->sock[t->family] < 0) {
+        ep->sock[t->family] = ping_multi_open_socket(ep, t->family);
+        ESP_GOTO_ON_FALSE(ep->sock[t->family] >= 0, ESP_FAIL, err_unlock, TAG, "create socket failed");
+    }
+
+    ip_addr_copy(t->addr, addr);
+    t->count = count;
+    t->in_use = true;
+    if (ep->running) {
+        ping_wheel_insert(ep, t, sys_now());
+    }
+    *target_out = ping_target_index(ep, t);
+    ping_unlock(ep);
+    return ESP_OK;
+err_unlock:
+    ping_unlock(ep);
+err:
+    return ret;
+}
+
+esp_err_t esp_ping_multi_remove_target(esp_ping_multi_handle_t hdl, int target)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ping_multi_t *ep = (esp_ping_multi_t *)hdl;
+    ESP_GOTO_ON_FALSE(ep, ESP_ERR_INVALID_ARG, err, TAG, "ping handle can't be null");
+    ESP_GOTO_ON_FALSE(target >= 0 && (uint32_t)target < ep->max_targets, ESP_ERR_INVALID_ARG, err, TAG, "invalid target: %d", target);
+
+    ping_lock(ep);
+    ping_target_t *t = &ep->targets[target];
+    ping_wheel_remove(t);
+    t->in_use = false;
+    t->waiting = false;
+    ping_unlock(ep);
+    return ESP_OK;
+err:
+    return ret;
+}
+
+esp_err_t esp_ping_multi_start(esp_ping_multi_handle_t hdl)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ping_multi_t *ep = (esp_ping_multi_t *)hdl;
+    ESP_GOTO_ON_FALSE(ep, ESP_ERR_INVALID_ARG, err, TAG, "ping handle can't be null");
+    ep->flags |= PING_FLAGS_START;
+    xTaskNotifyGive(ep->ping_task_hdl);
+    return ESP_OK;
+err:
+    return ret;
+}
+
+esp_err_t esp_ping_multi_stop(esp_ping_multi_handle_t hdl)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ping_multi_t *ep = (esp_ping_multi_t *)hdl;
+    ESP_GOTO_ON_FALSE(ep, ESP_ERR_INVALID_ARG, err, TAG, "ping handle can't be null");
+    ep->flags &= ~PING_FLAGS_START;
+    return ESP_OK;
+err:
+    return ret;
+}
+
+esp_err_t esp_ping_multi_get_stats(esp_ping_multi_handle_t hdl, int target, esp_ping_multi_stats_t *stats)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ping_multi_t *ep = (esp_ping_multi_t *)hdl;
+    ESP_GOTO_ON_FALSE(ep && stats, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(target >= 0 && (uint32_t)target < ep->max_targets, ESP_ERR_INVALID_ARG, err, TAG, "invalid target: %d", target);
+
+    ping_lock(ep);
+    memcpy(stats, &ep->targets[target].stats, sizeof(*stats));
+    ping_unlock(ep);
+    return ESP_OK;
+err:
+    return ret;
+}
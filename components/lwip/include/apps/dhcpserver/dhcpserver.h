@@ -59,6 +59,7 @@ typedef enum
  * - DHCPS_DEBUG: Prints very detailed debug messages if set to 1, hardcoded to 0
  * - USE_CLASS_B_NET: Use class B network mask if enabled, not-defined (could be enabled as CC_FLAGS)
  * - MAX_STATION_NUM: Maximum number of clients, set to Kconfig value CONFIG_LWIP_DHCPS_MAX_STATION_NUM
+ * - DHCPS_MAX_LEASE: Maximum number of addresses in the pool, set to Kconfig value CONFIG_LWIP_DHCPS_MAX_LEASE
  * - LWIP_HOOK_DHCPS_POST_STATE: Used to inject user code after parsing DHCP message, not defined
  *      - could be enabled in lwipopts.h or via CC_FLAGS
  *      - basic usage of the hook to print hex representation of the entire option field is below:
@@ -70,7 +71,11 @@ typedef enum
  * @brief Definitions related to lease time, units and limits
  */
 #define DHCPS_COARSE_TIMER_SECS  1
+#ifdef CONFIG_LWIP_DHCPS_MAX_LEASE
+#define DHCPS_MAX_LEASE CONFIG_LWIP_DHCPS_MAX_LEASE
+#else
 #define DHCPS_MAX_LEASE 0x64
+#endif
 #define DHCPS_LEASE_TIME_DEF (120)
 #define DHCPS_LEASE_UNIT CONFIG_LWIP_DHCPS_LEASE_UNIT
 
@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "lwip/ip_addr.h"
+
+/**
+* @brief Type of multi-target "ping" session handle
+*
+*/
+typedef void *esp_ping_multi_handle_t;
+
+/**
+ * @brief Maximum number of targets in one multi-target ping session
+ *
+ */
+#define ESP_PING_MULTI_MAX_TARGETS (256)
+
+/**
+ * @brief Number of buckets of the round trip time histogram
+ *
+ * Bucket 0 counts replies received within 1 ms, bucket i counts replies with
+ * a round trip time in [2^(i-1), 2^i) ms, and the last bucket counts all the slower ones.
+ *
+ */
+#define ESP_PING_MULTI_RTT_BUCKETS (12)
+
+/**
+* @brief Result of a ping procedure, passed to the callback functions
+*
+*/
+typedef struct {
+    int target;               /*!< Target index returned by esp_ping_multi_add_target */
+    ip_addr_t target_addr;    /*!< Target IP address */
+    uint16_t seqno;           /*!< Sequence number of the ping procedure for this target, counted from 1 */
+    uint8_t ttl;              /*!< Time to live of the reply (IPv4 only) */
+    uint8_t tos;              /*!< Type of service of the reply (IPv4 only) */
+    uint32_t recv_len;        /*!< Size of the data portion of the reply */
+    uint32_t elapsed_time_ms; /*!< Round trip time, or the timeout on timeout */
+} esp_ping_multi_result_t;
+
+/**
+* @brief Runtime statistics of one target
+*
+*/
+typedef struct {
+    uint32_t transmitted;                           /*!< Number of request packets sent out */
+    uint32_t received;                              /*!< Number of reply packets received */
+    uint32_t timeouts;                              /*!< Number of requests without a reply within the timeout */
+    uint32_t rtt_min_ms;                            /*!< Minimum round trip time */
+    uint32_t rtt_max_ms;                            /*!< Maximum round trip time */
+    uint32_t rtt_total_ms;                          /*!< Sum of the round trip times of all replies */
+    uint32_t rtt_hist[ESP_PING_MULTI_RTT_BUCKETS];  /*!< Round trip time histogram, see ESP_PING_MULTI_RTT_BUCKETS */
+} esp_ping_multi_stats_t;
+
+/**
+* @brief Type of multi-target "ping" callback functions
+*
+* Callbacks are invoked by the internal ping task with the session locked, they may call
+* esp_ping_multi_get_stats() but should return quickly as they delay the other targets.
+*
+*/
+typedef struct {
+    /**
+    * @brief arguments for callback functions
+    *
+    */
+    void *cb_args;
+
+    /**
+    * @brief Invoked by internal ping thread when received ICMP echo reply packet
+    *
+    */
+    void (*on_ping_success)(esp_ping_multi_handle_t hdl, const esp_ping_multi_result_t *result, void *args);
+
+    /**
+    * @brief Invoked by internal ping thread when receive ICMP echo reply packet timeout
+    *
+    */
+    void (*on_ping_timeout)(esp_ping_multi_handle_t hdl, const esp_ping_multi_result_t *result, void *args);
+
+    /**
+    * @brief Invoked by internal ping thread when a target has finished its count, or when the session is stopped
+    *
+    */
+    void (*on_ping_end)(esp_ping_multi_handle_t hdl, int target, void *args);
+} esp_ping_multi_callbacks_t;
+
+/**
+* @brief Type of multi-target "ping" configuration, shared by all targets of the session
+*
+*/
+typedef struct {
+    uint32_t max_targets;     /*!< Maximum number of targets, up to ESP_PING_MULTI_MAX_TARGETS */
+    uint32_t interval_ms;     /*!< Milliseconds between each ping procedure of a target */
+    uint32_t timeout_ms;      /*!< Timeout value (in milliseconds) of each ping procedure */
+    uint32_t data_size;       /*!< Size of the data next to ICMP packet header */
+    int tos;                  /*!< Type of Service, a field specified in the IP header */
+    int ttl;                  /*!< Time to Live,a field specified in the IP header */
+    uint32_t task_stack_size; /*!< Stack size of internal ping task */
+    uint32_t task_prio;       /*!< Priority of internal ping task */
+    uint32_t interface;       /*!< Netif index, interface=0 means NETIF_NO_INDEX*/
+} esp_ping_multi_config_t;
+
+/**
+ * @brief Default multi-target ping configuration
+ *
+ */
+#define ESP_PING_MULTI_DEFAULT_CONFIG()  \
+    {                                    \
+        .max_targets = 16,               \
+        .interval_ms = 1000,             \
+        .timeout_ms = 1000,              \
+        .data_size = 64,                 \
+        .tos = 0,                        \
+        .ttl = IP_DEFAULT_TTL,           \
+        .task_stack_size = ESP_TASK_PING_STACK + 1024,  \
+        .task_prio = 2,                  \
+        .interface = 0,                  \
+    }
+
+/**
+ * @brief Create a multi-target ping session
+ *
+ * A single internal task and one raw socket per address family serve all the targets of the session.
+ * Replies are matched to targets by ICMP id and sequence number, timeouts and intervals are kept
+ * in a timer wheel.
+ *
+ * @param config ping configuration
+ * @param cbs a bunch of callback functions invoked by internal ping task
+ * @param hdl_out handle of ping session
+ * @return
+ *      - ESP_ERR_INVALID_ARG: invalid parameters (e.g. configuration is null, etc)
+ *      - ESP_ERR_NO_MEM: out of memory
+ *      - ESP_OK: create ping session successfully
+ */
+esp_err_t esp_ping_multi_new_session(const esp_ping_multi_config_t *config, const esp_ping_multi_callbacks_t *cbs,
+                                     esp_ping_multi_handle_t *hdl_out);
+
+/**
+ * @brief Delete a multi-target ping session
+ *
+ * @param hdl handle of ping session
+ * @return
+ *      - ESP_ERR_INVALID_ARG: invalid parameters (e.g. ping handle is null, etc)
+ *      - ESP_OK: delete ping session successfully
+ */
+esp_err_t esp_ping_multi_delete_session(esp_ping_multi_handle_t hdl);
+
+/**
+ * @brief Add a target to the session
+ *
+ * Targets can be added while the session is running, they are pinged right away.
+ *
+ * @param hdl handle of ping session
+ * @param target_addr Target IP address, either IPv4 or IPv6
+ * @param count Number of ping procedures for this target, 0 to ping until the session is stopped
+ * @param target_out Index of the target, used by the other functions and reported to the callbacks
+ * @return
+ *      - ESP_ERR_INVALID_ARG: invalid parameters
+ *      - ESP_ERR_NO_MEM: no free target slot
+ *      - ESP_FAIL: socket error
+ *      - ESP_OK: target added successfully
+ */
+esp_err_t esp_ping_multi_add_target(esp_ping_multi_handle_t hdl, const ip_addr_t *target_addr, uint32_t count,
+                                    int *target_out);
+
+/**
+ * @brief Remove a target from the session
+ *
+ * @param hdl handle of ping session
+ * @param target target index
+ * @return
+ *      - ESP_ERR_INVALID_ARG: invalid parameters
+ *      - ESP_OK: target removed successfully
+ */
+esp_err_t esp_ping_multi_remove_target(esp_ping_multi_handle_t hdl, int target);
+
+/**
+ * @brief Start the session, the statistics of all targets are cleared
+ *
+ * @param hdl handle of ping session
+ * @return
+ *      - ESP_ERR_INVALID_ARG: invalid parameters (e.g. ping handle is null, etc)
+ *      - ESP_OK: start ping session successfully
+ */
+esp_err_t esp_ping_multi_start(esp_ping_multi_handle_t hdl);
+
+/**
+ * @brief Stop the session
+ *
+ * @param hdl handle of ping session
+ * @return
+ *      - ESP_ERR_INVALID_ARG: invalid parameters (e.g. ping handle is null, etc)
+ *      - ESP_OK: stop ping session successfully
+ */
+esp_err_t esp_ping_multi_stop(esp_ping_multi_handle_t hdl);
+
+/**
+ * @brief Get the runtime statistics of a target
+ *
+ * @param hdl handle of ping session
+ * @param target target index
+ * @param stats statistics copied out
+ * @return
+ *      - ESP_ERR_INVALID_ARG: invalid parameters
+ *      - ESP_OK: get statistics successfully
+ */
+esp_err_t esp_ping_multi_get_stats(esp_ping_multi_handle_t hdl, int target, esp_ping_multi_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,7 +7,7 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2018-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2025 Espressif Systems (Shanghai) CO LTD
  */
 #ifndef LWIP_HDR_SYS_SOCKETS_H
 #define LWIP_HDR_SYS_SOCKETS_H
@@ -19,4 +19,25 @@
 */
 #include <net/if.h>
 
+#ifndef LWIP_HDR_SYS_SOCKETS_MMSG
+#define LWIP_HDR_SYS_SOCKETS_MMSG
+#include <time.h>
+
+/* Batched datagram I/O, implemented in port/sockets_ext.c */
+struct mmsghdr {
+    struct msghdr msg_hdr;  /* message header */
+    unsigned int  msg_len;  /* number of bytes transmitted */
+};
+
+static inline int sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    return lwip_sendmmsg(s, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+    return lwip_recvmmsg(s, msgvec, vlen, flags, timeout);
+}
+#endif /* LWIP_HDR_SYS_SOCKETS_MMSG */
+
 #endif /* LWIP_HDR_SYS_SOCKETS_H */
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "nvs.h"
+#include "lwip/netif.h"
+#include "netif/dhcps_state.h"
+
+#define DHCPS_NAMESPACE "dhcps_state"
+#define IF_KEY_SIZE 3
+
+/*
+ * As a NVS key, use string representation of the interface index number
+ */
+static inline char *gen_if_key(struct netif *netif, char *name)
+{
+    lwip_itoa(name, IF_KEY_SIZE, netif->num);
+    return name;
+}
+
+size_t dhcps_leases_restore(struct netif *netif, struct dhcps_pool *pools, size_t max_pools)
+{
+    nvs_handle_t nvs;
+    char if_key[IF_KEY_SIZE];
+    size_t len = max_pools * sizeof(struct dhcps_pool);
+    size_t num_pools = 0;
+    if (netif == NULL || pools == NULL) {
+        return 0;
+    }
+
+    if (nvs_open(DHCPS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+        // the blob is not read if larger than the pool, e.g. after shrinking it in the configuration
+        if (nvs_get_blob(nvs, gen_if_key(netif, if_key), pools, &len) == ESP_OK) {
+            num_pools = len / sizeof(struct dhcps_pool);
+        }
+        nvs_close(nvs);
+    }
+    return num_pools;
+}
+
+void dhcps_leases_store(struct netif *netif, const struct dhcps_pool *pools, size_t num_pools)
+{
+    nvs_handle_t nvs;
+    char if_key[IF_KEY_SIZE];
+    if (netif == NULL) {
+        return;
+    }
+
+    if (nvs_open(DHCPS_NAMESPACE, NVS_READWRITE, &nvs) == ESP_OK) {
+        if (num_pools == 0) {
+            nvs_erase_key(nvs, gen_if_key(netif, if_key));
+        } else {
+            nvs_set_blob(nvs, gen_if_key(netif, if_key), pools, num_pools * sizeof(struct dhcps_pool));
+        }
+        nvs_commit(nvs);
+        nvs_close(nvs);
+    }
+}
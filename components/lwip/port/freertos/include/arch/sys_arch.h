@@ -3,11 +3,12 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2025 Espressif Systems (Shanghai) CO LTD
  */
 #ifndef __SYS_ARCH_H__
 #define __SYS_ARCH_H__
 
+#include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
@@ -22,9 +23,25 @@ typedef SemaphoreHandle_t sys_sem_t;
 typedef SemaphoreHandle_t sys_mutex_t;
 typedef TaskHandle_t sys_thread_t;
 
+#if CONFIG_LWIP_MBOX_RING
+/* Ring buffer mailbox: posting and fetching only take a spinlock, the
+ * semaphores are touched only when the other side is actually blocked */
+typedef struct sys_mbox_s {
+  portMUX_TYPE lock;
+  void **ring;
+  uint32_t size;
+  uint32_t head;
+  uint32_t count;
+  uint32_t rx_waiters;
+  uint32_t tx_waiters;
+  SemaphoreHandle_t rx_bell;
+  SemaphoreHandle_t tx_bell;
+}* sys_mbox_t;
+#else
 typedef struct sys_mbox_s {
   QueueHandle_t os_mbox;
 }* sys_mbox_t;
+#endif /* CONFIG_LWIP_MBOX_RING */
 
 /** This is returned by _fromisr() sys functions to tell the outermost function
  * that a higher priority task was woken and the scheduler needs to be invoked.
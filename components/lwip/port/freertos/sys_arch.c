@@ -3,12 +3,13 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2025 Espressif Systems (Shanghai) CO LTD
  */
 
 /* lwIP includes. */
 
 #include <pthread.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
@@ -195,6 +196,283 @@ sys_sem_free(sys_sem_t *sem)
   *sem = NULL;
 }
 
+#if CONFIG_LWIP_MBOX_RING
+
+/* Both helpers must be called with the mailbox lock held */
+static inline bool
+mbox_ring_put(struct sys_mbox_s *m, void *msg)
+{
+  if (m->count == m->size) {
+    return false;
+  }
+  m->ring[(m->head + m->count) % m->size] = msg;
+  m->count++;
+  return true;
+}
+
+static inline bool
+mbox_ring_get(struct sys_mbox_s *m, void **msg)
+{
+  if (m->count == 0) {
+    return false;
+  }
+  *msg = m->ring[m->head];
+  m->head = (m->head + 1) % m->size;
+  m->count--;
+  return true;
+}
+
+/**
+ * @brief Create an empty mailbox.
+ *
+ * @param mbox pointer of the mailbox
+ * @param size size of the mailbox
+ * @return ERR_OK on success, ERR_MEM when out of memory
+ */
+err_t
+sys_mbox_new(sys_mbox_t *mbox, int size)
+{
+  /* mailbox descriptor and its ring live in one allocation */
+  struct sys_mbox_s *m = mem_malloc(sizeof(struct sys_mbox_s) + size * sizeof(void *));
+  if (m == NULL) {
+    LWIP_DEBUGF(ESP_THREAD_SAFE_DEBUG, ("fail to new *mbox\n"));
+    return ERR_MEM;
+  }
+  memset(m, 0, sizeof(struct sys_mbox_s));
+  portMUX_INITIALIZE(&m->lock);
+  m->ring = (void **)(m + 1);
+  m->size = size;
+  m->rx_bell = xSemaphoreCreateBinary();
+  m->tx_bell = xSemaphoreCreateBinary();
+  if (m->rx_bell == NULL || m->tx_bell == NULL) {
+    LWIP_DEBUGF(ESP_THREAD_SAFE_DEBUG, ("fail to new mbox semaphores\n"));
+    if (m->rx_bell) {
+      vSemaphoreDelete(m->rx_bell);
+    }
+    if (m->tx_bell) {
+      vSemaphoreDelete(m->tx_bell);
+    }
+    free(m);
+    return ERR_MEM;
+  }
+
+  *mbox = m;
+  LWIP_DEBUGF(ESP_THREAD_SAFE_DEBUG, ("new *mbox ok mbox=%p size=%d\n", m, size));
+  return ERR_OK;
+}
+
+/**
+ * @brief Send message to mailbox
+ *
+ * @param mbox pointer of the mailbox
+ * @param msg pointer of the message to send
+ */
+void
+sys_mbox_post(sys_mbox_t *mbox, void *msg)
+{
+  struct sys_mbox_s *m = *mbox;
+
+  for (;;) {
+    portENTER_CRITICAL(&m->lock);
+    if (mbox_ring_put(m, msg)) {
+      bool wake_rx = m->rx_waiters > 0;
+      /* pass the baton to another blocked writer if there is still room */
+      bool wake_tx = m->tx_waiters > 0 && m->count < m->size;
+      portEXIT_CRITICAL(&m->lock);
+      if (wake_rx) {
+        xSemaphoreGive(m->rx_bell);
+      }
+      if (wake_tx) {
+        xSemaphoreGive(m->tx_bell);
+      }
+      return;
+    }
+    m->tx_waiters++;
+    portEXIT_CRITICAL(&m->lock);
+
+    BaseType_t ret = xSemaphoreTake(m->tx_bell, portMAX_DELAY);
+    LWIP_ASSERT("mbox post failed", ret == pdTRUE);
+    (void)ret;
+
+    portENTER_CRITICAL(&m->lock);
+    m->tx_waiters--;
+    portEXIT_CRITICAL(&m->lock);
+  }
+}
+
+/**
+ * @brief Try to post a message to mailbox
+ *
+ * @param mbox pointer of the mailbox
+ * @param msg pointer of the message to send
+ * @return ERR_OK on success, ERR_MEM when mailbox is full
+ */
+err_t
+sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
+{
+  struct sys_mbox_s *m = *mbox;
+
+  portENTER_CRITICAL(&m->lock);
+  bool posted = mbox_ring_put(m, msg);
+  bool wake_rx = posted && m->rx_waiters > 0;
+  portEXIT_CRITICAL(&m->lock);
+
+  if (!posted) {
+    LWIP_DEBUGF(ESP_THREAD_SAFE_DEBUG, ("trypost mbox=%p fail\n", m));
+    return ERR_MEM;
+  }
+  if (wake_rx) {
+    xSemaphoreGive(m->rx_bell);
+  }
+  return ERR_OK;
+}
+
+/**
+ * @brief Try to post a message to mailbox from ISR
+ *
+ * @param mbox pointer of the mailbox
+ * @param msg pointer of the message to send
+ * @return  ERR_OK on success
+ *          ERR_MEM when mailbox is full
+ *          ERR_NEED_SCHED when high priority task wakes up
+ */
+err_t
+sys_mbox_trypost_fromisr(sys_mbox_t *mbox, void *msg)
+{
+  struct sys_mbox_s *m = *mbox;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  portENTER_CRITICAL_ISR(&m->lock);
+  bool posted = mbox_ring_put(m, msg);
+  bool wake_rx = posted && m->rx_waiters > 0;
+  portEXIT_CRITICAL_ISR(&m->lock);
+
+  if (!posted) {
+    return ERR_MEM;
+  }
+  if (wake_rx) {
+    xSemaphoreGiveFromISR(m->rx_bell, &xHigherPriorityTaskWoken);
+  }
+  return xHigherPriorityTaskWoken == pdTRUE ? ERR_NEED_SCHED : ERR_OK;
+}
+
+/* Takes one message off the ring, or registers the caller as a blocked reader if empty */
+static bool
+mbox_ring_fetch(struct sys_mbox_s *m, void **msg, bool register_waiter)
+{
+  portENTER_CRITICAL(&m->lock);
+  bool fetched = mbox_ring_get(m, msg);
+  bool wake_tx = fetched && m->tx_waiters > 0;
+  /* pass the baton to another blocked reader if messages are left */
+  bool wake_rx = fetched && m->rx_waiters > 0 && m->count > 0;
+  if (!fetched && register_waiter) {
+    m->rx_waiters++;
+  }
+  portEXIT_CRITICAL(&m->lock);
+
+  if (wake_tx) {
+    xSemaphoreGive(m->tx_bell);
+  }
+  if (wake_rx) {
+    xSemaphoreGive(m->rx_bell);
+  }
+  return fetched;
+}
+
+/**
+ * @brief Fetch message from mailbox
+ *
+ * While messages keep arriving the reader drains them without blocking,
+ * and writers only signal the semaphore when a reader is actually waiting.
+ *
+ * @param mbox pointer of mailbox
+ * @param msg pointer of the received message, could be NULL to indicate the message should be dropped
+ * @param timeout if zero, will wait infinitely; or will wait milliseconds specify by this argument
+ * @return SYS_ARCH_TIMEOUT when timeout, 0 otherwise
+ */
+u32_t
+sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
+{
+  struct sys_mbox_s *m = *mbox;
+  TickType_t start = xTaskGetTickCount();
+  TickType_t timeout_ticks = timeout / portTICK_PERIOD_MS;
+  void *msg_dummy;
+
+  if (msg == NULL) {
+    msg = &msg_dummy;
+  }
+
+  while (!mbox_ring_fetch(m, msg, true)) {
+    BaseType_t ret;
+    if (timeout == 0) {
+      /* wait infinite */
+      ret = xSemaphoreTake(m->rx_bell, portMAX_DELAY);
+    } else {
+      TickType_t elapsed = xTaskGetTickCount() - start;
+      ret = xSemaphoreTake(m->rx_bell, elapsed < timeout_ticks ? timeout_ticks - elapsed : 0);
+    }
+
+    portENTER_CRITICAL(&m->lock);
+    m->rx_waiters--;
+    portEXIT_CRITICAL(&m->lock);
+
+    if (ret != pdTRUE) {
+      if (mbox_ring_fetch(m, msg, false)) {
+        return 0;
+      }
+      /* timed out */
+      *msg = NULL;
+      return SYS_ARCH_TIMEOUT;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief try to fetch message from mailbox
+ *
+ * @param mbox pointer of mailbox
+ * @param msg pointer of the received message
+ * @return SYS_MBOX_EMPTY if mailbox is empty, 1 otherwise
+ */
+u32_t
+sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg)
+{
+  void *msg_dummy;
+
+  if (msg == NULL) {
+    msg = &msg_dummy;
+  }
+  if (!mbox_ring_fetch(*mbox, msg, false)) {
+    *msg = NULL;
+    return SYS_MBOX_EMPTY;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Delete a mailbox
+ *
+ * @param mbox pointer of the mailbox to delete
+ */
+void
+sys_mbox_free(sys_mbox_t *mbox)
+{
+  if ((NULL == mbox) || (NULL == *mbox)) {
+    return;
+  }
+  LWIP_ASSERT("mbox quence not empty", (*mbox)->count == 0);
+
+  vSemaphoreDelete((*mbox)->rx_bell);
+  vSemaphoreDelete((*mbox)->tx_bell);
+  free(*mbox);
+  *mbox = NULL;
+}
+
+#else /* CONFIG_LWIP_MBOX_RING */
+
 /**
  * @brief Create an empty mailbox.
  *
@@ -369,6 +647,8 @@ sys_mbox_free(sys_mbox_t *mbox)
   (void)msgs_waiting;
 }
 
+#endif /* CONFIG_LWIP_MBOX_RING */
+
 /**
  * @brief Create a new thread
  *
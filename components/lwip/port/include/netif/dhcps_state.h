@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LWIP_ESP_DHCPS_STATE_H
+#define LWIP_ESP_DHCPS_STATE_H
+
+#include <stddef.h>
+#include "lwip/netif.h"
+#include "dhcpserver/dhcpserver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t dhcps_leases_restore(struct netif *netif, struct dhcps_pool *pools, size_t max_pools);
+
+void dhcps_leases_store(struct netif *netif, const struct dhcps_pool *pools, size_t num_pools);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*  LWIP_ESP_DHCPS_STATE_H */
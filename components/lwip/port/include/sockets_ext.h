@@ -1,11 +1,13 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #pragma once
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,10 +17,100 @@ extern "C" {
 #define IPV6_MULTICAST_HOPS  0x301
 #define IPV6_MULTICAST_LOOP  0x302
 
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE       0x10000   /* recvmmsg(): block for the first datagram only */
+#endif
+
 struct lwip_sock;
+struct sockaddr;
+struct iovec;
+struct mmsghdr;
+struct timespec;
+
+/**
+ * @brief Zero-copy receive descriptor
+ *
+ * Filled by lwip_recv_zc() with an iovec view of the received pbuf chain.
+ * The referenced memory belongs to the stack and stays valid until the
+ * descriptor is handed back via lwip_recv_zc_release().
+ */
+typedef struct lwip_zc_buf {
+    struct iovec *iov;  /*!< [in] caller provided iovec array, [out] segments of the pbuf chain */
+    int iovcnt;         /*!< [in] capacity of iov, [out] number of used entries */
+    size_t len;         /*!< [out] total number of bytes referenced by iov */
+    int flags;          /*!< [out] MSG_TRUNC if a datagram had more segments than iov could hold */
+    void *priv;         /*!< internal: borrowed pbuf chain or netbuf, do not touch */
+    bool is_tcp;        /*!< internal: type of the borrowed buffer */
+} lwip_zc_buf_t;
 
 bool lwip_setsockopt_impl_ext(struct lwip_sock* sock, int level, int optname, const void *optval, uint32_t optlen, int *err);
 bool lwip_getsockopt_impl_ext(struct lwip_sock* sock, int level, int optname, void *optval, uint32_t *optlen, int *err);
+
+/**
+ * @brief Get a socket and hold a reference to it, as the lwip_* socket calls do
+ *
+ * Implemented in port/sockets.c. The socket stays valid until
+ * lwip_sock_put_ref(), even if it is closed concurrently.
+ *
+ * @return the socket, or NULL with errno set to EBADF
+ */
+struct lwip_sock *lwip_sock_get_ref(int s);
+
+/**
+ * @brief Release a reference taken by lwip_sock_get_ref()
+ */
+void lwip_sock_put_ref(struct lwip_sock *sock);
+
+/**
+ * @brief Receive data without copying it into a user buffer
+ *
+ * Works with TCP, UDP and RAW sockets. For TCP, the advertised receive window
+ * is only reopened when the buffer is released, so holding buffers applies
+ * back-pressure to the peer. Any data left over by a previous lwip_recv()
+ * is returned first.
+ *
+ * @param s       socket descriptor
+ * @param zc      descriptor with iov/iovcnt set up by the caller
+ * @param flags   MSG_DONTWAIT is supported
+ * @param from    optional source address (datagram sockets only)
+ * @param fromlen in/out length of from
+ *
+ * @return number of bytes referenced, 0 on orderly TCP shutdown, -1 on error with errno set
+ */
+ssize_t lwip_recv_zc(int s, lwip_zc_buf_t *zc, int flags, struct sockaddr *from, uint32_t *fromlen);
+
+/**
+ * @brief Return the buffers borrowed by lwip_recv_zc() to the stack
+ *
+ * @param s  socket descriptor the data was received from
+ * @param zc descriptor previously filled by lwip_recv_zc()
+ */
+void lwip_recv_zc_release(int s, lwip_zc_buf_t *zc);
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * For UDP sockets all datagrams of the batch are handed over to the stack
+ * within a single tcpip call. Other socket types fall back to one
+ * lwip_sendmsg() per message.
+ *
+ * @param flags  UDP sockets accept MSG_DONTWAIT only (EOPNOTSUPP otherwise);
+ *               other socket types take the lwip_sendmsg() flags
+ *
+ * @return number of messages sent, or -1 with errno set if none was sent
+ */
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * Supports MSG_DONTWAIT and MSG_WAITFORONE. The timeout is checked after
+ * each received datagram, as on Linux.
+ *
+ * @return number of messages received, or -1 with errno set if none was received
+ */
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
+
 #ifdef __cplusplus
 }
 #endif
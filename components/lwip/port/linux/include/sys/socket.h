@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,4 +10,25 @@
 #else
 /* Include lwip sockets by default */
 #include "lwip/sockets.h"
+
+#ifndef LWIP_HDR_SYS_SOCKETS_MMSG
+#define LWIP_HDR_SYS_SOCKETS_MMSG
+#include <time.h>
+
+/* Batched datagram I/O, implemented in port/sockets_ext.c */
+struct mmsghdr {
+    struct msghdr msg_hdr;  /* message header */
+    unsigned int  msg_len;  /* number of bytes transmitted */
+};
+
+static inline int sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    return lwip_sendmmsg(s, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+    return lwip_recvmmsg(s, msgvec, vlen, flags, timeout);
+}
+#endif /* LWIP_HDR_SYS_SOCKETS_MMSG */
 #endif /* LWIP_HDR_LINUX_SYS_SOCKETS_H */
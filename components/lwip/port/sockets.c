@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Builds lwIP's sockets.c together with the socket reference accessors of
+ * sockets_ext.h, which need its static get_socket() and done_socket().
+ * The object keeps the "sockets" name used by linker.lf.
+ */
+#include "../lwip/src/api/sockets.c"
+
+#include "sockets_ext.h"
+
+struct lwip_sock *lwip_sock_get_ref(int s)
+{
+    return get_socket(s);
+}
+
+void lwip_sock_put_ref(struct lwip_sock *sock)
+{
+#if LWIP_NETCONN_FULLDUPLEX
+    done_socket(sock);
+#else
+    LWIP_UNUSED_ARG(sock);
+#endif /* LWIP_NETCONN_FULLDUPLEX */
+}
@@ -1,9 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <sys/socket.h>
 #include "lwip/sockets.h"
 #include "lwip/priv/sockets_priv.h"
 #include "lwip/api.h"
@@ -11,6 +13,9 @@
 #include "lwip/tcp.h"
 #include "lwip/raw.h"
 #include "lwip/udp.h"
+#include "lwip/netbuf.h"
+#include "lwip/inet.h"
+#include "lwip/priv/tcpip_priv.h"
 
 #define LWIP_SOCKOPT_CHECK_OPTLEN_CONN_PCB(sock, optlen, opttype) do { \
   if (((optlen) < sizeof(opttype)) || ((sock)->conn == NULL) || ((sock)->conn->pcb.tcp == NULL)) { *err=EINVAL; goto exit; } }while(0)
@@ -106,3 +111,370 @@ exit:
     return true;
 #endif /* LWIP_IPV6 */
 }
+
+static void zc_fill_from(const ip_addr_t *addr, u16_t port, struct sockaddr *from, uint32_t *fromlen)
+{
+    union {
+        struct sockaddr sa;
+#if LWIP_IPV4
+        struct sockaddr_in sin;
+#endif
+#if LWIP_IPV6
+        struct sockaddr_in6 sin6;
+#endif
+    } saddr;
+    uint32_t len = 0;
+
+    memset(&saddr, 0, sizeof(saddr));
+#if LWIP_IPV6
+    if (IP_IS_V6(addr)) {
+        saddr.sin6.sin6_len = sizeof(struct sockaddr_in6);
+        saddr.sin6.sin6_family = AF_INET6;
+        saddr.sin6.sin6_port = lwip_htons(port);
+        inet6_addr_from_ip6addr(&saddr.sin6.sin6_addr, ip_2_ip6(addr));
+        saddr.sin6.sin6_scope_id = ip6_addr_zone(ip_2_ip6(addr));
+        len = sizeof(struct sockaddr_in6);
+    }
+#endif
+#if LWIP_IPV4
+    if (IP_IS_V4(addr)) {
+        saddr.sin.sin_len = sizeof(struct sockaddr_in);
+        saddr.sin.sin_family = AF_INET;
+        saddr.sin.sin_port = lwip_htons(port);
+        inet_addr_from_ip4addr(&saddr.sin.sin_addr, ip_2_ip4(addr));
+        len = sizeof(struct sockaddr_in);
+    }
+#endif
+    if (*fromlen > len) {
+        *fromlen = len;
+    }
+    MEMCPY(from, &saddr, *fromlen);
+}
+
+/* Map the pbuf chain onto the caller's iovec array, returns the first pbuf that did not fit */
+static struct pbuf *zc_fill_iov(struct pbuf *p, lwip_zc_buf_t *zc)
+{
+    int i = 0;
+    zc->len = 0;
+    for (; p != NULL && i < zc->iovcnt; p = p->next) {
+        if (p->len == 0) {
+            continue;
+        }
+        zc->iov[i].iov_base = p->payload;
+        zc->iov[i].iov_len = p->len;
+        zc->len += p->len;
+        i++;
+    }
+    zc->iovcnt = i;
+    return p;
+}
+
+static ssize_t recv_zc_sock(struct lwip_sock *sock, lwip_zc_buf_t *zc, int flags, struct sockaddr *from, uint32_t *fromlen)
+{
+    err_t err;
+    u8_t apiflags = (flags & MSG_DONTWAIT) ? NETCONN_DONTBLOCK : 0;
+
+#if LWIP_TCP
+    if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+        struct pbuf *p = sock->lastdata.pbuf;
+        if (p != NULL) {
+            sock->lastdata.pbuf = NULL;
+        } else {
+            /* NOAUTORCVD: the window is reopened in lwip_recv_zc_release() */
+            err = netconn_recv_tcp_pbuf_flags(sock->conn, &p, apiflags | NETCONN_NOAUTORCVD);
+            if (err == ERR_CLSD) {
+                /* orderly shutdown, reported as end of stream like lwip_recv() */
+                return 0;
+            }
+            if (err != ERR_OK) {
+                set_errno(err_to_errno(err));
+                return -1;
+            }
+        }
+        struct pbuf *rest = zc_fill_iov(p, zc);
+        if (rest != NULL) {
+            /* Detach the tail that did not fit and keep it for the next receive call */
+            for (struct pbuf *q = p; q != rest; q = q->next) {
+                q->tot_len -= rest->tot_len;
+                if (q->next == rest) {
+                    q->next = NULL;
+                    break;
+                }
+            }
+            sock->lastdata.pbuf = rest;
+        }
+        zc->priv = p;
+        zc->is_tcp = true;
+        if (from && fromlen) {
+            ip_addr_t addr;
+            u16_t port;
+            if (netconn_getaddr(sock->conn, &addr, &port, 0) == ERR_OK) {
+                zc_fill_from(&addr, port, from, fromlen);
+            }
+        }
+        return zc->len;
+    }
+#endif /* LWIP_TCP */
+
+    struct netbuf *buf = sock->lastdata.netbuf;
+    if (buf != NULL) {
+        sock->lastdata.netbuf = NULL;
+    } else {
+        err = netconn_recv_udp_raw_netbuf_flags(sock->conn, &buf, apiflags);
+        if (err != ERR_OK) {
+            set_errno(err_to_errno(err));
+            return -1;
+        }
+    }
+    if (zc_fill_iov(buf->p, zc) != NULL) {
+        zc->flags |= MSG_TRUNC;
+    }
+    zc->priv = buf;
+    zc->is_tcp = false;
+    if (from && fromlen) {
+        zc_fill_from(netbuf_fromaddr(buf), netbuf_fromport(buf), from, fromlen);
+    }
+    return zc->len;
+}
+
+ssize_t lwip_recv_zc(int s, lwip_zc_buf_t *zc, int flags, struct sockaddr *from, uint32_t *fromlen)
+{
+    if (zc == NULL || zc->iov == NULL || zc->iovcnt <= 0) {
+        set_errno(EINVAL);
+        return -1;
+    }
+    zc->flags = 0;
+    zc->priv = NULL;
+
+    /* Hold the socket so that a concurrent close() can't free it, its conn or lastdata */
+    struct lwip_sock *sock = lwip_sock_get_ref(s);
+    if (sock == NULL) {
+        return -1;
+    }
+    ssize_t ret = recv_zc_sock(sock, zc, flags, from, fromlen);
+    lwip_sock_put_ref(sock);
+    return ret;
+}
+
+void lwip_recv_zc_release(int s, lwip_zc_buf_t *zc)
+{
+    if (zc == NULL || zc->priv == NULL) {
+        return;
+    }
+#if LWIP_TCP
+    if (zc->is_tcp) {
+        struct pbuf *p = (struct pbuf *)zc->priv;
+        u16_t len = p->tot_len;
+        pbuf_free(p);
+        /* The socket may have been closed while the data was borrowed */
+        int saved_errno = errno;
+        struct lwip_sock *sock = lwip_sock_get_ref(s);
+        if (sock != NULL) {
+            netconn_tcp_recvd(sock->conn, len);
+            lwip_sock_put_ref(sock);
+        }
+        errno = saved_errno;
+    } else
+#endif /* LWIP_TCP */
+    {
+        netbuf_delete((struct netbuf *)zc->priv);
+    }
+    zc->priv = NULL;
+    zc->len = 0;
+    zc->iovcnt = 0;
+}
+
+static bool sockaddr_to_ipaddr_port(const struct sockaddr *sa, socklen_t salen, ip_addr_t *addr, u16_t *port)
+{
+#if LWIP_IPV6
+    if (sa->sa_family == AF_INET6 && salen >= sizeof(struct sockaddr_in6)) {
+        const struct sockaddr_in6 *sin6 = (const struct sockaddr_in6 *)sa;
+        inet6_addr_to_ip6addr(ip_2_ip6(addr), &sin6->sin6_addr);
+        IP_SET_TYPE(addr, IPADDR_TYPE_V6);
+        ip6_addr_set_zone(ip_2_ip6(addr), (u8_t)sin6->sin6_scope_id);
+#if LWIP_IPV4
+        if (ip6_addr_isipv4mappedipv6(ip_2_ip6(addr))) {
+            unmap_ipv4_mapped_ipv6(ip_2_ip4(addr), ip_2_ip6(addr));
+            IP_SET_TYPE(addr, IPADDR_TYPE_V4);
+        }
+#endif /* LWIP_IPV4 */
+        *port = lwip_ntohs(sin6->sin6_port);
+        return true;
+    }
+#endif /* LWIP_IPV6 */
+#if LWIP_IPV4
+    if (sa->sa_family == AF_INET && salen >= sizeof(struct sockaddr_in)) {
+        const struct sockaddr_in *sin = (const struct sockaddr_in *)sa;
+        inet_addr_to_ip4addr(ip_2_ip4(addr), &sin->sin_addr);
+        IP_SET_TYPE(addr, IPADDR_TYPE_V4);
+        *port = lwip_ntohs(sin->sin_port);
+        return true;
+    }
+#endif /* LWIP_IPV4 */
+    return false;
+}
+
+#if LWIP_UDP
+struct tcpip_sendmmsg {
+    struct tcpip_api_call_data call;
+    struct netconn *conn;
+    struct mmsghdr *msgvec;
+    unsigned int vlen;
+    unsigned int sent;
+};
+
+/* Runs in the tcpip context: pushes the whole batch to the UDP pcb in one go */
+static err_t do_sendmmsg(struct tcpip_api_call_data *msg)
+{
+    struct tcpip_sendmmsg *params = __containerof(msg, struct tcpip_sendmmsg, call);
+    struct udp_pcb *pcb = params->conn->pcb.udp;
+    err_t err = ERR_OK;
+
+    if (pcb == NULL) {
+        return ERR_CLSD;
+    }
+    /* Same check as the netconn send path: report a fatal error latched on the conn */
+    if (ERR_IS_FATAL(params->conn->pending_err)) {
+        return params->conn->pending_err;
+    }
+    for (; params->sent < params->vlen; params->sent++) {
+        struct mmsghdr *m = &params->msgvec[params->sent];
+        size_t total = 0;
+        for (int i = 0; i < m->msg_hdr.msg_iovlen; i++) {
+            total += m->msg_hdr.msg_iov[i].iov_len;
+        }
+        if (total > 0xFFFF - UDP_HLEN) {
+            err = ERR_VAL;
+            break;
+        }
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, (u16_t)total, PBUF_RAM);
+        if (p == NULL) {
+            err = ERR_MEM;
+            break;
+        }
+        u16_t offset = 0;
+        for (int i = 0; i < m->msg_hdr.msg_iovlen; i++) {
+            pbuf_take_at(p, m->msg_hdr.msg_iov[i].iov_base, (u16_t)m->msg_hdr.msg_iov[i].iov_len, offset);
+            offset += (u16_t)m->msg_hdr.msg_iov[i].iov_len;
+        }
+        if (m->msg_hdr.msg_name != NULL) {
+            ip_addr_t addr;
+            u16_t port;
+            if (!sockaddr_to_ipaddr_port(m->msg_hdr.msg_name, m->msg_hdr.msg_namelen, &addr, &port)) {
+                pbuf_free(p);
+                err = ERR_ARG;
+                break;
+            }
+            err = udp_sendto(pcb, p, &addr, port);
+        } else if (udp_flags(pcb) & UDP_FLAGS_CONNECTED) {
+            err = udp_send(pcb, p);
+        } else {
+            err = ERR_CONN;
+        }
+        pbuf_free(p);
+        if (err != ERR_OK) {
+            break;
+        }
+        m->msg_len = (unsigned int)total;
+    }
+    return err;
+}
+#endif /* LWIP_UDP */
+
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    if (msgvec == NULL) {
+        set_errno(EFAULT);
+        return -1;
+    }
+    for (unsigned int i = 0; i < vlen; i++) {
+        if (msgvec[i].msg_hdr.msg_iovlen < 0 ||
+                (msgvec[i].msg_hdr.msg_iov == NULL && msgvec[i].msg_hdr.msg_iovlen > 0)) {
+            set_errno(EFAULT);
+            return -1;
+        }
+    }
+
+    struct lwip_sock *sock = lwip_sock_get_ref(s);
+    if (sock == NULL) {
+        return -1;
+    }
+#if LWIP_UDP
+    if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_UDP) {
+        /* UDP sends never block in lwIP, so MSG_DONTWAIT only changes how a full
+         * send buffer is reported; nothing else applies to datagrams */
+        if (flags & ~MSG_DONTWAIT) {
+            lwip_sock_put_ref(sock);
+            set_errno(EOPNOTSUPP);
+            return -1;
+        }
+        struct tcpip_sendmmsg params = {
+            .conn = sock->conn,
+            .msgvec = msgvec,
+            .vlen = vlen,
+        };
+        err_t err = tcpip_api_call(do_sendmmsg, &params.call);
+        lwip_sock_put_ref(sock);
+        if (params.sent == 0 && err != ERR_OK) {
+            set_errno((err == ERR_MEM && (flags & MSG_DONTWAIT)) ? EAGAIN : err_to_errno(err));
+            return -1;
+        }
+        return (int)params.sent;
+    }
+#endif /* LWIP_UDP */
+    lwip_sock_put_ref(sock);
+
+    /* lwip_sendmsg() takes its own reference and handles the flags */
+    unsigned int i;
+    for (i = 0; i < vlen; i++) {
+        ssize_t ret = lwip_sendmsg(s, &msgvec[i].msg_hdr, flags);
+        if (ret < 0) {
+            return i > 0 ? (int)i : -1;
+        }
+        msgvec[i].msg_len = (unsigned int)ret;
+    }
+    return (int)i;
+}
+
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+    u32_t start = sys_now();
+    u32_t timeout_ms = 0;
+    int rx_flags = flags & ~MSG_WAITFORONE;
+    unsigned int i;
+
+    if (msgvec == NULL) {
+        set_errno(EFAULT);
+        return -1;
+    }
+    if (timeout != NULL) {
+        if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 || timeout->tv_nsec >= 1000000000L) {
+            set_errno(EINVAL);
+            return -1;
+        }
+        /* Clamp before scaling so that a large tv_sec can't wrap the u32_t deadline */
+        if ((uint64_t)timeout->tv_sec >= UINT32_MAX / 1000) {
+            timeout_ms = UINT32_MAX;
+        } else {
+            timeout_ms = (u32_t)timeout->tv_sec * 1000 + (u32_t)(timeout->tv_nsec / 1000000);
+        }
+    }
+    for (i = 0; i < vlen; i++) {
+        ssize_t ret = lwip_recvmsg(s, &msgvec[i].msg_hdr, rx_flags);
+        if (ret < 0) {
+            if (i == 0) {
+                return -1;
+            }
+            break;
+        }
+        msgvec[i].msg_len = (unsigned int)ret;
+        if (flags & MSG_WAITFORONE) {
+            rx_flags |= MSG_DONTWAIT;
+        }
+        if (timeout != NULL && (u32_t)(sys_now() - start) >= timeout_ms) {
+            i++;
+            break;
+        }
+    }
+    return (int)i;
+}
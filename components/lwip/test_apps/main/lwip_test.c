@@ -1,10 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
 #include <esp_types.h>
 
 #include "freertos/FreeRTOS.h"
@@ -18,12 +20,18 @@
 #include "lwip/inet.h"
 #include "lwip/netdb.h"
 #include "lwip/sockets.h"
+#include "sys/socket.h"
 #include "lwip/tcpip.h"
+#include "lwip/priv/tcpip_priv.h"
+#include "lwip/priv/sockets_priv.h"
+#include "lwip/tcp.h"
 #include "lwip/prot/iana.h"
 #include "ping/ping_sock.h"
+#include "ping/ping_multi.h"
 #include "dhcpserver/dhcpserver.h"
 #include "dhcpserver/dhcpserver_options.h"
 #include "esp_sntp.h"
+#include "esp_timer.h"
 
 #define ETH_PING_END_BIT BIT(1)
 #define ETH_PING_DURATION_MS (5000)
@@ -134,6 +142,77 @@ TEST(lwip, localhost_ping_test)
     vEventGroupDelete(eth_event_group);
 }
 
+#define PING_MULTI_LOOPBACK_TARGETS (3)
+#define PING_MULTI_COUNT (10)
+#define PING_MULTI_UNREACHABLE "192.0.2.1"  // TEST-NET-1, there is no route to it
+
+static void test_on_ping_multi_end(esp_ping_multi_handle_t hdl, int target, void *args)
+{
+    xEventGroupSetBits((EventGroupHandle_t)args, BIT(target));
+}
+
+TEST(lwip, localhost_ping_multi_test)
+{
+    EventGroupHandle_t done = xEventGroupCreate();
+    TEST_ASSERT(done != NULL);
+    test_case_uses_tcpip();
+
+    esp_ping_multi_config_t config = ESP_PING_MULTI_DEFAULT_CONFIG();
+    config.max_targets = PING_MULTI_LOOPBACK_TARGETS + 1;
+    config.interval_ms = 50;
+    config.timeout_ms = 200;
+    esp_ping_multi_callbacks_t cbs = {
+        .on_ping_end = test_on_ping_multi_end,
+        .cb_args = done,
+    };
+    esp_ping_multi_handle_t ping;
+    TEST_ESP_OK(esp_ping_multi_new_session(&config, &cbs, &ping));
+
+    // The same address several times, replies are told apart by their sequence numbers
+    ip_addr_t addr = IPADDR4_INIT_BYTES(127, 0, 0, 1);
+    int targets[PING_MULTI_LOOPBACK_TARGETS + 1];
+    for (int i = 0; i < PING_MULTI_LOOPBACK_TARGETS; i++) {
+        TEST_ESP_OK(esp_ping_multi_add_target(ping, &addr, PING_MULTI_COUNT, &targets[i]));
+    }
+    TEST_ASSERT(ipaddr_aton(PING_MULTI_UNREACHABLE, &addr));
+    TEST_ESP_OK(esp_ping_multi_add_target(ping, &addr, PING_MULTI_COUNT, &targets[PING_MULTI_LOOPBACK_TARGETS]));
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, esp_ping_multi_add_target(ping, &addr, PING_MULTI_COUNT, &(int){0}));
+
+    int64_t start = esp_timer_get_time();
+    TEST_ESP_OK(esp_ping_multi_start(ping));
+    EventBits_t all = BIT(PING_MULTI_LOOPBACK_TARGETS + 1) - 1;
+    EventBits_t bits = xEventGroupWaitBits(done, all, true, true, pdMS_TO_TICKS(ETH_PING_END_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(all, bits);
+    printf("%d targets x %d pings in one task: %" PRId64 " ms\n", PING_MULTI_LOOPBACK_TARGETS + 1, PING_MULTI_COUNT,
+           (esp_timer_get_time() - start) / 1000);
+
+    esp_ping_multi_stats_t stats;
+    for (int i = 0; i < PING_MULTI_LOOPBACK_TARGETS; i++) {
+        TEST_ESP_OK(esp_ping_multi_get_stats(ping, targets[i], &stats));
+        printf("target %d: %" PRIu32 " transmitted, %" PRIu32 " received, rtt min/avg/max %" PRIu32 "/%" PRIu32 "/%" PRIu32 " ms\n",
+               targets[i], stats.transmitted, stats.received,
+               stats.rtt_min_ms, stats.rtt_total_ms / PING_MULTI_COUNT, stats.rtt_max_ms);
+        TEST_ASSERT_EQUAL(PING_MULTI_COUNT, stats.transmitted);
+        TEST_ASSERT_EQUAL(PING_MULTI_COUNT, stats.received);
+        TEST_ASSERT_EQUAL(0, stats.timeouts);
+        TEST_ASSERT_LESS_OR_EQUAL(stats.rtt_max_ms, stats.rtt_min_ms);
+        uint32_t hist_total = 0;
+        for (int b = 0; b < ESP_PING_MULTI_RTT_BUCKETS; b++) {
+            hist_total += stats.rtt_hist[b];
+        }
+        TEST_ASSERT_EQUAL(PING_MULTI_COUNT, hist_total);
+    }
+    TEST_ESP_OK(esp_ping_multi_get_stats(ping, targets[PING_MULTI_LOOPBACK_TARGETS], &stats));
+    TEST_ASSERT_EQUAL(0, stats.received);
+    TEST_ASSERT_EQUAL(PING_MULTI_COUNT, stats.timeouts);
+
+    TEST_ESP_OK(esp_ping_multi_stop(ping));
+    TEST_ESP_OK(esp_ping_multi_delete_session(ping));
+    // let the ping task release its resources
+    vTaskDelay(pdMS_TO_TICKS(200));
+    vEventGroupDelete(done);
+}
+
 TEST(lwip, dhcp_server_init_deinit)
 {
     dhcps_t *dhcps = dhcps_new();
@@ -304,6 +383,171 @@ TEST(lwip, dhcp_server_dns_options)
     dhcps_delete(dhcps);
 }
 
+#define DHCPS_TEST_CLIENTS (500)
+#define DHCPS_TEST_POOL_SIZE LWIP_MIN(DHCPS_TEST_CLIENTS, DHCPS_MAX_LEASE)
+#define DHCPS_TEST_BATCH (50)
+
+struct dhcps_clients_api {
+    EventGroupHandle_t event;
+    dhcps_t *dhcps;
+    err_t ret;
+    int found;
+    int last_found;
+    bool unique;
+};
+
+static void dhcps_test_client_mac(int client, u8_t *mac)
+{
+    const u8_t base[6] = { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x00 };
+    memcpy(mac, base, sizeof(base));
+    mac[4] = client >> 8;
+    mac[5] = client & 0xFF;
+}
+
+static void dhcps_test_clients_start_api(void* ctx)
+{
+    struct netif *netif;
+    struct dhcps_clients_api *api = ctx;
+    ip4_addr_t netmask = { .addr = PP_HTONL(0xFFFF0000) };
+    ip4_addr_t ip = { .addr = PP_HTONL(0x7f000001) };
+
+    NETIF_FOREACH(netif) {
+        if (netif->name[0] == 'l' && netif->name[1] == 'o') {
+            break;
+        }
+    }
+    TEST_ASSERT_NOT_NULL(netif);
+
+    api->dhcps = dhcps_new();
+    dhcps_set_option_info(api->dhcps, SUBNET_MASK, (void*)&netmask, sizeof(netmask));
+    api->ret = dhcps_start(api->dhcps, netif, ip);
+    xEventGroupSetBits(api->event, 1);
+}
+
+static void dhcps_test_clients_stop_api(void* ctx)
+{
+    struct netif *netif;
+    struct dhcps_clients_api *api = ctx;
+
+    NETIF_FOREACH(netif) {
+        if (netif->name[0] == 'l' && netif->name[1] == 'o') {
+            break;
+        }
+    }
+    api->ret = dhcps_stop(api->dhcps, netif);
+    dhcps_delete(api->dhcps);
+    xEventGroupSetBits(api->event, 1);
+}
+
+static void dhcps_test_clients_search_api(void* ctx)
+{
+    struct dhcps_clients_api *api = ctx;
+    uint32_t seen[(DHCPS_MAX_LEASE + 31) / 32] = { 0 };
+    u8_t mac[6];
+    ip4_addr_t ip;
+
+    api->found = 0;
+    api->last_found = -1;
+    api->unique = true;
+    for (int i = 0; i < DHCPS_TEST_CLIENTS; i++) {
+        dhcps_test_client_mac(i, mac);
+        if (dhcp_search_ip_on_mac(api->dhcps, mac, &ip)) {
+            // the pool starts next to the server address, 127.0.0.2
+            uint32_t offset = lwip_ntohl(ip.addr) - 0x7f000002;
+            if (offset >= DHCPS_MAX_LEASE || (seen[offset / 32] & BIT(offset % 32))) {
+                api->unique = false;
+            } else {
+                seen[offset / 32] |= BIT(offset % 32);
+            }
+            api->found++;
+            api->last_found = i;
+        }
+    }
+    xEventGroupSetBits(api->event, 1);
+}
+
+static void dhcps_test_clients_sync_api(void* ctx)
+{
+    struct dhcps_clients_api *api = ctx;
+    xEventGroupSetBits(api->event, 1);
+}
+
+static void dhcps_test_clients_call(tcpip_callback_fn fn, struct dhcps_clients_api *api)
+{
+    TEST_ASSERT_EQUAL(ERR_OK, tcpip_callback(fn, api));
+    TEST_ASSERT_EQUAL(1, xEventGroupWaitBits(api->event, 1, true, true, pdMS_TO_TICKS(5000)) & 1);
+}
+
+static void dhcps_test_client_send(int sock, int client, u8_t type)
+{
+    struct dhcps_msg msg = { 0 };
+    const u8_t options[] = { 0x63, 0x82, 0x53, 0x63, 53, 1, type, 255 };
+    struct sockaddr_in to = {
+        .sin_family = AF_INET,
+        .sin_port = htons(67),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+
+    msg.op = 1;
+    msg.htype = 1;
+    msg.hlen = 6;
+    memcpy(msg.xid, &client, sizeof(msg.xid));
+    // broadcast replies, the loopback interface has no ARP table
+    msg.flags = htons(0x8000);
+    dhcps_test_client_mac(client, msg.chaddr);
+    memcpy(msg.options, options, sizeof(options));
+    TEST_ASSERT_EQUAL(sizeof(msg), sendto(sock, &msg, sizeof(msg), 0, (struct sockaddr *)&to, sizeof(to)));
+}
+
+TEST(lwip, dhcp_server_many_clients)
+{
+    test_case_uses_tcpip();
+    struct dhcps_clients_api api = { .event = xEventGroupCreate(), .ret = ERR_IF };
+    int64_t batch_us[DHCPS_TEST_CLIENTS / DHCPS_TEST_BATCH] = { 0 };
+
+    dhcps_test_clients_call(dhcps_test_clients_start_api, &api);
+    TEST_ASSERT_EQUAL(ERR_OK, api.ret);
+
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, sock);
+
+    // each client discovers, the server leases an address on the first message;
+    // wait until the server has handled it, the loopback queue is short
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < DHCPS_TEST_CLIENTS; i++) {
+        int64_t t = esp_timer_get_time();
+        dhcps_test_client_send(sock, i, 1 /* DHCPDISCOVER */);
+        dhcps_test_clients_call(dhcps_test_clients_sync_api, &api);
+        batch_us[i / DHCPS_TEST_BATCH] += esp_timer_get_time() - t;
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    printf("dhcps: %d clients in %lld us, per request: first %d %lld us, last %d %lld us\n",
+           DHCPS_TEST_CLIENTS, elapsed_us,
+           DHCPS_TEST_BATCH, batch_us[0] / DHCPS_TEST_BATCH,
+           DHCPS_TEST_BATCH, batch_us[DHCPS_TEST_CLIENTS / DHCPS_TEST_BATCH - 1] / DHCPS_TEST_BATCH);
+
+    dhcps_test_clients_call(dhcps_test_clients_search_api, &api);
+    TEST_ASSERT_TRUE(api.unique);
+    TEST_ASSERT_LESS_OR_EQUAL(DHCPS_TEST_POOL_SIZE, api.found);
+    // the server drops the oldest lease every second above the maximum number of stations
+    TEST_ASSERT_GREATER_OR_EQUAL(LWIP_MIN(DHCPS_TEST_POOL_SIZE, CONFIG_LWIP_DHCPS_MAX_STATION_NUM), api.found);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, api.last_found);
+
+    // the released address is free again
+    int released = api.last_found;
+    int found = api.found;
+    dhcps_test_client_send(sock, released, 7 /* DHCPRELEASE */);
+    dhcps_test_clients_call(dhcps_test_clients_sync_api, &api);
+    dhcps_test_clients_call(dhcps_test_clients_search_api, &api);
+    TEST_ASSERT_LESS_THAN(found, api.found);
+    TEST_ASSERT_NOT_EQUAL(released, api.last_found);
+
+    close(sock);
+    dhcps_test_clients_call(dhcps_test_clients_stop_api, &api);
+    TEST_ASSERT_EQUAL(ERR_OK, api.ret);
+    vEventGroupDelete(api.event);
+}
+
 int test_sntp_server_create(void)
 {
     struct sockaddr_in dest_addr_ip4;
@@ -402,14 +646,644 @@ TEST(lwip, sntp_client_time_2048)
     test_sntp_timestamps(2048, false); // NTP timestamp MSB is cleared for time after 2036
 }
 
+TEST(lwip, udp_recv_zero_copy_localhost)
+{
+    test_case_uses_tcpip();
+    const char payload[] = "zero-copy localhost datagram";
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(3333),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, sock);
+    TEST_ASSERT_EQUAL(0, bind(sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(sizeof(payload), sendto(sock, payload, sizeof(payload), 0, (struct sockaddr *)&addr, sizeof(addr)));
+
+        struct iovec iov[4];
+        lwip_zc_buf_t zc = { .iov = iov, .iovcnt = 4 };
+        struct sockaddr_in from;
+        uint32_t fromlen = sizeof(from);
+        TEST_ASSERT_EQUAL(sizeof(payload), lwip_recv_zc(sock, &zc, 0, (struct sockaddr *)&from, &fromlen));
+        TEST_ASSERT_EQUAL(1, zc.iovcnt);
+        TEST_ASSERT_EQUAL(0, zc.flags);
+        TEST_ASSERT_EQUAL_MEMORY(payload, iov[0].iov_base, sizeof(payload));
+        TEST_ASSERT_EQUAL(sizeof(from), fromlen);
+        TEST_ASSERT_EQUAL(htonl(INADDR_LOOPBACK), from.sin_addr.s_addr);
+        lwip_recv_zc_release(sock, &zc);
+        TEST_ASSERT_NULL(zc.priv);
+    }
+
+    // nothing left to read
+    struct iovec iov;
+    lwip_zc_buf_t zc = { .iov = &iov, .iovcnt = 1 };
+    TEST_ASSERT_EQUAL(-1, lwip_recv_zc(sock, &zc, MSG_DONTWAIT, NULL, NULL));
+    TEST_ASSERT_EQUAL(EWOULDBLOCK, errno);
+    close(sock);
+}
+
+static void test_tcp_localhost_pair(uint16_t port, int *listener, int *client, int *server)
+{
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int reuse_en = 1;
+    *listener = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, *listener);
+    TEST_ASSERT_EQUAL(0, setsockopt(*listener, SOL_SOCKET, SO_REUSEADDR, &reuse_en, sizeof(reuse_en)));
+    TEST_ASSERT_EQUAL(0, bind(*listener, (struct sockaddr *)&addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL(0, listen(*listener, 1));
+    if (client != NULL) {
+        *client = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+        TEST_ASSERT_GREATER_OR_EQUAL(0, *client);
+        TEST_ASSERT_EQUAL(0, connect(*client, (struct sockaddr *)&addr, sizeof(addr)));
+        *server = accept(*listener, NULL, NULL);
+        TEST_ASSERT_GREATER_OR_EQUAL(0, *server);
+    }
+}
+
+struct test_tcp_rcv_wnd {
+    struct tcpip_api_call_data call;
+    struct netconn *conn;
+    tcpwnd_size_t wnd;
+};
+
+static err_t test_tcp_rcv_wnd_fn(struct tcpip_api_call_data *msg)
+{
+    struct test_tcp_rcv_wnd *params = __containerof(msg, struct test_tcp_rcv_wnd, call);
+    params->wnd = params->conn->pcb.tcp->rcv_wnd;
+    return ERR_OK;
+}
+
+// receive window of a TCP socket, read in the tcpip context
+static tcpwnd_size_t test_tcp_rcv_wnd(int s)
+{
+    struct lwip_sock *sock = lwip_socket_dbg_get_socket(s);
+    TEST_ASSERT_NOT_NULL(sock);
+    struct test_tcp_rcv_wnd params = { .conn = sock->conn };
+    TEST_ASSERT_EQUAL(ERR_OK, tcpip_api_call(test_tcp_rcv_wnd_fn, &params.call));
+    return params.wnd;
+}
+
+#define TEST_TCP_ZC_LEN     (1000)
+#define TEST_TCP_ZC_BUFS    (8)
+
+TEST(lwip, tcp_recv_zero_copy_window)
+{
+    test_case_uses_tcpip();
+    int listener, client, server;
+    test_tcp_localhost_pair(3340, &listener, &client, &server);
+    tcpwnd_size_t wnd = test_tcp_rcv_wnd(server);
+    uint8_t payload[TEST_TCP_ZC_LEN];
+    for (int i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 7);
+    }
+
+    // the window stays closed by the borrowed data until it is released (NETCONN_NOAUTORCVD)
+    TEST_ASSERT_EQUAL(sizeof(payload), send(client, payload, sizeof(payload), 0));
+    struct iovec iov[TEST_TCP_ZC_BUFS];
+    lwip_zc_buf_t zc[TEST_TCP_ZC_BUFS];
+    int bufs = 0;
+    size_t received = 0;
+    while (received < sizeof(payload)) {
+        TEST_ASSERT_LESS_THAN(TEST_TCP_ZC_BUFS, bufs);
+        zc[bufs] = (lwip_zc_buf_t) { .iov = &iov[bufs], .iovcnt = 1 };
+        ssize_t len = lwip_recv_zc(server, &zc[bufs], 0, NULL, NULL);
+        TEST_ASSERT_GREATER_THAN(0, len);
+        TEST_ASSERT_EQUAL(len, iov[bufs].iov_len);
+        TEST_ASSERT_EQUAL_MEMORY(payload + received, iov[bufs].iov_base, len);
+        received += len;
+        bufs++;
+    }
+    TEST_ASSERT_EQUAL(sizeof(payload), received);
+    TEST_ASSERT_EQUAL(wnd - sizeof(payload), test_tcp_rcv_wnd(server));
+    for (int i = 0; i < bufs; i++) {
+        lwip_recv_zc_release(server, &zc[i]);
+        TEST_ASSERT_NULL(zc[i].priv);
+    }
+    TEST_ASSERT_EQUAL(wnd, test_tcp_rcv_wnd(server));
+
+    // data left over by lwip_recv() is returned first, its window is reopened on release
+    TEST_ASSERT_EQUAL(100, send(client, payload, 100, 0));
+    uint8_t buf[30];
+    TEST_ASSERT_EQUAL(sizeof(buf), recv(server, buf, sizeof(buf), 0));
+    TEST_ASSERT_EQUAL_MEMORY(payload, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(wnd - (100 - sizeof(buf)), test_tcp_rcv_wnd(server));
+    zc[0] = (lwip_zc_buf_t) { .iov = iov, .iovcnt = TEST_TCP_ZC_BUFS };
+    TEST_ASSERT_EQUAL(100 - sizeof(buf), lwip_recv_zc(server, &zc[0], MSG_DONTWAIT, NULL, NULL));
+    TEST_ASSERT_EQUAL(1, zc[0].iovcnt);
+    TEST_ASSERT_EQUAL_MEMORY(payload + sizeof(buf), iov[0].iov_base, 100 - sizeof(buf));
+    TEST_ASSERT_EQUAL(wnd - (100 - sizeof(buf)), test_tcp_rcv_wnd(server));
+    lwip_recv_zc_release(server, &zc[0]);
+    TEST_ASSERT_EQUAL(wnd, test_tcp_rcv_wnd(server));
+
+    // orderly shutdown
+    close(client);
+    zc[0] = (lwip_zc_buf_t) { .iov = iov, .iovcnt = 1 };
+    TEST_ASSERT_EQUAL(0, lwip_recv_zc(server, &zc[0], 0, NULL, NULL));
+    close(server);
+    close(listener);
+}
+
+TEST(lwip, tcp_recv_zero_copy_chain_split)
+{
+    test_case_uses_tcpip();
+    int listener, client, server;
+    test_tcp_localhost_pair(3341, &listener, &client, &server);
+
+    // a chain of three pbufs, as left in lastdata, read through two iovecs at a time
+    const u16_t lens[] = { 10, 20, 30 };
+    struct pbuf *chain = NULL;
+    uint8_t value = 0;
+    for (int i = 0; i < 3; i++) {
+        struct pbuf *p = pbuf_alloc(PBUF_RAW, lens[i], PBUF_RAM);
+        TEST_ASSERT_NOT_NULL(p);
+        for (int j = 0; j < lens[i]; j++) {
+            ((uint8_t *)p->payload)[j] = value++;
+        }
+        if (chain == NULL) {
+            chain = p;
+        } else {
+            pbuf_cat(chain, p);
+        }
+    }
+    struct lwip_sock *sock = lwip_socket_dbg_get_socket(server);
+    TEST_ASSERT_NULL(sock->lastdata.pbuf);
+    sock->lastdata.pbuf = chain;
+
+    struct iovec iov[2];
+    lwip_zc_buf_t zc = { .iov = iov, .iovcnt = 2 };
+    TEST_ASSERT_EQUAL(lens[0] + lens[1], lwip_recv_zc(server, &zc, MSG_DONTWAIT, NULL, NULL));
+    TEST_ASSERT_EQUAL(2, zc.iovcnt);
+    TEST_ASSERT_EQUAL(lens[0], iov[0].iov_len);
+    TEST_ASSERT_EQUAL(lens[1], iov[1].iov_len);
+    TEST_ASSERT_EQUAL(0, ((uint8_t *)iov[0].iov_base)[0]);
+    TEST_ASSERT_EQUAL(lens[0], ((uint8_t *)iov[1].iov_base)[0]);
+    // the borrowed head and the tail kept in lastdata are separate chains now
+    struct pbuf *head = (struct pbuf *)zc.priv;
+    TEST_ASSERT_EQUAL(lens[0] + lens[1], head->tot_len);
+    TEST_ASSERT_NULL(head->next->next);
+    TEST_ASSERT_NOT_NULL(sock->lastdata.pbuf);
+    TEST_ASSERT_EQUAL(lens[2], sock->lastdata.pbuf->tot_len);
+    lwip_recv_zc_release(server, &zc);
+
+    zc = (lwip_zc_buf_t) { .iov = iov, .iovcnt = 2 };
+    TEST_ASSERT_EQUAL(lens[2], lwip_recv_zc(server, &zc, MSG_DONTWAIT, NULL, NULL));
+    TEST_ASSERT_EQUAL(1, zc.iovcnt);
+    TEST_ASSERT_EQUAL(lens[0] + lens[1], ((uint8_t *)iov[0].iov_base)[0]);
+    TEST_ASSERT_NULL(sock->lastdata.pbuf);
+    lwip_recv_zc_release(server, &zc);
+
+    zc = (lwip_zc_buf_t) { .iov = iov, .iovcnt = 2 };
+    TEST_ASSERT_EQUAL(-1, lwip_recv_zc(server, &zc, MSG_DONTWAIT, NULL, NULL));
+    TEST_ASSERT_EQUAL(EWOULDBLOCK, errno);
+    close(client);
+    close(server);
+    close(listener);
+}
+
+#define TEST_TCP_BENCH_PORT     (3342)
+#define TEST_TCP_BENCH_BYTES    (256 * 1024)
+#define TEST_TCP_BENCH_CHUNK    (1436)
+
+static void test_tcp_bench_sender_task(void *arg)
+{
+    EventGroupHandle_t done = (EventGroupHandle_t)arg;
+    static uint8_t chunk[TEST_TCP_BENCH_CHUNK];
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(TEST_TCP_BENCH_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    if (sock >= 0 && connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+        size_t sent = 0;
+        while (sent < TEST_TCP_BENCH_BYTES) {
+            ssize_t len = send(sock, chunk, LWIP_MIN(sizeof(chunk), TEST_TCP_BENCH_BYTES - sent), 0);
+            if (len <= 0) {
+                break;
+            }
+            sent += len;
+        }
+    }
+    close(sock);
+    xEventGroupSetBits(done, BIT(0));
+    vTaskDelete(NULL);
+}
+
+// receives the whole stream of the sender task, returns the elapsed time
+static int64_t test_tcp_bench_receive(int listener, bool zero_copy)
+{
+    static uint8_t buf[TEST_TCP_BENCH_CHUNK];
+    EventGroupHandle_t done = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(done);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(test_tcp_bench_sender_task, "tcp_sender", 4096, done, 5, NULL));
+    int server = accept(listener, NULL, NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, server);
+
+    int64_t start = esp_timer_get_time();
+    size_t received = 0;
+    uint32_t sum = 0;
+    for (;;) {
+        ssize_t len;
+        if (zero_copy) {
+            struct iovec iov[4];
+            lwip_zc_buf_t zc = { .iov = iov, .iovcnt = 4 };
+            len = lwip_recv_zc(server, &zc, 0, NULL, NULL);
+            for (int i = 0; i < zc.iovcnt && len > 0; i++) {
+                sum += ((uint8_t *)iov[i].iov_base)[0];
+            }
+            lwip_recv_zc_release(server, &zc);
+        } else {
+            len = recv(server, buf, sizeof(buf), 0);
+            sum += len > 0 ? buf[0] : 0;
+        }
+        if (len <= 0) {
+            TEST_ASSERT_EQUAL(0, len);
+            break;
+        }
+        received += len;
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(TEST_TCP_BENCH_BYTES, received);
+    TEST_ASSERT_EQUAL(0, sum);
+    TEST_ASSERT_EQUAL(BIT(0), xEventGroupWaitBits(done, BIT(0), true, true, pdMS_TO_TICKS(5000)));
+    vEventGroupDelete(done);
+    close(server);
+    return elapsed_us;
+}
+
+TEST(lwip, tcp_recv_copy_vs_zero_copy_localhost)
+{
+    test_case_uses_tcpip();
+    int listener;
+    test_tcp_localhost_pair(TEST_TCP_BENCH_PORT, &listener, NULL, NULL);
+    int64_t copy_us = test_tcp_bench_receive(listener, false);
+    int64_t zc_us = test_tcp_bench_receive(listener, true);
+    printf("%d bytes over localhost TCP: recv() %" PRId64 " us (%" PRId64 " kB/s), lwip_recv_zc() %" PRId64 " us (%" PRId64 " kB/s)\n",
+           TEST_TCP_BENCH_BYTES, copy_us, (int64_t)TEST_TCP_BENCH_BYTES * 1000000 / 1024 / copy_us,
+           zc_us, (int64_t)TEST_TCP_BENCH_BYTES * 1000000 / 1024 / zc_us);
+    close(listener);
+}
+
+#define TEST_MMSG_BATCH      (8)
+#define TEST_MMSG_ROUNDS     (200)
+
+static int test_udp_localhost_socket(struct sockaddr_in *addr, uint16_t port)
+{
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(port);
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, sock);
+    TEST_ASSERT_EQUAL(0, bind(sock, (struct sockaddr *)addr, sizeof(*addr)));
+    return sock;
+}
+
+#define TEST_MMSG_LEN   (24)
+
+static void test_mmsg_fill_batch(char tx_data[][TEST_MMSG_LEN], struct iovec *tx_iov, int round)
+{
+    for (int i = 0; i < TEST_MMSG_BATCH; i++) {
+        snprintf(tx_data[i], TEST_MMSG_LEN, "round %d datagram %d", round, i);
+        tx_iov[i].iov_len = strlen(tx_data[i]) + 1;
+    }
+}
+
+static void test_mmsg_check_batch(int received, char rx_data[][TEST_MMSG_LEN], struct mmsghdr *rx_msgs,
+                                  char tx_data[][TEST_MMSG_LEN], struct iovec *tx_iov)
+{
+    TEST_ASSERT_EQUAL(TEST_MMSG_BATCH, received);
+    for (int i = 0; i < TEST_MMSG_BATCH; i++) {
+        TEST_ASSERT_EQUAL(tx_iov[i].iov_len, rx_msgs[i].msg_len);
+        TEST_ASSERT_EQUAL_STRING(tx_data[i], rx_data[i]);
+    }
+    memset(rx_data, 0, TEST_MMSG_BATCH * TEST_MMSG_LEN);
+}
+
+TEST(lwip, udp_sendmmsg_recvmmsg_localhost)
+{
+    test_case_uses_tcpip();
+    struct sockaddr_in addr;
+    int sock = test_udp_localhost_socket(&addr, 3334);
+
+    char tx_data[TEST_MMSG_BATCH][TEST_MMSG_LEN];
+    char rx_data[TEST_MMSG_BATCH][TEST_MMSG_LEN];
+    struct iovec tx_iov[TEST_MMSG_BATCH];
+    struct iovec rx_iov[TEST_MMSG_BATCH];
+    struct mmsghdr tx_msgs[TEST_MMSG_BATCH];
+    struct mmsghdr rx_msgs[TEST_MMSG_BATCH];
+    memset(tx_msgs, 0, sizeof(tx_msgs));
+    memset(rx_msgs, 0, sizeof(rx_msgs));
+    memset(rx_data, 0, sizeof(rx_data));
+    for (int i = 0; i < TEST_MMSG_BATCH; i++) {
+        tx_iov[i].iov_base = tx_data[i];
+        tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+        tx_msgs[i].msg_hdr.msg_iovlen = 1;
+        tx_msgs[i].msg_hdr.msg_name = &addr;
+        tx_msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+        rx_iov[i].iov_base = rx_data[i];
+        rx_iov[i].iov_len = sizeof(rx_data[i]);
+        rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+        rx_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    test_mmsg_fill_batch(tx_data, tx_iov, 0);
+
+    TEST_ASSERT_EQUAL(TEST_MMSG_BATCH, lwip_sendmmsg(sock, tx_msgs, TEST_MMSG_BATCH, 0));
+    for (int i = 0; i < TEST_MMSG_BATCH; i++) {
+        TEST_ASSERT_EQUAL(tx_iov[i].iov_len, tx_msgs[i].msg_len);
+    }
+    test_mmsg_check_batch(lwip_recvmmsg(sock, rx_msgs, TEST_MMSG_BATCH, MSG_WAITFORONE, NULL),
+                          rx_data, rx_msgs, tx_data, tx_iov);
+    // queue is drained, a non-blocking batch receive has to fail
+    TEST_ASSERT_EQUAL(-1, lwip_recvmmsg(sock, rx_msgs, TEST_MMSG_BATCH, MSG_DONTWAIT, NULL));
+    TEST_ASSERT_EQUAL(EWOULDBLOCK, errno);
+
+    // invalid arguments are rejected before anything is sent
+    TEST_ASSERT_EQUAL(-1, lwip_sendmmsg(sock, tx_msgs, TEST_MMSG_BATCH, MSG_OOB));
+    TEST_ASSERT_EQUAL(EOPNOTSUPP, errno);
+    tx_msgs[TEST_MMSG_BATCH - 1].msg_hdr.msg_iov = NULL;
+    TEST_ASSERT_EQUAL(-1, lwip_sendmmsg(sock, tx_msgs, TEST_MMSG_BATCH, 0));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+    tx_msgs[TEST_MMSG_BATCH - 1].msg_hdr.msg_iov = &tx_iov[TEST_MMSG_BATCH - 1];
+    struct timespec bad_timeout = { .tv_sec = 0, .tv_nsec = 1000000000L };
+    TEST_ASSERT_EQUAL(-1, lwip_recvmmsg(sock, rx_msgs, TEST_MMSG_BATCH, MSG_DONTWAIT, &bad_timeout));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_EQUAL(-1, lwip_recvmmsg(sock, rx_msgs, TEST_MMSG_BATCH, MSG_DONTWAIT, NULL));
+    TEST_ASSERT_EQUAL(EWOULDBLOCK, errno);
+
+    // a timeout too large for a millisecond u32_t must not wrap to an early expiry
+    struct timespec long_timeout = { .tv_sec = 5000000, .tv_nsec = 0 };
+    TEST_ASSERT_EQUAL(TEST_MMSG_BATCH, lwip_sendmmsg(sock, tx_msgs, TEST_MMSG_BATCH, MSG_DONTWAIT));
+    test_mmsg_check_batch(lwip_recvmmsg(sock, rx_msgs, TEST_MMSG_BATCH, 0, &long_timeout),
+                          rx_data, rx_msgs, tx_data, tx_iov);
+
+    // compare throughput of per-datagram sendto() and batched sendmmsg(),
+    // blocking for the whole batch so that every round checks all datagrams
+    int64_t start = esp_timer_get_time();
+    for (int r = 0; r < TEST_MMSG_ROUNDS; r++) {
+        test_mmsg_fill_batch(tx_data, tx_iov, r);
+        for (int i = 0; i < TEST_MMSG_BATCH; i++) {
+            TEST_ASSERT_EQUAL(tx_iov[i].iov_len, sendto(sock, tx_data[i], tx_iov[i].iov_len, 0, (struct sockaddr *)&addr, sizeof(addr)));
+        }
+        test_mmsg_check_batch(lwip_recvmmsg(sock, rx_msgs, TEST_MMSG_BATCH, 0, NULL),
+                              rx_data, rx_msgs, tx_data, tx_iov);
+    }
+    int64_t single_us = esp_timer_get_time() - start;
+    start = esp_timer_get_time();
+    for (int r = 0; r < TEST_MMSG_ROUNDS; r++) {
+        test_mmsg_fill_batch(tx_data, tx_iov, r);
+        TEST_ASSERT_EQUAL(TEST_MMSG_BATCH, lwip_sendmmsg(sock, tx_msgs, TEST_MMSG_BATCH, 0));
+        test_mmsg_check_batch(lwip_recvmmsg(sock, rx_msgs, TEST_MMSG_BATCH, 0, NULL),
+                              rx_data, rx_msgs, tx_data, tx_iov);
+    }
+    int64_t batch_us = esp_timer_get_time() - start;
+    printf("%d datagrams: sendto %" PRId64 " us, sendmmsg %" PRId64 " us\n",
+           TEST_MMSG_BATCH * TEST_MMSG_ROUNDS, single_us, batch_us);
+    close(sock);
+}
+
+#define TEST_TCPIP_CLIENTS          (8)
+#define TEST_TCPIP_CALLS_PER_CLIENT (500)
+
+struct test_tcpip_noop {
+    struct tcpip_api_call_data call;
+    uint32_t *counter;
+};
+
+static err_t test_tcpip_noop_fn(struct tcpip_api_call_data *msg)
+{
+    struct test_tcpip_noop *params = __containerof(msg, struct test_tcpip_noop, call);
+    (*params->counter)++;   // runs in tcpip context, no locking needed
+    return ERR_OK;
+}
+
+struct test_tcpip_client {
+    EventGroupHandle_t done;
+    int index;
+};
+
+static void test_tcpip_client_task(void *arg)
+{
+    struct test_tcpip_client *client = (struct test_tcpip_client *)arg;
+    static uint32_t counter;
+    struct test_tcpip_noop params = { .counter = &counter };
+    for (int i = 0; i < TEST_TCPIP_CALLS_PER_CLIENT; i++) {
+        tcpip_api_call(test_tcpip_noop_fn, &params.call);
+    }
+    xEventGroupSetBits(client->done, BIT(client->index));
+    vTaskDelete(NULL);
+}
+
+TEST(lwip, tcpip_mbox_many_clients)
+{
+    test_case_uses_tcpip();
+    struct test_tcpip_client clients[TEST_TCPIP_CLIENTS];
+    EventGroupHandle_t done = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(done);
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < TEST_TCPIP_CLIENTS; i++) {
+        clients[i].done = done;
+        clients[i].index = i;
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(test_tcpip_client_task, "tcpip_client", 4096, &clients[i], 5, NULL));
+    }
+    EventBits_t bits = xEventGroupWaitBits(done, BIT(TEST_TCPIP_CLIENTS) - 1, true, true, pdMS_TO_TICKS(20000));
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(BIT(TEST_TCPIP_CLIENTS) - 1, bits);
+    printf("%d clients x %d tcpip calls: %" PRId64 " us, %" PRId64 " ns per call\n",
+           TEST_TCPIP_CLIENTS, TEST_TCPIP_CALLS_PER_CLIENT, elapsed_us,
+           elapsed_us * 1000 / (TEST_TCPIP_CLIENTS * TEST_TCPIP_CALLS_PER_CLIENT));
+    vEventGroupDelete(done);
+}
+
+#define TEST_MBOX_SIZE          (4)
+#define TEST_MBOX_WRITERS       (2)
+#define TEST_MBOX_ROUND_TRIPS   (1000)
+
+struct test_mbox_peer {
+    sys_mbox_t *mbox;
+    sys_mbox_t *reply;
+    EventGroupHandle_t done;
+    int index;
+    void *msg;
+};
+
+static void test_mbox_writer_task(void *arg)
+{
+    struct test_mbox_peer *peer = (struct test_mbox_peer *)arg;
+    sys_mbox_post(peer->mbox, peer->msg);
+    xEventGroupSetBits(peer->done, BIT(peer->index));
+    vTaskDelete(NULL);
+}
+
+static void test_mbox_reader_task(void *arg)
+{
+    struct test_mbox_peer *peer = (struct test_mbox_peer *)arg;
+    if (sys_arch_mbox_fetch(peer->mbox, &peer->msg, 0) == 0) {
+        xEventGroupSetBits(peer->done, BIT(peer->index));
+    }
+    vTaskDelete(NULL);
+}
+
+static void test_mbox_echo_task(void *arg)
+{
+    struct test_mbox_peer *peer = (struct test_mbox_peer *)arg;
+    void *msg;
+    do {
+        sys_arch_mbox_fetch(peer->mbox, &msg, 0);
+        sys_mbox_post(peer->reply, msg);
+    } while (msg != NULL);
+    xEventGroupSetBits(peer->done, BIT(peer->index));
+    vTaskDelete(NULL);
+}
+
+TEST(lwip, sys_mbox_full_empty)
+{
+    sys_mbox_t mbox;
+    void *msg;
+    TEST_ASSERT_EQUAL(ERR_OK, sys_mbox_new(&mbox, TEST_MBOX_SIZE));
+
+    // empty mailbox: tryfetch fails at once, fetch times out
+    TEST_ASSERT_EQUAL(SYS_MBOX_EMPTY, sys_arch_mbox_tryfetch(&mbox, &msg));
+    TEST_ASSERT_NULL(msg);
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(SYS_ARCH_TIMEOUT, sys_arch_mbox_fetch(&mbox, &msg, 50));
+    TEST_ASSERT_NULL(msg);
+    TEST_ASSERT_GREATER_OR_EQUAL(40000, esp_timer_get_time() - start);
+
+    // full mailbox: trypost fails, messages come out in order across the wrap-around
+    uintptr_t next_post = 1, next_fetch = 1;
+    for (int round = 0; round < 3; round++) {
+        while (sys_mbox_trypost(&mbox, (void *)next_post) == ERR_OK) {
+            next_post++;
+        }
+        TEST_ASSERT_EQUAL(TEST_MBOX_SIZE, next_post - next_fetch);
+        for (int i = 0; i < TEST_MBOX_SIZE - 1; i++) {
+            TEST_ASSERT_EQUAL(0, sys_arch_mbox_tryfetch(&mbox, &msg));
+            TEST_ASSERT_EQUAL_PTR((void *)next_fetch++, msg);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, sys_arch_mbox_fetch(&mbox, &msg, 50));
+    TEST_ASSERT_EQUAL_PTR((void *)next_fetch++, msg);
+    TEST_ASSERT_EQUAL(next_post, next_fetch);
+    TEST_ASSERT_EQUAL(SYS_MBOX_EMPTY, sys_arch_mbox_tryfetch(&mbox, NULL));
+
+    sys_mbox_free(&mbox);
+    TEST_ASSERT_NULL(mbox);
+}
+
+TEST(lwip, sys_mbox_blocked_writers_readers)
+{
+    sys_mbox_t mbox;
+    void *msg;
+    struct test_mbox_peer peers[TEST_MBOX_WRITERS];
+    EventGroupHandle_t done = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(done);
+    TEST_ASSERT_EQUAL(ERR_OK, sys_mbox_new(&mbox, TEST_MBOX_SIZE));
+
+    // writers block on a full mailbox and are released one per fetched message
+    for (uintptr_t i = 0; i < TEST_MBOX_SIZE; i++) {
+        TEST_ASSERT_EQUAL(ERR_OK, sys_mbox_trypost(&mbox, (void *)(i + 1)));
+    }
+    for (int i = 0; i < TEST_MBOX_WRITERS; i++) {
+        peers[i] = (struct test_mbox_peer) { .mbox = &mbox, .done = done, .index = i, .msg = (void *)(uintptr_t)(0x100 + i) };
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(test_mbox_writer_task, "mbox_writer", 2048, &peers[i], 5, NULL));
+    }
+    TEST_ASSERT_EQUAL(0, xEventGroupWaitBits(done, BIT(TEST_MBOX_WRITERS) - 1, false, false, pdMS_TO_TICKS(50)));
+    TEST_ASSERT_EQUAL(0, sys_arch_mbox_tryfetch(&mbox, &msg));
+    TEST_ASSERT_EQUAL_PTR((void *)1, msg);
+    EventBits_t bits = xEventGroupWaitBits(done, BIT(TEST_MBOX_WRITERS) - 1, false, false, pdMS_TO_TICKS(1000));
+    TEST_ASSERT_NOT_EQUAL(0, bits);
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(bits, xEventGroupGetBits(done));
+    TEST_ASSERT_EQUAL(ERR_MEM, sys_mbox_trypost(&mbox, (void *)0x200));
+    TEST_ASSERT_EQUAL(0, sys_arch_mbox_fetch(&mbox, &msg, 0));
+    TEST_ASSERT_EQUAL_PTR((void *)2, msg);
+    TEST_ASSERT_EQUAL(BIT(TEST_MBOX_WRITERS) - 1, xEventGroupWaitBits(done, BIT(TEST_MBOX_WRITERS) - 1, true, true, pdMS_TO_TICKS(1000)));
+    for (uintptr_t i = 3; i <= TEST_MBOX_SIZE; i++) {
+        TEST_ASSERT_EQUAL(0, sys_arch_mbox_tryfetch(&mbox, &msg));
+        TEST_ASSERT_EQUAL_PTR((void *)i, msg);
+    }
+    uintptr_t writers_msgs = 0;
+    for (int i = 0; i < TEST_MBOX_WRITERS; i++) {
+        TEST_ASSERT_EQUAL(0, sys_arch_mbox_tryfetch(&mbox, &msg));
+        writers_msgs |= BIT((uintptr_t)msg - 0x100);
+    }
+    TEST_ASSERT_EQUAL(BIT(TEST_MBOX_WRITERS) - 1, writers_msgs);
+
+    // readers block on an empty mailbox and are released one per posted message
+    for (int i = 0; i < TEST_MBOX_WRITERS; i++) {
+        peers[i].msg = NULL;
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(test_mbox_reader_task, "mbox_reader", 2048, &peers[i], 5, NULL));
+    }
+    TEST_ASSERT_EQUAL(0, xEventGroupWaitBits(done, BIT(TEST_MBOX_WRITERS) - 1, false, false, pdMS_TO_TICKS(50)));
+    sys_mbox_post(&mbox, (void *)0x300);
+    bits = xEventGroupWaitBits(done, BIT(TEST_MBOX_WRITERS) - 1, false, false, pdMS_TO_TICKS(1000));
+    TEST_ASSERT_NOT_EQUAL(0, bits);
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(bits, xEventGroupGetBits(done));
+    sys_mbox_post(&mbox, (void *)0x301);
+    TEST_ASSERT_EQUAL(BIT(TEST_MBOX_WRITERS) - 1, xEventGroupWaitBits(done, BIT(TEST_MBOX_WRITERS) - 1, true, true, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL(0x601, (uintptr_t)peers[0].msg + (uintptr_t)peers[1].msg);
+    TEST_ASSERT_EQUAL(SYS_MBOX_EMPTY, sys_arch_mbox_tryfetch(&mbox, &msg));
+
+    sys_mbox_free(&mbox);
+    vEventGroupDelete(done);
+}
+
+TEST(lwip, sys_mbox_round_trip_latency)
+{
+    sys_mbox_t mbox, reply;
+    void *msg;
+    EventGroupHandle_t done = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(done);
+    TEST_ASSERT_EQUAL(ERR_OK, sys_mbox_new(&mbox, TEST_MBOX_SIZE));
+    TEST_ASSERT_EQUAL(ERR_OK, sys_mbox_new(&reply, TEST_MBOX_SIZE));
+    struct test_mbox_peer echo = { .mbox = &mbox, .reply = &reply, .done = done };
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(test_mbox_echo_task, "mbox_echo", 2048, &echo, 5, NULL));
+
+    // every message wakes up a blocked reader, on both sides
+    int64_t start = esp_timer_get_time();
+    for (uintptr_t i = 1; i <= TEST_MBOX_ROUND_TRIPS; i++) {
+        sys_mbox_post(&mbox, (void *)i);
+        TEST_ASSERT_EQUAL(0, sys_arch_mbox_fetch(&reply, &msg, 1000));
+        TEST_ASSERT_EQUAL_PTR((void *)i, msg);
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    printf("%d mbox round trips: %" PRId64 " us, %" PRId64 " ns per message\n",
+           TEST_MBOX_ROUND_TRIPS, elapsed_us, elapsed_us * 1000 / (2 * TEST_MBOX_ROUND_TRIPS));
+
+    sys_mbox_post(&mbox, NULL);
+    TEST_ASSERT_EQUAL(0, sys_arch_mbox_fetch(&reply, &msg, 1000));
+    TEST_ASSERT_EQUAL(BIT(0), xEventGroupWaitBits(done, BIT(0), true, true, pdMS_TO_TICKS(1000)));
+    sys_mbox_free(&mbox);
+    sys_mbox_free(&reply);
+    vEventGroupDelete(done);
+}
+
 TEST_GROUP_RUNNER(lwip)
 {
     RUN_TEST_CASE(lwip, localhost_ping_test)
+    RUN_TEST_CASE(lwip, localhost_ping_multi_test)
     RUN_TEST_CASE(lwip, dhcp_server_init_deinit)
     RUN_TEST_CASE(lwip, dhcp_server_start_stop_localhost)
     RUN_TEST_CASE(lwip, dhcp_server_dns_options)
+    RUN_TEST_CASE(lwip, dhcp_server_many_clients)
     RUN_TEST_CASE(lwip, sntp_client_time_2015)
     RUN_TEST_CASE(lwip, sntp_client_time_2048)
+    RUN_TEST_CASE(lwip, udp_recv_zero_copy_localhost)
+    RUN_TEST_CASE(lwip, tcp_recv_zero_copy_window)
+    RUN_TEST_CASE(lwip, tcp_recv_zero_copy_chain_split)
+    RUN_TEST_CASE(lwip, tcp_recv_copy_vs_zero_copy_localhost)
+    RUN_TEST_CASE(lwip, udp_sendmmsg_recvmmsg_localhost)
+    RUN_TEST_CASE(lwip, tcpip_mbox_many_clients)
+    RUN_TEST_CASE(lwip, sys_mbox_full_empty)
+    RUN_TEST_CASE(lwip, sys_mbox_blocked_writers_readers)
+    RUN_TEST_CASE(lwip, sys_mbox_round_trip_latency)
 }
 
 void app_main(void)
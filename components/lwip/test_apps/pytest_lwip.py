@@ -6,6 +6,7 @@ from pytest_embedded_idf.utils import idf_parametrize
 
 
 @pytest.mark.generic
+@idf_parametrize('config', ['default', 'dhcps_leases', 'mbox_ring'], indirect=['config'])
 @idf_parametrize('target', ['esp32'], indirect=['target'])
 def test_lwip(dut: Dut) -> None:
     dut.expect_unity_test_output()
@@ -43,10 +43,35 @@ static esp_mbedtls_ssl_buf_states esp_mbedtls_get_buf_state(unsigned char *buf)
     return temp->state;
 }
 
+struct esp_mbedtls_ssl_buf *esp_mbedtls_alloc_buf(size_t len)
+{
+    struct esp_mbedtls_ssl_buf *temp;
+
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+    temp = esp_mbedtls_pool_alloc(len);
+    if (temp) {
+        return temp;
+    }
+#endif
+    temp = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + len);
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+    if (temp) {
+        temp->pool_class = ESP_MBEDTLS_POOL_CLASS_NONE;
+    }
+#endif
+    return temp;
+}
+
 void esp_mbedtls_free_buf(unsigned char *buf)
 {
     struct esp_mbedtls_ssl_buf *temp = __containerof(buf, struct esp_mbedtls_ssl_buf, buf[0]);
     ESP_LOGV(TAG, "free buffer @ %p", temp);
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+    if (temp->pool_class != ESP_MBEDTLS_POOL_CLASS_NONE) {
+        esp_mbedtls_pool_free(temp);
+        return;
+    }
+#endif
     mbedtls_free(temp);
 }
 
@@ -159,7 +184,7 @@ esp_err_t esp_mbedtls_dynamic_set_rx_buf_static(mbedtls_ssl_context *ssl)
 
     struct esp_mbedtls_ssl_buf *esp_buf;
     int buffer_len = tx_buffer_len(ssl, MBEDTLS_SSL_IN_BUFFER_LEN);
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
+    esp_buf = esp_mbedtls_alloc_buf(buffer_len);
     if (!esp_buf) {
         ESP_LOGE(TAG, "rx buf alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
         return ESP_ERR_NO_MEM;
@@ -183,7 +208,7 @@ static int esp_mbedtls_alloc_tx_buf(mbedtls_ssl_context *ssl, int len)
         ssl->MBEDTLS_PRIVATE(out_buf) = NULL;
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + len);
+    esp_buf = esp_mbedtls_alloc_buf(len);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + len);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -244,7 +269,7 @@ int esp_mbedtls_reset_add_rx_buffer(mbedtls_ssl_context *ssl)
         ssl->MBEDTLS_PRIVATE(in_buf) = NULL;
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + MBEDTLS_SSL_IN_BUFFER_LEN);
+    esp_buf = esp_mbedtls_alloc_buf(MBEDTLS_SSL_IN_BUFFER_LEN);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + MBEDTLS_SSL_IN_BUFFER_LEN);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -295,7 +320,7 @@ int esp_mbedtls_add_tx_buffer(mbedtls_ssl_context *ssl, size_t buffer_len)
 
     buffer_len = tx_buffer_len(ssl, buffer_len);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
+    esp_buf = esp_mbedtls_alloc_buf(buffer_len);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%zu bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -340,7 +365,7 @@ int esp_mbedtls_free_tx_buffer(mbedtls_ssl_context *ssl)
     esp_mbedtls_free_buf(ssl->MBEDTLS_PRIVATE(out_buf));
     init_tx_buffer(ssl, NULL);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + TX_IDLE_BUFFER_SIZE);
+    esp_buf = esp_mbedtls_alloc_buf(TX_IDLE_BUFFER_SIZE);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + TX_IDLE_BUFFER_SIZE);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -416,7 +441,7 @@ int esp_mbedtls_add_rx_buffer(mbedtls_ssl_context *ssl)
         init_rx_buffer(ssl, NULL);
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
+    esp_buf = esp_mbedtls_alloc_buf(buffer_len);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -488,7 +513,7 @@ int esp_mbedtls_free_rx_buffer(mbedtls_ssl_context *ssl)
     esp_mbedtls_free_buf(ssl->MBEDTLS_PRIVATE(in_buf));
     init_rx_buffer(ssl, NULL);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + 16);
+    esp_buf = esp_mbedtls_alloc_buf(16);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + 16);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
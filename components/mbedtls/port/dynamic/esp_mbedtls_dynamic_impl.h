@@ -58,13 +58,27 @@ typedef enum {
 struct esp_mbedtls_ssl_buf {
     esp_mbedtls_ssl_buf_states state;
     unsigned int len;
-    unsigned char buf[];
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+    unsigned int pool_class;    /* ESP_MBEDTLS_POOL_CLASS_NONE if allocated from the heap */
+#endif
+    /* Aligned as the pool links its free blocks through the buffer */
+    unsigned char buf[] __attribute__((aligned(sizeof(void *))));
 };
 
 #define SSL_BUF_HEAD_OFFSET_SIZE ((int)offsetof(struct esp_mbedtls_ssl_buf, buf))
 
+#define ESP_MBEDTLS_POOL_CLASS_NONE 0xff
+
+struct esp_mbedtls_ssl_buf *esp_mbedtls_alloc_buf(size_t len);
+
 void esp_mbedtls_free_buf(unsigned char *buf);
 
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+struct esp_mbedtls_ssl_buf *esp_mbedtls_pool_alloc(size_t len);
+
+void esp_mbedtls_pool_free(struct esp_mbedtls_ssl_buf *esp_buf);
+#endif
+
 int esp_mbedtls_setup_tx_buffer(mbedtls_ssl_context *ssl);
 
 void esp_mbedtls_setup_rx_buffer(mbedtls_ssl_context *ssl);
@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_mbedtls_dynamic_impl.h"
+#include "esp_assert.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+
+/* Worst case expansion of a record, see tx_buffer_len() */
+#define POOL_RECORD_OVERHEAD (MBEDTLS_SSL_HEADER_LEN \
+                              + MBEDTLS_MAX_IV_LENGTH \
+                              + MBEDTLS_SSL_MAC_ADD \
+                              + MBEDTLS_SSL_PADDING_ADD \
+                              + MBEDTLS_SSL_MAX_CID_EXPANSION)
+
+#define POOL_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+#define POOL_SMALL_LEN  (1024)
+#define POOL_MEDIUM_LEN (4096 + POOL_RECORD_OVERHEAD)
+#define POOL_LARGE_LEN  (POOL_MAX(MBEDTLS_SSL_IN_BUFFER_LEN, MBEDTLS_SSL_OUT_BUFFER_LEN) + POOL_RECORD_OVERHEAD)
+
+/*
+ * The idle TX buffer and the 16 bytes RX cache buffer are kept by every
+ * connection between records, they are too small to fragment the heap and
+ * would only waste a pool block.
+ */
+#define POOL_MIN_LEN (256)
+
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_MEM_INTERNAL
+#define POOL_MALLOC(size) heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#elif CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_MEM_EXTERNAL
+#define POOL_MALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#else
+#define POOL_MALLOC(size) mbedtls_calloc(1, size)
+#endif
+
+typedef struct {
+    struct esp_mbedtls_ssl_buf *free_list;  /* Linked through the first word of buf[] */
+    esp_mbedtls_dynamic_pool_class_stats_t stats;
+} pool_class_t;
+
+static const char *TAG = "Dynamic Pool";
+
+static portMUX_TYPE s_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static pool_class_t s_pool[ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX] = {
+    [ESP_MBEDTLS_DYNAMIC_POOL_SMALL] = {
+        .stats = { .block_size = POOL_SMALL_LEN, .blocks_max = CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_SMALL_NUM },
+    },
+    [ESP_MBEDTLS_DYNAMIC_POOL_MEDIUM] = {
+        .stats = { .block_size = POOL_MEDIUM_LEN, .blocks_max = CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_MEDIUM_NUM },
+    },
+    [ESP_MBEDTLS_DYNAMIC_POOL_LARGE] = {
+        .stats = { .block_size = POOL_LARGE_LEN, .blocks_max = CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL_LARGE_NUM },
+    },
+};
+
+/* Free blocks are linked through the start of their buffer */
+ESP_STATIC_ASSERT(SSL_BUF_HEAD_OFFSET_SIZE % __alignof__(struct esp_mbedtls_ssl_buf *) == 0,
+                  "The free list link in esp_mbedtls_ssl_buf::buf must be aligned");
+
+static inline struct esp_mbedtls_ssl_buf **pool_next(struct esp_mbedtls_ssl_buf *esp_buf)
+{
+    return (struct esp_mbedtls_ssl_buf **)esp_buf->buf;
+}
+
+static int pool_class_for(size_t len)
+{
+    for (int i = 0; i < ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX; i++) {
+        if (len <= s_pool[i].stats.block_size && s_pool[i].stats.blocks_max) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static struct esp_mbedtls_ssl_buf *pool_new_block(int cls)
+{
+    struct esp_mbedtls_ssl_buf *esp_buf = POOL_MALLOC(SSL_BUF_HEAD_OFFSET_SIZE + s_pool[cls].stats.block_size);
+    if (esp_buf) {
+        esp_buf->pool_class = cls;
+    }
+    return esp_buf;
+}
+
+struct esp_mbedtls_ssl_buf *esp_mbedtls_pool_alloc(size_t len)
+{
+    struct esp_mbedtls_ssl_buf *esp_buf = NULL;
+    bool grow = false;
+    int cls;
+
+    if (len < POOL_MIN_LEN) {
+        return NULL;
+    }
+
+    cls = pool_class_for(len);
+    if (cls < 0) {
+        return NULL;
+    }
+
+    pool_class_t *pc = &s_pool[cls];
+
+    portENTER_CRITICAL(&s_pool_lock);
+    if (pc->free_list) {
+        esp_buf = pc->free_list;
+        pc->free_list = *pool_next(esp_buf);
+        pc->stats.hits++;
+    } else if (pc->stats.blocks < pc->stats.blocks_max) {
+        /* Reserve the slot now, the heap can't be called from the critical section */
+        pc->stats.blocks++;
+        pc->stats.misses++;
+        grow = true;
+    } else {
+        pc->stats.fallbacks++;
+        portEXIT_CRITICAL(&s_pool_lock);
+        return NULL;
+    }
+    pc->stats.in_use++;
+    if (pc->stats.in_use > pc->stats.peak) {
+        pc->stats.peak = pc->stats.in_use;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    if (grow) {
+        esp_buf = pool_new_block(cls);
+        if (!esp_buf) {
+            ESP_LOGD(TAG, "no memory for class %d block (%d bytes)", cls, (int)pc->stats.block_size);
+            portENTER_CRITICAL(&s_pool_lock);
+            pc->stats.blocks--;
+            pc->stats.in_use--;
+            pc->stats.fallbacks++;
+            portEXIT_CRITICAL(&s_pool_lock);
+            return NULL;
+        }
+    }
+
+    /* Record buffers used to come from calloc(), keep handing out zeroed memory */
+    memset(esp_buf->buf, 0, len);
+
+    ESP_LOGV(TAG, "lend class %d buffer @ %p for %d bytes", cls, esp_buf, (int)len);
+
+    return esp_buf;
+}
+
+void esp_mbedtls_pool_free(struct esp_mbedtls_ssl_buf *esp_buf)
+{
+    pool_class_t *pc = &s_pool[esp_buf->pool_class];
+
+    portENTER_CRITICAL(&s_pool_lock);
+    *pool_next(esp_buf) = pc->free_list;
+    pc->free_list = esp_buf;
+    pc->stats.in_use--;
+    portEXIT_CRITICAL(&s_pool_lock);
+}
+
+esp_err_t esp_mbedtls_dynamic_pool_reserve(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    for (int cls = 0; cls < ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX; cls++) {
+        pool_class_t *pc = &s_pool[cls];
+
+        while (1) {
+            portENTER_CRITICAL(&s_pool_lock);
+            bool grow = pc->stats.blocks < pc->stats.blocks_max;
+            if (grow) {
+                pc->stats.blocks++;
+            }
+            portEXIT_CRITICAL(&s_pool_lock);
+
+            if (!grow) {
+                break;
+            }
+
+            struct esp_mbedtls_ssl_buf *esp_buf = pool_new_block(cls);
+
+            portENTER_CRITICAL(&s_pool_lock);
+            if (esp_buf) {
+                *pool_next(esp_buf) = pc->free_list;
+                pc->free_list = esp_buf;
+            } else {
+                pc->stats.blocks--;
+            }
+            portEXIT_CRITICAL(&s_pool_lock);
+
+            if (!esp_buf) {
+                ESP_LOGE(TAG, "reserve class %d block (%d bytes) failed", cls, (int)pc->stats.block_size);
+                ret = ESP_ERR_NO_MEM;
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+
+esp_err_t esp_mbedtls_dynamic_pool_get_stats(esp_mbedtls_dynamic_pool_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int cls = 0; cls < ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX; cls++) {
+        stats->cls[cls] = s_pool[cls].stats;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    return ESP_OK;
+}
+
+void esp_mbedtls_dynamic_pool_reset_stats(void)
+{
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int cls = 0; cls < ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX; cls++) {
+        esp_mbedtls_dynamic_pool_class_stats_t *stats = &s_pool[cls].stats;
+        stats->hits = 0;
+        stats->misses = 0;
+        stats->fallbacks = 0;
+        stats->peak = stats->in_use;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+}
+
+#endif /* CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL */
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <stddef.h>
 #include "mbedtls/ssl.h"
 #include "esp_err.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +26,69 @@ extern "C" {
  */
 esp_err_t esp_mbedtls_dynamic_set_rx_buf_static(mbedtls_ssl_context *ssl);
 
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+
+/**
+ * @brief Size classes of the dynamic buffer pool
+ */
+typedef enum {
+    ESP_MBEDTLS_DYNAMIC_POOL_SMALL = 0,     /*!< 1 KB blocks */
+    ESP_MBEDTLS_DYNAMIC_POOL_MEDIUM,        /*!< 4 KB blocks */
+    ESP_MBEDTLS_DYNAMIC_POOL_LARGE,         /*!< Maximum TLS record size blocks */
+    ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX,
+} esp_mbedtls_dynamic_pool_class_t;
+
+/**
+ * @brief Statistics of one size class of the dynamic buffer pool
+ */
+typedef struct {
+    size_t block_size;      /*!< Usable size of each block of this class, in bytes */
+    uint32_t blocks_max;    /*!< Maximum number of blocks this class may own (Kconfig) */
+    uint32_t blocks;        /*!< Number of blocks currently owned by this class */
+    uint32_t in_use;        /*!< Number of blocks currently lent to TLS connections */
+    uint32_t peak;          /*!< Highest value of in_use since the last reset */
+    uint32_t hits;          /*!< Requests served with a block already owned by the pool */
+    uint32_t misses;        /*!< Requests for which a new block had to be taken from the heap */
+    uint32_t fallbacks;     /*!< Requests that could not be served by the pool and went to the mbedTLS allocator */
+} esp_mbedtls_dynamic_pool_class_stats_t;
+
+/**
+ * @brief Statistics of the dynamic buffer pool
+ */
+typedef struct {
+    esp_mbedtls_dynamic_pool_class_stats_t cls[ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX]; /*!< Per size class statistics */
+} esp_mbedtls_dynamic_pool_stats_t;
+
+/**
+ * @brief Allocate all blocks of the dynamic buffer pool up front
+ *
+ * By default pool blocks are taken from the heap the first time they are needed. Calling this
+ * early (e.g. at startup) makes sure the large record buffers are available even once the heap
+ * gets fragmented.
+ *
+ * @return
+ *         - ESP_OK: All blocks are allocated
+ *         - ESP_ERR_NO_MEM: Some blocks could not be allocated, the pool keeps those that were
+ */
+esp_err_t esp_mbedtls_dynamic_pool_reserve(void);
+
+/**
+ * @brief Get the statistics of the dynamic buffer pool
+ *
+ * @param[out] stats Pointer to the statistics to fill
+ * @return
+ *         - ESP_OK: Success
+ *         - ESP_ERR_INVALID_ARG: stats is NULL
+ */
+esp_err_t esp_mbedtls_dynamic_pool_get_stats(esp_mbedtls_dynamic_pool_stats_t *stats);
+
+/**
+ * @brief Reset the hit, miss, fallback and peak counters of the dynamic buffer pool
+ */
+void esp_mbedtls_dynamic_pool_reset_stats(void);
+
+#endif /* CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL */
+
 #ifdef __cplusplus
 }
 #endif
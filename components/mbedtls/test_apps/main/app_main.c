@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -10,6 +10,10 @@
 #include "memory_checks.h"
 #include "soc/soc_caps.h"
 #include "esp_newlib.h"
+#include "sdkconfig.h"
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+#include "mbedtls/esp_mbedtls_dynamic.h"
+#endif
 
 /* setUp runs before every test */
 void setUp(void)
@@ -21,6 +25,12 @@ void setUp(void)
     mbedtls_aes_init(&ctx);
 #endif // SOC_AES_SUPPORTED
 
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+    // Pool blocks are kept for the lifetime of the application, reserve them
+    // up front so that they are not considered as leak
+    esp_mbedtls_dynamic_pool_reserve();
+#endif
+
     test_utils_record_free_mem();
     test_utils_set_leak_level(CONFIG_UNITY_CRITICAL_LEAK_LEVEL_GENERAL, ESP_LEAK_TYPE_CRITICAL, ESP_COMP_LEAK_GENERAL);
     test_utils_set_leak_level(CONFIG_UNITY_WARN_LEAK_LEVEL_GENERAL, ESP_LEAK_TYPE_WARNING, ESP_COMP_LEAK_GENERAL);
@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/esp_mbedtls_dynamic.h"
+#include "esp_log.h"
+
+#include "unity.h"
+#include "test_utils.h"
+
+#define TEST_POOL_TASKS             2
+#define TEST_POOL_CONNS_PER_TASK    3
+#define TEST_POOL_ROUNDS            4
+#define TEST_POOL_PIPE_SIZE         2048
+
+extern const uint8_t server_cert_chain_pem_start[] asm("_binary_server_cert_chain_pem_start");
+extern const uint8_t server_cert_chain_pem_end[]   asm("_binary_server_cert_chain_pem_end");
+
+extern const uint8_t server_pk_start[] asm("_binary_prvtkey_pem_start");
+extern const uint8_t server_pk_end[]   asm("_binary_prvtkey_pem_end");
+
+static const char *TAG = "dynamic_pool_test";
+
+/* In-memory byte stream standing in for one direction of a TCP connection */
+typedef struct {
+    uint8_t buf[TEST_POOL_PIPE_SIZE];
+    size_t head;
+    size_t len;
+} test_pipe_t;
+
+typedef struct {
+    mbedtls_ssl_context client;
+    mbedtls_ssl_context server;
+    test_pipe_t c2s;
+    test_pipe_t s2c;
+    size_t sent;
+    size_t received;
+} test_conn_t;
+
+typedef struct {
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctr_drbg;
+    mbedtls_ssl_config client_conf;
+    mbedtls_ssl_config server_conf;
+    mbedtls_x509_crt cert;
+    mbedtls_pk_context pkey;
+    test_conn_t conn[TEST_POOL_CONNS_PER_TASK];
+    SemaphoreHandle_t done;
+    bool ok;
+} test_pool_ctx_t;
+
+typedef struct {
+    test_pipe_t *tx;
+    test_pipe_t *rx;
+} test_bio_t;
+
+static int pipe_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    test_pipe_t *pipe = ((test_bio_t *)ctx)->tx;
+    size_t n = MIN(len, TEST_POOL_PIPE_SIZE - pipe->len);
+
+    if (!n) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    for (size_t i = 0; i < n; i++) {
+        pipe->buf[(pipe->head + pipe->len + i) % TEST_POOL_PIPE_SIZE] = buf[i];
+    }
+    pipe->len += n;
+    return n;
+}
+
+static int pipe_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    test_pipe_t *pipe = ((test_bio_t *)ctx)->rx;
+    size_t n = MIN(len, pipe->len);
+
+    if (!n) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    for (size_t i = 0; i < n; i++) {
+        buf[i] = pipe->buf[(pipe->head + i) % TEST_POOL_PIPE_SIZE];
+    }
+    pipe->head = (pipe->head + n) % TEST_POOL_PIPE_SIZE;
+    pipe->len -= n;
+    return n;
+}
+
+static bool ssl_ok(int ret)
+{
+    return ret >= 0 || ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+static bool pool_ctx_setup(test_pool_ctx_t *ctx, test_bio_t *bio)
+{
+    mbedtls_entropy_init(&ctx->entropy);
+    mbedtls_ctr_drbg_init(&ctx->ctr_drbg);
+    mbedtls_ssl_config_init(&ctx->client_conf);
+    mbedtls_ssl_config_init(&ctx->server_conf);
+    mbedtls_x509_crt_init(&ctx->cert);
+    mbedtls_pk_init(&ctx->pkey);
+    for (int i = 0; i < TEST_POOL_CONNS_PER_TASK; i++) {
+        mbedtls_ssl_init(&ctx->conn[i].client);
+        mbedtls_ssl_init(&ctx->conn[i].server);
+    }
+
+    if (mbedtls_ctr_drbg_seed(&ctx->ctr_drbg, mbedtls_entropy_func, &ctx->entropy, NULL, 0) != 0 ||
+        mbedtls_x509_crt_parse(&ctx->cert, server_cert_chain_pem_start,
+                               server_cert_chain_pem_end - server_cert_chain_pem_start) != 0 ||
+        mbedtls_pk_parse_key(&ctx->pkey, server_pk_start, server_pk_end - server_pk_start, NULL, 0,
+                             mbedtls_ctr_drbg_random, &ctx->ctr_drbg) != 0) {
+        return false;
+    }
+
+    if (mbedtls_ssl_config_defaults(&ctx->server_conf, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                    MBEDTLS_SSL_PRESET_DEFAULT) != 0 ||
+        mbedtls_ssl_config_defaults(&ctx->client_conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                    MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
+        return false;
+    }
+    mbedtls_ssl_conf_rng(&ctx->server_conf, mbedtls_ctr_drbg_random, &ctx->ctr_drbg);
+    mbedtls_ssl_conf_rng(&ctx->client_conf, mbedtls_ctr_drbg_random, &ctx->ctr_drbg);
+    mbedtls_ssl_conf_authmode(&ctx->client_conf, MBEDTLS_SSL_VERIFY_NONE);
+    if (mbedtls_ssl_conf_own_cert(&ctx->server_conf, &ctx->cert, &ctx->pkey) != 0) {
+        return false;
+    }
+
+    for (int i = 0; i < TEST_POOL_CONNS_PER_TASK; i++) {
+        test_conn_t *conn = &ctx->conn[i];
+
+        if (mbedtls_ssl_setup(&conn->client, &ctx->client_conf) != 0 ||
+            mbedtls_ssl_setup(&conn->server, &ctx->server_conf) != 0) {
+            return false;
+        }
+        bio[2 * i] = (test_bio_t) { .tx = &conn->c2s, .rx = &conn->s2c };
+        bio[2 * i + 1] = (test_bio_t) { .tx = &conn->s2c, .rx = &conn->c2s };
+        mbedtls_ssl_set_bio(&conn->client, &bio[2 * i], pipe_send, pipe_recv, NULL);
+        mbedtls_ssl_set_bio(&conn->server, &bio[2 * i + 1], pipe_send, pipe_recv, NULL);
+    }
+    return true;
+}
+
+static void pool_ctx_teardown(test_pool_ctx_t *ctx)
+{
+    for (int i = 0; i < TEST_POOL_CONNS_PER_TASK; i++) {
+        mbedtls_ssl_free(&ctx->conn[i].client);
+        mbedtls_ssl_free(&ctx->conn[i].server);
+    }
+    mbedtls_ssl_config_free(&ctx->client_conf);
+    mbedtls_ssl_config_free(&ctx->server_conf);
+    mbedtls_x509_crt_free(&ctx->cert);
+    mbedtls_pk_free(&ctx->pkey);
+    mbedtls_ctr_drbg_free(&ctx->ctr_drbg);
+    mbedtls_entropy_free(&ctx->entropy);
+}
+
+/* Drive all connections of the task round-robin so their record buffers are borrowed concurrently */
+static bool pool_ctx_handshake(test_pool_ctx_t *ctx)
+{
+    bool busy = true;
+
+    while (busy) {
+        busy = false;
+        for (int i = 0; i < TEST_POOL_CONNS_PER_TASK; i++) {
+            test_conn_t *conn = &ctx->conn[i];
+
+            if (!mbedtls_ssl_is_handshake_over(&conn->client)) {
+                if (!ssl_ok(mbedtls_ssl_handshake(&conn->client))) {
+                    return false;
+                }
+                busy = true;
+            }
+            if (!mbedtls_ssl_is_handshake_over(&conn->server)) {
+                if (!ssl_ok(mbedtls_ssl_handshake(&conn->server))) {
+                    return false;
+                }
+                busy = true;
+            }
+        }
+    }
+    return true;
+}
+
+static bool pool_ctx_transfer(test_pool_ctx_t *ctx, const uint8_t *data, uint8_t *rx, size_t len)
+{
+    bool busy = true;
+
+    for (int i = 0; i < TEST_POOL_CONNS_PER_TASK; i++) {
+        ctx->conn[i].sent = 0;
+        ctx->conn[i].received = 0;
+    }
+
+    while (busy) {
+        busy = false;
+        for (int i = 0; i < TEST_POOL_CONNS_PER_TASK; i++) {
+            test_conn_t *conn = &ctx->conn[i];
+            int ret;
+
+            if (conn->sent < len) {
+                ret = mbedtls_ssl_write(&conn->client, data + conn->sent, len - conn->sent);
+                if (!ssl_ok(ret)) {
+                    return false;
+                }
+                conn->sent += MAX(ret, 0);
+            }
+            if (conn->received < len) {
+                ret = mbedtls_ssl_read(&conn->server, rx + conn->received, len - conn->received);
+                if (!ssl_ok(ret)) {
+                    return false;
+                }
+                conn->received += MAX(ret, 0);
+                busy = true;
+            }
+        }
+    }
+    return memcmp(data, rx, len) == 0;
+}
+
+static void pool_stress_task(void *arg)
+{
+    test_pool_ctx_t *ctx = arg;
+    test_bio_t bio[2 * TEST_POOL_CONNS_PER_TASK];
+    const size_t sizes[] = { 600, 3000, MBEDTLS_SSL_OUT_CONTENT_LEN };
+    uint8_t *data = malloc(MBEDTLS_SSL_OUT_CONTENT_LEN);
+    uint8_t *rx = malloc(MBEDTLS_SSL_OUT_CONTENT_LEN);
+
+    ctx->ok = data && rx && pool_ctx_setup(ctx, bio) && pool_ctx_handshake(ctx);
+    for (int round = 0; ctx->ok && round < TEST_POOL_ROUNDS; round++) {
+        for (int i = 0; ctx->ok && i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            for (size_t j = 0; j < sizes[i]; j++) {
+                data[j] = (uint8_t)(j + round);
+            }
+            ctx->ok = pool_ctx_transfer(ctx, data, rx, sizes[i]);
+        }
+    }
+    if (!ctx->ok) {
+        ESP_LOGE(TAG, "TLS loopback failed");
+    }
+
+    pool_ctx_teardown(ctx);
+    free(data);
+    free(rx);
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("mbedtls dynamic buffer pool with concurrent connections", "[mbedtls]")
+{
+    test_pool_ctx_t *ctx[TEST_POOL_TASKS];
+    esp_mbedtls_dynamic_pool_stats_t stats;
+    uint32_t hits = 0;
+
+    esp_mbedtls_dynamic_pool_reset_stats();
+
+    for (int i = 0; i < TEST_POOL_TASKS; i++) {
+        ctx[i] = calloc(1, sizeof(test_pool_ctx_t));
+        TEST_ASSERT_NOT_NULL(ctx[i]);
+        ctx[i]->done = xSemaphoreCreateBinary();
+        TEST_ASSERT_NOT_NULL(ctx[i]->done);
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(pool_stress_task, "pool_stress", 8192, ctx[i], 5, NULL));
+    }
+
+    for (int i = 0; i < TEST_POOL_TASKS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(ctx[i]->done, pdMS_TO_TICKS(60000)));
+        TEST_ASSERT_TRUE(ctx[i]->ok);
+        vSemaphoreDelete(ctx[i]->done);
+        free(ctx[i]);
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mbedtls_dynamic_pool_get_stats(&stats));
+    for (int cls = 0; cls < ESP_MBEDTLS_DYNAMIC_POOL_CLASS_MAX; cls++) {
+        esp_mbedtls_dynamic_pool_class_stats_t *s = &stats.cls[cls];
+        ESP_LOGI(TAG, "class %d (%d bytes): blocks %"PRIu32"/%"PRIu32" peak %"PRIu32" hits %"PRIu32" misses %"PRIu32" fallbacks %"PRIu32,
+                 cls, (int)s->block_size, s->blocks, s->blocks_max, s->peak, s->hits, s->misses, s->fallbacks);
+        /* Every borrowed block must have been returned */
+        TEST_ASSERT_EQUAL_UINT32(0, s->in_use);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(s->blocks_max, s->peak);
+        hits += s->hits;
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(0, hits);
+}
+
+#endif /* CONFIG_MBEDTLS_DYNAMIC_BUFFER_POOL */
@@ -101,6 +101,19 @@ def test_mbedtls_ecdsa_sign(dut: Dut) -> None:
     dut.run_all_single_board_cases(group='efuse_key')
 
 
+@pytest.mark.generic
+@pytest.mark.parametrize(
+    'config',
+    [
+        'dynamic_pool',
+    ],
+    indirect=True,
+)
+@idf_parametrize('target', ['esp32', 'esp32c3'], indirect=['target'])
+def test_mbedtls_dynamic_pool(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
+
+
 @pytest.mark.generic
 @pytest.mark.parametrize(
     'config',
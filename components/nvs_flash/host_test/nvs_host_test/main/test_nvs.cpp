@@ -18,6 +18,7 @@
 #include <string>
 #include <random>
 #include "test_fixtures.hpp"
+#include "nvs_image_builder.hpp"
 #include "spi_flash_mmap.h"
 
 using namespace std;
@@ -3507,6 +3508,59 @@ TEST_CASE("check and read data from partition generated via partition generation
     }
 }
 
+TEST_CASE("check and read data from partition generated via native image generator", "[nvs_image_gen]")
+{
+    int status;
+    int childpid = fork();
+    if (childpid == 0) {
+        exit(execlp("cp", " cp",
+                    "-rf",
+                    WD_PREFIX "../../nvs_partition_generator/testdata",
+                    ".", NULL));
+    } else {
+        CHECK(childpid > 0);
+        waitpid(childpid, &status, 0);
+        CHECK(WEXITSTATUS(status) == 0);
+    }
+
+    TEST_ESP_OK(nvs_image_gen::generate(WD_PREFIX "../../nvs_partition_generator/sample_multipage_blob.csv",
+                                        "partition_native.bin",
+                                        0x4000,
+                                        nullptr));
+
+    check_nvs_part_gen_args("partition_native.bin",
+                            "test",
+                            4,
+                            WD_PREFIX "../../nvs_partition_generator/testdata/sample_multipage_blob.bin");
+
+    // entries before the first namespace are rejected and no image is left behind
+    {
+        ofstream csv("partition_native_invalid.csv");
+        csv << "key,type,encoding,value\n"
+            << "dummyU8Key,data,u8,127\n";
+    }
+    TEST_ESP_ERR(nvs_image_gen::generate("partition_native_invalid.csv", "partition_native_invalid.bin", 0x4000, nullptr),
+                 ESP_ERR_INVALID_ARG);
+    CHECK(access("partition_native_invalid.bin", F_OK) != 0);
+
+    TEST_ESP_ERR(nvs_image_gen::generate(WD_PREFIX "../../nvs_partition_generator/sample_multipage_blob.csv",
+                                         "partition_native_invalid.bin",
+                                         0x2000,
+                                         nullptr),
+                 ESP_ERR_INVALID_SIZE);
+
+    childpid = fork();
+    if (childpid == 0) {
+        exit(execlp("bash", "bash",
+                    "-c",
+                    "rm -rf testdata partition_native.bin partition_native_invalid.csv", NULL));
+    } else {
+        CHECK(childpid > 0);
+        waitpid(childpid, &status, 0);
+        CHECK(WEXITSTATUS(status) == 0);
+    }
+}
+
 TEST_CASE("check and read data from partition generated via manufacturing utility with multipage blob support disabled", "[mfg_gen]")
 {
     int childpid = fork();
@@ -0,0 +1,547 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "esp_partition.h"
+#include "esp_private/partition_linux.h"
+#include "esp_rom_crc.h"
+#include "nvs.h"
+#include "nvs_partition.hpp"
+#include "nvs_partition_manager.hpp"
+#include "nvs_image_builder.hpp"
+
+#if NVS_IMAGE_GEN_ENCRYPTION
+#include "nvs_encrypted_partition.hpp"
+#endif
+
+namespace nvs_image_gen {
+
+/* Label of the partition while it is being generated, it is not part of the image */
+static const char *PART_NAME = "nvs_image_gen";
+
+/* Size of the key partition image, keys are followed by erased flash */
+static const size_t KEYS_IMAGE_SIZE = 0x1000;
+
+/**
+ * Integer encodings, stored with the nvs_set_* function of the same type
+ */
+static const struct {
+    const char *name;
+    nvs_type_t type;
+    bool is_signed;
+    unsigned bits;
+} s_int_encodings[] = {
+    { "u8",  NVS_TYPE_U8,  false, 8  },
+    { "i8",  NVS_TYPE_I8,  true,  8  },
+    { "u16", NVS_TYPE_U16, false, 16 },
+    { "i16", NVS_TYPE_I16, true,  16 },
+    { "u32", NVS_TYPE_U32, false, 32 },
+    { "i32", NVS_TYPE_I32, true,  32 },
+    { "u64", NVS_TYPE_U64, false, 64 },
+    { "i64", NVS_TYPE_I64, true,  64 },
+};
+
+/**
+ * Read the next record of a CSV file. Quoting follows the Python csv module used by
+ * nvs_partition_gen.py: a quoted field may contain commas, line breaks and doubled quotes.
+ * Empty lines and lines starting with '#' are skipped.
+ *
+ * @return false at the end of the file
+ */
+static bool read_record(std::istream &in, std::vector<std::string> &fields, size_t &line)
+{
+    std::string text;
+
+    do {
+        if (!std::getline(in, text)) {
+            return false;
+        }
+        line++;
+        if (!text.empty() && text.back() == '\r') {
+            text.pop_back();
+        }
+    } while (text.empty() || text[0] == '#');
+
+    fields.clear();
+    std::string field;
+    bool quoted = false;
+    bool field_start = true;
+
+    for (;;) {
+        for (size_t i = 0; i < text.size(); i++) {
+            const char c = text[i];
+            if (quoted) {
+                if (c != '"') {
+                    field += c;
+                } else if (i + 1 < text.size() && text[i + 1] == '"') {
+                    field += '"';
+                    i++;
+                } else {
+                    quoted = false;
+                }
+            } else if (c == '"' && field_start) {
+                quoted = true;
+                field_start = false;
+            } else if (c == ',') {
+                fields.push_back(field);
+                field.clear();
+                field_start = true;
+            } else {
+                field += c;
+                field_start = false;
+            }
+        }
+
+        if (!quoted || !std::getline(in, text)) {
+            break;
+        }
+        // The line break is part of the quoted field
+        line++;
+        if (!text.empty() && text.back() == '\r') {
+            text.pop_back();
+        }
+        field += '\n';
+    }
+
+    fields.push_back(field);
+    return true;
+}
+
+static bool read_file(const std::string &path, std::string &contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+static std::string strip(const std::string &text)
+{
+    const char *space = " \t\r\n";
+    const size_t first = text.find_first_not_of(space);
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    return text.substr(first, text.find_last_not_of(space) - first + 1);
+}
+
+static bool hex_to_bin(const std::string &hex, std::vector<uint8_t> &data)
+{
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    };
+
+    if (hex.size() % 2 != 0) {
+        return false;
+    }
+    data.clear();
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        const int high = nibble(hex[i]);
+        const int low = nibble(hex[i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        data.push_back(static_cast<uint8_t>((high << 4) | low));
+    }
+    return true;
+}
+
+static bool base64_to_bin(const std::string &text, std::vector<uint8_t> &data)
+{
+    auto sextet = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') {
+            return c - 'A';
+        }
+        if (c >= 'a' && c <= 'z') {
+            return c - 'a' + 26;
+        }
+        if (c >= '0' && c <= '9') {
+            return c - '0' + 52;
+        }
+        if (c == '+') {
+            return 62;
+        }
+        if (c == '/') {
+            return 63;
+        }
+        return -1;
+    };
+
+    uint32_t bits = 0;
+    int bit_count = 0;
+    bool padding = false;
+
+    data.clear();
+    for (char c : text) {
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            continue;
+        }
+        if (c == '=') {
+            padding = true;
+            continue;
+        }
+        const int value = sextet(c);
+        if (value < 0 || padding) {
+            return false;
+        }
+        bits = (bits << 6) | static_cast<uint32_t>(value);
+        bit_count += 6;
+        if (bit_count >= 8) {
+            bit_count -= 8;
+            data.push_back(static_cast<uint8_t>(bits >> bit_count));
+        }
+    }
+    // Leftover bits must only be the padding of the last byte
+    return bit_count < 6 && (bits & ((1U << bit_count) - 1)) == 0;
+}
+
+static esp_err_t write_integer(nvs_handle_t handle, const char *key, const char *value, unsigned index)
+{
+    const auto &encoding = s_int_encodings[index];
+    const char *digits = (value[0] == '-') ? value + 1 : value;
+    const int base = (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) ? 16 : 10;
+    char *end = nullptr;
+    int64_t svalue = 0;
+    uint64_t uvalue = 0;
+
+    errno = 0;
+    if (encoding.is_signed) {
+        svalue = strtoll(value, &end, base);
+        const int64_t max = (encoding.bits == 64) ? INT64_MAX : (INT64_C(1) << (encoding.bits - 1)) - 1;
+        if (svalue > max || svalue < -max - 1) {
+            errno = ERANGE;
+        }
+    } else {
+        uvalue = strtoull(value, &end, base);
+        const uint64_t max = (encoding.bits == 64) ? UINT64_MAX : (UINT64_C(1) << encoding.bits) - 1;
+        if (value[0] == '-' || uvalue > max) {
+            errno = ERANGE;
+        }
+    }
+    if (end == value || *end != '\0' || errno != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    switch (encoding.type) {
+    case NVS_TYPE_U8:
+        return nvs_set_u8(handle, key, static_cast<uint8_t>(uvalue));
+    case NVS_TYPE_I8:
+        return nvs_set_i8(handle, key, static_cast<int8_t>(svalue));
+    case NVS_TYPE_U16:
+        return nvs_set_u16(handle, key, static_cast<uint16_t>(uvalue));
+    case NVS_TYPE_I16:
+        return nvs_set_i16(handle, key, static_cast<int16_t>(svalue));
+    case NVS_TYPE_U32:
+        return nvs_set_u32(handle, key, static_cast<uint32_t>(uvalue));
+    case NVS_TYPE_I32:
+        return nvs_set_i32(handle, key, static_cast<int32_t>(svalue));
+    case NVS_TYPE_U64:
+        return nvs_set_u64(handle, key, uvalue);
+    case NVS_TYPE_I64:
+        return nvs_set_i64(handle, key, svalue);
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+}
+
+/**
+ * Write a data or file entry. For file entries, value holds the contents of the file.
+ */
+static esp_err_t write_entry(nvs_handle_t handle, const std::string &key, const std::string &encoding,
+                             const std::string &value, bool is_file)
+{
+    for (unsigned i = 0; i < sizeof(s_int_encodings) / sizeof(s_int_encodings[0]); i++) {
+        if (encoding == s_int_encodings[i].name) {
+            // Integers can't be read from files, as in nvs_partition_gen.py
+            if (is_file) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            return write_integer(handle, key.c_str(), value.c_str(), i);
+        }
+    }
+
+    std::vector<uint8_t> data;
+    if (encoding == "string") {
+        return nvs_set_str(handle, key.c_str(), value.c_str());
+    } else if (encoding == "hex2bin") {
+        if (!hex_to_bin(is_file ? strip(value) : value, data)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    } else if (encoding == "base64") {
+        if (!base64_to_bin(value, data)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    } else if (encoding == "binary") {
+        data.assign(value.begin(), value.end());
+    } else {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return nvs_set_blob(handle, key.c_str(), data.data(), data.size());
+}
+
+static esp_err_t write_entries(const char *input)
+{
+    std::ifstream in(input, std::ios::binary);
+    if (!in) {
+        fprintf(stderr, "%s: %s\n", input, strerror(errno));
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    std::vector<std::string> fields;
+    size_t line = 0;
+    bool header = true;
+    bool in_namespace = false;
+    nvs_handle_t handle = 0;
+    esp_err_t err = ESP_OK;
+
+    while (err == ESP_OK && read_record(in, fields, line)) {
+        // The first line holds the column names
+        if (header) {
+            header = false;
+            continue;
+        }
+
+        if (fields.size() != 4) {
+            fprintf(stderr, "%s:%zu: expected 4 columns: key,type,encoding,value\n", input, line);
+            err = ESP_ERR_INVALID_ARG;
+            break;
+        }
+        const std::string &key = fields[0];
+        const std::string &type = fields[1];
+        const std::string &encoding = fields[2];
+        const std::string &value = fields[3];
+
+        if (type == "namespace") {
+            if (in_namespace) {
+                nvs_close(handle);
+                in_namespace = false;
+            }
+            err = nvs_open_from_partition(PART_NAME, key.c_str(), NVS_READWRITE, &handle);
+            in_namespace = (err == ESP_OK);
+        } else if (type == "data" || type == "file") {
+            if (!in_namespace) {
+                fprintf(stderr, "%s:%zu: the first entry must be a namespace\n", input, line);
+                err = ESP_ERR_INVALID_ARG;
+                break;
+            }
+            if (type == "data") {
+                err = write_entry(handle, key, encoding, value, false);
+            } else {
+                std::string contents;
+                if (!read_file(value, contents)) {
+                    fprintf(stderr, "%s:%zu: %s: %s\n", input, line, value.c_str(), strerror(errno));
+                    err = ESP_ERR_NOT_FOUND;
+                    break;
+                }
+                err = write_entry(handle, key, encoding, contents, true);
+            }
+        } else {
+            fprintf(stderr, "%s:%zu: unknown type '%s'\n", input, line, type.c_str());
+            err = ESP_ERR_INVALID_ARG;
+            break;
+        }
+
+        if (err == ESP_ERR_INVALID_ARG) {
+            fprintf(stderr, "%s:%zu: invalid value for '%s' with encoding '%s'\n", input, line,
+                    key.c_str(), encoding.c_str());
+        } else if (err != ESP_OK) {
+            fprintf(stderr, "%s:%zu: cannot write '%s': %s\n", input, line, key.c_str(), esp_err_to_name(err));
+        }
+    }
+
+    if (in_namespace) {
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    return err;
+}
+
+/**
+ * Create the output file with the whole partition erased
+ */
+static esp_err_t create_erased_image(const char *output, size_t size)
+{
+    FILE *f = fopen(output, "wb");
+    if (f == nullptr) {
+        fprintf(stderr, "%s: %s\n", output, strerror(errno));
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const std::vector<uint8_t> erased(size, 0xFF);
+    const bool written = fwrite(erased.data(), 1, size, f) == size;
+    if (fclose(f) != 0 || !written) {
+        fprintf(stderr, "%s: %s\n", output, strerror(errno));
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static nvs::NVSPartition *create_partition(const esp_partition_t *partition, const nvs_sec_cfg_t *sec_cfg,
+                                           esp_err_t *err)
+{
+    *err = ESP_OK;
+    if (sec_cfg == nullptr) {
+        nvs::NVSPartition *part = new (std::nothrow) nvs::NVSPartition(partition);
+        if (part == nullptr) {
+            *err = ESP_ERR_NO_MEM;
+        }
+        return part;
+    }
+
+#if NVS_IMAGE_GEN_ENCRYPTION
+    nvs::NVSEncryptedPartition *part = new (std::nothrow) nvs::NVSEncryptedPartition(partition);
+    if (part == nullptr) {
+        *err = ESP_ERR_NO_MEM;
+        return nullptr;
+    }
+    // init() only reads the keys
+    *err = part->init(const_cast<nvs_sec_cfg_t *>(sec_cfg));
+    if (*err != ESP_OK) {
+        delete part;
+        return nullptr;
+    }
+    return part;
+#else
+    *err = ESP_ERR_NOT_SUPPORTED;
+    return nullptr;
+#endif
+}
+
+esp_err_t generate(const char *input, const char *output, size_t size, const nvs_sec_cfg_t *sec_cfg)
+{
+    const uint32_t sec_size = esp_partition_get_main_flash_sector_size();
+    if (size < MIN_PARTITION_SIZE || size % sec_size != 0) {
+        fprintf(stderr, "Invalid partition size 0x%zx, must be a multiple of 0x%" PRIx32 " of at least 0x%zx\n",
+                size, sec_size, MIN_PARTITION_SIZE);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    esp_err_t err = create_erased_image(output, size);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // The output file is the emulated flash, the partition covers all of it
+    esp_partition_file_mmap_ctrl_t *p_ctrl = esp_partition_get_file_mmap_ctrl_input();
+    memset(p_ctrl, 0, sizeof(*p_ctrl));
+    strlcpy(p_ctrl->flash_file_name, output, sizeof(p_ctrl->flash_file_name));
+    const uint8_t *p_flash = nullptr;
+    err = esp_partition_file_mmap(&p_flash);
+    if (err != ESP_OK) {
+        fprintf(stderr, "%s: cannot map the image: %s\n", output, esp_err_to_name(err));
+        remove(output);
+        return err;
+    }
+
+    esp_partition_t partition = {};
+    partition.address = 0;
+    partition.size = size;
+    partition.erase_size = ESP_PARTITION_EMULATED_SECTOR_SIZE;
+    partition.type = ESP_PARTITION_TYPE_DATA;
+    partition.subtype = ESP_PARTITION_SUBTYPE_DATA_NVS;
+    strlcpy(partition.label, PART_NAME, sizeof(partition.label));
+
+    nvs::NVSPartition *part = create_partition(&partition, sec_cfg, &err);
+    if (part != nullptr) {
+        err = nvs::NVSPartitionManager::get_instance()->init_custom(part, 0, size / sec_size);
+        if (err == ESP_OK) {
+            err = write_entries(input);
+            nvs_flash_deinit_partition(PART_NAME);
+        } else {
+            fprintf(stderr, "%s: cannot initialize the partition: %s\n", output, esp_err_to_name(err));
+        }
+        delete part;
+    } else {
+        fprintf(stderr, "%s: cannot create the partition: %s\n", output, esp_err_to_name(err));
+    }
+
+    // Keep the image, a previous emulation may have asked for its flash file to be removed
+    p_ctrl->remove_dump = false;
+    const esp_err_t unmap_err = esp_partition_file_munmap();
+    if (err == ESP_OK) {
+        err = unmap_err;
+    }
+    if (err != ESP_OK) {
+        remove(output);
+    }
+    return err;
+}
+
+static uint32_t keys_crc(const nvs_sec_cfg_t *cfg)
+{
+    const uint32_t crc = esp_rom_crc32_le(0xffffffff, cfg->eky, NVS_KEY_SIZE);
+    return esp_rom_crc32_le(crc, cfg->tky, NVS_KEY_SIZE);
+}
+
+esp_err_t read_keys(const char *path, nvs_sec_cfg_t *cfg)
+{
+    std::string contents;
+    if (!read_file(path, contents) || contents.size() < 2 * NVS_KEY_SIZE + sizeof(uint32_t)) {
+        fprintf(stderr, "%s: cannot read the keys\n", path);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    uint32_t crc;
+    memcpy(cfg->eky, contents.data(), NVS_KEY_SIZE);
+    memcpy(cfg->tky, contents.data() + NVS_KEY_SIZE, NVS_KEY_SIZE);
+    memcpy(&crc, contents.data() + 2 * NVS_KEY_SIZE, sizeof(crc));
+    if (crc != keys_crc(cfg)) {
+        fprintf(stderr, "%s: CRC32 of the keys doesn't match\n", path);
+        return ESP_ERR_NVS_CORRUPT_KEY_PART;
+    }
+    return ESP_OK;
+}
+
+esp_err_t generate_keys(const char *path, nvs_sec_cfg_t *cfg)
+{
+    FILE *random = fopen("/dev/urandom", "rb");
+    const bool filled = random != nullptr &&
+                        fread(cfg->eky, 1, NVS_KEY_SIZE, random) == NVS_KEY_SIZE &&
+                        fread(cfg->tky, 1, NVS_KEY_SIZE, random) == NVS_KEY_SIZE;
+    if (random != nullptr) {
+        fclose(random);
+    }
+    if (!filled) {
+        fprintf(stderr, "Cannot read random data for the keys\n");
+        return ESP_FAIL;
+    }
+
+    std::vector<uint8_t> image(KEYS_IMAGE_SIZE, 0xFF);
+    const uint32_t crc = keys_crc(cfg);
+    memcpy(image.data(), cfg->eky, NVS_KEY_SIZE);
+    memcpy(image.data() + NVS_KEY_SIZE, cfg->tky, NVS_KEY_SIZE);
+    memcpy(image.data() + 2 * NVS_KEY_SIZE, &crc, sizeof(crc));
+
+    FILE *f = fopen(path, "wb");
+    const bool written = f != nullptr && fwrite(image.data(), 1, image.size(), f) == image.size();
+    if (f == nullptr || fclose(f) != 0 || !written) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+} // nvs_image_gen
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include "esp_err.h"
+#include "nvs_flash.h"
+
+namespace nvs_image_gen {
+
+/**
+ * Smallest partition size accepted, same as nvs_partition_gen.py
+ */
+constexpr size_t MIN_PARTITION_SIZE = 0x3000;
+
+/**
+ * @brief Generate an NVS partition image from a CSV file
+ *
+ * The CSV file has the format of nvs_partition_gen.py: a "key,type,encoding,value" header,
+ * then one namespace, data or file entry per line. Lines starting with '#' are ignored.
+ *
+ * The entries are written by the nvs_flash Storage and Page code to the emulated flash,
+ * which is mapped directly onto the output file. The image is therefore laid out
+ * exactly as the firmware itself would have written it.
+ *
+ * Errors are reported on stderr with the line of the CSV file they were found on.
+ *
+ * @param input   CSV file
+ * @param output  image file, created or overwritten. Removed if the generation fails.
+ * @param size    size of the partition in bytes, a multiple of the flash sector size
+ * @param sec_cfg XTS encryption keys, nullptr to generate a plain image
+ *
+ * @return
+ *      - ESP_OK if the image was generated
+ *      - ESP_ERR_INVALID_SIZE if size isn't valid
+ *      - ESP_ERR_NOT_FOUND if the CSV file or a file it references can't be read
+ *      - ESP_ERR_INVALID_ARG if the CSV file has an invalid entry
+ *      - ESP_ERR_NOT_SUPPORTED if sec_cfg is given but encryption support isn't built in
+ *      - error codes from the nvs API, e.g. ESP_ERR_NVS_NOT_ENOUGH_SPACE
+ */
+esp_err_t generate(const char *input, const char *output, size_t size, const nvs_sec_cfg_t *sec_cfg);
+
+/**
+ * @brief Read XTS encryption keys from a key partition image
+ *
+ * The image has the layout of the nvs_keys partition, as written by nvs_partition_gen.py
+ * generate-key: the encryption key, the tweak key and the CRC32 of both keys.
+ *
+ * @return
+ *      - ESP_OK if the keys were read
+ *      - ESP_ERR_NOT_FOUND if the file can't be read
+ *      - ESP_ERR_NVS_CORRUPT_KEY_PART if the CRC32 doesn't match
+ */
+esp_err_t read_keys(const char *path, nvs_sec_cfg_t *cfg);
+
+/**
+ * @brief Generate random XTS encryption keys and write them as a key partition image
+ *
+ * @return
+ *      - ESP_OK if the keys were generated and written
+ *      - ESP_FAIL if the file can't be written or no random data is available
+ */
+esp_err_t generate_keys(const char *path, nvs_sec_cfg_t *cfg);
+
+} // nvs_image_gen
@@ -0,0 +1,164 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "nvs_image_builder.hpp"
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s generate INPUT OUTPUT SIZE\n"
+            "       %s generate --batch LIST SIZE\n"
+            "       %s encrypt --inputkey KEYFILE INPUT OUTPUT SIZE\n"
+            "       %s encrypt [--inputkey KEYFILE] --batch LIST SIZE\n"
+            "       %s generate-key --keyfile KEYFILE\n"
+            "\n"
+            "INPUT is a CSV file in the nvs_partition_gen.py format, OUTPUT the partition image\n"
+            "and SIZE the partition size, e.g. 0x6000.\n"
+            "LIST has one image per line: INPUT,OUTPUT[,KEYFILE]. The key file of a line\n"
+            "overrides --inputkey, so that each device can have its own keys.\n",
+            prog, prog, prog, prog, prog);
+}
+
+static int generate_batch(const char *list, size_t size, const nvs_sec_cfg_t *default_cfg, bool encrypt)
+{
+    std::ifstream in(list);
+    if (!in) {
+        fprintf(stderr, "%s: cannot read the list of images\n", list);
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::string text;
+    size_t line = 0;
+    size_t count = 0;
+
+    while (std::getline(in, text)) {
+        line++;
+        if (!text.empty() && text.back() == '\r') {
+            text.pop_back();
+        }
+        if (text.empty() || text[0] == '#') {
+            continue;
+        }
+
+        const size_t first = text.find(',');
+        const size_t second = (first == std::string::npos) ? first : text.find(',', first + 1);
+        if (first == std::string::npos) {
+            fprintf(stderr, "%s:%zu: expected INPUT,OUTPUT[,KEYFILE]\n", list, line);
+            return EXIT_FAILURE;
+        }
+        const std::string input = text.substr(0, first);
+        const std::string output = text.substr(first + 1, second - first - 1);
+
+        nvs_sec_cfg_t cfg;
+        const nvs_sec_cfg_t *p_cfg = default_cfg;
+        if (second != std::string::npos) {
+            if (!encrypt) {
+                fprintf(stderr, "%s:%zu: key files are only used by the encrypt command\n", list, line);
+                return EXIT_FAILURE;
+            }
+            if (nvs_image_gen::read_keys(text.substr(second + 1).c_str(), &cfg) != ESP_OK) {
+                return EXIT_FAILURE;
+            }
+            p_cfg = &cfg;
+        }
+        if (encrypt && p_cfg == nullptr) {
+            fprintf(stderr, "%s:%zu: no key file for %s\n", list, line, output.c_str());
+            return EXIT_FAILURE;
+        }
+
+        if (nvs_image_gen::generate(input.c_str(), output.c_str(), size, p_cfg) != ESP_OK) {
+            return EXIT_FAILURE;
+        }
+        count++;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    printf("Created %zu NVS images in %lld ms\n", count, static_cast<long long>(elapsed.count()));
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string command = argv[1];
+    const char *inputkey = nullptr;
+    const char *keyfile = nullptr;
+    const char *batch = nullptr;
+    const char *positional[3];
+    int positional_count = 0;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--inputkey") == 0 && i + 1 < argc) {
+            inputkey = argv[++i];
+        } else if (strcmp(argv[i], "--keyfile") == 0 && i + 1 < argc) {
+            keyfile = argv[++i];
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch = argv[++i];
+        } else if (argv[i][0] != '-' && positional_count < 3) {
+            positional[positional_count++] = argv[i];
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (command == "generate-key") {
+        nvs_sec_cfg_t cfg;
+        if (keyfile == nullptr || positional_count != 0) {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        if (nvs_image_gen::generate_keys(keyfile, &cfg) != ESP_OK) {
+            return EXIT_FAILURE;
+        }
+        printf("Created encryption keys: %s\n", keyfile);
+        return EXIT_SUCCESS;
+    }
+
+    const bool encrypt = (command == "encrypt");
+    if ((!encrypt && command != "generate") || (!encrypt && inputkey != nullptr) ||
+            positional_count != (batch != nullptr ? 1 : 3) || (encrypt && batch == nullptr && inputkey == nullptr)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char *end;
+    const char *size_arg = positional[positional_count - 1];
+    const size_t size = strtoul(size_arg, &end, 0);
+    if (end == size_arg || *end != '\0') {
+        fprintf(stderr, "Invalid partition size %s\n", size_arg);
+        return EXIT_FAILURE;
+    }
+
+    nvs_sec_cfg_t cfg;
+    const nvs_sec_cfg_t *p_cfg = nullptr;
+    if (inputkey != nullptr) {
+        if (nvs_image_gen::read_keys(inputkey, &cfg) != ESP_OK) {
+            return EXIT_FAILURE;
+        }
+        p_cfg = &cfg;
+    }
+
+    if (batch != nullptr) {
+        return generate_batch(batch, size, p_cfg, encrypt);
+    }
+
+    if (nvs_image_gen::generate(positional[0], positional[1], size, p_cfg) != ESP_OK) {
+        return EXIT_FAILURE;
+    }
+    printf("Created NVS image: %s\n", positional[1]);
+    return EXIT_SUCCESS;
+}
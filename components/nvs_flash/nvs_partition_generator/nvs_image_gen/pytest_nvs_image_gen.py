@@ -0,0 +1,103 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Unlicense OR CC0-1.0
+import os
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+from typing import Any
+from typing import Dict
+from typing import List
+from typing import Tuple
+
+import pytest
+from pytest_embedded_idf.app import IdfApp
+from pytest_embedded_idf.utils import idf_parametrize
+
+GENERATOR_DIR = Path(__file__).resolve().parent.parent
+sys.path.append(str(GENERATOR_DIR.parent / 'nvs_partition_tool'))
+from nvs_parser import NVS_Partition  # noqa: E402
+
+PARTITION_SIZE = '0x4000'
+SAMPLE_CSV = str(GENERATOR_DIR / 'sample_multipage_blob.csv')
+SAMPLE_KEYS = os.path.join('testdata', 'sample_encryption_keys.bin')
+
+
+def nvs_partition_gen(*args: str) -> None:
+    subprocess.check_call([sys.executable, str(GENERATOR_DIR / 'nvs_partition_gen.py'), *args, '--outdir', '.'])
+
+
+def read_items(image: str) -> Dict[Tuple[str, str], Tuple[str, Any]]:
+    """
+    Read the items of a plain image as {(namespace, key): (type, value)}, blobs being
+    reassembled from their chunks. Unlike the image itself, this doesn't depend on
+    the order the entries were written in.
+    """
+    with open(image, 'rb') as f:
+        partition = NVS_Partition('nvs', bytearray(f.read()))
+
+    namespaces: Dict[int, str] = {}
+    items: Dict[Tuple[int, str], Tuple[str, Any]] = {}
+    chunks: Dict[Tuple[int, str], Dict[int, bytes]] = {}
+    for page in partition.pages:
+        for entry in page.entries:
+            if entry.state != 'Written':
+                continue
+            namespace = entry.metadata['namespace']
+            entry_type = entry.metadata['type']
+            if namespace == 0:
+                namespaces[entry.data['value']] = entry.key
+            elif entry_type in ('string', 'blob', 'blob_data'):
+                data = b''.join(bytes(child.raw) for child in entry.children)[:entry.data['size']]
+                if entry_type == 'blob_data':
+                    chunks.setdefault((namespace, entry.key), {})[entry.metadata['chunk_index']] = data
+                else:
+                    items[(namespace, entry.key)] = (entry_type, data)
+            elif entry_type != 'blob_index':
+                items[(namespace, entry.key)] = (entry_type, entry.data['value'])
+
+    for item, item_chunks in chunks.items():
+        items[item] = ('blob', b''.join(item_chunks[index] for index in sorted(item_chunks)))
+    return {(namespaces[namespace], key): value for (namespace, key), value in items.items()}
+
+
+@pytest.mark.host_test
+@idf_parametrize('target', ['linux'], indirect=['target'])
+def test_nvs_image_gen_encrypted(app: IdfApp, tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    # File entries of the sample CSV are relative to the current directory
+    shutil.copytree(GENERATOR_DIR / 'testdata', tmp_path / 'testdata')
+    monkeypatch.chdir(tmp_path)
+
+    def nvs_image_gen(*args: str) -> None:
+        subprocess.check_call([app.elf_file, *args])
+
+    nvs_image_gen('generate', SAMPLE_CSV, 'native.bin', PARTITION_SIZE)
+    nvs_image_gen('encrypt', '--inputkey', SAMPLE_KEYS, SAMPLE_CSV, 'native_enc.bin', PARTITION_SIZE)
+    nvs_partition_gen('decrypt', 'native_enc.bin', SAMPLE_KEYS, 'native_dec.bin')
+
+    # Encryption doesn't change the layout, nvs_partition_gen.py gets the plain image back
+    assert Path('native_enc.bin').read_bytes() != Path('native.bin').read_bytes()
+    assert Path('native_dec.bin').read_bytes() == Path('native.bin').read_bytes()
+
+    # Same items as an image encrypted by nvs_partition_gen.py with the same keys
+    nvs_partition_gen('encrypt', SAMPLE_CSV, 'python_enc.bin', PARTITION_SIZE, '--inputkey', SAMPLE_KEYS)
+    nvs_partition_gen('decrypt', 'python_enc.bin', SAMPLE_KEYS, 'python_dec.bin')
+    native_items = read_items('native_dec.bin')
+    assert native_items == read_items('python_dec.bin')
+    assert native_items[('dummyNamespace', 'binFileKey')] == \
+        ('blob', Path('testdata/sample_multipage_blob.bin').read_bytes())
+
+    # Keys generated natively can be used by nvs_partition_gen.py
+    nvs_image_gen('generate-key', '--keyfile', 'native_keys.bin')
+    nvs_image_gen('encrypt', '--inputkey', 'native_keys.bin', SAMPLE_CSV, 'native_keys_enc.bin', PARTITION_SIZE)
+    nvs_partition_gen('decrypt', 'native_keys_enc.bin', 'native_keys.bin', 'native_keys_dec.bin')
+    assert Path('native_keys_dec.bin').read_bytes() == Path('native.bin').read_bytes()
+
+    # Keys with a bad CRC are rejected
+    keys = bytearray(Path(SAMPLE_KEYS).read_bytes())
+    keys[0] ^= 0xFF
+    Path('bad_keys.bin').write_bytes(keys)
+    encrypt_bad_keys: List[str] = [app.elf_file, 'encrypt', '--inputkey', 'bad_keys.bin', SAMPLE_CSV, 'bad.bin',
+                                   PARTITION_SIZE]
+    assert subprocess.run(encrypt_bad_keys).returncode != 0
+    assert not Path('bad.bin').exists()
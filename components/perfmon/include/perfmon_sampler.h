@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum number of frames recorded for each sampled call stack
+ */
+#define PERFMON_SAMPLER_MAX_DEPTH (32)
+
+/**
+ * @brief Configuration of the sampling profiler
+ */
+typedef struct {
+    uint32_t period_us;     /*!< Sampling period, in microseconds */
+    uint32_t depth;         /*!< Maximum number of frames of each call stack, up to PERFMON_SAMPLER_MAX_DEPTH */
+    uint32_t max_stacks;    /*!< Number of distinct call stacks that can be recorded */
+} perfmon_sampler_config_t;
+
+/**
+ * @brief Default sampling profiler configuration: 1 kHz, 16 frames, 512 call stacks
+ */
+#define PERFMON_SAMPLER_DEFAULT_CONFIG() \
+    {                                    \
+        .period_us = 1000,               \
+        .depth = 16,                     \
+        .max_stacks = 512,               \
+    }
+
+/**
+ * @brief Statistics of the sampling profiler
+ */
+typedef struct {
+    uint32_t samples;       /*!< Number of call stacks recorded */
+    uint32_t stacks;        /*!< Number of distinct call stacks recorded */
+    uint32_t dropped;       /*!< Number of samples lost because the stack table was full */
+    uint32_t skipped;       /*!< Number of samples skipped because the flash cache was disabled */
+} perfmon_sampler_stats_t;
+
+/**
+ * @brief Start sampling the call stacks of the running tasks
+ *
+ * A periodic esp_timer, dispatched from its interrupt handler, interrupts the CPU and
+ * unwinds the call stack of the task it interrupted with the eh_frame parser. Call stacks
+ * are counted in a fixed size table allocated here, nothing is allocated while sampling.
+ * Only the CPU esp_timer interrupt runs on is sampled.
+ *
+ * Code running with interrupts disabled is never sampled, and with
+ * CONFIG_ESP_TIMER_INTERRUPT_LEVEL above 1, a sample taken while another interrupt
+ * handler is running is attributed to the task that handler interrupted.
+ *
+ * Requires CONFIG_ESP_SYSTEM_USE_EH_FRAME and CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD.
+ *
+ * @param config Sampling profiler configuration
+ * @return
+ *      - ESP_OK: the profiler was started, the previous results are discarded
+ *      - ESP_ERR_INVALID_ARG: invalid configuration
+ *      - ESP_ERR_INVALID_STATE: the profiler is already running
+ *      - ESP_ERR_NO_MEM: the stack table could not be allocated
+ *      - ESP_ERR_NOT_SUPPORTED: the required options are not enabled
+ */
+esp_err_t perfmon_sampler_start(const perfmon_sampler_config_t *config);
+
+/**
+ * @brief Stop sampling, the results are kept until the profiler is started again or released
+ *
+ * @return
+ *      - ESP_OK: the profiler was stopped
+ *      - ESP_ERR_INVALID_STATE: the profiler is not running
+ */
+esp_err_t perfmon_sampler_stop(void);
+
+/**
+ * @brief Get the statistics of the sampling profiler
+ *
+ * @param[out] stats Statistics of the current or last run
+ * @return
+ *      - ESP_OK: success
+ *      - ESP_ERR_INVALID_ARG: stats is NULL
+ */
+esp_err_t perfmon_sampler_get_stats(perfmon_sampler_stats_t *stats);
+
+/**
+ * @brief Write the recorded call stacks in folded stacks format
+ *
+ * Each line holds one call stack, outermost frame first, followed by the number of samples:
+ * `0x42001234;0x42005678;0x4200abcd 42`. Frames are program counters, resolve them with the
+ * application ELF file (e.g. with addr2line) before rendering a flame graph.
+ *
+ * The profiler may be running, call stacks recorded while dumping may be missing from the output.
+ *
+ * @param stream Stream to write to, e.g. stdout
+ * @return
+ *      - ESP_OK: success
+ *      - ESP_ERR_INVALID_ARG: stream is NULL
+ *      - ESP_ERR_INVALID_STATE: nothing was recorded
+ */
+esp_err_t perfmon_sampler_dump(FILE *stream);
+
+/**
+ * @brief Release the memory used by the stack table, the profiler must be stopped
+ *
+ * @return
+ *      - ESP_OK: success
+ *      - ESP_ERR_INVALID_STATE: the profiler is running
+ */
+esp_err_t perfmon_sampler_release(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,259 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "perfmon_sampler.h"
+
+#if CONFIG_ESP_SYSTEM_USE_EH_FRAME && CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_private/cache_utils.h"
+#include "esp_private/eh_frame_parser.h"
+#include "esp_private/freertos_debug.h"
+
+static const char *TAG = "perfmon_sampler";
+
+/**
+ * Slot of the stack table. The table is open addressed with linear probing and has
+ * at least twice as many slots as call stacks, so that probing always finds a free slot.
+ */
+typedef struct {
+    uint32_t count;     // Number of samples, 0 if the slot is free
+    uint32_t hash;      // Hash of the program counters of the call stack
+    uint32_t stack;     // Index of the call stack in the program counters array
+    uint32_t depth;     // Number of frames of the call stack
+} sampler_slot_t;
+
+static struct {
+    esp_timer_handle_t timer;
+    sampler_slot_t *slots;
+    uint32_t slot_count;    // Power of two
+    uint32_t *pcs;          // max_stacks call stacks of depth program counters
+    uint32_t depth;
+    uint32_t max_stacks;
+    perfmon_sampler_stats_t stats;
+} s_sampler;
+
+static uint32_t sampler_hash(const uint32_t *pcs, uint32_t depth)
+{
+    // FNV-1a on whole words, program counters are already well distributed
+    uint32_t hash = 2166136261U;
+    for (uint32_t i = 0; i < depth; i++) {
+        hash = (hash ^ pcs[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static void sampler_record_stack(const uint32_t *pcs, uint32_t depth)
+{
+    const uint32_t hash = sampler_hash(pcs, depth);
+    const uint32_t mask = s_sampler.slot_count - 1;
+
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        sampler_slot_t *slot = &s_sampler.slots[i];
+        const uint32_t count = slot->count;
+
+        if (count == 0) {
+            if (s_sampler.stats.stacks == s_sampler.max_stacks) {
+                s_sampler.stats.dropped++;
+                return;
+            }
+            slot->hash = hash;
+            slot->depth = depth;
+            slot->stack = s_sampler.stats.stacks++;
+            memcpy(&s_sampler.pcs[slot->stack * s_sampler.depth], pcs, depth * sizeof(uint32_t));
+            // Publish the slot last, perfmon_sampler_dump() may be reading the table
+            __atomic_store_n(&slot->count, 1, __ATOMIC_RELEASE);
+            s_sampler.stats.samples++;
+            return;
+        }
+
+        if (slot->hash == hash && slot->depth == depth &&
+                memcmp(&s_sampler.pcs[slot->stack * s_sampler.depth], pcs, depth * sizeof(uint32_t)) == 0) {
+            slot->count = count + 1;
+            s_sampler.stats.samples++;
+            return;
+        }
+    }
+}
+
+static void __attribute__((noinline)) sampler_record(void)
+{
+    TaskSnapshot_t snapshot;
+    uint32_t pcs[PERFMON_SAMPLER_MAX_DEPTH];
+
+    // The interrupted context was saved on the task stack when entering the interrupt
+    if (vTaskGetSnapshot(xTaskGetCurrentTaskHandleForCore(xPortGetCoreID()), &snapshot) != pdTRUE) {
+        s_sampler.stats.skipped++;
+        return;
+    }
+
+    const uint32_t stack_low = (uint32_t) snapshot.pxTopOfStack;
+    const uint32_t stack_high = (uint32_t) snapshot.pxEndOfStack + sizeof(StackType_t);
+    const uint32_t depth = esp_eh_frame_unwind(snapshot.pxTopOfStack, stack_low, stack_high,
+                                               pcs, s_sampler.depth);
+    if (depth > 0) {
+        sampler_record_stack(pcs, depth);
+    }
+}
+
+static void IRAM_ATTR sampler_timer_cb(void *arg)
+{
+    // The eh_frame sections and the unwinder are in flash
+    if (!spi_flash_cache_enabled()) {
+        s_sampler.stats.skipped++;
+        return;
+    }
+    sampler_record();
+}
+
+static void sampler_free(void)
+{
+    free(s_sampler.slots);
+    free(s_sampler.pcs);
+    s_sampler.slots = NULL;
+    s_sampler.pcs = NULL;
+}
+
+esp_err_t perfmon_sampler_start(const perfmon_sampler_config_t *config)
+{
+    if (config == NULL || config->period_us == 0 || config->depth == 0 ||
+            config->depth > PERFMON_SAMPLER_MAX_DEPTH || config->max_stacks == 0 ||
+            config->max_stacks > UINT32_MAX / 2 / PERFMON_SAMPLER_MAX_DEPTH) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_sampler.timer != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    sampler_free();
+    memset(&s_sampler.stats, 0, sizeof(s_sampler.stats));
+    s_sampler.depth = config->depth;
+    s_sampler.max_stacks = config->max_stacks;
+    s_sampler.slot_count = 1;
+    while (s_sampler.slot_count < config->max_stacks * 2) {
+        s_sampler.slot_count <<= 1;
+    }
+    s_sampler.slots = calloc(s_sampler.slot_count, sizeof(sampler_slot_t));
+    s_sampler.pcs = calloc(config->max_stacks * config->depth, sizeof(uint32_t));
+    if (s_sampler.slots == NULL || s_sampler.pcs == NULL) {
+        sampler_free();
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = sampler_timer_cb,
+        .dispatch_method = ESP_TIMER_ISR,
+        .name = "perfmon_sampler",
+    };
+    esp_err_t err = esp_timer_create(&timer_args, &s_sampler.timer);
+    if (err == ESP_OK) {
+        err = esp_timer_start_periodic(s_sampler.timer, config->period_us);
+        if (err != ESP_OK) {
+            esp_timer_delete(s_sampler.timer);
+            s_sampler.timer = NULL;
+        }
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start the sampling timer (0x%x)", err);
+        sampler_free();
+    }
+    return err;
+}
+
+esp_err_t perfmon_sampler_stop(void)
+{
+    if (s_sampler.timer == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_timer_stop(s_sampler.timer);
+    esp_timer_delete(s_sampler.timer);
+    s_sampler.timer = NULL;
+    return ESP_OK;
+}
+
+esp_err_t perfmon_sampler_get_stats(perfmon_sampler_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = s_sampler.stats;
+    return ESP_OK;
+}
+
+esp_err_t perfmon_sampler_dump(FILE *stream)
+{
+    if (stream == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_sampler.slots == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (uint32_t i = 0; i < s_sampler.slot_count; i++) {
+        const sampler_slot_t *slot = &s_sampler.slots[i];
+        const uint32_t count = __atomic_load_n(&slot->count, __ATOMIC_ACQUIRE);
+        if (count == 0) {
+            continue;
+        }
+        // Folded stacks start with the outermost frame
+        const uint32_t *pcs = &s_sampler.pcs[slot->stack * s_sampler.depth];
+        for (uint32_t j = slot->depth; j > 0; j--) {
+            fprintf(stream, "0x%08" PRIx32 "%s", pcs[j - 1], (j > 1) ? ";" : " ");
+        }
+        fprintf(stream, "%" PRIu32 "\n", count);
+    }
+    return ESP_OK;
+}
+
+esp_err_t perfmon_sampler_release(void)
+{
+    if (s_sampler.timer != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    sampler_free();
+    return ESP_OK;
+}
+
+#else // CONFIG_ESP_SYSTEM_USE_EH_FRAME && CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+
+esp_err_t perfmon_sampler_start(const perfmon_sampler_config_t *config)
+{
+    (void) config;
+    ESP_LOGE("perfmon_sampler", "CONFIG_ESP_SYSTEM_USE_EH_FRAME and CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD are required");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t perfmon_sampler_stop(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t perfmon_sampler_get_stats(perfmon_sampler_stats_t *stats)
+{
+    (void) stats;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t perfmon_sampler_dump(FILE *stream)
+{
+    (void) stream;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t perfmon_sampler_release(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_ESP_SYSTEM_USE_EH_FRAME && CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_timer.h"
+#include "perfmon_sampler.h"
+#include "unity.h"
+
+#define TEST_PERIOD_US      (200)
+#define TEST_DURATION_US    (100 * 1000)
+
+/* Length of a frame in the folded stacks, "0x%08x" */
+#define FRAME_LEN           (10)
+
+static volatile uint32_t s_sink;
+
+static void __attribute__((noinline)) busy_leaf(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        s_sink += i;
+    }
+}
+
+static void __attribute__((noinline)) busy_a(void)
+{
+    busy_leaf(100);
+}
+
+static void __attribute__((noinline)) busy_b(void)
+{
+    busy_leaf(50);
+    busy_a();
+}
+
+/* Keep the CPU busy in a few distinct call stacks */
+static void run_workload(void)
+{
+    const int64_t end = esp_timer_get_time() + TEST_DURATION_US;
+    while (esp_timer_get_time() < end) {
+        busy_a();
+        busy_b();
+    }
+}
+
+/**
+ * Check the format of the output of perfmon_sampler_dump() and that each call stack
+ * appears once. Returns the number of samples of all call stacks.
+ */
+static uint32_t check_folded_stacks(const char *dump, uint32_t *stacks)
+{
+    uint32_t samples = 0;
+    *stacks = 0;
+
+    for (const char *line = dump; *line != '\0';) {
+        const char *end = strchr(line, '\n');
+        TEST_ASSERT_NOT_NULL(end);
+        const char *space = memchr(line, ' ', end - line);
+        TEST_ASSERT_NOT_NULL(space);
+
+        for (const char *frame = line; frame < space; frame += FRAME_LEN + 1) {
+            TEST_ASSERT_EQUAL_STRING_LEN("0x", frame, 2);
+            for (int i = 2; i < FRAME_LEN; i++) {
+                TEST_ASSERT_TRUE(isxdigit((unsigned char) frame[i]));
+            }
+            TEST_ASSERT_TRUE(frame[FRAME_LEN] == ';' || frame + FRAME_LEN == space);
+        }
+
+        char *count_end;
+        const uint32_t count = strtoul(space + 1, &count_end, 10);
+        TEST_ASSERT_EQUAL_PTR(end, count_end);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, count);
+
+        for (const char *prev = dump; prev < line; prev = strchr(prev, '\n') + 1) {
+            const char *prev_space = strchr(prev, ' ');
+            TEST_ASSERT_FALSE_MESSAGE(prev_space - prev == space - line && memcmp(prev, line, space - line) == 0,
+                                      "Call stack recorded twice");
+        }
+
+        samples += count;
+        (*stacks)++;
+        line = end + 1;
+    }
+    return samples;
+}
+
+static uint32_t dump_folded_stacks(uint32_t *stacks)
+{
+    char *out_str = NULL;
+    size_t out_len = 0;
+    FILE *out_stream = open_memstream(&out_str, &out_len);
+    TEST_ASSERT_NOT_NULL(out_stream);
+
+    TEST_ESP_OK(perfmon_sampler_dump(out_stream));
+    fclose(out_stream);
+
+    const uint32_t samples = check_folded_stacks(out_str, stacks);
+    free(out_str);
+    return samples;
+}
+
+TEST_CASE("perfmon_sampler start/stop", "[perfmon_sampler]")
+{
+    perfmon_sampler_config_t config = PERFMON_SAMPLER_DEFAULT_CONFIG();
+    perfmon_sampler_stats_t stats;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_sampler_start(NULL));
+    config.depth = PERFMON_SAMPLER_MAX_DEPTH + 1;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_sampler_start(&config));
+    config.depth = 16;
+    config.max_stacks = 0;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_sampler_start(&config));
+    config.max_stacks = 512;
+    config.period_us = 0;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_sampler_start(&config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_sampler_stop());
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_sampler_dump(stdout));
+
+    config.period_us = TEST_PERIOD_US;
+    TEST_ESP_OK(perfmon_sampler_start(&config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_sampler_start(&config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_sampler_release());
+    run_workload();
+    TEST_ESP_OK(perfmon_sampler_stop());
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_sampler_stop());
+
+    TEST_ESP_OK(perfmon_sampler_get_stats(&stats));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.samples);
+
+    // Nothing is sampled once stopped, the results are kept
+    const uint32_t samples = stats.samples;
+    run_workload();
+    TEST_ESP_OK(perfmon_sampler_get_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(samples, stats.samples);
+
+    // Starting again discards the results, the first sample is only taken after a period
+    config.period_us = 1000 * 1000;
+    TEST_ESP_OK(perfmon_sampler_start(&config));
+    TEST_ESP_OK(perfmon_sampler_get_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.stacks);
+    TEST_ESP_OK(perfmon_sampler_stop());
+
+    TEST_ESP_OK(perfmon_sampler_release());
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_sampler_dump(stdout));
+}
+
+TEST_CASE("perfmon_sampler counts each call stack once", "[perfmon_sampler]")
+{
+    perfmon_sampler_config_t config = PERFMON_SAMPLER_DEFAULT_CONFIG();
+    perfmon_sampler_stats_t stats;
+    uint32_t stacks;
+
+    // The table can hold more call stacks than the number of samples taken
+    config.period_us = TEST_PERIOD_US;
+    TEST_ASSERT_GREATER_THAN_UINT32(TEST_DURATION_US / TEST_PERIOD_US, config.max_stacks);
+
+    TEST_ESP_OK(perfmon_sampler_start(&config));
+    run_workload();
+    TEST_ESP_OK(perfmon_sampler_stop());
+
+    TEST_ESP_OK(perfmon_sampler_get_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.stacks);
+    // The workload runs in a few loops, the same call stacks are sampled many times
+    TEST_ASSERT_LESS_THAN_UINT32(stats.samples, stats.stacks);
+
+    TEST_ASSERT_EQUAL_UINT32(stats.samples, dump_folded_stacks(&stacks));
+    TEST_ASSERT_EQUAL_UINT32(stats.stacks, stacks);
+
+    TEST_ESP_OK(perfmon_sampler_release());
+}
+
+TEST_CASE("perfmon_sampler drops new call stacks once the table is full", "[perfmon_sampler]")
+{
+    perfmon_sampler_config_t config = PERFMON_SAMPLER_DEFAULT_CONFIG();
+    perfmon_sampler_stats_t stats;
+    uint32_t stacks;
+
+    config.period_us = TEST_PERIOD_US;
+    config.max_stacks = 2;
+    TEST_ESP_OK(perfmon_sampler_start(&config));
+    run_workload();
+    TEST_ESP_OK(perfmon_sampler_stop());
+
+    TEST_ESP_OK(perfmon_sampler_get_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(config.max_stacks, stats.stacks);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.dropped);
+
+    // The call stacks already in the table are still counted
+    TEST_ASSERT_EQUAL_UINT32(stats.samples, dump_folded_stacks(&stacks));
+    TEST_ASSERT_EQUAL_UINT32(config.max_stacks, stacks);
+
+    TEST_ESP_OK(perfmon_sampler_release());
+}
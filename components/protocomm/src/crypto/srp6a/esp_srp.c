@@ -10,8 +10,10 @@
 #include "esp_err.h"
 
 #include <mbedtls/sha512.h>
+#include <mbedtls/platform_util.h>
 #include "esp_srp_mpi.h"
 #include "esp_srp.h"
+#include "esp_srp_precomp.h"
 
 #define SHA512_HASH_SZ      64
 
@@ -35,6 +37,11 @@ typedef struct esp_srp_handle {
     const char    *bytes_g;
     int      len_g;
 
+    /* k = H(N | PAD(g)), fixed for the group
+     * the bytes_k simply points to the static array
+     */
+    const char    *bytes_k;
+
     /* Salt */
     esp_mpi_t *s;
     char    *bytes_s;
@@ -125,6 +132,8 @@ esp_srp_handle_t *esp_srp_init(esp_ng_type_t ng)
     if (! hd->g) {
         goto error;
     }
+
+    hd->bytes_k = k_3072;
     hd->type = ng;
     return hd;
 error:
@@ -247,10 +256,13 @@ static esp_mpi_t *calculate_padded_hash(esp_srp_handle_t *hd, const char *a, int
 /* k = SHA (N, PAD(g))
  *
  * https://tools.ietf.org/html/draft-ietf-tls-srp-08
+ *
+ * N and g are fixed for the group, so k is generated along with the group
+ * constants by gen_esp_srp_precomp.py instead of being hashed in every session.
  */
 static esp_mpi_t *calculate_k(esp_srp_handle_t *hd)
 {
-    return calculate_padded_hash(hd, hd->bytes_n, hd->len_n, hd->bytes_g, hd->len_g);
+    return esp_mpi_new_from_bin(hd->bytes_k, SHA512_HASH_SZ);
 }
 
 static esp_mpi_t *calculate_u(esp_srp_handle_t *hd, char *A, int len_A)
@@ -258,6 +270,131 @@ static esp_mpi_t *calculate_u(esp_srp_handle_t *hd, char *A, int len_A)
     return calculate_padded_hash(hd, A, len_A, hd->bytes_B, hd->len_B);
 }
 
+#if CONFIG_ESP_PROTOCOMM_SRP_FIXED_BASE_TABLE
+/* Montgomery multiplication r = a * b / R mod N (CIOS), r may alias a or b.
+ * t is a scratch buffer of SRP_3072_WORDS + 2 words.
+ */
+static void srp_montmul(uint32_t *r, const uint32_t *a, const uint32_t *b, uint32_t *t)
+{
+    const uint32_t *n = n_3072_words;
+    const int s = SRP_3072_WORDS;
+
+    memset(t, 0, (s + 2) * sizeof(uint32_t));
+    for (int i = 0; i < s; i++) {
+        uint64_t c = 0;
+        for (int j = 0; j < s; j++) {
+            c += (uint64_t)a[j] * b[i] + t[j];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[s];
+        t[s] = (uint32_t)c;
+        t[s + 1] = (uint32_t)(c >> 32);
+
+        uint32_t m = t[0] * SRP_3072_N0;
+        c = ((uint64_t)m * n[0] + t[0]) >> 32;
+        for (int j = 1; j < s; j++) {
+            c += (uint64_t)m * n[j] + t[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[s];
+        t[s - 1] = (uint32_t)c;
+        t[s] = t[s + 1] + (uint32_t)(c >> 32);
+    }
+
+    /* Subtract N if t >= N, without branching on the result */
+    uint32_t borrow = 0;
+    for (int j = 0; j < s; j++) {
+        uint64_t d = (uint64_t)t[j] - n[j] - borrow;
+        r[j] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 63);
+    }
+    uint32_t keep_diff = 0 - (t[s] | (borrow ^ 1));
+    for (int j = 0; j < s; j++) {
+        r[j] = (r[j] & keep_diff) | (t[j] & ~keep_diff);
+    }
+}
+
+/* Constant time table lookup, every entry is read whatever the index */
+static void srp_comb_select(uint32_t *out, const uint32_t table[][SRP_3072_WORDS], unsigned int idx)
+{
+    memset(out, 0, SRP_3072_WORDS * sizeof(uint32_t));
+    for (unsigned int e = 0; e < (1 << SRP_COMB_ROWS); e++) {
+        uint32_t match = 0 - (uint32_t)(e == idx);
+        for (int j = 0; j < SRP_3072_WORDS; j++) {
+            out[j] |= table[e][j] & match;
+        }
+    }
+}
+
+/* g^b mod N for the 3072-bit group with the precomputed Lim-Lee comb
+ *
+ * The 256-bit exponent is laid out in SRP_COMB_ROWS rows, each row split in
+ * SRP_COMB_BLOCKS blocks of SRP_COMB_COLS bits. Every column then costs one
+ * table lookup per block, so g^b takes SRP_COMB_COLS squarings and
+ * SRP_COMB_COLS * SRP_COMB_BLOCKS multiplications instead of one squaring per
+ * exponent bit.
+ */
+static int srp_g_exp_b_comb(esp_mpi_t *result, esp_mpi_t *b)
+{
+    const int row_bits = SRP_COMB_EXP_BITS / SRP_COMB_ROWS;
+    unsigned char bytes[SRP_3072_WORDS * sizeof(uint32_t)];
+    int ret;
+
+    if (mbedtls_mpi_bitlen(b) > SRP_COMB_EXP_BITS) {
+        return -1;
+    }
+
+    uint32_t *acc = malloc((3 * SRP_3072_WORDS + 2) * sizeof(uint32_t));
+    if (!acc) {
+        return -1;
+    }
+    uint32_t *sel = acc + SRP_3072_WORDS;
+    uint32_t *t = sel + SRP_3072_WORDS;
+
+    memcpy(acc, one_3072_mont, sizeof(one_3072_mont));
+    for (int c = SRP_COMB_COLS - 1; c >= 0; c--) {
+        srp_montmul(acc, acc, acc, t);
+        for (int blk = 0; blk < SRP_COMB_BLOCKS; blk++) {
+            unsigned int idx = 0;
+            for (int row = 0; row < SRP_COMB_ROWS; row++) {
+                idx |= mbedtls_mpi_get_bit(b, row * row_bits + blk * SRP_COMB_COLS + c) << row;
+            }
+            srp_comb_select(sel, g_3072_comb[blk], idx);
+            srp_montmul(acc, acc, sel, t);
+        }
+    }
+
+    /* Leave the Montgomery domain */
+    memset(sel, 0, SRP_3072_WORDS * sizeof(uint32_t));
+    sel[0] = 1;
+    srp_montmul(acc, acc, sel, t);
+
+    for (int i = 0; i < (int)sizeof(bytes); i++) {
+        bytes[sizeof(bytes) - 1 - i] = (unsigned char)(acc[i / 4] >> (8 * (i % 4)));
+    }
+    ret = mbedtls_mpi_read_binary(result, bytes, sizeof(bytes));
+
+    mbedtls_platform_zeroize(acc, (3 * SRP_3072_WORDS + 2) * sizeof(uint32_t));
+    mbedtls_platform_zeroize(bytes, sizeof(bytes));
+    free(acc);
+    return ret;
+}
+#endif /* CONFIG_ESP_PROTOCOMM_SRP_FIXED_BASE_TABLE */
+
+/* g^b mod N, g is fixed for the group */
+static void calculate_g_exp_b(esp_srp_handle_t *hd, esp_mpi_t *gb)
+{
+#if CONFIG_ESP_PROTOCOMM_SRP_FIXED_BASE_TABLE
+    if (hd->type == ESP_NG_3072 && srp_g_exp_b_comb(gb, hd->b) == 0) {
+        return;
+    }
+    ESP_LOGD(TAG, "Fixed-base table not usable, falling back to generic exponentiation");
+#endif
+    esp_mpi_a_exp_b_mod_c(gb, hd->g, hd->b, hd->n, hd->ctx);
+}
+
 static esp_err_t __esp_srp_srv_pubkey(esp_srp_handle_t *hd, char **bytes_B, int *len_B)
 {
     esp_mpi_t *k = calculate_k(hd);
@@ -283,7 +420,7 @@ static esp_err_t __esp_srp_srv_pubkey(esp_srp_handle_t *hd, char **bytes_B, int
         goto error;
     }
     esp_mpi_a_mul_b_mod_c(kv, k, hd->v, hd->n, hd->ctx);
-    esp_mpi_a_exp_b_mod_c(gb, hd->g, hd->b, hd->n, hd->ctx);
+    calculate_g_exp_b(hd, gb);
     esp_mpi_a_add_b_mod_c(hd->B, kv, gb, hd->n, hd->ctx);
     hd->bytes_B = esp_mpi_to_bin(hd->B, len_B);
     hd->len_B = *len_B;
@@ -0,0 +1,521 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generated by gen_esp_srp_precomp.py, do not edit */
+
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+
+/* k = H(N | PAD(g)) for the 3072-bit group */
+static const char k_3072[] = {
+    0xA9, 0xC2, 0xE2, 0x55, 0x9B, 0xF0, 0xEB, 0xB5, 0x3F, 0x0C, 0xBB, 0xF6, 0x22, 0x82, 0x90, 0x6B,
+    0xED, 0xE7, 0xF2, 0x18, 0x2F, 0x00, 0x67, 0x82, 0x11, 0xFB, 0xD5, 0xBD, 0xE5, 0xB2, 0x85, 0x03,
+    0x3A, 0x49, 0x93, 0x50, 0x3B, 0x87, 0x39, 0x7F, 0x9B, 0xE5, 0xEC, 0x02, 0x08, 0x0F, 0xED, 0xBC,
+    0x08, 0x35, 0x58, 0x7A, 0xD0, 0x39, 0x06, 0x08, 0x79, 0xB8, 0x62, 0x1E, 0x8C, 0x36, 0x59, 0xE0,
+};
+
+#define SRP_3072_WORDS          96
+#define SRP_3072_N0             0x00000001U
+#define SRP_COMB_EXP_BITS       256
+#define SRP_COMB_ROWS           4
+#define SRP_COMB_BLOCKS         2
+#define SRP_COMB_COLS           32
+
+#if CONFIG_ESP_PROTOCOMM_SRP_FIXED_BASE_TABLE
+
+/* N, least significant word first */
+static const uint32_t n_3072_words[SRP_3072_WORDS] = {
+    0xffffffff, 0xffffffff, 0xa93ad2ca, 0x4b82d120, 0xe0fd108e, 0x43db5bfc, 0x74e5ab31, 0x08e24fa0,
+    0xbad946e2, 0x770988c0, 0x7a615d6c, 0xbbe11757, 0x177b200c, 0x521f2b18, 0x3ec86a64, 0xd8760273,
+    0xd98a0864, 0xf12ffa06, 0x1ad2ee6b, 0xcee3d226, 0x4a25619d, 0x1e8c94e0, 0xdb0933d7, 0xabf5ae8c,
+    0xa6e1e4c7, 0xb3970f85, 0x5d060c7d, 0x8aea7157, 0x58dbef0a, 0xecfb8504, 0xdf1cba64, 0xa85521ab,
+    0x04507a33, 0xad33170d, 0x8aaac42d, 0x15728e5a, 0x98fa0510, 0x15d22618, 0xea956ae5, 0x3995497c,
+    0x95581718, 0xde2bcbf6, 0x6f4c52c9, 0xb5c55df0, 0xec07a28f, 0x9b2783a2, 0x180e8603, 0xe39e772c,
+    0x2e36ce3b, 0x32905e46, 0xca18217c, 0xf1746c08, 0x4abc9804, 0x670c354e, 0x7096966d, 0x9ed52907,
+    0x208552bb, 0x1c62f356, 0xdca3ad96, 0x83655d23, 0xfd24cf5f, 0x69163fa8, 0x1c55d39a, 0x98da4836,
+    0xa163bf05, 0xc2007cb8, 0xece45b3d, 0x49286651, 0x7c4b1fe6, 0xae9f2411, 0x5a899fa5, 0xee386bfb,
+    0xf406b7ed, 0x0bff5cb6, 0xa637ed6b, 0xf44c42e9, 0x625e7ec6, 0xe485b576, 0x6d51c245, 0x4fe1356d,
+    0xf25f1437, 0x302b0a6d, 0xcd3a431b, 0xef9519b3, 0x8e3404dd, 0x514a0879, 0x3b139b22, 0x020bbea6,
+    0x8a67cc74, 0x29024e08, 0x80dc1cd1, 0xc4c6628b, 0x2168c234, 0xc90fdaa2, 0xffffffff, 0xffffffff,
+};
+
+/* R mod N, the Montgomery form of 1 */
+static const uint32_t one_3072_mont[SRP_3072_WORDS] = {
+    0x00000001, 0x00000000, 0x56c52d35, 0xb47d2edf, 0x1f02ef71, 0xbc24a403, 0x8b1a54ce, 0xf71db05f,
+    0x4526b91d, 0x88f6773f, 0x859ea293, 0x441ee8a8, 0xe884dff3, 0xade0d4e7, 0xc137959b, 0x2789fd8c,
+    0x2675f79b, 0x0ed005f9, 0xe52d1194, 0x311c2dd9, 0xb5da9e62, 0xe1736b1f, 0x24f6cc28, 0x540a5173,
+    0x591e1b38, 0x4c68f07a, 0xa2f9f382, 0x75158ea8, 0xa72410f5, 0x13047afb, 0x20e3459b, 0x57aade54,
+    0xfbaf85cc, 0x52cce8f2, 0x75553bd2, 0xea8d71a5, 0x6705faef, 0xea2dd9e7, 0x156a951a, 0xc66ab683,
+    0x6aa7e8e7, 0x21d43409, 0x90b3ad36, 0x4a3aa20f, 0x13f85d70, 0x64d87c5d, 0xe7f179fc, 0x1c6188d3,
+    0xd1c931c4, 0xcd6fa1b9, 0x35e7de83, 0x0e8b93f7, 0xb54367fb, 0x98f3cab1, 0x8f696992, 0x612ad6f8,
+    0xdf7aad44, 0xe39d0ca9, 0x235c5269, 0x7c9aa2dc, 0x02db30a0, 0x96e9c057, 0xe3aa2c65, 0x6725b7c9,
+    0x5e9c40fa, 0x3dff8347, 0x131ba4c2, 0xb6d799ae, 0x83b4e019, 0x5160dbee, 0xa576605a, 0x11c79404,
+    0x0bf94812, 0xf400a349, 0x59c81294, 0x0bb3bd16, 0x9da18139, 0x1b7a4a89, 0x92ae3dba, 0xb01eca92,
+    0x0da0ebc8, 0xcfd4f592, 0x32c5bce4, 0x106ae64c, 0x71cbfb22, 0xaeb5f786, 0xc4ec64dd, 0xfdf44159,
+    0x7598338b, 0xd6fdb1f7, 0x7f23e32e, 0x3b399d74, 0xde973dcb, 0x36f0255d, 0x00000000, 0x00000000,
+};
+
+/*
+ * g_3072_comb[t][mask] = prod(g^(2^(64 * j + 32 * t)) for each bit j set in mask) * R mod N
+ */
+static const uint32_t g_3072_comb[SRP_COMB_BLOCKS][1 << SRP_COMB_ROWS][SRP_3072_WORDS] = {
+    {
+        {
+            0x00000001, 0x00000000, 0x56c52d35, 0xb47d2edf, 0x1f02ef71, 0xbc24a403, 0x8b1a54ce, 0xf71db05f,
+            0x4526b91d, 0x88f6773f, 0x859ea293, 0x441ee8a8, 0xe884dff3, 0xade0d4e7, 0xc137959b, 0x2789fd8c,
+            0x2675f79b, 0x0ed005f9, 0xe52d1194, 0x311c2dd9, 0xb5da9e62, 0xe1736b1f, 0x24f6cc28, 0x540a5173,
+            0x591e1b38, 0x4c68f07a, 0xa2f9f382, 0x75158ea8, 0xa72410f5, 0x13047afb, 0x20e3459b, 0x57aade54,
+            0xfbaf85cc, 0x52cce8f2, 0x75553bd2, 0xea8d71a5, 0x6705faef, 0xea2dd9e7, 0x156a951a, 0xc66ab683,
+            0x6aa7e8e7, 0x21d43409, 0x90b3ad36, 0x4a3aa20f, 0x13f85d70, 0x64d87c5d, 0xe7f179fc, 0x1c6188d3,
+            0xd1c931c4, 0xcd6fa1b9, 0x35e7de83, 0x0e8b93f7, 0xb54367fb, 0x98f3cab1, 0x8f696992, 0x612ad6f8,
+            0xdf7aad44, 0xe39d0ca9, 0x235c5269, 0x7c9aa2dc, 0x02db30a0, 0x96e9c057, 0xe3aa2c65, 0x6725b7c9,
+            0x5e9c40fa, 0x3dff8347, 0x131ba4c2, 0xb6d799ae, 0x83b4e019, 0x5160dbee, 0xa576605a, 0x11c79404,
+            0x0bf94812, 0xf400a349, 0x59c81294, 0x0bb3bd16, 0x9da18139, 0x1b7a4a89, 0x92ae3dba, 0xb01eca92,
+            0x0da0ebc8, 0xcfd4f592, 0x32c5bce4, 0x106ae64c, 0x71cbfb22, 0xaeb5f786, 0xc4ec64dd, 0xfdf44159,
+            0x7598338b, 0xd6fdb1f7, 0x7f23e32e, 0x3b399d74, 0xde973dcb, 0x36f0255d, 0x00000000, 0x00000000,
+        },
+        {
+            0x00000005, 0x00000000, 0xb1d9e209, 0x8671ea5c, 0x9b0ead38, 0xacb7340f, 0xb783a809, 0xd39471dd,
+            0x59c19d95, 0xacd0543c, 0x9c192ce1, 0x549a8b4a, 0x8a985fc0, 0x65642887, 0xc615ec0a, 0xc5b1f3bf,
+            0xc04dd607, 0x4a101ddd, 0x79e157e4, 0xf58ce541, 0x8d4517ea, 0x6741179e, 0xb8d1fccc, 0xa433973f,
+            0xbd968819, 0x7e0cb263, 0x2ee1c18b, 0x496bc94b, 0x43b454cb, 0x5f1666ea, 0xa4705c07, 0xb65657a4,
+            0xea6d9cfd, 0x9e008cbe, 0x4aaa2b1b, 0x94c3383b, 0x031de6af, 0x92e54185, 0x6b14e986, 0xe015908f,
+            0x15478c86, 0xa925042f, 0xd382620e, 0x73252a4d, 0x63d9d331, 0xf83a6dd1, 0x87b761ed, 0x8de7ac23,
+            0x18edf8d4, 0x032e28a1, 0x0d875893, 0x48b9e3d4, 0x8a5107e7, 0xfcc2f578, 0xcd0f0fdc, 0xe5d632da,
+            0x5d656255, 0x72113f51, 0xb0cd9c11, 0x6f052e4c, 0x0e47f322, 0xf290c1b3, 0x7252ddfb, 0x03bc96f1,
+            0xd90d44e4, 0x35fd9064, 0x5f8a37cb, 0x92360066, 0x92886080, 0x96e44ba8, 0x3b4fe1c3, 0x58e5e417,
+            0x3bde685a, 0xc403306d, 0xc0e85ce8, 0x3a82b16f, 0x1427861d, 0x896374b0, 0xdd6734a2, 0x7099f4dc,
+            0x44249aeb, 0x0f28cbda, 0xfddcb078, 0x52167f7c, 0x38fbe7aa, 0x698dd5a0, 0xd89df854, 0xf5c546c0,
+            0x4bf901bb, 0x32f479d5, 0x7bb36fea, 0x28201346, 0x58f434f8, 0x12b0bad5, 0x00000001, 0x00000000,
+        },
+        {
+            0xeb8b9c21, 0xdabd32d8, 0xd1bbcd04, 0xf90481f7, 0xa5d8223a, 0x9ade55e5, 0xc89593ce, 0xc6685bf2,
+            0xf16aa4db, 0xe14506f3, 0xd5686435, 0x70be6867, 0x840bbdc3, 0x13248bd6, 0x384a6da9, 0x7e58f6f6,
+            0xc5b8ce7c, 0x91f840ed, 0x3d50cece, 0x6ad58221, 0x659d1dff, 0x9efae8f9, 0xd33f73fd, 0xf00c24ed,
+            0x5e8f45e5, 0x34e5fcf1, 0xeb4ffd86, 0x56532cf6, 0xa6175de7, 0x18127d1e, 0x6df679ce, 0x3465747e,
+            0x8d1af958, 0xe19e0e45, 0xfcb354ba, 0x17624ce5, 0x7aa1965b, 0xbef1400d, 0xcd250218, 0xe14ac3e1,
+            0xc792ff37, 0xda9eb60b, 0x70b5cadf, 0xd1f8b756, 0xe5a8d5d4, 0x717d3e82, 0xf54e96ff, 0xf8ed4f7e,
+            0x12d70c2e, 0xd657f727, 0x3ac32617, 0xfd0e8cc3, 0xe03dbd1f, 0xaa53f202, 0x592f7543, 0x6610f82e,
+            0xe84f6f31, 0xf049a65e, 0xb839bf68, 0xd7545f96, 0x4500922f, 0x6f936612, 0x38cd5f76, 0x5e1051a3,
+            0xee3a2e4f, 0xcf556a51, 0x61accfe1, 0x87d9166e, 0x1406ff3c, 0x3484e368, 0xab641132, 0x5e739c14,
+            0x0d1413e2, 0x1e552d41, 0x6efd3a8b, 0x62117077, 0xed90feaf, 0x6299083f, 0xf7a3686f, 0xb7721161,
+            0x2952e398, 0x9079b4f5, 0x85ccff37, 0xa1ebe242, 0xb536c075, 0x65c32889, 0x5455c372, 0xf30fe206,
+            0xf98f31e7, 0x67003cfe, 0x8dc6cf9d, 0xe8b05fb1, 0x6ec81a86, 0x68f22b0f, 0x918fb0bf, 0x92b32cd6,
+        },
+        {
+            0x99ba0ca7, 0x45b1fe3c, 0xc6355b82, 0x4610e795, 0x7b3e8a0a, 0x7ea0f582, 0x01208ca6, 0xce452c7d,
+            0x4162aa86, 0x78461142, 0x36473a34, 0xbbf5db58, 0x654474b7, 0xbb786500, 0x9be34f84, 0xc6d0cde8,
+            0x2987f7a4, 0xf7795097, 0xfcee2d30, 0x7863e659, 0x67c6d2c1, 0xddcd631e, 0x6a2adc45, 0x58515b8b,
+            0x8b0893ee, 0xa14fd1ab, 0xde83daa3, 0x99cafe23, 0x8cbcf76f, 0x9e656790, 0x6796ec3c, 0xb5510320,
+            0xb8e5ea51, 0x0db01941, 0xda2b1f4b, 0x4a0663c8, 0x3333e5a7, 0x8f11f412, 0x2c8e34b1, 0xf34b406f,
+            0xbb2ecde6, 0x88c1f64d, 0x54f450cb, 0xae50d8cf, 0xa43ce808, 0x01233148, 0x9a6be6f6, 0x15659f22,
+            0x01c5a073, 0xca971737, 0x919f7b7e, 0x0e5fe7be, 0xcbbb8196, 0x858b4f71, 0xdcc01d77, 0xc0aa86d8,
+            0x4882867f, 0x78aa592e, 0xdfd961e0, 0x2ddb23a9, 0x5eb93c30, 0x5bb47f09, 0xe357361b, 0xa49d07c3,
+            0x645b6981, 0x88aa1a28, 0x0e9758ed, 0x14eca384, 0x6b8cbc62, 0xa95a28e5, 0xa3e116af, 0xfbd13470,
+            0x5956f38f, 0x7fab28d7, 0xde8249e1, 0x01beac81, 0xdf17fbdf, 0x23f1be52, 0xfb8d85a1, 0xf577ec0e,
+            0xe9e0498c, 0x720a73ed, 0x028c75df, 0x4a7137e5, 0x6da9b890, 0x5a3bb9bd, 0x2f859af7, 0xbb37ecd3,
+            0xcafc609f, 0xb0fc94e9, 0xc329d470, 0x01e51960, 0xe7170039, 0x7a9b2208, 0xd7ce73bd, 0xdd7fe030,
+        },
+        {
+            0x4afc767e, 0x4ff739fa, 0x7d3f9b57, 0x6de341ed, 0xfa7393c5, 0xb32e09b1, 0x948bcb6a, 0xfb7f2084,
+            0x460e7f7f, 0x93b8bdac, 0x97065f5e, 0x08eb8a84, 0x467c313a, 0x2598bf4b, 0x81457dc1, 0x25ba9d6b,
+            0x0285cbf5, 0xd16f8abe, 0x9db5827d, 0x71c94b03, 0x974d22d6, 0xc6d117de, 0xe618b54b, 0x25b0229b,
+            0xe4af469c, 0xbc04107f, 0xfda3f7e0, 0x626d3123, 0x432554cb, 0x73d22063, 0xd2a914f9, 0x4e03c23a,
+            0xecf9032d, 0x529ebb25, 0x9d43a92e, 0x6a277ed6, 0x75988211, 0xa8a6e697, 0x16474ae9, 0xe46fb49a,
+            0x62cc50cb, 0xfdca5e97, 0x2081b96f, 0x4e86ff42, 0x12a7829a, 0x2f43944b, 0xc56b7449, 0x593d228c,
+            0x3fadef16, 0xc5008817, 0x6728b911, 0xdf8f8148, 0x2071f2bc, 0x1e802ef4, 0xd05f2837, 0x0cdba0f3,
+            0x730c9f7d, 0x9e4a78ca, 0x4ec3a9b3, 0x640f82fd, 0x1010c171, 0x9ad2ca88, 0x44628326, 0xa173b159,
+            0x3492a6f7, 0x94d52b40, 0x3372de90, 0xc3f6212e, 0x0b1770da, 0xe58969b9, 0xe78f6611, 0x482229f6,
+            0xd394e157, 0x09a1a50d, 0xc053238d, 0x5acf710d, 0x76005170, 0x54e095a7, 0xaf787905, 0x008461c7,
+            0x98dce4fa, 0x3754b46e, 0xd1b48bca, 0xc30dd044, 0x88fc7eb5, 0x2b193107, 0xbe6e7d68, 0xe28e05cd,
+            0xad8c8815, 0x0170798e, 0x7da47a24, 0xfb2f0e97, 0x43987d5c, 0x441229b9, 0x770723ae, 0x0e9ff190,
+        },
+        {
+            0x76ee5076, 0x8fd421e3, 0x723e08b4, 0x257049a3, 0xe441e2db, 0x7fe63079, 0xe6baf915, 0xe97ba296,
+            0x5e487d7f, 0xe29bb45d, 0xf31fdcd8, 0x2c99b496, 0x606cf622, 0xbbfbbc78, 0x865b74c5, 0xbca51319,
+            0x0c9cfbc9, 0x172db5b6, 0x148b8c75, 0x38ee7712, 0xf481ae30, 0xe2157758, 0x7e7b8a7a, 0xbc70ad0b,
+            0x776c610c, 0xac14527f, 0xf433d763, 0xec21f5b3, 0x4fbaa7f8, 0x431aa1f0, 0x1d4d68df, 0x8612cb26,
+            0xa0dd0fe2, 0x9d19a7bd, 0x12524de7, 0x12c57a31, 0x4bfa8a57, 0x4b4280f5, 0x6f647690, 0x762e8702,
+            0xedfd93fb, 0xf4f3d8f4, 0xa2889f2f, 0x88a2fc4a, 0x5d458d03, 0xec51e577, 0xdb19456d, 0xbe31acbf,
+            0x3e65ab6f, 0xd902a874, 0x03cb9d58, 0x5dcd866a, 0xa239bdb0, 0x9880eac4, 0x11dbc913, 0x404a24c3,
+            0x3f3f1d71, 0x17745bf4, 0x89d25082, 0xf44d8ef2, 0x5053c736, 0x061df4a8, 0x55ec8fc1, 0x274276be,
+            0x06dd42d6, 0xe829d841, 0x013e58d2, 0xd3cea5e7, 0x37753445, 0x7baf109d, 0x85ccfe59, 0x68aad1d2,
+            0x21e866b4, 0x30283945, 0xc19fb1c1, 0xc60d3544, 0x4e019731, 0xa862ec45, 0x6d5a5d1a, 0x0295e8e6,
+            0xfc5078e2, 0x14a78628, 0x1886baf3, 0xcf451158, 0xacee798c, 0xd77df525, 0xb8287308, 0x6cc61d04,
+            0x63bea86d, 0x07325fc9, 0x743662b4, 0xe7eb48f5, 0x51fa72d0, 0x545ad09e, 0x5323b267, 0x491fb7d2,
+        },
+        {
+            0xfe9675b7, 0x5d0576db, 0x45d9cc1c, 0x349c4b37, 0xc03a64b9, 0x74330c91, 0xb0595eac, 0x1604ed5d,
+            0x9b28d080, 0x7dc016b1, 0x312ff82e, 0x99e63290, 0x9d529d39, 0x17a6e83f, 0x521dc2fc, 0x26af0368,
+            0x51486e27, 0xa82077bb, 0x70a8104b, 0x9a894d55, 0x0d42f139, 0x135fc3a7, 0xc358f418, 0xc19b5679,
+            0xeffa7ea7, 0xa4d8655d, 0x615c3f9c, 0xca27f9c8, 0x43bd5c25, 0xe328c0cb, 0xaef69ac2, 0x55a265b9,
+            0x573af15c, 0x3422b50c, 0x296fc1cc, 0xbdd3a7ec, 0x6039646e, 0xbafd38f7, 0x5f7324a3, 0xd3c58ff0,
+            0x6eec9f1b, 0xf5896e0f, 0x521ea761, 0xde464615, 0x91bf9bd1, 0x5ededfad, 0xce9b85bb, 0xc0d7a3d3,
+            0x48f1fd33, 0x2f3c011f, 0xee6b1035, 0x20d094f7, 0x2f4381d1, 0xbee54153, 0xa08e2a8a, 0x6b2c6c2a,
+            0xaf6a41e7, 0x1a7062b0, 0x37f5784f, 0x5303e4c5, 0xab2b8af0, 0x1562817f, 0xb39314a4, 0x28f3aa29,
+            0xd5d69272, 0x067566ad, 0xea7b9747, 0x8904eb7b, 0xb4f52a1b, 0x6a092688, 0x059f1c3a, 0x2c6e5d05,
+            0xfa9248ae, 0xdfcfe78a, 0x82a7349a, 0x5def670c, 0x62e33de4, 0x5b856feb, 0x3071abdf, 0xab95b66a,
+            0x91378cec, 0xaf61703b, 0xb75fcfac, 0x31acaf39, 0xb4ef0110, 0x248e8762, 0x2c744cac, 0x765c2e64,
+            0x42691465, 0x8898da05, 0x1e8da5f4, 0x0a849a4c, 0x4ea5da21, 0x4c157989, 0x5dcd6fe0, 0x9dd8ebec,
+        },
+        {
+            0xf8f04c96, 0xd11b524b, 0x6190842c, 0x248504b2, 0x1e2cc5f3, 0x796d2ae2, 0x130dd7ca, 0x5371b3f3,
+            0xd7403dda, 0x0fa3d735, 0x86cbc0a3, 0xcddbb6ca, 0xcc2bb1f9, 0x7fe507f5, 0xde3b8fbf, 0x380909af,
+            0x09cc0d95, 0x75126894, 0xe2cf8636, 0x98030c38, 0x63de9146, 0x053913a2, 0x3fa128f3, 0xc427a4ba,
+            0xbb3ecaef, 0x1d74cc44, 0xcfbb1896, 0x52088ce3, 0x481eff9d, 0xa8d934eb, 0xcd7ad69f, 0xb32c979c,
+            0xa7354832, 0xfd144416, 0x2f2e7c73, 0x74ca9c8d, 0x1630e6f9, 0x657baa8b, 0x1d7f7683, 0x761bf33b,
+            0x6a96d642, 0x312bc269, 0x4cb44c8c, 0x360f4499, 0x14a7236a, 0x08e3d37b, 0xc0de0a9e, 0x195acd9e,
+            0xe215874f, 0x547aeac9, 0x49ceec95, 0xcfb5a4bd, 0x0c1bc106, 0x8555a6b5, 0xd103116d, 0x3b5ea1be,
+            0x0b835152, 0x2f091371, 0x81e050c9, 0x14e3606e, 0x606b4893, 0x2fa9c883, 0x2cddec65, 0x02337a2e,
+            0x49059f2a, 0xda498b3b, 0xcdbce2a9, 0xd19f6675, 0x13e872d6, 0x06505477, 0x0c7eae33, 0x137e8d27,
+            0x08c7439d, 0x3b116f92, 0x9a9c3ec5, 0xf8c83a81, 0xc754b920, 0x1c0a0f35, 0xaa43148b, 0x6a48efca,
+            0xfef883f9, 0xdc6611df, 0x2d30450d, 0x29a01f05, 0xde0ef6b7, 0xc2ea8b80, 0x2d0aadf5, 0x49a9ac02,
+            0xacd6009f, 0x2ff55800, 0x162fe753, 0xe643dbda, 0x2502fc06, 0x213bcfc8, 0xd5032f62, 0x153c9b9d,
+        },
+        {
+            0x410a121a, 0xa6ac7f36, 0xe7079a16, 0x15a96f1b, 0x5f958792, 0x702bfbf2, 0x0b0847d9, 0xe1f691a4,
+            0x833bcc76, 0x739c4049, 0xb5384286, 0xf83c6061, 0x9f5d7c57, 0xbfbdb61f, 0x6c39b6f8, 0xf29726ab,
+            0xf67d043a, 0x510e1ecc, 0xf6e200a1, 0xbea40f09, 0x9251346b, 0x129a1905, 0xc24ed04f, 0xf85bf1ef,
+            0x3091bd12, 0x611c0186, 0xbc2a6e79, 0xd4c8c073, 0xa5dfcfd9, 0x7ccd2d95, 0x5fb433bb, 0x596e1d97,
+            0x99465b23, 0x672501e5, 0x1bd75644, 0x09e699fd, 0x4f7e91e4, 0x41b9adfc, 0xae273932, 0x0229b8d0,
+            0x79b4a734, 0x4bf58ba5, 0xa0a9219a, 0x19cbf622, 0x01554b7e, 0x680e5f2f, 0x88129e58, 0x7fda52aa,
+            0xa115ed38, 0xeada4a7d, 0xa90d08ef, 0xe8b8d903, 0x4095503c, 0x8282bc40, 0x782a2821, 0x5ad42ce2,
+            0xb67f26e0, 0x2c5d6a38, 0x99c3459b, 0x1c3151dd, 0x5a94726e, 0x2b4db854, 0x4e6c39c7, 0x7c852efa,
+            0x11eeb704, 0xfbead470, 0xfb847b2b, 0xb8f9aa46, 0xd20c6561, 0x2f5a1cff, 0xaf099656, 0x1d56d799,
+            0x5280b720, 0x6745cef3, 0xfc894bed, 0x8b84e5a0, 0xa3ce8bad, 0xbaada4ea, 0xcbbebd9b, 0x15ff8f4e,
+            0x25070547, 0xa6c08fbf, 0xd6ff0e87, 0x4e247d3d, 0x01053527, 0xe4be40b3, 0x2c800cdd, 0x1ff6cc53,
+            0x5fde57d6, 0xcd9de61a, 0x5909e420, 0x0c2ac558, 0x6acd0292, 0x869766ca, 0x12001d17, 0x66b536ff,
+        },
+        {
+            0x45325a84, 0x415e7c0f, 0x30b05cdb, 0xd549894a, 0x1bf184bd, 0xa92533c2, 0x4d5e10dc, 0x580c38f3,
+            0x1a78708e, 0x53fa2fee, 0x955691c7, 0x616bb339, 0xeddd2d9e, 0x1a76386d, 0x9f8fbe13, 0x0c07bc72,
+            0x1d5d045d, 0xb2e6a5f3, 0x9cc4264e, 0x1b6ca6e5, 0x474b42df, 0x1fe9535b, 0x1577a9dd, 0x81e05c95,
+            0xa514e7cf, 0x7e5de893, 0xf2c80f63, 0x1216df93, 0x8ba7312c, 0x960ad9e3, 0x204b8ddf, 0x6e7c509d,
+            0xf5bed349, 0xa952db61, 0x75df26fa, 0x069be53c, 0x5b84cf54, 0x1cfc19bc, 0x91994831, 0x97a60919,
+            0x35d715d3, 0xbf74224e, 0x44b5026f, 0x157112cc, 0x2e9b3457, 0xd1f8d4a5, 0x78400bb2, 0xb806aefc,
+            0xc90005a2, 0x3122b7e7, 0xb910e9b7, 0xa8b36500, 0xad716126, 0xbe7542a4, 0x77a59bcc, 0x887a8e5d,
+            0x4f711cea, 0xa50d2c6f, 0x478900db, 0x862bdf0c, 0xca9c9d67, 0x06581a53, 0x4f7179af, 0x3ce55a77,
+            0x16e2150b, 0x67952cbf, 0x0fcdb160, 0x0a8f86bf, 0x21a7bb1c, 0x8f8448dc, 0xb61cb063, 0xb6415e09,
+            0xb47623c4, 0xec5e5152, 0xa23ea0cc, 0xd0fff651, 0x6e4bbcd5, 0xdc58cda8, 0x20162f7e, 0xce3b61af,
+            0xd464f1f4, 0xe16cb9df, 0x9886c26f, 0xa78c3ecd, 0xe8b20008, 0xd523328b, 0x68590a10, 0x9bba8053,
+            0xca881e46, 0xb210e272, 0xbb793b01, 0xb34915a2, 0xd32f8870, 0x0ed54caf, 0x5a009176, 0x018a12fb,
+        },
+        {
+            0x31cd190a, 0x8c8b404c, 0xe1c65056, 0x8b17727d, 0x9517c35f, 0xb72b8bb7, 0x5fd1f837, 0x1ffab567,
+            0xfdcc50eb, 0x76f0caf9, 0x8c26b543, 0x5e071912, 0x6194b411, 0xcf01d4dc, 0xa26102ca, 0x27aa4235,
+            0x2f7fb875, 0x6f045fa9, 0xbe6e5ffd, 0x7e814657, 0x2d9759da, 0xaa09ad83, 0x0cc9c825, 0x531913d7,
+            0x85258e82, 0x51742e9b, 0x4df7cc83, 0xf3b504d1, 0xa3562d6f, 0x61d8d4ab, 0x62407663, 0xa1250a5e,
+            0x3b0f2307, 0x38d14a4e, 0x9226c91d, 0xe1726341, 0x2165bd84, 0x43489a43, 0x686fe045, 0x1caab675,
+            0x27c2eb32, 0x21f7bd17, 0x6dc4d72f, 0xe36159b1, 0x4e8281f2, 0x506b1808, 0x849be3b7, 0x423e90b2,
+            0xcdea5dc9, 0xffb077f2, 0x4172bac1, 0x9f85478b, 0x25f636c7, 0x62c85104, 0x10d34fbf, 0x89b8712e,
+            0xa8fdd127, 0xa07c7d4e, 0x75d1b3f8, 0xcf3913d8, 0x4d4e2ca9, 0xe3c5abb2, 0x5f4788ae, 0xfe718045,
+            0xb2be76a7, 0x6be2bd16, 0x29d79dbb, 0x46be1b4f, 0xd502dcf3, 0xa5ff0855, 0x776539fa, 0x9a900fe5,
+            0xb839d3a3, 0x661838b1, 0xe31e7453, 0x315dc182, 0xd32533fa, 0xd7ae830d, 0x9aebd233, 0xbcf61ab0,
+            0x5f3fbedc, 0x1c3ac56b, 0x1bea9102, 0x29ccad03, 0x81e3e6cb, 0x1da18d1c, 0x66024ea8, 0xe8bb1f5b,
+            0xf008f33a, 0x95b54cb8, 0x9f2d3083, 0xa23f6118, 0xf5e0aca5, 0x0847f001, 0x971f7ced, 0x3ae09ecc,
+        },
+        {
+            0xf9017d33, 0xbeb8417c, 0xbfa4bee5, 0x6bf26b54, 0x0879c04f, 0x4ffe5e99, 0x6a342de5, 0x97033b64,
+            0x3a244db5, 0xdbaa6e21, 0x42602ce4, 0x1a426605, 0xd06c644a, 0xb8e9fd35, 0xed1ca391, 0xeddd4898,
+            0x13f491e4, 0x39e5e447, 0x9d54f187, 0xa9a28d90, 0x99cf5fa6, 0x33a3ceaf, 0x64e7b4e5, 0xf387b4a6,
+            0xf2d9e3c3, 0xe3add983, 0x28d0f212, 0x379ea6bf, 0xd7d2f425, 0xfc40a255, 0x0c25958b, 0x7d64122c,
+            0x22fb34f2, 0x6ee35c7a, 0x50172964, 0x51c961ed, 0x0e02ae88, 0x3a98dd37, 0x1f99f675, 0x55c046ce,
+            0x317680e2, 0xcbaae57d, 0xb58be121, 0xbb216286, 0x9c84e72e, 0xf6eff486, 0x7efcec90, 0x679a5c50,
+            0xd75d06b2, 0xcbe1f977, 0x7d25844d, 0x2c25f9af, 0x731279e1, 0x86dd5fc6, 0xe389f84f, 0x11c50cde,
+            0x2c6fc30a, 0x060b7f33, 0x7074d645, 0x88b80616, 0x85620ff1, 0x09c61ad2, 0xc00fd7d0, 0x5f5d3924,
+            0xdc549242, 0x596d34b8, 0xe451b96b, 0x188e2239, 0xacc330da, 0x8f5c059b, 0xfa70823f, 0x1697e37f,
+            0xa51a6a44, 0xf279bec1, 0xc9605835, 0x028884a4, 0xbd5b851c, 0x51e2d9ce, 0x994958bd, 0x60ed5005,
+            0xe9dfa618, 0x5cfad0aa, 0xbe5a91ef, 0xe16a475b, 0xfb3f7d19, 0x42ddb914, 0xc2f7ee26, 0x899bde22,
+            0x25c4f3b2, 0xc3883194, 0x9b05d5c0, 0x667682ef, 0xabfa9d07, 0x6057d567, 0xf39d70a1, 0x266319fe,
+        },
+        {
+            0x70490a06, 0x938ff542, 0x475fd575, 0xa18697f3, 0xe16da35f, 0x77228c81, 0x626c5494, 0x8339e650,
+            0xcbda0ddc, 0x8b9d8844, 0x7ce0b2d7, 0xa3914a24, 0xa00e975a, 0x43f4e813, 0x746b48a8, 0xf1cb8e5a,
+            0xd75094de, 0xe4ccfe03, 0x007547e2, 0x3b20b299, 0xfc8acc06, 0x544a20a0, 0x8dfd8724, 0x9627f2c0,
+            0x3c84ade1, 0x6c4ee299, 0xe856f207, 0x2291533e, 0xc717d06b, 0x9a02526f, 0x92a6f35f, 0x180f49bb,
+            0x20f0d8b3, 0xe8d609f3, 0x1c54a1dc, 0x2aa52217, 0x5ede106c, 0xe4bfc4a7, 0x259c631c, 0xff63bb4c,
+            0x1863028f, 0x096153f1, 0x8d32d0fd, 0x01fa90ca, 0x7051e961, 0x4f766b6f, 0x1948158d, 0xafac2ea9,
+            0xebaec7d5, 0xc7e9e74b, 0xf8a99a0a, 0xe7d3fb58, 0x5f0b5c48, 0x6bafbaab, 0xc195faa8, 0x3cab9a42,
+            0x183db14e, 0x4c6e2c50, 0x0fb7f9d8, 0x174c4c06, 0x450912a6, 0xd867cb1d, 0x6abe87a6, 0x7aebd7f7,
+            0xd043eeb2, 0x89a9e48d, 0x173ccefb, 0xede8c3df, 0x4d368b9c, 0x042413b3, 0xc910ee0a, 0x09945d64,
+            0x551edadb, 0xcdeabfd2, 0xca354922, 0xecfa8371, 0xa462b654, 0x1b1ba96a, 0x0dbf93b8, 0x2400dcf4,
+            0xd2e7da0f, 0xe91e2ace, 0xbfb6f7c2, 0x52f4c5ef, 0x927dab47, 0x29c482ca, 0xd21c1015, 0x28a5d2fb,
+            0xeab83196, 0x3038f2e1, 0x5413fbf5, 0x3dcc8155, 0x93fd2ba3, 0x64b1eca6, 0x22ec6c22, 0x194bcc0b,
+        },
+        {
+            0x316d321e, 0xe1cfca4c, 0x64df2b4b, 0x27a0f7c0, 0x672430de, 0x53acbe89, 0xec1da6e6, 0x90217f91,
+            0xfb42454e, 0xba13a957, 0x70637e35, 0x31d672b6, 0x2048f4c5, 0x53c88862, 0x46186b49, 0xb8f9c7c4,
+            0x3492e85a, 0x7800f613, 0x024a676e, 0x27a37cfd, 0xeeb5fc1f, 0xa572a324, 0xc5f3a3b5, 0xeec7bdc2,
+            0x2e976567, 0x1d8a6cfe, 0x89b2ba25, 0xacd6a03a, 0xe3771217, 0x020b9c2e, 0xdd42c0de, 0x784c70a9,
+            0xa4b43b7f, 0x8c2e31bf, 0x8da72950, 0xd539aa73, 0xda56521c, 0x77bed744, 0xbc0def90, 0xfcf2a87c,
+            0x79ef0ccf, 0x2ee6a3b5, 0xc1fe14f1, 0x09e4d3f4, 0x31998ee5, 0x8d50192d, 0x7e686bc2, 0x6e5ce94d,
+            0x9a69e72c, 0xe791847b, 0xdb500235, 0x8723e8bc, 0xdb38cd6c, 0x1a6ea558, 0xc7ede54a, 0x2f5a034d,
+            0x79347687, 0x7e26dd90, 0x4e97e139, 0x747d7c1e, 0x592d5d3e, 0x3a06f792, 0x15b8a642, 0x669b37d5,
+            0x1153a97c, 0xb05176c5, 0x74300ae9, 0xa58bd35b, 0x8210ba10, 0x14b46280, 0xed54a632, 0x2fe5d2f7,
+            0xa99a4647, 0x0595bf1b, 0xf30a6dae, 0xa0e49138, 0x35ed8fa8, 0x878a4f15, 0x44bde298, 0xb40450c4,
+            0x1e87424b, 0x8d96d60a, 0xbe92d6ce, 0x9ec7ddae, 0xdc745864, 0xd0d68df4, 0x1a8c5069, 0xcb3d1eeb,
+            0x9598f7ee, 0xf11cbe69, 0xa463ebc9, 0x34fe86aa, 0xe3f1da30, 0xf7799f40, 0xae9e1cab, 0x7e7afc37,
+        },
+        {
+            0x96e2937b, 0x1e1be659, 0x3a0afaec, 0x83d73437, 0xefd3301c, 0x0382cd51, 0x33fa2ed1, 0xad8f754c,
+            0x3186fefb, 0xdaf295a6, 0x23d5f157, 0x3ac4f142, 0x9d6f0fc1, 0x1f754559, 0x247824de, 0x15c1ef20,
+            0xbfb514a5, 0xcf2f1b30, 0xc3084b65, 0xbdbcbbf8, 0x541a93fe, 0xd722dbb6, 0x65b0c926, 0x6eaeadad,
+            0xd5ec1b3f, 0x11c46ed5, 0x6b2a7312, 0xa394fd40, 0x72544c75, 0x30e4ad8b, 0x2a310de0, 0x819f10b9,
+            0xbac6f73b, 0x3837b0a8, 0xea802012, 0xbb856ace, 0x1f5bc815, 0xade1ef93, 0x007e1025, 0xcc2ca538,
+            0x6fb59dbb, 0x463a2e01, 0x09b35f49, 0x3875a37a, 0x6380acdf, 0xc00a8037, 0x5d935205, 0x3ab3ca25,
+            0x526978b3, 0x1957ac04, 0x88501b4e, 0x8fa3e3f4, 0x7b443b59, 0x1850c567, 0xc7457ca4, 0x5d98b5eb,
+            0x7ef59ea0, 0x29d93a9f, 0xab8135dd, 0x8ad59a1b, 0x62182a4d, 0x89ebcf2f, 0x131f5ed0, 0x46807d3d,
+            0xd138f29e, 0xcefec72e, 0xef99ab4b, 0x4536f718, 0x4fd068b8, 0x56685b14, 0x2be7056e, 0x1a689e7a,
+            0xdffa25e5, 0x479ed957, 0xadb71fd4, 0x6e135619, 0x121fe7bc, 0x54508e11, 0x6be39a7c, 0xd6710d54,
+            0xb659960f, 0x1f7328da, 0xbde5c79a, 0x8b6225cb, 0x3a76a684, 0xdb0984d7, 0xe8295104, 0x8b8f9188,
+            0x85d3ffc5, 0xa097cbfb, 0x39f2e058, 0x5dc8de9b, 0x30695660, 0xf44badc2, 0x352c68f8, 0x2f235af4,
+        },
+        {
+            0xf26ce167, 0x968b7fbf, 0x2236e69c, 0x93340514, 0xaf1ff08e, 0x118e0299, 0x03e2ea15, 0x63cd4a7d,
+            0xf7a2faea, 0x46bcec3e, 0xb32db6b7, 0x25d8b64a, 0x132b4ec6, 0x9d4a5ac0, 0xb658b856, 0x6cc9aba0,
+            0xbe896739, 0x0beb87f3, 0xcf2978fd, 0xb4afabdb, 0xa484e3f9, 0x33ae4a8f, 0xfc73edc2, 0x29696462,
+            0x2d9c883d, 0x58d62a2d, 0x17d43f5a, 0x31e8f242, 0x3ba57e4c, 0xf47763b9, 0xd2f54560, 0x881b539d,
+            0xa5e2d429, 0x1916734b, 0x9480a05b, 0xa99b160a, 0x9ccae86c, 0x6569addf, 0x027650bc, 0xfcdf3a18,
+            0x2e8c14aa, 0x5f22e607, 0x3080dc6e, 0x1a4c3162, 0xf183605c, 0xc0348114, 0xd3e09a1c, 0x2582f2ba,
+            0x9c0f5b80, 0x7eb65c15, 0xa9908886, 0xce3373c6, 0x685528bf, 0x7993db05, 0xe45b6f34, 0xd3fb8d9a,
+            0x7acc1921, 0xd13e251d, 0x59860d51, 0xb62c028a, 0xea78d383, 0xb19b0bec, 0x5f9cda12, 0x60827231,
+            0x161cbd17, 0x0af9e3ea, 0xae00587b, 0x5a12d37c, 0x8f120b99, 0xb009c765, 0xdb831b27, 0x840b1862,
+            0x5fe2bd79, 0x661a3eb7, 0x64939f25, 0x2660ae80, 0x5a9f86ae, 0xa592c655, 0x1b72046d, 0x303542a6,
+            0x8fbfee4f, 0x9d3fcc45, 0xb57ce602, 0xb8eabcfa, 0x24514096, 0x472f9834, 0x88ce9518, 0xb9cdd7ac,
+            0x9d23fedb, 0x22f6fbe9, 0x21be61bb, 0xd4ec5908, 0xf20eafe1, 0xc57a64ca, 0x09de0cdc, 0xebb0c6c5,
+        },
+    },
+    {
+        {
+            0x00000001, 0x00000000, 0x56c52d35, 0xb47d2edf, 0x1f02ef71, 0xbc24a403, 0x8b1a54ce, 0xf71db05f,
+            0x4526b91d, 0x88f6773f, 0x859ea293, 0x441ee8a8, 0xe884dff3, 0xade0d4e7, 0xc137959b, 0x2789fd8c,
+            0x2675f79b, 0x0ed005f9, 0xe52d1194, 0x311c2dd9, 0xb5da9e62, 0xe1736b1f, 0x24f6cc28, 0x540a5173,
+            0x591e1b38, 0x4c68f07a, 0xa2f9f382, 0x75158ea8, 0xa72410f5, 0x13047afb, 0x20e3459b, 0x57aade54,
+            0xfbaf85cc, 0x52cce8f2, 0x75553bd2, 0xea8d71a5, 0x6705faef, 0xea2dd9e7, 0x156a951a, 0xc66ab683,
+            0x6aa7e8e7, 0x21d43409, 0x90b3ad36, 0x4a3aa20f, 0x13f85d70, 0x64d87c5d, 0xe7f179fc, 0x1c6188d3,
+            0xd1c931c4, 0xcd6fa1b9, 0x35e7de83, 0x0e8b93f7, 0xb54367fb, 0x98f3cab1, 0x8f696992, 0x612ad6f8,
+            0xdf7aad44, 0xe39d0ca9, 0x235c5269, 0x7c9aa2dc, 0x02db30a0, 0x96e9c057, 0xe3aa2c65, 0x6725b7c9,
+            0x5e9c40fa, 0x3dff8347, 0x131ba4c2, 0xb6d799ae, 0x83b4e019, 0x5160dbee, 0xa576605a, 0x11c79404,
+            0x0bf94812, 0xf400a349, 0x59c81294, 0x0bb3bd16, 0x9da18139, 0x1b7a4a89, 0x92ae3dba, 0xb01eca92,
+            0x0da0ebc8, 0xcfd4f592, 0x32c5bce4, 0x106ae64c, 0x71cbfb22, 0xaeb5f786, 0xc4ec64dd, 0xfdf44159,
+            0x7598338b, 0xd6fdb1f7, 0x7f23e32e, 0x3b399d74, 0xde973dcb, 0x36f0255d, 0x00000000, 0x00000000,
+        },
+        {
+            0x4a0134dd, 0xf2daaf08, 0xdd93c6cf, 0x7e2f2677, 0xff4156b7, 0xac9f4d3a, 0x6231849c, 0x56da12e9,
+            0x6c2e8113, 0x40ac308b, 0x1faa2313, 0xe678c642, 0x6f4775b0, 0x2d9d4f88, 0x637d1c41, 0xfd7b9f9e,
+            0xeb7fd8e1, 0xd94970c2, 0xd25123af, 0xbd10c8cb, 0x72870903, 0x33e327d7, 0x75cb21d7, 0xac094443,
+            0x493bd3c0, 0x5a724522, 0x4627182b, 0xb43d7ffc, 0xf385d68b, 0x504a33e2, 0xc6b26ed1, 0x086ac0d8,
+            0x4347321f, 0x0b413a9a, 0x2eb0de3f, 0xbddd1593, 0xa2f87eaf, 0xd2d59630, 0x328a455b, 0xeac62ec8,
+            0xb486bb73, 0xa46cbf4a, 0x48e36088, 0x6cb95314, 0xe3e94881, 0x292f4de8, 0xcf9392f6, 0xf22cd24e,
+            0x5412fa33, 0x76f8f6e2, 0xe5f38f88, 0xcd94e75d, 0x3e67f526, 0x2ba9b9ce, 0x139b4d19, 0x400d6051,
+            0xdfc2a98d, 0xd05cdad0, 0x812b62f1, 0x10d6da9a, 0xce22ee5f, 0xc6e46caf, 0x4e84b320, 0x39800efa,
+            0x0ba38c80, 0x6770454b, 0x622ad9b1, 0xe9b99750, 0xfa0b8c32, 0x9493f766, 0xafa07322, 0x39679759,
+            0xbb78fba4, 0x7e38383a, 0x79cae509, 0x3bcce96a, 0x4fd70194, 0x5cfb75f0, 0xdccb2450, 0x01f6580d,
+            0x5c0d5cfc, 0xb0a3cdde, 0x26eb9660, 0x622ff4f9, 0x56e8993f, 0xa6a2f299, 0xa25f75d3, 0xce3173c1,
+            0xd3b31297, 0x0842ea1c, 0xad2919e8, 0xb7bac978, 0xe2f2aab0, 0xd8d643f8, 0x7e985868, 0xbb970eae,
+        },
+        {
+            0x50072eb9, 0xbce2b5d9, 0x22328eb8, 0x00064872, 0xd568ead6, 0xc3ccd372, 0xd26bdb96, 0x6f441204,
+            0x03cd6eb7, 0x417a24ef, 0xb26d592f, 0xaf03cfdc, 0x05901937, 0x589cd176, 0x12d6e967, 0x19b5779f,
+            0x6f6d7393, 0xbc79dc79, 0xdb88e8d2, 0x73aef65d, 0x0b368323, 0x19ec9b4a, 0x7bc57611, 0xf8978566,
+            0x27ca0439, 0xf8295e6f, 0xc8963a83, 0x2d4dec28, 0x734e372e, 0x0848d51d, 0xd23aca91, 0xce960214,
+            0x5894747f, 0xd4625ca6, 0xce8d6eee, 0xb473f18f, 0x338acee6, 0x6dcc849b, 0x284fa661, 0x45ff1f0d,
+            0x81f2c630, 0x7cdc4536, 0x8c114773, 0x4859e2a5, 0x7b9d2fc2, 0x3ef3b1ce, 0xe506833f, 0xfbada4da,
+            0x39b6bfe2, 0x2077e0cf, 0xeda1e730, 0x1ddd4a8b, 0x07682fc2, 0xae8c5b2a, 0x53b074d5, 0xd912de11,
+            0x35e1b6c6, 0x826c457d, 0xe8f8ac33, 0x4c1a819c, 0x20c69e17, 0xeebd7a8c, 0xf0f98b26, 0x3fba0401,
+            0xedf74fbd, 0xf2280114, 0x7da45c3b, 0x0e8143bf, 0x1705174a, 0x33938513, 0xaef58d9a, 0xfbbb3a59,
+            0x171e9cb6, 0x56fcc312, 0x909c8675, 0x817bb38a, 0xd2466007, 0xd003a42e, 0xdae5bf9d, 0xae0559aa,
+            0x300829df, 0xf3a77e7a, 0x41390b93, 0x3d9499eb, 0x525007a3, 0xb37f6741, 0x34f28bf6, 0x6588c520,
+            0xcc7c32b6, 0x1277472b, 0xbbbc41f8, 0x5089513a, 0x91766476, 0xd694ae4a, 0xbf8c8f4e, 0xb30df055,
+        },
+        {
+            0xcd0ca717, 0x8212ecd7, 0x06926caa, 0x034ed717, 0x247465b7, 0x0f4dec9d, 0x01232bb5, 0x03b0f221,
+            0xf7e5d65e, 0x2cdb7f08, 0xf72416ae, 0x8b53740e, 0x62513d1e, 0xe669cc61, 0x846d150c, 0x26a00b70,
+            0xa3eba202, 0x48c66fc3, 0x714eb1d7, 0x9219a35a, 0x6dcf49f3, 0x1d16e5bd, 0x34e2f9a7, 0x779218d4,
+            0xa5bae719, 0x224ad58e, 0x4302c5f4, 0xe27bfd64, 0xbb401445, 0x356f35c3, 0xcbfde708, 0x02fd2030,
+            0x52732f23, 0xc8cc28ee, 0xf5f4df91, 0x80b18a90, 0x9164dd3f, 0x0732088e, 0xf3dbba26, 0x4b7f0e14,
+            0x946c683a, 0xe864effb, 0x9d0c45a8, 0x0bb99d23, 0x3b30dfe4, 0xf137830a, 0x2aee8742, 0x4d55e312,
+            0x56f2d12e, 0xee6543df, 0x72f8d5c5, 0x3cf971d2, 0x773a6dc3, 0xbbcadf8b, 0x812a9a5c, 0x5fa5c2dd,
+            0x43556645, 0x16058fa9, 0xb5290409, 0x7e8c49a8, 0x12e0e16a, 0x2142be12, 0xaaa9f273, 0xd25a1a28,
+            0x2ddd7795, 0xb32fbad7, 0x226f1b9f, 0x3704f6b8, 0x3cb80b93, 0x5fc9fb48, 0x68c8c09e, 0x6ca7a17d,
+            0xad4c14a0, 0x1d4137e3, 0x97e65aca, 0x3dca925f, 0x4e9662bd, 0x8fbf47e5, 0x753f05fb, 0x52810b69,
+            0xec22cdf4, 0xab8f3cbe, 0x7cfbd212, 0x6f5d4098, 0x82b8fdb6, 0x973accd4, 0x44d35d6e, 0xa4115ad9,
+            0x6a4e2393, 0xeafe210c, 0xc2eb3c1f, 0x991793e2, 0xcca7f7f2, 0xb96cc717, 0x632d6616, 0xf2a27711,
+        },
+        {
+            0x0bbdc2d9, 0xfc858507, 0x349ae485, 0x435d506c, 0x987be1bb, 0x795df70a, 0x9ce387fb, 0xc6f793ff,
+            0xd2d33922, 0x6fb1371d, 0xeee5474e, 0xd791495e, 0xaf92a793, 0x97f5d2c1, 0x01dd49d2, 0x8ca57415,
+            0x951048f5, 0xcd728a31, 0xb9681352, 0xca9a70f3, 0xb35b55a4, 0x4bc4f3fa, 0x47759bb2, 0x3f17e566,
+            0xb2668219, 0xc3aeefcc, 0x35443295, 0xa7404a4b, 0x017cd168, 0x87913f1e, 0x0226fe6a, 0x1def34a0,
+            0x47207001, 0x7a41b3a1, 0xad4de1a8, 0xfb58c983, 0x983fbec9, 0x38264f19, 0xca4dd9af, 0x2e2633cc,
+            0xe3067d73, 0x6168fdd1, 0x6d7736c3, 0x7820b6f3, 0xa187fd62, 0xe74395e0, 0x295bd805, 0xd54c0459,
+            0xb0a4a90e, 0xfef44d5d, 0xeb326a69, 0x53c62f74, 0xc21a3b50, 0x8dfb4015, 0xa3a76e80, 0xde35c9e0,
+            0x8fb39fd7, 0x0e93b3f3, 0xc2250522, 0x7f4d3c6d, 0x3adca184, 0x8631882a, 0x90a3fb47, 0xb73a8d9c,
+            0xbf3e2969, 0xe5e3f923, 0xf40a1c2f, 0x5acf5bd1, 0x8951d70f, 0xe6f8be8e, 0xd01e057f, 0x01026260,
+            0x4b431656, 0x17e13283, 0xbe49bb24, 0x5c8fa3bc, 0x5cd9237e, 0xc76351ab, 0x1f89223f, 0x10e7b7cc,
+            0xc1a1b2ee, 0xefa25da8, 0x7a6bf3e4, 0x0fcef3a7, 0x8ea8cc42, 0x8bec1968, 0xdb5a6802, 0x21837312,
+            0x54438cb4, 0x1c8bb4b5, 0x551061f6, 0x4382ec22, 0x75a2030c, 0xdb9c2fc9, 0x71a11f64, 0x5bcde059,
+        },
+        {
+            0x943257d1, 0x6cf12440, 0xca7e588d, 0x61a4df21, 0x328a5298, 0x75c13cc2, 0x72287fe0, 0x178f0b26,
+            0xb5e247ef, 0xefde4f67, 0x75c95c73, 0xf4de4a42, 0xc9df6f30, 0x90acf6a2, 0xd12235cf, 0x07bcd9dd,
+            0x3ffeb9ed, 0x7809dde7, 0x6f69b11a, 0xbd691400, 0x39e50890, 0x5768d9c4, 0xf73afede, 0xd1fc0e75,
+            0xc2560aec, 0x5ba90861, 0x0a8fe8ff, 0x68a5f06c, 0xebf90c07, 0x3555cdd7, 0x319cdff2, 0x5b66bedd,
+            0xd4094720, 0x8fbf97c4, 0x37bc74e2, 0x19198ed9, 0x54fe023c, 0xa8b0b75b, 0x7bd6005a, 0xa298a13c,
+            0x48af8e0d, 0x6a022710, 0x5fc74eff, 0xaf8e3d5a, 0x6516a831, 0x4cf68c53, 0xbadee898, 0x024f4998,
+            0x7b29296c, 0x4c8086be, 0xe720ccc5, 0x72469125, 0x17ca14e6, 0xccb8dac7, 0x29022708, 0x2fccdfee,
+            0x26f99a81, 0xf1aee64f, 0x6497cb02, 0xfa8e9a3d, 0xa88205eb, 0x51820991, 0x7f208221, 0x005eee62,
+            0xf827fa5c, 0xac17c0fc, 0xb8c204d3, 0x70d8dda7, 0xcabfc6da, 0x472cf5bc, 0x442282f9, 0x8fb80e1f,
+            0x41d080f6, 0xad0fd827, 0x88825b94, 0x39b5365d, 0x13f94766, 0xe8ea0f4b, 0x1ef84fdd, 0xad06c241,
+            0xa0d368fa, 0x6e6a7fc8, 0x8e706813, 0xd7489d66, 0x5f5bb474, 0xd8c35d41, 0x1be6766e, 0xa7f89660,
+            0x9f809d7a, 0x5747cb3a, 0x9034d169, 0xfabe5504, 0xef48fba7, 0xdbf831b2, 0x038618c0, 0x0ccaa8a3,
+        },
+        {
+            0x433bd3eb, 0x836ef2a2, 0x1c087a2f, 0x7fc21710, 0x8bf70620, 0x79097b31, 0x24e7c21e, 0xe8bc6db2,
+            0xbcee9fa7, 0x737a9e6d, 0xdc904b78, 0x33fdf186, 0x678b496e, 0x96cc8b98, 0xe3d31ab0, 0xde2beee8,
+            0x63fbf8c2, 0x5d40e4a5, 0xee00b71f, 0xd3ff2ca6, 0x253eda2c, 0x2c12bf59, 0x135ccc10, 0xd7279c62,
+            0xf59f7d23, 0x479516bd, 0x8d00c893, 0x3adfff72, 0x0f12cffd, 0x662ea793, 0x7e963604, 0xb90a9e5e,
+            0x73905690, 0x703985cd, 0xa6a2c429, 0x35581110, 0x081b3780, 0x2eaeeb1e, 0x52c1cafa, 0x4f4abb48,
+            0xf42193b2, 0x4afce404, 0xec4ab8a3, 0x23b700c6, 0xf252beeb, 0x09064857, 0x570bdb08, 0x8ffb9264,
+            0x4a8dcdcd, 0x94e5775f, 0x49fab20b, 0xa1278e53, 0x8e7d6c64, 0xc55c757b, 0x190e469b, 0x8e79a49e,
+            0xdf02ca77, 0x5a0d5c64, 0x0f14d2db, 0xdb479bc6, 0x168ee1fb, 0x694fae6e, 0x01296f5a, 0x4ed4205d,
+            0x9ca107ea, 0x09e4808b, 0x659cf19c, 0xfef9fa77, 0x3936d863, 0xd19c5817, 0x9657b871, 0x0f8a6e70,
+            0xde0c9fac, 0x3b0a30c7, 0xb7be9ba3, 0x5454eebe, 0x7cd894db, 0x11b3886c, 0x559fa366, 0xd965b444,
+            0xedab1c1f, 0x19fb6c3f, 0x0b43878d, 0x1a58fa18, 0x99097605, 0xe29bd8e5, 0x2e8fdedd, 0xa6d8b0d4,
+            0x806abf13, 0x7ee33a63, 0x86b36603, 0x6548a796, 0xd6675742, 0x0126e333, 0x12a05259, 0x296af60c,
+        },
+        {
+            0x6d730831, 0x4e8f7882, 0xbc29e553, 0x73f542ff, 0x09d448aa, 0xe2518ab1, 0xf097832b, 0xcb84cd1a,
+            0x11e8944e, 0x4fe4603a, 0x95d17a9e, 0x0449de45, 0xe7d581b7, 0xa1f354ab, 0x0453a98c, 0xbf02aac2,
+            0x579aa503, 0x1853be9b, 0x01a713a1, 0xbdf45ecf, 0x488e36aa, 0xa77d6f8d, 0x4ccbdac9, 0x49323847,
+            0x5365215a, 0x64336c81, 0x4792abc2, 0x41fcb21f, 0x52b12c75, 0x3c24b232, 0xf2af34b9, 0x5e148404,
+            0x8e476dfe, 0xb6fac8ad, 0xc7488366, 0xfb364e37, 0x8304b7fe, 0x926c0bbe, 0x94222f0d, 0xc5ea1b73,
+            0x76e44d0f, 0xda9fe6aa, 0x52c03e11, 0x6bb4a457, 0xec52f513, 0xe131d291, 0xdd42ba6e, 0x5d669599,
+            0x2513d7e5, 0x4b6cc4e5, 0x89a79141, 0xe9136052, 0x33ccf90a, 0x7d4bbc11, 0xa1b1e2c8, 0xd6696f34,
+            0x22e1d196, 0x2dffcc4a, 0xaa16daf6, 0x407b7141, 0x0d96da8d, 0xcfe458c7, 0xbd3e0d7f, 0x0f4bd31e,
+            0x9ee578fb, 0xe2c8213c, 0x1b32ec2a, 0xeab4f92c, 0x3533807a, 0xb7f99cff, 0x22ef01b1, 0x3a92d706,
+            0x64783442, 0x8e149d18, 0x73c854d5, 0xc6d76781, 0x57716aca, 0x88e81c4f, 0x6047b8d5, 0x40ffe1fe,
+            0x37a5a845, 0x09d63a5c, 0x85d07066, 0x0bd58e49, 0xbc26f012, 0x60a33d78, 0xa7a3ea69, 0xd26a08aa,
+            0x52a2e585, 0xac200648, 0x582d2c1b, 0xe9cc8af1, 0xf0be803a, 0xd5361299, 0x634a49a0, 0x20fc3c17,
+        },
+        {
+            0x077a9c4f, 0xa1ad30da, 0x6b0cc8fa, 0x4ad46018, 0x4cc2fd1d, 0xd0edcad9, 0x5e2bd348, 0x1a0b15fa,
+            0xa85c3d81, 0x3a287445, 0xc3c7a611, 0x73365fc1, 0xe4ade349, 0xd398bb4f, 0xcf2825f9, 0x5ed4f96a,
+            0xa16d6d42, 0xcb177ac7, 0x860e1b4a, 0xf0a4800a, 0xa264fbd2, 0x4fee50a6, 0x3fe12be2, 0xf02a4e37,
+            0x498d4cbf, 0x7ecee7d2, 0x86b45d30, 0x542655fe, 0x26de12d6, 0x48f8026c, 0xda90a818, 0x6dead549,
+            0x0b45375d, 0x2c51971b, 0xc08fef86, 0xb96e063e, 0xc5bc953c, 0xfbba222c, 0xfd58506e, 0xe1c40d0a,
+            0xd2283c1e, 0x548446b2, 0xf6aad0d0, 0x26c82271, 0xb8dcdaf8, 0x77e2e955, 0x0b6010dd, 0xa5796fa2,
+            0x43c7778e, 0xb9763f54, 0x6f3680c2, 0xdff619a3, 0x998fd1fa, 0x7455904e, 0x1fb75dba, 0x8018bfa0,
+            0xa903bdef, 0x86aa6e8e, 0xce61a7eb, 0x3cc8d5a9, 0x5a6e2c76, 0x322c0029, 0xc0c15fd2, 0x75f4a83b,
+            0x91c4309d, 0x6f5292e0, 0x1f94382a, 0x124d6b84, 0x87cd725e, 0xc6570651, 0x69e0d0d7, 0xb107b0eb,
+            0x2481535d, 0xc7fa34d0, 0x82ad14d3, 0xfee61181, 0xce13b6e9, 0xdd1e6227, 0xaccfb457, 0x9a0b6273,
+            0x5899fb30, 0xeb3286b3, 0x1a152697, 0xfac72fcc, 0xd7c2004b, 0x95d3ca53, 0x230f998a, 0x7b84dfb2,
+            0x9102370f, 0xf8e673e1, 0x0aeadbe6, 0xbca616d0, 0x69b19bc7, 0x05429e66, 0x4ce83d73, 0xa5f61548,
+        },
+        {
+            0xf32efe02, 0xdab02ddd, 0xc653d738, 0x1d1a34bd, 0x0ff5ba1e, 0xb9c00047, 0xb19ad1c8, 0x2258b501,
+            0x6b00ddf6, 0x9d5a24e2, 0x849ed98e, 0xc8f0db7b, 0xbddc21a7, 0xb1d54fa2, 0x24fddd85, 0x73ca04eb,
+            0xde08ab60, 0x5e958230, 0x35153951, 0x91621672, 0x8452b3ac, 0x69f8a1bb, 0xf0a8aa8b, 0x7db99fd3,
+            0x291fbd62, 0x507700e7, 0x5e5d4f22, 0xd02818e3, 0x733015dd, 0xf6a12d50, 0x289119cd, 0xe428987e,
+            0xbbaf7103, 0x6c282a32, 0xf9886194, 0xacb25774, 0x8158e6c4, 0x90f13d41, 0x7f52e4ed, 0x7017c7f3,
+            0x457507c9, 0xfb7747a7, 0xd067dcb1, 0x653bf870, 0x239c624b, 0xe371d03b, 0x72bd546f, 0xec07c8d9,
+            0x67ca7226, 0xa2c7dfcf, 0x70a818df, 0x206c11ea, 0xdcc92404, 0xb2058bf6, 0x7fa2091a, 0x87cdb5d3,
+            0xf9f5e15a, 0xc4717467, 0xf30bb0e9, 0x979c692c, 0x23d9d42d, 0x0b1fd356, 0x7a2a7ecb, 0xb97ce992,
+            0x92634a24, 0xaec72dfc, 0xab9a1287, 0x46a92e86, 0x6d4b0247, 0x32159065, 0x64cf8c72, 0x8d41c0fd,
+            0xa818cfee, 0xb122b7a3, 0x7492c6a5, 0x742f366b, 0x0deee19c, 0x60021a31, 0xec21ab56, 0xc83cf1a5,
+            0x717ca2f5, 0x58a5fe01, 0x09359d7f, 0x668e2aa7, 0xcb6b94bb, 0x236d2ac7, 0x5e38c3dd, 0x0351fb3f,
+            0x0c04740d, 0x83a7b2e5, 0x96213684, 0x566a5e67, 0x604149e4, 0x301aa1d0, 0xaa8192af, 0x0edb65ec,
+        },
+        {
+            0xa5e5f5ba, 0x31c7f5b9, 0x7e56e782, 0xfc5bc6cc, 0x485d3c8c, 0x5a9fd446, 0xc647f8b0, 0x663d6943,
+            0x5a474773, 0x83006c8e, 0x87f9ef2f, 0x76428109, 0x40331529, 0x3ec55465, 0x1c3022bf, 0xac99bc1c,
+            0xd97a4c2f, 0x1406c1e1, 0xd1338006, 0xce94e2c6, 0x0fc9d33e, 0xf1bd3898, 0x3e890f7f, 0x65292159,
+            0x2cd26a3d, 0x7ee8e65a, 0x92f17290, 0xf3ab7839, 0x78e41fad, 0xb9500d69, 0xadb77740, 0x74e94051,
+            0x6c1f3c2e, 0x80b5d467, 0x0de9689e, 0x48f361d6, 0x6264b556, 0x28660c3c, 0xa6f5f61e, 0x6b1652ff,
+            0x585596c5, 0x43ef49a8, 0xe4326ef5, 0x5009e93b, 0xfe4b1438, 0xc1b1a7fa, 0x6c548e73, 0x483e6447,
+            0x8e14d939, 0x8c4c41ff, 0xbe3c4c17, 0xa1c25dc1, 0x1503bdf1, 0x8ffdb704, 0xb7ba3bd7, 0x8aa7e6a5,
+            0x6ca04b9e, 0x4873fb96, 0xb754b939, 0x975ff485, 0xa107fc4d, 0x70139ba1, 0x8b86758d, 0xdc3d08db,
+            0x95743f3c, 0xf614afd9, 0x34c0cd84, 0x7139c6c9, 0xc58dceb6, 0x8ba318cc, 0x68191a63, 0x1ef472bd,
+            0xd8a87cb6, 0xbb2a0443, 0x0fdc4942, 0x96b7ab64, 0xa912b8bd, 0xd897e59f, 0x6737616a, 0xfea69dd7,
+            0x9b14d6a4, 0xd617f0c6, 0x5a4ecc5e, 0x4980eac7, 0xdabf89a1, 0x82253e90, 0xb9a50c95, 0xc6ddf8e5,
+            0x181cc852, 0xf01c724f, 0x12020730, 0xbe50203c, 0xbf464e37, 0x7f9e4368, 0x067eb4e3, 0x9adb9602,
+        },
+        {
+            0x233bed3b, 0xef6f24b2, 0xd1d83e27, 0x50978793, 0xdddf721f, 0x3b6361b5, 0x2f988cb9, 0x0a58f87b,
+            0x049733ae, 0xffb13cb3, 0xfa807f9d, 0x695ea63f, 0x501044ad, 0x5cf7fb85, 0xf2cc70c5, 0xf135daac,
+            0xbc8edd8e, 0x6edbcb97, 0x67188a62, 0xb1f968cd, 0x2fe4f3f4, 0xceb15fc5, 0xc229f208, 0x3a0e2eab,
+            0x5cdec744, 0xfe04e8d6, 0xfb841c86, 0xee6f515b, 0xe27d27b4, 0x8f71f307, 0xd046be4f, 0xcbf0d797,
+            0xf793167f, 0xaa1d3899, 0xb7d2b0f7, 0x7bed87a1, 0xb257ff9e, 0x6c6397b7, 0xa13fef58, 0x03542ff7,
+            0x62e281ca, 0x55e3577e, 0x580df093, 0x0d09f3e8, 0x64f0b91b, 0xc5cc1390, 0x05deb338, 0x378b3182,
+            0xf9bc3295, 0x25e84fe5, 0xeeeeff09, 0xb309cb40, 0x73913dde, 0x3eee16a6, 0xc0127e47, 0x254f52b1,
+            0x6ed04a48, 0x2342f18e, 0x1206276c, 0xca881b38, 0x806325d6, 0xc03151fa, 0x33be7103, 0xf7678941,
+            0x6038d049, 0xa944c4f9, 0xa9e96c6f, 0x70c35808, 0x5b220413, 0xb5489181, 0x1ed54a1a, 0x07ab66fc,
+            0x70c260f9, 0xa3538b6e, 0x12c5cc7b, 0x650865a4, 0xbf7d344a, 0xfb3e15dc, 0xefd9131c, 0x62d66772,
+            0x1422bff0, 0x73087e8c, 0x52f3dcb2, 0xf9c6e60a, 0xf03b4ee3, 0x99e9fc43, 0x13f55bab, 0x5bb102d3,
+            0xd5d376b6, 0x6622dd2a, 0x9e759dba, 0x15fa7026, 0x10d3c4a5, 0x7c9c6136, 0x0bc974b5, 0xdf8653db,
+        },
+        {
+            0x39c79131, 0xe4a851c7, 0x82653f62, 0xacdd3532, 0x06259162, 0x1c548c7e, 0xd53be8bb, 0xe3c103d4,
+            0x4a32a200, 0xb584e55c, 0x5c743d12, 0x51278454, 0x11a547b7, 0x8bda9e11, 0x1e233cab, 0x0c6046cd,
+            0x58916759, 0x8722d276, 0x15c19397, 0xef6a355b, 0x046b2382, 0x4dfff46f, 0x582e8e56, 0x72c795e6,
+            0x779c341a, 0x70a81f92, 0xc4b1b42f, 0x6fd940f8, 0x46f5ec3b, 0x7fb61745, 0x48880bec, 0x9651aa4d,
+            0xbb914578, 0xe0d7431b, 0xf3b9c807, 0xe602cd33, 0x7157f25e, 0xfd0be955, 0xdf2d25cf, 0xfd6c5236,
+            0x20b6737d, 0x27b793bd, 0x85ca3b14, 0xf6047bba, 0x95dbf0e7, 0x4eb36dc3, 0x073dfcc2, 0x7f07902f,
+            0xac4d68cf, 0xc1aa4770, 0x5f43827e, 0xedc0c50a, 0xe08f9fe4, 0x768ab3df, 0x9ebd93b1, 0x02a4e60c,
+            0x2430fcc0, 0x2f994314, 0x19f29c8f, 0x479fc365, 0xf58440ab, 0x10360ba1, 0xa50b3057, 0x4d3145a5,
+            0x397228d7, 0x8bea7fb3, 0xb51ee6c6, 0x5bd98bac, 0x8938fb9f, 0x4aac6431, 0x4282cae6, 0xa2f60f17,
+            0x26f37034, 0x3ddf9b69, 0x0e571931, 0x57e4b6db, 0x90114bc6, 0x0e4a2229, 0x0a96a997, 0x7660fedf,
+            0x2dfc3bff, 0x8c12831a, 0xdd7387fe, 0xf4f36aed, 0xdfdde2e6, 0x26db725a, 0x9df4155a, 0x2811410a,
+            0xb08c2afb, 0x8ab98c1a, 0x5873368f, 0x09035128, 0x8d49477f, 0xc8e2620e, 0x93f7fe68, 0xbbadc6cd,
+        },
+        {
+            0x2d15a2f4, 0xec265c41, 0xf834eb8e, 0x928aae9d, 0xf48fdddd, 0x3ee861fd, 0x1c38f964, 0x1e837cc9,
+            0x34428675, 0x8e4baf97, 0x56740555, 0xa581014b, 0xbd2d6a07, 0x3acf22ae, 0x6653c217, 0xdbfacc6e,
+            0x33e50b34, 0xcf5a3a5a, 0x43b8bcd2, 0x4638ff9b, 0x7de4ce8f, 0xf3a8d3dc, 0xdbf973db, 0x048a45a8,
+            0x079fbb0e, 0x92e2eed6, 0xa0c86f08, 0x58f1e5a4, 0x02d38178, 0x4fdbb43e, 0xca9f4845, 0x27ac51b7,
+            0x2e1217d5, 0x28dd0eda, 0x9874da7f, 0x7d7fbc86, 0x97a135ef, 0x8f0f16fa, 0x6f9527a0, 0x5f3006f0,
+            0x0b833ce5, 0x9817ea8b, 0x62723d3b, 0xee1c19d3, 0x370afd79, 0x3e7e59dd, 0x7082bd62, 0x4eaefff9,
+            0xee4f6191, 0x6dba6d8f, 0x13c1b2ff, 0xef44ad8f, 0x478c86de, 0x2afd7bfa, 0xff0e6482, 0xb2e98c88,
+            0x9507332c, 0xd0eeaeda, 0xe52105e2, 0xb839b3cc, 0x71accec1, 0x271084fe, 0xd215bc0d, 0x11c6d9bd,
+            0xc07dcd59, 0xd98fe336, 0xfc281bcc, 0x94167f9a, 0x4047ac76, 0xb44c0994, 0x92efc36a, 0x6cc5e2d8,
+            0xa5a4c1b4, 0x6c308367, 0x6e0d4586, 0xdc4bef15, 0x6b5aecbd, 0xf6e8c6f9, 0xb733b797, 0xe0d9d3af,
+            0x5327bc35, 0xda2c6775, 0x9bed4ab0, 0xbf4669f5, 0x998ab295, 0xe3021682, 0x1626b9d1, 0xfd27032d,
+            0x9192ffc0, 0x559429e5, 0x5a8d596c, 0x269aa99c, 0xb127a7c5, 0xead73647, 0x97974958, 0xbb3cbe33,
+        },
+        {
+            0xc7972352, 0xcaa36f55, 0x8bcf7499, 0xa398ab4d, 0x81db80c8, 0x3f5b1c20, 0x4d10f0d2, 0x694ccefa,
+            0x74f4d115, 0x3d19b977, 0xd2eaf377, 0xac61b248, 0xcd1c5b37, 0x4e204b0b, 0x7bc2a787, 0xc83adf93,
+            0x8bf656c3, 0x51a7c202, 0x5ca1750d, 0x603d8935, 0x0a189fc3, 0x627c1ba4, 0x1b6f49e9, 0x24fabea0,
+            0x3f138513, 0x79c4e909, 0xca50bb2a, 0x5d412873, 0x48f6521a, 0xf18715e6, 0x0f6840e6, 0x38692628,
+            0x9eb0978b, 0x4c80490a, 0x01908146, 0x2f90b3a1, 0x755e3848, 0xbc75937f, 0x631c4fd7, 0xa9a4e629,
+            0x1a847ec7, 0xb9f41337, 0xfa14bece, 0xc06a42e0, 0x9196ef3f, 0x7329bb42, 0x2260190e, 0xb507e80e,
+            0x098d00f5, 0x4b4ce51c, 0xe9d67003, 0x5c913227, 0x86f37dfe, 0x21e9f334, 0x5d1f23c6, 0x167fe90f,
+            0x0d7f83c1, 0x2dee7f96, 0xcfc44b00, 0x66da230e, 0x494ac1ec, 0x075c982d, 0xc52c1018, 0xa28d4a8d,
+            0x3d5bfb20, 0xa50a3281, 0x9f74e505, 0xe05dd3c7, 0xf5b8cb44, 0x898e2b76, 0xbb995d50, 0x7f897d66,
+            0xa6f4b1e9, 0xacf191ca, 0x91dcf455, 0x343b208b, 0x2b4fc673, 0x1b948727, 0xf5cc65cf, 0x0fe624d4,
+            0xe53f16ad, 0x80532e01, 0x6d58dca8, 0x5b70fb34, 0x46ab3b5a, 0xc54c83f3, 0xd09b200d, 0x189ad9d7,
+            0xfe2a01d8, 0x24a0ee49, 0x9878bafd, 0x4714b761, 0x5b386dce, 0xa806e86f, 0xa2ba674c, 0x8741af23,
+        },
+        {
+            0xa816da99, 0x959ff47c, 0x1fd18f6e, 0xd14501f0, 0x47676668, 0x5acde2ec, 0x9278d406, 0x5ddd661e,
+            0xa0d1f8dc, 0x737cb60d, 0x1dbbb979, 0x90a79fe3, 0x276a1786, 0x70954707, 0x3490107b, 0xd22a9156,
+            0x5891a7aa, 0x7c674d18, 0x6601f37c, 0x23a7c067, 0xeae173a0, 0x588135d2, 0x1387a35c, 0xf1d39c48,
+            0xcefcffe6, 0x90435f4e, 0x149af7a1, 0x868a6f75, 0xaeacca32, 0x5ee8eaec, 0x15b1006b, 0xecd1681e,
+            0x3e6da693, 0x948216b6, 0x1270cb44, 0x62b27437, 0xb7b7f131, 0xe62c7118, 0x6e4e8c79, 0x49c0870a,
+            0x41d8647f, 0x638f5f73, 0xb47ad48d, 0x5f683775, 0xb4e3925d, 0xea5708f7, 0x16fd1ea3, 0x9c1f4e61,
+            0x5c077573, 0x197b5b28, 0x058cb3a8, 0x25636411, 0x108c5f15, 0x3e9a68bb, 0xb84680f2, 0x2ee58733,
+            0x8d4fd057, 0x38cfd3ee, 0xbd7f550f, 0xe3b1d8b0, 0xc2e130ad, 0x1aee498a, 0x6c5c700f, 0xefe34bce,
+            0xfee80f1b, 0x649fa935, 0x7118403d, 0x2f2e85ae, 0x5c5f9582, 0x122533de, 0x32041aba, 0x8977e50d,
+            0xdec94d7f, 0x1dac533e, 0x4c52c1e5, 0x1f89dfb5, 0x6520b765, 0x3a770a0e, 0x94611dbe, 0x0e776be9,
+            0x09052878, 0x397bfeda, 0xa7c8a689, 0xe05485bb, 0xf81fc50f, 0x6d7928d9, 0x3d398bd3, 0x9798d9d9,
+            0xdf413871, 0xf2cf2adc, 0x3f84beb9, 0xa24bb6dd, 0x22c64f0a, 0x33fbd6e6, 0x8545df4c, 0x7e5c0df9,
+        },
+    },
+};
+
+#endif /* CONFIG_ESP_PROTOCOMM_SRP_FIXED_BASE_TABLE */
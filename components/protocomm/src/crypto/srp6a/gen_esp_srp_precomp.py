@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+# Generates esp_srp_precomp.h: the SRP6a multiplier k and the fixed-base comb
+# tables for g^b of the 3072-bit group (RFC 5054, Appendix A).
+#
+# Usage: python gen_esp_srp_precomp.py > esp_srp_precomp.h
+import hashlib
+
+N_HEX = (
+    'FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129024E088A67CC74'
+    '020BBEA63B139B22514A08798E3404DDEF9519B3CD3A431B302B0A6DF25F1437'
+    '4FE1356D6D51C245E485B576625E7EC6F44C42E9A637ED6B0BFF5CB6F406B7ED'
+    'EE386BFB5A899FA5AE9F24117C4B1FE649286651ECE45B3DC2007CB8A163BF05'
+    '98DA48361C55D39A69163FA8FD24CF5F83655D23DCA3AD961C62F356208552BB'
+    '9ED529077096966D670C354E4ABC9804F1746C08CA18217C32905E462E36CE3B'
+    'E39E772C180E86039B2783A2EC07A28FB5C55DF06F4C52C9DE2BCBF695581718'
+    '3995497CEA956AE515D2261898FA051015728E5A8AAAC42DAD33170D04507A33'
+    'A85521ABDF1CBA64ECFB850458DBEF0A8AEA71575D060C7DB3970F85A6E1E4C7'
+    'ABF5AE8CDB0933D71E8C94E04A25619DCEE3D2261AD2EE6BF12FFA06D98A0864'
+    'D87602733EC86A64521F2B18177B200CBBE117577A615D6C770988C0BAD946E2'
+    '08E24FA074E5AB3143DB5BFCE0FD108E4B82D120A93AD2CAFFFFFFFFFFFFFFFF'
+)
+G = 5
+N_BITS = 3072
+WORD_BITS = 32
+N_WORDS = N_BITS // WORD_BITS
+
+# Comb layout for 256-bit exponents: 4 rows of 64 bits, each row split in 2 blocks of 32 bits
+EXP_BITS = 256
+COMB_ROWS = 4
+COMB_BLOCKS = 2
+COMB_COLS = EXP_BITS // (COMB_ROWS * COMB_BLOCKS)
+
+
+def words(value: int) -> list:
+    return [(value >> (WORD_BITS * i)) & 0xFFFFFFFF for i in range(N_WORDS)]
+
+
+def c_words(value: int, indent: str) -> str:
+    w = words(value)
+    lines = []
+    for i in range(0, len(w), 8):
+        lines.append(indent + ' '.join('0x%08x,' % x for x in w[i:i + 8]))
+    return '\n'.join(lines)
+
+
+def main() -> None:
+    n = int(N_HEX, 16)
+    assert n.bit_length() == N_BITS
+    len_n = N_BITS // 8
+    r = 1 << N_BITS
+
+    # k = H(N | PAD(g)), see RFC 5054, Section 2.5.3
+    k = hashlib.sha512(n.to_bytes(len_n, 'big') + G.to_bytes(len_n, 'big')).digest()
+
+    # Montgomery constant, N is odd
+    n0 = (-pow(n, -1, 1 << WORD_BITS)) % (1 << WORD_BITS)
+
+    print('/*')
+    print(' * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD')
+    print(' *')
+    print(' * SPDX-License-Identifier: Apache-2.0')
+    print(' */')
+    print('')
+    print('/* Generated by gen_esp_srp_precomp.py, do not edit */')
+    print('')
+    print('#pragma once')
+    print('')
+    print('#include <stdint.h>')
+    print('#include "sdkconfig.h"')
+    print('')
+    print('/* k = H(N | PAD(g)) for the 3072-bit group */')
+    print('static const char k_3072[] = {')
+    for i in range(0, len(k), 16):
+        print('    ' + ' '.join('0x%02X,' % b for b in k[i:i + 16]))
+    print('};')
+    print('')
+    print('#define SRP_3072_WORDS          %d' % N_WORDS)
+    print('#define SRP_3072_N0             0x%08xU' % n0)
+    print('#define SRP_COMB_EXP_BITS       %d' % EXP_BITS)
+    print('#define SRP_COMB_ROWS           %d' % COMB_ROWS)
+    print('#define SRP_COMB_BLOCKS         %d' % COMB_BLOCKS)
+    print('#define SRP_COMB_COLS           %d' % COMB_COLS)
+    print('')
+    print('#if CONFIG_ESP_PROTOCOMM_SRP_FIXED_BASE_TABLE')
+    print('')
+    print('/* N, least significant word first */')
+    print('static const uint32_t n_3072_words[SRP_3072_WORDS] = {')
+    print(c_words(n, '    '))
+    print('};')
+    print('')
+    print('/* R mod N, the Montgomery form of 1 */')
+    print('static const uint32_t one_3072_mont[SRP_3072_WORDS] = {')
+    print(c_words(r % n, '    '))
+    print('};')
+    print('')
+    print('/*')
+    print(' * g_3072_comb[t][mask] = prod(g^(2^(64 * j + 32 * t)) for each bit j set in mask) * R mod N')
+    print(' */')
+    print('static const uint32_t g_3072_comb[SRP_COMB_BLOCKS][1 << SRP_COMB_ROWS][SRP_3072_WORDS] = {')
+    row_bits = EXP_BITS // COMB_ROWS
+    for t in range(COMB_BLOCKS):
+        print('    {')
+        for mask in range(1 << COMB_ROWS):
+            e = sum(1 << (row_bits * j + COMB_COLS * t) for j in range(COMB_ROWS) if mask & (1 << j))
+            print('        {')
+            print(c_words(pow(G, e, n) * r % n, '            '))
+            print('        },')
+        print('    },')
+    print('};')
+    print('')
+    print('#endif /* CONFIG_ESP_PROTOCOMM_SRP_FIXED_BASE_TABLE */')
+
+
+if __name__ == '__main__':
+    main()
@@ -34,11 +34,18 @@
 #include <mbedtls/ctr_drbg.h>
 #include <mbedtls/ecdh.h>
 #include <mbedtls/error.h>
+#include <mbedtls/bignum.h>
+#include <mbedtls/sha512.h>
 
 #include <protocomm.h>
 #include <protocomm_security.h>
 #include <protocomm_security0.h>
 #include <protocomm_security1.h>
+#ifdef CONFIG_ESP_PROTOCOMM_SUPPORT_SECURITY_VERSION_2
+#include <esp_srp.h>
+#endif
+#include <esp_random.h>
+#include <esp_timer.h>
 #include "test_utils.h"
 
 #include "session.pb-c.h"
@@ -1191,6 +1198,155 @@ TEST_CASE("security 1 weak session test", "[PROTOCOMM]")
     TEST_ASSERT(test_security1_weak_session() == ESP_OK);
 }
 
+#ifdef CONFIG_ESP_PROTOCOMM_SUPPORT_SECURITY_VERSION_2
+
+#define SRP_TEST_ROUNDS     4
+#define SRP_TEST_LEN_N      384
+#define SRP_TEST_SALT_LEN   16
+
+/* RFC 5054, Appendix A, 3072-bit group, g = 5 */
+static const char *srp_test_n_hex =
+    "FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129024E088A67CC74"
+    "020BBEA63B139B22514A08798E3404DDEF9519B3CD3A431B302B0A6DF25F1437"
+    "4FE1356D6D51C245E485B576625E7EC6F44C42E9A637ED6B0BFF5CB6F406B7ED"
+    "EE386BFB5A899FA5AE9F24117C4B1FE649286651ECE45B3DC2007CB8A163BF05"
+    "98DA48361C55D39A69163FA8FD24CF5F83655D23DCA3AD961C62F356208552BB"
+    "9ED529077096966D670C354E4ABC9804F1746C08CA18217C32905E462E36CE3B"
+    "E39E772C180E86039B2783A2EC07A28FB5C55DF06F4C52C9DE2BCBF695581718"
+    "3995497CEA956AE515D2261898FA051015728E5A8AAAC42DAD33170D04507A33"
+    "A85521ABDF1CBA64ECFB850458DBEF0A8AEA71575D060C7DB3970F85A6E1E4C7"
+    "ABF5AE8CDB0933D71E8C94E04A25619DCEE3D2261AD2EE6BF12FFA06D98A0864"
+    "D87602733EC86A64521F2B18177B200CBBE117577A615D6C770988C0BAD946E2"
+    "08E24FA074E5AB3143DB5BFCE0FD108E4B82D120A93AD2CAFFFFFFFFFFFFFFFF";
+
+static int srp_test_rng(void *ctx, unsigned char *buf, size_t len)
+{
+    esp_fill_random(buf, len);
+    return 0;
+}
+
+/* H(PAD(a) | PAD(b)) as an mpi, a and b are padded to the length of N */
+static void srp_test_padded_hash(mbedtls_mpi *out, const mbedtls_mpi *a, const mbedtls_mpi *b)
+{
+    unsigned char *buf = malloc(2 * SRP_TEST_LEN_N);
+    unsigned char digest[64];
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL(0, mbedtls_mpi_write_binary(a, buf, SRP_TEST_LEN_N));
+    TEST_ASSERT_EQUAL(0, mbedtls_mpi_write_binary(b, buf + SRP_TEST_LEN_N, SRP_TEST_LEN_N));
+    TEST_ASSERT_EQUAL(0, mbedtls_sha512(buf, 2 * SRP_TEST_LEN_N, digest, 0));
+    TEST_ASSERT_EQUAL(0, mbedtls_mpi_read_binary(out, digest, sizeof(digest)));
+    free(buf);
+}
+
+/* x = H(salt | H(username | ":" | password)) */
+static void srp_test_calculate_x(mbedtls_mpi *x, const char *salt, int salt_len, const char *username, const char *pass)
+{
+    unsigned char digest[64];
+    mbedtls_sha512_context ctx;
+
+    mbedtls_sha512_init(&ctx);
+    mbedtls_sha512_starts(&ctx, 0);
+    mbedtls_sha512_update(&ctx, (const unsigned char *)username, strlen(username));
+    mbedtls_sha512_update(&ctx, (const unsigned char *)":", 1);
+    mbedtls_sha512_update(&ctx, (const unsigned char *)pass, strlen(pass));
+    mbedtls_sha512_finish(&ctx, digest);
+
+    mbedtls_sha512_starts(&ctx, 0);
+    mbedtls_sha512_update(&ctx, (const unsigned char *)salt, salt_len);
+    mbedtls_sha512_update(&ctx, digest, sizeof(digest));
+    mbedtls_sha512_finish(&ctx, digest);
+    mbedtls_sha512_free(&ctx);
+
+    TEST_ASSERT_EQUAL(0, mbedtls_mpi_read_binary(x, digest, sizeof(digest)));
+}
+
+/* Runs the server side of SRP6a against a client computed here with plain
+ * mbedtls bignum operations, and reports the time spent by the server for
+ * B and for the session key.
+ */
+TEST_CASE("security 2 srp session key test", "[PROTOCOMM]")
+{
+    const char *username = "wifiprov";
+    const char *pass = "abcd1234";
+    char *salt = NULL, *verifier = NULL;
+    int verifier_len = 0;
+    int64_t pubkey_us = 0, session_key_us = 0;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_srp_gen_salt_verifier(username, strlen(username), pass, strlen(pass),
+                                                        &salt, SRP_TEST_SALT_LEN, &verifier, &verifier_len));
+
+    mbedtls_mpi N, g, k, a, A, B, u, x, t, S;
+    mbedtls_mpi *mpis[] = { &N, &g, &k, &a, &A, &B, &u, &x, &t, &S };
+    for (size_t i = 0; i < sizeof(mpis) / sizeof(mpis[0]); i++) {
+        mbedtls_mpi_init(mpis[i]);
+    }
+    TEST_ASSERT_EQUAL(0, mbedtls_mpi_read_string(&N, 16, srp_test_n_hex));
+    TEST_ASSERT_EQUAL(0, mbedtls_mpi_lset(&g, 5));
+    srp_test_padded_hash(&k, &N, &g);
+    srp_test_calculate_x(&x, salt, SRP_TEST_SALT_LEN, username, pass);
+
+    unsigned char *bytes_A = malloc(SRP_TEST_LEN_N);
+    unsigned char *bytes_S = malloc(SRP_TEST_LEN_N);
+    TEST_ASSERT_NOT_NULL(bytes_A);
+    TEST_ASSERT_NOT_NULL(bytes_S);
+
+    for (int round = 0; round < SRP_TEST_ROUNDS; round++) {
+        char *bytes_B = NULL, *key = NULL;
+        int len_B = 0;
+        uint16_t len_key = 0;
+        unsigned char client_key[64];
+
+        /* Client: A = g^a */
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_fill_random(&a, 32, srp_test_rng, NULL));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_exp_mod(&A, &g, &a, &N, NULL));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_write_binary(&A, bytes_A, SRP_TEST_LEN_N));
+
+        esp_srp_handle_t *hd = esp_srp_init(ESP_NG_3072);
+        TEST_ASSERT_NOT_NULL(hd);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_srp_set_salt_verifier(hd, salt, SRP_TEST_SALT_LEN, verifier, verifier_len));
+
+        int64_t start = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(ESP_OK, esp_srp_srv_pubkey_from_salt_verifier(hd, &bytes_B, &len_B));
+        pubkey_us += esp_timer_get_time() - start;
+
+        start = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(ESP_OK, esp_srp_get_session_key(hd, (char *)bytes_A, SRP_TEST_LEN_N, &key, &len_key));
+        session_key_us += esp_timer_get_time() - start;
+        TEST_ASSERT_EQUAL(sizeof(client_key), len_key);
+
+        /* Client: S = (B - k * g^x)^(a + u * x), K = H(S) */
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_read_binary(&B, (unsigned char *)bytes_B, len_B));
+        TEST_ASSERT_LESS_THAN(0, mbedtls_mpi_cmp_mpi(&B, &N));
+        srp_test_padded_hash(&u, &A, &B);
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_exp_mod(&t, &g, &x, &N, NULL));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_mul_mpi(&t, &t, &k));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_sub_mpi(&S, &B, &t));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_mod_mpi(&S, &S, &N));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_mul_mpi(&t, &u, &x));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_add_mpi(&t, &t, &a));
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_exp_mod(&S, &S, &t, &N, NULL));
+        size_t len_S = mbedtls_mpi_size(&S);
+        TEST_ASSERT_EQUAL(0, mbedtls_mpi_write_binary(&S, bytes_S, len_S));
+        TEST_ASSERT_EQUAL(0, mbedtls_sha512(bytes_S, len_S, client_key, 0));
+
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(client_key, key, sizeof(client_key));
+        esp_srp_free(hd);
+    }
+
+    ESP_LOGI(TAG, "SRP6a server: pubkey %lld us, session key %lld us (average of %d rounds)",
+             pubkey_us / SRP_TEST_ROUNDS, session_key_us / SRP_TEST_ROUNDS, SRP_TEST_ROUNDS);
+
+    for (size_t i = 0; i < sizeof(mpis) / sizeof(mpis[0]); i++) {
+        mbedtls_mpi_free(mpis[i]);
+    }
+    free(bytes_A);
+    free(bytes_S);
+    free(salt);
+    free(verifier);
+}
+
+#endif /* CONFIG_ESP_PROTOCOMM_SUPPORT_SECURITY_VERSION_2 */
+
 void app_main(void)
 {
     unity_run_menu();
@@ -6,6 +6,10 @@ from pytest_embedded_idf.utils import idf_parametrize
 
 
 @pytest.mark.generic
-@idf_parametrize('target', ['supported_targets'], indirect=['target'])
+@idf_parametrize(
+    'config,target',
+    [('default', 'supported_targets'), ('srp_fixed_base', 'esp32'), ('srp_fixed_base', 'esp32c3')],
+    indirect=['config', 'target'],
+)
 def test_protocomm(dut: Dut) -> None:
     dut.run_all_single_board_cases()
@@ -78,6 +78,28 @@ void esp_transport_ssl_set_esp_tls_dyn_buf_strategy(esp_transport_handle_t t, es
  */
 void esp_transport_ssl_set_tls_version(esp_transport_handle_t t, esp_tls_proto_ver_t tls_version);
 
+/**
+ * @brief      Enable coalescing of small writes into fewer TLS records
+ *
+ * Writes are collected in a buffer of the given size and sent once it is full,
+ * when esp_transport_ssl_flush() is called or before the transport reads.
+ *
+ * @param      t     ssl transport
+ * @param[in]  size  size of the coalescing buffer, 0 disables coalescing (default)
+ */
+void esp_transport_ssl_set_tx_coalescing(esp_transport_handle_t t, size_t size);
+
+/**
+ * @brief      Send the data collected by the write coalescing buffer
+ *
+ * @param      t     ssl transport
+ *
+ * @return
+ *             - 0  on success (or if nothing was pending)
+ *             - <0 on failure, see esp_tls_conn_flush()
+ */
+int esp_transport_ssl_flush(esp_transport_handle_t t);
+
 /**
  * @brief      Set SSL client certificate data for mutual authentication (as PEM format).
  *             Note that, this function stores the pointer to data, rather than making a copy.
@@ -44,8 +44,23 @@ typedef struct {
                                              *   If false, only user frames are propagated, control frames are handled
                                              *   automatically during read operations
                                              */
+    bool        permessage_deflate;         /*!< Offer the permessage-deflate extension (RFC 7692) in the handshake,
+                                             *   requires CONFIG_WS_PERMESSAGE_DEFLATE */
+    bool        deflate_no_context_takeover; /*!< Reset the compression context after every message in both directions.
+                                             *   Lowers the compression ratio but frees the deflate state between
+                                             *   messages */
 } esp_transport_ws_config_t;
 
+/**
+ * @brief WS permessage-deflate statistics
+ */
+typedef struct {
+    size_t tx_plain;            /*!< Application bytes of the compressed messages sent */
+    size_t tx_compressed;       /*!< Payload bytes of the compressed messages sent */
+    size_t rx_compressed;       /*!< Payload bytes of the compressed messages received */
+    size_t rx_plain;            /*!< Application bytes of the compressed messages received */
+} esp_transport_ws_deflate_stats_t;
+
 /**
  * @brief      Create web socket transport
  *
@@ -211,6 +226,20 @@ ws_transport_opcodes_t esp_transport_ws_get_read_opcode(esp_transport_handle_t t
  */
 int esp_transport_ws_get_read_payload_len(esp_transport_handle_t t);
 
+/**
+ * @brief               Returns permessage-deflate statistics of the current connection
+ *
+ * @param t             websocket transport handle
+ * @param[out] stats    Statistics of the compressed messages sent and received
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the arguments are invalid
+ *      - ESP_ERR_INVALID_STATE if permessage-deflate was not negotiated on this connection
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_WS_PERMESSAGE_DEFLATE is disabled
+ */
+esp_err_t esp_transport_ws_get_deflate_stats(esp_transport_handle_t t, esp_transport_ws_deflate_stats_t *stats);
+
 /**
  * @brief               Polls the active connection for termination
  *
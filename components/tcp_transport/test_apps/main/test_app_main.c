@@ -5,11 +5,15 @@
  */
 #include "unity_fixture.h"
 #include "unity_fixture_extras.h"
+#include "sdkconfig.h"
 
 static void run_all_tests(void)
 {
     RUN_TEST_GROUP(transport_basic);
     RUN_TEST_GROUP(transport_connect);
+#if CONFIG_WS_PERMESSAGE_DEFLATE && CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+    RUN_TEST_GROUP(transport_ws_deflate);
+#endif
 }
 
 void app_main(void)
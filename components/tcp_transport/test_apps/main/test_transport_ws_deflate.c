@@ -0,0 +1,322 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include "unity_fixture.h"
+#include "memory_checks.h"
+#include "esp_transport.h"
+#include "esp_transport_tcp.h"
+#include "esp_transport_ws.h"
+#include "esp_http_server.h"
+#include "esp_ws_deflate.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "test_utils.h"
+
+#if CONFIG_WS_PERMESSAGE_DEFLATE && CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE
+
+#define TEST_WS_PORT            8089
+#define TEST_WS_TIMEOUT_MS      5000
+#define TEST_WS_PAYLOAD_LEN     4096
+#define TEST_WS_ROUNDS          20
+#define TEST_WS_SENDERS         2
+#define TEST_WS_WINDOW_BITS     9
+#define TEST_WS_BLOCK_LEN       1024
+
+static const char *TAG = "test_ws_deflate";
+
+TEST_GROUP(transport_ws_deflate);
+
+TEST_SETUP(transport_ws_deflate)
+{
+    test_utils_record_free_mem();
+    // lwIP keeps some memory for the sockets of the http server after it stops
+    TEST_ESP_OK(test_utils_set_leak_level(2048, ESP_LEAK_TYPE_CRITICAL, ESP_COMP_LEAK_GENERAL));
+}
+
+TEST_TEAR_DOWN(transport_ws_deflate)
+{
+    test_utils_finish_and_evaluate_leaks(test_utils_get_leak_level(ESP_LEAK_TYPE_WARNING, ESP_COMP_LEAK_ALL),
+                                         test_utils_get_leak_level(ESP_LEAK_TYPE_CRITICAL, ESP_COMP_LEAK_ALL));
+}
+
+static esp_err_t ws_echo_handler(httpd_req_t *req)
+{
+    if (req->method == HTTP_GET) {
+        return ESP_OK;
+    }
+    httpd_ws_frame_t frame = { 0 };
+    // First call reads the header and reports the inflated length
+    esp_err_t ret = httpd_ws_recv_frame(req, &frame, 0);
+    if (ret != ESP_OK || frame.len == 0) {
+        return ret;
+    }
+    frame.payload = malloc(frame.len);
+    if (frame.payload == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ret = httpd_ws_recv_frame(req, &frame, frame.len);
+    if (ret == ESP_OK) {
+        ret = httpd_ws_send_frame(req, &frame);
+    }
+    free(frame.payload);
+    return ret;
+}
+
+static httpd_handle_t start_echo_server(bool deflate)
+{
+    httpd_handle_t server = NULL;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.server_port = TEST_WS_PORT;
+    TEST_ESP_OK(httpd_start(&server, &config));
+
+    const httpd_uri_t ws = {
+        .uri = "/ws",
+        .method = HTTP_GET,
+        .handler = ws_echo_handler,
+        .is_websocket = true,
+        .ws_permessage_deflate = deflate,
+    };
+    TEST_ESP_OK(httpd_register_uri_handler(server, &ws));
+    return server;
+}
+
+/* Sensor readings compress well, like most JSON telemetry */
+static int fill_json_payload(char *buf, int len)
+{
+    int pos = snprintf(buf, len, "[");
+    for (int i = 0; pos < len - 80; i++) {
+        pos += snprintf(buf + pos, len - pos, "{\"id\":%d,\"sensor\":\"temperature\",\"value\":%d.%d,\"unit\":\"celsius\"},",
+                        i, 20 + i % 5, i % 10);
+    }
+    buf[pos - 1] = ']';
+    return pos;
+}
+
+/* Echoes the payload TEST_WS_ROUNDS times, returns the time spent in microseconds */
+static int64_t echo_rounds(bool deflate, const char *payload, int len, esp_transport_ws_deflate_stats_t *stats)
+{
+    httpd_handle_t server = start_echo_server(deflate);
+
+    esp_transport_list_handle_t transport_list = esp_transport_list_init();
+    esp_transport_handle_t tcp = esp_transport_tcp_init();
+    esp_transport_list_add(transport_list, tcp, "tcp");
+    esp_transport_handle_t ws = esp_transport_ws_init(tcp);
+    esp_transport_list_add(transport_list, ws, "ws");
+    const esp_transport_ws_config_t ws_config = {
+        .ws_path = "/ws",
+        .permessage_deflate = deflate,
+    };
+    TEST_ESP_OK(esp_transport_ws_set_config(ws, &ws_config));
+    TEST_ASSERT_EQUAL(0, esp_transport_connect(ws, "127.0.0.1", TEST_WS_PORT, TEST_WS_TIMEOUT_MS));
+
+    char *rx = malloc(len);
+    TEST_ASSERT_NOT_NULL(rx);
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < TEST_WS_ROUNDS; i++) {
+        TEST_ASSERT_EQUAL(len, esp_transport_ws_send_raw(ws, WS_TRANSPORT_OPCODES_TEXT | WS_TRANSPORT_OPCODES_FIN,
+                                                         payload, len, TEST_WS_TIMEOUT_MS));
+        int received = 0;
+        while (received < len) {
+            int r = esp_transport_read(ws, rx + received, len - received, TEST_WS_TIMEOUT_MS);
+            TEST_ASSERT_GREATER_THAN(0, r);
+            received += r;
+        }
+        TEST_ASSERT_EQUAL(WS_TRANSPORT_OPCODES_TEXT, esp_transport_ws_get_read_opcode(ws));
+        TEST_ASSERT_EQUAL_MEMORY(payload, rx, len);
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    if (deflate) {
+        TEST_ESP_OK(esp_transport_ws_get_deflate_stats(ws, stats));
+    } else {
+        TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_transport_ws_get_deflate_stats(ws, stats));
+    }
+
+    free(rx);
+    esp_transport_close(ws);
+    esp_transport_list_destroy(transport_list);
+    TEST_ESP_OK(httpd_stop(server));
+    return elapsed;
+}
+
+TEST(transport_ws_deflate, echo_json)
+{
+    test_case_uses_tcpip();
+
+    char *payload = malloc(TEST_WS_PAYLOAD_LEN);
+    TEST_ASSERT_NOT_NULL(payload);
+    int len = fill_json_payload(payload, TEST_WS_PAYLOAD_LEN);
+
+    esp_transport_ws_deflate_stats_t stats = { 0 };
+    int64_t plain_us = echo_rounds(false, payload, len, &stats);
+    int64_t deflate_us = echo_rounds(true, payload, len, &stats);
+
+    TEST_ASSERT_EQUAL(len * TEST_WS_ROUNDS, stats.tx_plain);
+    TEST_ASSERT_EQUAL(len * TEST_WS_ROUNDS, stats.rx_plain);
+    TEST_ASSERT_LESS_THAN(stats.tx_plain / 2, stats.tx_compressed);
+    TEST_ASSERT_LESS_THAN(stats.rx_plain / 2, stats.rx_compressed);
+
+    ESP_LOGI(TAG, "%d rounds of %d bytes: plain %lld us, deflate %lld us, sent %u/%u bytes, received %u/%u bytes",
+             TEST_WS_ROUNDS, len, plain_us, deflate_us,
+             (unsigned)stats.tx_compressed, (unsigned)stats.tx_plain,
+             (unsigned)stats.rx_compressed, (unsigned)stats.rx_plain);
+    free(payload);
+}
+
+/* A block repeated further back than the window must not be referenced: the receiver can't see it */
+TEST(transport_ws_deflate, window_bound)
+{
+    int len = 2 * TEST_WS_BLOCK_LEN + TEST_WS_PAYLOAD_LEN / 2;
+    uint8_t *msg = calloc(1, len);
+    TEST_ASSERT_NOT_NULL(msg);
+    uint32_t seed = 1;
+    for (int i = 0; i < TEST_WS_BLOCK_LEN; i++) {
+        seed = seed * 1103515245 + 12345;
+        msg[i] = seed >> 16;
+    }
+    fill_json_payload((char *)msg + TEST_WS_BLOCK_LEN, TEST_WS_PAYLOAD_LEN / 2);
+    memcpy(msg + len - TEST_WS_BLOCK_LEN, msg, TEST_WS_BLOCK_LEN);
+
+    // The inflate dictionary has the size of the window, references beyond it would read other data
+    esp_ws_deflate_t tx = { .tx_window_bits = TEST_WS_WINDOW_BITS };
+    esp_ws_deflate_t rx = { .rx_window_bits = TEST_WS_WINDOW_BITS, .max_payload = len };
+    size_t total = 0;
+    for (int i = 0; i < 3; i++) {
+        uint8_t *out = NULL;
+        size_t out_len = 0;
+        TEST_ESP_OK(esp_ws_deflate_compress(&tx, msg, len, true, &out, &out_len));
+        TEST_ESP_OK(esp_ws_deflate_inflate(&rx, out, out_len, true));
+        TEST_ASSERT_EQUAL(len, rx.rx_len);
+        TEST_ASSERT_EQUAL_MEMORY(msg, rx.rx_buf, len);
+        total += out_len;
+        free(out);
+    }
+    // The JSON compresses, the random blocks can't be found within the window
+    TEST_ASSERT_LESS_THAN(3 * len, total);
+    TEST_ASSERT_GREATER_THAN(3 * 2 * TEST_WS_BLOCK_LEN, total);
+
+    esp_ws_deflate_free(&tx);
+    esp_ws_deflate_free(&rx);
+    free(msg);
+}
+
+typedef struct {
+    httpd_handle_t server;
+    int fd;
+    const char *payload;
+    int len;
+    esp_err_t ret;
+    SemaphoreHandle_t done;
+} ws_async_sender_t;
+
+static void ws_async_send_task(void *arg)
+{
+    ws_async_sender_t *sender = arg;
+    sender->ret = ESP_OK;
+    for (int i = 0; i < TEST_WS_ROUNDS && sender->ret == ESP_OK; i++) {
+        httpd_ws_frame_t frame = {
+            .type = HTTPD_WS_TYPE_TEXT,
+            .payload = (uint8_t *)sender->payload,
+            .len = sender->len,
+        };
+        sender->ret = httpd_ws_send_frame_async(sender->server, sender->fd, &frame);
+    }
+    xSemaphoreGive(sender->done);
+    vTaskDelete(NULL);
+}
+
+/* Compressed messages sent from several tasks have to arrive in the order of the compressor state */
+TEST(transport_ws_deflate, concurrent_async_send)
+{
+    test_case_uses_tcpip();
+
+    char *payloads[TEST_WS_SENDERS];
+    int len = 0;
+    for (int i = 0; i < TEST_WS_SENDERS; i++) {
+        payloads[i] = malloc(TEST_WS_PAYLOAD_LEN);
+        TEST_ASSERT_NOT_NULL(payloads[i]);
+        len = fill_json_payload(payloads[i], TEST_WS_PAYLOAD_LEN);
+    }
+    for (int i = 0; i < len; i++) {
+        payloads[1][i] = toupper((unsigned char)payloads[1][i]);
+    }
+
+    httpd_handle_t server = start_echo_server(true);
+    esp_transport_list_handle_t transport_list = esp_transport_list_init();
+    esp_transport_handle_t tcp = esp_transport_tcp_init();
+    esp_transport_list_add(transport_list, tcp, "tcp");
+    esp_transport_handle_t ws = esp_transport_ws_init(tcp);
+    esp_transport_list_add(transport_list, ws, "ws");
+    const esp_transport_ws_config_t ws_config = {
+        .ws_path = "/ws",
+        .permessage_deflate = true,
+    };
+    TEST_ESP_OK(esp_transport_ws_set_config(ws, &ws_config));
+    TEST_ASSERT_EQUAL(0, esp_transport_connect(ws, "127.0.0.1", TEST_WS_PORT, TEST_WS_TIMEOUT_MS));
+
+    size_t fds = 1;
+    int fd = -1;
+    TEST_ESP_OK(httpd_get_client_list(server, &fds, &fd));
+    TEST_ASSERT_EQUAL(1, fds);
+
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(TEST_WS_SENDERS, 0);
+    TEST_ASSERT_NOT_NULL(done);
+    ws_async_sender_t senders[TEST_WS_SENDERS];
+    for (int i = 0; i < TEST_WS_SENDERS; i++) {
+        senders[i] = (ws_async_sender_t) {
+            .server = server, .fd = fd, .payload = payloads[i], .len = len, .ret = ESP_FAIL, .done = done,
+        };
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(ws_async_send_task, "ws_async_send", 4096, &senders[i], 5, NULL));
+    }
+
+    // Every message has to inflate to one of the payloads
+    int seen[TEST_WS_SENDERS] = { 0 };
+    char *rx = malloc(len);
+    TEST_ASSERT_NOT_NULL(rx);
+    for (int i = 0; i < TEST_WS_SENDERS * TEST_WS_ROUNDS; i++) {
+        int received = 0;
+        while (received < len) {
+            int r = esp_transport_read(ws, rx + received, len - received, TEST_WS_TIMEOUT_MS);
+            TEST_ASSERT_GREATER_THAN(0, r);
+            received += r;
+        }
+        int match = memcmp(rx, payloads[0], len) == 0 ? 0 : (memcmp(rx, payloads[1], len) == 0 ? 1 : -1);
+        TEST_ASSERT_NOT_EQUAL(-1, match);
+        seen[match]++;
+    }
+    for (int i = 0; i < TEST_WS_SENDERS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(done, pdMS_TO_TICKS(TEST_WS_TIMEOUT_MS)));
+    }
+    for (int i = 0; i < TEST_WS_SENDERS; i++) {
+        TEST_ESP_OK(senders[i].ret);
+        TEST_ASSERT_EQUAL(TEST_WS_ROUNDS, seen[i]);
+    }
+
+    free(rx);
+    vSemaphoreDelete(done);
+    esp_transport_close(ws);
+    esp_transport_list_destroy(transport_list);
+    TEST_ESP_OK(httpd_stop(server));
+    for (int i = 0; i < TEST_WS_SENDERS; i++) {
+        free(payloads[i]);
+    }
+    // Lets the idle task free the sender tasks before the leak check
+    vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+TEST_GROUP_RUNNER(transport_ws_deflate)
+{
+    RUN_TEST_CASE(transport_ws_deflate, echo_json);
+    RUN_TEST_CASE(transport_ws_deflate, window_bound);
+    RUN_TEST_CASE(transport_ws_deflate, concurrent_async_send);
+}
+
+#endif /* CONFIG_WS_PERMESSAGE_DEFLATE && CONFIG_HTTPD_WS_PERMESSAGE_DEFLATE */
@@ -8,7 +8,7 @@ from pytest_embedded_idf.utils import idf_parametrize
 @pytest.mark.generic
 @idf_parametrize(
     'config,target',
-    [('default', 'esp32'), ('default', 'esp32c3'), ('psram_esp32', 'esp32')],
+    [('default', 'esp32'), ('default', 'esp32c3'), ('psram_esp32', 'esp32'), ('ws_deflate', 'esp32')],
     indirect=['config', 'target'],
 )
 def test_tcp_transport_client(dut: Dut) -> None:
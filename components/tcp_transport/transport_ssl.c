@@ -262,6 +262,24 @@ static int ssl_read(esp_transport_handle_t t, char *buffer, int len, int timeout
     transport_esp_tls_t *ssl = ssl_get_context_data(t);
     ESP_STATIC_ANALYZER_CHECK(ssl == NULL, -1);
 
+    if (ssl->cfg.tx_coalesce_size) {
+        /* do not wait for a reply to a request that is still in the coalescing buffer;
+         * once flushed here, esp_tls_conn_read() finds nothing pending */
+        int ret = esp_tls_conn_flush(ssl->tls);
+        if (ret == ESP_TLS_ERR_SSL_WANT_WRITE) {
+            /* the pending data is kept, the caller retries the read like on a timeout */
+            ESP_LOGD(TAG, "esp_tls_conn_flush would block, errno=%s", strerror(errno));
+            return ERR_TCP_TRANSPORT_CONNECTION_TIMEOUT;
+        }
+        if (ret < 0) {
+            ESP_LOGE(TAG, "esp_tls_conn_flush error, errno=%s", strerror(errno));
+            esp_tls_error_handle_t esp_tls_error_handle;
+            if (esp_tls_get_error_handle(ssl->tls, &esp_tls_error_handle) == ESP_OK) {
+                esp_transport_set_errors(t, esp_tls_error_handle);
+            }
+            return ERR_TCP_TRANSPORT_CONNECTION_FAILED;
+        }
+    }
     int poll = esp_transport_poll_read(t, timeout_ms);
     if (poll == -1) {
         return ERR_TCP_TRANSPORT_CONNECTION_FAILED;
@@ -379,6 +397,21 @@ void esp_transport_ssl_set_tls_version(esp_transport_handle_t t, esp_tls_proto_v
     ssl->cfg.tls_version = tls_version;
 }
 
+void esp_transport_ssl_set_tx_coalescing(esp_transport_handle_t t, size_t size)
+{
+    GET_SSL_FROM_TRANSPORT_OR_RETURN(ssl, t);
+    ssl->cfg.tx_coalesce_size = size;
+}
+
+int esp_transport_ssl_flush(esp_transport_handle_t t)
+{
+    transport_esp_tls_t *ssl = ssl_get_context_data(t);
+    if (!ssl || !ssl->tls) {
+        return -1;
+    }
+    return esp_tls_conn_flush(ssl->tls);
+}
+
 #ifdef CONFIG_ESP_TLS_PSK_VERIFICATION
 void esp_transport_ssl_set_psk_key_hint(esp_transport_handle_t t, const psk_hint_key_t *psk_hint_key)
 {
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <sys/param.h>
 #include <sys/random.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
@@ -19,6 +20,10 @@
 #include "errno.h"
 #include "esp_tls_crypto.h"
 #include <arpa/inet.h>
+#include "sdkconfig.h"
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+#include "esp_ws_deflate.h"
+#endif
 
 static const char *TAG = "transport_ws";
 
@@ -31,6 +36,8 @@ static const char *TAG = "transport_ws";
 #define WS_OPCODE_PING              0x09
 #define WS_OPCODE_PONG              0x0a
 #define WS_OPCODE_CONTROL_FRAME     0x08
+#define WS_OPCODE_MASK              0x0f
+#define WS_RSV1                     0x40    /*!< Marks the first frame of a compressed message */
 
 // Second byte
 #define WS_MASK                     0x80
@@ -56,8 +63,25 @@ typedef struct {
     int payload_len;                    /*!< Total length of the payload */
     int bytes_remaining;                /*!< Bytes left to read of the payload  */
     bool header_received;               /*!< Flag to indicate that a new message header was received */
+    bool compressed;                    /*!< Payload is part of a permessage-deflate compressed message */
+    bool inflated;                      /*!< Payload is served from the inflate buffer */
 } ws_transport_frame_state_t;
 
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+#define WS_DEFLATE_MAX_PAYLOAD      CONFIG_WS_PERMESSAGE_DEFLATE_MAX_PAYLOAD
+#define WS_DEFLATE_MIN_LEN          CONFIG_WS_PERMESSAGE_DEFLATE_MIN_LEN
+#define WS_DEFLATE_WINDOW_BITS      CONFIG_WS_PERMESSAGE_DEFLATE_WINDOW_BITS
+
+typedef struct {
+    bool enabled;                       /*!< Offer the extension in the handshake */
+    bool no_context_takeover;           /*!< Ask for no context takeover in both directions */
+    bool negotiated;                    /*!< Extension accepted by the server */
+    esp_ws_deflate_t codec;
+    size_t rx_pos;                      /*!< Bytes of codec.rx_buf already read */
+    esp_transport_ws_deflate_stats_t stats;
+} ws_deflate_t;
+#endif
+
 typedef struct {
     char *path;
     char *sub_protocol;
@@ -73,6 +97,9 @@ typedef struct {
     char *redir_host;
     char *response_header;
     size_t response_header_len;
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    ws_deflate_t deflate;
+#endif
 } transport_ws_t;
 
 /**
@@ -109,6 +136,9 @@ static esp_transport_handle_t ws_get_payload_transport_handle(esp_transport_hand
     /* Reading parts of a frame directly will disrupt the WS internal frame state,
         reset bytes_remaining to prepare for reading a new frame */
     ws->frame_state.bytes_remaining = 0;
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    ws->frame_state.inflated = false;
+#endif
 
     return ws->parent;
 }
@@ -204,6 +234,87 @@ static char *get_http_header(char *buffer, const char *key)
     return NULL;
 }
 
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+static void ws_deflate_reset(ws_deflate_t *d)
+{
+    esp_ws_deflate_free(&d->codec);
+    memset(&d->codec, 0, sizeof(d->codec));
+    d->rx_pos = 0;
+    d->negotiated = false;
+    memset(&d->stats, 0, sizeof(d->stats));
+}
+
+/* Copies a header value without terminating it in place, so the other headers can still be searched */
+static bool ws_copy_http_header(const char *buffer, const char *key, char *value, size_t value_len)
+{
+    const char *found = strcasestr(buffer, key);
+    if (found == NULL) {
+        return false;
+    }
+    found += strlen(key);
+    const char *found_end = strstr(found, "\r\n");
+    size_t len = found_end ? found_end - found : strlen(found);
+    if (len >= value_len) {
+        len = value_len - 1;
+    }
+    memcpy(value, found, len);
+    value[len] = '\0';
+    return true;
+}
+
+static void ws_deflate_offer(ws_deflate_t *d, esp_ws_deflate_params_t *offer)
+{
+    memset(offer, 0, sizeof(*offer));
+    offer->server_no_context_takeover = d->no_context_takeover;
+    offer->client_no_context_takeover = d->no_context_takeover;
+    // Limiting the server window bounds the inflate dictionary, a 15 bit window needs no limit
+    if (WS_DEFLATE_WINDOW_BITS < ESP_WS_DEFLATE_MAX_WINDOW_BITS) {
+        offer->server_max_window_bits = WS_DEFLATE_WINDOW_BITS;
+    }
+    offer->client_max_window_bits = WS_DEFLATE_WINDOW_BITS;
+}
+
+/* Parses the extension accepted by the server, see RFC 7692, Section 7.1 */
+static int ws_deflate_parse_response(ws_deflate_t *d, char *extensions)
+{
+    esp_ws_deflate_params_t params;
+    if (esp_ws_deflate_parse_params(extensions, &params) != ESP_OK) {
+        ESP_LOGE(TAG, "Unsupported extension in server response");
+        return -1;
+    }
+    // The server has to confirm the limit of its window, see RFC 7692, Section 7.1.2.1
+    if (WS_DEFLATE_WINDOW_BITS < ESP_WS_DEFLATE_MAX_WINDOW_BITS &&
+            (params.server_max_window_bits == 0 || params.server_max_window_bits > WS_DEFLATE_WINDOW_BITS)) {
+        ESP_LOGE(TAG, "Server window exceeds %d bits", WS_DEFLATE_WINDOW_BITS);
+        return -1;
+    }
+    d->codec.rx_window_bits = params.server_max_window_bits ? params.server_max_window_bits : ESP_WS_DEFLATE_MAX_WINDOW_BITS;
+    d->codec.tx_window_bits = params.client_max_window_bits ? MIN(params.client_max_window_bits, WS_DEFLATE_WINDOW_BITS) : WS_DEFLATE_WINDOW_BITS;
+    // We don't keep our compression context if we asked the server not to keep its
+    d->codec.tx_no_context_takeover = d->no_context_takeover || params.client_no_context_takeover;
+    d->codec.rx_no_context_takeover = params.server_no_context_takeover;
+    d->codec.max_payload = WS_DEFLATE_MAX_PAYLOAD;
+    d->negotiated = true;
+    return 0;
+}
+
+static bool ws_deflate_wants(ws_deflate_t *d, int opcode, int len)
+{
+    if (!d->negotiated) {
+        return false;
+    }
+    switch (opcode & WS_OPCODE_MASK) {
+    case WS_OPCODE_CONT:
+        return d->codec.tx_in_msg;
+    case WS_OPCODE_TEXT:
+    case WS_OPCODE_BINARY:
+        return len >= WS_DEFLATE_MIN_LEN;
+    default:
+        return false;
+    }
+}
+#endif /* CONFIG_WS_PERMESSAGE_DEFLATE */
+
 static int ws_connect(esp_transport_handle_t t, const char *host, int port, int timeout_ms)
 {
     transport_ws_t *ws = esp_transport_get_context_data(t);
@@ -272,6 +383,22 @@ static int ws_connect(esp_transport_handle_t t, const char *host, int port, int
             return -1;
         }
     }
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    ws_deflate_reset(&ws->deflate);
+    if (ws->deflate.enabled) {
+        esp_ws_deflate_params_t offer;
+        char extensions[128];
+        ws_deflate_offer(&ws->deflate, &offer);
+        esp_ws_deflate_format_params(&offer, extensions, sizeof(extensions));
+        int r = snprintf(ws->buffer + len, WS_BUFFER_SIZE - len, "Sec-WebSocket-Extensions: %s\r\n", extensions);
+        len += r;
+        if (r <= 0 || len >= WS_BUFFER_SIZE) {
+            ESP_LOGE(TAG, "Error in request generation"
+                     "(snprintf of extensions returned %d, desired request len: %d, buffer size: %d", r, len, WS_BUFFER_SIZE);
+            return -1;
+        }
+    }
+#endif
     if (ws->headers) {
         ESP_LOGD(TAG, "headers: %s", ws->headers);
         int r = snprintf(ws->buffer + len, WS_BUFFER_SIZE - len, "%s", ws->headers);
@@ -336,6 +463,19 @@ static int ws_connect(esp_transport_handle_t t, const char *host, int port, int
         return ws->http_status_code;
     }
 
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    // get_http_header() terminates the value in place, look at the extensions first
+    char extensions[128];
+    if (ws->deflate.enabled && ws_copy_http_header(ws->buffer, "Sec-WebSocket-Extensions:", extensions, sizeof(extensions))) {
+        if (ws_deflate_parse_response(&ws->deflate, extensions) != 0) {
+            return -1;
+        }
+        ESP_LOGD(TAG, "permessage-deflate negotiated (tx_window_bits=%d, rx_window_bits=%d, tx_no_context_takeover=%d, rx_no_context_takeover=%d)",
+                 ws->deflate.codec.tx_window_bits, ws->deflate.codec.rx_window_bits,
+                 ws->deflate.codec.tx_no_context_takeover, ws->deflate.codec.rx_no_context_takeover);
+    }
+#endif
+
     char *server_key = get_http_header(ws->buffer, "Sec-WebSocket-Accept:");
     if (server_key == NULL) {
         ESP_LOGE(TAG, "Sec-WebSocket-Accept not found");
@@ -381,7 +521,7 @@ static int ws_connect(esp_transport_handle_t t, const char *host, int port, int
     return 0;
 }
 
-static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const char *b, int len, int timeout_ms)
+static int _ws_write_frame(esp_transport_handle_t t, int opcode, int mask_flag, const char *b, int len, int timeout_ms)
 {
     transport_ws_t *ws = esp_transport_get_context_data(t);
     char *buffer = (char *)b;
@@ -449,6 +589,30 @@ static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const
     return ret;
 }
 
+static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const char *b, int len, int timeout_ms)
+{
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    transport_ws_t *ws = esp_transport_get_context_data(t);
+
+    if (ws_deflate_wants(&ws->deflate, opcode, len)) {
+        uint8_t *compressed = NULL;
+        size_t compressed_len = 0;
+        // RSV1 is only set on the first frame of a message, see RFC 7692, Section 6.1
+        int first = (opcode & WS_OPCODE_MASK) != WS_OPCODE_CONT;
+        if (esp_ws_deflate_compress(&ws->deflate.codec, (const uint8_t *)b, len, opcode & WS_FIN, &compressed, &compressed_len) != ESP_OK) {
+            return -1;
+        }
+        ws->deflate.stats.tx_plain += len;
+        ws->deflate.stats.tx_compressed += compressed_len;
+        int ret = _ws_write_frame(t, opcode | (first ? WS_RSV1 : 0), mask_flag, (const char *)compressed, compressed_len, timeout_ms);
+        free(compressed);
+        // Callers account for the bytes they handed in, not for what went on the wire
+        return ret == compressed_len ? len : (ret < 0 ? ret : -1);
+    }
+#endif
+    return _ws_write_frame(t, opcode, mask_flag, b, len, timeout_ms);
+}
+
 int esp_transport_ws_send_raw(esp_transport_handle_t t, ws_transport_opcodes_t opcode, const char *b, int len, int timeout_ms)
 {
     uint8_t op_code = ws_get_bin_opcode(opcode);
@@ -480,6 +644,22 @@ static int ws_read_payload(esp_transport_handle_t t, char *buffer, int len, int
     int bytes_to_read;
     int rlen = 0;
 
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    if (ws->frame_state.inflated) {
+        ws_deflate_t *d = &ws->deflate;
+        rlen = MIN(len, ws->frame_state.bytes_remaining);
+        memcpy(buffer, d->codec.rx_buf + d->rx_pos, rlen);
+        d->rx_pos += rlen;
+        ws->frame_state.bytes_remaining -= rlen;
+        if (ws->frame_state.bytes_remaining == 0) {
+            esp_ws_deflate_drop_rx_buf(&d->codec);
+            d->rx_pos = 0;
+            ws->frame_state.inflated = false;
+        }
+        return rlen;
+    }
+#endif
+
     if (ws->frame_state.bytes_remaining > len) {
         ESP_LOGD(TAG, "Actual data to receive (%d) are longer than ws buffer (%d)", ws->frame_state.bytes_remaining, len);
         bytes_to_read = len;
@@ -530,6 +710,47 @@ static int esp_transport_read_exact_size(transport_ws_t *ws, char *buffer, int r
 }
 
 
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+/* Reads the whole compressed frame and reports the inflated length as the frame payload length */
+static int ws_read_compressed_payload(esp_transport_handle_t t, int timeout_ms)
+{
+    transport_ws_t *ws = esp_transport_get_context_data(t);
+    int payload_len = ws->frame_state.payload_len;
+
+    if (payload_len > WS_DEFLATE_MAX_PAYLOAD) {
+        ESP_LOGE(TAG, "Compressed frame too large (need=%d, max_allowed=%d)", payload_len, WS_DEFLATE_MAX_PAYLOAD);
+        return -1;
+    }
+    char *compressed = malloc(payload_len ? payload_len : 1);
+    if (compressed == NULL) {
+        ESP_LOGE(TAG, "Cannot allocate buffer for compressed frame, need-%d", payload_len);
+        return -1;
+    }
+    int rlen = payload_len ? esp_transport_read_exact_size(ws, compressed, payload_len, timeout_ms) : 0;
+    if (rlen != payload_len) {
+        ESP_LOGE(TAG, "Error read compressed data(%d)", rlen);
+        free(compressed);
+        return -1;
+    }
+    for (int i = 0; i < payload_len; i++) {
+        compressed[i] = (compressed[i] ^ ws->frame_state.mask_key[i % 4]);
+    }
+    ws_deflate_t *d = &ws->deflate;
+    esp_err_t ret = esp_ws_deflate_inflate(&d->codec, (const uint8_t *)compressed, payload_len, ws->frame_state.fin);
+    free(compressed);
+    if (ret != ESP_OK) {
+        return -1;
+    }
+    d->rx_pos = 0;
+    d->stats.rx_compressed += payload_len;
+    d->stats.rx_plain += d->codec.rx_len;
+    ws->frame_state.inflated = d->codec.rx_len > 0;
+    ws->frame_state.payload_len = d->codec.rx_len;
+    ws->frame_state.bytes_remaining = d->codec.rx_len;
+    return d->codec.rx_len;
+}
+#endif
+
 /* Read and parse the WS header, determine length of payload */
 static int ws_read_header(esp_transport_handle_t t, char *buffer, int len, int timeout_ms)
 {
@@ -555,6 +776,14 @@ static int ws_read_header(esp_transport_handle_t t, char *buffer, int len, int t
     ws->frame_state.header_received = true;
     ws->frame_state.fin = (*data_ptr & 0x80) != 0;
     ws->frame_state.opcode = (*data_ptr & 0x0F);
+    ws->frame_state.compressed = false;
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    ws->frame_state.inflated = false;
+    if (ws->deflate.negotiated && !(ws->frame_state.opcode & WS_OPCODE_CONTROL_FRAME)) {
+        ws->frame_state.compressed = ws->frame_state.opcode == WS_OPCODE_CONT ?
+                                     ws->deflate.codec.rx_in_msg : (*data_ptr & WS_RSV1) != 0;
+    }
+#endif
     data_ptr ++;
     mask = ((*data_ptr >> 7) & 0x01);
     payload_len = (*data_ptr & 0x7F);
@@ -597,6 +826,11 @@ static int ws_read_header(esp_transport_handle_t t, char *buffer, int len, int t
     ws->frame_state.payload_len = payload_len;
     ws->frame_state.bytes_remaining = payload_len;
 
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    if (ws->frame_state.compressed) {
+        return ws_read_compressed_payload(t, timeout_ms);
+    }
+#endif
     return payload_len;
 }
 
@@ -718,6 +952,9 @@ static esp_err_t ws_destroy(esp_transport_handle_t t)
     free(ws->user_agent);
     free(ws->headers);
     free(ws->auth);
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    ws_deflate_reset(&ws->deflate);
+#endif
     free(ws);
     return 0;
 }
@@ -937,6 +1174,14 @@ esp_err_t esp_transport_ws_set_config(esp_transport_handle_t t, const esp_transp
     }
 
     ws->propagate_control_frames = config->propagate_control_frames;
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    ws->deflate.enabled = config->permessage_deflate;
+    ws->deflate.no_context_takeover = config->deflate_no_context_takeover;
+#else
+    if (config->permessage_deflate) {
+        ESP_LOGW(TAG, "permessage-deflate requested but CONFIG_WS_PERMESSAGE_DEFLATE is disabled");
+    }
+#endif
 
     return err;
 }
@@ -985,6 +1230,23 @@ int esp_transport_ws_get_read_payload_len(esp_transport_handle_t t)
     return ws->frame_state.payload_len;
 }
 
+esp_err_t esp_transport_ws_get_deflate_stats(esp_transport_handle_t t, esp_transport_ws_deflate_stats_t *stats)
+{
+#ifdef CONFIG_WS_PERMESSAGE_DEFLATE
+    if (t == NULL || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    transport_ws_t *ws = esp_transport_get_context_data(t);
+    if (!ws->deflate.negotiated) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *stats = ws->deflate.stats;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 static int esp_transport_ws_handle_control_frames(esp_transport_handle_t t, char *buffer, int len, int timeout_ms, bool client_closed)
 {
     transport_ws_t *ws = esp_transport_get_context_data(t);
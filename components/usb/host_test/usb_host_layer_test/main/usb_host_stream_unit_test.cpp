@@ -0,0 +1,278 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <deque>
+#include <catch2/catch_test_macros.hpp>
+
+#include "usb_host.h"   // Real implementation of usb_host.h
+
+extern "C" {
+#include "Mockusb_phy.h"
+#include "Mockhcd.h"
+#include "Mockusbh.h"
+#include "Mockenum.h"
+#include "Mockhub.h"
+}
+
+#define TEST_DEV_ADDR           1
+#define TEST_EP_IN_ADDR         0x81
+#define TEST_EP_OUT_ADDR        0x02
+#define TEST_EP_MPS             64
+#define TEST_NUM_TRANSFERS      4
+#define TEST_TRANSFER_SIZE      (8 * TEST_EP_MPS)
+
+// Configuration descriptor of a vendor device, with one interface made of a bulk IN and a bulk OUT endpoint
+static const uint8_t test_config_desc[] = {
+    0x09, USB_B_DESCRIPTOR_TYPE_CONFIGURATION, 0x20, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32,
+    0x09, USB_B_DESCRIPTOR_TYPE_INTERFACE, 0x00, 0x00, 0x02, 0xff, 0x00, 0x00, 0x00,
+    0x07, USB_B_DESCRIPTOR_TYPE_ENDPOINT, TEST_EP_IN_ADDR, USB_BM_ATTRIBUTES_XFER_BULK, TEST_EP_MPS, 0x00, 0x00,
+    0x07, USB_B_DESCRIPTOR_TYPE_ENDPOINT, TEST_EP_OUT_ADDR, USB_BM_ATTRIBUTES_XFER_BULK, TEST_EP_MPS, 0x00, 0x00,
+};
+
+// The USBH layer is emulated by the stubs below: each allocated endpoint keeps its config (containing the endpoint
+// callback and the USB Host layer's context), URBs enqueued to the endpoint wait in 'inflight' until the test moves
+// them to 'done' to be dequeued
+static usb_device_handle_t test_dev_hdl = (usb_device_handle_t)0x1234;
+static usbh_ep_config_t test_eps[2];
+static int test_num_eps;
+static std::deque<urb_t *> test_inflight;
+static std::deque<urb_t *> test_done;
+
+// Transfers delivered to the stream callback
+static int test_num_callbacks;
+static std::deque<usb_transfer_t *> test_delivered;
+
+static esp_err_t test_ep_alloc(usb_device_handle_t dev_hdl, usbh_ep_config_t *ep_config, usbh_ep_handle_t *ep_hdl_ret, int num_calls)
+{
+    test_eps[test_num_eps] = *ep_config;
+    *ep_hdl_ret = (usbh_ep_handle_t)&test_eps[test_num_eps];
+    test_num_eps++;
+    return ESP_OK;
+}
+
+static esp_err_t test_ep_get_handle(usb_device_handle_t dev_hdl, uint8_t bEndpointAddress, usbh_ep_handle_t *ep_hdl_ret, int num_calls)
+{
+    for (int i = 0; i < test_num_eps; i++) {
+        if (test_eps[i].bEndpointAddress == bEndpointAddress) {
+            *ep_hdl_ret = (usbh_ep_handle_t)&test_eps[i];
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+static void test_complete_urbs(int num_urbs, usb_transfer_status_t status)
+{
+    for (int i = 0; i < num_urbs; i++) {
+        urb_t *urb = test_inflight.front();
+        test_inflight.pop_front();
+        urb->transfer.status = status;
+        urb->transfer.actual_num_bytes = (status == USB_TRANSFER_STATUS_COMPLETED) ? TEST_EP_MPS : 0;
+        test_done.push_back(urb);
+    }
+    // Notify the USB Host layer, as the USBH layer would do from the HCD's pipe event
+    usbh_ep_config_t *ep = &test_eps[0];
+    ep->ep_cb((usbh_ep_handle_t)ep, USBH_EP_EVENT_URB_DONE, ep->ep_cb_arg, false);
+}
+
+static void test_stream_cb(usb_host_stream_handle_t stream_hdl, usb_transfer_t **transfers, int num_transfers, void *arg)
+{
+    test_num_callbacks++;
+    for (int i = 0; i < num_transfers; i++) {
+        test_delivered.push_back(transfers[i]);
+    }
+}
+
+static void test_client_event_cb(const usb_host_client_event_msg_t *event_msg, void *arg)
+{
+}
+
+static void test_transfer_cb(usb_transfer_t *transfer)
+{
+}
+
+SCENARIO("USB Host streaming endpoint")
+{
+    test_num_eps = 0;
+    test_inflight.clear();
+    test_done.clear();
+    test_num_callbacks = 0;
+    test_delivered.clear();
+
+    usbh_ep_alloc_Stub(test_ep_alloc);
+    usbh_ep_get_handle_Stub(test_ep_get_handle);
+    usbh_ep_get_context_Stub([](usbh_ep_handle_t ep_hdl, int num_calls) {
+        return ((usbh_ep_config_t *)ep_hdl)->context;
+    });
+    usbh_ep_enqueue_urb_Stub([](usbh_ep_handle_t ep_hdl, urb_t *urb, int num_calls) {
+        test_inflight.push_back(urb);
+        return ESP_OK;
+    });
+    usbh_ep_dequeue_urb_Stub([](usbh_ep_handle_t ep_hdl, urb_t **urb_ret, int num_calls) {
+        *urb_ret = NULL;
+        if (!test_done.empty()) {
+            *urb_ret = test_done.front();
+            test_done.pop_front();
+        }
+        return ESP_OK;
+    });
+    usbh_devs_open_Stub([](uint8_t dev_addr, usb_device_handle_t *dev_hdl, int num_calls) {
+        *dev_hdl = test_dev_hdl;
+        return ESP_OK;
+    });
+    usbh_dev_get_addr_Stub([](usb_device_handle_t dev_hdl, uint8_t *dev_addr, int num_calls) {
+        *dev_addr = TEST_DEV_ADDR;
+        return ESP_OK;
+    });
+    usbh_dev_get_config_desc_Stub([](usb_device_handle_t dev_hdl, const usb_config_desc_t **config_desc_ret, int num_calls) {
+        *config_desc_ret = (const usb_config_desc_t *)test_config_desc;
+        return ESP_OK;
+    });
+
+    // Install the USB Host driver with an external PHY and an unpowered root port
+    usb_host_config_t usb_host_config = {
+        .skip_phy_setup = true,
+        .root_port_unpowered = true,
+        .intr_flags = 1,
+        .enum_filter_cb = nullptr,
+        .fifo_settings_custom = {},
+        .peripheral_map = 0,
+    };
+    hcd_install_ExpectAnyArgsAndReturn(ESP_OK);
+    usbh_install_ExpectAnyArgsAndReturn(ESP_OK);
+    enum_install_ExpectAnyArgsAndReturn(ESP_OK);
+    hub_install_ExpectAnyArgsAndReturn(ESP_OK);
+    REQUIRE(ESP_OK == usb_host_install(&usb_host_config));
+
+    // Register a client, open the device and claim its interface
+    usb_host_client_config_t client_config = {};
+    client_config.max_num_event_msg = 5;
+    client_config.async.client_event_callback = test_client_event_cb;
+    usb_host_client_handle_t client_hdl;
+    REQUIRE(ESP_OK == usb_host_client_register(&client_config, &client_hdl));
+    usb_device_handle_t dev_hdl;
+    REQUIRE(ESP_OK == usb_host_device_open(client_hdl, TEST_DEV_ADDR, &dev_hdl));
+    REQUIRE(ESP_OK == usb_host_interface_claim(client_hdl, dev_hdl, 0, 0));
+    REQUIRE(2 == test_num_eps);
+
+    usb_host_stream_config_t stream_config = {
+        .device_handle = dev_hdl,
+        .bEndpointAddress = TEST_EP_IN_ADDR,
+        .num_transfers = TEST_NUM_TRANSFERS,
+        .transfer_size = TEST_TRANSFER_SIZE,
+        .callback = test_stream_cb,
+        .callback_arg = nullptr,
+    };
+    usb_host_stream_handle_t stream_hdl;
+
+    GIVEN("Invalid stream configurations") {
+
+        SECTION("OUT endpoint") {
+            stream_config.bEndpointAddress = TEST_EP_OUT_ADDR;
+            REQUIRE(ESP_ERR_NOT_SUPPORTED == usb_host_stream_alloc(&stream_config, &stream_hdl));
+        }
+
+        SECTION("Transfer size not a multiple of MPS") {
+            stream_config.transfer_size = TEST_EP_MPS + 1;
+            REQUIRE(ESP_ERR_INVALID_ARG == usb_host_stream_alloc(&stream_config, &stream_hdl));
+        }
+
+        SECTION("Endpoint not claimed") {
+            stream_config.bEndpointAddress = 0x83;
+            REQUIRE(ESP_ERR_NOT_FOUND == usb_host_stream_alloc(&stream_config, &stream_hdl));
+        }
+    }
+
+    GIVEN("A stream allocated on the bulk IN endpoint") {
+        REQUIRE(ESP_OK == usb_host_stream_alloc(&stream_config, &stream_hdl));
+
+        SECTION("The endpoint is reserved to the stream") {
+            usb_host_stream_handle_t other_stream_hdl;
+            REQUIRE(ESP_ERR_INVALID_STATE == usb_host_stream_alloc(&stream_config, &other_stream_hdl));
+
+            usb_transfer_t *transfer;
+            REQUIRE(ESP_OK == usb_host_transfer_alloc(TEST_EP_MPS, 0, &transfer));
+            transfer->device_handle = dev_hdl;
+            transfer->bEndpointAddress = TEST_EP_IN_ADDR;
+            transfer->num_bytes = TEST_EP_MPS;
+            transfer->callback = test_transfer_cb;
+            REQUIRE(ESP_ERR_INVALID_STATE == usb_host_transfer_submit(transfer));
+            REQUIRE(ESP_OK == usb_host_transfer_free(transfer));
+
+            REQUIRE(ESP_ERR_INVALID_STATE == usb_host_interface_release(client_hdl, dev_hdl, 0));
+        }
+
+        SECTION("Completed transfers are delivered in one callback and re-submitted") {
+            REQUIRE(ESP_OK == usb_host_stream_start(stream_hdl));
+            REQUIRE(TEST_NUM_TRANSFERS == test_inflight.size());
+            REQUIRE(ESP_ERR_NOT_FINISHED == usb_host_stream_start(stream_hdl));
+
+            for (int i = 0; i < 100; i++) {
+                usb_transfer_t *first = &test_inflight.front()->transfer;
+                test_complete_urbs(TEST_NUM_TRANSFERS - 1, USB_TRANSFER_STATUS_COMPLETED);
+                REQUIRE(ESP_OK == usb_host_client_handle_events(client_hdl, 0));
+
+                // All completed transfers are delivered together, in completion order
+                REQUIRE(i + 1 == test_num_callbacks);
+                REQUIRE(TEST_NUM_TRANSFERS - 1 == test_delivered.size());
+                REQUIRE(first == test_delivered.front());
+                REQUIRE(TEST_EP_MPS == test_delivered.front()->actual_num_bytes);
+                test_delivered.clear();
+                // ...and re-submitted behind the transfer that is still in-flight
+                REQUIRE(TEST_NUM_TRANSFERS == test_inflight.size());
+                REQUIRE(TEST_TRANSFER_SIZE == test_inflight.back()->transfer.num_bytes);
+            }
+            REQUIRE(ESP_ERR_INVALID_STATE == usb_host_stream_free(stream_hdl));
+
+            // Transfers still in-flight after stopping the stream are delivered, but not re-submitted
+            REQUIRE(ESP_OK == usb_host_stream_stop(stream_hdl));
+            test_complete_urbs(TEST_NUM_TRANSFERS, USB_TRANSFER_STATUS_COMPLETED);
+            REQUIRE(ESP_OK == usb_host_client_handle_events(client_hdl, 0));
+            REQUIRE(TEST_NUM_TRANSFERS == test_delivered.size());
+            REQUIRE(test_inflight.empty());
+        }
+
+        SECTION("A failed transfer stops the stream") {
+            REQUIRE(ESP_OK == usb_host_stream_start(stream_hdl));
+            test_complete_urbs(1, USB_TRANSFER_STATUS_STALL);
+            REQUIRE(ESP_OK == usb_host_client_handle_events(client_hdl, 0));
+            REQUIRE(1 == test_delivered.size());
+            REQUIRE(TEST_NUM_TRANSFERS - 1 == test_inflight.size());
+
+            // The stream can only be restarted once all of its transfers have been delivered
+            REQUIRE(ESP_ERR_NOT_FINISHED == usb_host_stream_start(stream_hdl));
+            test_complete_urbs(TEST_NUM_TRANSFERS - 1, USB_TRANSFER_STATUS_CANCELED);
+            REQUIRE(ESP_OK == usb_host_client_handle_events(client_hdl, 0));
+            REQUIRE(test_inflight.empty());
+            REQUIRE(ESP_OK == usb_host_stream_start(stream_hdl));
+            REQUIRE(ESP_OK == usb_host_stream_stop(stream_hdl));
+            test_complete_urbs(TEST_NUM_TRANSFERS, USB_TRANSFER_STATUS_COMPLETED);
+            REQUIRE(ESP_OK == usb_host_client_handle_events(client_hdl, 0));
+        }
+
+        REQUIRE(ESP_OK == usb_host_stream_free(stream_hdl));
+    }
+
+    // Release everything and uninstall the USB Host driver
+    usbh_ep_free_ExpectAnyArgsAndReturn(ESP_OK);
+    usbh_ep_free_ExpectAnyArgsAndReturn(ESP_OK);
+    REQUIRE(ESP_OK == usb_host_interface_release(client_hdl, dev_hdl, 0));
+    usbh_dev_close_ExpectAndReturn(test_dev_hdl, ESP_OK);
+    REQUIRE(ESP_OK == usb_host_device_close(client_hdl, dev_hdl));
+    REQUIRE(ESP_OK == usb_host_client_deregister(client_hdl));
+    uint32_t event_flags;
+    REQUIRE(ESP_OK == usb_host_lib_handle_events(0, &event_flags));
+    REQUIRE(USB_HOST_LIB_EVENT_FLAGS_NO_CLIENTS == event_flags);
+
+    hub_root_stop_ExpectAndReturn(ESP_OK);
+    hub_uninstall_ExpectAndReturn(ESP_OK);
+    enum_uninstall_ExpectAndReturn(ESP_OK);
+    usbh_uninstall_ExpectAndReturn(ESP_OK);
+    hcd_uninstall_ExpectAndReturn(ESP_OK);
+    REQUIRE(ESP_OK == usb_host_uninstall());
+}
@@ -36,6 +36,15 @@ extern "C" {
  */
 typedef struct usb_host_client_handle_s *usb_host_client_handle_t;
 
+/**
+ * @brief Handle to a streaming endpoint
+ *
+ * A streaming endpoint can be allocated using usb_host_stream_alloc()
+ *
+ * @note Asynchronous API
+ */
+typedef struct usb_host_stream_handle_s *usb_host_stream_handle_t;
+
 // ----------------------- Events --------------------------
 
 #define USB_HOST_LIB_EVENT_FLAGS_NO_CLIENTS     0x01    /**< All clients have been deregistered from the USB Host Library */
@@ -93,6 +102,20 @@ typedef struct {
  */
 typedef void (*usb_host_client_event_cb_t)(const usb_host_client_event_msg_t *event_msg, void *arg);
 
+/**
+ * @brief Streaming endpoint callback
+ *
+ * - Called with all the transfers of a stream that completed since the previous call, in completion order
+ * - The stream callback is run from the context of the clients usb_host_client_handle_events() function
+ * - The transfers are re-submitted when the callback returns, so their data must be consumed within the callback
+ *
+ * @param[in] stream_hdl Stream handle
+ * @param[in] transfers Completed transfers
+ * @param[in] num_transfers Number of completed transfers
+ * @param[in] arg Stream callback argument
+ */
+typedef void (*usb_host_stream_cb_t)(usb_host_stream_handle_t stream_hdl, usb_transfer_t **transfers, int num_transfers, void *arg);
+
 // -------------------- Configurations ---------------------
 
 /**
@@ -146,6 +169,20 @@ typedef struct {
     };
 } usb_host_client_config_t;
 
+/**
+ * @brief Streaming endpoint configuration
+ *
+ * Configuration structure of a streaming endpoint. Provided in usb_host_stream_alloc()
+ */
+typedef struct {
+    usb_device_handle_t device_handle;  /**< Device of the endpoint */
+    uint8_t bEndpointAddress;           /**< Address of a bulk or interrupt IN endpoint of a claimed interface */
+    int num_transfers;                  /**< Number of transfers kept in-flight on the endpoint */
+    size_t transfer_size;               /**< Size of each transfer. Must be a multiple of the endpoint's MPS */
+    usb_host_stream_cb_t callback;      /**< Stream callback function */
+    void *callback_arg;                 /**< Stream callback function argument */
+} usb_host_stream_config_t;
+
 // ------------------------------------------------ Library Functions --------------------------------------------------
 
 /**
@@ -506,6 +543,7 @@ esp_err_t usb_host_interface_claim(usb_host_client_handle_t client_hdl, usb_devi
  *
  * - A client should release a device's interface after it no longer needs to communicate with the interface
  * - A client must release all of its interfaces of a device it has claimed before being able to close the device
+ * - The streams allocated on the interface's endpoints must be freed before releasing the interface
  *
  * @note This function can block
  * @param[in] client_hdl Client handle
@@ -628,7 +666,7 @@ esp_err_t usb_host_transfer_free(usb_transfer_t *transfer);
  *    - ESP_ERR_INVALID_ARG: Invalid argument
  *    - ESP_ERR_NOT_FINISHED: Transfer already in-flight
  *    - ESP_ERR_NOT_FOUND: Endpoint address not found
- *    - ESP_ERR_INVALID_STATE: Endpoint pipe is not in a correct state to submit transfer
+ *    - ESP_ERR_INVALID_STATE: Endpoint pipe is not in a correct state to submit transfer, or the endpoint is streaming
  */
 esp_err_t usb_host_transfer_submit(usb_transfer_t *transfer);
 
@@ -652,6 +690,75 @@ esp_err_t usb_host_transfer_submit(usb_transfer_t *transfer);
  */
 esp_err_t usb_host_transfer_submit_control(usb_host_client_handle_t client_hdl, usb_transfer_t *transfer);
 
+// -------------------------------------------------- Streaming I/O ----------------------------------------------------
+
+/**
+ * @brief Allocate a streaming endpoint
+ *
+ * - A stream owns a ring of transfers that are allocated once and kept in-flight on an IN endpoint
+ * - Completed transfers are delivered in batches to the stream callback, then automatically re-submitted
+ * - The client must have claimed the endpoint's interface. The endpoint must not have other transfers in-flight
+ * - While the stream is allocated, usb_host_transfer_submit() can't be used on the endpoint
+ *
+ * @param[in] config Stream configuration
+ * @param[out] stream_hdl_ret Stream handle
+ *
+ * @return
+ *    - ESP_OK: Stream allocated successfully
+ *    - ESP_ERR_INVALID_ARG: Invalid argument
+ *    - ESP_ERR_NOT_FOUND: Endpoint address not found
+ *    - ESP_ERR_NOT_SUPPORTED: The endpoint is not a bulk or interrupt IN endpoint
+ *    - ESP_ERR_INVALID_STATE: The endpoint already has a stream or transfers in-flight
+ *    - ESP_ERR_NO_MEM: Insufficient memory
+ */
+esp_err_t usb_host_stream_alloc(const usb_host_stream_config_t *config, usb_host_stream_handle_t *stream_hdl_ret);
+
+/**
+ * @brief Free a streaming endpoint
+ *
+ * - The stream must be stopped and all of its transfers must have been delivered to the stream callback
+ *
+ * @param[in] stream_hdl Stream handle
+ *
+ * @return
+ *    - ESP_OK: Stream freed successfully
+ *    - ESP_ERR_INVALID_ARG: Invalid argument
+ *    - ESP_ERR_INVALID_STATE: The stream is running or has transfers in-flight
+ */
+esp_err_t usb_host_stream_free(usb_host_stream_handle_t stream_hdl);
+
+/**
+ * @brief Start a streaming endpoint
+ *
+ * - Submits all the transfers of the stream
+ * - A transfer that completes with an error is not re-submitted and stops the stream. After clearing the endpoint with
+ *   usb_host_endpoint_clear(), the stream can be started again once all of its transfers have been delivered
+ *
+ * @param[in] stream_hdl Stream handle
+ *
+ * @return
+ *    - ESP_OK: Stream started successfully
+ *    - ESP_ERR_INVALID_ARG: Invalid argument
+ *    - ESP_ERR_NOT_FINISHED: The stream still has transfers in-flight
+ *    - ESP_ERR_INVALID_STATE: Endpoint pipe is not in a correct state to submit transfers
+ */
+esp_err_t usb_host_stream_start(usb_host_stream_handle_t stream_hdl);
+
+/**
+ * @brief Stop a streaming endpoint
+ *
+ * - Transfers are no longer re-submitted after their completion
+ * - Transfers already in-flight are still delivered to the stream callback. To retire them immediately, halt and flush
+ *   the endpoint using usb_host_endpoint_halt() and usb_host_endpoint_flush()
+ *
+ * @param[in] stream_hdl Stream handle
+ *
+ * @return
+ *    - ESP_OK: Stream stopped successfully
+ *    - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t usb_host_stream_stop(usb_host_stream_handle_t stream_hdl);
+
 #ifdef __cplusplus
 }
 #endif
@@ -59,6 +59,7 @@ DEFINE_CRIT_SECTION_LOCK_STATIC(host_lock);
 typedef struct ep_wrapper_s ep_wrapper_t;
 typedef struct interface_s interface_t;
 typedef struct client_s client_t;
+typedef struct stream_s stream_t;
 
 struct ep_wrapper_s {
     // Dynamic members require a critical section
@@ -72,14 +73,38 @@ struct ep_wrapper_s {
         } flags;
         uint32_t num_urb_inflight;
         usbh_ep_event_t last_event;
+        stream_t *stream;           // Stream re-submitting the endpoint's URBs. NULL if the endpoint is not streaming
     } dynamic;
     // Constant members do no change after claiming the interface thus do not require a critical section
     struct {
         usbh_ep_handle_t ep_hdl;
+        const usb_ep_desc_t *ep_desc;
         interface_t *intf_obj;
     } constant;
 };
 
+struct stream_s {
+    // Dynamic members require a critical section
+    struct {
+        union {
+            struct {
+                uint32_t running: 1;
+                uint32_t reserved31: 31;
+            };
+        } flags;
+    } dynamic;
+    // Constant members do no change after allocation thus do not require a critical section
+    struct {
+        ep_wrapper_t *ep_wrap;
+        usb_host_stream_cb_t callback;
+        void *callback_arg;
+        size_t transfer_size;
+        usb_transfer_t **batch;     // Completed transfers passed to the callback
+        int num_urbs;
+        urb_t *urbs[0];
+    } constant;
+};
+
 struct interface_s {
     // Dynamic members require a critical section
     struct {
@@ -755,6 +780,58 @@ esp_err_t usb_host_lib_set_root_port_power(bool enable)
 
 // ----------------------- Private -------------------------
 
+static void _handle_stream_urbs(stream_t *stream_obj, uint32_t *num_urb_dequeued_ret, uint32_t *num_urb_rearmed_ret)
+{
+    usbh_ep_handle_t ep_hdl = stream_obj->constant.ep_wrap->constant.ep_hdl;
+    int num_done = 0;
+    bool error = false;
+    // Dequeue all URBs completed since the last call so that they are delivered in a single callback
+    urb_t *urb;
+    usbh_ep_dequeue_urb(ep_hdl, &urb);
+    while (urb != NULL) {
+        assert(num_done < stream_obj->constant.num_urbs);
+        urb->usb_host_inflight = false;
+        if (urb->transfer.status != USB_TRANSFER_STATUS_COMPLETED) {
+            error = true;
+        }
+        stream_obj->constant.batch[num_done++] = &urb->transfer;
+        usbh_ep_dequeue_urb(ep_hdl, &urb);
+    }
+    *num_urb_dequeued_ret = num_done;
+    *num_urb_rearmed_ret = 0;
+    if (num_done == 0) {
+        return;
+    }
+    stream_obj->constant.callback((usb_host_stream_handle_t)stream_obj, stream_obj->constant.batch, num_done, stream_obj->constant.callback_arg);
+
+    HOST_ENTER_CRITICAL();
+    // A failed transfer stops the stream. The endpoint must be cleared before restarting it
+    if (error) {
+        stream_obj->dynamic.flags.running = 0;
+    }
+    bool running = stream_obj->dynamic.flags.running;
+    HOST_EXIT_CRITICAL();
+    if (!running) {
+        return;
+    }
+    // Re-submit the delivered URBs in the same order, so that they are always in-flight
+    for (int i = 0; i < num_done; i++) {
+        urb = __containerof(stream_obj->constant.batch[i], urb_t, transfer);
+        urb->transfer.num_bytes = stream_obj->constant.transfer_size;
+        urb->usb_host_inflight = true;
+        esp_err_t ret = usbh_ep_enqueue_urb(ep_hdl, urb);
+        if (ret != ESP_OK) {
+            ESP_LOGE(USB_HOST_TAG, "Enqueue URB error: %s", esp_err_to_name(ret));
+            urb->usb_host_inflight = false;
+            HOST_ENTER_CRITICAL();
+            stream_obj->dynamic.flags.running = 0;
+            HOST_EXIT_CRITICAL();
+            break;
+        }
+        (*num_urb_rearmed_ret)++;
+    }
+}
+
 static void _handle_pending_ep(client_t *client_obj)
 {
     // Handle each EP on the pending list
@@ -765,7 +842,9 @@ static void _handle_pending_ep(client_t *client_obj)
         TAILQ_INSERT_TAIL(&client_obj->dynamic.idle_ep_tailq, ep_wrap, dynamic.tailq_entry);
         ep_wrap->dynamic.flags.pending = 0;
         usbh_ep_event_t last_event = ep_wrap->dynamic.last_event;
+        stream_t *stream_obj = ep_wrap->dynamic.stream;
         uint32_t num_urb_dequeued = 0;
+        uint32_t num_urb_rearmed = 0;
 
         HOST_EXIT_CRITICAL();
         // Handle pipe event
@@ -779,6 +858,11 @@ static void _handle_pending_ep(client_t *client_obj)
             // All URBs in this pipe are now retired waiting to be dequeued. Fall through to dequeue them
             __attribute__((fallthrough));
         case USBH_EP_EVENT_URB_DONE: {
+            if (stream_obj != NULL) {
+                // Streaming endpoint. Deliver all URBs in one callback then re-submit them
+                _handle_stream_urbs(stream_obj, &num_urb_dequeued, &num_urb_rearmed);
+                break;
+            }
             // Dequeue all URBs and run their transfer callback
             urb_t *urb;
             usbh_ep_dequeue_urb(ep_wrap->constant.ep_hdl, &urb);
@@ -800,6 +884,7 @@ static void _handle_pending_ep(client_t *client_obj)
         // Update the endpoint's number of URB's in-flight
         assert(num_urb_dequeued <= ep_wrap->dynamic.num_urb_inflight);
         ep_wrap->dynamic.num_urb_inflight -= num_urb_dequeued;
+        ep_wrap->dynamic.num_urb_inflight += num_urb_rearmed;
     }
 }
 
@@ -1266,6 +1351,7 @@ static esp_err_t ep_wrapper_alloc(usb_device_handle_t dev_hdl, const usb_ep_desc
     }
     // Initialize endpoint wrapper item
     ep_wrap->constant.ep_hdl = ep_hdl;
+    ep_wrap->constant.ep_desc = ep_desc;
     ep_wrap->constant.intf_obj = intf_obj;
     // Write back result
     *ep_wrap_ret = ep_wrap;
@@ -1393,8 +1479,8 @@ static esp_err_t interface_release(client_t *client_obj, usb_device_handle_t dev
     bool can_free = true;
     for (int i = 0; i < intf_obj->constant.intf_desc->bNumEndpoints; i++) {
         ep_wrapper_t *ep_wrap = intf_obj->constant.endpoints[i];
-        // Endpoint must not be on the pending list and must not have in-flight URBs
-        if (ep_wrap->dynamic.num_urb_inflight != 0 || ep_wrap->dynamic.flags.pending) {
+        // Endpoint must not be on the pending list, must not have in-flight URBs and must not be streaming
+        if (ep_wrap->dynamic.num_urb_inflight != 0 || ep_wrap->dynamic.flags.pending || ep_wrap->dynamic.stream != NULL) {
             can_free = false;
             break;
         }
@@ -1607,10 +1693,12 @@ esp_err_t usb_host_transfer_submit(usb_transfer_t *transfer)
     assert(ep_wrap != NULL);
     // Check that we are not submitting a transfer already in-flight
     HOST_CHECK(!urb_obj->usb_host_inflight, ESP_ERR_NOT_FINISHED);
-    urb_obj->usb_host_inflight = true;
     HOST_ENTER_CRITICAL();
+    // The URBs of a streaming endpoint are only submitted by its stream
+    HOST_CHECK_FROM_CRIT(ep_wrap->dynamic.stream == NULL, ESP_ERR_INVALID_STATE);
     ep_wrap->dynamic.num_urb_inflight++;
     HOST_EXIT_CRITICAL();
+    urb_obj->usb_host_inflight = true;
 
     ret = usbh_ep_enqueue_urb(ep_hdl, urb_obj);
     if (ret != ESP_OK) {
@@ -1652,3 +1740,151 @@ esp_err_t usb_host_transfer_submit_control(usb_host_client_handle_t client_hdl,
     }
     return ret;
 }
+
+// -------------------------------------------------- Streaming I/O ----------------------------------------------------
+
+// ----------------------- Private -------------------------
+
+static void stream_transfer_cb(usb_transfer_t *transfer)
+{
+    // Stream URBs are delivered by _handle_stream_urbs(), never through their transfer callback
+    abort();
+}
+
+static void stream_free(stream_t *stream_obj)
+{
+    for (int i = 0; i < stream_obj->constant.num_urbs; i++) {
+        urb_free(stream_obj->constant.urbs[i]);
+    }
+    heap_caps_free(stream_obj->constant.batch);
+    heap_caps_free(stream_obj);
+}
+
+// ----------------------- Public --------------------------
+
+esp_err_t usb_host_stream_alloc(const usb_host_stream_config_t *config, usb_host_stream_handle_t *stream_hdl_ret)
+{
+    HOST_CHECK(config != NULL && stream_hdl_ret != NULL && config->callback != NULL, ESP_ERR_INVALID_ARG);
+    HOST_CHECK(config->device_handle != NULL && config->num_transfers > 0 && config->transfer_size > 0, ESP_ERR_INVALID_ARG);
+    HOST_CHECK((config->bEndpointAddress & USB_B_ENDPOINT_ADDRESS_EP_NUM_MASK) != 0, ESP_ERR_INVALID_ARG);
+
+    esp_err_t ret;
+    usbh_ep_handle_t ep_hdl;
+    ret = usbh_ep_get_handle(config->device_handle, config->bEndpointAddress, &ep_hdl);
+    if (ret != ESP_OK) {
+        print_error_ep_get_handle(ret);
+        return ret;
+    }
+    ep_wrapper_t *ep_wrap = usbh_ep_get_context(ep_hdl);
+    assert(ep_wrap != NULL);
+    // Only bulk and interrupt IN endpoints can be re-submitted without refilling their data
+    const usb_ep_desc_t *ep_desc = ep_wrap->constant.ep_desc;
+    usb_transfer_type_t type = USB_EP_DESC_GET_XFERTYPE(ep_desc);
+    HOST_CHECK(USB_EP_DESC_GET_EP_DIR(ep_desc) && (type == USB_TRANSFER_TYPE_BULK || type == USB_TRANSFER_TYPE_INTR), ESP_ERR_NOT_SUPPORTED);
+    // IN transfers must be an integer multiple of the endpoint's MPS
+    HOST_CHECK(USB_EP_DESC_GET_MPS(ep_desc) != 0 && config->transfer_size % USB_EP_DESC_GET_MPS(ep_desc) == 0, ESP_ERR_INVALID_ARG);
+
+    // Allocate stream object and its URBs
+    stream_t *stream_obj = heap_caps_calloc(1, sizeof(stream_t) + (sizeof(urb_t *) * config->num_transfers), MALLOC_CAP_DEFAULT);
+    if (stream_obj == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    stream_obj->constant.num_urbs = config->num_transfers;
+    stream_obj->constant.batch = heap_caps_calloc(config->num_transfers, sizeof(usb_transfer_t *), MALLOC_CAP_DEFAULT);
+    if (stream_obj->constant.batch == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto alloc_err;
+    }
+    for (int i = 0; i < config->num_transfers; i++) {
+        urb_t *urb = urb_alloc(config->transfer_size, 0);
+        if (urb == NULL) {
+            ret = ESP_ERR_NO_MEM;
+            goto alloc_err;
+        }
+        urb->transfer.device_handle = config->device_handle;
+        urb->transfer.bEndpointAddress = config->bEndpointAddress;
+        urb->transfer.callback = stream_transfer_cb;
+        urb->transfer.context = (void *)stream_obj;
+        stream_obj->constant.urbs[i] = urb;
+    }
+    stream_obj->constant.ep_wrap = ep_wrap;
+    stream_obj->constant.callback = config->callback;
+    stream_obj->constant.callback_arg = config->callback_arg;
+    stream_obj->constant.transfer_size = config->transfer_size;
+
+    // Attach the stream to the endpoint. The endpoint must not be used by other transfers
+    HOST_ENTER_CRITICAL();
+    if (ep_wrap->dynamic.stream != NULL || ep_wrap->dynamic.num_urb_inflight != 0) {
+        HOST_EXIT_CRITICAL();
+        ret = ESP_ERR_INVALID_STATE;
+        goto alloc_err;
+    }
+    ep_wrap->dynamic.stream = stream_obj;
+    HOST_EXIT_CRITICAL();
+
+    *stream_hdl_ret = (usb_host_stream_handle_t)stream_obj;
+    return ESP_OK;
+
+alloc_err:
+    stream_free(stream_obj);
+    return ret;
+}
+
+esp_err_t usb_host_stream_free(usb_host_stream_handle_t stream_hdl)
+{
+    HOST_CHECK(stream_hdl != NULL, ESP_ERR_INVALID_ARG);
+    stream_t *stream_obj = (stream_t *)stream_hdl;
+    ep_wrapper_t *ep_wrap = stream_obj->constant.ep_wrap;
+
+    HOST_ENTER_CRITICAL();
+    HOST_CHECK_FROM_CRIT(!stream_obj->dynamic.flags.running && ep_wrap->dynamic.num_urb_inflight == 0, ESP_ERR_INVALID_STATE);
+    ep_wrap->dynamic.stream = NULL;
+    HOST_EXIT_CRITICAL();
+
+    stream_free(stream_obj);
+    return ESP_OK;
+}
+
+esp_err_t usb_host_stream_start(usb_host_stream_handle_t stream_hdl)
+{
+    HOST_CHECK(stream_hdl != NULL, ESP_ERR_INVALID_ARG);
+    stream_t *stream_obj = (stream_t *)stream_hdl;
+    ep_wrapper_t *ep_wrap = stream_obj->constant.ep_wrap;
+    const int num_urbs = stream_obj->constant.num_urbs;
+
+    HOST_ENTER_CRITICAL();
+    // All URBs of the stream must have been delivered before it is started again
+    HOST_CHECK_FROM_CRIT(!stream_obj->dynamic.flags.running && ep_wrap->dynamic.num_urb_inflight == 0, ESP_ERR_NOT_FINISHED);
+    stream_obj->dynamic.flags.running = 1;
+    ep_wrap->dynamic.num_urb_inflight += num_urbs;
+    HOST_EXIT_CRITICAL();
+
+    for (int i = 0; i < num_urbs; i++) {
+        urb_t *urb = stream_obj->constant.urbs[i];
+        urb->transfer.num_bytes = stream_obj->constant.transfer_size;
+        urb->usb_host_inflight = true;
+        esp_err_t ret = usbh_ep_enqueue_urb(ep_wrap->constant.ep_hdl, urb);
+        if (ret != ESP_OK) {
+            ESP_LOGE(USB_HOST_TAG, "Enqueue URB error: %s", esp_err_to_name(ret));
+            urb->usb_host_inflight = false;
+            // URBs already enqueued will still be delivered, but not re-submitted
+            HOST_ENTER_CRITICAL();
+            stream_obj->dynamic.flags.running = 0;
+            ep_wrap->dynamic.num_urb_inflight -= num_urbs - i;
+            HOST_EXIT_CRITICAL();
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t usb_host_stream_stop(usb_host_stream_handle_t stream_hdl)
+{
+    HOST_CHECK(stream_hdl != NULL, ESP_ERR_INVALID_ARG);
+    stream_t *stream_obj = (stream_t *)stream_hdl;
+
+    HOST_ENTER_CRITICAL();
+    stream_obj->dynamic.flags.running = 0;
+    HOST_EXIT_CRITICAL();
+    return ESP_OK;
+}
@@ -17,6 +17,11 @@
 #include "esp_hostap.h"
 #include <inttypes.h>
 #include "common/defs.h"
+#ifdef CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE
+#include "crypto/crypto.h"
+#include "crypto/sha256.h"
+#include "nvs.h"
+#endif /* CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE */
 
 #ifdef CONFIG_SAE_H2E
 static struct sae_pt *g_sae_pt;
@@ -27,6 +32,221 @@ static struct wpabuf *g_sae_commit = NULL;
 static struct wpabuf *g_sae_confirm = NULL;
 int g_allowed_groups[] = { IANA_SECP256R1, 0 };
 
+#ifdef CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE
+#define SAE_PT_CACHE_NAMESPACE      "sae_pt"
+#define SAE_PT_CACHE_MAX_ENTRIES    CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE_ENTRIES
+/* Entries are stored under "pt" + 6 hex digits identifying (SSID, group) + 6 hex digits identifying
+ * the credentials, so that a configuration change of a network replaces its previous entry */
+#define SAE_PT_CACHE_NET_ID_LEN     3
+#define SAE_PT_CACHE_KEY_ID_LEN     3
+#define SAE_PT_CACHE_NET_PREFIX_LEN (2 + 2 * SAE_PT_CACHE_NET_ID_LEN)
+
+/* Blob layout: SHA-256 of the inputs of the PT derivation, followed by the element */
+struct sae_pt_cache_blob {
+    u8 hash[SHA256_MAC_LEN];
+    u8 element[2 * SAE_MAX_ECC_PRIME_LEN];
+};
+
+static int wpa3_sae_pt_cache_key(int group, const u8 *ssid, size_t ssid_len,
+                                 const u8 *password, size_t password_len,
+                                 const char *identifier, u8 *hash, char *key)
+{
+    u8 group_be[2];
+    u8 net_hash[SHA256_MAC_LEN];
+    u8 ssid_len_u8 = ssid_len;
+    u8 pw_len_be[2];
+    const u8 *addr[6];
+    size_t len[6];
+
+    WPA_PUT_BE16(group_be, group);
+    WPA_PUT_BE16(pw_len_be, password_len);
+
+    addr[0] = group_be;
+    len[0] = sizeof(group_be);
+    addr[1] = &ssid_len_u8;
+    len[1] = 1;
+    addr[2] = ssid;
+    len[2] = ssid_len;
+    if (sha256_vector(3, addr, len, net_hash) < 0) {
+        return -1;
+    }
+
+    /* Length prefix the password so that it cannot run into the identifier */
+    addr[3] = pw_len_be;
+    len[3] = sizeof(pw_len_be);
+    addr[4] = password;
+    len[4] = password_len;
+    addr[5] = (const u8 *)identifier;
+    len[5] = identifier ? os_strlen(identifier) : 0;
+    if (sha256_vector(6, addr, len, hash) < 0) {
+        return -1;
+    }
+
+    os_snprintf(key, NVS_KEY_NAME_MAX_SIZE, "pt%02x%02x%02x%02x%02x%02x",
+                net_hash[0], net_hash[1], net_hash[2], hash[0], hash[1], hash[2]);
+    forced_memzero(net_hash, sizeof(net_hash));
+    return 0;
+}
+
+static struct sae_pt *wpa3_sae_pt_cache_load(int group, const u8 *ssid, size_t ssid_len,
+                                             const u8 *hash, const char *key)
+{
+    nvs_handle_t handle;
+    struct sae_pt_cache_blob *blob;
+    struct sae_pt *pt = NULL;
+    size_t len = sizeof(*blob);
+    esp_err_t err;
+
+    if (nvs_open(SAE_PT_CACHE_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return NULL;
+    }
+
+    blob = os_zalloc(sizeof(*blob));
+    if (!blob) {
+        nvs_close(handle);
+        return NULL;
+    }
+
+    err = nvs_get_blob(handle, key, blob, &len);
+    nvs_close(handle);
+    if (err == ESP_OK && len > SHA256_MAC_LEN &&
+            os_memcmp_const(blob->hash, hash, SHA256_MAC_LEN) == 0) {
+        pt = sae_pt_from_bin(group, ssid, ssid_len, blob->element, len - SHA256_MAC_LEN);
+    }
+    bin_clear_free(blob, sizeof(*blob));
+
+    if (err == ESP_OK && !pt) {
+        wpa_printf(MSG_INFO, "wpa3: discarding invalid cached PT %s", key);
+        if (nvs_open(SAE_PT_CACHE_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+            nvs_erase_key(handle, key);
+            nvs_commit(handle);
+            nvs_close(handle);
+        }
+    }
+    return pt;
+}
+
+static void wpa3_sae_pt_cache_evict(nvs_handle_t handle, const char *key)
+{
+    nvs_iterator_t it = NULL;
+    nvs_entry_info_t info;
+    char stale[SAE_PT_CACHE_MAX_ENTRIES][NVS_KEY_NAME_MAX_SIZE];
+    int n_stale = 0;
+    int n_entries = 0;
+    bool overflow = false;
+    esp_err_t err;
+
+    for (err = nvs_entry_find_in_handle(handle, NVS_TYPE_BLOB, &it); err == ESP_OK;
+            err = nvs_entry_next(&it)) {
+        nvs_entry_info(it, &info);
+        if (os_strcmp(info.key, key) == 0) {
+            continue;
+        }
+        n_entries++;
+        /* Previous credentials of the same network */
+        if (os_strncmp(info.key, key, SAE_PT_CACHE_NET_PREFIX_LEN) == 0) {
+            if (n_stale < SAE_PT_CACHE_MAX_ENTRIES) {
+                os_strlcpy(stale[n_stale++], info.key, NVS_KEY_NAME_MAX_SIZE);
+            } else {
+                overflow = true;
+            }
+        }
+    }
+    nvs_release_iterator(it);
+
+    if (overflow || n_entries - n_stale >= SAE_PT_CACHE_MAX_ENTRIES) {
+        nvs_erase_all(handle);
+        return;
+    }
+    for (int i = 0; i < n_stale; i++) {
+        nvs_erase_key(handle, stale[i]);
+    }
+}
+
+static void wpa3_sae_pt_cache_store(const struct sae_pt *pt, const u8 *hash, const char *key)
+{
+    nvs_handle_t handle;
+    struct sae_pt_cache_blob *blob;
+    int len;
+
+    blob = os_zalloc(sizeof(*blob));
+    if (!blob) {
+        return;
+    }
+
+    len = sae_pt_to_bin(pt, blob->element, sizeof(blob->element));
+    if (len < 0 || nvs_open(SAE_PT_CACHE_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        bin_clear_free(blob, sizeof(*blob));
+        return;
+    }
+    os_memcpy(blob->hash, hash, SHA256_MAC_LEN);
+
+    wpa3_sae_pt_cache_evict(handle, key);
+    if (nvs_set_blob(handle, key, blob, SHA256_MAC_LEN + len) != ESP_OK ||
+            nvs_commit(handle) != ESP_OK) {
+        wpa_printf(MSG_DEBUG, "wpa3: failed to store PT %s", key);
+    }
+    nvs_close(handle);
+    bin_clear_free(blob, sizeof(*blob));
+}
+
+struct sae_pt *wpa3_sae_pt_cache_derive(int *groups, const u8 *ssid, size_t ssid_len,
+                                        const u8 *password, size_t password_len,
+                                        const char *identifier, int *n_loaded)
+{
+    struct sae_pt *pt = NULL, *last = NULL, *tmp;
+    u8 hash[SHA256_MAC_LEN];
+    char key[NVS_KEY_NAME_MAX_SIZE];
+
+    for (int i = 0; groups[i] > 0; i++) {
+        int group[] = { groups[i], 0 };
+
+        if (wpa3_sae_pt_cache_key(groups[i], ssid, ssid_len, password, password_len,
+                                  identifier, hash, key) < 0) {
+            continue;
+        }
+        tmp = wpa3_sae_pt_cache_load(groups[i], ssid, ssid_len, hash, key);
+        if (tmp) {
+            wpa_printf(MSG_DEBUG, "wpa3: using cached PT for group %d", groups[i]);
+            if (n_loaded) {
+                (*n_loaded)++;
+            }
+        } else {
+            tmp = sae_derive_pt(group, ssid, ssid_len, password, password_len, identifier);
+            if (tmp) {
+                wpa3_sae_pt_cache_store(tmp, hash, key);
+            }
+        }
+        forced_memzero(hash, sizeof(hash));
+        if (!tmp) {
+            continue;
+        }
+
+        if (last) {
+            last->next = tmp;
+        } else {
+            pt = tmp;
+        }
+        last = tmp;
+    }
+
+    return pt;
+}
+#endif /* CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE */
+
+#ifdef CONFIG_SAE_H2E
+static struct sae_pt *wpa3_derive_sae_pt(int *groups, const u8 *ssid, size_t ssid_len,
+                                         const u8 *password, size_t password_len,
+                                         const char *identifier)
+{
+#ifdef CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE
+    return wpa3_sae_pt_cache_derive(groups, ssid, ssid_len, password, password_len, identifier, NULL);
+#else
+    return sae_derive_pt(groups, ssid, ssid_len, password, password_len, identifier);
+#endif /* CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE */
+}
+#endif /* CONFIG_SAE_H2E */
+
 static esp_err_t wpa3_build_sae_commit(u8 *bssid, size_t *sae_msg_len)
 {
     int default_group = IANA_SECP256R1;
@@ -93,7 +313,7 @@ static esp_err_t wpa3_build_sae_commit(u8 *bssid, size_t *sae_msg_len)
     }
 
     if (use_pt && !g_sae_pt) {
-        g_sae_pt = sae_derive_pt(g_allowed_groups, ssid->ssid, ssid->len, pw, strlen((const char *)pw), valid_pwd_id ? sae_pwd_id : NULL);
+        g_sae_pt = wpa3_derive_sae_pt(g_allowed_groups, ssid->ssid, ssid->len, pw, strlen((const char *)pw), valid_pwd_id ? sae_pwd_id : NULL);
     }
 #endif /* CONFIG_SAE_H2E */
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,6 +13,14 @@
 void esp_wifi_register_wpa3_cb(struct wpa_funcs *wpa_cb);
 void esp_wpa3_free_sae_data(void);
 
+#ifdef CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE
+/* Get the PTs of the given groups from the NVS cache, deriving and storing the missing ones.
+ * n_loaded, if not NULL, is incremented for each PT loaded from the cache. */
+struct sae_pt *wpa3_sae_pt_cache_derive(int *groups, const u8 *ssid, size_t ssid_len,
+                                        const u8 *password, size_t password_len,
+                                        const char *identifier, int *n_loaded);
+#endif /* CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE */
+
 #else /* CONFIG_WPA3_SAE */
 
 static inline void esp_wifi_register_wpa3_cb(struct wpa_funcs *wpa_cb)
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -20,4 +20,8 @@
 #define SCAN_CACHE_SUPPORTED
 #endif
 
+#ifdef CONFIG_ESP_WIFI_BSS_MAX_COUNT
+#define MAX_BSS_COUNT CONFIG_ESP_WIFI_BSS_MAX_COUNT
+#endif
+
 #endif /* _SUPPLICANT_OPT_H */
@@ -20,7 +20,35 @@
 #include "esp_wifi_driver.h"
 #endif
 
+#ifndef MAX_BSS_COUNT
 #define MAX_BSS_COUNT 20
+#endif
+
+/* The last octets of the BSSID differ the most between neighboring BSSes */
+#define WPA_BSS_HASH(bssid) \
+	(((bssid)[3] ^ (bssid)[4] ^ (bssid)[5]) & (WPA_BSS_HASH_SIZE - 1))
+
+static void wpa_bss_hash_add(struct wpa_supplicant *wpa_s, struct wpa_bss *bss)
+{
+	struct wpa_bss **head = &wpa_s->bss_hash[WPA_BSS_HASH(bss->bssid)];
+
+	bss->hash_next = *head;
+	*head = bss;
+}
+
+static void wpa_bss_hash_del(struct wpa_supplicant *wpa_s, struct wpa_bss *bss)
+{
+	struct wpa_bss **pos = &wpa_s->bss_hash[WPA_BSS_HASH(bss->bssid)];
+
+	while (*pos) {
+		if (*pos == bss) {
+			*pos = bss->hash_next;
+			bss->hash_next = NULL;
+			return;
+		}
+		pos = &(*pos)->hash_next;
+	}
+}
 
 void wpa_bss_remove(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 		    const char *reason)
@@ -40,6 +68,7 @@ void wpa_bss_remove(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 	}
 	dl_list_del(&bss->list);
 	dl_list_del(&bss->list_id);
+	wpa_bss_hash_del(wpa_s, bss);
 	wpa_s->num_bss--;
 	wpa_dbg(wpa_s, MSG_DEBUG, "BSS: Remove id %u BSSID " MACSTR
 		" SSID '%s' due to %s", bss->id, MAC2STR(bss->bssid),
@@ -60,7 +89,9 @@ struct wpa_bss * wpa_bss_get(struct wpa_supplicant *wpa_s, const u8 *bssid,
 			     const u8 *ssid, size_t ssid_len)
 {
 	struct wpa_bss *bss;
-	dl_list_for_each(bss, &wpa_s->bss, struct wpa_bss, list) {
+
+	for (bss = wpa_s->bss_hash[WPA_BSS_HASH(bssid)]; bss;
+	     bss = bss->hash_next) {
 		if (os_memcmp(bss->bssid, bssid, ETH_ALEN) == 0 &&
 		    bss->ssid_len == ssid_len &&
 		    os_memcmp(bss->ssid, ssid, ssid_len) == 0)
@@ -203,6 +234,7 @@ static struct wpa_bss * wpa_bss_add(struct wpa_supplicant *wpa_s,
 
 	dl_list_add_tail(&wpa_s->bss, &bss->list);
 	dl_list_add_tail(&wpa_s->bss_id, &bss->list_id);
+	wpa_bss_hash_add(wpa_s, bss);
 	wpa_s->num_bss++;
 	wpa_dbg(wpa_s, MSG_INFO, "BSS: Add new id %u BSSID " MACSTR
 		" SSID '%s' chan %d",
@@ -215,7 +247,10 @@ static struct wpa_bss *
 wpa_bss_update(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 	       struct wpa_scan_res *res, struct os_reltime *fetch_time)
 {
-	if (bss->last_update_idx == wpa_s->bss_update_idx) {
+	/* Only entries already updated in this round are in last_scan_res */
+	int in_last_scan_res = bss->last_update_idx == wpa_s->bss_update_idx;
+
+	if (in_last_scan_res) {
 		struct os_reltime update_time;
 
 		/*
@@ -233,9 +268,10 @@ wpa_bss_update(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 			   "Accept this BSS entry since it looks more current than the previous update");
 	}
 
+	/* Move the entry to the end of the list and the head of its bucket */
+	wpa_bss_hash_del(wpa_s, bss);
 	bss->last_update_idx = wpa_s->bss_update_idx;
 	wpa_bss_copy_res(bss, res, fetch_time);
-	/* Move the entry to the end of the list */
 	dl_list_del(&bss->list);
 	if (bss->ie_len + bss->beacon_ie_len >=
 	    res->ie_len + res->beacon_ie_len) {
@@ -250,7 +286,8 @@ wpa_bss_update(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 				  res->beacon_ie_len);
 		if (nbss) {
 			unsigned int i;
-			for (i = 0; i < wpa_s->last_scan_res_used; i++) {
+			for (i = 0; in_last_scan_res &&
+				    i < wpa_s->last_scan_res_used; i++) {
 				if (wpa_s->last_scan_res[i] == bss) {
 					wpa_s->last_scan_res[i] = nbss;
 					break;
@@ -267,6 +304,7 @@ wpa_bss_update(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 		dl_list_add(prev, &bss->list_id);
 	}
 	dl_list_add_tail(&wpa_s->bss, &bss->list);
+	wpa_bss_hash_add(wpa_s, bss);
 
 	return bss;
 }
@@ -326,16 +364,15 @@ void wpa_bss_update_scan_res(struct wpa_supplicant *wpa_s,
 	if (bss == NULL)
 		bss = wpa_bss_add(wpa_s, ssid + 2, ssid[1], res, fetch_time);
 	else {
+		/*
+		 * An entry already updated in this round is already in the
+		 * last_scan_res list.
+		 */
+		int seen = bss->last_update_idx == wpa_s->bss_update_idx;
+
 		bss = wpa_bss_update(wpa_s, bss, res, fetch_time);
-		if (wpa_s->last_scan_res) {
-			unsigned int i;
-			for (i = 0; i < wpa_s->last_scan_res_used; i++) {
-				if (bss == wpa_s->last_scan_res[i]) {
-					/* Already in the list */
-					return;
-				}
-			}
-		}
+		if (seen)
+			return;
 	}
 
 	if (bss == NULL)
@@ -387,6 +424,7 @@ int wpa_bss_init(struct wpa_supplicant *wpa_s)
 {
 	dl_list_init(&wpa_s->bss);
 	dl_list_init(&wpa_s->bss_id);
+	os_memset(wpa_s->bss_hash, 0, sizeof(wpa_s->bss_hash));
 	return 0;
 }
 
@@ -430,7 +468,10 @@ struct wpa_bss * wpa_bss_get_bssid(struct wpa_supplicant *wpa_s,
 				   const u8 *bssid)
 {
 	struct wpa_bss *bss;
-	dl_list_for_each_reverse(bss, &wpa_s->bss, struct wpa_bss, list) {
+
+	/* Buckets are kept in most recently updated first order */
+	for (bss = wpa_s->bss_hash[WPA_BSS_HASH(bssid)]; bss;
+	     bss = bss->hash_next) {
 		if (os_memcmp(bss->bssid, bssid, ETH_ALEN) == 0)
 			return bss;
 	}
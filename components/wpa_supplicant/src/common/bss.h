@@ -23,6 +23,8 @@ struct wpa_bss {
 	struct dl_list list;
 	/** List entry for struct wpa_supplicant::bss_id */
 	struct dl_list list_id;
+	/** Next entry in the same struct wpa_supplicant::bss_hash bucket */
+	struct wpa_bss *hash_next;
 	/** Unique identifier for this BSS entry */
 	unsigned int id;
 	/** Index of the last scan update */
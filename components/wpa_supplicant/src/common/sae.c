@@ -1073,6 +1073,93 @@ struct sae_pt * sae_derive_pt(int *groups, const u8 *ssid, size_t ssid_len,
 }
 
 
+/**
+ * sae_pt_to_bin - Write an ECC PT as binary data
+ * @pt: PT from sae_derive_pt(), only the first group of the list is written
+ * @buf: Buffer for the x and y coordinates, padded to the length of the prime
+ * @buf_len: Length of @buf in octets
+ * Returns: Number of octets written or -1 on failure (e.g., FFC group)
+ *
+ * This can be used to store a PT in a persistent cache, since deriving it
+ * again with sae_derive_pt() requires a costly hash-to-curve operation.
+ */
+int sae_pt_to_bin(const struct sae_pt *pt, u8 *buf, size_t buf_len)
+{
+	size_t prime_len;
+
+	if (!pt || !pt->ec || !pt->ecc_pt)
+		return -1;
+
+	prime_len = crypto_ec_prime_len(pt->ec);
+	if (buf_len < 2 * prime_len ||
+	    crypto_ec_point_to_bin(pt->ec, pt->ecc_pt, buf,
+				   buf + prime_len) < 0)
+		return -1;
+
+	return 2 * prime_len;
+}
+
+
+/**
+ * sae_pt_from_bin - Create an ECC PT from binary data
+ * @group: ECC group of the PT
+ * @ssid: SSID the PT was derived for
+ * @ssid_len: Length of @ssid in octets
+ * @buf: Binary data written by sae_pt_to_bin()
+ * @len: Length of @buf in octets
+ * Returns: PT or %NULL if the data is not a valid element of the group
+ */
+struct sae_pt * sae_pt_from_bin(int group, const u8 *ssid, size_t ssid_len,
+				const u8 *buf, size_t len)
+{
+	struct sae_pt *pt;
+	const struct crypto_bignum *prime;
+	u8 prime_bin[SAE_MAX_ECC_PRIME_LEN];
+	size_t prime_len;
+
+	if (ssid_len > 32)
+		return NULL;
+
+	pt = os_zalloc(sizeof(*pt));
+	if (!pt)
+		return NULL;
+#ifdef CONFIG_SAE_PK
+	os_memcpy(pt->ssid, ssid, ssid_len);
+	pt->ssid_len = ssid_len;
+#endif /* CONFIG_SAE_PK */
+
+	pt->group = group;
+	pt->ec = crypto_ec_init(group);
+	if (!pt->ec)
+		goto fail;
+
+	prime_len = crypto_ec_prime_len(pt->ec);
+	prime = crypto_ec_get_prime(pt->ec);
+	if (len != 2 * prime_len ||
+	    crypto_bignum_to_bin(prime, prime_bin, sizeof(prime_bin),
+				 prime_len) < 0)
+		goto fail;
+
+	/* x and y coordinates < p */
+	if (os_memcmp(buf, prime_bin, prime_len) >= 0 ||
+	    os_memcmp(buf + prime_len, prime_bin, prime_len) >= 0)
+		goto fail;
+
+	pt->ecc_pt = crypto_ec_point_from_bin(pt->ec, buf);
+	if (!pt->ecc_pt ||
+	    crypto_ec_point_is_at_infinity(pt->ec, pt->ecc_pt) ||
+	    !crypto_ec_point_is_on_curve(pt->ec, pt->ecc_pt)) {
+		wpa_printf(MSG_DEBUG, "SAE: Stored PT is not a valid point");
+		goto fail;
+	}
+
+	return pt;
+fail:
+	sae_deinit_pt(pt);
+	return NULL;
+}
+
+
 static void sae_max_min_addr(const u8 *addr[], size_t len[],
 			     const u8 *addr1, const u8 *addr2)
 {
@@ -78,6 +78,8 @@ struct sae_pk_elems {
 };
 #endif
 
+#define WPA_BSS_HASH_SIZE 32
+
 struct wpa_supplicant {
 
 	int scanning;
@@ -88,6 +90,8 @@ struct wpa_supplicant {
 
 	struct dl_list bss; /* struct wpa_bss::list */
 	struct dl_list bss_id; /* struct wpa_bss::list_id */
+	/* BSS entries hashed by BSSID, most recently updated first */
+	struct wpa_bss *bss_hash[WPA_BSS_HASH_SIZE]; /* struct wpa_bss::hash_next */
 	size_t num_bss;
 	unsigned int bss_update_idx;
 	unsigned int bss_next_id;
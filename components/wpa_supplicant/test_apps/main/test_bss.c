@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_wifi.h"
+#include "utils/common.h"
+#include "utils/list.h"
+#include "common/ieee802_11_defs.h"
+#include "drivers/driver.h"
+#include "common/wpa_supplicant_i.h"
+#include "common/bss.h"
+#include "test_utils.h"
+#include "test_wpa_supplicant_common.h"
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_WIFI_11KV_SUPPORT || CONFIG_ESP_WIFI_11R_SUPPORT
+
+#define TEST_MAX_BSS        CONFIG_ESP_WIFI_BSS_MAX_COUNT
+#define TEST_SSID           "bss_test"
+#define TEST_OTHER_SSID     "bss_test_2"
+/* SSID of the STA config, the supplicant keeps its BSSes over the others */
+#define TEST_KNOWN_SSID     "bss_test_known"
+
+static struct wpa_supplicant s_wpa_s;
+
+static void test_bssid(int i, u8 *bssid)
+{
+    /* The entries share the buckets of the BSS table once there are more than WPA_BSS_HASH_SIZE */
+    const u8 addr[ETH_ALEN] = { 0x02, 0x00, 0x00, 0x33, i >> 8, i & 0xff };
+
+    memcpy(bssid, addr, ETH_ALEN);
+}
+
+/* Feed a scan result with an SSID element, followed by extra_ie_len bytes of a vendor element */
+static void test_scan_res(int i, const char *ssid, int level, size_t extra_ie_len)
+{
+    size_t ssid_len = strlen(ssid);
+    size_t ie_len = 2 + ssid_len + (extra_ie_len ? 2 + extra_ie_len : 0);
+    struct wpa_scan_res *res = os_zalloc(sizeof(*res) + ie_len);
+    struct os_reltime fetch_time;
+    u8 *pos;
+
+    TEST_ASSERT_NOT_NULL(res);
+    test_bssid(i, res->bssid);
+    res->chan = 6;
+    res->level = level;
+    res->ie_len = ie_len;
+
+    pos = (u8 *)(res + 1);
+    *pos++ = WLAN_EID_SSID;
+    *pos++ = ssid_len;
+    memcpy(pos, ssid, ssid_len);
+    pos += ssid_len;
+    if (extra_ie_len) {
+        *pos++ = WLAN_EID_VENDOR_SPECIFIC;
+        *pos++ = extra_ie_len;
+        memset(pos, 0xdd, extra_ie_len);
+    }
+
+    os_get_reltime(&fetch_time);
+    wpa_bss_update_scan_res(&s_wpa_s, res, &fetch_time);
+    os_free(res);
+}
+
+static struct wpa_bss *test_get_bssid(int i)
+{
+    u8 bssid[ETH_ALEN];
+
+    test_bssid(i, bssid);
+    return wpa_bss_get_bssid(&s_wpa_s, bssid);
+}
+
+static struct wpa_bss *test_get(int i, const char *ssid)
+{
+    u8 bssid[ETH_ALEN];
+
+    test_bssid(i, bssid);
+    return wpa_bss_get(&s_wpa_s, bssid, (const u8 *)ssid, strlen(ssid));
+}
+
+static void check_bss(int i, const char *ssid, int level)
+{
+    struct wpa_bss *bss = test_get(i, ssid);
+    u8 bssid[ETH_ALEN];
+
+    test_bssid(i, bssid);
+    TEST_ASSERT_NOT_NULL_MESSAGE(bss, "BSS not found");
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(bssid, bss->bssid, ETH_ALEN);
+    TEST_ASSERT_EQUAL(strlen(ssid), bss->ssid_len);
+    TEST_ASSERT_EQUAL_MEMORY(ssid, bss->ssid, bss->ssid_len);
+    TEST_ASSERT_EQUAL(level, bss->level);
+}
+
+/* Each entry of the last scan results is in the table, once */
+static void check_last_scan_res(unsigned int used)
+{
+    TEST_ASSERT_EQUAL(used, s_wpa_s.last_scan_res_used);
+    for (unsigned int i = 0; i < used; i++) {
+        struct wpa_bss *bss = s_wpa_s.last_scan_res[i];
+
+        TEST_ASSERT_EQUAL_PTR(bss, wpa_bss_get(&s_wpa_s, bss->bssid, bss->ssid, bss->ssid_len));
+        for (unsigned int j = 0; j < i; j++) {
+            TEST_ASSERT_NOT_EQUAL(bss, s_wpa_s.last_scan_res[j]);
+        }
+    }
+}
+
+TEST_CASE("Test BSS table lookup, update and expiry", "[wpa_bss]")
+{
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    wifi_config_t sta_config = { 0 };
+    int i;
+
+    /* Fill the table past its default size of 20 entries, with entries sharing buckets */
+    TEST_ASSERT_GREATER_THAN(WPA_BSS_HASH_SIZE, TEST_MAX_BSS);
+
+    set_leak_threshold(6000);
+    cfg.nvs_enable = false;
+    TEST_ESP_OK(esp_wifi_init(&cfg));
+    TEST_ESP_OK(esp_wifi_set_mode(WIFI_MODE_STA));
+    strlcpy((char *)sta_config.sta.ssid, TEST_KNOWN_SSID, sizeof(sta_config.sta.ssid));
+    TEST_ESP_OK(esp_wifi_set_config(WIFI_IF_STA, &sta_config));
+
+    memset(&s_wpa_s, 0, sizeof(s_wpa_s));
+    TEST_ASSERT_EQUAL(0, wpa_bss_init(&s_wpa_s));
+
+    /* Fill the table, the first BSS is the one of the STA config */
+    wpa_bss_update_start(&s_wpa_s);
+    test_scan_res(0, TEST_KNOWN_SSID, -70, 0);
+    for (i = 1; i < TEST_MAX_BSS; i++) {
+        test_scan_res(i, TEST_SSID, -70, 0);
+    }
+    wpa_bss_update_end(&s_wpa_s);
+
+    TEST_ASSERT_EQUAL(TEST_MAX_BSS, s_wpa_s.num_bss);
+    check_last_scan_res(TEST_MAX_BSS);
+    check_bss(0, TEST_KNOWN_SSID, -70);
+    for (i = 1; i < TEST_MAX_BSS; i++) {
+        check_bss(i, TEST_SSID, -70);
+        TEST_ASSERT_EQUAL_PTR(test_get(i, TEST_SSID), test_get_bssid(i));
+        TEST_ASSERT_NULL(test_get(i, TEST_OTHER_SSID));
+    }
+    TEST_ASSERT_NULL(test_get_bssid(TEST_MAX_BSS));
+
+    /*
+     * Update all the BSSes but the first one, in reverse order. The second one is reported
+     * twice, the second time with more IEs so that the entry is reallocated.
+     */
+    wpa_bss_update_start(&s_wpa_s);
+    for (i = TEST_MAX_BSS - 1; i > 0; i--) {
+        test_scan_res(i, TEST_SSID, -50, 0);
+    }
+    test_scan_res(1, TEST_SSID, -40, 64);
+    wpa_bss_update_end(&s_wpa_s);
+
+    TEST_ASSERT_EQUAL(TEST_MAX_BSS, s_wpa_s.num_bss);
+    check_last_scan_res(TEST_MAX_BSS - 1);
+    check_bss(0, TEST_KNOWN_SSID, -70);
+    check_bss(1, TEST_SSID, -40);
+    TEST_ASSERT_EQUAL(2 + strlen(TEST_SSID) + 2 + 64, test_get_bssid(1)->ie_len);
+    for (i = 2; i < TEST_MAX_BSS; i++) {
+        check_bss(i, TEST_SSID, -50);
+    }
+
+    /*
+     * Four new BSSes, one of them with the BSSID of the second BSS, expire the oldest entries
+     * except the one of the STA config. Those are the last updated in reverse order.
+     */
+    wpa_bss_update_start(&s_wpa_s);
+    for (i = TEST_MAX_BSS; i < TEST_MAX_BSS + 3; i++) {
+        test_scan_res(i, TEST_SSID, -60, 0);
+    }
+    test_scan_res(1, TEST_OTHER_SSID, -30, 0);
+    wpa_bss_update_end(&s_wpa_s);
+
+    TEST_ASSERT_EQUAL(TEST_MAX_BSS, s_wpa_s.num_bss);
+    check_last_scan_res(4);
+    check_bss(0, TEST_KNOWN_SSID, -70);
+    for (i = TEST_MAX_BSS - 4; i < TEST_MAX_BSS; i++) {
+        TEST_ASSERT_NULL(test_get_bssid(i));
+    }
+    for (i = 2; i < TEST_MAX_BSS - 4; i++) {
+        check_bss(i, TEST_SSID, -50);
+    }
+    for (i = TEST_MAX_BSS; i < TEST_MAX_BSS + 3; i++) {
+        check_bss(i, TEST_SSID, -60);
+    }
+    /* Both entries of the second BSSID are kept, the most recently updated one is found first */
+    check_bss(1, TEST_SSID, -40);
+    check_bss(1, TEST_OTHER_SSID, -30);
+    TEST_ASSERT_EQUAL_PTR(test_get(1, TEST_OTHER_SSID), test_get_bssid(1));
+
+    /* Removing the newer entry of the second BSSID leaves the older one */
+    wpa_bss_remove(&s_wpa_s, test_get(1, TEST_OTHER_SSID), __func__);
+    TEST_ASSERT_EQUAL(TEST_MAX_BSS - 1, s_wpa_s.num_bss);
+    check_last_scan_res(3);
+    TEST_ASSERT_EQUAL_PTR(test_get(1, TEST_SSID), test_get_bssid(1));
+
+    wpa_bss_flush(&s_wpa_s);
+    TEST_ASSERT_EQUAL(0, s_wpa_s.num_bss);
+    for (i = 0; i < TEST_MAX_BSS + 3; i++) {
+        TEST_ASSERT_NULL(test_get_bssid(i));
+    }
+
+    wpa_bss_deinit(&s_wpa_s);
+    os_free(s_wpa_s.last_scan_res);
+    s_wpa_s.last_scan_res = NULL;
+    TEST_ESP_OK(esp_wifi_deinit());
+}
+
+#endif /* CONFIG_ESP_WIFI_11KV_SUPPORT || CONFIG_ESP_WIFI_11R_SUPPORT */
@@ -18,8 +18,15 @@
 #include "crypto/crypto.h"
 #include "common/sae.h"
 #include "utils/wpabuf.h"
+#include "esp_timer.h"
 #include "test_utils.h"
 #include "test_wpa_supplicant_common.h"
+#ifdef CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE
+#include "crypto/sha256.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "esp_wpa3_i.h"
+#endif /* CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE */
 
 /* Helper functions for random SSID and password generation */
 static void generate_random_string(char *str, size_t len, bool include_special)
@@ -149,4 +156,189 @@ TEST_CASE("Test SAE H2E complete workflow", "[wpa3_sae_h2e]")
     sae_clear_data(&sae);
 }
 
+TEST_CASE("Test SAE H2E PT serialization", "[wpa3_sae_h2e]")
+{
+    set_leak_threshold(600);
+    const u8 addr1[ETH_ALEN] = { 0x4d, 0x3f, 0x2f, 0xff, 0xe3, 0x87 };
+    const u8 addr2[ETH_ALEN] = { 0xa5, 0xd8, 0xaa, 0x95, 0x8e, 0x3c };
+    u8 bin[2 * SAE_MAX_ECC_PRIME_LEN];
+    u8 pwe_bin[2 * SAE_MAX_ECC_PRIME_LEN];
+    u8 pwe_cached_bin[2 * SAE_MAX_ECC_PRIME_LEN];
+    char password[64];
+    char ssid[33];
+    size_t ssid_len;
+    int len;
+
+    generate_random_ssid(ssid, &ssid_len);
+    generate_random_password(password);
+
+    int64_t start_time = esp_timer_get_time();
+    struct sae_pt *pt = sae_derive_pt(NULL, (const u8 *)ssid, ssid_len,
+                                      (const u8 *)password, strlen(password), NULL);
+    int64_t derive_time = esp_timer_get_time() - start_time;
+    TEST_ASSERT_MESSAGE(pt != NULL, "Failed to derive PT");
+
+    len = sae_pt_to_bin(pt, bin, sizeof(bin));
+    TEST_ASSERT_EQUAL(2 * crypto_ec_prime_len(pt->ec), len);
+
+    start_time = esp_timer_get_time();
+    struct sae_pt *cached = sae_pt_from_bin(IANA_SECP256R1, (const u8 *)ssid, ssid_len, bin, len);
+    int64_t load_time = esp_timer_get_time() - start_time;
+    TEST_ASSERT_MESSAGE(cached != NULL, "Failed to load PT");
+
+    ESP_LOGI("H2E", "PT derivation %lld us, loading a cached PT %lld us", derive_time, load_time);
+
+    /* Both PTs give the same PWE */
+    struct crypto_ec_point *pwe = sae_derive_pwe_from_pt_ecc(pt, addr1, addr2);
+    struct crypto_ec_point *pwe_cached = sae_derive_pwe_from_pt_ecc(cached, addr1, addr2);
+    TEST_ASSERT(pwe != NULL && pwe_cached != NULL);
+    TEST_ASSERT(crypto_ec_point_to_bin(pt->ec, pwe, pwe_bin, pwe_bin + len / 2) == 0);
+    TEST_ASSERT(crypto_ec_point_to_bin(cached->ec, pwe_cached, pwe_cached_bin, pwe_cached_bin + len / 2) == 0);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(pwe_bin, pwe_cached_bin, len);
+    crypto_ec_point_deinit(pwe, 1);
+    crypto_ec_point_deinit(pwe_cached, 1);
+    sae_deinit_pt(cached);
+
+    /* Corrupted or truncated data is rejected */
+    bin[len - 1] ^= 0x01;
+    TEST_ASSERT_NULL(sae_pt_from_bin(IANA_SECP256R1, (const u8 *)ssid, ssid_len, bin, len));
+    bin[len - 1] ^= 0x01;
+    TEST_ASSERT_NULL(sae_pt_from_bin(IANA_SECP256R1, (const u8 *)ssid, ssid_len, bin, len - 1));
+    memset(bin, 0xff, len);
+    TEST_ASSERT_NULL(sae_pt_from_bin(IANA_SECP256R1, (const u8 *)ssid, ssid_len, bin, len));
+
+    sae_deinit_pt(pt);
+}
+
+#ifdef CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE
+/* Namespace of the PT cache in esp_wpa3.c */
+#define SAE_PT_CACHE_NAMESPACE "sae_pt"
+
+static void sae_pt_cache_erase(void)
+{
+    nvs_handle_t handle;
+
+    TEST_ESP_OK(nvs_open(SAE_PT_CACHE_NAMESPACE, NVS_READWRITE, &handle));
+    TEST_ESP_OK(nvs_erase_all(handle));
+    TEST_ESP_OK(nvs_commit(handle));
+    nvs_close(handle);
+}
+
+/* Returns the number of cached PTs, key is set to the name of the last one */
+static int sae_pt_cache_entries(char *key)
+{
+    nvs_iterator_t it = NULL;
+    nvs_entry_info_t info;
+    int count = 0;
+
+    for (esp_err_t err = nvs_entry_find(NVS_DEFAULT_PART_NAME, SAE_PT_CACHE_NAMESPACE, NVS_TYPE_BLOB, &it);
+            err == ESP_OK; err = nvs_entry_next(&it)) {
+        nvs_entry_info(it, &info);
+        if (key) {
+            strlcpy(key, info.key, NVS_KEY_NAME_MAX_SIZE);
+        }
+        count++;
+    }
+    nvs_release_iterator(it);
+    return count;
+}
+
+static struct sae_pt *sae_pt_cache_derive(const char *ssid, const char *password, int *n_loaded)
+{
+    int groups[] = { IANA_SECP256R1, 0 };
+    struct sae_pt *pt;
+
+    *n_loaded = 0;
+    pt = wpa3_sae_pt_cache_derive(groups, (const u8 *)ssid, strlen(ssid),
+                                  (const u8 *)password, strlen(password), NULL, n_loaded);
+    TEST_ASSERT_NOT_NULL(pt);
+    return pt;
+}
+
+TEST_CASE("Test SAE H2E PT cache in NVS", "[wpa3_sae_h2e]")
+{
+    set_leak_threshold(600);
+    u8 bin[2 * SAE_MAX_ECC_PRIME_LEN];
+    u8 cached_bin[2 * SAE_MAX_ECC_PRIME_LEN];
+    u8 blob[SHA256_MAC_LEN + 2 * SAE_MAX_ECC_PRIME_LEN];
+    size_t blob_len = sizeof(blob);
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    char ssid[16];
+    struct sae_pt *pt, *cached;
+    nvs_handle_t handle;
+    int n_loaded;
+    int len;
+
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        TEST_ESP_OK(nvs_flash_erase());
+        err = nvs_flash_init();
+    }
+    TEST_ESP_OK(err);
+    sae_pt_cache_erase();
+
+    /* Miss: the PT is derived and stored */
+    int64_t start_time = esp_timer_get_time();
+    pt = sae_pt_cache_derive("h2e_cache", "password_1", &n_loaded);
+    int64_t derive_time = esp_timer_get_time() - start_time;
+    TEST_ASSERT_EQUAL(0, n_loaded);
+    TEST_ASSERT_EQUAL(1, sae_pt_cache_entries(NULL));
+
+    /* Hit after a reboot: the same PT is loaded from NVS */
+    TEST_ESP_OK(nvs_flash_deinit());
+    TEST_ESP_OK(nvs_flash_init());
+    start_time = esp_timer_get_time();
+    cached = sae_pt_cache_derive("h2e_cache", "password_1", &n_loaded);
+    int64_t load_time = esp_timer_get_time() - start_time;
+    TEST_ASSERT_EQUAL(1, n_loaded);
+    ESP_LOGI("H2E", "PT derivation %lld us, loading the PT from NVS %lld us", derive_time, load_time);
+
+    len = sae_pt_to_bin(pt, bin, sizeof(bin));
+    TEST_ASSERT_GREATER_THAN(0, len);
+    TEST_ASSERT_EQUAL(len, sae_pt_to_bin(cached, cached_bin, sizeof(cached_bin)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(bin, cached_bin, len);
+    sae_deinit_pt(cached);
+    sae_deinit_pt(pt);
+
+    /* New credentials of the same network evict the previous entry */
+    pt = sae_pt_cache_derive("h2e_cache", "password_2", &n_loaded);
+    TEST_ASSERT_EQUAL(0, n_loaded);
+    sae_deinit_pt(pt);
+    TEST_ASSERT_EQUAL(1, sae_pt_cache_entries(NULL));
+    pt = sae_pt_cache_derive("h2e_cache", "password_1", &n_loaded);
+    TEST_ASSERT_EQUAL(0, n_loaded);
+    sae_deinit_pt(pt);
+    TEST_ASSERT_EQUAL(1, sae_pt_cache_entries(key));
+
+    /* A corrupted entry is not used and is replaced */
+    TEST_ESP_OK(nvs_open(SAE_PT_CACHE_NAMESPACE, NVS_READWRITE, &handle));
+    TEST_ESP_OK(nvs_get_blob(handle, key, blob, &blob_len));
+    blob[blob_len - 1] ^= 0x01;
+    TEST_ESP_OK(nvs_set_blob(handle, key, blob, blob_len));
+    TEST_ESP_OK(nvs_commit(handle));
+    nvs_close(handle);
+    pt = sae_pt_cache_derive("h2e_cache", "password_1", &n_loaded);
+    TEST_ASSERT_EQUAL(0, n_loaded);
+    sae_deinit_pt(pt);
+    pt = sae_pt_cache_derive("h2e_cache", "password_1", &n_loaded);
+    TEST_ASSERT_EQUAL(1, n_loaded);
+    sae_deinit_pt(pt);
+
+    /* The number of networks is bounded, the cache is emptied once full */
+    for (int i = 1; i < CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE_ENTRIES; i++) {
+        snprintf(ssid, sizeof(ssid), "h2e_cache_%d", i);
+        pt = sae_pt_cache_derive(ssid, "password_1", &n_loaded);
+        sae_deinit_pt(pt);
+        TEST_ASSERT_EQUAL(i + 1, sae_pt_cache_entries(NULL));
+    }
+    pt = sae_pt_cache_derive("h2e_cache_full", "password_1", &n_loaded);
+    TEST_ASSERT_EQUAL(0, n_loaded);
+    sae_deinit_pt(pt);
+    TEST_ASSERT_EQUAL(1, sae_pt_cache_entries(NULL));
+
+    sae_pt_cache_erase();
+    TEST_ESP_OK(nvs_flash_deinit());
+}
+#endif /* CONFIG_ESP_WIFI_SAE_H2E_PT_CACHE */
+
 #endif /* CONFIG_WPA3_SAE */
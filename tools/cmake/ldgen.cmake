@@ -159,7 +159,8 @@ function(__ldgen_create_target exe_target)
     set_property(DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}"
         APPEND PROPERTY ADDITIONAL_CLEAN_FILES
         "${build_dir}/ldgen_libraries.in"
-        "${build_dir}/ldgen_libraries")
+        "${build_dir}/ldgen_libraries"
+        "${output}.cache")
 
     idf_build_get_property(ldgen_fragment_files __LDGEN_FRAGMENT_FILES GENERATOR_EXPRESSION)
 
@@ -188,6 +189,7 @@ function(__ldgen_create_target exe_target)
         --env-file  "${config_env_path}"
         --libraries-file "${build_dir}/ldgen_libraries"
         --objdump   "${CMAKE_OBJDUMP}"
+        --cache     "${output}.cache"
         ${ldgen_check}
         DEPENDS     ${template} ${ldgen_fragment_files} ${ldgen_deps} ${SDKCONFIG}
         VERBATIM
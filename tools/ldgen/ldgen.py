@@ -1,18 +1,16 @@
 #!/usr/bin/env python
 #
-# SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
 #
 import argparse
 import errno
 import json
 import os
-import subprocess
 import sys
 import tempfile
-from io import StringIO
 
-from ldgen.entity import EntityDB
+from ldgen.cache import LdGenCache
 from ldgen.fragments import parse_fragment_file
 from ldgen.generation import Generation
 from ldgen.ldgen_common import LdGenFailure
@@ -100,6 +98,16 @@ def main():
         '--objdump',
         help='Path to toolchain objdump')
 
+    argparser.add_argument(
+        '--cache',
+        help='File keeping the section tables of the libraries between runs',
+        type=str)
+
+    argparser.add_argument(
+        '--jobs', '-j',
+        help='Number of libraries to scan in parallel, defaults to the number of usable CPUs',
+        type=int)
+
     args = argparser.parse_args()
 
     input_file = args.input
@@ -121,16 +129,21 @@ def main():
     else:
         check_mapping_exceptions = None
 
+    cache = LdGenCache(args.cache)
     try:
-        sections_infos = EntityDB()
-        for library in libraries_file:
-            library = library.strip()
-            if library:
-                new_env = os.environ.copy()
-                new_env['LC_ALL'] = 'C'
-                dump = StringIO(subprocess.check_output([objdump, '-h', library], env=new_env).decode())
-                dump.name = library
-                sections_infos.add_sections_info(dump)
+        libraries = [library.strip() for library in libraries_file if library.strip()]
+        sections_infos = cache.scan(libraries, objdump, args.jobs)
+
+        # Nothing to do if none of the inputs changed since the script was last generated
+        input_files = [input_file.name, config_file, kconfig_file]
+        input_files += [getattr(f, 'name', f) for f in fragment_files]
+        if args.env_file is not None:
+            input_files.append(args.env_file.name)
+        inputs_digest = cache.inputs_digest(input_files, [args.env, check_mapping, check_mapping_exceptions])
+        if cache.is_output_current(output_path, inputs_digest):
+            # Keep the output newer than its dependencies for the build system
+            os.utime(output_path)
+            return
 
         generation_model = Generation(check_mapping, check_mapping_exceptions)
 
@@ -167,9 +180,12 @@ def main():
 
             with open(output_path, 'w', encoding='utf-8') as f:  # only create output file after generation has succeeded
                 f.write(output.read())
+        cache.set_output_digest(output_path, inputs_digest)
     except LdGenFailure as e:
         print('linker script generation failed for %s\nERROR: %s' % (input_file.name, e))
         sys.exit(1)
+    finally:
+        cache.save()
 
 
 if __name__ == '__main__':
@@ -0,0 +1,156 @@
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+import hashlib
+import json
+import os
+import re
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+from io import StringIO
+from typing import Any
+from typing import Dict
+from typing import List
+from typing import Optional
+
+from .entity import EntityDB
+
+# Object file and input section names in a section table dump
+SECTION_NAMES = re.compile(r'^(\S.*):\s+file format|^\s*\d+\s+(\.\S+)', re.MULTILINE)
+
+
+def scan_library(objdump: str, library: str) -> str:
+    """
+    Run objdump on a library and return its section table dump. The dump is only
+    parsed once the archive is looked up, see EntityDB.
+    """
+    new_env = os.environ.copy()
+    new_env['LC_ALL'] = 'C'
+    return subprocess.check_output([objdump, '-h', library], env=new_env).decode()
+
+
+def sections_digest(dump: str) -> str:
+    """
+    Digest of the object files and input sections of a dump, which unlike the dump
+    itself doesn't change when only the sizes or offsets of the sections do.
+    """
+    digest = hashlib.sha256()
+    for match in SECTION_NAMES.finditer(dump):
+        digest.update(((match.group(1) or match.group(2)) + '\n').encode())
+    return digest.hexdigest()
+
+
+class LdGenCache:
+    """
+    Keeps the section table dumps of the libraries across ldgen runs, so that objdump only
+    runs on the libraries which changed since the last run. A library is considered unchanged
+    if its path, modification time and size are the same.
+
+    Also keeps a digest of all the inputs of each generated linker script, so that the
+    generation can be skipped altogether when nothing changed.
+    """
+
+    VERSION = 2
+
+    # Starting a thread pool only pays off once enough libraries have to be scanned
+    PARALLEL_MIN_LIBRARIES = 8
+
+    def __init__(self, path: Optional[str] = None) -> None:
+        self.path = path
+        self.libraries: Dict[str, Dict[str, Any]] = dict()
+        self.outputs: Dict[str, str] = dict()
+        self.scanned = 0
+
+        if path and os.path.exists(path):
+            try:
+                with open(path, 'r', encoding='utf-8') as f:
+                    contents = json.load(f)
+                if contents.get('version') == LdGenCache.VERSION:
+                    self.libraries = contents['libraries']
+                    self.outputs = contents['outputs']
+            except (ValueError, KeyError, OSError):
+                # A corrupted cache is simply rebuilt
+                pass
+
+    @staticmethod
+    def _stamp(library: str) -> List[int]:
+        stat = os.stat(library)
+        return [stat.st_mtime_ns, stat.st_size]
+
+    @staticmethod
+    def _usable_cpus() -> int:
+        try:
+            return len(os.sched_getaffinity(0))
+        except AttributeError:
+            return os.cpu_count() or 1
+
+    def scan(self, libraries: List[str], objdump: str, jobs: Optional[int] = None) -> EntityDB:
+        """
+        Get the section tables of the given libraries, running objdump on the libraries
+        missing from the cache, in parallel if there are enough of them.
+
+        Returns an EntityDB containing all the libraries, in the order given.
+        """
+        stamps = {library: self._stamp(library) for library in libraries}
+        changed = [library for library in stamps
+                   if library not in self.libraries or self.libraries[library]['stamp'] != stamps[library]]
+
+        # objdump runs in its own process, so threads are enough to scan in parallel
+        workers = jobs or self._usable_cpus()
+        if workers > 1 and len(changed) >= LdGenCache.PARALLEL_MIN_LIBRARIES:
+            with ThreadPoolExecutor(max_workers=workers) as executor:
+                dumps = list(executor.map(lambda library: scan_library(objdump, library), changed))
+        else:
+            dumps = [scan_library(objdump, library) for library in changed]
+
+        for library, dump in zip(changed, dumps):
+            self.libraries[library] = {'stamp': stamps[library], 'dump': dump, 'digest': sections_digest(dump)}
+        self.scanned = len(changed)
+
+        # Forget the libraries which are not part of the build anymore
+        self.libraries = {library: self.libraries[library] for library in stamps}
+
+        entities = EntityDB()
+        for library in libraries:
+            dump_file = StringIO(self.libraries[library]['dump'])
+            dump_file.name = library
+            entities.add_sections_info(dump_file)
+        return entities
+
+    def inputs_digest(self, files: List[str], args: List[Any]) -> str:
+        """
+        Compute a digest of the inputs of a linker script generation: the contents of the
+        given files, the given arguments and the section tables of the scanned libraries.
+        """
+        digest = hashlib.sha256()
+        digest.update(str(LdGenCache.VERSION).encode())
+        # Changes to ldgen itself invalidate the generated scripts
+        package_dir = os.path.dirname(__file__)
+        for source in sorted(os.listdir(package_dir)):
+            if source.endswith('.py'):
+                digest.update(('%s %s' % (source, self._stamp(os.path.join(package_dir, source)))).encode())
+        for path in files:
+            digest.update(path.encode() + b'\0')
+            if path and os.path.exists(path):
+                with open(path, 'rb') as f:
+                    digest.update(f.read())
+        digest.update(json.dumps(args).encode())
+        for library, entry in self.libraries.items():
+            digest.update((library + entry['digest']).encode())
+        return digest.hexdigest()
+
+    def is_output_current(self, output: str, digest: str) -> bool:
+        return os.path.exists(output) and self.outputs.get(output) == digest
+
+    def set_output_digest(self, output: str, digest: str) -> None:
+        self.outputs[output] = digest
+
+    def save(self) -> None:
+        if not self.path:
+            return
+        contents = {'version': LdGenCache.VERSION, 'libraries': self.libraries, 'outputs': self.outputs}
+        tmp_path = self.path + '.tmp'
+        with open(tmp_path, 'w', encoding='utf-8') as f:
+            json.dump(contents, f)
+        os.replace(tmp_path, self.path)
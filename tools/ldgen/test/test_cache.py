@@ -0,0 +1,216 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import os
+import shutil
+import stat
+import sys
+import tempfile
+import time
+import unittest
+from concurrent.futures import ThreadPoolExecutor
+from typing import List
+from unittest import mock
+
+try:
+    from ldgen.cache import LdGenCache
+    from ldgen.entity import EntityDB
+except ImportError:
+    sys.path.append(os.path.dirname(os.path.dirname(__file__)))
+    from ldgen.cache import LdGenCache
+    from ldgen.entity import EntityDB
+
+
+class LdGenCacheTest(unittest.TestCase):
+    # Number of libraries used for measuring the scanning time
+    TIMING_LIBRARIES = 32
+
+    def setUp(self) -> None:
+        self.test_dir = tempfile.mkdtemp()
+        self.cache_path = os.path.join(self.test_dir, 'sections.ld.cache')
+        self.calls_path = os.path.join(self.test_dir, 'objdump_calls')
+
+        # The libraries are the objdump outputs themselves, the fake objdump
+        # prints them and records each call.
+        self.objdump = os.path.join(self.test_dir, 'objdump')
+        with open(self.objdump, 'w') as f:
+            f.write('#!/bin/sh\necho "$2" >> "%s"\ncat "$2"\n' % self.calls_path)
+        os.chmod(self.objdump, os.stat(self.objdump).st_mode | stat.S_IEXEC)
+
+        self.libraries = [self._create_library('data/libfreertos.a.txt', 'libfreertos.a'),
+                          self._create_library('data/libsoc.a.txt', 'libsoc.a')]
+
+    def tearDown(self) -> None:
+        shutil.rmtree(self.test_dir)
+
+    def _create_library(self, dump: str, name: str) -> str:
+        library = os.path.join(self.test_dir, name)
+        with open(dump) as src, open(library, 'w') as dst:
+            src.readline()
+            dst.write('In archive %s:\n' % library)
+            dst.write(src.read())
+        return library
+
+    def _objdump_calls(self) -> List[str]:
+        if not os.path.exists(self.calls_path):
+            return []
+        with open(self.calls_path) as f:
+            calls = f.read().split()
+        os.remove(self.calls_path)
+        return calls
+
+    def _touch(self, library: str) -> None:
+        stamp = os.stat(library).st_mtime_ns + 1000000000
+        os.utime(library, ns=(stamp, stamp))
+
+    def test_scan_same_as_objdump_output(self) -> None:
+        expected = EntityDB()
+        for dump in ('data/libfreertos.a.txt', 'data/libsoc.a.txt'):
+            with open(dump) as f:
+                expected.add_sections_info(f)
+
+        entities = LdGenCache().scan(self.libraries, self.objdump)
+
+        self.assertEqual(sorted(expected.get_archives()), sorted(entities.get_archives()))
+        for archive in expected.get_archives():
+            self.assertEqual(sorted(expected.get_objects(archive)), sorted(entities.get_objects(archive)))
+            for obj in expected.get_objects(archive):
+                self.assertEqual(list(expected.sections[archive][obj]), entities.sections[archive][obj])
+
+    def test_scan_lazy(self) -> None:
+        entities = LdGenCache().scan(self.libraries, self.objdump)
+
+        # Archives are only parsed once they are looked up
+        self.assertNotIsInstance(entities.sections['libfreertos.a'], dict)
+        self.assertIn('.text.xTaskGetTickCount', entities.get_sections('libfreertos.a', 'tasks'))
+        self.assertIsInstance(entities.sections['libfreertos.a'], dict)
+        self.assertNotIsInstance(entities.sections['libsoc.a'], dict)
+
+    def test_scan_parallel_threshold(self) -> None:
+        with mock.patch('ldgen.cache.ThreadPoolExecutor') as executor:
+            LdGenCache().scan(self.libraries, self.objdump)
+            executor.assert_not_called()
+
+        libraries = [self._create_library('data/libsoc.a.txt', 'lib%d.a' % i)
+                     for i in range(LdGenCache.PARALLEL_MIN_LIBRARIES)]
+        with mock.patch('ldgen.cache.ThreadPoolExecutor') as executor:
+            LdGenCache().scan(libraries, self.objdump, jobs=1)
+            executor.assert_not_called()
+
+        # Scanning in parallel doesn't pay off with a single usable CPU
+        with mock.patch('ldgen.cache.ThreadPoolExecutor') as executor, \
+                mock.patch.object(LdGenCache, '_usable_cpus', return_value=1):
+            LdGenCache().scan(libraries, self.objdump)
+            executor.assert_not_called()
+
+        with mock.patch('ldgen.cache.ThreadPoolExecutor', wraps=ThreadPoolExecutor) as executor:
+            entities = LdGenCache().scan(libraries, self.objdump, jobs=2)
+            executor.assert_called_once_with(max_workers=2)
+        self.assertEqual(['lib%d.a' % i for i in range(LdGenCache.PARALLEL_MIN_LIBRARIES)],
+                         list(entities.get_archives()))
+
+    def test_scan_changed_libraries_only(self) -> None:
+        cache = LdGenCache(self.cache_path)
+        cache.scan(self.libraries, self.objdump)
+        cache.save()
+        self.assertEqual(sorted(self.libraries), sorted(self._objdump_calls()))
+
+        cache = LdGenCache(self.cache_path)
+        entities = cache.scan(self.libraries, self.objdump)
+        self.assertEqual([], self._objdump_calls())
+        self.assertEqual(0, cache.scanned)
+        self.assertIn('.text.xTaskGetTickCount', entities.get_sections('libfreertos.a', 'tasks'))
+
+        self._touch(self.libraries[1])
+        cache.scan(self.libraries, self.objdump)
+        self.assertEqual([self.libraries[1]], self._objdump_calls())
+
+        # Libraries removed from the build are dropped from the cache
+        entities = cache.scan(self.libraries[:1], self.objdump)
+        self.assertEqual(['libfreertos.a'], list(entities.get_archives()))
+        self.assertEqual([self.libraries[0]], list(cache.libraries.keys()))
+
+    def test_corrupted_cache(self) -> None:
+        with open(self.cache_path, 'w') as f:
+            f.write('{"version": %d, "libraries"' % LdGenCache.VERSION)
+
+        cache = LdGenCache(self.cache_path)
+        cache.scan(self.libraries, self.objdump)
+        self.assertEqual(len(self.libraries), cache.scanned)
+
+    def test_output_current(self) -> None:
+        output = os.path.join(self.test_dir, 'sections.ld')
+        fragment = os.path.join(self.test_dir, 'linker.lf')
+        with open(fragment, 'w') as f:
+            f.write('[mapping:test]\narchive: libfreertos.a\nentries:\n    * (default)\n')
+
+        cache = LdGenCache(self.cache_path)
+        cache.scan(self.libraries, self.objdump)
+        digest = cache.inputs_digest([fragment], [])
+        self.assertFalse(cache.is_output_current(output, digest))
+
+        with open(output, 'w') as f:
+            f.write('SECTIONS {}\n')
+        cache.set_output_digest(output, digest)
+        cache.save()
+
+        cache = LdGenCache(self.cache_path)
+        cache.scan(self.libraries, self.objdump)
+        self.assertTrue(cache.is_output_current(output, cache.inputs_digest([fragment], [])))
+        self.assertFalse(cache.is_output_current(output, cache.inputs_digest([fragment], [['FOO=1']])))
+
+        # Rebuilding a library without changing its sections doesn't invalidate the output
+        self._touch(self.libraries[0])
+        cache.scan(self.libraries, self.objdump)
+        self.assertTrue(cache.is_output_current(output, cache.inputs_digest([fragment], [])))
+
+        with open(self.libraries[0], 'a') as f:
+            f.write('\nadded.c.obj:     file format elf32-xtensa-le\n\nSections:\n'
+                    'Idx Name          Size      VMA       LMA       File off  Algn\n'
+                    '  0 .text.added   00000000  00000000  00000000  00000034  2**0\n'
+                    '                  CONTENTS, ALLOC, LOAD, READONLY, CODE\n')
+        cache.scan(self.libraries, self.objdump)
+        self.assertFalse(cache.is_output_current(output, cache.inputs_digest([fragment], [])))
+
+        with open(fragment, 'a') as f:
+            f.write('\n')
+        self.assertFalse(cache.is_output_current(output, cache.inputs_digest([fragment], [])))
+
+    def test_scan_timing(self) -> None:
+        libraries = []
+        for i in range(LdGenCacheTest.TIMING_LIBRARIES):
+            dump = 'data/libfreertos.a.txt' if i % 2 else 'data/libsoc.a.txt'
+            libraries.append(self._create_library(dump, 'lib%d.a' % i))
+
+        start = time.perf_counter()
+        LdGenCache().scan(libraries, self.objdump, jobs=1)
+        serial = time.perf_counter() - start
+
+        start = time.perf_counter()
+        cache = LdGenCache(self.cache_path)
+        cache.scan(libraries, self.objdump)
+        cache.save()
+        parallel = time.perf_counter() - start
+
+        start = time.perf_counter()
+        cache = LdGenCache(self.cache_path)
+        cache.scan(libraries, self.objdump)
+        cached = time.perf_counter() - start
+        self.assertEqual(0, cache.scanned)
+
+        self._touch(libraries[0])
+        start = time.perf_counter()
+        cache = LdGenCache(self.cache_path)
+        cache.scan(libraries, self.objdump)
+        one_changed = time.perf_counter() - start
+        self.assertEqual(1, cache.scanned)
+
+        print('\nScanning %d libraries: %.3f s serial, %.3f s parallel, %.3f s cached, %.3f s with one changed' %
+              (len(libraries), serial, parallel, cached, one_changed))
+
+
+if __name__ == '__main__':
+    unittest.main()